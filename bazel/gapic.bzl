@@ -41,9 +41,15 @@ def cc_gapic_library(name, service_dirs = [], googleapis_deps = []):
         srcs = native.glob(sources_glob),
     )
 
+    # Handwritten tests and benchmarks live next to the code they exercise.
+    test_glob = [d + "internal/*_" + k + ".cc" for d in service_dirs for k in [
+        "test",
+        "benchmark",
+    ]]
+
     native.filegroup(
         name = "hdrs",
-        srcs = native.glob(include = code_glob, exclude = sources_glob),
+        srcs = native.glob(include = code_glob, exclude = sources_glob + test_glob),
     )
 
     native.filegroup(
@@ -54,3 +54,57 @@ if (BUILD_TESTING AND GOOGLE_CLOUD_CPP_ENABLE_CXX_EXCEPTIONS)
     target_link_libraries(bigquery_samples_mock_bigquery_read
                           PRIVATE GTest::gmock_main)
 endif ()
+
+function (bigquery_grpc_define_tests)
+    # The tests require googletest to be installed. Force CMake to use the
+    # config file for googletest (that is, the CMake file installed by
+    # googletest itself), because the generic `FindGTest` module does not
+    # define the GTest::gmock target, and the target names are also weird.
+    find_package(GTest CONFIG REQUIRED)
+    find_package(benchmark CONFIG REQUIRED)
+
+    set(bigquery_unit_tests
+        # cmake-format: sort
+        storage/v1/internal/stream_writer_impl_test.cc)
+
+    # Export the list of unit tests to a .bzl file so we do not need to maintain
+    # the list in two places.
+    export_list_to_bazel("bigquery_unit_tests.bzl" "bigquery_unit_tests" YEAR
+                         "2024")
+
+    # Generate a target for each unit test.
+    foreach (fname ${bigquery_unit_tests})
+        google_cloud_cpp_add_executable(target "bigquery" "${fname}")
+        target_link_libraries(
+            ${target}
+            PRIVATE google-cloud-cpp::bigquery
+                    google_cloud_cpp_testing
+                    google-cloud-cpp::mocks
+                    GTest::gmock_main
+                    GTest::gmock
+                    GTest::gtest)
+        google_cloud_cpp_add_common_options(${target})
+        add_test(NAME ${target} COMMAND ${target})
+    endforeach ()
+
+    set(bigquery_benchmarks # cmake-format: sort
+                            storage/v1/internal/stream_writer_benchmark.cc)
+
+    # Export the list of benchmarks to a .bzl file so we do not need to maintain
+    # the list in two places.
+    export_list_to_bazel("bigquery_benchmarks.bzl" "bigquery_benchmarks" YEAR
+                         "2024")
+
+    # Generate a target for each benchmark.
+    foreach (fname ${bigquery_benchmarks})
+        google_cloud_cpp_add_executable(target "bigquery" "${fname}")
+        add_test(NAME ${target} COMMAND ${target})
+        target_link_libraries(${target} PRIVATE google-cloud-cpp::bigquery
+                                                benchmark::benchmark_main)
+        google_cloud_cpp_add_common_options(${target})
+    endforeach ()
+endfunction ()
+
+if (BUILD_TESTING)
+    bigquery_grpc_define_tests()
+endif ()
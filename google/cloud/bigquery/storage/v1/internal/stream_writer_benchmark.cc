@@ -0,0 +1,129 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/storage/v1/bigquery_write_connection.h"
+#include "google/cloud/bigquery/storage/v1/stream_writer.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/credentials.h"
+#include "google/cloud/future.h"
+#include <google/cloud/bigquery/storage/v1/storage.grpc.pb.h>
+#include <benchmark/benchmark.h>
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace bqs = ::google::cloud::bigquery::storage::v1;
+using ::google::cloud::future;
+using ::google::cloud::Options;
+using ::google::cloud::Status;
+
+/**
+ * Acknowledges every `AppendRows` request.
+ *
+ * This is not a fake of the service, it does not persist or validate the rows.
+ * It is just fast enough that the benchmark measures the client overhead.
+ */
+class FakeBigQueryWrite final : public bqs::BigQueryWrite::Service {
+ public:
+  grpc::Status AppendRows(
+      grpc::ServerContext*,
+      grpc::ServerReaderWriter<bqs::AppendRowsResponse,
+                               bqs::AppendRowsRequest>* stream) override {
+    bqs::AppendRowsRequest request;
+    std::string write_stream;
+    while (stream->Read(&request)) {
+      if (!request.write_stream().empty()) {
+        write_stream = request.write_stream();
+      }
+      bqs::AppendRowsResponse response;
+      response.set_write_stream(write_stream);
+      if (request.has_offset()) {
+        response.mutable_append_result()->mutable_offset()->set_value(
+            request.offset().value());
+      }
+      if (!stream->Write(response)) break;
+    }
+    return grpc::Status::OK;
+  }
+};
+
+class EmbeddedServer {
+ public:
+  EmbeddedServer() {
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("[::]:0", grpc::InsecureServerCredentials(),
+                             &port_);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    thread_ = std::thread([this] { server_->Wait(); });
+  }
+  ~EmbeddedServer() {
+    server_->Shutdown();
+    thread_.join();
+  }
+
+  std::string address() const { return "localhost:" + std::to_string(port_); }
+
+ private:
+  FakeBigQueryWrite service_;
+  int port_ = 0;
+  std::unique_ptr<grpc::Server> server_;
+  std::thread thread_;
+};
+
+// Measures the throughput of `StreamWriter`, the arguments are the size of
+// the window of outstanding requests and the number of rows per `Append()`.
+void BM_StreamWriterAppend(benchmark::State& state) {
+  EmbeddedServer server;
+  auto connection = google::cloud::bigquery_storage_v1::
+      MakeBigQueryWriteConnection(
+          Options{}
+              .set<google::cloud::EndpointOption>(server.address())
+              .set<google::cloud::UnifiedCredentialsOption>(
+                  google::cloud::MakeInsecureCredentials()));
+
+  bqs::ProtoSchema schema;
+  auto writer = google::cloud::bigquery_storage_v1::MakeStreamWriter(
+      connection, "projects/p/datasets/d/tables/t/streams/s", schema,
+      Options{}.set<google::cloud::bigquery_storage_v1::
+                        StreamWriterMaxOutstandingRequestsOption>(
+          static_cast<std::size_t>(state.range(0))));
+
+  std::vector<std::string> const rows(static_cast<std::size_t>(state.range(1)),
+                                      std::string(128, 'x'));
+  // Keep a bounded number of appends pending, as applications should.
+  std::vector<future<Status>> pending;
+  for (auto _ : state) {
+    pending.push_back(writer->Append(rows));
+    if (pending.size() < 32) continue;
+    for (auto& p : pending) {
+      auto status = p.get();
+      if (!status.ok()) state.SkipWithError(status.message().c_str());
+    }
+    pending.clear();
+  }
+  for (auto& p : pending) p.get();
+  writer->Close().get();
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+  state.SetBytesProcessed(state.iterations() * state.range(1) * 128);
+}
+BENCHMARK(BM_StreamWriterAppend)
+    ->ArgsProduct({{1, 16}, {100, 1000}})
+    ->UseRealTime();
+
+}  // namespace
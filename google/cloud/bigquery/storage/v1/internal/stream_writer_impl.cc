@@ -0,0 +1,380 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/storage/v1/internal/stream_writer_impl.h"
+#include "google/cloud/bigquery/storage/v1/bigquery_write_options.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/make_status.h"
+#include "absl/strings/match.h"
+#include <iterator>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigquery_storage_v1_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::bigquery::storage::v1::AppendRowsResponse;
+using ::google::cloud::bigquery_storage_v1::BigQueryWriteBackoffPolicyOption;
+using ::google::cloud::bigquery_storage_v1::BigQueryWriteRetryPolicyOption;
+using ::google::cloud::bigquery_storage_v1::
+    StreamWriterMaxOutstandingRequestsOption;
+using ::google::cloud::bigquery_storage_v1::StreamWriterMaxRequestBytesOption;
+using ::google::cloud::bigquery_storage_v1::StreamWriterStartOffsetOption;
+
+// The service rejects requests larger than 10MiB.
+auto constexpr kDefaultMaxRequestBytes = 8 * 1024 * 1024;
+auto constexpr kDefaultMaxOutstandingRequests = 16;
+
+// Writes to the default stream cannot use offsets.
+bool IsDefaultStream(std::string const& write_stream) {
+  return absl::EndsWith(write_stream, "/_default");
+}
+
+}  // namespace
+
+Options StreamWriterDefaultOptions(Options options) {
+  if (!options.has<StreamWriterMaxOutstandingRequestsOption>()) {
+    options.set<StreamWriterMaxOutstandingRequestsOption>(
+        kDefaultMaxOutstandingRequests);
+  }
+  if (!options.has<StreamWriterMaxRequestBytesOption>()) {
+    options.set<StreamWriterMaxRequestBytesOption>(kDefaultMaxRequestBytes);
+  }
+  if (!options.has<StreamWriterStartOffsetOption>()) {
+    options.set<StreamWriterStartOffsetOption>(0);
+  }
+  auto& outstanding =
+      options.lookup<StreamWriterMaxOutstandingRequestsOption>();
+  if (outstanding == 0) outstanding = 1;
+  return options;
+}
+
+StreamWriterImpl::StreamWriterImpl(
+    StreamFactory factory, Sleeper sleeper, std::string write_stream,
+    google::cloud::bigquery::storage::v1::ProtoSchema schema,
+    Options const& options)
+    : factory_(std::move(factory)),
+      sleeper_(std::move(sleeper)),
+      write_stream_(std::move(write_stream)),
+      schema_(std::move(schema)),
+      max_outstanding_(options.get<StreamWriterMaxOutstandingRequestsOption>()),
+      max_request_bytes_(options.get<StreamWriterMaxRequestBytesOption>()),
+      use_offsets_(!IsDefaultStream(write_stream_)),
+      retry_prototype_(options.get<BigQueryWriteRetryPolicyOption>()->clone()),
+      backoff_prototype_(
+          options.get<BigQueryWriteBackoffPolicyOption>()->clone()),
+      retry_policy_(retry_prototype_->clone()),
+      backoff_policy_(backoff_prototype_->clone()),
+      next_offset_(options.get<StreamWriterStartOffsetOption>()) {}
+
+void StreamWriterImpl::Start() { Connect(); }
+
+future<Status> StreamWriterImpl::Append(
+    std::vector<std::string> serialized_rows) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!status_.ok()) return make_ready_future(status_);
+  if (closing_) {
+    return make_ready_future(internal::FailedPreconditionError(
+        "Append() called after Close()", GCP_ERROR_INFO()));
+  }
+  if (serialized_rows.empty()) return make_ready_future(Status{});
+
+  auto append = std::make_shared<PendingAppend>();
+  auto f = append->done.get_future();
+  for (auto& row : serialized_rows) {
+    if (open_ && open_->bytes != 0 &&
+        open_->bytes + row.size() > max_request_bytes_) {
+      Seal(lk);
+    }
+    if (!open_) open_ = std::make_shared<Request>();
+    if (open_->appends.empty() || open_->appends.back() != append) {
+      open_->appends.push_back(append);
+      ++append->pending_requests;
+    }
+    open_->bytes += row.size();
+    open_->request.mutable_proto_rows()->mutable_rows()->add_serialized_rows(
+        std::move(row));
+  }
+  Write(lk);
+  return f;
+}
+
+future<Status> StreamWriterImpl::Close() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (closing_) {
+    return make_ready_future(internal::FailedPreconditionError(
+        "Close() called more than once", GCP_ERROR_INFO()));
+  }
+  closing_ = true;
+  if (closed_) return make_ready_future(status_);
+  auto f = close_done_.get_future();
+  Seal(lk);
+  Write(lk);
+  return f;
+}
+
+void StreamWriterImpl::Connect() {
+  auto stream = factory_();
+  std::unique_lock<std::mutex> lk(mu_);
+  stream_ = std::move(stream);
+  send_header_ = true;
+  writes_done_ = false;
+  // Treat `Start()` as a pending read, so we do not `Finish()` the stream
+  // before it completes.
+  reading_ = true;
+  auto* s = stream_.get();
+  lk.unlock();
+  s->Start().then([self = shared_from_this()](future<bool> f) {
+    self->OnStart(f.get());
+  });
+}
+
+void StreamWriterImpl::OnStart(bool ok) {
+  std::unique_lock<std::mutex> lk(mu_);
+  reading_ = false;
+  if (!ok) broken_ = true;
+  if (broken_) return MaybeFinish(lk);
+  connected_ = true;
+  Read(lk);
+  Write(lk);
+}
+
+void StreamWriterImpl::Read(std::unique_lock<std::mutex>& lk) {
+  if (reading_ || broken_ || !connected_) return;
+  reading_ = true;
+  auto* s = stream_.get();
+  lk.unlock();
+  s->Read().then([self = shared_from_this()](
+                     future<absl::optional<AppendRowsResponse>> f) {
+    self->OnRead(f.get());
+  });
+  lk.lock();
+}
+
+void StreamWriterImpl::OnRead(absl::optional<AppendRowsResponse> response) {
+  PendingAppends ready;
+  std::unique_lock<std::mutex> lk(mu_);
+  reading_ = false;
+  if (!response) {
+    broken_ = true;
+    return MaybeFinish(lk);
+  }
+  if (in_flight_.empty()) {
+    Abort(lk, internal::InternalError(
+                  "AppendRows response received with no outstanding requests",
+                  GCP_ERROR_INFO()));
+    MaybeFinish(lk);
+    return;
+  }
+  auto request = std::move(in_flight_.front());
+  in_flight_.pop_front();
+
+  auto status = Status{};
+  if (response->has_error()) {
+    status = MakeStatusFromRpcError(response->error());
+    // A resent request may have been persisted by a previous attempt. The
+    // service rejects the duplicate, which is exactly what we want.
+    if (status.code() == StatusCode::kAlreadyExists && use_offsets_ &&
+        request->attempts > 1) {
+      status = Status{};
+    }
+  }
+  Complete(*request, status, ready);
+  if (status.ok()) {
+    // Progress was made, start any future retry loop from scratch.
+    progress_ = true;
+    retry_policy_ = retry_prototype_->clone();
+    backoff_policy_ = backoff_prototype_->clone();
+  } else if (use_offsets_) {
+    // The following requests have offsets past the end of the stream, they
+    // would all fail.
+    Abort(lk, std::move(status));
+  }
+  if (broken_) {
+    MaybeFinish(lk);
+  } else {
+    Read(lk);
+    Write(lk);
+  }
+  lk.unlock();
+  Notify(std::move(ready));
+}
+
+void StreamWriterImpl::Write(std::unique_lock<std::mutex>& lk) {
+  if (writing_ || broken_ || !connected_) return;
+  if (queued_.empty() && in_flight_.size() < max_outstanding_) Seal(lk);
+  if (queued_.empty()) {
+    if (!closing_ || writes_done_ || open_ || !in_flight_.empty()) return;
+    writes_done_ = true;
+    writing_ = true;
+    auto* s = stream_.get();
+    lk.unlock();
+    s->WritesDone().then([self = shared_from_this()](future<bool> f) {
+      self->OnWrite(f.get());
+    });
+    lk.lock();
+    return;
+  }
+  if (in_flight_.size() >= max_outstanding_) return;
+
+  auto request = std::move(queued_.front());
+  queued_.pop_front();
+  in_flight_.push_back(request);
+  ++request->attempts;
+  // Only the first request on each stream needs the stream name and schema.
+  auto& r = request->request;
+  if (send_header_) {
+    r.set_write_stream(write_stream_);
+    *r.mutable_proto_rows()->mutable_writer_schema() = schema_;
+    send_header_ = false;
+  } else {
+    r.clear_write_stream();
+    r.mutable_proto_rows()->clear_writer_schema();
+  }
+  writing_ = true;
+  auto* s = stream_.get();
+  lk.unlock();
+  s->Write(r, grpc::WriteOptions())
+      .then([self = shared_from_this(), request](future<bool> f) {
+        self->OnWrite(f.get());
+      });
+  lk.lock();
+}
+
+void StreamWriterImpl::OnWrite(bool ok) {
+  std::unique_lock<std::mutex> lk(mu_);
+  writing_ = false;
+  if (!ok) broken_ = true;
+  if (broken_) return MaybeFinish(lk);
+  Write(lk);
+}
+
+void StreamWriterImpl::MaybeFinish(std::unique_lock<std::mutex>& lk) {
+  if (!broken_ || reading_ || writing_ || finishing_ || !stream_) return;
+  finishing_ = true;
+  auto* s = stream_.get();
+  lk.unlock();
+  s->Finish().then([self = shared_from_this()](future<Status> f) {
+    self->OnFinish(f.get());
+  });
+  lk.lock();
+}
+
+void StreamWriterImpl::OnFinish(Status status) {
+  PendingAppends ready;
+  std::unique_ptr<AppendRowsStream> stream;
+  std::unique_lock<std::mutex> lk(mu_);
+  stream = std::move(stream_);
+  connected_ = false;
+  broken_ = false;
+  finishing_ = false;
+
+  auto const idle = !open_ && queued_.empty() && in_flight_.empty();
+  absl::optional<std::chrono::milliseconds> delay;
+  auto const progress = std::exchange(progress_, false);
+  if (status_.ok() && !(closing_ && idle)) {
+    // A stream closed without an error, e.g. by a server restart, counts
+    // against the retry policy too. Otherwise a service (or proxy) that keeps
+    // closing the stream would have us resend the same requests forever. It is
+    // resumed immediately only if some requests completed on that stream.
+    auto const clean_close = status.ok();
+    if (clean_close) {
+      status = internal::UnavailableError(
+          "AppendRows stream closed by the service", GCP_ERROR_INFO());
+    }
+    if (!retry_policy_->OnFailure(status)) {
+      status_ = std::move(status);
+    } else if (!clean_close || !progress) {
+      delay = backoff_policy_->OnCompletion();
+    }
+  } else if (status_.ok()) {
+    status_ = std::move(status);
+  }
+
+  if (closing_ && idle) {
+    closed_ = true;
+    auto close_status = status_;
+    lk.unlock();
+    close_done_.set_value(std::move(close_status));
+    return;
+  }
+  if (!status_.ok()) {
+    closed_ = true;
+    FailAll(lk, status_, ready);
+    auto close_status = status_;
+    auto const notify_close = closing_;
+    lk.unlock();
+    Notify(std::move(ready));
+    if (notify_close) close_done_.set_value(std::move(close_status));
+    return;
+  }
+  // Resend the outstanding requests, in order, on the new stream.
+  queued_.insert(queued_.begin(), std::make_move_iterator(in_flight_.begin()),
+                 std::make_move_iterator(in_flight_.end()));
+  in_flight_.clear();
+  lk.unlock();
+  stream.reset();
+  if (!delay) return Connect();
+  sleeper_(*delay).then(
+      [self = shared_from_this()](future<void>) { self->Connect(); });
+}
+
+void StreamWriterImpl::Seal(std::unique_lock<std::mutex> const&) {
+  if (!open_) return;
+  if (use_offsets_) {
+    open_->request.mutable_offset()->set_value(next_offset_);
+    next_offset_ += open_->request.proto_rows().rows().serialized_rows_size();
+  }
+  queued_.push_back(std::move(open_));
+  open_.reset();
+}
+
+void StreamWriterImpl::Abort(std::unique_lock<std::mutex> const&,
+                             Status status) {
+  if (status_.ok()) status_ = std::move(status);
+  broken_ = true;
+  // The service keeps the stream open until we half-close it, cancel it so
+  // `Finish()` completes.
+  if (stream_) stream_->Cancel();
+}
+
+void StreamWriterImpl::FailAll(std::unique_lock<std::mutex> const&,
+                               Status const& status, PendingAppends& ready) {
+  for (auto& r : in_flight_) Complete(*r, status, ready);
+  in_flight_.clear();
+  for (auto& r : queued_) Complete(*r, status, ready);
+  queued_.clear();
+  if (open_) Complete(*open_, status, ready);
+  open_.reset();
+}
+
+void StreamWriterImpl::Complete(Request& request, Status const& status,
+                                PendingAppends& ready) {
+  for (auto& a : request.appends) {
+    if (a->status.ok() && !status.ok()) a->status = status;
+    if (--a->pending_requests == 0) ready.push_back(std::move(a));
+  }
+  request.appends.clear();
+}
+
+void StreamWriterImpl::Notify(PendingAppends ready) {
+  for (auto& a : ready) a->done.set_value(std::move(a->status));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigquery_storage_v1_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,157 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_STORAGE_V1_INTERNAL_STREAM_WRITER_IMPL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_STORAGE_V1_INTERNAL_STREAM_WRITER_IMPL_H
+
+#include "google/cloud/bigquery/storage/v1/bigquery_write_connection.h"
+#include "google/cloud/bigquery/storage/v1/stream_writer.h"
+#include "google/cloud/async_streaming_read_write_rpc.h"
+#include "google/cloud/backoff_policy.h"
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <google/cloud/bigquery/storage/v1/storage.pb.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery_storage_v1_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/// Populates the `StreamWriterOptionList` defaults.
+Options StreamWriterDefaultOptions(Options options);
+
+/**
+ * Implements `bigquery_storage_v1::StreamWriter`.
+ *
+ * Rows are accumulated in an "open" request. The open request is sealed, and
+ * assigned its offset, when it reaches the size limit or when there is room in
+ * the window of outstanding requests. Sealed requests are written in order, at
+ * most one `Write()` at a time, and a single `Read()` loop matches responses to
+ * the outstanding requests (the service responds in order).
+ *
+ * When the stream breaks we wait for any pending operations, call `Finish()`,
+ * and consult the retry policy. If the error is transient the outstanding
+ * requests are moved back to the front of the queue and resent, with the same
+ * offsets, on a new stream. Streams closed with an OK status are treated as
+ * transient errors, but reconnect without a backoff if some requests completed
+ * on them.
+ */
+class StreamWriterImpl
+    : public bigquery_storage_v1::StreamWriter,
+      public std::enable_shared_from_this<StreamWriterImpl> {
+ public:
+  using AppendRowsStream = ::google::cloud::AsyncStreamingReadWriteRpc<
+      google::cloud::bigquery::storage::v1::AppendRowsRequest,
+      google::cloud::bigquery::storage::v1::AppendRowsResponse>;
+  using StreamFactory = std::function<std::unique_ptr<AppendRowsStream>()>;
+  using Sleeper = std::function<future<void>(std::chrono::milliseconds)>;
+
+  StreamWriterImpl(StreamFactory factory, Sleeper sleeper,
+                   std::string write_stream,
+                   google::cloud::bigquery::storage::v1::ProtoSchema schema,
+                   Options const& options);
+
+  /// Opens the first stream, must be called once after construction.
+  void Start();
+
+  future<Status> Append(std::vector<std::string> serialized_rows) override;
+  future<Status> Close() override;
+
+ private:
+  struct PendingAppend {
+    promise<Status> done;
+    std::size_t pending_requests = 0;
+    Status status;
+  };
+  using PendingAppends = std::vector<std::shared_ptr<PendingAppend>>;
+
+  struct Request {
+    google::cloud::bigquery::storage::v1::AppendRowsRequest request;
+    std::size_t bytes = 0;
+    int attempts = 0;
+    PendingAppends appends;
+  };
+
+  // The member functions receiving a `std::unique_lock<>&` may release the
+  // lock while calling into the stream, but always return with it held.
+  void Connect();
+  void OnStart(bool ok);
+  void Read(std::unique_lock<std::mutex>& lk);
+  void OnRead(
+      absl::optional<google::cloud::bigquery::storage::v1::AppendRowsResponse>
+          response);
+  void Write(std::unique_lock<std::mutex>& lk);
+  void OnWrite(bool ok);
+  void MaybeFinish(std::unique_lock<std::mutex>& lk);
+  void OnFinish(Status status);
+
+  void Seal(std::unique_lock<std::mutex> const& lk);
+  void Abort(std::unique_lock<std::mutex> const& lk, Status status);
+  void FailAll(std::unique_lock<std::mutex> const& lk, Status const& status,
+               PendingAppends& ready);
+  static void Complete(Request& request, Status const& status,
+                       PendingAppends& ready);
+  static void Notify(PendingAppends ready);
+
+  StreamFactory factory_;
+  Sleeper sleeper_;
+  std::string const write_stream_;
+  google::cloud::bigquery::storage::v1::ProtoSchema const schema_;
+  std::size_t const max_outstanding_;
+  std::size_t const max_request_bytes_;
+  bool const use_offsets_;
+  std::unique_ptr<bigquery_storage_v1::BigQueryWriteRetryPolicy> const
+      retry_prototype_;
+  std::unique_ptr<BackoffPolicy> const backoff_prototype_;
+
+  std::mutex mu_;
+  std::unique_ptr<AppendRowsStream> stream_;  // ABSL_GUARDED_BY(mu_)
+  std::unique_ptr<bigquery_storage_v1::BigQueryWriteRetryPolicy>
+      retry_policy_;                              // ABSL_GUARDED_BY(mu_)
+  std::unique_ptr<BackoffPolicy> backoff_policy_;  // ABSL_GUARDED_BY(mu_)
+  std::int64_t next_offset_;                       // ABSL_GUARDED_BY(mu_)
+  std::shared_ptr<Request> open_;                  // ABSL_GUARDED_BY(mu_)
+  std::deque<std::shared_ptr<Request>> queued_;    // ABSL_GUARDED_BY(mu_)
+  std::deque<std::shared_ptr<Request>> in_flight_;  // ABSL_GUARDED_BY(mu_)
+  bool connected_ = false;                          // ABSL_GUARDED_BY(mu_)
+  bool broken_ = false;                             // ABSL_GUARDED_BY(mu_)
+  bool reading_ = false;                            // ABSL_GUARDED_BY(mu_)
+  bool writing_ = false;                            // ABSL_GUARDED_BY(mu_)
+  bool finishing_ = false;                          // ABSL_GUARDED_BY(mu_)
+  bool send_header_ = true;                         // ABSL_GUARDED_BY(mu_)
+  bool progress_ = false;                           // ABSL_GUARDED_BY(mu_)
+  bool writes_done_ = false;                        // ABSL_GUARDED_BY(mu_)
+  bool closing_ = false;                            // ABSL_GUARDED_BY(mu_)
+  bool closed_ = false;                             // ABSL_GUARDED_BY(mu_)
+  Status status_;                                   // ABSL_GUARDED_BY(mu_)
+  promise<Status> close_done_;                      // ABSL_GUARDED_BY(mu_)
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigquery_storage_v1_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_STORAGE_V1_INTERNAL_STREAM_WRITER_IMPL_H
@@ -0,0 +1,370 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/storage/v1/internal/stream_writer_impl.h"
+#include "google/cloud/bigquery/storage/v1/bigquery_write_options.h"
+#include "google/cloud/mocks/mock_async_streaming_read_write_rpc.h"
+#include "google/cloud/testing_util/async_sequencer.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigquery_storage_v1_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::bigquery::storage::v1::AppendRowsRequest;
+using ::google::cloud::bigquery::storage::v1::AppendRowsResponse;
+using ::google::cloud::bigquery::storage::v1::ProtoSchema;
+using ::google::cloud::bigquery_storage_v1::BigQueryWriteBackoffPolicyOption;
+using ::google::cloud::bigquery_storage_v1::
+    BigQueryWriteLimitedErrorCountRetryPolicy;
+using ::google::cloud::bigquery_storage_v1::BigQueryWriteRetryPolicyOption;
+using ::google::cloud::bigquery_storage_v1::
+    StreamWriterMaxOutstandingRequestsOption;
+using ::google::cloud::bigquery_storage_v1::StreamWriterMaxRequestBytesOption;
+using ::google::cloud::bigquery_storage_v1::StreamWriterStartOffsetOption;
+using ::google::cloud::testing_util::AsyncSequencer;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+using MockStream = ::google::cloud::mocks::MockAsyncStreamingReadWriteRpc<
+    AppendRowsRequest, AppendRowsResponse>;
+
+auto constexpr kStreamName =
+    "projects/p/datasets/d/tables/t/streams/test-stream";
+auto constexpr kDefaultStreamName =
+    "projects/p/datasets/d/tables/t/streams/_default";
+
+ProtoSchema TestSchema() {
+  ProtoSchema schema;
+  schema.mutable_proto_descriptor()->set_name("TestRow");
+  return schema;
+}
+
+Options TestOptions(std::size_t max_outstanding = 16,
+                    std::size_t max_request_bytes = 1024) {
+  return StreamWriterDefaultOptions(
+      Options{}
+          .set<StreamWriterMaxOutstandingRequestsOption>(max_outstanding)
+          .set<StreamWriterMaxRequestBytesOption>(max_request_bytes)
+          .set<BigQueryWriteRetryPolicyOption>(
+              BigQueryWriteLimitedErrorCountRetryPolicy(2).clone())
+          .set<BigQueryWriteBackoffPolicyOption>(
+              ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                       std::chrono::milliseconds(5), 2.0)
+                  .clone()));
+}
+
+AppendRowsResponse MakeResponse(std::int64_t offset) {
+  AppendRowsResponse response;
+  response.mutable_append_result()->mutable_offset()->set_value(offset);
+  return response;
+}
+
+AppendRowsResponse MakeErrorResponse(grpc::StatusCode code) {
+  AppendRowsResponse response;
+  response.mutable_error()->set_code(code);
+  response.mutable_error()->set_message("uh-oh");
+  return response;
+}
+
+std::vector<std::string> Rows(AppendRowsRequest const& request) {
+  auto const& rows = request.proto_rows().rows().serialized_rows();
+  return {rows.begin(), rows.end()};
+}
+
+/// Simulates the streams returned by `AsyncAppendRows()`.
+class StreamWriterImplTest : public ::testing::Test {
+ protected:
+  using ReadResult = absl::optional<AppendRowsResponse>;
+
+  // Create a mock stream, reads are controlled by `reads_`, all other
+  // operations succeed immediately unless configured by the test.
+  std::unique_ptr<MockStream> MakeStream(Status finish_status = Status{}) {
+    auto stream = std::make_unique<MockStream>();
+    EXPECT_CALL(*stream, Start).WillOnce([] {
+      return make_ready_future(true);
+    });
+    EXPECT_CALL(*stream, Read).WillRepeatedly([this] {
+      return reads_.PushBack();
+    });
+    EXPECT_CALL(*stream, Write)
+        .WillRepeatedly([this](AppendRowsRequest const& r, grpc::WriteOptions) {
+          requests_.push_back(r);
+          return make_ready_future(true);
+        });
+    EXPECT_CALL(*stream, WritesDone).WillRepeatedly([] {
+      return make_ready_future(true);
+    });
+    EXPECT_CALL(*stream, Finish).WillOnce([finish_status] {
+      return make_ready_future(finish_status);
+    });
+    return stream;
+  }
+
+  std::shared_ptr<StreamWriterImpl> MakeWriter(std::string name,
+                                               Options const& options) {
+    auto writer = std::make_shared<StreamWriterImpl>(
+        [this] {
+          EXPECT_THAT(streams_, Not(IsEmpty()));
+          auto s = std::move(streams_.front());
+          streams_.pop_front();
+          return std::unique_ptr<StreamWriterImpl::AppendRowsStream>(
+              std::move(s));
+        },
+        [this](std::chrono::milliseconds) {
+          ++sleep_count_;
+          return make_ready_future();
+        },
+        std::move(name), TestSchema(), options);
+    writer->Start();
+    return writer;
+  }
+
+  AsyncSequencer<ReadResult> reads_;
+  std::vector<AppendRowsRequest> requests_;
+  std::deque<std::unique_ptr<MockStream>> streams_;
+  int sleep_count_ = 0;
+};
+
+TEST_F(StreamWriterImplTest, DefaultOptions) {
+  auto const options = StreamWriterDefaultOptions(
+      Options{}.set<StreamWriterMaxOutstandingRequestsOption>(0));
+  EXPECT_EQ(options.get<StreamWriterMaxOutstandingRequestsOption>(), 1);
+  EXPECT_GT(options.get<StreamWriterMaxRequestBytesOption>(), 0);
+  EXPECT_EQ(options.get<StreamWriterStartOffsetOption>(), 0);
+}
+
+TEST_F(StreamWriterImplTest, AppendWithOffsets) {
+  streams_.push_back(MakeStream());
+  auto writer = MakeWriter(kStreamName, TestOptions());
+
+  auto f0 = writer->Append({"r0", "r1"});
+  auto f1 = writer->Append({"r2"});
+  ASSERT_EQ(requests_.size(), 2);
+  EXPECT_EQ(requests_[0].write_stream(), kStreamName);
+  EXPECT_EQ(requests_[0].proto_rows().writer_schema().proto_descriptor().name(),
+            "TestRow");
+  EXPECT_EQ(requests_[0].offset().value(), 0);
+  EXPECT_THAT(Rows(requests_[0]), ElementsAre("r0", "r1"));
+  // Only the first request on each stream needs the name and schema.
+  EXPECT_THAT(requests_[1].write_stream(), IsEmpty());
+  EXPECT_FALSE(requests_[1].proto_rows().has_writer_schema());
+  EXPECT_EQ(requests_[1].offset().value(), 2);
+  EXPECT_THAT(Rows(requests_[1]), ElementsAre("r2"));
+
+  reads_.PopFront().set_value(MakeResponse(0));
+  EXPECT_STATUS_OK(f0.get());
+  EXPECT_FALSE(f1.is_ready());
+  reads_.PopFront().set_value(MakeResponse(2));
+  EXPECT_STATUS_OK(f1.get());
+
+  auto closed = writer->Close();
+  EXPECT_FALSE(closed.is_ready());
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+  EXPECT_THAT(writer->Append({"r3"}).get(),
+              StatusIs(StatusCode::kFailedPrecondition));
+}
+
+TEST_F(StreamWriterImplTest, BatchesWhileWindowIsFull) {
+  streams_.push_back(MakeStream());
+  auto writer = MakeWriter(kStreamName, TestOptions(/*max_outstanding=*/1));
+
+  auto f0 = writer->Append({"r0"});
+  auto f1 = writer->Append({"r1"});
+  auto f2 = writer->Append({"r2", "r3"});
+  ASSERT_EQ(requests_.size(), 1);
+
+  reads_.PopFront().set_value(MakeResponse(0));
+  EXPECT_STATUS_OK(f0.get());
+  ASSERT_EQ(requests_.size(), 2);
+  EXPECT_EQ(requests_[1].offset().value(), 1);
+  EXPECT_THAT(Rows(requests_[1]), ElementsAre("r1", "r2", "r3"));
+
+  reads_.PopFront().set_value(MakeResponse(1));
+  EXPECT_STATUS_OK(f1.get());
+  EXPECT_STATUS_OK(f2.get());
+
+  auto closed = writer->Close();
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+}
+
+TEST_F(StreamWriterImplTest, SplitsLargeAppends) {
+  streams_.push_back(MakeStream());
+  auto writer = MakeWriter(kStreamName, TestOptions(/*max_outstanding=*/16,
+                                                    /*max_request_bytes=*/8));
+
+  auto f = writer->Append({"aaaaaa", "bbbbbb", "cc", "dddddddddddd"});
+  ASSERT_EQ(requests_.size(), 3);
+  EXPECT_THAT(Rows(requests_[0]), ElementsAre("aaaaaa"));
+  EXPECT_THAT(Rows(requests_[1]), ElementsAre("bbbbbb", "cc"));
+  EXPECT_THAT(Rows(requests_[2]), ElementsAre("dddddddddddd"));
+  EXPECT_EQ(requests_[0].offset().value(), 0);
+  EXPECT_EQ(requests_[1].offset().value(), 1);
+  EXPECT_EQ(requests_[2].offset().value(), 3);
+
+  reads_.PopFront().set_value(MakeResponse(0));
+  reads_.PopFront().set_value(MakeResponse(1));
+  EXPECT_FALSE(f.is_ready());
+  reads_.PopFront().set_value(MakeResponse(3));
+  EXPECT_STATUS_OK(f.get());
+
+  auto closed = writer->Close();
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+}
+
+TEST_F(StreamWriterImplTest, ResendsAfterTransientError) {
+  streams_.push_back(MakeStream(internal::UnavailableError("try-again")));
+  streams_.push_back(MakeStream());
+  auto writer = MakeWriter(kStreamName, TestOptions());
+
+  auto f0 = writer->Append({"r0"});
+  auto f1 = writer->Append({"r1"});
+  ASSERT_EQ(requests_.size(), 2);
+  reads_.PopFront().set_value(absl::nullopt);
+
+  // The outstanding requests are resent, with the same offsets.
+  EXPECT_EQ(sleep_count_, 1);
+  ASSERT_EQ(requests_.size(), 4);
+  EXPECT_EQ(requests_[2].write_stream(), kStreamName);
+  EXPECT_TRUE(requests_[2].proto_rows().has_writer_schema());
+  EXPECT_EQ(requests_[2].offset().value(), 0);
+  EXPECT_EQ(requests_[3].offset().value(), 1);
+
+  // The first request was persisted before the stream broke.
+  reads_.PopFront().set_value(
+      MakeErrorResponse(grpc::StatusCode::ALREADY_EXISTS));
+  EXPECT_STATUS_OK(f0.get());
+  reads_.PopFront().set_value(MakeResponse(1));
+  EXPECT_STATUS_OK(f1.get());
+
+  auto closed = writer->Close();
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+}
+
+TEST_F(StreamWriterImplTest, PermanentStreamError) {
+  streams_.push_back(MakeStream(internal::PermissionDeniedError("uh-oh")));
+  auto writer = MakeWriter(kStreamName, TestOptions());
+
+  auto f0 = writer->Append({"r0"});
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_EQ(sleep_count_, 0);
+  EXPECT_THAT(f0.get(), StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_THAT(writer->Append({"r1"}).get(),
+              StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_THAT(writer->Close().get(), StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST_F(StreamWriterImplTest, AlreadyExistsOnFirstAttemptIsAnError) {
+  auto stream = MakeStream(internal::CancelledError("cancelled"));
+  EXPECT_CALL(*stream, Cancel).Times(1);
+  streams_.push_back(std::move(stream));
+  auto writer = MakeWriter(kStreamName, TestOptions());
+
+  auto f0 = writer->Append({"r0"});
+  auto f1 = writer->Append({"r1"});
+  reads_.PopFront().set_value(
+      MakeErrorResponse(grpc::StatusCode::ALREADY_EXISTS));
+  EXPECT_THAT(f0.get(), StatusIs(StatusCode::kAlreadyExists));
+  // With explicit offsets the following requests cannot succeed.
+  EXPECT_THAT(f1.get(), StatusIs(StatusCode::kAlreadyExists));
+  EXPECT_THAT(writer->Close().get(), StatusIs(StatusCode::kAlreadyExists));
+}
+
+TEST_F(StreamWriterImplTest, DefaultStreamErrorsAreIndependent) {
+  streams_.push_back(MakeStream());
+  auto writer = MakeWriter(kDefaultStreamName, TestOptions());
+
+  auto f0 = writer->Append({"r0"});
+  auto f1 = writer->Append({"r1"});
+  ASSERT_EQ(requests_.size(), 2);
+  EXPECT_FALSE(requests_[0].has_offset());
+  EXPECT_FALSE(requests_[1].has_offset());
+
+  reads_.PopFront().set_value(
+      MakeErrorResponse(grpc::StatusCode::INVALID_ARGUMENT));
+  EXPECT_THAT(f0.get(), StatusIs(StatusCode::kInvalidArgument));
+  reads_.PopFront().set_value(AppendRowsResponse{});
+  EXPECT_STATUS_OK(f1.get());
+
+  auto closed = writer->Close();
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+}
+
+TEST_F(StreamWriterImplTest, RetryPolicyExhausted) {
+  streams_.push_back(MakeStream(internal::UnavailableError("try-again")));
+  streams_.push_back(MakeStream(internal::UnavailableError("try-again")));
+  streams_.push_back(MakeStream(internal::UnavailableError("try-again")));
+  auto writer = MakeWriter(kStreamName, TestOptions());
+
+  auto f0 = writer->Append({"r0"});
+  reads_.PopFront().set_value(absl::nullopt);
+  reads_.PopFront().set_value(absl::nullopt);
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_EQ(sleep_count_, 2);
+  EXPECT_THAT(f0.get(), StatusIs(StatusCode::kUnavailable));
+}
+
+TEST_F(StreamWriterImplTest, CleanCloseAfterProgressReconnectsImmediately) {
+  streams_.push_back(MakeStream());
+  streams_.push_back(MakeStream());
+  auto writer = MakeWriter(kStreamName, TestOptions());
+
+  auto f0 = writer->Append({"r0"});
+  auto f1 = writer->Append({"r1"});
+  reads_.PopFront().set_value(MakeResponse(0));
+  EXPECT_STATUS_OK(f0.get());
+  reads_.PopFront().set_value(absl::nullopt);
+
+  EXPECT_EQ(sleep_count_, 0);
+  ASSERT_EQ(requests_.size(), 3);
+  EXPECT_EQ(requests_[2].offset().value(), 1);
+  reads_.PopFront().set_value(MakeResponse(1));
+  EXPECT_STATUS_OK(f1.get());
+
+  auto closed = writer->Close();
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_STATUS_OK(closed.get());
+}
+
+TEST_F(StreamWriterImplTest, CleanCloseWithoutProgressUsesRetryPolicy) {
+  streams_.push_back(MakeStream());
+  streams_.push_back(MakeStream());
+  streams_.push_back(MakeStream());
+  auto writer = MakeWriter(kStreamName, TestOptions());
+
+  auto f0 = writer->Append({"r0"});
+  reads_.PopFront().set_value(absl::nullopt);
+  reads_.PopFront().set_value(absl::nullopt);
+  reads_.PopFront().set_value(absl::nullopt);
+  EXPECT_EQ(sleep_count_, 2);
+  EXPECT_EQ(requests_.size(), 3);
+  EXPECT_THAT(f0.get(), StatusIs(StatusCode::kUnavailable));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigquery_storage_v1_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,86 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/storage/v1/stream_writer.h"
+#include "google/cloud/bigquery/storage/v1/internal/bigquery_write_option_defaults.h"
+#include "google/cloud/bigquery/storage/v1/internal/stream_writer_impl.h"
+#include "google/cloud/background_threads.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/options.h"
+
+namespace google {
+namespace cloud {
+namespace bigquery_storage_v1 {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+/**
+ * Owns the background threads used to back off between reconnects.
+ *
+ * The implementation may be destroyed from one of the background threads,
+ * joining them there would deadlock. This wrapper is only referenced by the
+ * application.
+ */
+class BackgroundThreadsStreamWriter : public StreamWriter {
+ public:
+  BackgroundThreadsStreamWriter(
+      std::unique_ptr<BackgroundThreads> background,
+      std::shared_ptr<bigquery_storage_v1_internal::StreamWriterImpl> impl)
+      : background_(std::move(background)), impl_(std::move(impl)) {}
+
+  future<Status> Append(std::vector<std::string> serialized_rows) override {
+    return impl_->Append(std::move(serialized_rows));
+  }
+  future<Status> Close() override { return impl_->Close(); }
+
+ private:
+  std::unique_ptr<BackgroundThreads> background_;
+  std::shared_ptr<bigquery_storage_v1_internal::StreamWriterImpl> impl_;
+};
+
+}  // namespace
+
+StreamWriter::~StreamWriter() = default;
+
+std::shared_ptr<StreamWriter> MakeStreamWriter(
+    std::shared_ptr<BigQueryWriteConnection> connection,
+    std::string write_stream,
+    google::cloud::bigquery::storage::v1::ProtoSchema schema, Options opts) {
+  auto options = bigquery_storage_v1_internal::StreamWriterDefaultOptions(
+      internal::MergeOptions(
+          std::move(opts),
+          bigquery_storage_v1_internal::BigQueryWriteDefaultOptions(
+              connection->options())));
+  auto background = internal::MakeBackgroundThreadsFactory(options)();
+  auto factory = [connection, options] {
+    internal::OptionsSpan span(options);
+    return connection->AsyncAppendRows();
+  };
+  auto sleeper = [cq = background->cq()](std::chrono::milliseconds d) mutable {
+    return cq.MakeRelativeTimer(d).then(
+        [](future<StatusOr<std::chrono::system_clock::time_point>>) {});
+  };
+  auto impl = std::make_shared<bigquery_storage_v1_internal::StreamWriterImpl>(
+      std::move(factory), std::move(sleeper), std::move(write_stream),
+      std::move(schema), options);
+  impl->Start();
+  return std::make_shared<BackgroundThreadsStreamWriter>(std::move(background),
+                                                         std::move(impl));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigquery_storage_v1
+}  // namespace cloud
+}  // namespace google
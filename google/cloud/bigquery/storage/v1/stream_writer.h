@@ -0,0 +1,158 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_STORAGE_V1_STREAM_WRITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_STORAGE_V1_STREAM_WRITER_H
+
+#include "google/cloud/bigquery/storage/v1/bigquery_write_connection.h"
+#include "google/cloud/future.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include <google/cloud/bigquery/storage/v1/protobuf.pb.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery_storage_v1 {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * The maximum number of `AppendRowsRequest`s sent, but not yet acknowledged.
+ *
+ * The `StreamWriter` pipelines requests on its `AppendRows` stream. Once this
+ * many requests are waiting for a response, new rows are accumulated into the
+ * next request until the service acknowledges one of the outstanding requests.
+ *
+ * @ingroup google-cloud-bigquery-options
+ */
+struct StreamWriterMaxOutstandingRequestsOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The maximum size of the serialized rows in each `AppendRowsRequest`.
+ *
+ * The service rejects requests larger than 10MiB. The default leaves some room
+ * for the writer schema, which is included in the first request of each
+ * stream. A single row larger than this limit is sent in its own request.
+ *
+ * @ingroup google-cloud-bigquery-options
+ */
+struct StreamWriterMaxRequestBytesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * The offset of the first row appended by a `StreamWriter`.
+ *
+ * Only used with explicitly created (committed, pending, or buffered) write
+ * streams. Set this when resuming writes on a stream that already contains
+ * data.
+ *
+ * @ingroup google-cloud-bigquery-options
+ */
+struct StreamWriterStartOffsetOption {
+  using Type = std::int64_t;
+};
+
+/// The options applicable to `StreamWriter`.
+using StreamWriterOptionList =
+    OptionList<StreamWriterMaxOutstandingRequestsOption,
+               StreamWriterMaxRequestBytesOption,
+               StreamWriterStartOffsetOption>;
+
+/**
+ * Appends serialized protobuf rows to a BigQuery write stream.
+ *
+ * A `StreamWriter` owns a single `AppendRows` bidirectional stream. It packs
+ * the rows from consecutive `Append()` calls into size-bounded
+ * `AppendRowsRequest` messages and keeps up to
+ * `StreamWriterMaxOutstandingRequestsOption` requests in flight.
+ *
+ * If the stream breaks with a transient error the writer opens a new stream,
+ * with the `BigQueryWriteRetryPolicyOption` and
+ * `BigQueryWriteBackoffPolicyOption` from the connection, and resends every
+ * unacknowledged request.
+ *
+ * @par Exactly-once semantics
+ * When writing to an explicitly created stream, each request carries the
+ * offset of its first row. Requests resent after a reconnect carry the same
+ * offsets, and the service rejects any that were already persisted, which the
+ * writer treats as success. Writes to the `_default` stream do not use offsets,
+ * so rows in requests resent after a failure may be duplicated.
+ *
+ * @par Backpressure
+ * The future returned by `Append()` is satisfied once all its rows are
+ * acknowledged by the service. Applications should bound the number of
+ * unsatisfied futures (or the bytes they represent) to avoid buffering an
+ * unbounded amount of data.
+ *
+ * @par Thread Safety
+ * All member functions are safe to call from multiple threads. Rows appended
+ * from different threads are sent in the order the calls are serialized.
+ */
+class StreamWriter {
+ public:
+  virtual ~StreamWriter() = 0;
+
+  /**
+   * Appends @p serialized_rows to the stream.
+   *
+   * Each element must be a protobuf message serialized with the schema used to
+   * create this writer.
+   *
+   * @return a future satisfied when all the rows are acknowledged, or when the
+   *     writer gives up on them.
+   */
+  virtual future<Status> Append(std::vector<std::string> serialized_rows) = 0;
+
+  /**
+   * Sends any pending rows and closes the stream.
+   *
+   * Further calls to `Append()` fail. The returned future is satisfied once all
+   * previously appended rows are acknowledged (or failed) and the stream is
+   * closed. Applications must wait for this future before releasing the last
+   * reference to the writer.
+   */
+  virtual future<Status> Close() = 0;
+};
+
+/**
+ * Creates a new `StreamWriter`.
+ *
+ * @param connection the connection used to open `AppendRows` streams.
+ * @param write_stream the name of the stream, in the form
+ *     `projects/{project}/datasets/{dataset}/tables/{table}/streams/{id}`. Use
+ *     `_default` as the `{id}` for the default stream.
+ * @param schema the schema of the serialized rows.
+ * @param opts configure the writer, see `StreamWriterOptionList`. Also used to
+ *     override the connection options.
+ */
+std::shared_ptr<StreamWriter> MakeStreamWriter(
+    std::shared_ptr<BigQueryWriteConnection> connection,
+    std::string write_stream,
+    google::cloud::bigquery::storage::v1::ProtoSchema schema,
+    Options opts = {});
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigquery_storage_v1
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_STORAGE_V1_STREAM_WRITER_H
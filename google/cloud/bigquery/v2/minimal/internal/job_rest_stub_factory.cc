@@ -19,6 +19,7 @@
 #include "google/cloud/bigquery/v2/minimal/internal/job_metadata.h"
 #include "google/cloud/common_options.h"
 #include "google/cloud/internal/algorithm.h"
+#include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/log.h"
 
 namespace google {
@@ -30,7 +31,8 @@ std::shared_ptr<BigQueryJobRestStub> CreateDefaultBigQueryJobRestStub(
     Options const& opts) {
   Options local_opts = opts;
   if (!local_opts.has<UnifiedCredentialsOption>()) {
-    local_opts.set<UnifiedCredentialsOption>(MakeGoogleDefaultCredentials());
+    local_opts.set<UnifiedCredentialsOption>(
+        internal::SharedGoogleDefaultCredentials(Options{}));
   }
 
   auto curl_rest_client = rest_internal::MakePooledRestClient(
@@ -18,6 +18,7 @@
 #include "google/cloud/common_options.h"
 #include "google/cloud/credentials.h"
 #include "google/cloud/internal/algorithm.h"
+#include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/internal/unified_rest_credentials.h"
 #include "google/cloud/log.h"
 
@@ -30,7 +31,8 @@ std::shared_ptr<ProjectRestStub> CreateDefaultProjectRestStub(
     Options const& opts) {
   Options local_opts = opts;
   if (!local_opts.has<UnifiedCredentialsOption>()) {
-    local_opts.set<UnifiedCredentialsOption>(MakeGoogleDefaultCredentials());
+    local_opts.set<UnifiedCredentialsOption>(
+        internal::SharedGoogleDefaultCredentials(Options{}));
   }
 
   auto curl_rest_client = rest_internal::MakePooledRestClient(
@@ -43,6 +43,7 @@ bigtable_client_unit_tests = [
     "internal/async_row_reader_test.cc",
     "internal/async_row_sampler_test.cc",
     "internal/async_streaming_read_test.cc",
+    "internal/bigtable_channel_health_stub_test.cc",
     "internal/bigtable_channel_refresh_test.cc",
     "internal/bigtable_stub_factory_test.cc",
     "internal/bulk_mutator_test.cc",
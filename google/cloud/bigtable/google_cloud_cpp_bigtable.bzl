@@ -74,6 +74,7 @@ google_cloud_cpp_bigtable_hdrs = [
     "internal/async_row_sampler.h",
     "internal/async_streaming_read.h",
     "internal/bigtable_auth_decorator.h",
+    "internal/bigtable_channel_health_stub.h",
     "internal/bigtable_channel_refresh.h",
     "internal/bigtable_logging_decorator.h",
     "internal/bigtable_metadata_decorator.h",
@@ -178,6 +179,7 @@ google_cloud_cpp_bigtable_srcs = [
     "internal/async_row_reader.cc",
     "internal/async_row_sampler.cc",
     "internal/bigtable_auth_decorator.cc",
+    "internal/bigtable_channel_health_stub.cc",
     "internal/bigtable_channel_refresh.cc",
     "internal/bigtable_logging_decorator.cc",
     "internal/bigtable_metadata_decorator.cc",
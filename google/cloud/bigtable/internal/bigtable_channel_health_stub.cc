@@ -0,0 +1,211 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/bigtable_channel_health_stub.h"
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+BigtableChannelHealthStub::BigtableChannelHealthStub(
+    std::shared_ptr<internal::ChannelPoolHealth> health, std::size_t index,
+    std::shared_ptr<BigtableStub> child)
+    : health_(std::move(health)),
+      index_(index),
+      child_{std::move(child), health_->Epoch(index_)} {}
+
+void BigtableChannelHealthStub::ReplaceChild(
+    std::shared_ptr<BigtableStub> child) {
+  Child replacement{std::move(child), health_->Reset(index_)};
+  std::unique_lock<std::mutex> lk(mu_);
+  std::swap(child_, replacement);
+  lk.unlock();
+  // The old stub, if this was the last reference, is released here, outside
+  // the lock.
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ReadRowsResponse>>
+BigtableChannelHealthStub::ReadRows(
+    std::shared_ptr<grpc::ClientContext> client_context, Options const& options,
+    google::bigtable::v2::ReadRowsRequest const& request) {
+  return CurrentChild().stub->ReadRows(std::move(client_context), options,
+                                       request);
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::SampleRowKeysResponse>>
+BigtableChannelHealthStub::SampleRowKeys(
+    std::shared_ptr<grpc::ClientContext> client_context, Options const& options,
+    google::bigtable::v2::SampleRowKeysRequest const& request) {
+  return CurrentChild().stub->SampleRowKeys(std::move(client_context),
+                                            options, request);
+}
+
+StatusOr<google::bigtable::v2::MutateRowResponse>
+BigtableChannelHealthStub::MutateRow(
+    grpc::ClientContext& client_context, Options const& options,
+    google::bigtable::v2::MutateRowRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->MutateRow(client_context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::MutateRowsResponse>>
+BigtableChannelHealthStub::MutateRows(
+    std::shared_ptr<grpc::ClientContext> client_context, Options const& options,
+    google::bigtable::v2::MutateRowsRequest const& request) {
+  return CurrentChild().stub->MutateRows(std::move(client_context), options,
+                                         request);
+}
+
+StatusOr<google::bigtable::v2::CheckAndMutateRowResponse>
+BigtableChannelHealthStub::CheckAndMutateRow(
+    grpc::ClientContext& client_context, Options const& options,
+    google::bigtable::v2::CheckAndMutateRowRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response =
+      child.stub->CheckAndMutateRow(client_context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::bigtable::v2::PingAndWarmResponse>
+BigtableChannelHealthStub::PingAndWarm(
+    grpc::ClientContext& client_context, Options const& options,
+    google::bigtable::v2::PingAndWarmRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->PingAndWarm(client_context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::bigtable::v2::ReadModifyWriteRowResponse>
+BigtableChannelHealthStub::ReadModifyWriteRow(
+    grpc::ClientContext& client_context, Options const& options,
+    google::bigtable::v2::ReadModifyWriteRowRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response =
+      child.stub->ReadModifyWriteRow(client_context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::bigtable::v2::ExecuteQueryResponse>>
+BigtableChannelHealthStub::ExecuteQuery(
+    std::shared_ptr<grpc::ClientContext> client_context, Options const& options,
+    google::bigtable::v2::ExecuteQueryRequest const& request) {
+  return CurrentChild().stub->ExecuteQuery(std::move(client_context),
+                                           options, request);
+}
+
+std::unique_ptr<::google::cloud::internal::AsyncStreamingReadRpc<
+    google::bigtable::v2::ReadRowsResponse>>
+BigtableChannelHealthStub::AsyncReadRows(
+    google::cloud::CompletionQueue const& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::bigtable::v2::ReadRowsRequest const& request) {
+  return CurrentChild().stub->AsyncReadRows(cq, std::move(context),
+                                            std::move(options), request);
+}
+
+std::unique_ptr<::google::cloud::internal::AsyncStreamingReadRpc<
+    google::bigtable::v2::SampleRowKeysResponse>>
+BigtableChannelHealthStub::AsyncSampleRowKeys(
+    google::cloud::CompletionQueue const& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::bigtable::v2::SampleRowKeysRequest const& request) {
+  return CurrentChild().stub->AsyncSampleRowKeys(cq, std::move(context),
+                                                 std::move(options), request);
+}
+
+future<StatusOr<google::bigtable::v2::MutateRowResponse>>
+BigtableChannelHealthStub::AsyncMutateRow(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::bigtable::v2::MutateRowRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto f = child.stub->AsyncMutateRow(cq, std::move(context),
+                                      std::move(options), request);
+  return Record(child.epoch, start, std::move(f));
+}
+
+std::unique_ptr<::google::cloud::internal::AsyncStreamingReadRpc<
+    google::bigtable::v2::MutateRowsResponse>>
+BigtableChannelHealthStub::AsyncMutateRows(
+    google::cloud::CompletionQueue const& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::bigtable::v2::MutateRowsRequest const& request) {
+  return CurrentChild().stub->AsyncMutateRows(cq, std::move(context),
+                                              std::move(options), request);
+}
+
+future<StatusOr<google::bigtable::v2::CheckAndMutateRowResponse>>
+BigtableChannelHealthStub::AsyncCheckAndMutateRow(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::bigtable::v2::CheckAndMutateRowRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto f = child.stub->AsyncCheckAndMutateRow(cq, std::move(context),
+                                              std::move(options), request);
+  return Record(child.epoch, start, std::move(f));
+}
+
+future<StatusOr<google::bigtable::v2::ReadModifyWriteRowResponse>>
+BigtableChannelHealthStub::AsyncReadModifyWriteRow(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::bigtable::v2::ReadModifyWriteRowRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto f = child.stub->AsyncReadModifyWriteRow(cq, std::move(context),
+                                               std::move(options), request);
+  return Record(child.epoch, start, std::move(f));
+}
+
+BigtableChannelHealthStub::Child BigtableChannelHealthStub::CurrentChild() {
+  std::lock_guard<std::mutex> lk(mu_);
+  return child_;
+}
+
+void BigtableChannelHealthStub::Record(
+    std::uint64_t epoch, std::chrono::steady_clock::time_point start,
+    StatusCode code) {
+  health_->Record(index_, epoch, std::chrono::steady_clock::now() - start,
+                  code);
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
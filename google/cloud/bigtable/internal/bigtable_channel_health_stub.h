@@ -0,0 +1,175 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_BIGTABLE_CHANNEL_HEALTH_STUB_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_BIGTABLE_CHANNEL_HEALTH_STUB_H
+
+#include "google/cloud/bigtable/internal/bigtable_stub.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/channel_health.h"
+#include "google/cloud/internal/retry_loop_helpers.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Records the health of one gRPC channel.
+ *
+ * The stub factory wraps the stub for each channel with this decorator, below
+ * the round-robin decorator. Each unary RPC is timed, and its latency and
+ * status code are recorded in the `ChannelPoolHealth` for the channel.
+ * Streaming RPCs, such as `ReadRows()` and `MutateRows()`, are not recorded:
+ * their duration depends on the amount of data transferred, not on the health
+ * of the channel.
+ *
+ * When the channel is replaced, `ReplaceChild()` swaps the wrapped stub. RPCs
+ * that started before the swap complete on the old stub, and their results
+ * are discarded.
+ */
+class BigtableChannelHealthStub : public BigtableStub {
+ public:
+  BigtableChannelHealthStub(std::shared_ptr<internal::ChannelPoolHealth> health,
+                            std::size_t index,
+                            std::shared_ptr<BigtableStub> child);
+  ~BigtableChannelHealthStub() override = default;
+
+  /// Use @p child for any new RPCs, and reset the channel scores.
+  void ReplaceChild(std::shared_ptr<BigtableStub> child);
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::bigtable::v2::ReadRowsResponse>>
+  ReadRows(std::shared_ptr<grpc::ClientContext> client_context,
+           Options const& options,
+           google::bigtable::v2::ReadRowsRequest const& request) override;
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::bigtable::v2::SampleRowKeysResponse>>
+  SampleRowKeys(
+      std::shared_ptr<grpc::ClientContext> client_context,
+      Options const& options,
+      google::bigtable::v2::SampleRowKeysRequest const& request) override;
+
+  StatusOr<google::bigtable::v2::MutateRowResponse> MutateRow(
+      grpc::ClientContext& client_context, Options const& options,
+      google::bigtable::v2::MutateRowRequest const& request) override;
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::bigtable::v2::MutateRowsResponse>>
+  MutateRows(std::shared_ptr<grpc::ClientContext> client_context,
+             Options const& options,
+             google::bigtable::v2::MutateRowsRequest const& request) override;
+
+  StatusOr<google::bigtable::v2::CheckAndMutateRowResponse> CheckAndMutateRow(
+      grpc::ClientContext& client_context, Options const& options,
+      google::bigtable::v2::CheckAndMutateRowRequest const& request) override;
+
+  StatusOr<google::bigtable::v2::PingAndWarmResponse> PingAndWarm(
+      grpc::ClientContext& client_context, Options const& options,
+      google::bigtable::v2::PingAndWarmRequest const& request) override;
+
+  StatusOr<google::bigtable::v2::ReadModifyWriteRowResponse> ReadModifyWriteRow(
+      grpc::ClientContext& client_context, Options const& options,
+      google::bigtable::v2::ReadModifyWriteRowRequest const& request) override;
+
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+      google::bigtable::v2::ExecuteQueryResponse>>
+  ExecuteQuery(
+      std::shared_ptr<grpc::ClientContext> client_context,
+      Options const& options,
+      google::bigtable::v2::ExecuteQueryRequest const& request) override;
+
+  std::unique_ptr<::google::cloud::internal::AsyncStreamingReadRpc<
+      google::bigtable::v2::ReadRowsResponse>>
+  AsyncReadRows(google::cloud::CompletionQueue const& cq,
+                std::shared_ptr<grpc::ClientContext> context,
+                google::cloud::internal::ImmutableOptions options,
+                google::bigtable::v2::ReadRowsRequest const& request) override;
+
+  std::unique_ptr<::google::cloud::internal::AsyncStreamingReadRpc<
+      google::bigtable::v2::SampleRowKeysResponse>>
+  AsyncSampleRowKeys(
+      google::cloud::CompletionQueue const& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::bigtable::v2::SampleRowKeysRequest const& request) override;
+
+  future<StatusOr<google::bigtable::v2::MutateRowResponse>> AsyncMutateRow(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::bigtable::v2::MutateRowRequest const& request) override;
+
+  std::unique_ptr<::google::cloud::internal::AsyncStreamingReadRpc<
+      google::bigtable::v2::MutateRowsResponse>>
+  AsyncMutateRows(
+      google::cloud::CompletionQueue const& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::bigtable::v2::MutateRowsRequest const& request) override;
+
+  future<StatusOr<google::bigtable::v2::CheckAndMutateRowResponse>>
+  AsyncCheckAndMutateRow(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::bigtable::v2::CheckAndMutateRowRequest const& request) override;
+
+  future<StatusOr<google::bigtable::v2::ReadModifyWriteRowResponse>>
+  AsyncReadModifyWriteRow(
+      google::cloud::CompletionQueue& cq,
+      std::shared_ptr<grpc::ClientContext> context,
+      google::cloud::internal::ImmutableOptions options,
+      google::bigtable::v2::ReadModifyWriteRowRequest const& request) override;
+
+ private:
+  struct Child {
+    std::shared_ptr<BigtableStub> stub;
+    std::uint64_t epoch;
+  };
+
+  Child CurrentChild();
+  void Record(std::uint64_t epoch, std::chrono::steady_clock::time_point start,
+              StatusCode code);
+
+  template <typename T>
+  future<T> Record(std::uint64_t epoch,
+                   std::chrono::steady_clock::time_point start, future<T> f) {
+    return f.then([health = health_, index = index_, epoch, start](auto g) {
+      auto response = g.get();
+      health->Record(index, epoch, std::chrono::steady_clock::now() - start,
+                     internal::GetResultCode(response));
+      return response;
+    });
+  }
+
+  std::shared_ptr<internal::ChannelPoolHealth> const health_;
+  std::size_t const index_;
+  std::mutex mu_;
+  Child child_;  // GUARDED_BY(mu_)
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_BIGTABLE_CHANNEL_HEALTH_STUB_H
@@ -0,0 +1,125 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/bigtable_channel_health_stub.h"
+#include "google/cloud/bigtable/testing/mock_bigtable_stub.h"
+#include "google/cloud/internal/make_status.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::bigtable::testing::MockBigtableStub;
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ByMove;
+using ::testing::Return;
+
+auto MakePool() {
+  return std::make_shared<internal::ChannelPoolHealth>(0, 2, 1, 3.0);
+}
+
+TEST(BigtableChannelHealthStub, RecordsUnary) {
+  auto pool = MakePool();
+  auto mock = std::make_shared<MockBigtableStub>();
+  EXPECT_CALL(*mock, MutateRow)
+      .WillOnce(Return(google::bigtable::v2::MutateRowResponse{}))
+      .WillOnce(Return(internal::UnavailableError("try-again")));
+
+  BigtableChannelHealthStub stub(pool, 1, mock);
+  grpc::ClientContext c1;
+  EXPECT_THAT(stub.MutateRow(c1, Options{}, {}), IsOk());
+  grpc::ClientContext c2;
+  EXPECT_THAT(stub.MutateRow(c2, Options{}, {}),
+              StatusIs(StatusCode::kUnavailable));
+
+  auto const points = pool->Collect();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_EQ(points[0].samples, 0);
+  EXPECT_EQ(points[1].samples, 2);
+  EXPECT_GT(points[1].error_rate, 0);
+}
+
+TEST(BigtableChannelHealthStub, RecordsAsyncUnary) {
+  auto pool = MakePool();
+  auto mock = std::make_shared<MockBigtableStub>();
+  promise<StatusOr<google::bigtable::v2::MutateRowResponse>> p;
+  EXPECT_CALL(*mock, AsyncMutateRow).WillOnce(Return(ByMove(p.get_future())));
+
+  BigtableChannelHealthStub stub(pool, 0, mock);
+  CompletionQueue cq;
+  auto f = stub.AsyncMutateRow(cq, std::make_shared<grpc::ClientContext>(),
+                               internal::MakeImmutableOptions({}), {});
+  EXPECT_EQ(pool->Collect()[0].samples, 0);
+  p.set_value(internal::DeadlineExceededError("too slow"));
+  EXPECT_THAT(f.get(), StatusIs(StatusCode::kDeadlineExceeded));
+
+  auto const points = pool->Collect();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_EQ(points[0].samples, 1);
+  EXPECT_EQ(points[0].error_rate, 1.0);
+}
+
+TEST(BigtableChannelHealthStub, StreamingNotRecorded) {
+  auto pool = MakePool();
+  auto mock = std::make_shared<MockBigtableStub>();
+  EXPECT_CALL(*mock, ReadRows).WillOnce([] {
+    return std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+        google::bigtable::v2::ReadRowsResponse>>{};
+  });
+
+  BigtableChannelHealthStub stub(pool, 0, mock);
+  (void)stub.ReadRows(std::make_shared<grpc::ClientContext>(), Options{}, {});
+  EXPECT_EQ(pool->Collect()[0].samples, 0);
+}
+
+TEST(BigtableChannelHealthStub, ReplaceChild) {
+  auto pool = MakePool();
+  auto old_mock = std::make_shared<MockBigtableStub>();
+  promise<StatusOr<google::bigtable::v2::MutateRowResponse>> p;
+  EXPECT_CALL(*old_mock, AsyncMutateRow)
+      .WillOnce(Return(ByMove(p.get_future())));
+  auto new_mock = std::make_shared<MockBigtableStub>();
+  EXPECT_CALL(*new_mock, PingAndWarm)
+      .WillOnce(Return(google::bigtable::v2::PingAndWarmResponse{}));
+
+  BigtableChannelHealthStub stub(pool, 1, old_mock);
+  CompletionQueue cq;
+  auto f = stub.AsyncMutateRow(cq, std::make_shared<grpc::ClientContext>(),
+                               internal::MakeImmutableOptions({}), {});
+  stub.ReplaceChild(new_mock);
+  grpc::ClientContext context;
+  EXPECT_THAT(stub.PingAndWarm(context, Options{}, {}), IsOk());
+
+  // The RPC on the old child completes, but its result is discarded.
+  p.set_value(internal::UnavailableError("try-again"));
+  EXPECT_THAT(f.get(), StatusIs(StatusCode::kUnavailable));
+
+  auto const points = pool->Collect();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_EQ(points[1].samples, 1);
+  EXPECT_EQ(points[1].error_rate, 0);
+  EXPECT_EQ(points[1].replacements, 1);
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace bigtable_internal
+}  // namespace cloud
+}  // namespace google
@@ -27,13 +27,19 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 /**
  * A container that holds the shared state of timer futures involved in
  * channel refreshing.
+ *
+ * It also owns the object replacing unhealthy channels, if any. The timers
+ * only hold a weak pointer to it.
  */
 class BigtableChannelRefresh : public BigtableStub {
  public:
   explicit BigtableChannelRefresh(
       std::shared_ptr<BigtableStub> child,
-      std::shared_ptr<ConnectionRefreshState> refresh_state)
-      : child_(std::move(child)), refresh_state_(std::move(refresh_state)) {}
+      std::shared_ptr<ConnectionRefreshState> refresh_state,
+      std::shared_ptr<ChannelHealthCheck> health_check = {})
+      : child_(std::move(child)),
+        refresh_state_(std::move(refresh_state)),
+        health_check_(std::move(health_check)) {}
 
   ~BigtableChannelRefresh() override {
     // Eventually the channel refresh chain will terminate after this class is
@@ -130,6 +136,7 @@ class BigtableChannelRefresh : public BigtableStub {
  private:
   std::shared_ptr<BigtableStub> child_;
   std::shared_ptr<ConnectionRefreshState> refresh_state_;
+  std::shared_ptr<ChannelHealthCheck> health_check_;
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
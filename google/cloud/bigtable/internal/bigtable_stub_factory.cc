@@ -14,6 +14,7 @@
 
 #include "google/cloud/bigtable/internal/bigtable_stub_factory.h"
 #include "google/cloud/bigtable/internal/bigtable_auth_decorator.h"
+#include "google/cloud/bigtable/internal/bigtable_channel_health_stub.h"
 #include "google/cloud/bigtable/internal/bigtable_channel_refresh.h"
 #include "google/cloud/bigtable/internal/bigtable_logging_decorator.h"
 #include "google/cloud/bigtable/internal/bigtable_metadata_decorator.h"
@@ -31,6 +32,10 @@
 #include "google/cloud/log.h"
 #include <google/bigtable/v2/feature_flags.pb.h>
 #include <grpcpp/grpcpp.h>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -73,6 +78,33 @@ std::shared_ptr<BigtableStub> CreateBigtableStubRoundRobin(
   return std::make_shared<BigtableRoundRobin>(std::move(children));
 }
 
+std::pair<std::shared_ptr<BigtableStub>, std::shared_ptr<ChannelHealthCheck>>
+CreateBigtableStubHealthCheck(
+    Options const& options, internal::ChannelHealth& health,
+    std::function<std::shared_ptr<BigtableStub>(int)> child_factory) {
+  auto const size = (std::max)(1, options.get<GrpcNumChannelsOption>());
+  auto pool = health.AddPool(static_cast<std::size_t>(size));
+  std::vector<std::shared_ptr<BigtableChannelHealthStub>> children;
+  auto stub = CreateBigtableStubRoundRobin(
+      options, [&pool, &children, &child_factory](int id) {
+        auto child = std::make_shared<BigtableChannelHealthStub>(
+            pool, children.size(), child_factory(id));
+        children.push_back(child);
+        return child;
+      });
+  // The replacement channels need new ids, otherwise gRPC may reuse the
+  // connection of the channel they replace.
+  auto replace = [children = std::move(children),
+                  child_factory = std::move(child_factory),
+                  id = size](std::size_t index) mutable {
+    children.at(index)->ReplaceChild(child_factory(id++));
+  };
+  auto const period = health.check_period();
+  return std::make_pair(
+      std::move(stub), std::make_shared<ChannelHealthCheck>(
+                           std::move(pool), period, std::move(replace)));
+}
+
 std::shared_ptr<BigtableStub> CreateDecoratedStubs(
     std::shared_ptr<internal::GrpcAuthenticationStrategy> auth,
     CompletionQueue const& cq, Options const& options,
@@ -81,16 +113,25 @@ std::shared_ptr<BigtableStub> CreateDecoratedStubs(
   auto refresh = std::make_shared<ConnectionRefreshState>(
       cq_impl, options.get<bigtable::MinConnectionRefreshOption>(),
       options.get<bigtable::MaxConnectionRefreshOption>());
-  auto child_factory = [base_factory, cq_impl, refresh, &auth,
-                        options](int id) {
+  // Capture `auth` by value, the health check may create channels after this
+  // function returns.
+  auto child_factory = [base_factory, cq_impl, refresh, auth, options](int id) {
     auto channel = CreateGrpcChannel(*auth, options, id);
     if (refresh->enabled()) ScheduleChannelRefresh(cq_impl, refresh, channel);
     return base_factory(std::move(channel));
   };
-  auto stub = CreateBigtableStubRoundRobin(options, std::move(child_factory));
-  if (refresh->enabled()) {
-    stub = std::make_shared<BigtableChannelRefresh>(std::move(stub),
-                                                    std::move(refresh));
+  std::shared_ptr<BigtableStub> stub;
+  std::shared_ptr<ChannelHealthCheck> health_check;
+  if (auto health = options.get<ChannelHealthOption>()) {
+    std::tie(stub, health_check) = CreateBigtableStubHealthCheck(
+        options, *health, std::move(child_factory));
+    health_check->Start(cq_impl, refresh);
+  } else {
+    stub = CreateBigtableStubRoundRobin(options, std::move(child_factory));
+  }
+  if (refresh->enabled() || health_check) {
+    stub = std::make_shared<BigtableChannelRefresh>(
+        std::move(stub), std::move(refresh), std::move(health_check));
   }
   if (auth->RequiresConfigureContext()) {
     stub = std::make_shared<BigtableAuth>(std::move(auth), std::move(stub));
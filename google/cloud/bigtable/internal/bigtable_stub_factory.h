@@ -16,12 +16,15 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_BIGTABLE_STUB_FACTORY_H
 
 #include "google/cloud/bigtable/internal/bigtable_stub.h"
+#include "google/cloud/bigtable/internal/connection_refresh_state.h"
 #include "google/cloud/completion_queue.h"
+#include "google/cloud/internal/channel_health.h"
 #include "google/cloud/internal/unified_grpc_credentials.h"
 #include "google/cloud/options.h"
 #include "google/cloud/version.h"
 #include <functional>
 #include <memory>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -35,6 +38,17 @@ std::shared_ptr<BigtableStub> CreateBigtableStubRoundRobin(
     Options const& options,
     std::function<std::shared_ptr<BigtableStub>(int)> child_factory);
 
+/**
+ * Like `CreateBigtableStubRoundRobin()`, but scores the health of each child.
+ *
+ * Returns the stub and the object to replace the unhealthy children. The
+ * replacements are created using @p child_factory, with new ids.
+ */
+std::pair<std::shared_ptr<BigtableStub>, std::shared_ptr<ChannelHealthCheck>>
+CreateBigtableStubHealthCheck(
+    Options const& options, internal::ChannelHealth& health,
+    std::function<std::shared_ptr<BigtableStub>(int)> child_factory);
+
 /// Used in testing to create decorated mocks.
 std::shared_ptr<BigtableStub> CreateDecoratedStubs(
     std::shared_ptr<internal::GrpcAuthenticationStrategy> auth,
@@ -30,6 +30,7 @@
 #include <gmock/gmock.h>
 #include <chrono>
 #include <regex>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -107,6 +108,56 @@ TEST(BigtableStubFactory, RoundRobin) {
   }
 }
 
+TEST(BigtableStubFactory, HealthCheckReplacesUnhealthy) {
+  auto constexpr kTestChannels = 3;
+
+  ::testing::MockFunction<std::shared_ptr<BigtableStub>(int)> factory;
+  EXPECT_CALL(factory, Call).Times(kTestChannels).WillRepeatedly([](int id) {
+    auto mock = std::make_shared<MockBigtableStub>();
+    EXPECT_CALL(*mock, MutateRow)
+        .WillOnce([id](auto&, auto const&, auto const&) {
+          // Much slower than its peers, as a channel connected to an
+          // overloaded frontend would be.
+          if (id == 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+          }
+          return google::bigtable::v2::MutateRowResponse{};
+        });
+    return mock;
+  });
+  // The replacement uses a new channel id.
+  promise<void> replaced;
+  EXPECT_CALL(factory, Call(kTestChannels)).WillOnce([&replaced](int) {
+    replaced.set_value();
+    return std::make_shared<MockBigtableStub>();
+  });
+
+  internal::ChannelHealth health(1, 3.0, std::chrono::milliseconds(1));
+  auto stubs = CreateBigtableStubHealthCheck(
+      Options{}.set<GrpcNumChannelsOption>(kTestChannels), health,
+      factory.AsStdFunction());
+  for (int i = 0; i != kTestChannels; ++i) {
+    grpc::ClientContext context;
+    EXPECT_STATUS_OK(stubs.first->MutateRow(context, Options{}, {}));
+  }
+
+  CompletionQueue cq;
+  std::thread t([&cq] { cq.Run(); });
+  auto cq_impl = internal::GetCompletionQueueImpl(cq);
+  auto state = std::make_shared<ConnectionRefreshState>(
+      cq_impl, std::chrono::milliseconds(0), std::chrono::milliseconds(0));
+  stubs.second->Start(cq_impl, state);
+  replaced.get_future().get();
+  state->timers().CancelAll();
+  cq.Shutdown();
+  t.join();
+
+  auto const points = health.Collect();
+  ASSERT_EQ(points.size(), kTestChannels);
+  EXPECT_EQ(points[1].samples, 0);
+  EXPECT_EQ(points[1].replacements, 1);
+}
+
 // Note that the channel refreshing decorator is tested in
 // bigtable_channel_refresh_test.cc
 
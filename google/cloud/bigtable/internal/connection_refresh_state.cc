@@ -14,6 +14,7 @@
 #include "google/cloud/bigtable/internal/connection_refresh_state.h"
 #include "google/cloud/log.h"
 #include <chrono>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -95,6 +96,42 @@ void ScheduleChannelRefresh(
   state->timers().RegisterTimer(std::move(timer_future));
 }
 
+ChannelHealthCheck::ChannelHealthCheck(
+    std::shared_ptr<internal::ChannelPoolHealth> health,
+    std::chrono::milliseconds period, ReplaceChannel replace)
+    : health_(std::move(health)),
+      period_(period),
+      replace_(std::move(replace)) {}
+
+void ChannelHealthCheck::Start(
+    std::shared_ptr<internal::CompletionQueueImpl> const& cq_impl,
+    std::shared_ptr<ConnectionRefreshState> const& state) {
+  Schedule(cq_impl, state);
+}
+
+void ChannelHealthCheck::Schedule(
+    std::weak_ptr<internal::CompletionQueueImpl> weak_cq_impl,
+    std::shared_ptr<ConnectionRefreshState> const& state) {
+  auto cq_impl = weak_cq_impl.lock();
+  if (!cq_impl) return;
+  auto cq = CompletionQueue(std::move(cq_impl));
+  std::weak_ptr<ChannelHealthCheck> weak_self(shared_from_this());
+  using TimerFuture = future<StatusOr<std::chrono::system_clock::time_point>>;
+  auto timer_future = cq.MakeRelativeTimer(period_).then(
+      [weak_self, weak_cq_impl = std::move(weak_cq_impl),
+       state](TimerFuture fut) {
+        if (!fut.get()) {
+          // Timer cancelled.
+          return;
+        }
+        auto self = weak_self.lock();
+        if (!self) return;
+        if (auto index = self->health_->Unhealthy()) self->replace_(*index);
+        self->Schedule(weak_cq_impl, state);
+      });
+  state->timers().RegisterTimer(std::move(timer_future));
+}
+
 void OutstandingTimers::RegisterTimer(future<void> fut) {
   std::unique_lock<std::mutex> lk(mu_);
   if (shutdown_) {
@@ -18,9 +18,12 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/future.h"
+#include "google/cloud/internal/channel_health.h"
 #include "google/cloud/internal/random.h"
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -30,6 +33,17 @@ namespace cloud {
 namespace bigtable_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
+/**
+ * The channel health scores, if enabled.
+ *
+ * `bigtable::internal::DefaultDataOptions()` sets this option when
+ * `bigtable::experimental::EnableChannelHealthOption` is `true`. Tests may set
+ * it directly to use a different configuration.
+ */
+struct ChannelHealthOption {
+  using Type = std::shared_ptr<internal::ChannelHealth>;
+};
+
 class OutstandingTimers
     : public std::enable_shared_from_this<OutstandingTimers> {
  public:
@@ -88,6 +102,40 @@ void ScheduleChannelRefresh(
     std::shared_ptr<ConnectionRefreshState> const& state,
     std::shared_ptr<grpc::Channel> const& channel);
 
+/**
+ * Replaces the unhealthy channels.
+ *
+ * Every `period`, asks @p health for the unhealthy channel, if any, and calls
+ * `replace` with its index. `replace` is expected to create a new channel, with
+ * a new connection, and start using it for new RPCs. At most one channel is
+ * replaced on each iteration, so a problem affecting all the channels does not
+ * replace all of them at once.
+ *
+ * The timers hold only a weak pointer to this object. The chain of timers stops
+ * when the client releases it.
+ */
+class ChannelHealthCheck
+    : public std::enable_shared_from_this<ChannelHealthCheck> {
+ public:
+  /// Replaces the channel at the given index.
+  using ReplaceChannel = std::function<void(std::size_t)>;
+
+  ChannelHealthCheck(std::shared_ptr<internal::ChannelPoolHealth> health,
+                     std::chrono::milliseconds period, ReplaceChannel replace);
+
+  /// Start the chain of timers, registered in @p state.
+  void Start(std::shared_ptr<internal::CompletionQueueImpl> const& cq_impl,
+             std::shared_ptr<ConnectionRefreshState> const& state);
+
+ private:
+  void Schedule(std::weak_ptr<internal::CompletionQueueImpl> weak_cq_impl,
+                std::shared_ptr<ConnectionRefreshState> const& state);
+
+  std::shared_ptr<internal::ChannelPoolHealth> const health_;
+  std::chrono::milliseconds const period_;
+  ReplaceChannel const replace_;
+};
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace bigtable_internal
 }  // namespace cloud
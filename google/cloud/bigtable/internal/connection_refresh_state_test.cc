@@ -106,6 +106,28 @@ TEST_F(OutstandingTimersTest, TimerRegisteredAfterCancelAllGetCancelled) {
   continuation_promise.get_future().get();
 }
 
+TEST_F(OutstandingTimersTest, ChannelHealthCheckReplacesUnhealthy) {
+  using ms = std::chrono::milliseconds;
+  auto cq_impl = internal::GetCompletionQueueImpl(cq_);
+  auto state = std::make_shared<ConnectionRefreshState>(cq_impl, ms(0), ms(0));
+  auto pool = std::make_shared<internal::ChannelPoolHealth>(0, 3, 1, 3.0);
+  for (std::size_t i = 0; i != 3; ++i) {
+    auto const latency = i == 1 ? ms(100) : ms(10);
+    pool->Record(i, pool->Epoch(i), latency, StatusCode::kOk);
+  }
+
+  promise<std::size_t> replaced;
+  auto check = std::make_shared<ChannelHealthCheck>(
+      pool, ms(1), [&](std::size_t index) {
+        // The replacement has no samples, so it is not replaced again.
+        pool->Reset(index);
+        replaced.set_value(index);
+      });
+  check->Start(cq_impl, state);
+  EXPECT_EQ(replaced.get_future().get(), 1);
+  state->timers().CancelAll();
+}
+
 TEST(ConnectionRefreshState, Enabled) {
   using ms = std::chrono::milliseconds;
   ConnectionRefreshState state(nullptr, ms(0), ms(1000));
@@ -14,12 +14,14 @@
 
 #include "google/cloud/bigtable/internal/defaults.h"
 #include "google/cloud/bigtable/internal/client_options_defaults.h"
+#include "google/cloud/bigtable/internal/connection_refresh_state.h"
 #include "google/cloud/bigtable/internal/rpc_policy_parameters.h"
 #include "google/cloud/bigtable/options.h"
 #include "google/cloud/common_options.h"
 #include "google/cloud/connection_options.h"
 #include "google/cloud/credentials.h"
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/channel_health.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/service_endpoint.h"
 #include "google/cloud/internal/user_agent_prefix.h"
@@ -29,6 +31,7 @@
 #include "absl/algorithm/container.h"
 #include "absl/strings/str_split.h"
 #include <chrono>
+#include <memory>
 #include <string>
 
 namespace google {
@@ -109,6 +112,15 @@ Options DefaultChannelArgumentOptions(Options opts) {
   return opts;
 }
 
+// All the clients share the same object, their channels are scored in
+// separate pools.
+std::shared_ptr<google::cloud::internal::ChannelHealth> DefaultChannelHealth() {
+  static auto* const kHealth =
+      new std::shared_ptr<google::cloud::internal::ChannelHealth>(
+          std::make_shared<google::cloud::internal::ChannelHealth>());
+  return *kHealth;
+}
+
 }  // namespace
 
 int DefaultConnectionPoolSize() {
@@ -253,6 +265,16 @@ Options DefaultDataOptions(Options opts) {
   if (!opts.has<EnableServerRetriesOption>()) {
     opts.set<EnableServerRetriesOption>(true);
   }
+  // Setting the (internal) health option directly also enables the feature.
+  if (!opts.has<experimental::EnableChannelHealthOption>()) {
+    opts.set<experimental::EnableChannelHealthOption>(
+        opts.has<bigtable_internal::ChannelHealthOption>());
+  }
+  if (!opts.get<experimental::EnableChannelHealthOption>()) {
+    opts.unset<bigtable_internal::ChannelHealthOption>();
+  } else if (!opts.has<bigtable_internal::ChannelHealthOption>()) {
+    opts.set<bigtable_internal::ChannelHealthOption>(DefaultChannelHealth());
+  }
   opts = DefaultOptions(std::move(opts));
   if (!opts.has<AuthorityOption>()) {
     auto ep = google::cloud::internal::UniverseDomainEndpoint(
@@ -14,10 +14,12 @@
 
 #include "google/cloud/bigtable/internal/defaults.h"
 #include "google/cloud/bigtable/internal/client_options_defaults.h"
+#include "google/cloud/bigtable/internal/connection_refresh_state.h"
 #include "google/cloud/bigtable/options.h"
 #include "google/cloud/common_options.h"
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/internal/channel_health.h"
 #include "google/cloud/opentelemetry_options.h"
 #include "google/cloud/status.h"
 #include "google/cloud/testing_util/chrono_output.h"
@@ -235,6 +237,34 @@ TEST(OptionsTest, DataEnableServerRetriesOption) {
   EXPECT_FALSE(options.get<EnableServerRetriesOption>());
 }
 
+TEST(OptionsTest, DataChannelHealthOption) {
+  using ::google::cloud::bigtable_internal::ChannelHealthOption;
+  auto options = DefaultDataOptions(Options{});
+  EXPECT_FALSE(options.get<experimental::EnableChannelHealthOption>());
+  EXPECT_FALSE(options.has<ChannelHealthOption>());
+
+  auto const o1 = DefaultDataOptions(
+      Options{}.set<experimental::EnableChannelHealthOption>(true));
+  auto const health = o1.get<ChannelHealthOption>();
+  ASSERT_NE(health, nullptr);
+  // All the clients share the same object.
+  auto const o2 = DefaultDataOptions(
+      Options{}.set<experimental::EnableChannelHealthOption>(true));
+  EXPECT_EQ(o2.get<ChannelHealthOption>(), health);
+
+  auto const custom =
+      std::make_shared<google::cloud::internal::ChannelHealth>();
+  options = DefaultDataOptions(Options{}.set<ChannelHealthOption>(custom));
+  EXPECT_TRUE(options.get<experimental::EnableChannelHealthOption>());
+  EXPECT_EQ(options.get<ChannelHealthOption>(), custom);
+
+  options = DefaultDataOptions(
+      Options{}
+          .set<ChannelHealthOption>(custom)
+          .set<experimental::EnableChannelHealthOption>(false));
+  EXPECT_FALSE(options.has<ChannelHealthOption>());
+}
+
 TEST(OptionsTest, UniverseDomain) {
   auto options =
       Options{}.set<google::cloud::internal::UniverseDomainOption>("ud.net");
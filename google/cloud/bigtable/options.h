@@ -187,6 +187,26 @@ struct BulkApplyThrottlingOption {
   using Type = bool;
 };
 
+/**
+ * If set, the client scores the health of its gRPC channels.
+ *
+ * The client records the latency and transport errors of each unary RPC, such
+ * as `Apply()` or `ReadModifyWriteRow()`, in the channel that carried it.
+ * Streaming RPCs, such as `ReadRows()`, are not recorded. Periodically, the
+ * client compares the channels and replaces the one that is clearly worse than
+ * the rest, for example, because it is connected to an overloaded frontend.
+ * New RPCs use the replacement channel, while any RPCs in progress complete on
+ * the old channel.
+ *
+ * The default is `false`.
+ *
+ * @note This option must be supplied to `MakeDataConnection()` in order to take
+ * effect.
+ */
+struct EnableChannelHealthOption {
+  using Type = bool;
+};
+
 }  // namespace experimental
 
 /// The complete list of options accepted by `bigtable::*Client`
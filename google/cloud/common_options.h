@@ -18,6 +18,7 @@
 #include "google/cloud/internal/attributes.h"
 #include "google/cloud/options.h"
 #include "google/cloud/version.h"
+#include <cstddef>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -291,12 +292,31 @@ struct FieldMaskOption {
   using Type = std::string;
 };
 
+/**
+ * Prefetch pages in `List*()` RPCs.
+ *
+ * By default, paginated `List*()` functions fetch the next page only after
+ * the application consumes all the items in the current page. With this option
+ * set to a value greater than 0, the library fetches up to this many pages in
+ * the background, while the application consumes the current page.
+ *
+ * The pages are fetched sequentially, as each request requires the
+ * `next_page_token` from the previous response. The prefetched pages are kept
+ * in memory until the application consumes them.
+ *
+ * @ingroup options
+ */
+struct PaginationPrefetchDepthOption {
+  using Type = std::size_t;
+};
+
 /**
  * A list of all the common options.
  */
 using CommonOptionList =
     OptionList<EndpointOption, UserAgentProductsOption, LoggingComponentsOption,
-               UserProjectOption, AuthorityOption, CustomHeadersOption>;
+               UserProjectOption, AuthorityOption, CustomHeadersOption,
+               PaginationPrefetchDepthOption>;
 
 /**
  * Enable logging for a set of components.
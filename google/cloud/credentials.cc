@@ -14,12 +14,15 @@
 
 #include "google/cloud/credentials.h"
 #include "google/cloud/internal/credentials_impl.h"
+#include "google/cloud/internal/shared_credentials_cache.h"
 
 namespace google {
 namespace cloud {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
-Credentials::~Credentials() = default;
+Credentials::~Credentials() {
+  internal::ForgetSharedCredentialsCaches(this);
+}
 
 std::shared_ptr<Credentials> MakeInsecureCredentials(Options opts) {
   return std::make_shared<internal::InsecureCredentialsConfig>(std::move(opts));
@@ -129,6 +129,21 @@ TEST(FutureCoroutines, Threads) {
   EXPECT_GE(ids.size(), 2);
 }
 
+future<std::thread::id> ResumedOn(future<void> f) {
+  co_await std::move(f);
+  co_return std::this_thread::get_id();
+}
+
+TEST(FutureCoroutines, ResumesInSatisfyingThread) {
+  promise<void> p;
+  auto pending = ResumedOn(p.get_future());
+  EXPECT_FALSE(pending.is_ready());
+  std::thread t([](promise<void> p) { p.set_value(); }, std::move(p));
+  auto const id = t.get_id();
+  t.join();
+  EXPECT_EQ(pending.get(), id);
+}
+
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 future<void> TestThrowVoid(future<void> t) { co_return co_await std::move(t); }
 
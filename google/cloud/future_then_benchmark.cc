@@ -0,0 +1,126 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <benchmark/benchmark.h>
+#include <utility>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// Run on (1 X 2100 MHz CPU )
+// CPU Caches:
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// Load Average: 0.47, 0.58, 1.08
+// --------------------------------------------------------------------
+// Benchmark                          Time             CPU   Iterations
+// --------------------------------------------------------------------
+// BM_FuturePromiseGet              278 ns          272 ns      2589333
+// BM_FutureThenReady               818 ns          812 ns       849453
+// BM_FutureThenChain/1             764 ns          755 ns       934017
+// BM_FutureThenChain/8            4849 ns         4812 ns       146047
+// BM_FutureThenChain/64          36157 ns        36028 ns        19410
+// BM_FutureThenChainVoid/1         126 ns          123 ns      5717445
+// BM_FutureThenChainVoid/8         759 ns          751 ns       921482
+// BM_FutureThenChainVoid/64       6510 ns         6436 ns       111863
+// BM_FutureThenUnwrap/1           1085 ns         1077 ns       641020
+// BM_FutureThenUnwrap/8           7730 ns         7686 ns        88597
+// BM_FutureThenUnwrap/64         60242 ns        59837 ns        11754
+//
+// With a mutex in every shared state operation, a heap allocated object for
+// each continuation, and an intermediate shared state for each `.then()`,
+// BM_FuturePromiseGet ran at 436 ns, BM_FutureThenChain/64 at 93008 ns,
+// BM_FutureThenChainVoid/64 at 12961 ns, and BM_FutureThenUnwrap/64 at
+// 97502 ns.
+
+/// Satisfy a promise and retrieve the value, the simplest possible use.
+void BM_FuturePromiseGet(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<StatusOr<int>> p;
+    auto f = p.get_future();
+    p.set_value(42);
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FuturePromiseGet);
+
+/// Attach a continuation to a future that is already satisfied.
+void BM_FutureThenReady(benchmark::State& state) {
+  for (auto _ : state) {
+    auto f = make_ready_future(StatusOr<int>(42)).then(
+        [](future<StatusOr<int>> g) { return g.get(); });
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureThenReady);
+
+/// Build a chain of continuations and then satisfy the first future, this is
+/// how most retry loops and stream wrappers use futures.
+void BM_FutureThenChain(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<StatusOr<int>> p;
+    auto f = p.get_future();
+    for (auto i = state.range(0); i != 0; --i) {
+      f = f.then([](future<StatusOr<int>> g) {
+        auto v = g.get();
+        if (!v) return v;
+        return StatusOr<int>(*v + 1);
+      });
+    }
+    p.set_value(0);
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureThenChain)->Range(1, 64);
+
+/// Same as BM_FutureThenChain, with `future<void>`.
+void BM_FutureThenChainVoid(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<void> p;
+    auto f = p.get_future();
+    for (auto i = state.range(0); i != 0; --i) {
+      f = f.then([](future<void> g) { g.get(); });
+    }
+    p.set_value();
+    f.get();
+  }
+}
+BENCHMARK(BM_FutureThenChainVoid)->Range(1, 64);
+
+/// Continuations that return a future, which `.then()` must unwrap.
+void BM_FutureThenUnwrap(benchmark::State& state) {
+  for (auto _ : state) {
+    promise<StatusOr<int>> p;
+    auto f = p.get_future();
+    for (auto i = state.range(0); i != 0; --i) {
+      f = f.then([](future<StatusOr<int>> g) {
+        return make_ready_future(StatusOr<int>(*g.get() + 1));
+      });
+    }
+    p.set_value(0);
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureThenUnwrap)->Range(1, 64);
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
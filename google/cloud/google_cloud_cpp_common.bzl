@@ -31,6 +31,7 @@ google_cloud_cpp_common_hdrs = [
     "internal/absl_str_replace_quiet.h",
     "internal/algorithm.h",
     "internal/api_client_header.h",
+    "internal/atomic_shared_ptr.h",
     "internal/attributes.h",
     "internal/auth_header_error.h",
     "internal/backoff_policy.h",
@@ -38,6 +39,7 @@ google_cloud_cpp_common_hdrs = [
     "internal/big_endian.h",
     "internal/build_info.h",
     "internal/call_context.h",
+    "internal/channel_health.h",
     "internal/clock.h",
     "internal/compiler_info.h",
     "internal/compute_engine_util.h",
@@ -75,16 +77,19 @@ google_cloud_cpp_common_hdrs = [
     "internal/retry_info.h",
     "internal/retry_loop_helpers.h",
     "internal/retry_policy_impl.h",
+    "internal/rpc_metrics.h",
     "internal/service_endpoint.h",
     "internal/sha256_hash.h",
     "internal/sha256_hmac.h",
     "internal/sha256_type.h",
+    "internal/shared_credentials_cache.h",
     "internal/status_payload_keys.h",
     "internal/status_utils.h",
     "internal/strerror.h",
     "internal/subject_token.h",
     "internal/throw_delegate.h",
     "internal/timer_queue.h",
+    "internal/timing_wheel.h",
     "internal/trace_propagator.h",
     "internal/traced_stream_range.h",
     "internal/tuple.h",
@@ -121,6 +126,7 @@ google_cloud_cpp_common_srcs = [
     "internal/auth_header_error.cc",
     "internal/backoff_policy.cc",
     "internal/base64_transforms.cc",
+    "internal/channel_health.cc",
     "internal/compiler_info.cc",
     "internal/compute_engine_util.cc",
     "internal/credentials_impl.cc",
@@ -143,9 +149,11 @@ google_cloud_cpp_common_srcs = [
     "internal/random.cc",
     "internal/retry_loop_helpers.cc",
     "internal/retry_policy_impl.cc",
+    "internal/rpc_metrics.cc",
     "internal/service_endpoint.cc",
     "internal/sha256_hash.cc",
     "internal/sha256_hmac.cc",
+    "internal/shared_credentials_cache.cc",
     "internal/status_payload_keys.cc",
     "internal/status_utils.cc",
     "internal/strerror.cc",
@@ -48,6 +48,7 @@ add_library(
     internal/algorithm.h
     internal/api_client_header.cc
     internal/api_client_header.h
+    internal/atomic_shared_ptr.h
     internal/attributes.h
     internal/auth_header_error.cc
     internal/auth_header_error.h
@@ -58,6 +59,8 @@ add_library(
     internal/big_endian.h
     internal/build_info.h
     internal/call_context.h
+    internal/channel_health.cc
+    internal/channel_health.h
     internal/clock.h
     internal/compiler_info.cc
     internal/compiler_info.h
@@ -117,6 +120,8 @@ add_library(
     internal/retry_loop_helpers.h
     internal/retry_policy_impl.cc
     internal/retry_policy_impl.h
+    internal/rpc_metrics.cc
+    internal/rpc_metrics.h
     internal/service_endpoint.cc
     internal/service_endpoint.h
     internal/sha256_hash.cc
@@ -124,6 +129,8 @@ add_library(
     internal/sha256_hmac.cc
     internal/sha256_hmac.h
     internal/sha256_type.h
+    internal/shared_credentials_cache.cc
+    internal/shared_credentials_cache.h
     internal/status_payload_keys.cc
     internal/status_payload_keys.h
     internal/status_utils.cc
@@ -136,6 +143,7 @@ add_library(
     internal/throw_delegate.h
     internal/timer_queue.cc
     internal/timer_queue.h
+    internal/timing_wheel.h
     internal/trace_propagator.cc
     internal/trace_propagator.h
     internal/traced_stream_range.h
@@ -361,6 +369,7 @@ if (BUILD_TESTING)
         internal/base64_transforms_test.cc
         internal/big_endian_test.cc
         internal/call_context_test.cc
+        internal/channel_health_test.cc
         internal/clock_test.cc
         internal/compiler_info_test.cc
         internal/compute_engine_util_test.cc
@@ -386,15 +395,18 @@ if (BUILD_TESTING)
         internal/random_test.cc
         internal/retry_loop_helpers_test.cc
         internal/retry_policy_impl_test.cc
+        internal/rpc_metrics_test.cc
         internal/service_endpoint_test.cc
         internal/sha256_hash_test.cc
         internal/sha256_hmac_test.cc
+        internal/shared_credentials_cache_test.cc
         internal/status_payload_keys_test.cc
         internal/status_utils_test.cc
         internal/strerror_test.cc
         internal/subject_token_test.cc
         internal/throw_delegate_test.cc
         internal/timer_queue_test.cc
+        internal/timing_wheel_test.cc
         internal/trace_propagator_test.cc
         internal/traced_stream_range_test.cc
         internal/tuple_test.cc
@@ -435,8 +447,11 @@ if (BUILD_TESTING)
         add_test(NAME ${target} COMMAND ${target})
     endforeach ()
 
-    set(google_cloud_cpp_common_benchmarks # cmake-format: sort
-                                           options_benchmark.cc)
+    set(google_cloud_cpp_common_benchmarks
+        # cmake-format: sort
+        future_then_benchmark.cc internal/log_impl_benchmark.cc
+        internal/rfc3339_benchmark.cc internal/timer_queue_benchmark.cc
+        options_benchmark.cc)
 
     # Export the list of benchmarks to a .bzl file so we do not need to maintain
     # the list in two places.
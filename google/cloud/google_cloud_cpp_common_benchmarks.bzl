@@ -17,5 +17,9 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 google_cloud_cpp_common_benchmarks = [
+    "future_then_benchmark.cc",
+    "internal/log_impl_benchmark.cc",
+    "internal/rfc3339_benchmark.cc",
+    "internal/timer_queue_benchmark.cc",
     "options_benchmark.cc",
 ]
@@ -30,6 +30,7 @@ google_cloud_cpp_common_unit_tests = [
     "internal/base64_transforms_test.cc",
     "internal/big_endian_test.cc",
     "internal/call_context_test.cc",
+    "internal/channel_health_test.cc",
     "internal/clock_test.cc",
     "internal/compiler_info_test.cc",
     "internal/compute_engine_util_test.cc",
@@ -55,15 +56,18 @@ google_cloud_cpp_common_unit_tests = [
     "internal/random_test.cc",
     "internal/retry_loop_helpers_test.cc",
     "internal/retry_policy_impl_test.cc",
+    "internal/rpc_metrics_test.cc",
     "internal/service_endpoint_test.cc",
     "internal/sha256_hash_test.cc",
     "internal/sha256_hmac_test.cc",
+    "internal/shared_credentials_cache_test.cc",
     "internal/status_payload_keys_test.cc",
     "internal/status_utils_test.cc",
     "internal/strerror_test.cc",
     "internal/subject_token_test.cc",
     "internal/throw_delegate_test.cc",
     "internal/timer_queue_test.cc",
+    "internal/timing_wheel_test.cc",
     "internal/trace_propagator_test.cc",
     "internal/traced_stream_range_test.cc",
     "internal/tuple_test.cc",
@@ -39,6 +39,7 @@ google_cloud_cpp_grpc_utils_hdrs = [
     "internal/async_read_write_stream_timeout.h",
     "internal/async_read_write_stream_tracing.h",
     "internal/async_retry_loop.h",
+    "internal/async_retry_loop_coroutines.h",
     "internal/async_retry_unary_rpc.h",
     "internal/async_rpc_details.h",
     "internal/async_streaming_read_rpc.h",
@@ -54,6 +55,7 @@ google_cloud_cpp_grpc_utils_hdrs = [
     "internal/async_streaming_write_rpc_timeout.h",
     "internal/async_streaming_write_rpc_tracing.h",
     "internal/background_threads_impl.h",
+    "internal/completion_queue_coroutines.h",
     "internal/completion_queue_impl.h",
     "internal/debug_string_protobuf.h",
     "internal/debug_string_status.h",
@@ -66,6 +68,7 @@ google_cloud_cpp_grpc_utils_hdrs = [
     "internal/grpc_metadata_view.h",
     "internal/grpc_opentelemetry.h",
     "internal/grpc_request_metadata.h",
+    "internal/grpc_rpc_metrics.h",
     "internal/grpc_service_account_authentication.h",
     "internal/log_wrapper.h",
     "internal/minimal_iam_credentials_stub.h",
@@ -103,6 +106,7 @@ google_cloud_cpp_grpc_utils_srcs = [
     "internal/grpc_impersonate_service_account.cc",
     "internal/grpc_opentelemetry.cc",
     "internal/grpc_request_metadata.cc",
+    "internal/grpc_rpc_metrics.cc",
     "internal/grpc_service_account_authentication.cc",
     "internal/log_wrapper.cc",
     "internal/minimal_iam_credentials_stub.cc",
@@ -45,6 +45,7 @@ add_library(
     internal/async_read_write_stream_timeout.h
     internal/async_read_write_stream_tracing.h
     internal/async_retry_loop.h
+    internal/async_retry_loop_coroutines.h
     internal/async_retry_unary_rpc.h
     internal/async_rpc_details.h
     internal/async_streaming_read_rpc.h
@@ -61,6 +62,7 @@ add_library(
     internal/async_streaming_write_rpc_tracing.h
     internal/background_threads_impl.cc
     internal/background_threads_impl.h
+    internal/completion_queue_coroutines.h
     internal/completion_queue_impl.h
     internal/debug_string_protobuf.cc
     internal/debug_string_protobuf.h
@@ -83,6 +85,8 @@ add_library(
     internal/grpc_opentelemetry.h
     internal/grpc_request_metadata.cc
     internal/grpc_request_metadata.h
+    internal/grpc_rpc_metrics.cc
+    internal/grpc_rpc_metrics.h
     internal/grpc_service_account_authentication.cc
     internal/grpc_service_account_authentication.h
     internal/log_wrapper.cc
@@ -235,6 +239,7 @@ if (BUILD_TESTING)
         internal/async_read_write_stream_logging_test.cc
         internal/async_read_write_stream_timeout_test.cc
         internal/async_read_write_stream_tracing_test.cc
+        internal/async_retry_loop_coroutines_test.cc
         internal/async_retry_loop_test.cc
         internal/async_retry_unary_rpc_test.cc
         internal/async_streaming_read_rpc_auth_test.cc
@@ -248,6 +253,7 @@ if (BUILD_TESTING)
         internal/async_streaming_write_rpc_timeout_test.cc
         internal/async_streaming_write_rpc_tracing_test.cc
         internal/background_threads_impl_test.cc
+        internal/completion_queue_coroutines_test.cc
         internal/debug_string_protobuf_test.cc
         internal/debug_string_status_test.cc
         internal/extract_long_running_result_test.cc
@@ -256,6 +262,7 @@ if (BUILD_TESTING)
         internal/grpc_channel_credentials_authentication_test.cc
         internal/grpc_opentelemetry_test.cc
         internal/grpc_request_metadata_test.cc
+        internal/grpc_rpc_metrics_test.cc
         internal/grpc_service_account_authentication_test.cc
         internal/log_wrapper_test.cc
         internal/minimal_iam_credentials_stub_test.cc
@@ -321,8 +328,9 @@ if (BUILD_TESTING)
         endif ()
     endforeach ()
 
-    set(google_cloud_cpp_grpc_utils_benchmarks # cmake-format: sortable
-                                               completion_queue_benchmark.cc)
+    set(google_cloud_cpp_grpc_utils_benchmarks
+        # cmake-format: sortable
+        completion_queue_benchmark.cc internal/grpc_opentelemetry_benchmark.cc)
 
     # Export the list of benchmarks to a .bzl file so we do not need to maintain
     # the list in two places.
@@ -337,6 +345,9 @@ if (BUILD_TESTING)
             ${target}
             PRIVATE google-cloud-cpp::grpc_utils google-cloud-cpp::common
                     benchmark::benchmark_main)
+        if (opentelemetry-cpp_FOUND)
+            target_link_libraries(${target} PRIVATE opentelemetry-cpp::trace)
+        endif ()
         google_cloud_cpp_add_common_options(${target})
     endforeach ()
 endif ()
@@ -18,4 +18,5 @@
 
 google_cloud_cpp_grpc_utils_benchmarks = [
     "completion_queue_benchmark.cc",
+    "internal/grpc_opentelemetry_benchmark.cc",
 ]
@@ -29,6 +29,7 @@ google_cloud_cpp_grpc_utils_unit_tests = [
     "internal/async_read_write_stream_logging_test.cc",
     "internal/async_read_write_stream_timeout_test.cc",
     "internal/async_read_write_stream_tracing_test.cc",
+    "internal/async_retry_loop_coroutines_test.cc",
     "internal/async_retry_loop_test.cc",
     "internal/async_retry_unary_rpc_test.cc",
     "internal/async_streaming_read_rpc_auth_test.cc",
@@ -42,6 +43,7 @@ google_cloud_cpp_grpc_utils_unit_tests = [
     "internal/async_streaming_write_rpc_timeout_test.cc",
     "internal/async_streaming_write_rpc_tracing_test.cc",
     "internal/background_threads_impl_test.cc",
+    "internal/completion_queue_coroutines_test.cc",
     "internal/debug_string_protobuf_test.cc",
     "internal/debug_string_status_test.cc",
     "internal/extract_long_running_result_test.cc",
@@ -50,6 +52,7 @@ google_cloud_cpp_grpc_utils_unit_tests = [
     "internal/grpc_channel_credentials_authentication_test.cc",
     "internal/grpc_opentelemetry_test.cc",
     "internal/grpc_request_metadata_test.cc",
+    "internal/grpc_rpc_metrics_test.cc",
     "internal/grpc_service_account_authentication_test.cc",
     "internal/log_wrapper_test.cc",
     "internal/minimal_iam_credentials_stub_test.cc",
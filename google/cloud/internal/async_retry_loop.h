@@ -22,6 +22,7 @@
 #include "google/cloud/idempotency.h"
 #include "google/cloud/internal/call_context.h"
 #include "google/cloud/internal/grpc_opentelemetry.h"
+#include "google/cloud/internal/grpc_rpc_metrics.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/retry_loop_helpers.h"
 #include "google/cloud/internal/setup_context.h"
@@ -188,6 +189,7 @@ class AsyncRetryLoopImpl
         functor_(std::forward<Functor>(functor)),
         request_(std::move(request)),
         location_(location),
+        metrics_(*options, location),
         call_context_(std::move(options)) {}
 
   using ReturnType = ::google::cloud::internal::invoke_result_t<
@@ -238,10 +240,12 @@ class AsyncRetryLoopImpl
     auto context = std::make_shared<grpc::ClientContext>();
     ConfigureContext(*context, *call_context_.options);
     SetupContext<RetryPolicyType>::Setup(*retry_policy_, *context);
-    SetPending(
-        state.operation,
-        functor_(cq_, std::move(context), call_context_.options, request_)
-            .then([self](future<T> f) { self->OnAttempt(f.get()); }));
+    metrics_.OnAttemptStart();
+    SetPending(state.operation,
+               functor_(cq_, context, call_context_.options, request_)
+                   .then([self, context](future<T> f) {
+                     self->OnAttempt(f.get(), *context);
+                   }));
   }
 
   void StartBackoff(std::chrono::milliseconds delay) {
@@ -255,7 +259,8 @@ class AsyncRetryLoopImpl
                                     }));
   }
 
-  void OnAttempt(T result) {
+  void OnAttempt(T result, grpc::ClientContext& context) {
+    metrics_.OnAttemptEnd(context, GetResultCode(result));
     // A successful attempt, set the value and finish the loop.
     if (result.ok()) return SetDone(std::move(result));
     // Some kind of failure, first verify that it is retryable.
@@ -288,23 +293,30 @@ class AsyncRetryLoopImpl
   // Handle the case where the retry loop finishes due to a successful request
   // or the retry policies getting exhausted.
   void SetDone(T value) {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (done_) return;
-    done_ = true;
-    lk.unlock();
-    result_.set_value(std::move(value));
+    auto const code = GetResultCode(value);
+    Finish(std::move(value), code);
   }
 
   // Handle the case where the retry loop finishes due to a successful cancel
   // request.
   State SetDoneWithCancel(std::unique_lock<std::mutex> lk) {
-    if (done_) return State{true, 0};
-    done_ = true;
     lk.unlock();
-    result_.set_value(RetryLoopCancelled(last_status_, location_));
+    Finish(RetryLoopCancelled(last_status_, location_), StatusCode::kCancelled);
     return State{true, 0};
   }
 
+  // The loop finishes only here, and only in its own callbacks, never in the
+  // thread calling `Cancel()`. The operation metrics are recorded once, after
+  // the last attempt has ended.
+  void Finish(T value, StatusCode code) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (done_) return;
+    done_ = true;
+    lk.unlock();
+    metrics_.OnOperationEnd(code);
+    result_.set_value(std::move(value));
+  }
+
   void Cancel() { return Cancel(std::unique_lock<std::mutex>{mu_}); }
 
   void Cancel(std::unique_lock<std::mutex> lk) {
@@ -322,6 +334,7 @@ class AsyncRetryLoopImpl
   std::decay_t<Functor> functor_;
   Request request_;
   char const* location_ = "unknown";
+  RpcMetricsOperation metrics_;
   CallContext call_context_;
   Status last_status_;
   promise<T> result_;
@@ -0,0 +1,122 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_RETRY_LOOP_COROUTINES_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_RETRY_LOOP_COROUTINES_H
+
+#include "google/cloud/internal/port_platform.h"
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#include "google/cloud/backoff_policy.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/idempotency.h"
+#include "google/cloud/internal/async_retry_loop.h"
+#include "google/cloud/internal/call_context.h"
+#include "google/cloud/internal/future_coroutines.h"
+#include "google/cloud/internal/grpc_opentelemetry.h"
+#include "google/cloud/internal/grpc_rpc_metrics.h"
+#include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/retry_loop_helpers.h"
+#include "google/cloud/internal/setup_context.h"
+#include "google/cloud/options.h"
+#include "google/cloud/version.h"
+#include <grpcpp/grpcpp.h>
+#include <memory>
+#include <type_traits>
+
+namespace google::cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/**
+ * Implement an asynchronous retry loop for wrapped gRPC requests as a
+ * coroutine.
+ *
+ * This is an alternative to `AsyncRetryLoop()`, with the same signature and
+ * the same policies, metrics, and error messages. Instead of an object that
+ * chains callbacks through `.then()`, the loop is a single coroutine: each
+ * attempt and each backoff timer is a `co_await` expression, and the
+ * coroutine resumes in the thread that satisfies the attempt or timer, which
+ * is typically a completion queue thread.
+ *
+ * @par Cancellation
+ *
+ * Cancelling the returned future has no effect. The loop stops once the retry
+ * policy is exhausted, or the completion queue is shutdown. Use
+ * `AsyncRetryLoop()` if the operation must be cancellable.
+ *
+ * @note All the parameters are taken by value, as they must remain valid
+ *     after the coroutine suspends.
+ */
+template <typename Functor, typename Request, typename RetryPolicyType,
+          std::enable_if_t<google::cloud::internal::is_invocable<
+                               Functor&, google::cloud::CompletionQueue&,
+                               std::shared_ptr<grpc::ClientContext>,
+                               ImmutableOptions, Request const&>::value,
+                           int> = 0>
+auto AsyncRetryLoopCoroutine(std::unique_ptr<RetryPolicyType> retry_policy,
+                             std::unique_ptr<BackoffPolicy> backoff_policy,
+                             Idempotency idempotency,
+                             google::cloud::CompletionQueue cq,
+                             Functor functor, ImmutableOptions options,
+                             Request request, char const* location)
+    -> google::cloud::internal::invoke_result_t<
+        Functor&, google::cloud::CompletionQueue&,
+        std::shared_ptr<grpc::ClientContext>, ImmutableOptions,
+        Request const&> {
+  using ReturnType = ::google::cloud::internal::invoke_result_t<
+      Functor&, google::cloud::CompletionQueue&,
+      std::shared_ptr<grpc::ClientContext>, ImmutableOptions, Request const&>;
+  using T = typename FutureValueType<ReturnType>::value_type;
+
+  auto const enable_server_retries = options->get<EnableServerRetriesOption>();
+  RpcMetricsOperation metrics(*options, location);
+  auto done = [&metrics](T value) {
+    metrics.OnOperationEnd(GetResultCode(value));
+    return value;
+  };
+
+  Status last_status;
+  while (!retry_policy->IsExhausted()) {
+    auto context = std::make_shared<grpc::ClientContext>();
+    ConfigureContext(*context, *options);
+    SetupContext<RetryPolicyType>::Setup(*retry_policy, *context);
+    metrics.OnAttemptStart();
+    T result = co_await functor(cq, context, options, request);
+    metrics.OnAttemptEnd(*context, GetResultCode(result));
+    // A successful attempt, set the value and finish the loop.
+    if (result.ok()) co_return done(std::move(result));
+    // Some kind of failure, first verify that it is retryable.
+    last_status = GetResultStatus(std::move(result));
+    auto delay =
+        Backoff(last_status, location, *retry_policy, *backoff_policy,
+                idempotency, enable_server_retries);
+    if (!delay) co_return done(std::move(delay).status());
+    auto tp =
+        co_await TracedAsyncBackoff(cq, *options, *delay, "Async Backoff");
+    if (!tp) {
+      // Some kind of error in the CompletionQueue, probably shutting down.
+      co_return done(RetryLoopCancelled(std::move(tp).status(), location));
+    }
+  }
+  co_return done(RetryLoopPolicyExhaustedError(last_status, location));
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_RETRY_LOOP_COROUTINES_H
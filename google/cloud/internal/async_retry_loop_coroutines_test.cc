@@ -0,0 +1,282 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/async_retry_loop_coroutines.h"
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/internal/retry_policy_impl.h"
+#include "google/cloud/options.h"
+#include "google/cloud/testing_util/mock_backoff_policy.h"
+#include "google/cloud/testing_util/mock_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google::cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::MockBackoffPolicy;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Contains;
+using ::testing::HasSubstr;
+using ::testing::Pair;
+using ::testing::Return;
+
+struct TestOption {
+  using Type = std::string;
+};
+
+struct TestRetryablePolicy {
+  static bool IsPermanentFailure(google::cloud::Status const& s) {
+    return !s.ok() &&
+           (s.code() == google::cloud::StatusCode::kPermissionDenied);
+  }
+};
+
+auto constexpr kMaxRetries = 5;
+std::unique_ptr<RetryPolicy> TestRetryPolicy() {
+  return LimitedErrorCountRetryPolicy<TestRetryablePolicy>(kMaxRetries).clone();
+}
+
+std::unique_ptr<BackoffPolicy> TestBackoffPolicy() {
+  return ExponentialBackoffPolicy(std::chrono::microseconds(1),
+                                  std::chrono::microseconds(5), 2.0)
+      .clone();
+}
+
+using TimerResult = StatusOr<std::chrono::system_clock::time_point>;
+
+TEST(AsyncRetryLoopCoroutineTest, Success) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      background.cq(),
+      [](google::cloud::CompletionQueue&, auto, ImmutableOptions const& options,
+         int request) -> future<StatusOr<int>> {
+        EXPECT_EQ(options->get<TestOption>(), "Success");
+        return make_ready_future(StatusOr<int>(2 * request));
+      },
+      MakeImmutableOptions(Options{}.set<TestOption>("Success")),
+      /*request=*/42, /*location=*/"error message");
+  StatusOr<int> actual = pending.get();
+  ASSERT_THAT(actual.status(), IsOk());
+  EXPECT_EQ(84, *actual);
+}
+
+TEST(AsyncRetryLoopCoroutineTest, TransientThenSuccess) {
+  int counter = 0;
+  AutomaticallyCreatedBackgroundThreads background;
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      background.cq(),
+      [&](google::cloud::CompletionQueue&, auto,
+          ImmutableOptions const& options, int request) {
+        EXPECT_EQ(options->get<TestOption>(), "TransientThenSuccess");
+        if (++counter < 3) {
+          return make_ready_future(
+              StatusOr<int>(Status(StatusCode::kUnavailable, "try again")));
+        }
+        return make_ready_future(StatusOr<int>(2 * request));
+      },
+      MakeImmutableOptions(Options{}.set<TestOption>("TransientThenSuccess")),
+      42, "error message");
+  StatusOr<int> actual = pending.get();
+  ASSERT_THAT(actual.status(), IsOk());
+  EXPECT_EQ(84, *actual);
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(AsyncRetryLoopCoroutineTest, ReturnJustStatus) {
+  int counter = 0;
+  AutomaticallyCreatedBackgroundThreads background;
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      background.cq(),
+      [&](google::cloud::CompletionQueue&, auto, ImmutableOptions const&,
+          int) {
+        if (++counter <= 3) {
+          return make_ready_future(
+              Status(StatusCode::kResourceExhausted, "slow-down"));
+        }
+        return make_ready_future(Status());
+      },
+      MakeImmutableOptions(Options{}), 42, "error message");
+  Status actual = pending.get();
+  ASSERT_THAT(actual, IsOk());
+}
+
+/// @test Verify the backoff policy is queried after each failure.
+TEST(AsyncRetryLoopCoroutineTest, UsesBackoffPolicy) {
+  using ms = std::chrono::milliseconds;
+
+  std::unique_ptr<MockBackoffPolicy> mock(new MockBackoffPolicy);
+  EXPECT_CALL(*mock, OnCompletion()).Times(3).WillRepeatedly(Return(ms(1)));
+
+  int counter = 0;
+  AutomaticallyCreatedBackgroundThreads background;
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), std::move(mock), Idempotency::kIdempotent,
+      background.cq(),
+      [&](google::cloud::CompletionQueue&, auto, ImmutableOptions const&,
+          int request) {
+        if (++counter <= 3) {
+          return make_ready_future(
+              StatusOr<int>(Status(StatusCode::kUnavailable, "try again")));
+        }
+        return make_ready_future(StatusOr<int>(2 * request));
+      },
+      MakeImmutableOptions(Options{}), 42, "error message");
+  StatusOr<int> actual = pending.get();
+  ASSERT_THAT(actual.status(), IsOk());
+  EXPECT_EQ(84, *actual);
+}
+
+TEST(AsyncRetryLoopCoroutineTest, TransientFailureNonIdempotent) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kNonIdempotent,
+      background.cq(),
+      [](google::cloud::CompletionQueue&, auto, ImmutableOptions const&, int) {
+        return make_ready_future(StatusOr<int>(
+            Status(StatusCode::kUnavailable, "test-message-try-again")));
+      },
+      MakeImmutableOptions(Options{}), 42, "test-location");
+  StatusOr<int> actual = pending.get();
+  EXPECT_THAT(actual, StatusIs(StatusCode::kUnavailable,
+                               HasSubstr("test-message-try-again")));
+  auto const& metadata = actual.status().error_info().metadata();
+  EXPECT_THAT(metadata,
+              Contains(Pair("gcloud-cpp.retry.reason", "non-idempotent")));
+  EXPECT_THAT(metadata,
+              Contains(Pair("gcloud-cpp.retry.function", "test-location")));
+}
+
+TEST(AsyncRetryLoopCoroutineTest, PermanentFailureIdempotent) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      background.cq(),
+      [](google::cloud::CompletionQueue&, auto, ImmutableOptions const&, int) {
+        return make_ready_future(StatusOr<int>(
+            Status(StatusCode::kPermissionDenied, "test-message-uh-oh")));
+      },
+      MakeImmutableOptions(Options{}), 42, "test-location");
+  StatusOr<int> actual = pending.get();
+  EXPECT_THAT(actual, StatusIs(StatusCode::kPermissionDenied,
+                               HasSubstr("test-message-uh-oh")));
+  auto const& metadata = actual.status().error_info().metadata();
+  EXPECT_THAT(metadata,
+              Contains(Pair("gcloud-cpp.retry.reason", "permanent-error")));
+  EXPECT_THAT(metadata,
+              Contains(Pair("gcloud-cpp.retry.function", "test-location")));
+}
+
+TEST(AsyncRetryLoopCoroutineTest, TooManyTransientFailuresIdempotent) {
+  int counter = 0;
+  AutomaticallyCreatedBackgroundThreads background;
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      background.cq(),
+      [&](google::cloud::CompletionQueue&, auto, ImmutableOptions const&,
+          int) {
+        ++counter;
+        return make_ready_future(StatusOr<int>(
+            Status(StatusCode::kUnavailable, "test-message-try-again")));
+      },
+      MakeImmutableOptions(Options{}), 42, "test-location");
+  StatusOr<int> actual = pending.get();
+  EXPECT_THAT(actual, StatusIs(StatusCode::kUnavailable,
+                               HasSubstr("test-message-try-again")));
+  EXPECT_EQ(counter, kMaxRetries + 1);
+  auto const& metadata = actual.status().error_info().metadata();
+  EXPECT_THAT(metadata, Contains(Pair("gcloud-cpp.retry.reason",
+                                      "retry-policy-exhausted")));
+  EXPECT_THAT(metadata, Contains(Pair("gcloud-cpp.retry.on-entry", "false")));
+  EXPECT_THAT(metadata,
+              Contains(Pair("gcloud-cpp.retry.function", "test-location")));
+}
+
+TEST(AsyncRetryLoopCoroutineTest, ExhaustedBeforeStart) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto policy = TestRetryPolicy();
+  for (int i = 0; i <= kMaxRetries; ++i) {
+    policy->OnFailure(Status(StatusCode::kUnavailable, "try-again"));
+  }
+  ASSERT_TRUE(policy->IsExhausted());
+  StatusOr<int> actual =
+      AsyncRetryLoopCoroutine(
+          std::move(policy), TestBackoffPolicy(), Idempotency::kIdempotent,
+          background.cq(),
+          [](google::cloud::CompletionQueue&, auto, auto const&, int) {
+            ADD_FAILURE() << "unexpected call to functor";
+            return make_ready_future(StatusOr<int>(0));
+          },
+          MakeImmutableOptions(Options{}), 42, "test-location")
+          .get();
+  EXPECT_THAT(actual, StatusIs(StatusCode::kDeadlineExceeded));
+  auto const& metadata = actual.status().error_info().metadata();
+  EXPECT_THAT(metadata, Contains(Pair("gcloud-cpp.retry.on-entry", "true")));
+}
+
+TEST(AsyncRetryLoopCoroutineTest, ShutdownDuringTimer) {
+  auto mock = std::make_shared<testing_util::MockCompletionQueueImpl>();
+  EXPECT_CALL(*mock, MakeRelativeTimer).WillOnce([] {
+    return make_ready_future(
+        TimerResult(Status(StatusCode::kCancelled, "timer cancelled")));
+  });
+  google::cloud::CompletionQueue cq(mock);
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent, cq,
+      [](google::cloud::CompletionQueue&, auto, auto const&, int) {
+        return make_ready_future(
+            StatusOr<int>(Status(StatusCode::kUnavailable, "try-again")));
+      },
+      MakeImmutableOptions(Options{}), 42, "test-location");
+  auto value = pending.get();
+  EXPECT_THAT(value, StatusIs(StatusCode::kCancelled));
+  auto const& metadata = value.status().error_info().metadata();
+  EXPECT_THAT(metadata, Contains(Pair("gcloud-cpp.retry.reason", "cancelled")));
+  EXPECT_THAT(metadata,
+              Contains(Pair("gcloud-cpp.retry.function", "test-location")));
+}
+
+/// @test Verify the loop resumes as soon as the attempt is satisfied.
+TEST(AsyncRetryLoopCoroutineTest, CompletesWhenAttemptIsSatisfied) {
+  promise<StatusOr<int>> p;
+  AutomaticallyCreatedBackgroundThreads background;
+  auto pending = AsyncRetryLoopCoroutine(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      background.cq(),
+      [&p](google::cloud::CompletionQueue&, auto, auto const&, int) {
+        return p.get_future();
+      },
+      MakeImmutableOptions(Options{}), 42, "test-location");
+  EXPECT_EQ(pending.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::timeout);
+  p.set_value(84);
+  ASSERT_EQ(pending.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::ready);
+  EXPECT_THAT(pending.get(), IsOkAndHolds(84));
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
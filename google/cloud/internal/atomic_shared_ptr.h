@@ -0,0 +1,78 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ATOMIC_SHARED_PTR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ATOMIC_SHARED_PTR_H
+
+#include "google/cloud/version.h"
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/**
+ * A `std::shared_ptr<T>` that can be loaded and stored concurrently.
+ *
+ * This is used to publish immutable snapshots, e.g. a cached access token,
+ * which are read far more often than they are replaced. Readers never wait
+ * for a writer holding some other lock, such as the lock held while a token
+ * is refreshed.
+ *
+ * C++20 provides `std::atomic<std::shared_ptr<T>>` for this purpose, and
+ * deprecates the `std::atomic_load()` and `std::atomic_store()` overloads we
+ * must use with older standards.
+ *
+ * Neither is guaranteed to be lock-free. In particular, libstdc++ implements
+ * the C++14 overloads with a small global pool of mutexes, indexed by the
+ * address of the `std::shared_ptr<T>`. The critical sections are just a
+ * reference count update, so readers still avoid any long waits, but they
+ * may briefly contend with each other and with unrelated objects.
+ */
+template <typename T>
+class AtomicSharedPtr {
+ public:
+  AtomicSharedPtr() = default;
+  explicit AtomicSharedPtr(std::shared_ptr<T> value)
+      : value_(std::move(value)) {}
+
+  AtomicSharedPtr(AtomicSharedPtr const&) = delete;
+  AtomicSharedPtr& operator=(AtomicSharedPtr const&) = delete;
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+  std::shared_ptr<T> load() const { return value_.load(); }
+  void store(std::shared_ptr<T> value) { value_.store(std::move(value)); }
+
+ private:
+  std::atomic<std::shared_ptr<T>> value_;
+#else
+  std::shared_ptr<T> load() const { return std::atomic_load(&value_); }
+  void store(std::shared_ptr<T> value) {
+    std::atomic_store(&value_, std::move(value));
+  }
+
+ private:
+  std::shared_ptr<T> value_;
+#endif  // defined(__cpp_lib_atomic_shared_ptr)
+};
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ATOMIC_SHARED_PTR_H
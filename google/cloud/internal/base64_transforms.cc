@@ -15,6 +15,7 @@
 #include "google/cloud/internal/base64_transforms.h"
 #include "google/cloud/internal/absl_str_cat_quiet.h"
 #include "google/cloud/internal/make_status.h"
+#include <cstring>
 #include <limits>
 
 namespace google {
@@ -59,6 +60,45 @@ constexpr std::array<unsigned char, 256> kCharToIndexExcessOne = {{
     38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52,
 }};
 
+// Each entry holds the two characters encoding a 12-bit value, so 3 octets are
+// encoded with 2 table lookups.
+using EncodeTable = std::array<std::array<char, 2>, 4096>;
+
+EncodeTable const& GetEncodeTable() {
+  static auto const* const kTable = [] {
+    auto* table = new EncodeTable;
+    for (std::size_t i = 0; i != table->size(); ++i) {
+      (*table)[i] = {{kIndexToChar[i >> 6], kIndexToChar[i & 0x3f]}};
+    }
+    return table;
+  }();
+  return *kTable;
+}
+
+// Set in the decoding tables for characters outside the alphabet, including
+// the padding. It is outside the 24 bits of a decoded group.
+constexpr std::uint32_t kInvalidChar = 0x01000000;
+
+// The value of a character in each position of a group, already shifted into
+// place, so a group is decoded by OR-ing 4 table entries. Invalid characters
+// are detected once per call, instead of once per character.
+using DecodeTable = std::array<std::array<std::uint32_t, 256>, 4>;
+
+DecodeTable const& GetDecodeTable() {
+  static auto const* const kTable = [] {
+    auto* table = new DecodeTable;
+    for (std::size_t c = 0; c != 256; ++c) {
+      auto const i = kCharToIndexExcessOne[c];
+      for (std::size_t p = 0; p != 4; ++p) {
+        (*table)[p][c] =
+            i == 0 ? kInvalidChar : std::uint32_t(i - 1) << (6 * (3 - p));
+      }
+    }
+    return table;
+  }();
+  return *kTable;
+}
+
 /**
  * Decode up to 3 octets from 4 base64-encoded characters.
  *
@@ -95,9 +135,7 @@ inline bool Base64Fill(unsigned char p0, unsigned char p1, unsigned char p2,
   return true;
 }
 
-Status Base64DecodingError(std::string const& input,
-                           std::string::const_iterator p) {
-  auto const offset = std::distance(input.begin(), p);
+Status Base64DecodingError(absl::string_view input, std::size_t offset) {
   auto const bad_chunk = input.substr(offset, 4);
   return internal::InvalidArgumentError(
       absl::StrCat("Invalid base64 chunk \"", bad_chunk, "\" at offset ",
@@ -105,18 +143,118 @@ Status Base64DecodingError(std::string const& input,
       GCP_ERROR_INFO());
 }
 
-template <typename Sink>
-Status Base64DecodeGeneric(std::string const& input, Sink const& sink) {
-  auto p = input.begin();
-  for (; std::distance(p, input.end()) >= 4; p = std::next(p, 4)) {
-    if (!Base64Fill(*p, *(p + 1), *(p + 2), *(p + 3), sink)) break;
+/**
+ * Decodes @p input into @p out, or just validates it if `kWrite` is false.
+ *
+ * All the groups, except possibly the last one, have 4 characters from the
+ * alphabet. These are decoded in a tight loop, without branches.
+ */
+template <bool kWrite>
+StatusOr<std::size_t> Base64DecodeImpl(absl::string_view input,
+                                       std::uint8_t* out) {
+  auto const& table = GetDecodeTable();
+  auto const groups = input.size() / 4;
+  // The last group may have padding, it is decoded separately.
+  auto const full = input.size() % 4 == 0 && groups != 0 ? groups - 1 : groups;
+  auto const* p = reinterpret_cast<unsigned char const*>(input.data());
+  auto* o = out;
+  std::uint32_t invalid = 0;
+  for (std::size_t g = 0; g != full; ++g, p += 4) {
+    auto const v = table[0][p[0]] | table[1][p[1]] | table[2][p[2]] |
+                   table[3][p[3]];
+    invalid |= v;
+    if (kWrite) {
+      o[0] = static_cast<std::uint8_t>(v >> 16);
+      o[1] = static_cast<std::uint8_t>(v >> 8);
+      o[2] = static_cast<std::uint8_t>(v);
+      o += 3;
+    }
+  }
+  if ((invalid & kInvalidChar) != 0) {
+    // Find the first invalid group to report it.
+    p = reinterpret_cast<unsigned char const*>(input.data());
+    for (std::size_t g = 0; g != full; ++g, p += 4) {
+      auto const v = table[0][p[0]] | table[1][p[1]] | table[2][p[2]] |
+                     table[3][p[3]];
+      if ((v & kInvalidChar) != 0) return Base64DecodingError(input, 4 * g);
+    }
+  }
+  if (full == groups) {
+    if (input.size() % 4 == 0) return 0;  // `input` is empty
+    return Base64DecodingError(input, 4 * full);
+  }
+  auto sink = [&o](unsigned char c) {
+    if (kWrite) *o++ = c;
+  };
+  if (!Base64Fill(p[0], p[1], p[2], p[3], sink)) {
+    return Base64DecodingError(input, 4 * full);
   }
-  if (p != input.end()) return Base64DecodingError(input, p);
-  return Status{};
+  return static_cast<std::size_t>(o - out);
 }
 
 }  // namespace
 
+std::size_t Base64EncodeBulk(absl::Span<std::uint8_t const> in,
+                             absl::Span<char> out) {
+  auto const& table = GetEncodeTable();
+  auto const* p = in.data();
+  auto const* const end = p + in.size() / 3 * 3;
+  auto* o = out.data();
+  for (; p != end; p += 3, o += 4) {
+    std::uint32_t const v = std::uint32_t{p[0]} << 16 |
+                            std::uint32_t{p[1]} << 8 | std::uint32_t{p[2]};
+    std::memcpy(o, table[v >> 12].data(), 2);
+    std::memcpy(o + 2, table[v & 0xfff].data(), 2);
+  }
+  switch (in.size() % 3) {  // NOLINT(bugprone-switch-missing-default-case)
+    case 2: {
+      std::uint32_t const v =
+          std::uint32_t{p[0]} << 16 | std::uint32_t{p[1]} << 8;
+      std::memcpy(o, table[v >> 12].data(), 2);
+      *(o + 2) = kIndexToChar[v >> 6 & 0x3f];
+      *(o + 3) = kPadding;
+      o += 4;
+      break;
+    }
+    case 1: {
+      std::uint32_t const v = std::uint32_t{p[0]} << 16;
+      std::memcpy(o, table[v >> 12].data(), 2);
+      *(o + 2) = kPadding;
+      *(o + 3) = kPadding;
+      o += 4;
+      break;
+    }
+    case 0:
+      break;
+  }
+  return static_cast<std::size_t>(o - out.data());
+}
+
+StatusOr<std::size_t> Base64DecodeBulk(absl::string_view in,
+                                       absl::Span<std::uint8_t> out) {
+  if (out.size() < Base64DecodedMaxSize(in.size())) {
+    return internal::InvalidArgumentError(
+        absl::StrCat("output buffer too small, has ", out.size(),
+                     " octets, needs ", Base64DecodedMaxSize(in.size())),
+        GCP_ERROR_INFO());
+  }
+  return Base64DecodeImpl<true>(in, out.data());
+}
+
+void Base64Encoder::Append(absl::Span<std::uint8_t const> bytes) {
+  // Complete any partial group from previous calls.
+  while (len_ != 0 && !bytes.empty()) {
+    PushBack(bytes.front());
+    bytes.remove_prefix(1);
+  }
+  auto const n = bytes.size() / 3 * 3;
+  auto const offset = rep_.size();
+  rep_.resize(offset + Base64EncodedSize(n));
+  auto out = absl::MakeSpan(&rep_[offset], rep_.size() - offset);
+  Base64EncodeBulk(bytes.first(n), out);
+  for (auto c : bytes.subspan(n)) PushBack(c);
+}
+
 void Base64Encoder::Flush() {
   unsigned int const v = buf_[0] << 16 | buf_[1] << 8 | buf_[2];
   rep_.push_back(kIndexToChar[v >> 18]);
@@ -176,15 +314,15 @@ void Base64Decoder::Iterator::Fill() {
 }
 
 Status ValidateBase64String(std::string const& input) {
-  return Base64DecodeGeneric(input, [](unsigned char) {});
+  return Base64DecodeImpl<false>(input, nullptr).status();
 }
 
 StatusOr<std::vector<std::uint8_t>> Base64DecodeToBytes(
     std::string const& input) {
-  std::vector<std::uint8_t> result;
-  auto status = Base64DecodeGeneric(
-      input, [&result](unsigned char c) { result.push_back(c); });
-  if (!status.ok()) return status;
+  std::vector<std::uint8_t> result(Base64DecodedMaxSize(input.size()));
+  auto size = Base64DecodeImpl<true>(input, result.data());
+  if (!size) return std::move(size).status();
+  result.resize(*size);
   return result;
 }
 
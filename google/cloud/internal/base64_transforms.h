@@ -17,6 +17,8 @@
 
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include <algorithm>
 #include <array>
 #include <cstddef>
@@ -37,6 +39,9 @@ class Base64Encoder {
     buf_[len_++] = c;
     if (len_ == buf_.size()) Flush();
   }
+  /// Encodes @p bytes, which is much faster than calling `PushBack()` for
+  /// each octet. Can be mixed with calls to `PushBack()`.
+  void Append(absl::Span<std::uint8_t const> bytes);
   std::string FlushAndPad() &&;
 
  private:
@@ -97,6 +102,50 @@ struct Base64Decoder {
   std::string const& rep_;  // encoded
 };
 
+/// The number of characters needed to encode @p n octets, including padding.
+inline std::size_t Base64EncodedSize(std::size_t n) { return (n + 2) / 3 * 4; }
+
+/// The maximum number of octets decoded from @p n characters.
+inline std::size_t Base64DecodedMaxSize(std::size_t n) { return n / 4 * 3; }
+
+/**
+ * Encodes @p in into @p out, adding padding if needed.
+ *
+ * This works on whole blocks of octets, using table lookups for 12 bits at a
+ * time. Inputs whose size is a multiple of 3 do not need padding, so a large
+ * input can be encoded in pieces of those sizes.
+ *
+ * @param out must have room for `Base64EncodedSize(in.size())` characters.
+ * @return the number of characters written.
+ */
+std::size_t Base64EncodeBulk(absl::Span<std::uint8_t const> in,
+                             absl::Span<char> out);
+
+/**
+ * Decodes @p in into @p out.
+ *
+ * Only the last group of 4 characters may contain padding, so a large input
+ * can be decoded in pieces whose sizes are multiples of 4.
+ *
+ * @param out must have room for `Base64DecodedMaxSize(in.size())` octets.
+ * @return the number of octets written, or the same error as
+ *     `ValidateBase64String()` if @p in is not valid.
+ */
+StatusOr<std::size_t> Base64DecodeBulk(absl::string_view in,
+                                       absl::Span<std::uint8_t> out);
+
+/**
+ * Returns the octets in @p c, which must use contiguous storage.
+ *
+ * For example, `std::string` or `std::vector<std::uint8_t>`.
+ */
+template <typename Container>
+absl::Span<std::uint8_t const> AsOctets(Container const& c) {
+  static_assert(sizeof(*c.data()) == 1, "Container must hold octets");
+  return absl::MakeConstSpan(reinterpret_cast<std::uint8_t const*>(c.data()),
+                             c.size());
+}
+
 Status ValidateBase64String(std::string const& input);
 
 StatusOr<std::vector<std::uint8_t>> Base64DecodeToBytes(
@@ -112,7 +161,7 @@ StatusOr<std::vector<std::uint8_t>> Base64DecodeToBytes(
 template <typename Collection>
 inline std::string UrlsafeBase64Encode(Collection const& bytes) {
   Base64Encoder encoder;
-  for (auto c : bytes) encoder.PushBack(c);
+  encoder.Append(AsOctets(bytes));
   std::string b64str = std::move(encoder).FlushAndPad();
   std::replace(b64str.begin(), b64str.end(), '+', '-');
   std::replace(b64str.begin(), b64str.end(), '/', '_');
@@ -15,6 +15,9 @@
 #include "google/cloud/internal/base64_transforms.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -22,8 +25,10 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace internal {
 namespace {
 
+using ::google::cloud::testing_util::IsOkAndHolds;
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::ContainsRegex;
+using ::testing::HasSubstr;
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::Not;
@@ -184,6 +189,100 @@ TEST(Base64, Base64DecodePadding) {
               ElementsAre('A', 'B', 'C', 'D'));
 }
 
+std::vector<std::uint8_t> AllOctets(std::size_t size) {
+  std::vector<std::uint8_t> result(size);
+  for (std::size_t i = 0; i != size; ++i) {
+    result[i] = static_cast<std::uint8_t>((i * 131 + 7) % 256);
+  }
+  return result;
+}
+
+std::string EncodeOneByOne(std::vector<std::uint8_t> const& bytes) {
+  Base64Encoder enc;
+  for (auto c : bytes) enc.PushBack(c);
+  return std::move(enc).FlushAndPad();
+}
+
+TEST(Base64, BulkRoundTrip) {
+  for (std::size_t size = 0; size != 300; ++size) {
+    auto const bytes = AllOctets(size);
+    auto const expected = EncodeOneByOne(bytes);
+
+    std::string encoded(Base64EncodedSize(size), '\0');
+    auto const n = Base64EncodeBulk(bytes, absl::MakeSpan(encoded));
+    EXPECT_EQ(n, encoded.size());
+    EXPECT_EQ(encoded, expected) << "size=" << size;
+
+    std::vector<std::uint8_t> decoded(Base64DecodedMaxSize(encoded.size()));
+    auto const m = Base64DecodeBulk(encoded, absl::MakeSpan(decoded));
+    ASSERT_STATUS_OK(m) << "size=" << size;
+    decoded.resize(*m);
+    EXPECT_EQ(decoded, bytes) << "size=" << size;
+    EXPECT_THAT(Base64DecodeToBytes(encoded), IsOkAndHolds(bytes));
+  }
+}
+
+TEST(Base64, BulkPieces) {
+  // Pieces with a multiple of 3 octets, or 4 characters, can be processed
+  // independently.
+  auto const bytes = AllOctets(1000);
+  std::string encoded(Base64EncodedSize(bytes.size()), '\0');
+  auto in = absl::MakeConstSpan(bytes);
+  auto out = absl::MakeSpan(encoded);
+  while (!in.empty()) {
+    auto const piece = in.first((std::min<std::size_t>)(in.size(), 99));
+    out.remove_prefix(Base64EncodeBulk(piece, out));
+    in.remove_prefix(piece.size());
+  }
+  EXPECT_EQ(encoded, EncodeOneByOne(bytes));
+
+  std::vector<std::uint8_t> decoded(Base64DecodedMaxSize(encoded.size()));
+  auto view = absl::string_view(encoded);
+  auto buffer = absl::MakeSpan(decoded);
+  std::size_t total = 0;
+  while (!view.empty()) {
+    auto const piece = view.substr(0, 128);
+    auto n = Base64DecodeBulk(piece, buffer);
+    ASSERT_STATUS_OK(n);
+    buffer.remove_prefix(*n);
+    view.remove_prefix(piece.size());
+    total += *n;
+  }
+  decoded.resize(total);
+  EXPECT_EQ(decoded, bytes);
+}
+
+TEST(Base64, EncoderAppend) {
+  auto const bytes = AllOctets(100);
+  auto const expected = EncodeOneByOne(bytes);
+  for (std::size_t prefix = 0; prefix != 5; ++prefix) {
+    Base64Encoder enc;
+    auto span = absl::MakeConstSpan(bytes);
+    for (auto c : span.first(prefix)) enc.PushBack(c);
+    enc.Append(span.subspan(prefix, 50));
+    enc.Append(span.subspan(prefix + 50, 1));
+    enc.Append(span.subspan(prefix + 51));
+    EXPECT_EQ(std::move(enc).FlushAndPad(), expected) << "prefix=" << prefix;
+  }
+  EXPECT_EQ(UrlsafeBase64Encode(std::string("abcde")), "YWJjZGU");
+}
+
+TEST(Base64, BulkDecodeErrors) {
+  std::vector<std::uint8_t> buffer(64);
+  auto out = absl::MakeSpan(buffer);
+  // Padding is only valid in the last group.
+  EXPECT_THAT(Base64DecodeBulk("YQ==YWJj", out),
+              StatusIs(StatusCode::kInvalidArgument,
+                       ContainsRegex("Invalid base64.*at offset 0")));
+  EXPECT_THAT(ValidateBase64String("YQ==YWJj"),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(Base64DecodeBulk("YWJjYWJj.WJjYWJj", out),
+              StatusIs(StatusCode::kInvalidArgument,
+                       ContainsRegex("Invalid base64.*at offset 8")));
+  EXPECT_THAT(Base64DecodeBulk("YWJjYWJj", absl::MakeSpan(buffer).first(5)),
+              StatusIs(StatusCode::kInvalidArgument, HasSubstr("too small")));
+}
+
 }  // namespace
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
@@ -0,0 +1,170 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/channel_health.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+// The weight of each new value in the moving averages. With 0.05 the scores
+// reflect roughly the last 20 to 50 RPCs in each channel.
+auto constexpr kAlpha = 0.05;
+
+// Caps the effect of the error rate on the score. A channel where every RPC
+// fails scores 10 times its latency.
+auto constexpr kMinSuccessRate = 0.1;
+
+auto constexpr kDefaultMinSamples = 100;
+auto constexpr kDefaultThreshold = 3.0;
+auto constexpr kDefaultCheckPeriod = std::chrono::seconds(30);
+
+bool IsTransportError(StatusCode code) {
+  return code == StatusCode::kUnavailable ||
+         code == StatusCode::kDeadlineExceeded;
+}
+
+}  // namespace
+
+ChannelPoolHealth::ChannelPoolHealth(std::uint64_t id, std::size_t size,
+                                     std::uint64_t min_samples,
+                                     double threshold)
+    : id_(id),
+      min_samples_(min_samples),
+      threshold_(threshold),
+      channels_(size) {}
+
+void ChannelPoolHealth::Record(std::size_t channel, std::uint64_t epoch,
+                                   std::chrono::nanoseconds latency,
+                                   StatusCode code) {
+  if (channel >= channels_.size()) return;
+  auto const value = static_cast<double>(latency.count());
+  auto const error = IsTransportError(code) ? 1.0 : 0.0;
+  auto& c = channels_[channel];
+  std::lock_guard<std::mutex> lk(c.mu);
+  if (c.epoch != epoch) return;
+  if (c.samples++ == 0) {
+    c.latency = value;
+    c.error_rate = error;
+    return;
+  }
+  c.latency += kAlpha * (value - c.latency);
+  c.error_rate += kAlpha * (error - c.error_rate);
+}
+
+absl::optional<std::size_t> ChannelPoolHealth::Unhealthy() const {
+  std::vector<std::pair<double, std::size_t>> scores;
+  for (std::size_t i = 0; i != channels_.size(); ++i) {
+    auto const& c = channels_[i];
+    std::lock_guard<std::mutex> lk(c.mu);
+    if (c.samples < min_samples_) continue;
+    scores.emplace_back(Score(c), i);
+  }
+  if (scores.size() < 3) return absl::nullopt;
+  std::sort(scores.begin(), scores.end());
+  auto const median = scores[scores.size() / 2].first;
+  auto const& worst = scores.back();
+  if (median <= 0 || worst.first <= threshold_ * median) return absl::nullopt;
+  return worst.second;
+}
+
+std::uint64_t ChannelPoolHealth::Reset(std::size_t channel) {
+  if (channel >= channels_.size()) return 0;
+  auto& c = channels_[channel];
+  std::lock_guard<std::mutex> lk(c.mu);
+  c.samples = 0;
+  c.latency = 0;
+  c.error_rate = 0;
+  ++c.replacements;
+  return ++c.epoch;
+}
+
+std::uint64_t ChannelPoolHealth::Epoch(std::size_t channel) const {
+  if (channel >= channels_.size()) return 0;
+  auto const& c = channels_[channel];
+  std::lock_guard<std::mutex> lk(c.mu);
+  return c.epoch;
+}
+
+std::vector<ChannelHealthPoint> ChannelPoolHealth::Collect() const {
+  std::vector<ChannelHealthPoint> points(channels_.size());
+  for (std::size_t i = 0; i != channels_.size(); ++i) {
+    auto const& c = channels_[i];
+    auto& p = points[i];
+    p.pool = id_;
+    p.channel = i;
+    std::lock_guard<std::mutex> lk(c.mu);
+    p.latency = std::chrono::nanoseconds(
+        static_cast<std::chrono::nanoseconds::rep>(c.latency));
+    p.error_rate = c.error_rate;
+    p.score = Score(c);
+    p.samples = c.samples;
+    p.replacements = c.replacements;
+  }
+  return points;
+}
+
+double ChannelPoolHealth::Score(Channel const& c) {
+  return c.latency / (std::max)(1.0 - c.error_rate, kMinSuccessRate);
+}
+
+ChannelHealth::ChannelHealth()
+    : ChannelHealth(kDefaultMinSamples, kDefaultThreshold,
+                        kDefaultCheckPeriod) {}
+
+ChannelHealth::ChannelHealth(std::uint64_t min_samples, double threshold,
+                             std::chrono::milliseconds check_period)
+    : min_samples_(min_samples),
+      threshold_(threshold),
+      check_period_(check_period) {}
+
+std::shared_ptr<ChannelPoolHealth> ChannelHealth::AddPool(
+    std::size_t size) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto pool = std::make_shared<ChannelPoolHealth>(next_id_++, size,
+                                                  min_samples_, threshold_);
+  // Drop any pools released by their clients.
+  pools_.erase(std::remove_if(pools_.begin(), pools_.end(),
+                              [](auto const& w) { return w.expired(); }),
+               pools_.end());
+  pools_.push_back(pool);
+  return pool;
+}
+
+std::vector<ChannelHealthPoint> ChannelHealth::Collect() const {
+  std::vector<std::shared_ptr<ChannelPoolHealth>> pools;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    for (auto const& w : pools_) {
+      if (auto p = w.lock()) pools.push_back(std::move(p));
+    }
+  }
+  std::vector<ChannelHealthPoint> points;
+  for (auto const& p : pools) {
+    auto v = p->Collect();
+    points.insert(points.end(), std::make_move_iterator(v.begin()),
+                  std::make_move_iterator(v.end()));
+  }
+  return points;
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace internal
+}  // namespace cloud
+}  // namespace google
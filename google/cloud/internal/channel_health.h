@@ -0,0 +1,165 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_CHANNEL_HEALTH_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_CHANNEL_HEALTH_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/// The health of one channel, as reported by `Collect()`.
+struct ChannelHealthPoint {
+  /// Identifies the channel pool, each client has a different pool.
+  std::uint64_t pool = 0;
+  /// The index of the channel in its pool.
+  std::size_t channel = 0;
+  /// The moving average of the RPC latency.
+  std::chrono::nanoseconds latency{0};
+  /// The moving average of the transport error rate, in the `[0, 1]` range.
+  double error_rate = 0;
+  /// The channel score, higher is worse.
+  double score = 0;
+  /// The number of RPCs recorded since the channel was created.
+  std::uint64_t samples = 0;
+  /// The number of times this channel was replaced.
+  std::uint64_t replacements = 0;
+};
+
+/**
+ * Scores the channels used by one client.
+ *
+ * The score for each channel is the exponentially weighted moving average of
+ * its RPC latency, inflated by the moving average of its transport error rate.
+ * Only `kUnavailable` and `kDeadlineExceeded` count as transport errors, other
+ * errors are the service's responses and say nothing about the channel.
+ *
+ * The client distributes RPCs over the channels in round-robin order, so all
+ * the channels see the same mix of RPCs, and their scores are comparable even
+ * though the latency varies by RPC.
+ *
+ * Recording a value locks only the mutex for that channel.
+ */
+class ChannelPoolHealth {
+ public:
+  ChannelPoolHealth(std::uint64_t id, std::size_t size,
+                    std::uint64_t min_samples, double threshold);
+
+  ChannelPoolHealth(ChannelPoolHealth const&) = delete;
+  ChannelPoolHealth& operator=(ChannelPoolHealth const&) = delete;
+
+  std::size_t size() const { return channels_.size(); }
+
+  /**
+   * Records the result of one RPC in @p channel.
+   *
+   * The value is discarded if @p epoch is not the current epoch for the
+   * channel, that is, if the RPC started before the channel was replaced.
+   */
+  void Record(std::size_t channel, std::uint64_t epoch,
+              std::chrono::nanoseconds latency, StatusCode code);
+
+  /**
+   * Returns the channel to replace, if any.
+   *
+   * A channel is unhealthy if it has the worst score in the pool, and its
+   * score is more than `threshold` times the median score. Only channels with
+   * at least `min_samples` values are considered, and the pool needs at least
+   * three such channels to have a meaningful median.
+   */
+  absl::optional<std::size_t> Unhealthy() const;
+
+  /// Clears the scores after @p channel is replaced, returns its new epoch.
+  std::uint64_t Reset(std::size_t channel);
+
+  /// The current epoch for @p channel.
+  std::uint64_t Epoch(std::size_t channel) const;
+
+  /// The health of each channel in the pool.
+  std::vector<ChannelHealthPoint> Collect() const;
+
+ private:
+  struct Channel {
+    mutable std::mutex mu;
+    std::uint64_t epoch = 0;
+    std::uint64_t samples = 0;
+    std::uint64_t replacements = 0;
+    double latency = 0;
+    double error_rate = 0;
+  };
+
+  static double Score(Channel const& c);
+
+  std::uint64_t const id_;
+  std::uint64_t const min_samples_;
+  double const threshold_;
+  std::vector<Channel> channels_;
+};
+
+/**
+ * Configures the channel health scoring and collects the scores.
+ *
+ * Each client creates a `ChannelPoolHealth` for its channels using
+ * `AddPool()`. `Collect()` reports the channels in all the pools that are
+ * still in use.
+ */
+class ChannelHealth {
+ public:
+  /**
+   * Uses the default configuration.
+   *
+   * Channels are scored after 100 RPCs, a channel is unhealthy if its score
+   * is 3 times the median score, and the health is checked every 30 seconds.
+   */
+  ChannelHealth();
+  ChannelHealth(std::uint64_t min_samples, double threshold,
+                std::chrono::milliseconds check_period);
+
+  ChannelHealth(ChannelHealth const&) = delete;
+  ChannelHealth& operator=(ChannelHealth const&) = delete;
+
+  std::chrono::milliseconds check_period() const { return check_period_; }
+
+  /// Creates the scores for a pool of @p size channels.
+  std::shared_ptr<ChannelPoolHealth> AddPool(std::size_t size);
+
+  /// The health of all the channels, sorted by pool and channel.
+  std::vector<ChannelHealthPoint> Collect() const;
+
+ private:
+  std::uint64_t const min_samples_;
+  double const threshold_;
+  std::chrono::milliseconds const check_period_;
+  mutable std::mutex mu_;
+  std::uint64_t next_id_ = 0;                           // GUARDED_BY(mu_)
+  std::vector<std::weak_ptr<ChannelPoolHealth>> pools_;  // GUARDED_BY(mu_)
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_CHANNEL_HEALTH_H
@@ -0,0 +1,207 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/channel_health.h"
+#include <gmock/gmock.h>
+#include <chrono>
+
+namespace google {
+namespace cloud {
+namespace internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using namespace std::chrono_literals;  // NOLINT
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+
+void RecordMany(ChannelPoolHealth& pool, std::size_t channel, int count,
+                std::chrono::nanoseconds latency,
+                StatusCode code = StatusCode::kOk) {
+  auto const epoch = pool.Epoch(channel);
+  for (int i = 0; i != count; ++i) pool.Record(channel, epoch, latency, code);
+}
+
+TEST(ChannelPoolHealth, Collect) {
+  ChannelPoolHealth pool(7, 2, 1, 3.0);
+  RecordMany(pool, 0, 10, 10ms);
+  RecordMany(pool, 1, 10, 20ms, StatusCode::kNotFound);
+
+  auto const points = pool.Collect();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_EQ(points[0].pool, 7);
+  EXPECT_EQ(points[0].channel, 0);
+  EXPECT_EQ(points[0].latency, 10ms);
+  EXPECT_EQ(points[0].error_rate, 0);
+  EXPECT_DOUBLE_EQ(points[0].score, 1.0E7);
+  EXPECT_EQ(points[0].samples, 10);
+  EXPECT_EQ(points[0].replacements, 0);
+  // Service errors are not transport errors.
+  EXPECT_EQ(points[1].channel, 1);
+  EXPECT_EQ(points[1].latency, 20ms);
+  EXPECT_EQ(points[1].error_rate, 0);
+  EXPECT_EQ(points[1].samples, 10);
+}
+
+TEST(ChannelPoolHealth, MovingAverage) {
+  ChannelPoolHealth pool(0, 1, 1, 3.0);
+  RecordMany(pool, 0, 1, 100ms);
+  RecordMany(pool, 0, 1, 200ms);
+  auto const points = pool.Collect();
+  ASSERT_EQ(points.size(), 1);
+  EXPECT_EQ(points[0].latency, 105ms);
+  EXPECT_EQ(points[0].samples, 2);
+}
+
+TEST(ChannelPoolHealth, TransportErrors) {
+  ChannelPoolHealth pool(0, 2, 1, 3.0);
+  RecordMany(pool, 0, 1, 10ms, StatusCode::kUnavailable);
+  RecordMany(pool, 1, 1, 10ms, StatusCode::kDeadlineExceeded);
+  auto const points = pool.Collect();
+  ASSERT_EQ(points.size(), 2);
+  for (auto const& p : points) {
+    EXPECT_EQ(p.error_rate, 1.0);
+    EXPECT_DOUBLE_EQ(p.score, 1.0E8);
+  }
+}
+
+TEST(ChannelPoolHealth, UnhealthyByLatency) {
+  ChannelPoolHealth pool(0, 4, 10, 3.0);
+  RecordMany(pool, 0, 10, 10ms);
+  RecordMany(pool, 1, 10, 40ms);
+  RecordMany(pool, 2, 10, 12ms);
+  RecordMany(pool, 3, 10, 11ms);
+  EXPECT_THAT(pool.Unhealthy(), Optional(1));
+}
+
+TEST(ChannelPoolHealth, UnhealthyByErrors) {
+  ChannelPoolHealth pool(0, 3, 10, 3.0);
+  RecordMany(pool, 0, 10, 10ms);
+  RecordMany(pool, 1, 10, 10ms);
+  RecordMany(pool, 2, 10, 10ms, StatusCode::kUnavailable);
+  EXPECT_THAT(pool.Unhealthy(), Optional(2));
+}
+
+TEST(ChannelPoolHealth, HealthyWithinThreshold) {
+  ChannelPoolHealth pool(0, 3, 10, 3.0);
+  RecordMany(pool, 0, 10, 10ms);
+  RecordMany(pool, 1, 10, 10ms);
+  RecordMany(pool, 2, 10, 30ms);
+  EXPECT_EQ(pool.Unhealthy(), absl::nullopt);
+}
+
+TEST(ChannelPoolHealth, RequiresMinSamples) {
+  ChannelPoolHealth pool(0, 3, 10, 3.0);
+  RecordMany(pool, 0, 10, 10ms);
+  RecordMany(pool, 1, 10, 10ms);
+  RecordMany(pool, 2, 9, 100ms);
+  EXPECT_EQ(pool.Unhealthy(), absl::nullopt);
+  RecordMany(pool, 2, 1, 100ms);
+  EXPECT_THAT(pool.Unhealthy(), Optional(2));
+}
+
+TEST(ChannelPoolHealth, RequiresThreeChannels) {
+  ChannelPoolHealth pool(0, 2, 1, 3.0);
+  RecordMany(pool, 0, 10, 10ms);
+  RecordMany(pool, 1, 10, 100ms);
+  EXPECT_EQ(pool.Unhealthy(), absl::nullopt);
+}
+
+TEST(ChannelPoolHealth, Reset) {
+  ChannelPoolHealth pool(0, 3, 1, 3.0);
+  RecordMany(pool, 0, 10, 10ms);
+  RecordMany(pool, 1, 10, 10ms);
+  RecordMany(pool, 2, 10, 100ms);
+  EXPECT_THAT(pool.Unhealthy(), Optional(2));
+
+  auto const old_epoch = pool.Epoch(2);
+  auto const epoch = pool.Reset(2);
+  EXPECT_NE(epoch, old_epoch);
+  EXPECT_EQ(pool.Epoch(2), epoch);
+  EXPECT_EQ(pool.Unhealthy(), absl::nullopt);
+
+  // Results for RPCs started before the reset are discarded.
+  pool.Record(2, old_epoch, 100ms, StatusCode::kOk);
+  auto points = pool.Collect();
+  ASSERT_EQ(points.size(), 3);
+  EXPECT_EQ(points[2].samples, 0);
+  EXPECT_EQ(points[2].replacements, 1);
+
+  pool.Record(2, epoch, 10ms, StatusCode::kOk);
+  points = pool.Collect();
+  ASSERT_EQ(points.size(), 3);
+  EXPECT_EQ(points[2].samples, 1);
+  EXPECT_EQ(points[2].latency, 10ms);
+}
+
+TEST(ChannelPoolHealth, InvalidChannel) {
+  ChannelPoolHealth pool(0, 1, 1, 3.0);
+  pool.Record(1, 0, 10ms, StatusCode::kOk);
+  EXPECT_EQ(pool.Reset(1), 0);
+  EXPECT_EQ(pool.Epoch(1), 0);
+  EXPECT_THAT(pool.Collect(),
+              ElementsAre(Field(&ChannelHealthPoint::samples, 0)));
+}
+
+TEST(ChannelHealth, Defaults) {
+  ChannelHealth health;
+  EXPECT_EQ(health.check_period(), 30s);
+  EXPECT_THAT(health.Collect(), IsEmpty());
+
+  auto pool = health.AddPool(3);
+  ASSERT_EQ(pool->size(), 3);
+  RecordMany(*pool, 0, 99, 10ms);
+  RecordMany(*pool, 1, 99, 10ms);
+  RecordMany(*pool, 2, 99, 100ms);
+  EXPECT_EQ(pool->Unhealthy(), absl::nullopt);
+  RecordMany(*pool, 0, 1, 10ms);
+  RecordMany(*pool, 1, 1, 10ms);
+  RecordMany(*pool, 2, 1, 100ms);
+  EXPECT_THAT(pool->Unhealthy(), Optional(2));
+}
+
+TEST(ChannelHealth, CollectPools) {
+  ChannelHealth health(1, 3.0, 10ms);
+  EXPECT_EQ(health.check_period(), 10ms);
+  auto p0 = health.AddPool(2);
+  auto p1 = health.AddPool(1);
+  RecordMany(*p1, 0, 1, 10ms);
+
+  auto const pool = &ChannelHealthPoint::pool;
+  auto const channel = &ChannelHealthPoint::channel;
+  auto const samples = &ChannelHealthPoint::samples;
+  auto points = health.Collect();
+  ASSERT_EQ(points.size(), 3);
+  EXPECT_EQ(points[0].pool, points[1].pool);
+  EXPECT_NE(points[0].pool, points[2].pool);
+  EXPECT_THAT(points, ElementsAre(Field(channel, 0), Field(channel, 1),
+                                  Field(samples, 1)));
+
+  // Released pools are not reported.
+  auto const released = points[0].pool;
+  p0.reset();
+  EXPECT_THAT(health.Collect(), ElementsAre(Field(pool, points[2].pool)));
+  auto p2 = health.AddPool(1);
+  points = health.Collect();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_NE(points[1].pool, released);
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,178 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_COMPLETION_QUEUE_COROUTINES_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_COMPLETION_QUEUE_COROUTINES_H
+
+#include "google/cloud/internal/port_platform.h"
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/internal/async_rpc_details.h"
+#include "google/cloud/internal/call_context.h"
+#include "google/cloud/internal/future_coroutines.h"
+#include "google/cloud/internal/make_status.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <grpcpp/support/async_unary_call.h>
+#include <coroutine>
+#include <memory>
+
+namespace google::cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/**
+ * Wrap a unary RPC into an `AsyncOperation` that resumes a coroutine.
+ *
+ * This is the coroutine version of `AsyncUnaryRpcFuture`. There is no promise
+ * or future involved: the thread running the completion queue stores the
+ * result in this object and resumes the coroutine waiting for it directly.
+ *
+ * @tparam Request the type of the RPC request.
+ * @tparam Response the type of the RPC response.
+ */
+template <typename Request, typename Response>
+class AsyncUnaryRpcAwaitOperation : public AsyncGrpcOperation {
+ public:
+  explicit AsyncUnaryRpcAwaitOperation(
+      std::shared_ptr<grpc::ClientContext> context)
+      : context_(std::move(context)) {}
+
+  /**
+   * Set the coroutine resumed by `Notify()`.
+   *
+   * This must be called before the operation is passed to the completion
+   * queue. If the completion queue is shut down it calls `Notify()` without
+   * calling `Start()`.
+   */
+  void set_handle(std::coroutine_handle<> h) { handle_ = h; }
+
+  /// Prepare the operation to receive the response and start the RPC.
+  template <typename AsyncFunctionType>
+  void Start(AsyncFunctionType& async_call, Request const& request,
+             grpc::CompletionQueue* cq, void* tag) {
+    auto rpc = async_call(context_.get(), request, cq);
+    rpc->Finish(&response_, &status_, tag);
+  }
+
+  void Cancel() override {}
+
+  bool Notify(bool ok) override {
+    ScopedCallContext scope(call_context_);
+    if (!ok) {
+      // `Finish()` always returns `true` for unary RPCs, so the only time we
+      // get `!ok` is after `Shutdown()` was called; create a "cancelled"
+      // originating from the client.
+      result_ = internal::CancelledError(
+          "call cancelled",
+          GCP_ERROR_INFO().WithMetadata("gl-cpp.error.origin", "client"));
+    } else if (!status_.ok()) {
+      result_ = MakeStatusFromRpcError(status_);
+    } else {
+      result_ = std::move(response_);
+    }
+    // The coroutine runs until its next suspension point. The completion queue
+    // holds a reference to this object until `Notify()` returns.
+    handle_.resume();
+    return true;
+  }
+
+  StatusOr<Response> ExtractResult() { return std::move(result_); }
+
+ private:
+  std::shared_ptr<grpc::ClientContext> context_;
+  grpc::Status status_;
+  Response response_;
+  StatusOr<Response> result_;
+  CallContext call_context_;
+  std::coroutine_handle<> handle_;
+};
+
+/// The awaitable returned by `AwaitUnaryRpc()`.
+template <typename AsyncCallType, typename Request, typename Response>
+class AsyncUnaryRpcAwaiter {
+ public:
+  AsyncUnaryRpcAwaiter(std::shared_ptr<CompletionQueueImpl> impl,
+                       AsyncCallType async_call, Request const& request,
+                       std::shared_ptr<grpc::ClientContext> context)
+      : impl_(std::move(impl)),
+        async_call_(std::move(async_call)),
+        request_(request),
+        op_(std::make_shared<AsyncUnaryRpcAwaitOperation<Request, Response>>(
+            std::move(context))) {}
+
+  [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> h) {
+    // The coroutine may be resumed, and this object destroyed, as soon as the
+    // RPC finishes, or immediately if the completion queue is shut down. That
+    // can happen before `StartOperation()` returns, so it must not use any
+    // member variables after `Start()` returns.
+    auto impl = impl_;
+    auto op = op_;
+    op->set_handle(h);
+    impl->StartOperation(op, [&](void* tag) {
+      op->Start(async_call_, request_, impl->cq(), tag);
+    });
+  }
+
+  StatusOr<Response> await_resume() { return op_->ExtractResult(); }
+
+ private:
+  std::shared_ptr<CompletionQueueImpl> impl_;
+  AsyncCallType async_call_;
+  Request const& request_;
+  std::shared_ptr<AsyncUnaryRpcAwaitOperation<Request, Response>> op_;
+};
+
+/**
+ * Make an asynchronous unary RPC and `co_await` its result.
+ *
+ * This is the coroutine version of `CompletionQueue::MakeUnaryRpc()`. The
+ * coroutine resumes in the thread running the completion queue, without
+ * allocating a promise, a future, or a continuation.
+ *
+ * @code
+ * future<StatusOr<Response>> Example(CompletionQueue cq, Request request) {
+ *   auto response = co_await AwaitUnaryRpc(
+ *       cq, [stub](auto* context, auto const& request, auto* cq) {
+ *         return stub->AsyncGetResponse(context, request, cq);
+ *       }, request, std::make_shared<grpc::ClientContext>());
+ *   co_return response;
+ * }
+ * @endcode
+ *
+ * @note @p request must remain valid until the `co_await` expression
+ *     completes, which is always the case if it is a local variable or a
+ *     temporary in the same expression.
+ */
+template <
+    typename AsyncCallType, typename Request,
+    typename Sig = internal::AsyncCallResponseType<AsyncCallType, Request>,
+    typename Response = typename Sig::type,
+    std::enable_if_t<Sig::value, int> = 0>
+AsyncUnaryRpcAwaiter<AsyncCallType, Request, Response> AwaitUnaryRpc(
+    CompletionQueue const& cq, AsyncCallType async_call,
+    Request const& request, std::shared_ptr<grpc::ClientContext> context) {
+  return AsyncUnaryRpcAwaiter<AsyncCallType, Request, Response>(
+      GetCompletionQueueImpl(cq), std::move(async_call), request,
+      std::move(context));
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_COMPLETION_QUEUE_COROUTINES_H
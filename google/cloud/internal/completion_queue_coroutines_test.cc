@@ -0,0 +1,152 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/completion_queue_coroutines.h"
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/mock_async_response_reader.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <google/protobuf/duration.pb.h>
+#include <google/protobuf/timestamp.pb.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace google::cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::HasSubstr;
+
+using Request = google::protobuf::Duration;
+using Response = google::protobuf::Timestamp;
+using MockResponseReader =
+    ::google::cloud::testing_util::MockAsyncResponseReader<Response>;
+
+class MockClient {
+ public:
+  MOCK_METHOD(
+      std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<Response>>,
+      AsyncGetResponse,
+      (grpc::ClientContext*, Request const&, grpc::CompletionQueue* cq));
+};
+
+future<StatusOr<Response>> GetResponse(CompletionQueue cq, MockClient& client,
+                                       Request request) {
+  co_return co_await AwaitUnaryRpc(
+      cq,
+      [&client](grpc::ClientContext* context, Request const& request,
+                grpc::CompletionQueue* cq) {
+        return client.AsyncGetResponse(context, request, cq);
+      },
+      request, std::make_shared<grpc::ClientContext>());
+}
+
+class CompletionQueueCoroutinesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    EXPECT_CALL(mock_client_, AsyncGetResponse)
+        .WillOnce([this](grpc::ClientContext*, Request const& request,
+                         grpc::CompletionQueue*) {
+          EXPECT_EQ(request.seconds(), 123);
+          // This looks like a double delete, but it is not because
+          // std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<T>> is
+          // specialized to not delete. :shrug:
+          return std::unique_ptr<
+              grpc::ClientAsyncResponseReaderInterface<Response>>(
+              mock_reader_.get());
+        });
+  }
+
+  future<StatusOr<Response>> MakeCall() {
+    Request request;
+    request.set_seconds(123);
+    return GetResponse(cq_, mock_client_, std::move(request));
+  }
+
+  std::shared_ptr<FakeCompletionQueueImpl> mock_cq_ =
+      std::make_shared<FakeCompletionQueueImpl>();
+  CompletionQueue cq_{mock_cq_};
+  std::unique_ptr<MockResponseReader> mock_reader_ =
+      std::make_unique<MockResponseReader>();
+  MockClient mock_client_;
+};
+
+TEST_F(CompletionQueueCoroutinesTest, AwaitUnaryRpc) {
+  using ms = std::chrono::milliseconds;
+  EXPECT_CALL(*mock_reader_, Finish)
+      .WillOnce([](Response* response, grpc::Status* status, void*) {
+        response->set_seconds(123);
+        response->set_nanos(456);
+        *status = grpc::Status::OK;
+      });
+
+  std::thread runner([this] { cq_.Run(); });
+
+  auto pending = MakeCall();
+  EXPECT_EQ(std::future_status::timeout, pending.wait_for(ms(0)));
+  mock_cq_->SimulateCompletion(true);
+  EXPECT_EQ(std::future_status::ready, pending.wait_for(ms(0)));
+  auto response = pending.get();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(response->seconds(), 123);
+  EXPECT_EQ(response->nanos(), 456);
+
+  cq_.Shutdown();
+  runner.join();
+}
+
+TEST_F(CompletionQueueCoroutinesTest, AwaitUnaryRpcError) {
+  EXPECT_CALL(*mock_reader_, Finish)
+      .WillOnce([](Response*, grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+      });
+
+  auto pending = MakeCall();
+  mock_cq_->SimulateCompletion(true);
+  EXPECT_THAT(pending.get(),
+              StatusIs(StatusCode::kUnavailable, HasSubstr("try-again")));
+}
+
+TEST_F(CompletionQueueCoroutinesTest, AwaitUnaryRpcCancelled) {
+  EXPECT_CALL(*mock_reader_, Finish).Times(1);
+
+  auto pending = MakeCall();
+  mock_cq_->SimulateCompletion(false);
+  EXPECT_THAT(pending.get(), StatusIs(StatusCode::kCancelled));
+}
+
+TEST(CompletionQueueCoroutines, AwaitUnaryRpcAfterShutdown) {
+  // The RPC is never started, the completion queue notifies the operation
+  // directly.
+  MockClient mock_client;
+  EXPECT_CALL(mock_client, AsyncGetResponse).Times(0);
+
+  auto mock_cq = std::make_shared<FakeCompletionQueueImpl>();
+  CompletionQueue cq(mock_cq);
+  cq.Shutdown();
+  auto pending = GetResponse(cq, mock_client, Request{});
+  EXPECT_THAT(pending.get(), StatusIs(StatusCode::kCancelled));
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace google::cloud
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
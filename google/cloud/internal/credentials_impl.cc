@@ -14,6 +14,7 @@
 
 #include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/common_options.h"
+#include "google/cloud/opentelemetry_options.h"
 #include "google/cloud/internal/populate_common_options.h"
 #include <chrono>
 
@@ -87,6 +88,19 @@ std::vector<std::string> const& ImpersonateServiceAccountConfig::delegates()
   return options_.get<DelegatesOption>();
 }
 
+std::shared_ptr<Credentials> SharedGoogleDefaultCredentials(
+    Options const& options) {
+  // `MakeAuthOptions()` only preserves the tracing configuration, there are
+  // only two possible objects. They are never destroyed, as clients may be
+  // created (and destroyed) during static initialization (and destruction).
+  static auto* const kPlain = new std::shared_ptr<Credentials>(
+      MakeGoogleDefaultCredentials(MakeAuthOptions(Options{})));
+  static auto* const kTraced =
+      new std::shared_ptr<Credentials>(MakeGoogleDefaultCredentials(
+          MakeAuthOptions(Options{}.set<OpenTelemetryTracingOption>(true))));
+  return options.get<OpenTelemetryTracingOption>() ? *kTraced : *kPlain;
+}
+
 ServiceAccountConfig::ServiceAccountConfig(std::string json_object,
                                            Options opts)
     : json_object_(std::move(json_object)),
@@ -169,6 +169,18 @@ class ExternalAccountConfig : public Credentials {
 /// A helper function to initialize Auth options.
 Options PopulateAuthOptions(Options options);
 
+/**
+ * Returns the Google Default Credentials for a client configured with
+ * @p options.
+ *
+ * Clients created without explicit credentials use this function. They all
+ * receive the same `Credentials` object, and therefore share any cached access
+ * tokens (see `SharedCredentialsCache()`), instead of refreshing the same
+ * token once per client.
+ */
+std::shared_ptr<Credentials> SharedGoogleDefaultCredentials(
+    Options const& options);
+
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
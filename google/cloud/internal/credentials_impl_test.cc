@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "google/cloud/internal/credentials_impl.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/opentelemetry_options.h"
 #include "google/cloud/testing_util/credentials.h"
 #include <gmock/gmock.h>
 
@@ -51,6 +53,24 @@ TEST(Credentials, GoogleDefaultCredentials) {
   EXPECT_EQ("GoogleDefaultCredentialsConfig", visitor.name);
 }
 
+TEST(Credentials, SharedGoogleDefaultCredentials) {
+  auto credentials = SharedGoogleDefaultCredentials(Options{});
+  TestCredentialsVisitor visitor;
+  CredentialsVisitor::dispatch(*credentials, visitor);
+  EXPECT_EQ("GoogleDefaultCredentialsConfig", visitor.name);
+  EXPECT_FALSE(visitor.options.get<OpenTelemetryTracingOption>());
+  EXPECT_EQ(credentials, SharedGoogleDefaultCredentials(
+                             Options{}.set<EndpointOption>("unused")));
+
+  auto traced = SharedGoogleDefaultCredentials(
+      Options{}.set<OpenTelemetryTracingOption>(true));
+  EXPECT_NE(credentials, traced);
+  CredentialsVisitor::dispatch(*traced, visitor);
+  EXPECT_TRUE(visitor.options.get<OpenTelemetryTracingOption>());
+  EXPECT_EQ(traced, SharedGoogleDefaultCredentials(
+                        Options{}.set<OpenTelemetryTracingOption>(true)));
+}
+
 TEST(Credentials, AccessTokenCredentials) {
   TestCredentialsVisitor visitor;
 
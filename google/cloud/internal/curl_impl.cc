@@ -680,6 +680,10 @@ Status CurlImpl::PerformWorkUntil(absl::FunctionRef<bool()> predicate) {
   TRACE_STATE() << ", begin";
   int repeats = 0;
   while (!predicate()) {
+    if (cancelled_->load()) {
+      return internal::CancelledError("the request was cancelled",
+                                      GCP_ERROR_INFO());
+    }
     handle_.FlushDebug(__func__);
     TRACE_STATE() << ", repeats=" << repeats;
     auto running_handles = PerformWork();
@@ -27,6 +27,7 @@
 #include "absl/types/optional.h"
 #include "absl/types/span.h"
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <map>
@@ -102,6 +103,11 @@ class CurlImpl {
   bool HasUnreadData() const;
   StatusOr<std::size_t> Read(absl::Span<char> output);
 
+  // Interrupts a Read() blocked in another thread. The Read() returns once
+  // libcurl stops waiting for data, which takes at most the poll timeout in
+  // WaitForHandles().
+  void Cancel() { cancelled_->store(true); }
+
   // Called from libcurl callbacks for received data.
   std::size_t WriteCallback(absl::Span<char> response);
   std::size_t HeaderCallback(absl::Span<char> response);
@@ -175,6 +181,11 @@ class CurlImpl {
 
   // Store pending data between WriteCallback() calls.
   SpillBuffer spill_;
+
+  // Set by Cancel(), possibly from a different thread. This is a pointer to
+  // keep the class movable.
+  std::unique_ptr<std::atomic<bool>> cancelled_ =
+      std::make_unique<std::atomic<bool>>(false);
 };
 
 /// Compute the CURLOPT_PROXY setting from @p options.
@@ -13,17 +13,104 @@
 // limitations under the License.
 
 #include "google/cloud/internal/format_time_point.h"
-#include "absl/time/time.h"
+#include <algorithm>
+#include <cstdint>
 
 namespace google {
 namespace cloud {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace internal {
+namespace {
+
+char* WriteTwoDigits(char* p, std::int64_t v) {
+  p[0] = static_cast<char>('0' + v / 10);
+  p[1] = static_cast<char>('0' + v % 10);
+  return p + 2;
+}
+
+struct CivilDate {
+  std::int64_t year;
+  int month;
+  int mday;
+};
+
+// Converts the number of days since 1970-01-01 to a date in the proleptic
+// Gregorian calendar.
+//
+// @see http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+CivilDate CivilFromDays(std::int64_t z) {
+  z += 719468;
+  auto const era = (z >= 0 ? z : z - 146096) / 146097;
+  auto const doe = z - era * 146097;
+  auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  auto const mp = (5 * doy + 2) / 153;
+  auto const d = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  auto const m = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  return CivilDate{yoe + era * 400 + (m <= 2 ? 1 : 0), m, d};
+}
+
+}  // namespace
 
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  char buffer[kFormatRfc3339BufferSize];
+  return std::string(buffer, FormatRfc3339(tp, buffer));
+}
+
+char* FormatRfc3339(absl::Time t, char* buffer) {
+  // 0000-01-01T00:00:00Z and 9999-12-31T23:59:59Z
+  auto constexpr kMinSeconds = -62167219200;
+  auto constexpr kMaxSeconds = 253402300799;
+  auto const seconds = absl::ToUnixSeconds(t);
+  auto const subsecond = t - absl::FromUnixSeconds(seconds);
+  auto const nanos = absl::ToInt64Nanoseconds(subsecond);
+  if (seconds < kMinSeconds || seconds > kMaxSeconds ||
+      absl::Nanoseconds(nanos) != subsecond) {
+    auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
+    auto const s = absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+    return std::copy_n(s.data(), std::min(s.size(), kFormatRfc3339BufferSize),
+                       buffer);
+  }
+
+  auto constexpr kSecondsPerDay = 86400;
+  auto days = seconds / kSecondsPerDay;
+  auto sod = seconds % kSecondsPerDay;
+  if (sod < 0) {
+    sod += kSecondsPerDay;
+    --days;
+  }
+  auto const date = CivilFromDays(days);
+
+  char* p = buffer;
+  p = WriteTwoDigits(p, date.year / 100);
+  p = WriteTwoDigits(p, date.year % 100);
+  *p++ = '-';
+  p = WriteTwoDigits(p, date.month);
+  *p++ = '-';
+  p = WriteTwoDigits(p, date.mday);
+  *p++ = 'T';
+  p = WriteTwoDigits(p, sod / 3600);
+  *p++ = ':';
+  p = WriteTwoDigits(p, sod / 60 % 60);
+  *p++ = ':';
+  p = WriteTwoDigits(p, sod % 60);
+  if (nanos != 0) {
+    // Write all 9 digits and then drop the trailing zeros.
+    *p++ = '.';
+    auto v = nanos;
+    for (int i = 8; i >= 0; --i) {
+      p[i] = static_cast<char>('0' + v % 10);
+      v /= 10;
+    }
+    p += 9;
+    while (p[-1] == '0') --p;
+  }
+  *p++ = 'Z';
+  return p;
+}
+
+char* FormatRfc3339(std::chrono::system_clock::time_point tp, char* buffer) {
+  return FormatRfc3339(absl::FromChrono(tp), buffer);
 }
 
 std::string FormatUtcDate(std::chrono::system_clock::time_point tp) {
@@ -16,7 +16,9 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FORMAT_TIME_POINT_H
 
 #include "google/cloud/version.h"
+#include "absl/time/time.h"
 #include <chrono>
+#include <cstddef>
 #include <string>
 
 namespace google {
@@ -42,6 +44,28 @@ namespace internal {
  */
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp);
 
+/// The minimum size of the buffers used with `FormatRfc3339(..., char*)`.
+std::size_t constexpr kFormatRfc3339BufferSize = 64;
+
+/**
+ * Formats @p t as a RFC-3339 timestamp into @p buffer, without allocating.
+ *
+ * The output is the same as `FormatRfc3339(tp)`, that is, it uses
+ * `YYYY-MM-DDTHH:MM:SS.FFFZ` with as many fractional digits as needed. Most
+ * timestamps, those between years 0 and 9999 with nanosecond precision, are
+ * formatted directly. Any other timestamps are formatted by
+ * `absl::FormatTime()`.
+ *
+ * @p buffer must have room for at least `kFormatRfc3339BufferSize` characters.
+ * The output is not null-terminated.
+ *
+ * @return a pointer to the character following the last character written.
+ */
+char* FormatRfc3339(absl::Time t, char* buffer);
+
+/// @copydoc FormatRfc3339(absl::Time, char*)
+char* FormatRfc3339(std::chrono::system_clock::time_point tp, char* buffer);
+
 /// Format a time point as YYYY-MM-DD.
 std::string FormatUtcDate(std::chrono::system_clock::time_point tp);
 
@@ -15,6 +15,7 @@
 #include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/parse_rfc3339.h"
 #include <gmock/gmock.h>
+#include <random>
 
 namespace google {
 namespace cloud {
@@ -72,6 +73,53 @@ TEST(FormatRfc3339Test, FractionalNanos) {
   }
 }
 
+TEST(FormatRfc3339Test, Buffer) {
+  struct Test {
+    absl::Time input;
+    std::string expected;
+  } cases[] = {
+      {absl::UnixEpoch(), "1970-01-01T00:00:00Z"},
+      {absl::UnixEpoch() - absl::Nanoseconds(1),
+       "1969-12-31T23:59:59.999999999Z"},
+      {absl::FromUnixSeconds(1526654523L) + absl::Milliseconds(100),
+       "2018-05-18T14:42:03.1Z"},
+      {absl::FromUnixSeconds(951782400L), "2000-02-29T00:00:00Z"},
+      {absl::FromUnixSeconds(-62167219200L), "0000-01-01T00:00:00Z"},
+      {absl::FromUnixSeconds(253402300799L) + absl::Nanoseconds(999999999),
+       "9999-12-31T23:59:59.999999999Z"},
+      // These are formatted by `absl::FormatTime()`.
+      {absl::FromUnixSeconds(253402300800L), "10000-01-01T00:00:00Z"},
+      {absl::UnixEpoch() + absl::Nanoseconds(1) / 4,
+       "1970-01-01T00:00:00.00000000025Z"},
+      {absl::InfiniteFuture(), "infinite-future"},
+  };
+  for (auto const& test : cases) {
+    char buffer[kFormatRfc3339BufferSize];
+    auto* end = FormatRfc3339(test.input, buffer);
+    EXPECT_EQ(std::string(buffer, end), test.expected);
+  }
+}
+
+TEST(FormatRfc3339Test, BufferMatchesFormatTime) {
+  auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
+  auto generator = std::mt19937_64(std::random_device{}());
+  auto seconds = std::uniform_int_distribution<std::int64_t>(-62167219200L,
+                                                             253402300799L);
+  auto nanos = std::uniform_int_distribution<std::int64_t>(0, 999999999);
+  for (int i = 0; i != 10000; ++i) {
+    // Use a mix of whole seconds, milliseconds and nanoseconds.
+    auto n = nanos(generator);
+    if (i % 3 == 0) n = 0;
+    if (i % 3 == 1) n -= n % 1000000;
+    auto const t =
+        absl::FromUnixSeconds(seconds(generator)) + absl::Nanoseconds(n);
+    char buffer[kFormatRfc3339BufferSize];
+    auto* end = FormatRfc3339(t, buffer);
+    EXPECT_EQ(std::string(buffer, end),
+              absl::FormatTime(kFormat, t, absl::UTCTimeZone()));
+  }
+}
+
 TEST(FormatV4SignedUrlTimestampTest, Base) {
   auto timestamp = ParseRfc3339("2019-08-02T01:02:03Z").value();
   std::string actual = FormatV4SignedUrlTimestamp(timestamp);
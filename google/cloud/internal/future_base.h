@@ -18,6 +18,7 @@
 #include "google/cloud/internal/future_impl.h"
 #include "google/cloud/version.h"
 #include <chrono>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -204,6 +205,12 @@ struct CoroutineSupport {
   static void set_continuation(future<T>& f, std::unique_ptr<C> c) {
     f.shared_state_->set_continuation(std::move(c));
   }
+
+  template <typename C, typename T, typename... Args>
+  static void emplace_continuation(future<T>& f, Args&&... args) {
+    f.shared_state_->template emplace_continuation<C>(
+        std::forward<Args>(args)...);
+  }
 };
 
 }  // namespace internal
@@ -116,9 +116,11 @@ auto operator co_await(future<T> f) noexcept
       // We cannot use `impl.then()` because that returns a new future, and
       // coroutines expect the future to remain unchanged.  We reach into the
       // future's internals to set up a callback without invalidating the
-      // future.
-      internal::CoroutineSupport::set_continuation(
-          impl, std::make_unique<AndThen>(std::move(h)));
+      // future. The callback is small enough to be stored in the shared
+      // state, so suspending the coroutine does not allocate, and it resumes
+      // in the thread that satisfies the future.
+      internal::CoroutineSupport::emplace_continuation<AndThen>(impl,
+                                                                std::move(h));
     }
 
     // Get the value (or exception) from the future.
@@ -18,13 +18,20 @@
 #include "google/cloud/internal/future_fwd.h"
 #include "google/cloud/terminate_handler.h"
 #include "google/cloud/version.h"
+#include "absl/meta/type_traits.h"
 #include "absl/types/variant.h"
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace google {
@@ -152,6 +159,12 @@ struct FutureValueRetrieved {};
  *
  * Case (4) above is needed in the implementation of `.then()`. No public APIs
  * of `future<T>` or `promise<T>` can get a shared state to contain it.
+ *
+ * Satisfying the shared state, attaching a continuation, and querying or
+ * retrieving a satisfied value do not lock any mutex, they are coordinated
+ * through an atomic state machine (see `state_`). The mutex and condition
+ * variable are only used when a thread needs to block until the shared state
+ * is satisfied.
  */
 template <typename T>
 class future_shared_state final {  // NOLINT(readability-identifier-naming)
@@ -174,6 +187,14 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
   using ValueType = absl::variant<absl::monostate, std::exception_ptr, T,
                                   FutureValueRetrieved>;
 
+  /**
+   * Continuations up to this size are stored in the shared state.
+   *
+   * This is large enough for the continuations created by `.then()` when the
+   * functor captures a few pointers, avoiding a heap allocation for each one.
+   */
+  static constexpr std::size_t kInlineContinuationSize = 64;
+
 #if __clang__
 #elif __GNUC__
   // With some versions of Abseil and GCC the compiler emits spurious warnings.
@@ -186,43 +207,56 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
   // Used in the implementation of `.then()` to transfer the value from one
   // instance to a new instance.
   explicit future_shared_state(ValueType value)
-      : future_shared_state([] {}, std::move(value)) {}
+      : state_(initial_state(value)),
+        value_(std::move(value)),
+        cancellation_callback_([] {}) {}
 
   explicit future_shared_state(std::function<void()> cancellation_callback,
                                ValueType value = {})
-      : value_(std::move(value)),
+      : state_(initial_state(value)),
+        value_(std::move(value)),
         cancellation_callback_(std::move(cancellation_callback)) {}
 #if __clang__
 #elif __GNUC__
 #pragma GCC diagnostic pop
 #endif
 
+  ~future_shared_state() {
+    if (continuation_inline_) {
+      continuation_->~Continuation();
+    } else {
+      delete continuation_;
+    }
+  }
+
+  future_shared_state(future_shared_state const&) = delete;
+  future_shared_state& operator=(future_shared_state const&) = delete;
+
   /// The implementation details for `future<T>::get()`
   T get() {
-    std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
-    struct Visitor {
-      T operator()(T v) { return v; }
-      T operator()(std::exception_ptr ex) {
-        ThrowDelegate(
-            std::move(ex),
-            "future<T>::get() had an exception but exceptions are disabled");
-      }
-      T operator()(FutureValueRetrieved) {
-        ThrowFutureError(std::future_errc::no_state,
-                         "future<T>::get() - already retrieved");
-      }
-      T operator()(absl::monostate) {
-        ThrowFutureError(std::future_errc::no_state,
-                         "future<T>::get() - not set");
-      }
-    };
+    wait();
     // Note that the value is moved out. It is impossible to retrieve the value
     // a second time. The `.get()` operation on a `future<T>` invalidates the
-    // future, so new calls will fail.
-    ValueType tmp(FutureValueRetrieved{});
-    tmp.swap(value_);
-    return absl::visit(Visitor{}, std::move(tmp));
+    // future, so new calls will fail. Once the state is satisfied only the
+    // (single) consumer modifies `value_`, no locks are needed.
+    if (auto* v = absl::get_if<T>(&value_)) {
+      T result = std::move(*v);
+      value_.template emplace<FutureValueRetrieved>();
+      return result;
+    }
+    if (auto* ex = absl::get_if<std::exception_ptr>(&value_)) {
+      auto tmp = std::move(*ex);
+      value_.template emplace<FutureValueRetrieved>();
+      ThrowDelegate(
+          std::move(tmp),
+          "future<T>::get() had an exception but exceptions are disabled");
+    }
+    if (absl::holds_alternative<FutureValueRetrieved>(value_)) {
+      ThrowFutureError(std::future_errc::no_state,
+                       "future<T>::get() - already retrieved");
+    }
+    value_.template emplace<FutureValueRetrieved>();
+    ThrowFutureError(std::future_errc::no_state, "future<T>::get() - not set");
   }
 
   /**
@@ -236,24 +270,17 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
    *     error code is `std::future_errc::promise_already_satisfied`.
    */
   void set_value(T value) {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (is_ready_unlocked()) {
-      ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
-    }
+    claim_or_throw(__func__);
     // We can only reach this point once, all other states are terminal.
-    // Therefore we know that `value_` has not been initialized.
-
-    // TODO(#1405) - this is calling application code while holding a lock.
-    // That could result in a deadlock (or at least unbounded priority
-    // inversions) if the move constructor for `T` takes a long time to execute.
-    value_ = std::move(value);
-    notify_now(std::move(lk));
+    // Therefore we know that `value_` has not been initialized, and no other
+    // thread reads it until `publish()` marks the state as ready.
+    value_.template emplace<T>(std::move(value));
+    publish();
   }
 
   /// Return true if the shared state has a value or an exception.
   bool is_ready() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return is_ready_unlocked();
+    return (state_.load(std::memory_order_acquire) & kReady) != 0;
   }
 
   /// Return true if the shared state can be cancelled.
@@ -261,8 +288,10 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
 
   /// Block until is_ready() returns true.
   void wait() {
+    if (is_ready()) return;
     std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
+    state_.fetch_or(kWaiting, std::memory_order_acq_rel);
+    cv_.wait(lk, [this] { return is_ready(); });
   }
 
   /**
@@ -289,11 +318,12 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
    */
   template <typename Rep, typename Period>
   std::future_status wait_for(std::chrono::duration<Rep, Period> duration) {
+    if (is_ready()) return std::future_status::ready;
     std::unique_lock<std::mutex> lk(mu_);
-    bool result =
-        cv_.wait_for(lk, duration, [this] { return is_ready_unlocked(); });
+    state_.fetch_or(kWaiting, std::memory_order_acq_rel);
+    bool result = cv_.wait_for(lk, duration, [this] { return is_ready(); });
     if (result) return std::future_status::ready;
-    if (continuation_) return std::future_status::deferred;
+    if (has_continuation()) return std::future_status::deferred;
     return std::future_status::timeout;
   }
 
@@ -315,20 +345,21 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
    */
   template <typename Clock>
   std::future_status wait_until(std::chrono::time_point<Clock> deadline) {
+    if (is_ready()) return std::future_status::ready;
     std::unique_lock<std::mutex> lk(mu_);
     if (!lk.owns_lock()) return std::future_status::timeout;
-    bool result =
-        cv_.wait_until(lk, deadline, [this] { return is_ready_unlocked(); });
+    state_.fetch_or(kWaiting, std::memory_order_acq_rel);
+    bool result = cv_.wait_until(lk, deadline, [this] { return is_ready(); });
     if (result) return std::future_status::ready;
-    if (continuation_) return std::future_status::deferred;
+    if (has_continuation()) return std::future_status::deferred;
     return std::future_status::timeout;
   }
 
   /// Set the shared state to hold an exception and notify immediately.
   void set_exception(std::exception_ptr ex) {
-    std::unique_lock<std::mutex> lk(mu_);
-    set_exception(std::move(ex), lk);
-    notify_now(std::move(lk));
+    claim_or_throw(__func__);
+    value_.template emplace<std::exception_ptr>(std::move(ex));
+    publish();
   }
 
   /**
@@ -340,26 +371,41 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
    * `std::future_errc::broken_promise`.
    */
   void abandon() {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (is_ready_unlocked()) return;
-    set_exception(MakeFutureError(std::future_errc::broken_promise), lk);
-    notify_now(std::move(lk));
+    if (!claim()) return;
+    value_.template emplace<std::exception_ptr>(
+        MakeFutureError(std::future_errc::broken_promise));
+    publish();
   }
 
   void set_continuation(std::unique_ptr<Continuation<T>> c) {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (continuation_) {
-      ThrowFutureError(std::future_errc::future_already_retrieved, __func__);
-    }
+    auto const s = check_continuation(__func__);
     // If the future is already satisfied, invoke the continuation immediately.
-    if (is_ready_unlocked()) {
-      // Release the lock before calling the user's code, holding locks during
-      // callbacks is a bad practice.
-      lk.unlock();
-      c->Execute(*this);
-      return;
+    if ((s & kReady) != 0) return c->Execute(*this);
+    install_continuation(c.release(), false);
+  }
+
+  /**
+   * Creates a continuation of type @p C, storing it in the shared state when
+   * it is small enough.
+   *
+   * The semantics are the same as `set_continuation()`, but this avoids a
+   * heap allocation for most of the continuations created by `.then()`.
+   */
+  template <typename C, typename... Args>
+  void emplace_continuation(Args&&... args) {
+    static_assert(std::is_base_of<Continuation<T>, C>::value,
+                  "C must be a Continuation<T>");
+    auto const s = check_continuation(__func__);
+    if ((s & kReady) != 0) {
+      C c(std::forward<Args>(args)...);
+      return c.Execute(*this);
     }
-    continuation_ = std::move(c);
+    using Fits = std::integral_constant<
+        bool, sizeof(C) <= sizeof(ContinuationStorage) &&
+                  alignof(ContinuationStorage) % alignof(C) == 0>;
+    install_continuation(
+        new_continuation<C>(Fits{}, std::forward<Args>(args)...),
+        Fits::value);
   }
 
   std::function<void()> release_cancellation_callback() {
@@ -405,48 +451,101 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
    * Extract the value.
    *
    * This is used in the implementation of `.then()`, to move `value_` to a
-   * new future.
+   * new future. It is only called once the shared state is satisfied, at that
+   * point only the (single) consumer modifies `value_`.
    *
    * It is not necessary to notify any threads blocked on this shared state
    * change.
    */
   ValueType value() {
-    ValueType result(FutureValueRetrieved{});
-    {
-      std::lock_guard<std::mutex> lk(mu_);
-      result.swap(value_);
-    }
+    ValueType result(std::move(value_));
+    value_.template emplace<FutureValueRetrieved>();
     return result;
   }
 
- protected:
-  bool is_ready_unlocked() const {
-    return !absl::holds_alternative<absl::monostate>(value_);
+ private:
+  /**
+   * The bits in `state_`.
+   *
+   * A producer (`set_value()`, `set_exception()`, or `abandon()`) first sets
+   * `kSatisfying`, which gives it exclusive access to `value_`. Once `value_`
+   * is initialized the producer sets `kReady`, publishing the value to any
+   * consumers. `kContinuation` is set once `continuation_` is initialized.
+   * Whichever of the producer or `set_continuation()` observes the other's bit
+   * calls the continuation, this happens exactly once because both bits are
+   * set using atomic read-modify-write operations.
+   *
+   * Threads blocking in `wait()` set `kWaiting` while holding `mu_`, the
+   * producer only needs to lock `mu_` and notify `cv_` if this bit is set.
+   */
+  static constexpr std::uint32_t kPending = 0;
+  static constexpr std::uint32_t kSatisfying = 1U << 0;
+  static constexpr std::uint32_t kReady = 1U << 1;
+  static constexpr std::uint32_t kContinuation = 1U << 2;
+  static constexpr std::uint32_t kWaiting = 1U << 3;
+
+  static std::uint32_t initial_state(ValueType const& value) {
+    if (absl::holds_alternative<absl::monostate>(value)) return kPending;
+    return kSatisfying | kReady;
   }
 
-  /// Satisfy the shared state using an exception.
-  void set_exception(std::exception_ptr ex, std::unique_lock<std::mutex>&) {
-    if (is_ready_unlocked()) {
-      ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
-    }
-    value_.template emplace<std::exception_ptr>(std::move(ex));
+  /// Acquire exclusive access to `value_`, returns false if already satisfied.
+  bool claim() {
+    auto const s = state_.fetch_or(kSatisfying, std::memory_order_acq_rel);
+    return (s & kSatisfying) == 0;
   }
 
-  /// If needed, notify any waiting threads that the shared state is satisfied.
-  void notify_now(std::unique_lock<std::mutex> lk) {
-    if (continuation_) {
-      // Release the lock before calling the continuation because the
-      // continuation will likely call get() to fetch the state of the future.
-      lk.unlock();
-      continuation_->Execute(*this);
-      // If there is a continuation there can be no threads blocked on get() or
-      // wait() because then() invalidates the future. Therefore we can return
-      // without notifying any other threads.
-      return;
-    }
+  void claim_or_throw(char const* msg) {
+    if (claim()) return;
+    ThrowFutureError(std::future_errc::promise_already_satisfied, msg);
+  }
+
+  /// Mark `value_` as ready and call the continuation or wake up any waiters.
+  void publish() {
+    auto const s = state_.fetch_or(kReady, std::memory_order_acq_rel);
+    // If there is a continuation there can be no threads blocked on get() or
+    // wait() because then() invalidates the future. The continuation will
+    // likely call get() to fetch the state of the future, no locks are held.
+    if ((s & kContinuation) != 0) continuation_->Execute(*this);
+    if ((s & kWaiting) == 0) return;
+    std::lock_guard<std::mutex> lk(mu_);
     cv_.notify_all();
   }
 
+  bool has_continuation() const {
+    return (state_.load(std::memory_order_acquire) & kContinuation) != 0;
+  }
+
+  std::uint32_t check_continuation(char const* msg) const {
+    auto const s = state_.load(std::memory_order_acquire);
+    if ((s & kContinuation) != 0) {
+      ThrowFutureError(std::future_errc::future_already_retrieved, msg);
+    }
+    return s;
+  }
+
+  using ContinuationStorage = absl::aligned_storage_t<kInlineContinuationSize>;
+
+  template <typename C, typename... Args>
+  Continuation<T>* new_continuation(std::true_type, Args&&... args) {
+    return ::new (static_cast<void*>(&continuation_storage_))
+        C(std::forward<Args>(args)...);
+  }
+
+  template <typename C, typename... Args>
+  Continuation<T>* new_continuation(std::false_type, Args&&... args) {
+    return new C(std::forward<Args>(args)...);
+  }
+
+  void install_continuation(Continuation<T>* c, bool is_inline) {
+    continuation_ = c;
+    continuation_inline_ = is_inline;
+    auto const s = state_.fetch_or(kContinuation, std::memory_order_acq_rel);
+    // The producer satisfied the shared state since `check_continuation()`,
+    // but did not see the continuation. Invoke it from this thread.
+    if ((s & kReady) != 0) continuation_->Execute(*this);
+  }
+
   /**
    * Keep track of whether `get_future()` has been called.
    *
@@ -466,9 +565,12 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
    */
   std::atomic_flag retrieved_ = ATOMIC_FLAG_INIT;
 
-  /// Synchronize changes to `value_` and `cv_`.
-  mutable std::mutex mu_;
-  /// Used to wait until `value_` does not contain `absl::monostate`.
+  /// The state machine synchronizing access to `value_` and `continuation_`.
+  std::atomic<std::uint32_t> state_;
+
+  /// Only used to block threads in `wait()`, `wait_for()` and `wait_until()`.
+  std::mutex mu_;
+  /// Used to wait until `state_` includes `kReady`.
   std::condition_variable cv_;
   /// The value of the shared state.
   ValueType value_;
@@ -479,14 +581,32 @@ class future_shared_state final {  // NOLINT(readability-identifier-naming)
    * Note that continuations may be set independently of having a value or
    * exception. Setting a continuation does not change `value_` and does not
    * satisfy the future represented by this shared state.
+   *
+   * The continuation is either allocated in `continuation_storage_`, or
+   * allocated in the heap, as indicated by `continuation_inline_`.
    */
-  std::unique_ptr<Continuation<T>> continuation_;
+  Continuation<T>* continuation_ = nullptr;
+  bool continuation_inline_ = false;
+  ContinuationStorage continuation_storage_;
 
   // Allow users "cancel" the future with the given callback.
   std::atomic<bool> cancelled_ = ATOMIC_VAR_INIT(false);
   std::function<void()> cancellation_callback_;
 };
 
+template <typename T>
+constexpr std::size_t future_shared_state<T>::kInlineContinuationSize;
+template <typename T>
+constexpr std::uint32_t future_shared_state<T>::kPending;
+template <typename T>
+constexpr std::uint32_t future_shared_state<T>::kSatisfying;
+template <typename T>
+constexpr std::uint32_t future_shared_state<T>::kReady;
+template <typename T>
+constexpr std::uint32_t future_shared_state<T>::kContinuation;
+template <typename T>
+constexpr std::uint32_t future_shared_state<T>::kWaiting;
+
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
@@ -16,6 +16,8 @@
 #include "google/cloud/testing_util/chrono_literals.h"
 #include "google/cloud/testing_util/expect_future_error.h"
 #include <gmock/gmock.h>
+#include <array>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -236,6 +238,101 @@ TEST(FutureImplInt, SetContinuationAlreadySatisfied) {
   EXPECT_EQ(42, shared_state.get());
 }
 
+template <std::size_t N>
+class SizedContinuation : public Continuation<int> {
+ public:
+  SizedContinuation(int* executed, int* destroyed)
+      : executed_(executed), destroyed_(destroyed) {}
+  ~SizedContinuation() override { ++*destroyed_; }
+
+  void Execute(SharedStateType<int>& s) override {
+    ++*executed_;
+    padding_[0] = static_cast<char>(s.get());
+  }
+
+ private:
+  int* executed_;
+  int* destroyed_;
+  std::array<char, N> padding_;
+};
+
+using SmallContinuation = SizedContinuation<8>;
+using LargeContinuation =
+    SizedContinuation<future_shared_state<int>::kInlineContinuationSize>;
+
+TEST(FutureImplInt, EmplaceContinuation) {
+  static_assert(
+      sizeof(SmallContinuation) <=
+          future_shared_state<int>::kInlineContinuationSize,
+      "SmallContinuation should be stored in the shared state");
+  static_assert(
+      sizeof(LargeContinuation) >
+          future_shared_state<int>::kInlineContinuationSize,
+      "LargeContinuation should be allocated in the heap");
+
+  int executed = 0;
+  int destroyed = 0;
+  {
+    future_shared_state<int> small;
+    small.emplace_continuation<SmallContinuation>(&executed, &destroyed);
+    future_shared_state<int> large;
+    large.emplace_continuation<LargeContinuation>(&executed, &destroyed);
+    EXPECT_EQ(0, executed);
+    small.set_value(42);
+    large.set_value(42);
+    EXPECT_EQ(2, executed);
+    EXPECT_EQ(0, destroyed);
+  }
+  EXPECT_EQ(2, destroyed);
+}
+
+TEST(FutureImplInt, EmplaceContinuationAlreadySet) {
+  int executed = 0;
+  int destroyed = 0;
+  future_shared_state<int> shared_state;
+  shared_state.emplace_continuation<SmallContinuation>(&executed, &destroyed);
+  ExpectFutureError(
+      [&] {
+        shared_state.emplace_continuation<SmallContinuation>(&executed,
+                                                             &destroyed);
+      },
+      std::future_errc::future_already_retrieved);
+  EXPECT_EQ(0, executed);
+}
+
+TEST(FutureImplInt, EmplaceContinuationAlreadySatisfied) {
+  int executed = 0;
+  int destroyed = 0;
+  future_shared_state<int> shared_state;
+  shared_state.set_value(42);
+  shared_state.emplace_continuation<SmallContinuation>(&executed, &destroyed);
+  EXPECT_EQ(1, executed);
+  EXPECT_EQ(1, destroyed);
+}
+
+TEST(FutureImplInt, ContinuationRace) {
+  // Race the producer against the continuation, in each iteration exactly one
+  // of them must execute the continuation.
+  for (int i = 0; i != 1000; ++i) {
+    int executed = 0;
+    int destroyed = 0;
+    future_shared_state<int> shared_state;
+    std::thread producer([&] { shared_state.set_value(i); });
+    shared_state.emplace_continuation<SmallContinuation>(&executed, &destroyed);
+    producer.join();
+    ASSERT_EQ(1, executed);
+  }
+}
+
+TEST(FutureImplInt, WaitRace) {
+  for (int i = 0; i != 1000; ++i) {
+    future_shared_state<int> shared_state;
+    std::thread producer([&] { shared_state.set_value(i); });
+    EXPECT_EQ(i, shared_state.get());
+    producer.join();
+  }
+}
+
 }  // namespace
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
@@ -21,6 +21,7 @@
 #include "google/cloud/version.h"
 #include "absl/functional/function_ref.h"
 #include <exception>
+#include <memory>
 #include <type_traits>
 
 namespace google {
@@ -102,7 +103,7 @@ struct FutureThenImpl {
             output->set_exception(std::move(e));
           }
           void operator()(FutureValueRetrieved) { output->abandon(); }
-          void operator()(T v) { set_value(*output, std::move(v)); }
+          void operator()(T&& v) { set_value(*output, std::move(v)); }
         };
         return absl::visit(Visitor{std::move(output_)}, s.value());
       }
@@ -110,7 +111,7 @@ struct FutureThenImpl {
      private:
       std::shared_ptr<future_shared_state<U>> output_;
     };
-    input->set_continuation(std::make_unique<AndThen>(std::move(output)));
+    input->template emplace_continuation<AndThen>(std::move(output));
   }
 
   /// Transfer the value from @p input to @p output when @p input *and* the
@@ -136,7 +137,7 @@ struct FutureThenImpl {
             output->set_exception(std::move(e));
           }
           void operator()(FutureValueRetrieved) { output->abandon(); }
-          void operator()(future<T> v) {
+          void operator()(future<T>&& v) {
             unwrap(std::move(output), std::move(v.shared_state_));
           }
         };
@@ -146,7 +147,7 @@ struct FutureThenImpl {
      private:
       std::shared_ptr<future_shared_state<U>> output_;
     };
-    input->set_continuation(std::make_unique<AndThen>(std::move(output)));
+    input->template emplace_continuation<AndThen>(std::move(output));
   }
 
   /// Implements `future<T>::then()`.
@@ -175,11 +176,30 @@ struct FutureThenImpl {
     fut.shared_state_.reset();
     auto output = std::make_shared<SharedStateType<unwrapped_result_t>>(
         input->release_cancellation_callback());
-    auto result = std::make_shared<SharedStateType<result_t>>();
-    input->set_continuation(
-        std::make_unique<AndThen>(result, std::forward<F>(functor)));
-    unwrap(output, result);
-    return future<unwrapped_result_t>(output);
+    input->template emplace_continuation<AndThen>(
+        result_state<result_t>(
+            output, std::is_same<result_t, unwrapped_result_t>{}),
+        std::forward<F>(functor));
+    return future<unwrapped_result_t>(std::move(output));
+  }
+
+  /// If the functor in `.then()` returns a value, it is stored directly in the
+  /// shared state of the returned future.
+  template <typename R>
+  static std::shared_ptr<SharedStateType<R>> result_state(
+      std::shared_ptr<SharedStateType<R>> output, std::true_type) {
+    return output;
+  }
+
+  /// If the functor in `.then()` returns a `future<U>`, its value is stored in
+  /// a separate shared state, and transferred to @p output once that future
+  /// is satisfied.
+  template <typename R, typename U>
+  static std::shared_ptr<SharedStateType<R>> result_state(
+      std::shared_ptr<future_shared_state<U>> output, std::false_type) {
+    auto result = std::make_shared<SharedStateType<R>>();
+    unwrap(std::move(output), result);
+    return result;
   }
 
   /// Implements `future<T>::future<T>(future<future<T>>)`.
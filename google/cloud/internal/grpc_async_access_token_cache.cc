@@ -28,52 +28,90 @@ std::shared_ptr<GrpcAsyncAccessTokenCache> GrpcAsyncAccessTokenCache::Create(
       new GrpcAsyncAccessTokenCache(std::move(cq), std::move(source)));
 }
 
+std::shared_ptr<GrpcAsyncAccessTokenCache> GrpcAsyncAccessTokenCache::Create() {
+  return std::shared_ptr<GrpcAsyncAccessTokenCache>(
+      new GrpcAsyncAccessTokenCache(absl::nullopt, AsyncAccessTokenSource{}));
+}
+
 StatusOr<AccessToken> GrpcAsyncAccessTokenCache::GetAccessToken(
     std::chrono::system_clock::time_point now) {
+  return GetAccessToken(*cq_, source_, now);
+}
+
+future<StatusOr<AccessToken>> GrpcAsyncAccessTokenCache::AsyncGetAccessToken(
+    std::chrono::system_clock::time_point now) {
+  return AsyncGetAccessToken(*cq_, source_, now);
+}
+
+StatusOr<AccessToken> GrpcAsyncAccessTokenCache::GetAccessToken(
+    CompletionQueue cq, AsyncAccessTokenSource const& source,
+    std::chrono::system_clock::time_point now) {
+  auto snapshot = snapshot_.load();
+  if (now + kRefreshSlack < snapshot->expiration) return *snapshot;
   std::unique_lock<std::mutex> lk(mu_);
-  if (now + kUseSlack > token_.expiration) return Refresh(std::move(lk));
+  if (now + kUseSlack > token_.expiration) {
+    return Refresh(std::move(cq), source, std::move(lk));
+  }
   auto tmp = token_;
-  if (now + kRefreshSlack >= token_.expiration) StartRefresh(std::move(lk));
+  if (now + kRefreshSlack >= token_.expiration) {
+    StartRefresh(std::move(cq), source, std::move(lk));
+  }
   return tmp;
 }
 
 future<StatusOr<AccessToken>> GrpcAsyncAccessTokenCache::AsyncGetAccessToken(
+    CompletionQueue cq, AsyncAccessTokenSource const& source,
     std::chrono::system_clock::time_point now) {
+  auto snapshot = snapshot_.load();
+  if (now + kRefreshSlack < snapshot->expiration) {
+    return make_ready_future(make_status_or(*snapshot));
+  }
   std::unique_lock<std::mutex> lk(mu_);
-  if (now + kUseSlack > token_.expiration) return AsyncRefresh(std::move(lk));
+  if (now + kUseSlack > token_.expiration) {
+    return AsyncRefresh(std::move(cq), source, std::move(lk));
+  }
   auto tmp = token_;
-  if (now + kRefreshSlack >= token_.expiration) StartRefresh(std::move(lk));
+  if (now + kRefreshSlack >= token_.expiration) {
+    StartRefresh(std::move(cq), source, std::move(lk));
+  }
   return make_ready_future(make_status_or(tmp));
 }
 
 GrpcAsyncAccessTokenCache::GrpcAsyncAccessTokenCache(
-    CompletionQueue cq, AsyncAccessTokenSource source)
-    : cq_(std::move(cq)), source_(std::move(source)) {}
+    absl::optional<CompletionQueue> cq, AsyncAccessTokenSource source)
+    : cq_(std::move(cq)),
+      source_(std::move(source)),
+      snapshot_(std::make_shared<AccessToken const>()) {}
 
 StatusOr<AccessToken> GrpcAsyncAccessTokenCache::Refresh(
+    CompletionQueue cq, AsyncAccessTokenSource const& source,
     std::unique_lock<std::mutex> lk) {
-  return AsyncRefresh(std::move(lk)).get();
+  return AsyncRefresh(std::move(cq), source, std::move(lk)).get();
 }
 
 future<StatusOr<AccessToken>> GrpcAsyncAccessTokenCache::AsyncRefresh(
+    CompletionQueue cq, AsyncAccessTokenSource const& source,
     std::unique_lock<std::mutex> lk) {
   waiting_.emplace_back();
   auto result = waiting_.back().get_future();
-  StartRefresh(std::move(lk));
+  StartRefresh(std::move(cq), source, std::move(lk));
   return result;
 }
 
-void GrpcAsyncAccessTokenCache::StartRefresh(std::unique_lock<std::mutex> lk) {
+void GrpcAsyncAccessTokenCache::StartRefresh(
+    CompletionQueue cq, AsyncAccessTokenSource const& source,
+    std::unique_lock<std::mutex> lk) {
   if (refreshing_) return;
   refreshing_ = true;
   auto w = WeakFromThis();
   lk.unlock();
-  source_(cq_).then([w](future<StatusOr<AccessToken>> f) {
-    if (auto self = w.lock()) self->OnRefresh(std::move(f));
+  source(cq).then([w, cq](future<StatusOr<AccessToken>> f) mutable {
+    if (auto self = w.lock()) self->OnRefresh(std::move(cq), std::move(f));
   });
 }
 
-void GrpcAsyncAccessTokenCache::OnRefresh(future<StatusOr<AccessToken>> f) {
+void GrpcAsyncAccessTokenCache::OnRefresh(CompletionQueue cq,
+                                          future<StatusOr<AccessToken>> f) {
   std::unique_lock<std::mutex> lk(mu_);
   refreshing_ = false;
   std::vector<WaiterType> waiting;
@@ -82,6 +120,7 @@ void GrpcAsyncAccessTokenCache::OnRefresh(future<StatusOr<AccessToken>> f) {
   StatusOr<AccessToken> value;
   if (result) {
     token_ = *std::move(result);
+    snapshot_.store(std::make_shared<AccessToken const>(token_));
     value = token_;
   } else {
     value = std::move(result).status();
@@ -92,7 +131,7 @@ void GrpcAsyncAccessTokenCache::OnRefresh(future<StatusOr<AccessToken>> f) {
     StatusOr<AccessToken> value;
     void operator()() { p.set_value(std::move(value)); }
   };
-  for (auto& p : waiting) cq_.RunAsync(SetStatus{std::move(p), value});
+  for (auto& p : waiting) cq.RunAsync(SetStatus{std::move(p), value});
 }
 
 }  // namespace internal
@@ -16,11 +16,14 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_ASYNC_ACCESS_TOKEN_CACHE_H
 
 #include "google/cloud/completion_queue.h"
+#include "google/cloud/internal/atomic_shared_ptr.h"
 #include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/status.h"
 #include "google/cloud/version.h"
+#include "absl/types/optional.h"
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -48,6 +51,14 @@ using AsyncAccessTokenSource =
  * Splitting this functionality to a separate class (instead of the
  * GrpcAuthenticationStrategy for service account impersonation) makes for
  * easier testing.
+ *
+ * A single cache may be shared by many clients, see `SharedCredentialsCache()`.
+ * The current token is published as an immutable snapshot, so callers with a
+ * fresh token never wait for a refresh. Clients may use different options
+ * and completion queues, and a completion queue may be shut down before the
+ * cache is released. A shared cache is created without a completion queue or a
+ * source, and the callers provide theirs on each call. Such a cache holds only
+ * the token, never a client's stub or completion queue.
  */
 class GrpcAsyncAccessTokenCache
     : public std::enable_shared_from_this<GrpcAsyncAccessTokenCache> {
@@ -55,30 +66,55 @@ class GrpcAsyncAccessTokenCache
   static std::shared_ptr<GrpcAsyncAccessTokenCache> Create(
       CompletionQueue cq, AsyncAccessTokenSource source);
 
+  /**
+   * Creates a cache to share across clients.
+   *
+   * Only the overloads receiving a `CompletionQueue` and a source can be used
+   * with this cache.
+   */
+  static std::shared_ptr<GrpcAsyncAccessTokenCache> Create();
+
+  StatusOr<AccessToken> GetAccessToken(
+      std::chrono::system_clock::time_point now =
+          std::chrono::system_clock::now());
+  future<StatusOr<AccessToken>> AsyncGetAccessToken(
+      std::chrono::system_clock::time_point now =
+          std::chrono::system_clock::now());
+
+  /// Refreshes the token, if needed, using @p cq and @p source.
   StatusOr<AccessToken> GetAccessToken(
+      CompletionQueue cq, AsyncAccessTokenSource const& source,
       std::chrono::system_clock::time_point now =
           std::chrono::system_clock::now());
+  /// Refreshes the token, if needed, using @p cq and @p source.
   future<StatusOr<AccessToken>> AsyncGetAccessToken(
+      CompletionQueue cq, AsyncAccessTokenSource const& source,
       std::chrono::system_clock::time_point now =
           std::chrono::system_clock::now());
 
  private:
   using WaiterType = promise<StatusOr<AccessToken>>;
-  explicit GrpcAsyncAccessTokenCache(CompletionQueue cq,
-                                     AsyncAccessTokenSource source);
+  GrpcAsyncAccessTokenCache(absl::optional<CompletionQueue> cq,
+                            AsyncAccessTokenSource source);
 
-  StatusOr<AccessToken> Refresh(std::unique_lock<std::mutex> lk);
-  future<StatusOr<AccessToken>> AsyncRefresh(std::unique_lock<std::mutex> lk);
+  StatusOr<AccessToken> Refresh(CompletionQueue cq,
+                                AsyncAccessTokenSource const& source,
+                                std::unique_lock<std::mutex> lk);
+  future<StatusOr<AccessToken>> AsyncRefresh(
+      CompletionQueue cq, AsyncAccessTokenSource const& source,
+      std::unique_lock<std::mutex> lk);
 
-  void StartRefresh(std::unique_lock<std::mutex> lk);
-  void OnRefresh(future<StatusOr<AccessToken>>);
+  void StartRefresh(CompletionQueue cq, AsyncAccessTokenSource const& source,
+                    std::unique_lock<std::mutex> lk);
+  void OnRefresh(CompletionQueue cq, future<StatusOr<AccessToken>>);
 
   std::weak_ptr<GrpcAsyncAccessTokenCache> WeakFromThis() {
     return std::weak_ptr<GrpcAsyncAccessTokenCache>(shared_from_this());
   }
 
-  CompletionQueue cq_;
+  absl::optional<CompletionQueue> cq_;
   AsyncAccessTokenSource source_;
+  AtomicSharedPtr<AccessToken const> snapshot_;
   std::mutex mu_;
   AccessToken token_;
   bool refreshing_ = false;
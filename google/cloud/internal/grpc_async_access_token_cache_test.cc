@@ -270,6 +270,48 @@ TEST(GrpcAsyncAccessTokenCacheTest, BlockingRefresh) {
   EXPECT_EQ(t1.expiration, r->expiration);
 }
 
+TEST(GrpcAsyncAccessTokenCacheTest, SharedRefreshWithCallerSource) {
+  ::testing::MockFunction<future<StatusOr<AccessToken>>(CompletionQueue&)>
+      source1;
+  ::testing::MockFunction<future<StatusOr<AccessToken>>(CompletionQueue&)>
+      source2;
+  auto const start = std::chrono::system_clock::now();
+  using minutes = std::chrono::minutes;
+  auto const t1 = AccessToken{"token1", start + minutes(10)};
+  auto const t2 = AccessToken{"token2", start + minutes(20)};
+
+  EXPECT_CALL(source1, Call).WillOnce([&](CompletionQueue&) {
+    return make_ready_future(make_status_or(t1));
+  });
+  EXPECT_CALL(source2, Call).WillOnce([&](CompletionQueue&) {
+    return make_ready_future(make_status_or(t2));
+  });
+
+  // The shared cache has no completion queue or source of its own, each
+  // caller refreshes the token with theirs.
+  auto under_test = GrpcAsyncAccessTokenCache::Create();
+  AutomaticallyCreatedBackgroundThreads background1;
+  AutomaticallyCreatedBackgroundThreads background2;
+  auto r = under_test
+               ->AsyncGetAccessToken(background1.cq(),
+                                     source1.AsStdFunction(), start)
+               .get();
+  ASSERT_THAT(r, IsOk());
+  EXPECT_EQ(t1.token, r->token);
+
+  // The refreshed token is available to all callers.
+  r = under_test->GetAccessToken(background2.cq(), source2.AsStdFunction(),
+                                 start + minutes(1));
+  ASSERT_THAT(r, IsOk());
+  EXPECT_EQ(t1.token, r->token);
+
+  // The token is about to expire, the caller refreshes it with its source.
+  r = under_test->GetAccessToken(background2.cq(), source2.AsStdFunction(),
+                                 start + minutes(10));
+  ASSERT_THAT(r, IsOk());
+  EXPECT_EQ(t2.token, r->token);
+}
+
 }  // namespace
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
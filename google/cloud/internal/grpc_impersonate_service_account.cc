@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include "google/cloud/internal/grpc_impersonate_service_account.h"
+#include "google/cloud/common_options.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/internal/minimal_iam_credentials_stub.h"
+#include "google/cloud/internal/shared_credentials_cache.h"
 #include "google/cloud/internal/time_utils.h"
 #include "google/cloud/internal/unified_grpc_credentials.h"
 
@@ -58,10 +60,14 @@ AsyncAccessTokenSource MakeSource(ImpersonateServiceAccountConfig const& config,
 }
 
 std::shared_ptr<GrpcAsyncAccessTokenCache> MakeCache(
-    CompletionQueue cq, ImpersonateServiceAccountConfig const& config,
-    Options const& options) {
-  auto source = MakeSource(config, cq, options);
-  return GrpcAsyncAccessTokenCache::Create(std::move(cq), std::move(source));
+    ImpersonateServiceAccountConfig const& config, Options const& options) {
+  // All the clients using the same `config` and IAM Credentials endpoint share
+  // the cached tokens. Each client refreshes the tokens using its own stub and
+  // completion queue, the shared cache holds neither.
+  auto const endpoint =
+      MakeMinimalIamCredentialsOptions(options).get<EndpointOption>();
+  return SharedCredentialsCache<GrpcAsyncAccessTokenCache>(
+      config, endpoint, [] { return GrpcAsyncAccessTokenCache::Create(); });
 }
 
 }  // namespace
@@ -77,7 +83,9 @@ GrpcImpersonateServiceAccount::Create(
 GrpcImpersonateServiceAccount::GrpcImpersonateServiceAccount(
     CompletionQueue cq, ImpersonateServiceAccountConfig const& config,
     Options const& opts)
-    : cache_(MakeCache(std::move(cq), config, opts)) {
+    : cq_(cq),
+      source_(MakeSource(config, std::move(cq), opts)),
+      cache_(MakeCache(config, opts)) {
   auto cainfo = LoadCAInfo(opts);
   if (cainfo) ssl_options_.pem_root_certs = std::move(*cainfo);
 }
@@ -96,7 +104,7 @@ bool GrpcImpersonateServiceAccount::RequiresConfigureContext() const {
 
 Status GrpcImpersonateServiceAccount::ConfigureContext(
     grpc::ClientContext& context) {
-  auto token = cache_->GetAccessToken();
+  auto token = cache_->GetAccessToken(cq_, source_);
   if (!token) return std::move(token).status();
   context.set_credentials(UpdateCallCredentials(std::move(token->token)));
   return Status{};
@@ -117,7 +125,7 @@ GrpcImpersonateServiceAccount::AsyncConfigureContext(
       return self->OnGetCallCredentials(std::move(context), f.get());
     }
   };
-  return cache_->AsyncGetAccessToken().then(
+  return cache_->AsyncGetAccessToken(cq_, source_).then(
       Capture{WeakFromThis(), std::move(context)});
 }
 
@@ -64,6 +64,8 @@ class GrpcImpersonateServiceAccount
     return shared_from_this();
   }
 
+  CompletionQueue cq_;
+  AsyncAccessTokenSource source_;
   std::shared_ptr<GrpcAsyncAccessTokenCache> cache_;
   std::mutex mu_;
   std::string access_token_;
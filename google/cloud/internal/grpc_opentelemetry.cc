@@ -25,6 +25,7 @@
 #ifdef GOOGLE_CLOUD_CPP_HAVE_OPENTELEMETRY
 #include <opentelemetry/context/propagation/global_propagator.h>
 #include <opentelemetry/context/propagation/text_map_propagator.h>
+#include <opentelemetry/trace/context.h>
 #include <opentelemetry/trace/semantic_conventions.h>
 #include <opentelemetry/trace/span_metadata.h>
 #include <opentelemetry/trace/span_startoptions.h>
@@ -105,6 +106,11 @@ std::pair<std::string, std::string> MakeAttribute(
           std::move(value)};
 }
 
+std::string const& GrpcVersion() {
+  static auto const* const kVersion = new std::string(grpc::Version());
+  return *kVersion;
+}
+
 }  // namespace
 
 opentelemetry::nostd::shared_ptr<opentelemetry::trace::Span> MakeSpanGrpc(
@@ -113,22 +119,28 @@ opentelemetry::nostd::shared_ptr<opentelemetry::trace::Span> MakeSpanGrpc(
   namespace sc = opentelemetry::trace::SemanticConventions;
   opentelemetry::trace::StartSpanOptions options;
   options.kind = opentelemetry::trace::SpanKind::kClient;
-  return internal::MakeSpan(
+  auto span = internal::MakeSpan(
       absl::StrCat(absl::string_view{service.data(), service.size()}, "/",
                    absl::string_view{method.data(), method.size()}),
       {{sc::kRpcSystem, sc::RpcSystemValues::kGrpc},
        {sc::kRpcService, service},
-       {sc::kRpcMethod, method},
-       {/*sc::kNetworkTransport=*/"network.transport",
-        sc::NetTransportValues::kIpTcp},
-       {"grpc.version", grpc::Version()}},
+       {sc::kRpcMethod, method}},
       options);
+  // The sampler only needs the attributes above. Skip the rest if the span is
+  // dropped.
+  if (!span->IsRecording()) return span;
+  span->SetAttribute(/*sc::kNetworkTransport=*/"network.transport",
+                     sc::NetTransportValues::kIpTcp);
+  span->SetAttribute("grpc.version", GrpcVersion());
+  return span;
 }
 
 void InjectTraceContext(
     grpc::ClientContext& context,
     opentelemetry::context::propagation::TextMapPropagator& propagator) {
   auto current = opentelemetry::context::RuntimeContext::GetCurrent();
+  // There is no trace to join if the sampler dropped the span.
+  if (!opentelemetry::trace::GetSpan(current)->IsRecording()) return;
   GrpcClientCarrier carrier(context);
   propagator.Inject(carrier, current);
 }
@@ -136,6 +148,7 @@ void InjectTraceContext(
 void ExtractAttributes(grpc::ClientContext& context,
                        opentelemetry::trace::Span& span,
                        GrpcMetadataView view) {
+  if (!span.IsRecording()) return;
   auto md = GetRequestMetadataFromContext(context, view);
   for (auto& kv : md.headers) {
     auto p = MakeAttribute(std::move(kv));
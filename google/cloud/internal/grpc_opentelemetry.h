@@ -60,6 +60,10 @@ opentelemetry::nostd::shared_ptr<opentelemetry::trace::Span> MakeSpanGrpc(
  *
  * @see https://opentelemetry.io/docs/concepts/instrumenting-library/#injecting-context
  *
+ * Nothing is injected if the current span is not recording, that is, if it
+ * was dropped by the sampler. The service makes its own sampling decision in
+ * that case.
+ *
  * [header]: https://cloud.google.com/trace/docs/setup#force-trace
  */
 void InjectTraceContext(
@@ -68,6 +72,8 @@ void InjectTraceContext(
 
 /**
  * Extracts attributes from the `context` and adds them to the `span`.
+ *
+ * This is a no-op if the span is not recording.
  */
 void ExtractAttributes(grpc::ClientContext& context,
                        opentelemetry::trace::Span& span, GrpcMetadataView view);
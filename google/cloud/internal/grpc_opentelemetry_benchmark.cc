@@ -0,0 +1,133 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/grpc_opentelemetry.h"
+#include "google/cloud/internal/opentelemetry.h"
+#include "google/cloud/internal/trace_propagator.h"
+#include "google/cloud/status.h"
+#include <benchmark/benchmark.h>
+#include <grpcpp/grpcpp.h>
+#ifdef GOOGLE_CLOUD_CPP_HAVE_OPENTELEMETRY
+#include <opentelemetry/sdk/resource/resource.h>
+#include <opentelemetry/sdk/trace/exporter.h>
+#include <opentelemetry/sdk/trace/samplers/always_off.h>
+#include <opentelemetry/sdk/trace/samplers/always_on.h>
+#include <opentelemetry/sdk/trace/simple_processor.h>
+#include <opentelemetry/sdk/trace/span_data.h>
+#include <opentelemetry/sdk/trace/tracer_provider.h>
+#include <opentelemetry/trace/provider.h>
+#include <opentelemetry/trace/scope.h>
+#endif  // GOOGLE_CLOUD_CPP_HAVE_OPENTELEMETRY
+#include <memory>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+// Compares the overhead of the tracing decorators for a unary RPC, with
+// tracing disabled, with spans dropped by the sampler, and with spans sampled
+// (and discarded by the exporter).
+//
+// Run with:
+//   bazel run -c opt //google/cloud:internal_grpc_opentelemetry_benchmark
+
+// The work done by a `*Stub` without tracing: just the client context.
+void BM_TracingOff(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc::ClientContext context;
+    benchmark::DoNotOptimize(Status{});
+  }
+}
+BENCHMARK(BM_TracingOff);
+
+#ifdef GOOGLE_CLOUD_CPP_HAVE_OPENTELEMETRY
+
+class DiscardingExporter : public opentelemetry::sdk::trace::SpanExporter {
+ public:
+  std::unique_ptr<opentelemetry::sdk::trace::Recordable>
+  MakeRecordable() noexcept override {
+    return std::make_unique<opentelemetry::sdk::trace::SpanData>();
+  }
+
+  opentelemetry::sdk::common::ExportResult Export(
+      opentelemetry::nostd::span<
+          std::unique_ptr<opentelemetry::sdk::trace::Recordable>> const&)
+      noexcept override {
+    return opentelemetry::sdk::common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+class ScopedTracerProvider {
+ public:
+  explicit ScopedTracerProvider(
+      std::unique_ptr<opentelemetry::sdk::trace::Sampler> sampler)
+      : previous_(opentelemetry::trace::Provider::GetTracerProvider()) {
+    auto processor =
+        std::make_unique<opentelemetry::sdk::trace::SimpleSpanProcessor>(
+            std::make_unique<DiscardingExporter>());
+    opentelemetry::trace::Provider::SetTracerProvider(
+        opentelemetry::nostd::shared_ptr<opentelemetry::trace::TracerProvider>(
+            std::make_shared<opentelemetry::sdk::trace::TracerProvider>(
+                std::move(processor),
+                opentelemetry::sdk::resource::Resource::Create({}),
+                std::move(sampler))));
+  }
+  ~ScopedTracerProvider() {
+    opentelemetry::trace::Provider::SetTracerProvider(std::move(previous_));
+  }
+
+ private:
+  opentelemetry::nostd::shared_ptr<opentelemetry::trace::TracerProvider>
+      previous_;
+};
+
+// The work done by a `*TracingStub` for a unary RPC. There is no server
+// metadata without a real call, so it is not extracted.
+void TracedRpc(
+    opentelemetry::context::propagation::TextMapPropagator& propagator) {
+  grpc::ClientContext context;
+  auto span = MakeSpanGrpc("google.bigtable.v2.Bigtable", "MutateRow");
+  auto scope = opentelemetry::trace::Scope(span);
+  InjectTraceContext(context, propagator);
+  ExtractAttributes(context, *span, GrpcMetadataView::kWithoutServerMetadata);
+  benchmark::DoNotOptimize(EndSpan(*span, Status{}));
+}
+
+void BM_TracingSampledOut(benchmark::State& state) {
+  ScopedTracerProvider provider(
+      std::make_unique<opentelemetry::sdk::trace::AlwaysOffSampler>());
+  auto propagator = MakePropagator();
+  for (auto _ : state) TracedRpc(*propagator);
+}
+BENCHMARK(BM_TracingSampledOut);
+
+void BM_TracingSampledIn(benchmark::State& state) {
+  ScopedTracerProvider provider(
+      std::make_unique<opentelemetry::sdk::trace::AlwaysOnSampler>());
+  auto propagator = MakePropagator();
+  for (auto _ : state) TracedRpc(*propagator);
+}
+BENCHMARK(BM_TracingSampledIn);
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_OPENTELEMETRY
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
@@ -106,6 +106,28 @@ TEST(OpenTelemetry, InjectTraceContextGrpc) {
   testing_util::ValidatePropagator(context);
 }
 
+TEST(OpenTelemetry, InjectTraceContextGrpcNotRecording) {
+  // Without a span catcher the spans are not recording, as if dropped by the
+  // sampler.
+  auto span = MakeSpanGrpc("google.cloud.foo.v1.Foo", "GetBar");
+  ASSERT_FALSE(span->IsRecording());
+  opentelemetry::trace::Scope scope(span);
+
+  grpc::ClientContext context;
+  auto propagator = MakePropagator();
+  InjectTraceContext(context, *propagator);
+  testing_util::ValidateNoPropagator(context);
+}
+
+TEST(OpenTelemetry, EndSpanNotRecording) {
+  // The server metadata is not set. Reading it would crash the program.
+  grpc::ClientContext context;
+  auto span = MakeSpanGrpc("google.cloud.foo.v1.Foo", "GetBar");
+  ASSERT_FALSE(span->IsRecording());
+  auto status = EndSpan(context, *span, UnavailableError("try-again"));
+  EXPECT_THAT(status, StatusIs(StatusCode::kUnavailable));
+}
+
 TEST(OpenTelemetry, EndSpan) {
   auto span_catcher = InstallSpanCatcher();
 
@@ -0,0 +1,76 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/grpc_rpc_metrics.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+absl::optional<std::chrono::nanoseconds> ParseServerTiming(
+    absl::string_view header) {
+  for (auto param : absl::StrSplit(header, ';')) {
+    param = absl::StripAsciiWhitespace(param);
+    if (!absl::ConsumePrefix(&param, "dur=")) continue;
+    double ms;
+    if (!absl::SimpleAtod(param, &ms) || ms < 0) return absl::nullopt;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double, std::milli>(ms));
+  }
+  return absl::nullopt;
+}
+
+RpcMetricsOperation::RpcMetricsOperation(Options const& options,
+                                         char const* location)
+    : metrics_(GetRpcMetrics(options.get<experimental::RpcMetricsOption>())),
+      location_(location) {
+  if (metrics_) operation_start_ = std::chrono::steady_clock::now();
+}
+
+void RpcMetricsOperation::OnAttemptStart() {
+  ++attempts_;
+  if (metrics_) attempt_start_ = std::chrono::steady_clock::now();
+}
+
+void RpcMetricsOperation::OnAttemptEnd(grpc::ClientContext& context,
+                                       StatusCode code) {
+  if (!metrics_) return;
+  metrics_->RecordAttempt(location_, code,
+                          std::chrono::steady_clock::now() - attempt_start_);
+  // The server metadata is only available if the call was started, which is
+  // not the case if the stub was mocked, or failed before making a call.
+  if (context.c_call() == nullptr) return;
+  auto const& md = context.GetServerInitialMetadata();
+  auto l = md.find("server-timing");
+  if (l == md.end()) return;
+  auto latency =
+      ParseServerTiming(absl::string_view(l->second.data(), l->second.size()));
+  if (latency) metrics_->RecordServerLatency(location_, code, *latency);
+}
+
+void RpcMetricsOperation::OnOperationEnd(StatusCode code) {
+  if (!metrics_) return;
+  metrics_->RecordOperation(location_, code,
+                            std::chrono::steady_clock::now() - operation_start_,
+                            attempts_);
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,70 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_RPC_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_RPC_METRICS_H
+
+#include "google/cloud/internal/rpc_metrics.h"
+#include "google/cloud/opentelemetry_options.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <memory>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/**
+ * Parses the server latency from a `server-timing` header.
+ *
+ * Google services report their processing time in a `server-timing` header,
+ * with the format `gfet4t7; dur=<milliseconds>`.
+ */
+absl::optional<std::chrono::nanoseconds> ParseServerTiming(
+    absl::string_view header);
+
+/**
+ * Records the `RpcMetrics` for one operation in a retry loop.
+ *
+ * If `experimental::RpcMetricsOption` is not set all the member functions are
+ * no-ops, and do not even query the clock.
+ */
+class RpcMetricsOperation {
+ public:
+  RpcMetricsOperation(Options const& options, char const* location);
+
+  void OnAttemptStart();
+  void OnAttemptEnd(grpc::ClientContext& context, StatusCode code);
+  void OnOperationEnd(StatusCode code);
+
+ private:
+  std::shared_ptr<RpcMetrics> metrics_;
+  char const* location_;
+  std::chrono::steady_clock::time_point operation_start_;
+  std::chrono::steady_clock::time_point attempt_start_;
+  int attempts_ = 0;
+};
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_GRPC_RPC_METRICS_H
@@ -0,0 +1,92 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/grpc_rpc_metrics.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Field;
+
+TEST(GrpcRpcMetrics, ParseServerTiming) {
+  EXPECT_EQ(ParseServerTiming("gfet4t7; dur=12"),
+            std::chrono::milliseconds(12));
+  EXPECT_EQ(ParseServerTiming("gfet4t7;dur=1.5"),
+            std::chrono::microseconds(1500));
+  EXPECT_EQ(ParseServerTiming("gfet4t7"), absl::nullopt);
+  EXPECT_EQ(ParseServerTiming("gfet4t7; dur=abc"), absl::nullopt);
+  EXPECT_EQ(ParseServerTiming("gfet4t7; dur=-1"), absl::nullopt);
+  EXPECT_EQ(ParseServerTiming(""), absl::nullopt);
+}
+
+TEST(GrpcRpcMetrics, DisabledByDefault) {
+  RpcMetricsOperation operation(Options{}, "Method");
+  grpc::ClientContext context;
+  operation.OnAttemptStart();
+  operation.OnAttemptEnd(context, StatusCode::kOk);
+  operation.OnOperationEnd(StatusCode::kOk);
+}
+
+TEST(GrpcRpcMetrics, RecordsAttemptsAndOperation) {
+  auto metrics = std::make_shared<RpcMetrics>("test-service");
+  RpcMetricsOperation operation(
+      Options{}.set<experimental::RpcMetricsOption>(
+          MakeRpcMetricsHandle(metrics)),
+      "Method");
+  for (auto code : {StatusCode::kUnavailable, StatusCode::kOk}) {
+    // The context was never used in a call, there is no server metadata.
+    grpc::ClientContext context;
+    operation.OnAttemptStart();
+    operation.OnAttemptEnd(context, code);
+  }
+  operation.OnOperationEnd(StatusCode::kOk);
+
+  auto points = metrics->Collect();
+  ASSERT_THAT(points,
+              ElementsAre(Field(&RpcMetricsPoint::code, StatusCode::kOk),
+                          Field(&RpcMetricsPoint::code,
+                                StatusCode::kUnavailable)));
+  EXPECT_EQ(points[0].method, "Method");
+  EXPECT_EQ(points[0].attempt_latency.count, 1);
+  EXPECT_EQ(points[0].server_latency.count, 0);
+  EXPECT_EQ(points[0].operation_latency.count, 1);
+  EXPECT_EQ(points[0].attempt_count.sum, 2.0);
+  EXPECT_EQ(points[1].attempt_latency.count, 1);
+  EXPECT_EQ(points[1].operation_latency.count, 0);
+}
+
+TEST(GrpcRpcMetrics, NoAttempts) {
+  auto metrics = std::make_shared<RpcMetrics>("test-service");
+  RpcMetricsOperation operation(
+      Options{}.set<experimental::RpcMetricsOption>(
+          MakeRpcMetricsHandle(metrics)),
+      "Method");
+  operation.OnOperationEnd(StatusCode::kCancelled);
+  auto points = metrics->Collect();
+  ASSERT_THAT(points, ElementsAre(Field(&RpcMetricsPoint::code,
+                                        StatusCode::kCancelled)));
+  EXPECT_EQ(points[0].attempt_latency.count, 0);
+  EXPECT_EQ(points[0].attempt_count.sum, 0.0);
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
@@ -46,6 +46,11 @@ class HttpPayload {
   virtual std::multimap<std::string, std::string> DebugHeaders() const {
     return {};
   }
+
+  // Interrupts a Read() call blocked in another thread. This is the only
+  // member function that may be called concurrently with Read(). The default
+  // implementation does nothing.
+  virtual void Cancel() {}
 };
 
 // This function makes one or more HttpPayload::Read calls and writes all the
@@ -14,6 +14,9 @@
 
 #include "google/cloud/internal/log_impl.h"
 #include "google/cloud/internal/getenv.h"
+#include <iterator>
+#include <string>
+#include <unordered_map>
 
 namespace google {
 namespace cloud {
@@ -76,6 +79,187 @@ thread_local std::vector<LogRecord> PerThreadCircularBufferBackend::buffer_;
 thread_local std::size_t PerThreadCircularBufferBackend::begin_ = 0;
 thread_local std::size_t PerThreadCircularBufferBackend::end_ = 0;
 
+namespace {
+
+auto constexpr kAsyncLogDrainPeriod = std::chrono::milliseconds(50);
+
+std::uint64_t NextAsyncLogBackendId() {
+  static std::atomic<std::uint64_t> generator{0};
+  return ++generator;
+}
+
+std::size_t RoundUpToPowerOfTwo(std::size_t n) {
+  std::size_t r = 1;
+  while (r < n) r <<= 1;
+  return r;
+}
+
+}  // namespace
+
+/**
+ * A single-producer, single-consumer ring buffer of log records.
+ *
+ * The producer is the thread that owns the buffer, the consumer is the drain
+ * thread. Each side only writes its own index, so no locks are needed.
+ */
+class AsyncLogBackend::Buffer {
+ public:
+  explicit Buffer(std::size_t capacity)
+      : records_(RoundUpToPowerOfTwo((std::max)(capacity, std::size_t{1}))),
+        mask_(records_.size() - 1) {}
+
+  bool Push(LogRecord& lr) {
+    auto const tail = tail_.load(std::memory_order_relaxed);
+    auto const head = head_.load(std::memory_order_acquire);
+    if (tail - head == records_.size()) return false;
+    records_[tail & mask_] = std::move(lr);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  void PopAll(std::vector<LogRecord>& out) {
+    auto head = head_.load(std::memory_order_relaxed);
+    auto const tail = tail_.load(std::memory_order_acquire);
+    for (; head != tail; ++head) {
+      out.push_back(std::move(records_[head & mask_]));
+    }
+    head_.store(head, std::memory_order_release);
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+  /// Called by the producer when its thread exits, after its last `Push()`.
+  void Close() { closed_.store(true, std::memory_order_release); }
+  bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+ private:
+  std::vector<LogRecord> records_;
+  std::size_t const mask_;
+  std::atomic<std::size_t> head_{0};
+  std::atomic<std::size_t> tail_{0};
+  std::atomic<bool> closed_{false};
+};
+
+AsyncLogBackend::AsyncLogBackend(std::size_t buffer_size,
+                                 Severity min_flush_severity,
+                                 std::shared_ptr<LogBackend> backend)
+    : buffer_size_(buffer_size),
+      min_flush_severity_(min_flush_severity),
+      backend_(std::move(backend)),
+      id_(NextAsyncLogBackendId()),
+      drain_([this] { DrainLoop(); }) {}
+
+AsyncLogBackend::~AsyncLogBackend() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  drain_cv_.notify_one();
+  drain_.join();
+}
+
+void AsyncLogBackend::ProcessWithOwnership(LogRecord lr) {
+  auto const needs_flush = lr.severity >= min_flush_severity_;
+  if (!ThreadBuffer().Push(lr)) ++discarded_;
+  if (needs_flush) Flush();
+}
+
+void AsyncLogBackend::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const target = ++flush_requested_;
+  drain_cv_.notify_one();
+  flush_cv_.wait(lk, [&] { return flush_completed_ >= target; });
+}
+
+AsyncLogBackend::Buffer& AsyncLogBackend::ThreadBuffer() {
+  // Each thread caches its buffer for each `AsyncLogBackend` object. Only
+  // `buffers_` owns the buffers, so the cache entries expire when the backend
+  // is destroyed, and are pruned when a thread adds a new entry. When the
+  // thread exits it closes its buffers, and the backend drains and releases
+  // them. While `this` is alive and the thread is running its buffer is alive
+  // too, so the raw pointer is safe to use.
+  struct CachedBuffer {
+    std::weak_ptr<Buffer> owner;
+    Buffer* buffer;
+  };
+  struct ThreadBuffers {
+    ~ThreadBuffers() {
+      for (auto& kv : entries) {
+        if (auto b = kv.second.owner.lock()) b->Close();
+      }
+    }
+    std::unordered_map<std::uint64_t, CachedBuffer> entries;
+  };
+  thread_local ThreadBuffers thread_buffers;
+  auto& entries = thread_buffers.entries;
+  auto c = entries.find(id_);
+  if (c == entries.end()) {
+    for (auto j = entries.begin(); j != entries.end();) {
+      j = j->second.owner.expired() ? entries.erase(j) : std::next(j);
+    }
+    auto b = std::make_shared<Buffer>(buffer_size_);
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      buffers_.push_back(b);
+    }
+    c = entries.emplace(id_, CachedBuffer{b, b.get()}).first;
+  }
+  return *c->second.buffer;
+}
+
+void AsyncLogBackend::DrainLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    drain_cv_.wait_for(lk, kAsyncLogDrainPeriod, [this] {
+      return shutdown_ || flush_requested_ != flush_completed_;
+    });
+    auto const target = flush_requested_;
+    auto const done = shutdown_;
+    // Release the buffers of threads that exited, once they are empty.
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                  [](std::shared_ptr<Buffer> const& b) {
+                                    return b->closed() && b->empty();
+                                  }),
+                   buffers_.end());
+    auto buffers = buffers_;
+    lk.unlock();
+    Drain(buffers);
+    lk.lock();
+    if (target != flush_completed_) {
+      flush_completed_ = target;
+      flush_cv_.notify_all();
+    }
+    if (done) return;
+  }
+}
+
+void AsyncLogBackend::Drain(
+    std::vector<std::shared_ptr<Buffer>> const& buffers) {
+  std::vector<LogRecord> batch;
+  for (auto const& b : buffers) b->PopAll(batch);
+  auto const discarded = discarded_.load();
+  if (discarded != reported_discarded_) {
+    batch.push_back(LogRecord{
+        Severity::GCP_LS_WARNING, __func__, __FILE__, __LINE__,
+        std::this_thread::get_id(), std::chrono::system_clock::now(),
+        "AsyncLogBackend discarded " +
+            std::to_string(discarded - reported_discarded_) +
+            " log records, the log buffers were full"});
+    reported_discarded_ = discarded;
+  }
+  if (batch.empty()) return;
+  // Each buffer is in order, merge the records from different threads.
+  std::stable_sort(batch.begin(), batch.end(),
+                   [](LogRecord const& a, LogRecord const& b) {
+                     return a.timestamp < b.timestamp;
+                   });
+  for (auto& lr : batch) backend_->ProcessWithOwnership(std::move(lr));
+  backend_->Flush();
+}
+
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
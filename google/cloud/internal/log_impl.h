@@ -18,6 +18,12 @@
 #include "google/cloud/log.h"
 #include "google/cloud/version.h"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace google {
@@ -97,6 +103,63 @@ class PerThreadCircularBufferBackend : public LogBackend {
   std::shared_ptr<LogBackend> backend_;
 };
 
+/**
+ * Forwards log records to another backend from a background thread.
+ *
+ * `StdClogBackend` formats and writes each record, while holding a mutex, in
+ * the thread that created the record. With RPC tracing enabled this serializes
+ * all the threads making RPCs. This backend moves each record into a ring
+ * buffer owned by the calling thread, without any locks. A background thread
+ * drains all the buffers and forwards the records, in timestamp order, to
+ * @p backend in batches.
+ *
+ * Each thread buffers at most @p buffer_size records. If the background thread
+ * falls behind, new records are discarded and counted, and the next batch
+ * includes a warning with the number of discarded records.
+ *
+ * Records with severity @p min_flush_severity or higher, and calls to
+ * `Flush()`, block until all the buffered records are written.
+ */
+class AsyncLogBackend : public LogBackend {
+ public:
+  AsyncLogBackend(std::size_t buffer_size, Severity min_flush_severity,
+                  std::shared_ptr<LogBackend> backend);
+  ~AsyncLogBackend() override;
+
+  std::size_t buffer_size() const { return buffer_size_; }
+  Severity min_flush_severity() const { return min_flush_severity_; }
+  std::shared_ptr<LogBackend> backend() const { return backend_; }
+  /// The number of records discarded because a buffer was full.
+  std::uint64_t discarded() const { return discarded_.load(); }
+
+  void Process(LogRecord const& lr) override { ProcessWithOwnership(lr); }
+  void ProcessWithOwnership(LogRecord lr) override;
+  void Flush() override;
+
+ private:
+  class Buffer;
+
+  Buffer& ThreadBuffer();
+  void DrainLoop();
+  void Drain(std::vector<std::shared_ptr<Buffer>> const& buffers);
+
+  std::size_t const buffer_size_;
+  Severity const min_flush_severity_;
+  std::shared_ptr<LogBackend> const backend_;
+  std::uint64_t const id_;
+  std::atomic<std::uint64_t> discarded_{0};
+  std::uint64_t reported_discarded_ = 0;  // only used by `drain_`
+
+  std::mutex mu_;
+  std::condition_variable drain_cv_;
+  std::condition_variable flush_cv_;
+  std::vector<std::shared_ptr<Buffer>> buffers_;  // ABSL_GUARDED_BY(mu_)
+  std::uint64_t flush_requested_ = 0;             // ABSL_GUARDED_BY(mu_)
+  std::uint64_t flush_completed_ = 0;             // ABSL_GUARDED_BY(mu_)
+  bool shutdown_ = false;                         // ABSL_GUARDED_BY(mu_)
+  std::thread drain_;
+};
+
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
@@ -16,6 +16,9 @@
 #include "google/cloud/testing_util/scoped_environment.h"
 #include "google/cloud/testing_util/scoped_log.h"
 #include <gmock/gmock.h>
+#include <future>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -25,8 +28,11 @@ namespace {
 
 using ::google::cloud::testing_util::ScopedEnvironment;
 using ::google::cloud::testing_util::ScopedLog;
+using ::testing::Contains;
 using ::testing::ElementsAre;
+using ::testing::HasSubstr;
 using ::testing::IsEmpty;
+using ::testing::Not;
 using ::testing::NotNull;
 
 auto constexpr kLogConfig = "GOOGLE_CLOUD_CPP_EXPERIMENTAL_LOG_CONFIG";
@@ -125,6 +131,111 @@ TEST(PerThreadCircularBufferBackend, Basic) {
   EXPECT_THAT(be->ExtractLines(), ElementsAre("msg 9", "msg 10"));
 }
 
+LogRecord TestLogRecord(Severity severity, std::string msg) {
+  return LogRecord{severity,
+                   "test_function()",
+                   "file",
+                   1,
+                   std::this_thread::get_id(),
+                   std::chrono::system_clock::now(),
+                   std::move(msg)};
+}
+
+TEST(AsyncLogBackend, Basic) {
+  auto be = std::make_shared<ScopedLog::Backend>();
+  AsyncLogBackend async(16, Severity::GCP_LS_ERROR, be);
+  async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_INFO, "msg 1"));
+  async.Process(TestLogRecord(Severity::GCP_LS_DEBUG, "msg 2"));
+  async.Flush();
+  EXPECT_THAT(be->ExtractLines(), ElementsAre("msg 1", "msg 2"));
+
+  // High severity messages are written before `Process*()` returns.
+  async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_INFO, "msg 3"));
+  async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_ERROR, "msg 4"));
+  EXPECT_THAT(be->ExtractLines(), ElementsAre("msg 3", "msg 4"));
+  EXPECT_EQ(async.discarded(), 0U);
+}
+
+TEST(AsyncLogBackend, MultipleThreads) {
+  auto constexpr kThreads = 4;
+  auto constexpr kRecords = 100;
+  auto be = std::make_shared<ScopedLog::Backend>();
+  AsyncLogBackend async(kRecords, Severity::GCP_LS_FATAL, be);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&async, t] {
+      for (int i = 0; i != kRecords; ++i) {
+        async.ProcessWithOwnership(TestLogRecord(
+            Severity::GCP_LS_INFO,
+            "thread " + std::to_string(t) + " msg " + std::to_string(i)));
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  async.Flush();
+  // Records from each thread are written in order.
+  auto const lines = be->ExtractLines();
+  EXPECT_EQ(lines.size(), std::size_t{kThreads * kRecords});
+  for (int t = 0; t != kThreads; ++t) {
+    auto const prefix = "thread " + std::to_string(t) + " msg ";
+    int expected = 0;
+    for (auto const& l : lines) {
+      if (l.rfind(prefix, 0) != 0) continue;
+      EXPECT_EQ(l, prefix + std::to_string(expected));
+      ++expected;
+    }
+    EXPECT_EQ(expected, kRecords);
+  }
+}
+
+TEST(AsyncLogBackend, DiscardWhenFull) {
+  // A backend that blocks the drain thread on the first record.
+  class BlockingBackend : public ScopedLog::Backend {
+   public:
+    void ProcessWithOwnership(LogRecord lr) override {
+      if (lr.message == "block") {
+        blocked.set_value();
+        release.get_future().wait();
+      }
+      ScopedLog::Backend::ProcessWithOwnership(std::move(lr));
+    }
+    std::promise<void> blocked;
+    std::promise<void> release;
+  };
+
+  auto be = std::make_shared<BlockingBackend>();
+  AsyncLogBackend async(1, Severity::GCP_LS_FATAL, be);
+  async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_INFO, "block"));
+  be->blocked.get_future().wait();
+
+  async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_INFO, "msg 1"));
+  for (int i = 0; i != 5; ++i) {
+    async.ProcessWithOwnership(TestLogRecord(Severity::GCP_LS_INFO, "lost"));
+  }
+  EXPECT_EQ(async.discarded(), 5U);
+  be->release.set_value();
+  async.Flush();
+
+  auto const lines = be->ExtractLines();
+  EXPECT_THAT(lines, Contains("block"));
+  EXPECT_THAT(lines, Contains("msg 1"));
+  EXPECT_THAT(lines, Contains(HasSubstr("discarded 5 log records")));
+  EXPECT_THAT(lines, Not(Contains("lost")));
+}
+
+TEST(AsyncLogBackend, ShortLivedBackends) {
+  // The same thread logs to many backends, each destroyed before the next one
+  // is created. Each backend only sees its own records.
+  for (int i = 0; i != 100; ++i) {
+    auto be = std::make_shared<ScopedLog::Backend>();
+    AsyncLogBackend async(16, Severity::GCP_LS_FATAL, be);
+    async.ProcessWithOwnership(
+        TestLogRecord(Severity::GCP_LS_INFO, "msg " + std::to_string(i)));
+    async.Flush();
+    EXPECT_THAT(be->ExtractLines(), ElementsAre("msg " + std::to_string(i)));
+  }
+}
+
 TEST(DefaultLogBackend, CircularBuffer) {
   ScopedEnvironment config(kLogConfig, "lastN,5,WARNING");
   ScopedEnvironment clog(kEnableClog, absl::nullopt);
@@ -151,6 +262,19 @@ TEST(DefaultLogBackend, PerThreadCircularBuffer) {
   EXPECT_EQ(Severity::GCP_LS_DEBUG, clog_be->min_severity());
 }
 
+TEST(DefaultLogBackend, Async) {
+  ScopedEnvironment config(kLogConfig, "async,1024,WARNING");
+  ScopedEnvironment clog(kEnableClog, absl::nullopt);
+  auto be = DefaultLogBackend();
+  auto const* async = dynamic_cast<AsyncLogBackend*>(be.get());
+  ASSERT_NE(async, nullptr);
+  EXPECT_EQ(1024U, async->buffer_size());
+  EXPECT_EQ(Severity::GCP_LS_WARNING, async->min_flush_severity());
+  auto const* clog_be = dynamic_cast<StdClogBackend*>(async->backend().get());
+  ASSERT_THAT(clog_be, NotNull());
+  EXPECT_EQ(Severity::GCP_LS_DEBUG, clog_be->min_severity());
+}
+
 TEST(DefaultLogBackend, CLog) {
   ScopedEnvironment config(kLogConfig, "clog");
   ScopedEnvironment clog(kEnableClog, absl::nullopt);
@@ -13,11 +13,84 @@
 // limitations under the License.
 
 #include "google/cloud/internal/log_wrapper.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace google {
 namespace cloud {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace internal {
+namespace {
+
+class RpcLogSampler {
+ public:
+  bool Sample(char const* where, std::int64_t one_in,
+              std::int64_t per_second) {
+    auto& m = Lookup(where);
+    if (one_in > 1 &&
+        m.calls.fetch_add(1, std::memory_order_relaxed) % one_in != 0) {
+      return false;
+    }
+    if (per_second <= 0) return true;
+    // Refill the token counter when the current one second window expires.
+    // Only the thread that starts the new window refills it. The budget is
+    // approximate, a few extra RPCs may be logged (or skipped) when the
+    // window changes.
+    auto const now = std::chrono::steady_clock::now().time_since_epoch();
+    auto start = m.window_start.load(std::memory_order_relaxed);
+    if ((start == kNoWindow ||
+         now - Duration(start) >= std::chrono::seconds(1)) &&
+        m.window_start.compare_exchange_strong(start, now.count(),
+                                               std::memory_order_relaxed)) {
+      m.tokens.store(per_second, std::memory_order_relaxed);
+    }
+    return m.tokens.fetch_sub(1, std::memory_order_relaxed) > 0;
+  }
+
+ private:
+  using Duration = std::chrono::steady_clock::duration;
+  static auto constexpr kNoWindow = std::numeric_limits<Duration::rep>::min();
+
+  struct Method {
+    std::atomic<std::int64_t> calls{0};
+    std::atomic<Duration::rep> window_start{kNoWindow};
+    std::atomic<std::int64_t> tokens{0};
+  };
+
+  Method& Lookup(char const* where) {
+    // The `where` argument is (almost always) `__func__`, so the pointer
+    // identifies the method without hashing or copying the name. Each thread
+    // caches the methods it uses, so `mu_` is only locked the first time a
+    // thread logs each method. The `Method` objects are never deleted.
+    thread_local std::unordered_map<char const*, Method*> cache;
+    auto& cached = cache[where];
+    if (cached != nullptr) return *cached;
+    std::lock_guard<std::mutex> lk(mu_);
+    auto& m = methods_[where];
+    if (!m) m = std::make_unique<Method>();
+    cached = m.get();
+    return *cached;
+  }
+
+  std::mutex mu_;
+  std::unordered_map<char const*, std::unique_ptr<Method>>
+      methods_;  // ABSL_GUARDED_BY(mu_)
+};
+
+}  // namespace
+
+bool ShouldLogRpc(char const* where, TracingOptions const& options) {
+  auto const one_in = options.log_one_in();
+  auto const per_second = options.max_logs_per_second();
+  if (one_in <= 1 && per_second <= 0) return true;
+  static auto* const kSampler = new RpcLogSampler;
+  return kSampler->Sample(where, one_in, per_second);
+}
 
 void LogRequest(absl::string_view where, absl::string_view args,
                 absl::string_view message) {
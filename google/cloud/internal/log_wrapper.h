@@ -61,9 +61,26 @@ struct IsFutureStatus : public std::false_type {};
 template <>
 struct IsFutureStatus<future<Status>> : public std::true_type {};
 
+/**
+ * Returns true if the RPC to @p where should be logged.
+ *
+ * Applies the `log_one_in` and `max_logs_per_second` parameters in @p options
+ * to each method (i.e., each value of @p where) independently. This is cheap
+ * if neither parameter is set, as then all the RPCs are logged.
+ */
+bool ShouldLogRpc(char const* where, TracingOptions const& options);
+
 void LogRequest(absl::string_view where, absl::string_view args,
                 absl::string_view message);
 
+/// Formats @p request only if the log record is emitted.
+template <typename Request>
+void LogRequest(absl::string_view where, absl::string_view args,
+                Request const& request, TracingOptions const& options) {
+  GCP_LOG(DEBUG) << where << '(' << args << ')' << " << "
+                 << DebugString(request, options);
+}
+
 Status LogResponse(Status response, absl::string_view where,
                    absl::string_view args, TracingOptions const& options);
 
@@ -112,7 +129,10 @@ template <typename Functor, typename Request, typename Context,
 Result LogWrapper(Functor&& functor, Context&& context, Options const& opts,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
-  LogRequest(where, "", DebugString(request, options));
+  if (!ShouldLogRpc(where, options)) {
+    return functor(std::forward<Context>(context), opts, request);
+  }
+  LogRequest(where, "", request, options);
   return LogResponse(functor(std::forward<Context>(context), opts, request),
                      where, "", options);
 }
@@ -138,7 +158,8 @@ template <
 Result LogWrapper(Functor&& functor, grpc::ClientContext& context,
                   Request const& request, grpc::CompletionQueue* cq,
                   char const* where, TracingOptions const& options) {
-  LogRequest(where, "", DebugString(request, options));
+  if (!ShouldLogRpc(where, options)) return functor(context, request, cq);
+  LogRequest(where, "", request, options);
   return LogResponse(functor(context, request, cq), where, "", options);
 }
 
@@ -150,10 +171,13 @@ Result LogWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
                   Context&& context, Options const& opts,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  if (!ShouldLogRpc(where, options)) {
+    return functor(cq, std::forward<Context>(context), opts, request);
+  }
   // Because this is an asynchronous request we need a unique identifier so
   // applications can match the request and response in the log.
   auto args = RequestIdForLogging();
-  LogRequest(where, args, DebugString(request, options));
+  LogRequest(where, args, request, options);
   return LogResponse(functor(cq, std::forward<Context>(context), opts, request),
                      where, std::move(args), options);
 }
@@ -166,10 +190,14 @@ Result LogWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
                   Context&& context, ImmutableOptions opts,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  if (!ShouldLogRpc(where, options)) {
+    return functor(cq, std::forward<Context>(context), std::move(opts),
+                   request);
+  }
   // Because this is an asynchronous request we need a unique identifier so
   // applications can match the request and response in the log.
   auto args = RequestIdForLogging();
-  LogRequest(where, args, DebugString(request, options));
+  LogRequest(where, args, request, options);
   return LogResponse(
       functor(cq, std::forward<Context>(context), std::move(opts), request),
       where, std::move(args), options);
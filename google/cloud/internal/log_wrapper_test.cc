@@ -21,9 +21,12 @@
 #include <google/protobuf/duration.pb.h>
 #include <google/protobuf/timestamp.pb.h>
 #include <gmock/gmock.h>
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -389,6 +392,64 @@ TYPED_TEST(LogWrapperTest, AsyncErrorExplicitOptions) {
                                         HasSubstr(" >> future_status="))));
 }
 
+std::size_t CountRequests(std::vector<std::string> const& lines,
+                          std::string const& where) {
+  return static_cast<std::size_t>(
+      std::count_if(lines.begin(), lines.end(), [&](std::string const& l) {
+        return l.find(where + "(") != std::string::npos &&
+               l.find(" << ") != std::string::npos;
+      }));
+}
+
+TEST(LogWrapperSampling, LogOneIn) {
+  auto functor = [](TestContext&, Request const&) { return Status{}; };
+  auto const options = TracingOptions{}.SetOptions("log_one_in=3");
+
+  testing_util::ScopedLog log;
+  TestContext context;
+  for (int i = 0; i != 7; ++i) {
+    EXPECT_THAT(LogWrapper(functor, context, MakeRequest(), "log-one-in",
+                           options),
+                IsOk());
+  }
+  // The first, fourth, and seventh calls are logged.
+  EXPECT_EQ(CountRequests(log.ExtractLines(), "log-one-in"), 3);
+}
+
+TEST(LogWrapperSampling, MaxLogsPerSecond) {
+  auto functor = [](TestContext&, Request const&) { return Status{}; };
+  auto const options = TracingOptions{}.SetOptions("max_logs_per_second=2");
+
+  testing_util::ScopedLog log;
+  TestContext context;
+  for (int i = 0; i != 5; ++i) {
+    EXPECT_THAT(LogWrapper(functor, context, MakeRequest(),
+                           "max-logs-per-second", options),
+                IsOk());
+  }
+  // The calls complete well within one second, only the first 2 are logged.
+  EXPECT_EQ(CountRequests(log.ExtractLines(), "max-logs-per-second"), 2);
+}
+
+TEST(LogWrapperSampling, SkippedCallsStillRun) {
+  int calls = 0;
+  auto functor = [&calls](TestContext&, Request const&) {
+    ++calls;
+    return StatusOr<Response>(MakeResponse());
+  };
+  auto const options = TracingOptions{}.SetOptions("log_one_in=1000");
+
+  testing_util::ScopedLog log;
+  TestContext context;
+  for (int i = 0; i != 3; ++i) {
+    EXPECT_THAT(LogWrapper(functor, context, MakeRequest(), "skipped-calls",
+                           options),
+                IsOkAndHolds(IsProtoEqual(MakeResponse())));
+  }
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(CountRequests(log.ExtractLines(), "skipped-calls"), 1);
+}
+
 }  // namespace
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
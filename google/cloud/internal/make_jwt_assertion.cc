@@ -31,6 +31,16 @@ StatusOr<std::string> MakeJWTAssertionNoThrow(std::string const& header,
   return body + '.' + UrlsafeBase64Encode(*pem_signature);
 }
 
+StatusOr<std::string> MakeJWTAssertionNoThrow(std::string const& header,
+                                              std::string const& payload,
+                                              SigningKey const& key) {
+  auto const body =
+      UrlsafeBase64Encode(header) + '.' + UrlsafeBase64Encode(payload);
+  auto signature = internal::SignUsingSha256(body, key);
+  if (!signature) return std::move(signature).status();
+  return body + '.' + UrlsafeBase64Encode(*signature);
+}
+
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
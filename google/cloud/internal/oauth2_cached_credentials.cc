@@ -34,23 +34,34 @@ inline bool Expired(AccessToken const& token,
 }  // namespace
 
 CachedCredentials::CachedCredentials(std::shared_ptr<Credentials> impl)
-    : impl_(std::move(impl)) {}
+    : impl_(std::move(impl)),
+      token_(std::make_shared<AccessToken const>()) {}
 
 CachedCredentials::~CachedCredentials() = default;
 
 StatusOr<AccessToken> CachedCredentials::GetToken(
     std::chrono::system_clock::time_point now) {
-  std::lock_guard<std::mutex> lk(mu_);
-  if (!ExpiringSoon(token_, now)) return token_;
+  auto token = token_.load();
+  if (!ExpiringSoon(*token, now)) return *token;
+  // Only one thread refreshes the token. If the current token is still usable
+  // the other threads return it instead of waiting for the refresh.
+  std::unique_lock<std::mutex> lk(refresh_mu_, std::try_to_lock);
+  if (!lk.owns_lock()) {
+    if (!Expired(*token, now)) return *token;
+    lk.lock();
+  }
+  // Another thread may have refreshed the token while we waited for the lock.
+  token = token_.load();
+  if (!ExpiringSoon(*token, now)) return *token;
   auto refreshed = impl_->GetToken(now);
   if (!refreshed) {
     // Refreshing the token may have failed, but the old token may still be
     // usable
-    if (Expired(token_, now)) return std::move(refreshed).status();
-    return token_;
+    if (Expired(*token, now)) return std::move(refreshed).status();
+    return *token;
   }
-  token_ = *std::move(refreshed);
-  return token_;
+  token_.store(std::make_shared<AccessToken const>(*refreshed));
+  return *std::move(refreshed);
 }
 
 StatusOr<std::vector<std::uint8_t>> CachedCredentials::SignBlob(
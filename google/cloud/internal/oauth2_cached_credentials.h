@@ -15,8 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_OAUTH2_CACHED_CREDENTIALS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_OAUTH2_CACHED_CREDENTIALS_H
 
+#include "google/cloud/internal/atomic_shared_ptr.h"
 #include "google/cloud/internal/oauth2_credentials.h"
 #include "google/cloud/version.h"
+#include <memory>
 #include <mutex>
 
 namespace google {
@@ -35,6 +37,10 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
  * save CPU resources, as creating tokens typically involve some kind of
  * cryptographic signature.
  *
+ * The cached token is published as an immutable snapshot, threads that find a
+ * fresh token never wait for a refresh. At most one thread refreshes the
+ * token, while the old token is still valid other threads continue to use it.
+ *
  * @see https://cloud.google.com/docs/authentication/ for an overview of
  * authenticating to Google Cloud Platform APIs.
  */
@@ -57,8 +63,8 @@ class CachedCredentials : public Credentials {
 
  private:
   std::shared_ptr<Credentials> impl_;
-  std::mutex mu_;
-  AccessToken token_;
+  std::mutex refresh_mu_;
+  internal::AtomicSharedPtr<AccessToken const> token_;
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
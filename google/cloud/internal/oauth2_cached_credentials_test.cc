@@ -19,6 +19,8 @@
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -136,6 +138,25 @@ TEST(CachedCredentials, GetTokenExpiredWithError) {
   EXPECT_THAT(a2, StatusIs(StatusCode::kUnavailable));
 }
 
+TEST(CachedCredentials, GetTokenSingleFlight) {
+  auto mock = std::make_shared<MockCredentials>();
+  auto const now = std::chrono::system_clock::now();
+  auto const expected = AccessToken{"test-token", now + std::chrono::hours(1)};
+  // Only one of the threads should refresh the token, the others wait for it.
+  EXPECT_CALL(*mock, GetToken).WillOnce([&](auto) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return make_status_or(expected);
+  });
+  CachedCredentials tested(mock);
+  std::vector<StatusOr<AccessToken>> actual(8);
+  std::vector<std::thread> threads;
+  for (auto& a : actual) {
+    threads.emplace_back([&tested, &a, now] { a = tested.GetToken(now); });
+  }
+  for (auto& t : threads) t.join();
+  for (auto const& a : actual) EXPECT_THAT(a, IsOkAndHolds(expected));
+}
+
 TEST(CachedCredentials, SignBlob) {
   auto mock = std::make_shared<MockCredentials>();
   auto const expected = std::vector<std::uint8_t>{1, 2, 3};
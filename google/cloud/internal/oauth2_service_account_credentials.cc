@@ -208,7 +208,9 @@ StatusOr<AccessToken> ParseServiceAccountRefreshResponse(
   return AccessToken{access_token.value("access_token", ""), now + expires_in};
 }
 
-StatusOr<std::string> MakeSelfSignedJWT(
+namespace {
+
+std::pair<std::string, std::string> SelfSignedJWTComponents(
     ServiceAccountCredentialsInfo const& info,
     std::chrono::system_clock::time_point tp) {
   auto scope = [&info]() -> std::string {
@@ -236,7 +238,16 @@ StatusOr<std::string> MakeSelfSignedJWT(
       {"scope", scope()},
   };
 
-  return MakeJWTAssertionNoThrow(header.dump(), payload.dump(),
+  return std::make_pair(header.dump(), payload.dump());
+}
+
+}  // namespace
+
+StatusOr<std::string> MakeSelfSignedJWT(
+    ServiceAccountCredentialsInfo const& info,
+    std::chrono::system_clock::time_point tp) {
+  auto const components = SelfSignedJWTComponents(info, tp);
+  return MakeJWTAssertionNoThrow(components.first, components.second,
                                  info.private_key);
 }
 
@@ -248,7 +259,12 @@ ServiceAccountCredentials::ServiceAccountCredentials(
           std::move(options),
           Options{}.set<ServiceAccountCredentialsTokenUriOption>(
               info_.token_uri))),
-      client_factory_(std::move(client_factory)) {}
+      client_factory_(std::move(client_factory)) {
+  // Parsing the key is expensive, do it once. If the key is invalid we keep
+  // using the PEM contents, which reports the errors on each use.
+  auto key = internal::ParseSigningKey(info_.private_key);
+  if (key) signing_key_ = *std::move(key);
+}
 
 StatusOr<AccessToken> ServiceAccountCredentials::GetToken(
     std::chrono::system_clock::time_point tp) {
@@ -266,6 +282,7 @@ StatusOr<std::vector<std::uint8_t>> ServiceAccountCredentials::SignBlob(
             signing_account.value(),
         GCP_ERROR_INFO());
   }
+  if (signing_key_) return internal::SignUsingSha256(blob, *signing_key_);
   return internal::SignUsingSha256(blob, info_.private_key);
 }
 
@@ -331,7 +348,14 @@ StatusOr<AccessToken> ServiceAccountCredentials::GetTokenOAuth(
 
 StatusOr<AccessToken> ServiceAccountCredentials::GetTokenSelfSigned(
     std::chrono::system_clock::time_point tp) const {
-  auto token = MakeSelfSignedJWT(info_, tp);
+  if (!signing_key_) {
+    auto token = MakeSelfSignedJWT(info_, tp);
+    if (!token) return std::move(token).status();
+    return AccessToken{*token, tp + GoogleOAuthAccessTokenLifetime()};
+  }
+  auto const components = SelfSignedJWTComponents(info_, tp);
+  auto token = MakeJWTAssertionNoThrow(components.first, components.second,
+                                       *signing_key_);
   if (!token) return std::move(token).status();
   return AccessToken{*token, tp + GoogleOAuthAccessTokenLifetime()};
 }
@@ -18,11 +18,13 @@
 #include "google/cloud/internal/oauth2_credential_constants.h"
 #include "google/cloud/internal/oauth2_credentials.h"
 #include "google/cloud/internal/oauth2_http_client_factory.h"
+#include "google/cloud/internal/sign_using_sha256.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include "absl/types/optional.h"
 #include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -246,6 +248,7 @@ class ServiceAccountCredentials : public oauth2_internal::Credentials {
   ServiceAccountCredentialsInfo info_;
   Options options_;
   HttpClientFactory client_factory_;
+  std::shared_ptr<internal::SigningKey const> signing_key_;
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
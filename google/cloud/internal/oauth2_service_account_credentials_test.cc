@@ -35,6 +35,7 @@ namespace oauth2_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
+using ::google::cloud::internal::ParseSigningKey;
 using ::google::cloud::internal::SignUsingSha256;
 using ::google::cloud::internal::UrlsafeBase64Decode;
 using ::google::cloud::rest_internal::RestRequest;
@@ -815,6 +816,23 @@ TEST(ServiceAccountCredentialsTest, MakeJWTAssertion) {
   EXPECT_EQ(payload, expected_payload);
 }
 
+/// @test Verify a parsed key produces the same signatures as the PEM contents.
+TEST(ServiceAccountCredentialsTest, ParseSigningKey) {
+  auto key = ParseSigningKey(kPrivateKey);
+  ASSERT_STATUS_OK(key);
+
+  // RS256 signatures are deterministic, and the key is reusable.
+  for (std::string blob : {"test-blob-1", "test-blob-2", "test-blob-1"}) {
+    SCOPED_TRACE("Testing with " + blob);
+    auto const expected = SignUsingSha256(blob, kPrivateKey);
+    ASSERT_STATUS_OK(expected);
+    EXPECT_THAT(SignUsingSha256(blob, **key), IsOkAndHolds(*expected));
+  }
+
+  EXPECT_THAT(ParseSigningKey("not-a-valid-pem"),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
 /// @test Verify we can construct a service account refresh payload given the
 /// info parsed from a keyfile.
 TEST(ServiceAccountCredentialsTest, CreateServiceAccountRefreshPayload) {
@@ -74,10 +74,28 @@ std::string CaptureSslErrors() {
   return msg;
 }
 
+auto constexpr kOpenSslSuccess = 1;
+
 }  // namespace
 
-StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
-    std::string const& str, std::string const& pem_contents) {
+class SigningKey {
+ public:
+  SigningKey(std::unique_ptr<EVP_PKEY, OpenSslDeleter> key,
+             std::unique_ptr<EVP_MD_CTX, OpenSslDeleter> prototype)
+      : key_(std::move(key)), prototype_(std::move(prototype)) {}
+
+  EVP_PKEY* key() const { return key_.get(); }
+  // A digest context already initialized to sign with `key()`. Copying it is
+  // cheaper than initializing a new context for each signature.
+  EVP_MD_CTX const* prototype() const { return prototype_.get(); }
+
+ private:
+  std::unique_ptr<EVP_PKEY, OpenSslDeleter> key_;
+  std::unique_ptr<EVP_MD_CTX, OpenSslDeleter> prototype_;
+};
+
+StatusOr<std::shared_ptr<SigningKey const>> ParseSigningKey(
+    std::string const& pem_contents) {
   ERR_clear_error();
   auto pem_buffer = std::unique_ptr<BIO, OpenSslDeleter>(BIO_new_mem_buf(
       pem_contents.data(), static_cast<int>(pem_contents.length())));
@@ -115,7 +133,6 @@ StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
         GCP_ERROR_INFO());
   }
 
-  auto constexpr kOpenSslSuccess = 1;
   if (EVP_DigestSignInit(digest_ctx.get(), nullptr, EVP_sha256(), nullptr,
                          private_key.get()) != kOpenSslSuccess) {
     return internal::InvalidArgumentError(
@@ -125,6 +142,36 @@ StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
         GCP_ERROR_INFO());
   }
 
+  return std::shared_ptr<SigningKey const>(std::make_shared<SigningKey>(
+      std::move(private_key), std::move(digest_ctx)));
+}
+
+StatusOr<std::vector<std::uint8_t>> SignUsingSha256(std::string const& str,
+                                                    SigningKey const& key) {
+  ERR_clear_error();
+  auto digest_ctx = GetDigestCtx();
+  if (!digest_ctx) {
+    return internal::InvalidArgumentError(
+        "Invalid ServiceAccountCredentials - "
+        "could not create context for OpenSSL digest: " +
+            CaptureSslErrors(),
+        GCP_ERROR_INFO());
+  }
+
+  if (EVP_MD_CTX_copy_ex(digest_ctx.get(), key.prototype()) !=
+      kOpenSslSuccess) {
+    // Some providers cannot duplicate signing contexts, initialize a new one.
+    ERR_clear_error();
+    if (EVP_DigestSignInit(digest_ctx.get(), nullptr, EVP_sha256(), nullptr,
+                           key.key()) != kOpenSslSuccess) {
+      return internal::InvalidArgumentError(
+          "Invalid ServiceAccountCredentials - "
+          "could not initialize signing digest: " +
+              CaptureSslErrors(),
+          GCP_ERROR_INFO());
+    }
+  }
+
   if (EVP_DigestSignUpdate(digest_ctx.get(), str.data(), str.size()) !=
       kOpenSslSuccess) {
     return internal::InvalidArgumentError(
@@ -159,6 +206,13 @@ StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
       {buffer.begin(), std::next(buffer.begin(), actual_len)});
 }
 
+StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
+    std::string const& str, std::string const& pem_contents) {
+  auto key = ParseSigningKey(pem_contents);
+  if (!key) return std::move(key).status();
+  return SignUsingSha256(str, **key);
+}
+
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
@@ -94,6 +94,8 @@ opentelemetry::nostd::shared_ptr<opentelemetry::trace::Span> MakeSpan(
 }
 
 void EndSpanImpl(opentelemetry::trace::Span& span, Status const& status) {
+  // Avoid formatting the attributes if the sampler dropped the span.
+  if (!span.IsRecording()) return span.End();
   span.SetAttribute("gl-cpp.status_code", StatusCodeToString(status.code()));
   if (status.ok()) {
     span.SetStatus(opentelemetry::trace::StatusCode::kOk);
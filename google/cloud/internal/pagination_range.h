@@ -15,14 +15,21 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_PAGINATION_RANGE_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_PAGINATION_RANGE_H
 
+#include "google/cloud/common_options.h"
+#include "google/cloud/internal/call_context.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/type_traits.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/stream_range.h"
 #include "google/cloud/version.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -60,6 +67,10 @@ using PaginationRange = StreamRange<T>;
  * Users should not use this class directly. Use the `MakePaginationRange()`
  * function (defined below) instead.
  *
+ * If `prefetch_depth` is not zero, a background thread fetches up to that many
+ * pages ahead of the page consumed by the application. The pages are always
+ * fetched in order, as each request needs the token from the previous response.
+ *
  * @tparam T the type of the items, typically a proto describing the resources
  * @tparam Request the type of the request object for the `List` RPC.
  * @tparam Response the type of the response object for the `List` RPC.
@@ -77,15 +88,33 @@ class PagedStreamReader {
    * @param loader makes the RPC request to fetch a new page of items.
    * @param extractor extracts the items from the response using native C++
    *     types (as opposed to the proto types used in `Response`).
+   * @param prefetch_depth the maximum number of pages fetched before the
+   *     application consumes them. Zero disables prefetching.
    */
   PagedStreamReader(Request request, Loader loader,
-                    std::function<std::vector<T>(Response)> extractor)
+                    std::function<std::vector<T>(Response)> extractor,
+                    std::size_t prefetch_depth = 0)
       : request_(std::move(request)),
         loader_(std::move(loader)),
-        extractor_(std::move(extractor)) {
+        extractor_(std::move(extractor)),
+        prefetch_depth_(prefetch_depth) {
     current_ = page_.begin();
   }
 
+  ~PagedStreamReader() {
+    if (!prefetcher_.joinable()) return;
+    // Any request in progress completes before the thread exits.
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    cv_.notify_all();
+    prefetcher_.join();
+  }
+
+  PagedStreamReader(PagedStreamReader const&) = delete;
+  PagedStreamReader& operator=(PagedStreamReader const&) = delete;
+
   /**
    * Fetches (or returns if already fetched) the next object from the stream.
    *
@@ -94,6 +123,7 @@ class PagedStreamReader {
    *   successful end of stream.
    */
   typename StreamReader<T>::result_type GetNext(Options const& options) {
+    if (prefetch_depth_ != 0) return GetNextPrefetched();
     while (current_ == page_.end() && !last_page_) {
       request_.set_page_token(std::move(token_));
       auto response = loader_(options, request_);
@@ -108,6 +138,63 @@ class PagedStreamReader {
   }
 
  private:
+  struct Page {
+    StatusOr<std::vector<T>> items;
+    bool last;
+  };
+
+  typename StreamReader<T>::result_type GetNextPrefetched() {
+    while (current_ == page_.end() && !last_page_) {
+      if (!prefetcher_.joinable()) {
+        // Capture the options and tracing context of the caller, the loader
+        // runs in the background thread.
+        prefetcher_ =
+            std::thread(&PagedStreamReader::Prefetch, this, CallContext{});
+      }
+      std::unique_lock<std::mutex> lk(mu_);
+      cv_.wait(lk, [this] { return !pages_.empty(); });
+      auto next = std::move(pages_.front());
+      pages_.pop_front();
+      lk.unlock();
+      cv_.notify_all();
+      last_page_ = next.last;
+      if (!next.items) return std::move(next.items).status();
+      page_ = *std::move(next.items);
+      current_ = page_.begin();
+    }
+    if (current_ == page_.end()) return Status{};
+    return std::move(*current_++);
+  }
+
+  void Prefetch(CallContext call_context) {
+    auto const options = call_context.options;
+    ScopedCallContext scope(std::move(call_context));
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [this] {
+          return shutdown_ || pages_.size() < prefetch_depth_;
+        });
+        if (shutdown_) return;
+      }
+      request_.set_page_token(std::move(token_));
+      auto response = loader_(*options, request_);
+      auto page = [&]() -> Page {
+        if (!response) return Page{std::move(response).status(), true};
+        token_ = ExtractPageToken(*response);
+        auto const last = token_.empty();
+        return Page{extractor_(*std::move(response)), last};
+      }();
+      auto const last = page.last;
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        pages_.push_back(std::move(page));
+      }
+      cv_.notify_all();
+      if (last) return;
+    }
+  }
+
   template <typename U, typename AlwaysVoid = void>
   struct HasMutableNextPageToken : public std::false_type {};
   template <typename U>
@@ -194,6 +281,15 @@ class PagedStreamReader {
   typename std::vector<T>::iterator current_;
   std::string token_;
   bool last_page_ = false;
+
+  // Only used when prefetching pages. The background thread owns `request_`
+  // and `token_` while it is running.
+  std::size_t prefetch_depth_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Page> pages_;
+  bool shutdown_ = false;
+  std::thread prefetcher_;
 };
 
 /**
@@ -234,8 +330,10 @@ Range MakePaginationRange(ImmutableOptions options, Request request,
   static_assert(std::is_same<ExtractorResult, std::vector<ValueType>>::value,
                 "Expected extractor functor like vector<ValueType>(Response)");
   using ReaderType = PagedStreamReader<ValueType, Request, Response>;
-  auto reader = std::make_shared<ReaderType>(
-      std::move(request), std::move(loader), std::move(extractor));
+  auto const prefetch_depth = options->get<PaginationPrefetchDepthOption>();
+  auto reader =
+      std::make_shared<ReaderType>(std::move(request), std::move(loader),
+                                   std::move(extractor), prefetch_depth);
   return MakeStreamRange<ValueType>(std::move(options),
                                     [reader](Options const& options) mutable {
                                       return reader->GetNext(options);
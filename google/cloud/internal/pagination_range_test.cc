@@ -18,7 +18,11 @@
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -26,8 +30,10 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace internal {
 namespace {
 
+using ::google::cloud::testing_util::IsOkAndHolds;
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::ElementsAre;
+using ::testing::Field;
 using ::testing::HasSubstr;
 
 struct StringOption {
@@ -377,6 +383,113 @@ TYPED_TEST(PaginationRangeTest, IteratorCoverage) {
   EXPECT_TRUE(i1 == range.end());
 }
 
+TYPED_TEST(PaginationRangeTest, Prefetch) {
+  using ResponseType = TypeParam;
+  MockRpcExplicit<ResponseType> mock;
+  auto make_loader = [](std::string expected_token, std::string token,
+                        std::vector<Item> items) {
+    return [=](Options const& options, Request const& request) {
+      EXPECT_EQ(options.get<StringOption>(), "Prefetch");
+      EXPECT_EQ(CurrentOptions().get<StringOption>(), "Prefetch");
+      EXPECT_EQ(expected_token, request.testonly_page_token);
+      ResponseType response;
+      response.testonly_set_page_token(token);
+      response.testonly_items = items;
+      return make_status_or(response);
+    };
+  };
+  EXPECT_CALL(mock, Loader)
+      .WillOnce(make_loader("", "t1", {Item{"p1"}, Item{"p2"}}))
+      .WillOnce(make_loader("t1", "t2", {}))
+      .WillOnce(make_loader("t2", "t3", {Item{"p3"}}))
+      .WillOnce(make_loader("t3", "", {Item{"p4"}}));
+
+  auto range = MakePaginationRange<ItemRange>(
+      MakeImmutableOptions(Options{}
+                               .set<StringOption>("Prefetch")
+                               .set<PaginationPrefetchDepthOption>(2)),
+      Request{},
+      [&mock](Options const& o, Request const& r) { return mock.Loader(o, r); },
+      [](ResponseType const& r) { return r.testonly_items; });
+  OptionsSpan overlay(Options{}.set<StringOption>("uh-oh"));
+  std::vector<std::string> names;
+  for (auto& p : range) {
+    if (!p) break;
+    names.push_back(p->data);
+  }
+  EXPECT_THAT(names, ElementsAre("p1", "p2", "p3", "p4"));
+}
+
+TYPED_TEST(PaginationRangeTest, PrefetchWithError) {
+  using ResponseType = TypeParam;
+  MockRpcExplicit<ResponseType> mock;
+  EXPECT_CALL(mock, Loader)
+      .WillOnce([](Options const&, Request const& request) {
+        EXPECT_TRUE(request.testonly_page_token.empty());
+        ResponseType response;
+        response.testonly_set_page_token("t1");
+        response.testonly_items.push_back(Item{"p1"});
+        return response;
+      })
+      .WillOnce([](Options const&, Request const& request) {
+        EXPECT_EQ("t1", request.testonly_page_token);
+        return Status(StatusCode::kAborted, "bad-luck");
+      });
+
+  auto range = MakePaginationRange<ItemRange>(
+      MakeImmutableOptions(Options{}.set<PaginationPrefetchDepthOption>(1)),
+      Request{},
+      [&mock](Options const& o, Request const& r) { return mock.Loader(o, r); },
+      [](ResponseType const& r) { return r.testonly_items; });
+  std::vector<StatusOr<std::string>> actual;
+  for (auto& p : range) {
+    if (!p) {
+      actual.emplace_back(std::move(p).status());
+      continue;
+    }
+    actual.emplace_back(p->data);
+  }
+  EXPECT_THAT(actual, ElementsAre(IsOkAndHolds("p1"),
+                                  StatusIs(StatusCode::kAborted)));
+}
+
+TYPED_TEST(PaginationRangeTest, PrefetchIsBounded) {
+  using ResponseType = TypeParam;
+  std::mutex mu;
+  std::condition_variable cv;
+  int calls = 0;
+  // An infinite sequence of pages, with one item each.
+  auto loader = [&](Options const&, Request const&) {
+    std::lock_guard<std::mutex> lk(mu);
+    ++calls;
+    cv.notify_all();
+    ResponseType response;
+    response.testonly_set_page_token("t" + std::to_string(calls));
+    response.testonly_items.push_back(Item{"p" + std::to_string(calls)});
+    return make_status_or(response);
+  };
+
+  {
+    auto range = MakePaginationRange<ItemRange>(
+        MakeImmutableOptions(Options{}.set<PaginationPrefetchDepthOption>(2)),
+        Request{}, loader,
+        [](ResponseType const& r) { return r.testonly_items; });
+    auto i = range.begin();
+    ASSERT_NE(i, range.end());
+    EXPECT_THAT(*i, IsOkAndHolds(Field(&Item::data, "p1")));
+
+    // The first page is consumed, the reader should prefetch the next two and
+    // then stop.
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return calls >= 3; });
+    cv.wait_for(lk, std::chrono::milliseconds(50), [&] { return calls > 3; });
+    EXPECT_EQ(calls, 3);
+  }
+  // Destroying the range stops the background thread.
+  std::lock_guard<std::mutex> lk(mu);
+  EXPECT_EQ(calls, 3);
+}
+
 TEST(RangeFromPagination, MakeUnimplemented) {
   using NonProtoRange = PaginationRange<std::string>;
   auto range = MakeUnimplementedPaginationRange<NonProtoRange>();
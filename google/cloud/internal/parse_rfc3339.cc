@@ -14,14 +14,120 @@
 
 #include "google/cloud/internal/parse_rfc3339.h"
 #include "google/cloud/internal/make_status.h"
-#include "absl/time/time.h"
+#include <cstdint>
 
 namespace google {
 namespace cloud {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace internal {
+namespace {
+
+// Returns the value of the two digits at @p p, or a negative value if they are
+// not both digits.
+int ParseTwoDigits(char const* p) {
+  auto const d0 = static_cast<unsigned char>(p[0] - '0');
+  auto const d1 = static_cast<unsigned char>(p[1] - '0');
+  if (d0 > 9 || d1 > 9) return -1;
+  return d0 * 10 + d1;
+}
+
+bool IsLeapYear(std::int64_t y) {
+  return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+}
+
+int DaysInMonth(std::int64_t y, int m) {
+  static int const kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return m == 2 && IsLeapYear(y) ? 29 : kDays[m - 1];
+}
+
+// Returns the number of days since 1970-01-01 for a date in the proleptic
+// Gregorian calendar.
+//
+// @see http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+std::int64_t DaysFromCivil(std::int64_t y, int m, int d) {
+  y -= m <= 2 ? 1 : 0;
+  auto const era = (y >= 0 ? y : y - 399) / 400;
+  auto const yoe = y - era * 400;
+  auto const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+}  // namespace
+
+absl::optional<absl::Time> ParseRfc3339Fast(absl::string_view timestamp) {
+  // The shortest input is `YYYY-MM-DDTHH:MM:SSZ`.
+  auto constexpr kMinSize = 20;
+  if (timestamp.size() < kMinSize) return absl::nullopt;
+  char const* p = timestamp.data();
+  char const* const end = p + timestamp.size();
+
+  auto const y_hi = ParseTwoDigits(p);
+  auto const y_lo = ParseTwoDigits(p + 2);
+  auto const month = ParseTwoDigits(p + 5);
+  auto const mday = ParseTwoDigits(p + 8);
+  auto const hour = ParseTwoDigits(p + 11);
+  auto const minute = ParseTwoDigits(p + 14);
+  auto const second = ParseTwoDigits(p + 17);
+  if ((y_hi | y_lo | month | mday | hour | minute | second) < 0) {
+    return absl::nullopt;
+  }
+  if (p[4] != '-' || p[7] != '-' || (p[10] != 'T' && p[10] != 't') ||
+      p[13] != ':' || p[16] != ':') {
+    return absl::nullopt;
+  }
+  std::int64_t const year = y_hi * 100 + y_lo;
+  // Leap seconds (second == 60) are rare enough to leave to the full parser.
+  if (month < 1 || month > 12 || mday < 1 ||
+      mday > DaysInMonth(year, month) || hour > 23 || minute > 59 ||
+      second > 59) {
+    return absl::nullopt;
+  }
+  p += 19;
+
+  std::int64_t nanos = 0;
+  if (*p == '.') {
+    ++p;
+    char const* const digits = p;
+    int count = 0;
+    for (; p != end; ++p) {
+      auto const d = static_cast<unsigned char>(*p - '0');
+      if (d > 9) break;
+      // Digits beyond nanoseconds are truncated, as `absl::ParseTime()` does.
+      if (count == 9) continue;
+      nanos = nanos * 10 + d;
+      ++count;
+    }
+    if (p == digits || p == end) return absl::nullopt;
+    for (; count != 9; ++count) nanos *= 10;
+  }
+
+  std::int64_t offset = 0;
+  if (*p == 'Z' || *p == 'z') {
+    ++p;
+  } else if (*p == '+' || *p == '-') {
+    // The offset is exactly `+HH:MM` or `-HH:MM`.
+    if (end - p != 6 || p[3] != ':') return absl::nullopt;
+    auto const oh = ParseTwoDigits(p + 1);
+    auto const om = ParseTwoDigits(p + 4);
+    if (oh < 0 || om < 0 || oh > 23 || om > 59) return absl::nullopt;
+    offset = (oh * 60 + om) * 60;
+    if (*p == '-') offset = -offset;
+    p += 6;
+  } else {
+    return absl::nullopt;
+  }
+  if (p != end) return absl::nullopt;
+
+  auto const seconds = DaysFromCivil(year, month, mday) * 86400 +
+                       (hour * 60 + minute) * 60 + second - offset;
+  return absl::FromUnixSeconds(seconds) + absl::Nanoseconds(nanos);
+}
+
 StatusOr<std::chrono::system_clock::time_point> ParseRfc3339(
     std::string const& timestamp) {
+  auto fast = ParseRfc3339Fast(timestamp);
+  if (fast) return absl::ToChronoTime(*fast);
   std::string err;
   absl::Time t;
   if (!absl::ParseTime(absl::RFC3339_full, timestamp, &t, &err)) {
@@ -17,6 +17,9 @@
 
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
 #include <chrono>
 #include <string>
 
@@ -41,6 +44,20 @@ namespace internal {
 StatusOr<std::chrono::system_clock::time_point> ParseRfc3339(
     std::string const& timestamp);
 
+/**
+ * Parses the common forms of RFC-3339 timestamps without allocating memory.
+ *
+ * This handles `YYYY-MM-DDTHH:MM:SS[.fffffffff](Z|+HH:MM|-HH:MM)`, with any
+ * number of fractional digits (truncated to nanoseconds) and lowercase `t` and
+ * `z` separators. This covers the timestamps produced by Google Cloud services.
+ *
+ * Returns `absl::nullopt` for any other input, including invalid timestamps
+ * and leap seconds. The caller must fall back to a full parser, such as
+ * `absl::ParseTime()`, which also produces a meaningful error message. For any
+ * input accepted by this function both parsers return the same value.
+ */
+absl::optional<absl::Time> ParseRfc3339Fast(absl::string_view timestamp);
+
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
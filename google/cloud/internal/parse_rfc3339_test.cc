@@ -14,8 +14,9 @@
 
 #include "google/cloud/internal/parse_rfc3339.h"
 #include "google/cloud/testing_util/status_matchers.h"
-#include <gtest/gtest.h>
+#include <gmock/gmock.h>
 #include <ctime>
+#include <random>
 
 namespace google {
 namespace cloud {
@@ -28,6 +29,7 @@ using ::std::chrono::duration_cast;
 using ::std::chrono::milliseconds;
 using ::std::chrono::nanoseconds;
 using ::std::chrono::seconds;
+using ::testing::Optional;
 
 TEST(ParseRfc3339Test, ParseEpoch) {
   auto timestamp = ParseRfc3339("1970-01-01T00:00:00Z").value();
@@ -260,6 +262,80 @@ TEST(ParseRfc3339Test, DetectOutOfRangeOffsetMinute) {
               StatusIs(StatusCode::kInvalidArgument));
 }
 
+TEST(ParseRfc3339Test, ParseLeapSecond) {
+  // These are not handled by the fast path, but are still valid.
+  EXPECT_EQ(ParseRfc3339Fast("2016-12-31T23:59:60Z"), absl::nullopt);
+  auto timestamp = ParseRfc3339("2016-12-31T23:59:60Z").value();
+  EXPECT_EQ(1483228800L,
+            duration_cast<seconds>(timestamp.time_since_epoch()).count());
+}
+
+TEST(ParseRfc3339Test, FastPath) {
+  EXPECT_THAT(ParseRfc3339Fast("1970-01-01T00:00:00Z"),
+              Optional(absl::UnixEpoch()));
+  EXPECT_THAT(ParseRfc3339Fast("2018-05-18T14:42:03.123456789Z"),
+              Optional(absl::FromUnixSeconds(1526654523L) +
+                       absl::Nanoseconds(123456789)));
+  EXPECT_THAT(ParseRfc3339Fast("2018-05-18t14:42:03.5-01:05"),
+              Optional(absl::FromUnixSeconds(1526658423L) +
+                       absl::Milliseconds(500)));
+  EXPECT_THAT(ParseRfc3339Fast("1969-12-31T23:59:59.999999999z"),
+              Optional(absl::UnixEpoch() - absl::Nanoseconds(1)));
+  EXPECT_THAT(ParseRfc3339Fast("0001-01-01T00:00:00Z"),
+              Optional(absl::FromUnixSeconds(-62135596800L)));
+  EXPECT_THAT(ParseRfc3339Fast("9999-12-31T23:59:59.999999999Z"),
+              Optional(absl::FromUnixSeconds(253402300799L) +
+                       absl::Nanoseconds(999999999)));
+}
+
+TEST(ParseRfc3339Test, FastPathRejects) {
+  for (auto const* input : {
+           "",
+           "2018-05-18T14:42:03",
+           "2018-05-18T14:42:03.Z",
+           "2018-05-18T14:42:03.123",
+           "2018-05-18T14:42:03ZZ",
+           "2018-05-18T14:42:03+08:00Z",
+           "2018-05-18T14:42:03+0800",
+           "2018-05-18 14:42:03Z",
+           "2018-00-18T14:42:03Z",
+           "2018-05-00T14:42:03Z",
+           "2100-02-29T14:42:03Z",
+           "+2018-05-18T14:42:03Z",
+           "20180-05-18T14:42:03Z",
+           "2018-05-18T14:42:03+24:00",
+       }) {
+    EXPECT_EQ(ParseRfc3339Fast(input), absl::nullopt) << "input=" << input;
+  }
+  EXPECT_THAT(ParseRfc3339Fast("2000-02-29T14:42:03Z"),
+              Optional(absl::FromUnixSeconds(951835323L)));
+}
+
+TEST(ParseRfc3339Test, FastPathMatchesParseTime) {
+  auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*S%Ez";
+  auto generator = std::mt19937_64(std::random_device{}());
+  // Cover the full range of 4-digit years, with a bias towards the current
+  // decades. Stay a day away from the limits, so any UTC offset still results
+  // in a 4-digit year.
+  auto seconds = std::uniform_int_distribution<std::int64_t>(
+      -62135596800L + 86400, 253402300799L - 86400);
+  auto recent = std::uniform_int_distribution<std::int64_t>(0, 4102444800L);
+  auto nanos = std::uniform_int_distribution<std::int64_t>(0, 999999999);
+  auto offset = std::uniform_int_distribution<int>(-1439, 1439);
+  for (int i = 0; i != 10000; ++i) {
+    auto const s = i % 2 == 0 ? seconds(generator) : recent(generator);
+    auto const t =
+        absl::FromUnixSeconds(s) + absl::Nanoseconds(nanos(generator));
+    auto const tz = i % 3 == 0 ? absl::UTCTimeZone()
+                               : absl::FixedTimeZone(offset(generator) * 60);
+    auto const input = absl::FormatTime(kFormat, t, tz);
+    absl::Time expected;
+    ASSERT_TRUE(absl::ParseTime(absl::RFC3339_full, input, &expected, nullptr));
+    EXPECT_THAT(ParseRfc3339Fast(input), Optional(expected))
+        << "input=" << input;
+  }
+}
+
 }  // namespace
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
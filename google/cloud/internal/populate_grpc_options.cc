@@ -15,6 +15,7 @@
 #include "google/cloud/internal/populate_grpc_options.h"
 #include "google/cloud/credentials.h"
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/internal/populate_common_options.h"
 
 namespace google {
@@ -25,7 +26,8 @@ namespace internal {
 Options PopulateGrpcOptions(Options opts) {
   if (!opts.has<GrpcCredentialOption>() &&
       !opts.has<UnifiedCredentialsOption>()) {
-    opts.set<UnifiedCredentialsOption>(MakeGoogleDefaultCredentials());
+    opts.set<UnifiedCredentialsOption>(
+        SharedGoogleDefaultCredentials(Options{}));
   }
   if (!opts.has<GrpcTracingOptionsOption>()) {
     opts.set<GrpcTracingOptionsOption>(DefaultTracingOptions());
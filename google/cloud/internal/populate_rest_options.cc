@@ -15,6 +15,7 @@
 #include "google/cloud/internal/populate_rest_options.h"
 #include "google/cloud/credentials.h"
 #include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/internal/populate_common_options.h"
 #include "google/cloud/internal/rest_options.h"
 #include "google/cloud/rest_options.h"
@@ -28,8 +29,7 @@ namespace internal {
 
 Options PopulateRestOptions(Options opts) {
   if (!opts.has<UnifiedCredentialsOption>()) {
-    opts.set<UnifiedCredentialsOption>(
-        MakeGoogleDefaultCredentials(internal::MakeAuthOptions(opts)));
+    opts.set<UnifiedCredentialsOption>(SharedGoogleDefaultCredentials(opts));
   }
   if (!opts.has<rest_internal::LongrunningEndpointOption>()) {
     opts.set<rest_internal::LongrunningEndpointOption>(
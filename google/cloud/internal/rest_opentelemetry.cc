@@ -22,6 +22,7 @@
 #include "absl/strings/match.h"
 #include <opentelemetry/context/propagation/global_propagator.h>
 #include <opentelemetry/context/propagation/text_map_propagator.h>
+#include <opentelemetry/trace/context.h>
 #include <opentelemetry/trace/provider.h>
 #include <opentelemetry/trace/semantic_conventions.h>
 #include <opentelemetry/trace/span_metadata.h>
@@ -65,6 +66,8 @@ void InjectTraceContext(
     RestContext& context,
     opentelemetry::context::propagation::TextMapPropagator& propagator) {
   auto current = opentelemetry::context::RuntimeContext::GetCurrent();
+  // There is no trace to join if the sampler dropped the span.
+  if (!opentelemetry::trace::GetSpan(current)->IsRecording()) return;
   RestClientCarrier carrier(context);
   propagator.Inject(carrier, current);
 }
@@ -81,6 +84,7 @@ opentelemetry::nostd::shared_ptr<opentelemetry::trace::Span> MakeSpanHttp(
        {/*sc::kHttpRequestMethod=*/"http.request.method", method},
        {/*sc::kUrlFull=*/"url.full", request.path()}},
       options);
+  if (!span->IsRecording()) return span;
   for (auto const& kv : request.headers()) {
     auto const name = "http.request.header." + kv.first;
     if (kv.second.empty()) {
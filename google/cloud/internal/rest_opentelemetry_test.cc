@@ -36,6 +36,7 @@ using ::testing::AllOf;
 using ::testing::Contains;
 using ::testing::ElementsAre;
 using ::testing::Gt;
+using ::testing::IsEmpty;
 using ::testing::Pair;
 
 TEST(RestOpentelemetry, MakeSpanHttp) {
@@ -96,6 +97,23 @@ TEST(RestOpentelemetry, InjectTraceContext) {
                     Contains(Pair("traceparent", _))));
 }
 
+TEST(RestOpentelemetry, InjectTraceContextNotRecording) {
+  // Without a span catcher the spans are not recording, as if dropped by the
+  // sampler.
+  auto constexpr kUrl = "https://storage.googleapis.com/storage/v1/b/my-bucket";
+  RestRequest request(kUrl, RestRequest::HttpHeaders{{"empty", {}}});
+
+  auto span = MakeSpanHttp(request, "GET");
+  ASSERT_FALSE(span->IsRecording());
+  auto scope = opentelemetry::trace::Scope(span);
+  RestContext context;
+  auto propagator = internal::MakePropagator();
+  InjectTraceContext(context, *propagator);
+
+  span->End();
+  EXPECT_THAT(context.headers(), IsEmpty());
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace rest_internal
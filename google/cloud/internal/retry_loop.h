@@ -18,6 +18,7 @@
 #include "google/cloud/backoff_policy.h"
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/idempotency.h"
+#include "google/cloud/internal/grpc_rpc_metrics.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/internal/opentelemetry.h"
@@ -73,18 +74,28 @@ auto RetryLoopImpl(RetryPolicy& retry_policy, BackoffPolicy& backoff_policy,
         Functor, grpc::ClientContext&, Options const&, Request const&> {
   auto const enable_server_retries = options.get<EnableServerRetriesOption>();
   auto last_status = Status{};
+  RpcMetricsOperation metrics(options, location);
   while (!retry_policy.IsExhausted()) {
     // Need to create a new context for each retry.
     grpc::ClientContext context;
     ConfigureContext(context, options);
+    metrics.OnAttemptStart();
     auto result = functor(context, options, request);
-    if (result.ok()) return result;
+    metrics.OnAttemptEnd(context, GetResultCode(result));
+    if (result.ok()) {
+      metrics.OnOperationEnd(StatusCode::kOk);
+      return result;
+    }
     last_status = GetResultStatus(std::move(result));
     auto delay = Backoff(last_status, location, retry_policy, backoff_policy,
                          idempotency, enable_server_retries);
-    if (!delay) return std::move(delay).status();
+    if (!delay) {
+      metrics.OnOperationEnd(delay.status().code());
+      return std::move(delay).status();
+    }
     sleeper(*delay);
   }
+  metrics.OnOperationEnd(last_status.code());
   return internal::RetryLoopError(last_status, location,
                                   retry_policy.IsExhausted());
 }
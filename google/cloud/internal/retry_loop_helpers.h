@@ -36,6 +36,15 @@ Status GetResultStatus(StatusOr<T> result) {
   return std::move(result).status();
 }
 
+/// Like `GetResultStatus()`, but avoids copying the result.
+inline StatusCode GetResultCode(Status const& status) { return status.code(); }
+
+/// @copydoc GetResultCode(Status const&)
+template <typename T>
+StatusCode GetResultCode(StatusOr<T> const& result) {
+  return result.status().code();
+}
+
 /// Use this if the retry loop detects any error on a non-idempotent RPC.
 Status RetryLoopNonIdempotentError(Status status, char const* location);
 
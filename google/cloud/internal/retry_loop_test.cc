@@ -16,6 +16,8 @@
 #include "google/cloud/idempotency.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/internal/retry_policy_impl.h"
+#include "google/cloud/internal/rpc_metrics.h"
+#include "google/cloud/opentelemetry_options.h"
 #include "google/cloud/options.h"
 #include "google/cloud/testing_util/mock_backoff_policy.h"
 #include "google/cloud/testing_util/opentelemetry_matchers.h"
@@ -33,6 +35,7 @@ using ::google::cloud::testing_util::MockBackoffPolicy;
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::Contains;
 using ::testing::ElementsAre;
+using ::testing::Field;
 using ::testing::HasSubstr;
 using ::testing::MockFunction;
 using ::testing::Pair;
@@ -276,6 +279,55 @@ TEST(RetryLoopTest, ConfigureContext) {
       /*request=*/0, "error message");
 }
 
+TEST(RetryLoopTest, RecordsRpcMetrics) {
+  auto metrics = std::make_shared<RpcMetrics>("test-service");
+  int counter = 0;
+  StatusOr<int> actual = RetryLoop(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      [&counter](grpc::ClientContext&, Options const&, int request) {
+        if (++counter < 3) {
+          return StatusOr<int>(Status(StatusCode::kUnavailable, "try again"));
+        }
+        return StatusOr<int>(2 * request);
+      },
+      Options{}.set<experimental::RpcMetricsOption>(
+          MakeRpcMetricsHandle(metrics)),
+      42, "TestMethod");
+  EXPECT_THAT(actual, IsOkAndHolds(84));
+
+  auto points = metrics->Collect();
+  ASSERT_THAT(points,
+              ElementsAre(Field(&RpcMetricsPoint::code, StatusCode::kOk),
+                          Field(&RpcMetricsPoint::code,
+                                StatusCode::kUnavailable)));
+  EXPECT_EQ(points[0].method, "TestMethod");
+  EXPECT_EQ(points[0].attempt_latency.count, 1);
+  EXPECT_EQ(points[0].operation_latency.count, 1);
+  EXPECT_EQ(points[0].attempt_count.sum, 3.0);
+  EXPECT_EQ(points[1].attempt_latency.count, 2);
+  EXPECT_EQ(points[1].operation_latency.count, 0);
+}
+
+TEST(RetryLoopTest, RecordsRpcMetricsOnPermanentFailure) {
+  auto metrics = std::make_shared<RpcMetrics>("test-service");
+  StatusOr<int> actual = RetryLoop(
+      TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kIdempotent,
+      [](grpc::ClientContext&, Options const&, int) {
+        return StatusOr<int>(Status(StatusCode::kPermissionDenied, "uh-oh"));
+      },
+      Options{}.set<experimental::RpcMetricsOption>(
+          MakeRpcMetricsHandle(metrics)),
+      42, "TestMethod");
+  EXPECT_THAT(actual, StatusIs(StatusCode::kPermissionDenied));
+
+  auto points = metrics->Collect();
+  ASSERT_THAT(points, ElementsAre(Field(&RpcMetricsPoint::code,
+                                        StatusCode::kPermissionDenied)));
+  EXPECT_EQ(points[0].attempt_latency.count, 1);
+  EXPECT_EQ(points[0].operation_latency.count, 1);
+  EXPECT_EQ(points[0].attempt_count.sum, 1.0);
+}
+
 #ifdef GOOGLE_CLOUD_CPP_HAVE_OPENTELEMETRY
 using ::google::cloud::testing_util::DisableTracing;
 using ::google::cloud::testing_util::EnableTracing;
@@ -0,0 +1,139 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/parse_rfc3339.h"
+#include "absl/time/time.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+// Run on (1 X 2100 MHz CPU )
+// CPU Caches:
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// Load Average: 0.27, 0.53, 0.57
+// -----------------------------------------------------------------
+// Benchmark                       Time             CPU   Iterations
+// -----------------------------------------------------------------
+// BM_ParseRfc3339              51.8 ns         51.8 ns     13535525
+// BM_AbslParseTime              202 ns          201 ns      3502064
+// BM_FormatRfc3339Buffer       34.5 ns         34.3 ns     20527810
+// BM_FormatRfc3339String       44.3 ns         44.1 ns     15878662
+// BM_AbslFormatTime             228 ns          227 ns      3092704
+//
+// Each iteration parses or formats a single timestamp, so the times are
+// nanoseconds per timestamp.
+
+auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
+auto constexpr kTimestamps = 1024;
+
+std::vector<std::chrono::system_clock::time_point> RandomTimePoints() {
+  std::mt19937_64 gen(42);
+  // Timestamps between 2000-01-01 and 2100-01-01, with nanosecond precision,
+  // like those in Spanner TIMESTAMP columns.
+  std::uniform_int_distribution<std::int64_t> seconds(946684800L, 4102444800L);
+  std::uniform_int_distribution<std::int64_t> nanos(0, 999999999);
+  std::vector<std::chrono::system_clock::time_point> result(kTimestamps);
+  for (auto& tp : result) {
+    tp = absl::ToChronoTime(absl::FromUnixSeconds(seconds(gen)) +
+                            absl::Nanoseconds(nanos(gen)));
+  }
+  return result;
+}
+
+std::vector<std::string> RandomTimestamps() {
+  std::vector<std::string> result;
+  for (auto tp : RandomTimePoints()) {
+    result.push_back(
+        absl::FormatTime(kFormat, absl::FromChrono(tp), absl::UTCTimeZone()));
+  }
+  return result;
+}
+
+void BM_ParseRfc3339(benchmark::State& state) {
+  auto const inputs = RandomTimestamps();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParseRfc3339(inputs[i]));
+    i = (i + 1) % inputs.size();
+  }
+}
+BENCHMARK(BM_ParseRfc3339);
+
+void BM_AbslParseTime(benchmark::State& state) {
+  auto const inputs = RandomTimestamps();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    absl::Time t;
+    std::string err;
+    benchmark::DoNotOptimize(
+        absl::ParseTime(absl::RFC3339_full, inputs[i], &t, &err));
+    benchmark::DoNotOptimize(t);
+    i = (i + 1) % inputs.size();
+  }
+}
+BENCHMARK(BM_AbslParseTime);
+
+void BM_FormatRfc3339Buffer(benchmark::State& state) {
+  auto const inputs = RandomTimePoints();
+  char buffer[kFormatRfc3339BufferSize];
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FormatRfc3339(inputs[i], buffer));
+    benchmark::ClobberMemory();
+    i = (i + 1) % inputs.size();
+  }
+}
+BENCHMARK(BM_FormatRfc3339Buffer);
+
+void BM_FormatRfc3339String(benchmark::State& state) {
+  auto const inputs = RandomTimePoints();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FormatRfc3339(inputs[i]));
+    i = (i + 1) % inputs.size();
+  }
+}
+BENCHMARK(BM_FormatRfc3339String);
+
+void BM_AbslFormatTime(benchmark::State& state) {
+  auto const inputs = RandomTimePoints();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::FormatTime(
+        kFormat, absl::FromChrono(inputs[i]), absl::UTCTimeZone()));
+    i = (i + 1) % inputs.size();
+  }
+}
+BENCHMARK(BM_AbslFormatTime);
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,268 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/rpc_metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using dseconds = std::chrono::duration<double, std::ratio<1>>;
+
+// Cloud Monitoring supports up to 200 buckets per histogram. Use 2ms buckets
+// for the first 100ms, where most RPCs complete, and then grow the buckets
+// exponentially, up to 5 minutes.
+std::vector<double> MakeLatencyBoundaries() {
+  std::vector<double> boundaries;
+  auto boundary = std::chrono::milliseconds(0);
+  auto increment = std::chrono::milliseconds(2);
+  for (int i = 0; i != 50; ++i) {
+    boundaries.push_back(
+        std::chrono::duration_cast<dseconds>(boundary).count());
+    boundary += increment;
+  }
+  increment = std::chrono::milliseconds(10);
+  for (int i = 0; i != 150 && boundary <= std::chrono::minutes(5); ++i) {
+    boundaries.push_back(
+        std::chrono::duration_cast<dseconds>(boundary).count());
+    if (i != 0 && i % 10 == 0) increment *= 2;
+    boundary += increment;
+  }
+  return boundaries;
+}
+
+std::vector<double> const& LatencyBoundaries() {
+  static auto const* const kBoundaries =
+      new std::vector<double>(MakeLatencyBoundaries());
+  return *kBoundaries;
+}
+
+std::vector<double> const& AttemptCountBoundaries() {
+  static auto const* const kBoundaries = new std::vector<double>{
+      1, 2, 3, 4, 5, 6, 8, 10, 15, 20, 30, 50, 100};
+  return *kBoundaries;
+}
+
+/**
+ * A histogram with a single writer, and any number of readers.
+ *
+ * With a single writer, the counters can be updated using plain loads and
+ * stores, avoiding the cost of atomic read-modify-write operations.
+ */
+class Histogram {
+ public:
+  explicit Histogram(std::vector<double> const& boundaries)
+      : boundaries_(boundaries), counts_(boundaries.size() + 1) {}
+
+  void Record(double value) {
+    auto const i = std::distance(
+        boundaries_.begin(),
+        std::lower_bound(boundaries_.begin(), boundaries_.end(), value));
+    auto& counter = counts_[static_cast<std::size_t>(i)];
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value,
+               std::memory_order_relaxed);
+  }
+
+  void MergeInto(RpcMetricsHistogramData& data) const {
+    if (data.counts.empty()) {
+      data.boundaries = boundaries_;
+      data.counts.assign(counts_.size(), 0);
+    }
+    for (std::size_t i = 0; i != counts_.size(); ++i) {
+      auto const c = counts_[i].load(std::memory_order_relaxed);
+      data.counts[i] += c;
+      data.count += c;
+    }
+    data.sum += sum_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::vector<double> const& boundaries_;
+  std::vector<std::atomic<std::uint64_t>> counts_;
+  std::atomic<double> sum_{0};
+};
+
+using Key = std::pair<std::string, StatusCode>;
+using KeyView = std::pair<absl::string_view, StatusCode>;
+
+// Allows lookups with `KeyView`, avoiding a copy of the method name.
+struct KeyLess {
+  using is_transparent = void;
+
+  template <typename A, typename B>
+  bool operator()(A const& a, B const& b) const {
+    return std::forward_as_tuple(absl::string_view(a.first), a.second) <
+           std::forward_as_tuple(absl::string_view(b.first), b.second);
+  }
+};
+
+std::uint64_t NextId() {
+  static std::atomic<std::uint64_t> id{0};
+  return ++id;
+}
+
+}  // namespace
+
+struct RpcMetrics::MethodMetrics {
+  Histogram attempt_latency{LatencyBoundaries()};
+  Histogram server_latency{LatencyBoundaries()};
+  Histogram operation_latency{LatencyBoundaries()};
+  Histogram attempt_count{AttemptCountBoundaries()};
+};
+
+struct RpcMetrics::Shard {
+  void MergeInto(std::map<Key, RpcMetricsPoint>& points) const {
+    for (auto const& kv : methods) {
+      auto& p = points[kv.first];
+      p.method = kv.first.first;
+      p.code = kv.first.second;
+      kv.second.attempt_latency.MergeInto(p.attempt_latency);
+      kv.second.server_latency.MergeInto(p.server_latency);
+      kv.second.operation_latency.MergeInto(p.operation_latency);
+      kv.second.attempt_count.MergeInto(p.attempt_count);
+    }
+  }
+
+  // The thread owning the shard is the only writer. It inserts new keys with
+  // `mu` held, and looks up keys without it. `Collect()` holds `mu` while
+  // reading the map.
+  std::mutex mu;
+  std::map<Key, MethodMetrics, KeyLess> methods;
+};
+
+struct RpcMetrics::Shards {
+  // Called by the thread owning `shard` when it exits, so there are no
+  // concurrent writers.
+  void Retire(Shard const* shard) {
+    std::lock_guard<std::mutex> lk(mu);
+    shard->MergeInto(retired);
+    auto i = std::find_if(
+        live.begin(), live.end(),
+        [shard](std::unique_ptr<Shard> const& s) { return s.get() == shard; });
+    if (i == live.end()) return;
+    std::swap(*i, live.back());
+    live.pop_back();
+  }
+
+  std::mutex mu;
+  std::vector<std::unique_ptr<Shard>> live;  // GUARDED_BY(mu)
+  std::map<Key, RpcMetricsPoint> retired;    // GUARDED_BY(mu)
+};
+
+RpcMetrics::RpcMetrics(std::string service)
+    : service_(std::move(service)),
+      start_time_(std::chrono::system_clock::now()),
+      id_(NextId()),
+      shards_(std::make_shared<Shards>()) {}
+
+void RpcMetrics::RecordAttempt(absl::string_view method, StatusCode code,
+                               std::chrono::nanoseconds latency) {
+  Lookup(method, code).attempt_latency.Record(
+      std::chrono::duration_cast<dseconds>(latency).count());
+}
+
+void RpcMetrics::RecordServerLatency(absl::string_view method, StatusCode code,
+                                     std::chrono::nanoseconds latency) {
+  Lookup(method, code).server_latency.Record(
+      std::chrono::duration_cast<dseconds>(latency).count());
+}
+
+void RpcMetrics::RecordOperation(absl::string_view method, StatusCode code,
+                                 std::chrono::nanoseconds latency,
+                                 int attempts) {
+  auto& m = Lookup(method, code);
+  m.operation_latency.Record(
+      std::chrono::duration_cast<dseconds>(latency).count());
+  m.attempt_count.Record(static_cast<double>(attempts));
+}
+
+std::vector<RpcMetricsPoint> RpcMetrics::Collect() const {
+  // Holding the lock while merging the live shards ensures a shard retired
+  // concurrently is counted exactly once.
+  std::unique_lock<std::mutex> lk(shards_->mu);
+  auto points = shards_->retired;
+  for (auto const& shard : shards_->live) {
+    std::lock_guard<std::mutex> shard_lk(shard->mu);
+    shard->MergeInto(points);
+  }
+  lk.unlock();
+
+  std::vector<RpcMetricsPoint> result;
+  result.reserve(points.size());
+  for (auto& kv : points) result.push_back(std::move(kv.second));
+  return result;
+}
+
+RpcMetrics::MethodMetrics& RpcMetrics::Lookup(absl::string_view method,
+                                              StatusCode code) {
+  // Each thread caches its shard for each `RpcMetrics` object. Only `shards_`
+  // owns the shards, so the cache entries expire when the `RpcMetrics` object
+  // is destroyed, and are pruned when a thread adds a new entry. While `this`
+  // is alive its shard is alive too, so the raw pointer is safe to use. When
+  // the thread exits its shards are merged into the retired metrics.
+  struct CachedShard {
+    std::weak_ptr<Shards> owner;
+    Shard* shard;
+  };
+  struct ThreadShards {
+    ~ThreadShards() {
+      for (auto& kv : cache) {
+        if (auto owner = kv.second.owner.lock()) owner->Retire(kv.second.shard);
+      }
+    }
+    std::unordered_map<std::uint64_t, CachedShard> cache;
+  };
+  thread_local ThreadShards thread_shards;
+  auto& cache = thread_shards.cache;
+  auto c = cache.find(id_);
+  if (c == cache.end()) {
+    for (auto j = cache.begin(); j != cache.end();) {
+      j = j->second.owner.expired() ? cache.erase(j) : std::next(j);
+    }
+    auto s = std::make_unique<Shard>();
+    auto* shard = s.get();
+    {
+      std::lock_guard<std::mutex> lk(shards_->mu);
+      shards_->live.push_back(std::move(s));
+    }
+    c = cache.emplace(id_, CachedShard{shards_, shard}).first;
+  }
+  auto* shard = c->second.shard;
+  auto i = shard->methods.find(KeyView(method, code));
+  if (i != shard->methods.end()) return i->second;
+  std::lock_guard<std::mutex> lk(shard->mu);
+  return shard->methods
+      .emplace(std::piecewise_construct,
+               std::forward_as_tuple(std::string(method), code),
+               std::forward_as_tuple())
+      .first->second;
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,118 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RPC_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RPC_METRICS_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include "absl/strings/string_view.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/// The aggregated value of a histogram, using explicit bucket boundaries.
+struct RpcMetricsHistogramData {
+  /// Bucket `i` counts the values in `(boundaries[i - 1], boundaries[i]]`.
+  std::vector<double> boundaries;
+  /// Has `boundaries.size() + 1` elements, the last bucket is unbounded.
+  std::vector<std::uint64_t> counts;
+  double sum = 0;
+  std::uint64_t count = 0;
+};
+
+/// The metrics for one RPC and status code.
+struct RpcMetricsPoint {
+  std::string method;
+  StatusCode code = StatusCode::kOk;
+  /// The latency of each attempt, in seconds.
+  RpcMetricsHistogramData attempt_latency;
+  /// The server-side latency of each attempt (if reported), in seconds.
+  RpcMetricsHistogramData server_latency;
+  /// The latency of each operation, including retries and backoff, in seconds.
+  RpcMetricsHistogramData operation_latency;
+  /// The number of attempts in each operation.
+  RpcMetricsHistogramData attempt_count;
+};
+
+/**
+ * Records client-side RPC metrics with low overhead.
+ *
+ * The retry loops call the `Record*()` functions for every RPC, so they must
+ * be cheap. Each thread records into its own shard, where the histogram
+ * buckets are atomic counters with a single writer. Recording a value takes
+ * no locks, other than the first time a thread records a value for a given
+ * method and status code. When a thread exits its shard is merged into an
+ * aggregate of the retired shards, so short-lived threads do not accumulate
+ * shards. `Collect()` aggregates the shards, and may run concurrently with any
+ * `Record*()` calls.
+ *
+ * The histograms are cumulative since `start_time()`.
+ *
+ * Applications enable the metrics with `experimental::RpcMetricsOption`. The
+ * same object can be shared by multiple clients, but the metrics are not
+ * labeled by client.
+ */
+class RpcMetrics {
+ public:
+  explicit RpcMetrics(std::string service);
+
+  RpcMetrics(RpcMetrics const&) = delete;
+  RpcMetrics& operator=(RpcMetrics const&) = delete;
+
+  /// The service name, used to label the metrics.
+  std::string const& service() const { return service_; }
+
+  /// The time when the metrics started accumulating.
+  std::chrono::system_clock::time_point start_time() const {
+    return start_time_;
+  }
+
+  void RecordAttempt(absl::string_view method, StatusCode code,
+                     std::chrono::nanoseconds latency);
+  void RecordServerLatency(absl::string_view method, StatusCode code,
+                           std::chrono::nanoseconds latency);
+  void RecordOperation(absl::string_view method, StatusCode code,
+                       std::chrono::nanoseconds latency, int attempts);
+
+  /// Aggregates the metrics for all the threads, sorted by method and code.
+  std::vector<RpcMetricsPoint> Collect() const;
+
+ private:
+  struct Shard;
+  struct MethodMetrics;
+  struct Shards;
+
+  MethodMetrics& Lookup(absl::string_view method, StatusCode code);
+
+  std::string service_;
+  std::chrono::system_clock::time_point start_time_;
+  std::uint64_t id_;
+  // The recording threads hold a `weak_ptr` to retire their shards on exit.
+  std::shared_ptr<Shards> shards_;
+};
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RPC_METRICS_H
@@ -0,0 +1,195 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/rpc_metrics.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::testing::DoubleEq;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+TEST(RpcMetrics, Empty) {
+  RpcMetrics metrics("test-service");
+  EXPECT_EQ(metrics.service(), "test-service");
+  EXPECT_LE(metrics.start_time(), std::chrono::system_clock::now());
+  EXPECT_THAT(metrics.Collect(), IsEmpty());
+}
+
+TEST(RpcMetrics, RecordAndCollect) {
+  RpcMetrics metrics("test-service");
+  metrics.RecordAttempt("B", StatusCode::kUnavailable,
+                        std::chrono::milliseconds(3));
+  metrics.RecordAttempt("B", StatusCode::kOk, std::chrono::milliseconds(5));
+  metrics.RecordServerLatency("B", StatusCode::kOk,
+                              std::chrono::milliseconds(2));
+  metrics.RecordOperation("B", StatusCode::kOk, std::chrono::milliseconds(20),
+                          2);
+  metrics.RecordAttempt("A", StatusCode::kOk, std::chrono::milliseconds(1));
+
+  auto points = metrics.Collect();
+  ASSERT_THAT(points, ElementsAre(Field(&RpcMetricsPoint::method, "A"),
+                                  Field(&RpcMetricsPoint::method, "B"),
+                                  Field(&RpcMetricsPoint::method, "B")));
+  EXPECT_EQ(points[0].code, StatusCode::kOk);
+  EXPECT_EQ(points[1].code, StatusCode::kOk);
+  EXPECT_EQ(points[2].code, StatusCode::kUnavailable);
+
+  auto const& ok = points[1];
+  EXPECT_EQ(ok.attempt_latency.count, 1);
+  EXPECT_THAT(ok.attempt_latency.sum, DoubleEq(0.005));
+  EXPECT_EQ(ok.server_latency.count, 1);
+  EXPECT_THAT(ok.server_latency.sum, DoubleEq(0.002));
+  EXPECT_EQ(ok.operation_latency.count, 1);
+  EXPECT_THAT(ok.operation_latency.sum, DoubleEq(0.020));
+  EXPECT_EQ(ok.attempt_count.count, 1);
+  EXPECT_THAT(ok.attempt_count.sum, DoubleEq(2.0));
+
+  auto const& unavailable = points[2];
+  EXPECT_EQ(unavailable.attempt_latency.count, 1);
+  EXPECT_EQ(unavailable.operation_latency.count, 0);
+}
+
+TEST(RpcMetrics, Buckets) {
+  RpcMetrics metrics("test-service");
+  // The boundaries are inclusive, 4ms is in the (2ms, 4ms] bucket.
+  metrics.RecordAttempt("A", StatusCode::kOk, std::chrono::milliseconds(0));
+  metrics.RecordAttempt("A", StatusCode::kOk, std::chrono::milliseconds(3));
+  metrics.RecordAttempt("A", StatusCode::kOk, std::chrono::milliseconds(4));
+  metrics.RecordAttempt("A", StatusCode::kOk, std::chrono::hours(1));
+
+  auto points = metrics.Collect();
+  ASSERT_THAT(points, SizeIs(1));
+  auto const& h = points[0].attempt_latency;
+  ASSERT_THAT(h.counts, SizeIs(h.boundaries.size() + 1));
+  ASSERT_GE(h.boundaries.size(), 3);
+  EXPECT_THAT(h.boundaries[0], DoubleEq(0.0));
+  EXPECT_THAT(h.boundaries[1], DoubleEq(0.002));
+  EXPECT_THAT(h.boundaries[2], DoubleEq(0.004));
+  EXPECT_EQ(h.counts[0], 1);
+  EXPECT_EQ(h.counts[1], 0);
+  EXPECT_EQ(h.counts[2], 2);
+  EXPECT_EQ(h.counts.back(), 1);
+  EXPECT_EQ(h.count, 4);
+  EXPECT_LE(h.boundaries.size(), 200);
+}
+
+TEST(RpcMetrics, MultipleThreads) {
+  auto constexpr kThreads = 4;
+  auto constexpr kIterations = 1000;
+  RpcMetrics metrics("test-service");
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&metrics] {
+      for (int i = 0; i != kIterations; ++i) {
+        metrics.RecordAttempt("A", StatusCode::kOk,
+                              std::chrono::milliseconds(1));
+        metrics.RecordOperation("A", StatusCode::kOk,
+                                std::chrono::milliseconds(1), 1);
+      }
+    });
+  }
+  // Collecting while the threads record values is safe.
+  for (int i = 0; i != 10; ++i) {
+    for (auto const& p : metrics.Collect()) {
+      EXPECT_LE(p.attempt_latency.count, kThreads * kIterations);
+    }
+  }
+  for (auto& t : threads) t.join();
+
+  auto points = metrics.Collect();
+  ASSERT_THAT(points, SizeIs(1));
+  EXPECT_EQ(points[0].attempt_latency.count, kThreads * kIterations);
+  EXPECT_EQ(points[0].operation_latency.count, kThreads * kIterations);
+  EXPECT_THAT(points[0].attempt_count.sum,
+              DoubleEq(static_cast<double>(kThreads * kIterations)));
+}
+
+TEST(RpcMetrics, ShortLivedThreads) {
+  // Each thread exits before the next one starts. Their shards are retired,
+  // and their values are still reported.
+  auto constexpr kThreads = 100;
+  RpcMetrics metrics("test-service");
+  for (int t = 0; t != kThreads; ++t) {
+    std::thread([&metrics] {
+      metrics.RecordAttempt("A", StatusCode::kOk, std::chrono::milliseconds(1));
+      metrics.RecordAttempt("B", StatusCode::kOk, std::chrono::milliseconds(1));
+    }).join();
+    if (t % 10 != 0) continue;
+    EXPECT_THAT(metrics.Collect(), SizeIs(2));
+  }
+
+  auto points = metrics.Collect();
+  ASSERT_THAT(points, SizeIs(2));
+  EXPECT_EQ(points[0].method, "A");
+  EXPECT_EQ(points[0].attempt_latency.count, kThreads);
+  EXPECT_EQ(points[1].method, "B");
+  EXPECT_EQ(points[1].attempt_latency.count, kThreads);
+}
+
+TEST(RpcMetrics, ThreadOutlivesObject) {
+  // The thread exits after the object is destroyed, there is nothing to
+  // retire the shard into.
+  auto metrics = std::make_unique<RpcMetrics>("test-service");
+  std::promise<void> recorded;
+  std::promise<void> destroyed;
+  std::thread t([&] {
+    metrics->RecordAttempt("A", StatusCode::kOk, std::chrono::milliseconds(1));
+    recorded.set_value();
+    destroyed.get_future().wait();
+  });
+  recorded.get_future().wait();
+  EXPECT_THAT(metrics->Collect(), SizeIs(1));
+  metrics.reset();
+  destroyed.set_value();
+  t.join();
+}
+
+TEST(RpcMetrics, IndependentObjects) {
+  RpcMetrics m1("s1");
+  RpcMetrics m2("s2");
+  m1.RecordAttempt("A", StatusCode::kOk, std::chrono::milliseconds(1));
+  EXPECT_THAT(m1.Collect(), SizeIs(1));
+  EXPECT_THAT(m2.Collect(), IsEmpty());
+}
+
+TEST(RpcMetrics, ShortLivedObjects) {
+  // The same thread records into many objects, each destroyed before the next
+  // one is created. Each object only sees its own data.
+  for (int i = 0; i != 100; ++i) {
+    RpcMetrics m("s");
+    m.RecordAttempt("A", StatusCode::kOk, std::chrono::milliseconds(1));
+    auto points = m.Collect();
+    ASSERT_THAT(points, SizeIs(1));
+    EXPECT_EQ(points[0].attempt_latency.count, 1);
+  }
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
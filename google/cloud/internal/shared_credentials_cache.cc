@@ -0,0 +1,77 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/shared_credentials_cache.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+struct Registry {
+  std::mutex mu;
+  using Key = std::pair<std::type_index, std::string>;
+  std::map<Credentials const*, std::map<Key, std::weak_ptr<void>>>
+      entries;  // ABSL_GUARDED_BY(mu)
+};
+
+Registry& GetRegistry() {
+  // Never destroyed, `Credentials` may be destroyed during static destruction.
+  static auto* const kRegistry = new Registry;
+  return *kRegistry;
+}
+
+}  // namespace
+
+std::shared_ptr<void> SharedCredentialsCacheImpl(
+    Credentials const& credentials, std::type_index type,
+    std::string const& key,
+    absl::FunctionRef<std::shared_ptr<void>()> factory) {
+  auto& registry = GetRegistry();
+  auto const k = Registry::Key(type, key);
+  {
+    std::lock_guard<std::mutex> lk(registry.mu);
+    auto& entries = registry.entries[&credentials];
+    auto i = entries.find(k);
+    if (i != entries.end()) {
+      if (auto existing = i->second.lock()) return existing;
+    }
+  }
+  // Create the object without holding the lock, the factory may be expensive
+  // or recursive.
+  auto created = factory();
+  std::lock_guard<std::mutex> lk(registry.mu);
+  auto& entry = registry.entries[&credentials][k];
+  // Another thread may have won the race, prefer its object so all the clients
+  // share a single cache.
+  if (auto existing = entry.lock()) return existing;
+  entry = created;
+  return created;
+}
+
+void ForgetSharedCredentialsCaches(Credentials const* credentials) {
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mu);
+  registry.entries.erase(credentials);
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,85 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_SHARED_CREDENTIALS_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_SHARED_CREDENTIALS_CACHE_H
+
+#include "google/cloud/credentials.h"
+#include "google/cloud/version.h"
+#include "absl/functional/function_ref.h"
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/// Implements `SharedCredentialsCache()`, see below.
+std::shared_ptr<void> SharedCredentialsCacheImpl(
+    Credentials const& credentials, std::type_index type,
+    std::string const& key, absl::FunctionRef<std::shared_ptr<void>()> factory);
+
+/// Removes any objects associated with @p credentials from the registry.
+void ForgetSharedCredentialsCaches(Credentials const* credentials);
+
+/**
+ * Returns the process-wide object of type `T` associated with @p credentials.
+ *
+ * Refreshing access tokens is expensive, and all the clients created with the
+ * same `Credentials` object can share the same tokens. The first call creates
+ * the object using @p factory, further calls return the same object for as
+ * long as some client holds a reference to it.
+ *
+ * The registry uses the address of @p credentials as its key. The association
+ * ends when @p credentials is destroyed, so a new `Credentials` object created
+ * at the same address never receives a stale cache. Clients created without
+ * explicit credentials all use the same object, see
+ * `SharedGoogleDefaultCredentials()`.
+ *
+ * Clients with the same credentials may still need different caches, e.g.,
+ * if they get their tokens from a different universe domain. Such clients
+ * must use a different @p key.
+ *
+ * @note @p factory is called without holding any locks, it may call this
+ *     function recursively, e.g., to map the base credentials of a service
+ *     account impersonation configuration.
+ */
+template <typename T, typename Factory>
+std::shared_ptr<T> SharedCredentialsCache(Credentials const& credentials,
+                                          std::string const& key,
+                                          Factory&& factory) {
+  return std::static_pointer_cast<T>(SharedCredentialsCacheImpl(
+      credentials, std::type_index(typeid(T)), key,
+      [&factory]() -> std::shared_ptr<void> {
+        return std::forward<Factory>(factory)();
+      }));
+}
+
+template <typename T, typename Factory>
+std::shared_ptr<T> SharedCredentialsCache(Credentials const& credentials,
+                                          Factory&& factory) {
+  return SharedCredentialsCache<T>(credentials, std::string{},
+                                   std::forward<Factory>(factory));
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_SHARED_CREDENTIALS_CACHE_H
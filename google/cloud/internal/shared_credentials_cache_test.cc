@@ -0,0 +1,113 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/shared_credentials_cache.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+struct TestCache {
+  int id;
+};
+
+TEST(SharedCredentialsCache, SameCredentialsShare) {
+  auto credentials = MakeInsecureCredentials();
+  int calls = 0;
+  auto factory = [&calls] {
+    return std::make_shared<TestCache>(TestCache{++calls});
+  };
+  auto c1 = SharedCredentialsCache<TestCache>(*credentials, factory);
+  auto c2 = SharedCredentialsCache<TestCache>(*credentials, factory);
+  EXPECT_EQ(c1, c2);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(SharedCredentialsCache, DifferentCredentialsDoNotShare) {
+  auto credentials1 = MakeInsecureCredentials();
+  auto credentials2 = MakeInsecureCredentials();
+  int calls = 0;
+  auto factory = [&calls] {
+    return std::make_shared<TestCache>(TestCache{++calls});
+  };
+  auto c1 = SharedCredentialsCache<TestCache>(*credentials1, factory);
+  auto c2 = SharedCredentialsCache<TestCache>(*credentials2, factory);
+  EXPECT_NE(c1, c2);
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(SharedCredentialsCache, DifferentKeysDoNotShare) {
+  auto credentials = MakeInsecureCredentials();
+  int calls = 0;
+  auto factory = [&calls] {
+    return std::make_shared<TestCache>(TestCache{++calls});
+  };
+  auto c1 = SharedCredentialsCache<TestCache>(*credentials, "k1", factory);
+  auto c2 = SharedCredentialsCache<TestCache>(*credentials, "k2", factory);
+  auto c3 = SharedCredentialsCache<TestCache>(*credentials, "k1", factory);
+  EXPECT_NE(c1, c2);
+  EXPECT_EQ(c1, c3);
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(SharedCredentialsCache, RecreatedAfterRelease) {
+  auto credentials = MakeInsecureCredentials();
+  int calls = 0;
+  auto factory = [&calls] {
+    return std::make_shared<TestCache>(TestCache{++calls});
+  };
+  auto c1 = SharedCredentialsCache<TestCache>(*credentials, factory);
+  EXPECT_EQ(c1->id, 1);
+  c1.reset();
+  auto c2 = SharedCredentialsCache<TestCache>(*credentials, factory);
+  EXPECT_EQ(c2->id, 2);
+}
+
+TEST(SharedCredentialsCache, ForgottenWithCredentials) {
+  int calls = 0;
+  auto factory = [&calls] {
+    return std::make_shared<TestCache>(TestCache{++calls});
+  };
+  auto credentials = MakeInsecureCredentials();
+  auto const* address = credentials.get();
+  auto c1 = SharedCredentialsCache<TestCache>(*credentials, factory);
+  credentials.reset();
+  // Simulate a new object at the same address, it must not see `c1`.
+  ForgetSharedCredentialsCaches(address);
+  credentials = MakeInsecureCredentials();
+  auto c2 = SharedCredentialsCache<TestCache>(*credentials, factory);
+  EXPECT_NE(c1, c2);
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(SharedCredentialsCache, RecursiveFactory) {
+  auto credentials = MakeInsecureCredentials();
+  auto base = MakeInsecureCredentials();
+  auto c1 = SharedCredentialsCache<TestCache>(*credentials, [&] {
+    auto b = SharedCredentialsCache<std::string>(
+        *base, [] { return std::make_shared<std::string>("base"); });
+    return std::make_shared<TestCache>(TestCache{static_cast<int>(b->size())});
+  });
+  EXPECT_EQ(c1->id, 4);
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
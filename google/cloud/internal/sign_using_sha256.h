@@ -18,6 +18,7 @@
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,26 @@ namespace internal {
 StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
     std::string const& str, std::string const& pem_contents);
 
+/**
+ * A private key parsed from a PEM container, ready to create signatures.
+ *
+ * Parsing the PEM contents and preparing the signing context are a significant
+ * fraction of the cost of `SignUsingSha256()`. Credentials that sign many
+ * blobs, or refresh self-signed JWTs, should parse the key once and reuse it.
+ * Instances are immutable, and can be used from multiple threads.
+ *
+ * The representation depends on the platform's cryptography library.
+ */
+class SigningKey;
+
+/// Parses @p pem_contents into a key usable with `SignUsingSha256()`.
+StatusOr<std::shared_ptr<SigningKey const>> ParseSigningKey(
+    std::string const& pem_contents);
+
+/// Signs a string with a previously parsed private key.
+StatusOr<std::vector<std::uint8_t>> SignUsingSha256(std::string const& str,
+                                                    SigningKey const& key);
+
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
@@ -14,6 +14,7 @@
 
 #include "google/cloud/internal/timer_queue.h"
 #include "google/cloud/internal/make_status.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -34,10 +35,12 @@ future<StatusOr<std::chrono::system_clock::time_point>> TimerQueue::Schedule(
     lk.unlock();
     return make_ready_future(MakeCancelled(__func__));
   }
-  auto const key = MakeKey(tp);
-  auto p = MakePromise(std::move(weak), key);
-  auto f = p.get_future();
-  Insert(std::move(lk), key, std::move(p));
+  FutureType f;
+  Insert(std::move(lk), tp, [&](HandleType h) {
+    auto p = MakePromise(std::move(weak), h);
+    f = p.get_future();
+    return p;
+  });
   return f;
 }
 
@@ -55,7 +58,9 @@ void TimerQueue::Shutdown() {
 //
 // Once a timer expires, the leader thread relinquishes its role and wakes up
 // one follower thread to become the new leader. Only after doing so it
-// runs the code to expire the timer.
+// runs the code to expire the timer. All the timers that expired at the same
+// time are removed from the timing wheel in a single batch, the following
+// leaders take them from `ready_` without touching the wheel.
 //
 // This is all complicated by shutdown. Basically all thread needs to wake
 // up when the TQ is shutdown and one of them will expire all the timers.
@@ -72,56 +77,60 @@ void TimerQueue::Service() {
     }
     is_leader = true;
     has_leader_ = true;
-    if (timers_.empty()) {
-      cv_.wait(lk, [this] { return shutdown_ || !timers_.empty(); });
+    if (ready_.empty()) {
+      ready_ = timers_.Expire(std::chrono::system_clock::now());
+      // Expire the earliest timers first, as `ready_` is consumed from the
+      // back.
+      std::reverse(ready_.begin(), ready_.end());
+    }
+    if (!ready_.empty()) {
+      auto e = std::move(ready_.back());
+      ready_.pop_back();
+      // Relinquish the leader role, release the mutex and then signal a
+      // follower.
+      has_leader_ = false;
+      lk.unlock();
+      is_leader = false;
+      // Elect a new leader (if available) to continue expiring timers.
+      cv_follower_.notify_one();
+      // This may run user code (in the continuations for the future). That may
+      // do all kinds of things, including calling back into this class to
+      // create new timers. We cannot hold the mutex while it is running.
+      e.second.set_value(e.first);
+      lk.lock();
       continue;
     }
-    // Should a new timer appear that changes the "first" timer, we need to
-    // wake up and recompute the sleep time. But note that the leader thread
-    // does not need to relinquish its role to do so.
-    auto key = timers_.begin()->first;
-    auto predicate = [this, key] {
-      return shutdown_ || timers_.empty() || timers_.begin()->first != key;
+    // Should a new timer appear that expires before `wake_up_`, `Insert()`
+    // changes `wake_up_` and we need to wake up and recompute the sleep time.
+    // But note that the leader thread does not need to relinquish its role to
+    // do so.
+    auto const deadline = timers_.NextExpiration();
+    wake_up_ = deadline;
+    auto predicate = [this, deadline] {
+      return shutdown_ || wake_up_ != deadline;
     };
-    if (cv_.wait_until(lk, key.first, std::move(predicate))) {
-      // Timers can be expired only if wait_util() returns due to a timeout.
-      continue;
+    if (deadline == std::chrono::system_clock::time_point::max()) {
+      cv_.wait(lk, std::move(predicate));
+    } else {
+      cv_.wait_until(lk, deadline, std::move(predicate));
     }
-    // If we get here we know that predicate() is false, which implies that
-    // `timers_` is not empty and the first timer's key is `until`.
-    auto p = std::move(timers_.begin()->second);
-    timers_.erase(timers_.begin());
-    // Relinquish the leader role, release the mutex and then signal a follower.
-    has_leader_ = false;
-    lk.unlock();
-    is_leader = false;
-    // Elect a new leader (if available) to continue expiring timers.
-    cv_follower_.notify_one();
-    // This may run user code (in the continuations for the future). That may
-    // do all kinds of things, including calling back into this class to create
-    // new timers. We cannot hold the mutex while it is running.
-    p.set_value(key.first);
-    lk.lock();
   }
-  while (!timers_.empty()) {
-    auto p = std::move(timers_.begin()->second);
-    timers_.erase(timers_.begin());
+  for (auto& e : timers_.Clear()) ready_.push_back(std::move(e));
+  while (!ready_.empty()) {
+    auto p = std::move(ready_.back().second);
+    ready_.pop_back();
     lk.unlock();
     p.set_value(MakeCancelled(__func__));
     lk.lock();
   }
 }
 
-void TimerQueue::Cancel(KeyType key) {
+void TimerQueue::Cancel(HandleType h) {
   std::unique_lock<std::mutex> lk(mu_);
-  auto f = timers_.find(key);
-  if (f == timers_.end()) return;
-  auto p = std::move(f->second);
-  auto const should_notify = f == timers_.begin();
-  timers_.erase(f);
+  auto p = timers_.Cancel(h);
   lk.unlock();
-  if (should_notify) cv_.notify_one();
-  p.set_value(CancelledError("Timer cancelled"));
+  if (!p) return;
+  p->set_value(CancelledError("Timer cancelled"));
 }
 
 StatusOr<std::chrono::system_clock::time_point> TimerQueue::MakeCancelled(
@@ -131,10 +140,12 @@ StatusOr<std::chrono::system_clock::time_point> TimerQueue::MakeCancelled(
       ::google::cloud::internal::ErrorInfoBuilder(__FILE__, __LINE__, where));
 }
 
-void TimerQueue::Insert(std::unique_lock<std::mutex> lk, KeyType const& key,
-                        PromiseType p) {
-  auto const i = timers_.emplace(key, std::move(p));
-  if (i != timers_.begin()) return;
+void TimerQueue::Insert(
+    std::unique_lock<std::mutex> lk, std::chrono::system_clock::time_point tp,
+    absl::FunctionRef<PromiseType(HandleType)> make_promise) {
+  timers_.Emplace(tp, make_promise);
+  if (tp >= wake_up_) return;
+  wake_up_ = tp;
   lk.unlock();
   cv_.notify_one();
 }
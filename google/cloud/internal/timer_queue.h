@@ -16,13 +16,16 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMER_QUEUE_H
 
 #include "google/cloud/future.h"
+#include "google/cloud/internal/timing_wheel.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
+#include "absl/functional/function_ref.h"
 #include <chrono>
 #include <condition_variable>
-#include <map>
 #include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -141,10 +144,12 @@ class TimerQueue : public std::enable_shared_from_this<TimerQueue> {
       return make_ready_future(MakeCancelled(__func__))
           .then(std::forward<Functor>(functor));
     }
-    auto const key = MakeKey(tp);
-    auto p = MakePromise(std::move(weak), key);
-    auto f = p.get_future().then(std::forward<Functor>(functor));
-    Insert(std::move(lk), key, std::move(p));
+    decltype(std::declval<FutureType>().then(std::forward<Functor>(functor))) f;
+    Insert(std::move(lk), tp, [&](HandleType h) {
+      auto p = MakePromise(std::move(weak), h);
+      f = p.get_future().then(std::forward<Functor>(functor));
+      return p;
+    });
     return f;
   }
 
@@ -189,13 +194,12 @@ class TimerQueue : public std::enable_shared_from_this<TimerQueue> {
 
  private:
   using PromiseType = promise<StatusOr<std::chrono::system_clock::time_point>>;
-  using KeyType =
-      std::pair<std::chrono::system_clock::time_point, std::uint64_t>;
+  using HandleType = TimingWheel<PromiseType>::Handle;
 
   TimerQueue() = default;
 
   // Cancels a timer.
-  void Cancel(KeyType key);
+  void Cancel(HandleType h);
 
   /**
    * Helper function to satisfy futures and promises on shutdown.
@@ -209,24 +213,28 @@ class TimerQueue : public std::enable_shared_from_this<TimerQueue> {
   static StatusOr<std::chrono::system_clock::time_point> MakeCancelled(
       char const* where);
 
-  KeyType MakeKey(std::chrono::system_clock::time_point tp) {
-    return std::make_pair(tp, ++id_generator_);
-  }
-
-  static PromiseType MakePromise(std::weak_ptr<TimerQueue> w, KeyType key) {
-    return PromiseType([weak = std::move(w), key]() {
-      if (auto self = weak.lock()) self->Cancel(key);
+  static PromiseType MakePromise(std::weak_ptr<TimerQueue> w, HandleType h) {
+    return PromiseType([weak = std::move(w), h]() {
+      if (auto self = weak.lock()) self->Cancel(h);
     });
   }
 
-  void Insert(std::unique_lock<std::mutex> lk, KeyType const& key,
-              PromiseType p);
+  // Adds the promise returned by `make_promise()` to the queue.
+  void Insert(std::unique_lock<std::mutex> lk,
+              std::chrono::system_clock::time_point tp,
+              absl::FunctionRef<PromiseType(HandleType)> make_promise);
 
   std::mutex mu_;
   std::condition_variable cv_;
   std::condition_variable cv_follower_;
-  std::multimap<KeyType, PromiseType> timers_;
-  std::uint64_t id_generator_ = 0;
+  TimingWheel<PromiseType> timers_;
+  // Expired timers, in reverse expiration order, waiting for a thread to run
+  // them.
+  std::vector<std::pair<std::chrono::system_clock::time_point, PromiseType>>
+      ready_;
+  // The time at which the leader thread wakes up to expire timers.
+  std::chrono::system_clock::time_point wake_up_ =
+      std::chrono::system_clock::time_point::max();
   bool shutdown_ = false;
   bool has_leader_ = false;
 };
@@ -0,0 +1,179 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/timer_queue.h"
+#include "google/cloud/internal/timing_wheel.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+// Run on (1 X 2100 MHz CPU )
+// CPU Caches:
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// Load Average: 0.34, 0.15, 0.45
+// -----------------------------------------------------------------------
+// Benchmark                                  Time          CPU  Iterations
+// -----------------------------------------------------------------------
+// BM_TimerQueueScheduleCancel/1000000      763 ms       758 ms           1
+// BM_TimingWheelInsertCancel/1000000      16.4 ms      15.9 ms          43
+// BM_MultimapInsertCancel/1000000          869 ms       862 ms           1
+// BM_TimingWheelInsertExpire/1000000      86.6 ms      85.9 ms           8
+// BM_MultimapInsertExpire/1000000          525 ms       521 ms           2
+//
+// With a `std::multimap` in `TimerQueue`, BM_TimerQueueScheduleCancel/1000000
+// ran at 2464 ms. The remaining time is mostly spent creating and satisfying
+// the futures for each timer.
+
+auto constexpr kTimers = 1000 * 1000;
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+std::vector<TimePoint> RandomExpirations(TimePoint start, int count) {
+  std::mt19937_64 gen(42);
+  // Spread the timers over 10 minutes, typical for RPC deadlines.
+  std::uniform_int_distribution<std::int64_t> delay(0, 600 * 1000 * 1000);
+  std::vector<TimePoint> result(count);
+  for (auto& tp : result) tp = start + std::chrono::microseconds(delay(gen));
+  return result;
+}
+
+/// Schedule and then cancel many timers in a `TimerQueue`.
+void BM_TimerQueueScheduleCancel(benchmark::State& state) {
+  auto tq = TimerQueue::Create();
+  auto const expirations = RandomExpirations(
+      std::chrono::system_clock::now() + std::chrono::hours(1),
+      static_cast<int>(state.range(0)));
+  std::vector<future<StatusOr<TimePoint>>> timers(expirations.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != expirations.size(); ++i) {
+      timers[i] = tq->Schedule(expirations[i]);
+    }
+    for (auto& t : timers) t.cancel();
+    for (auto& t : timers) benchmark::DoNotOptimize(t.get());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  tq->Shutdown();
+}
+BENCHMARK(BM_TimerQueueScheduleCancel)
+    ->Arg(kTimers)
+    ->Unit(benchmark::kMillisecond);
+
+/// Insert and then cancel many timers in a `TimingWheel`.
+void BM_TimingWheelInsertCancel(benchmark::State& state) {
+  auto const start = std::chrono::system_clock::now();
+  TimingWheel<int> wheel(std::chrono::milliseconds(1), start);
+  auto const expirations =
+      RandomExpirations(start, static_cast<int>(state.range(0)));
+  std::vector<TimingWheel<int>::Handle> handles(expirations.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != expirations.size(); ++i) {
+      handles[i] = wheel.Insert(expirations[i], static_cast<int>(i));
+    }
+    for (auto h : handles) benchmark::DoNotOptimize(wheel.Cancel(h));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TimingWheelInsertCancel)
+    ->Arg(kTimers)
+    ->Unit(benchmark::kMillisecond);
+
+/// The same operations with an ordered container, as a baseline.
+void BM_MultimapInsertCancel(benchmark::State& state) {
+  using Key = std::pair<TimePoint, std::uint64_t>;
+  std::multimap<Key, int> timers;
+  std::uint64_t id = 0;
+  auto const expirations = RandomExpirations(std::chrono::system_clock::now(),
+                                             static_cast<int>(state.range(0)));
+  std::vector<Key> keys(expirations.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != expirations.size(); ++i) {
+      keys[i] = Key{expirations[i], ++id};
+      timers.emplace(keys[i], static_cast<int>(i));
+    }
+    for (auto const& k : keys) benchmark::DoNotOptimize(timers.erase(k));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MultimapInsertCancel)
+    ->Arg(kTimers)
+    ->Unit(benchmark::kMillisecond);
+
+/// Insert many timers in a `TimingWheel` and expire them in 1ms steps.
+void BM_TimingWheelInsertExpire(benchmark::State& state) {
+  auto const start = std::chrono::system_clock::now();
+  auto const expirations =
+      RandomExpirations(start, static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    TimingWheel<int> wheel(std::chrono::milliseconds(1), start);
+    for (std::size_t i = 0; i != expirations.size(); ++i) {
+      wheel.Insert(expirations[i], static_cast<int>(i));
+    }
+    auto constexpr kStep = std::chrono::milliseconds(1);
+    for (auto now = start; !wheel.empty(); now += kStep) {
+      benchmark::DoNotOptimize(wheel.Expire(now));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TimingWheelInsertExpire)
+    ->Arg(kTimers)
+    ->Unit(benchmark::kMillisecond);
+
+/// The same operations with an ordered container, as a baseline.
+void BM_MultimapInsertExpire(benchmark::State& state) {
+  using Key = std::pair<TimePoint, std::uint64_t>;
+  auto const start = std::chrono::system_clock::now();
+  auto const expirations =
+      RandomExpirations(start, static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    std::multimap<Key, int> timers;
+    std::uint64_t id = 0;
+    for (std::size_t i = 0; i != expirations.size(); ++i) {
+      timers.emplace(Key{expirations[i], ++id}, static_cast<int>(i));
+    }
+    auto constexpr kStep = std::chrono::milliseconds(1);
+    for (auto now = start; !timers.empty(); now += kStep) {
+      std::vector<std::pair<TimePoint, int>> expired;
+      while (!timers.empty() && timers.begin()->first.first <= now) {
+        expired.emplace_back(timers.begin()->first.first,
+                             timers.begin()->second);
+        timers.erase(timers.begin());
+      }
+      benchmark::DoNotOptimize(expired);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MultimapInsertExpire)
+    ->Arg(kTimers)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
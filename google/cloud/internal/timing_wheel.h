@@ -0,0 +1,315 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMING_WHEEL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMING_WHEEL_H
+
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/**
+ * A hierarchical timing wheel.
+ *
+ * Stores values of type `T`, each associated with an expiration time. Inserting
+ * and cancelling a timer are O(1) operations, and expiring timers is amortized
+ * O(1) per timer. This is in contrast to an ordered container, where each of
+ * these operations is O(log N), and requires one allocation per timer.
+ *
+ * The wheel has `kLevels` levels with `kSlots` slots each. Slots in level `k`
+ * span `kSlots^k` ticks. Timers are stored in the level where their
+ * expiration (in ticks) first differs from the current time, and "cascade" to
+ * lower levels as the current time advances. Timers too far in the future for
+ * all the levels are kept in an overflow list.
+ *
+ * Ticks only control how timers are stored. Timers never expire early, and
+ * `Expire()` returns the expired timers in order.
+ *
+ * This class is not thread-safe, the caller must provide any synchronization.
+ */
+template <typename T>
+class TimingWheel {
+ public:
+  using clock = std::chrono::system_clock;
+  using time_point = clock::time_point;
+  using duration = clock::duration;
+
+  /// Identifies a timer, for use in `Cancel()`.
+  struct Handle {
+    std::uint32_t index;
+    std::uint32_t generation;
+  };
+
+  explicit TimingWheel(duration tick = std::chrono::milliseconds(1),
+                       time_point now = clock::now())
+      : tick_(tick), origin_(now) {}
+
+  bool empty() const { return size_ == 0; }
+  std::size_t size() const { return size_; }
+
+  /// Adds a timer expiring at @p tp.
+  Handle Insert(time_point tp, T value) {
+    return Emplace(tp, [&value](Handle) { return std::move(value); });
+  }
+
+  /**
+   * Adds a timer expiring at @p tp, with the value returned by
+   * `make_value(handle)`.
+   *
+   * Use this function when the value needs to know its own handle, e.g., to
+   * cancel the timer.
+   */
+  template <typename MakeValue>
+  Handle Emplace(time_point tp, MakeValue&& make_value) {
+    if (free_.empty()) {
+      free_.push_back(static_cast<std::uint32_t>(entries_.size()));
+      entries_.emplace_back();
+    }
+    auto const index = free_.back();
+    auto& e = entries_[index];
+    auto const handle = Handle{index, e.generation};
+    e.value.emplace(std::forward<MakeValue>(make_value)(handle));
+    // Only claim the entry once `make_value()` succeeds.
+    free_.pop_back();
+    e.tp = tp;
+    e.sequence = ++sequence_;
+    Place(index);
+    ++size_;
+    return handle;
+  }
+
+  /**
+   * Removes a timer.
+   *
+   * Returns the value associated with the timer, or `absl::nullopt` if the
+   * timer already expired or was cancelled.
+   */
+  absl::optional<T> Cancel(Handle h) {
+    if (h.index >= entries_.size()) return absl::nullopt;
+    auto& e = entries_[h.index];
+    if (e.generation != h.generation || !e.value) return absl::nullopt;
+    Unlink(h.index);
+    return Release(h.index);
+  }
+
+  /**
+   * Removes and returns all the timers expiring at or before @p now.
+   *
+   * The timers are sorted by expiration time, timers with the same expiration
+   * time are returned in insertion order.
+   */
+  std::vector<std::pair<time_point, T>> Expire(time_point now) {
+    std::vector<std::uint32_t> expired;
+    auto const target = now <= Now() ? current_ : ToTick(now);
+    for (;;) {
+      // Iterate backwards, `Unlink()` moves the last element of the list.
+      auto const& list = lists_[ListIndex(0, current_)];
+      for (auto i = list.size(); i != 0; --i) {
+        auto const index = list[i - 1];
+        if (entries_[index].tp > now) continue;
+        Unlink(index);
+        expired.push_back(index);
+      }
+      if (current_ >= target) break;
+      current_ = NextTick(target);
+      Cascade();
+    }
+    std::sort(expired.begin(), expired.end(),
+              [this](std::uint32_t a, std::uint32_t b) {
+                return std::tie(entries_[a].tp, entries_[a].sequence) <
+                       std::tie(entries_[b].tp, entries_[b].sequence);
+              });
+    std::vector<std::pair<time_point, T>> result;
+    result.reserve(expired.size());
+    for (auto index : expired) {
+      result.emplace_back(entries_[index].tp, *Release(index));
+    }
+    return result;
+  }
+
+  /**
+   * Returns a time point at or before the next expiration.
+   *
+   * The result is exact if a timer expires in the current level 0 window.
+   * Otherwise it is the time at which the next timers cascade, the caller
+   * should call `Expire()` at that time and then query this function again.
+   * Returns `time_point::max()` if there are no timers.
+   */
+  time_point NextExpiration() const {
+    if (empty()) return time_point::max();
+    if (counts_[0] != 0) {
+      for (auto slot = current_ % kSlots; slot != kSlots; ++slot) {
+        auto const& list = lists_[slot];
+        if (list.empty()) continue;
+        auto tp = time_point::max();
+        for (auto index : list) tp = (std::min)(tp, entries_[index].tp);
+        return tp;
+      }
+    }
+    return origin_ + tick_ * static_cast<duration::rep>(NextBoundary());
+  }
+
+  /// Removes and returns all the timers, in no particular order.
+  std::vector<std::pair<time_point, T>> Clear() {
+    std::vector<std::pair<time_point, T>> result;
+    result.reserve(size_);
+    for (auto& list : lists_) {
+      for (auto index : list) {
+        result.emplace_back(entries_[index].tp, *Release(index));
+      }
+      list.clear();
+    }
+    counts_.fill(0);
+    return result;
+  }
+
+ private:
+  static auto constexpr kBits = 6;
+  static auto constexpr kSlots = std::uint64_t{1} << kBits;
+  static auto constexpr kLevels = 5;
+  // Each level has `kSlots` lists, the last list is the overflow list.
+  static auto constexpr kLists = kLevels * kSlots + 1;
+  static auto constexpr kOverflow = kLists - 1;
+
+  struct Entry {
+    time_point tp;
+    std::uint64_t sequence = 0;
+    std::uint32_t generation = 0;
+    std::uint32_t list = 0;
+    std::uint32_t position = 0;
+    absl::optional<T> value;
+  };
+
+  static std::size_t ListIndex(int level, std::uint64_t tick) {
+    return static_cast<std::size_t>(level * kSlots +
+                                    ((tick >> (level * kBits)) % kSlots));
+  }
+  static int Level(std::size_t list) {
+    return static_cast<int>(list / kSlots);
+  }
+
+  time_point Now() const {
+    return origin_ + tick_ * static_cast<duration::rep>(current_);
+  }
+
+  // Only valid for `tp > Now()`.
+  std::uint64_t ToTick(time_point tp) const {
+    return static_cast<std::uint64_t>((tp - origin_) / tick_);
+  }
+
+  // Inserts `entries_[index]` in the right list for the current time.
+  void Place(std::uint32_t index) {
+    auto& e = entries_[index];
+    std::size_t list = ListIndex(0, current_);
+    if (e.tp > Now()) {
+      auto const tick = ToTick(e.tp);
+      auto const diff = tick ^ current_;
+      int level = 0;
+      while (level != kLevels && (diff >> ((level + 1) * kBits)) != 0) {
+        ++level;
+      }
+      list = level == kLevels ? kOverflow : ListIndex(level, tick);
+    }
+    auto& l = lists_[list];
+    e.list = static_cast<std::uint32_t>(list);
+    e.position = static_cast<std::uint32_t>(l.size());
+    l.push_back(index);
+    ++counts_[Level(list)];
+  }
+
+  // Removes `entries_[index]` from its list.
+  void Unlink(std::uint32_t index) {
+    auto const& e = entries_[index];
+    auto& l = lists_[e.list];
+    auto const last = l.back();
+    l[e.position] = last;
+    entries_[last].position = e.position;
+    l.pop_back();
+    --counts_[Level(e.list)];
+  }
+
+  // Returns the value of `entries_[index]` and recycles the entry.
+  absl::optional<T> Release(std::uint32_t index) {
+    auto& e = entries_[index];
+    absl::optional<T> value = std::move(e.value);
+    e.value.reset();
+    ++e.generation;
+    free_.push_back(index);
+    --size_;
+    return value;
+  }
+
+  // The first tick, after `current_`, at which the lowest non-empty level
+  // cascades.
+  std::uint64_t NextBoundary() const {
+    auto level = 1;
+    while (level != kLevels && counts_[level] == 0) ++level;
+    auto const span = std::uint64_t{1} << (level * kBits);
+    return (current_ / span + 1) * span;
+  }
+
+  // Advances the current time by one tick, or, if possible, to the next tick
+  // at which any timers cascade, but never beyond `target`.
+  std::uint64_t NextTick(std::uint64_t target) const {
+    if (counts_[0] != 0) return current_ + 1;
+    if (empty()) return target;
+    return (std::min)(target, NextBoundary());
+  }
+
+  // Moves the timers in the lists starting at `current_` to lower levels.
+  void Cascade() {
+    auto level = 0;
+    while (level != kLevels &&
+           current_ % (std::uint64_t{1} << ((level + 1) * kBits)) == 0) {
+      ++level;
+    }
+    for (; level != 0; --level) {
+      auto const list =
+          level == kLevels ? kOverflow : ListIndex(level, current_);
+      auto pending = std::move(lists_[list]);
+      lists_[list].clear();
+      counts_[Level(list)] -= pending.size();
+      for (auto index : pending) Place(index);
+    }
+  }
+
+  duration tick_;
+  time_point origin_;
+  std::uint64_t current_ = 0;
+  std::uint64_t sequence_ = 0;
+  std::size_t size_ = 0;
+  std::vector<Entry> entries_;
+  std::vector<std::uint32_t> free_;
+  std::array<std::vector<std::uint32_t>, kLists> lists_;
+  std::array<std::size_t, kLevels + 1> counts_{};
+};
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMING_WHEEL_H
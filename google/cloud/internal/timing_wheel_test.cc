@@ -0,0 +1,198 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/timing_wheel.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::std::chrono::hours;
+using ::std::chrono::microseconds;
+using ::std::chrono::milliseconds;
+using ::std::chrono::nanoseconds;
+using ::std::chrono::seconds;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+auto const kStart = TimePoint{} + hours(24 * 365);
+
+TEST(TimingWheelTest, Basic) {
+  TimingWheel<int> wheel(milliseconds(1), kStart);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.NextExpiration(), TimePoint::max());
+
+  wheel.Insert(kStart + milliseconds(10), 10);
+  wheel.Insert(kStart + milliseconds(5), 5);
+  EXPECT_EQ(wheel.size(), 2);
+  EXPECT_EQ(wheel.NextExpiration(), kStart + milliseconds(5));
+
+  EXPECT_THAT(wheel.Expire(kStart + milliseconds(4)), IsEmpty());
+  EXPECT_THAT(wheel.Expire(kStart + milliseconds(5)),
+              ElementsAre(Pair(kStart + milliseconds(5), 5)));
+  EXPECT_EQ(wheel.NextExpiration(), kStart + milliseconds(10));
+  EXPECT_THAT(wheel.Expire(kStart + seconds(1)),
+              ElementsAre(Pair(kStart + milliseconds(10), 10)));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, NeverExpiresEarly) {
+  TimingWheel<int> wheel(milliseconds(1), kStart);
+  auto const tp = kStart + milliseconds(2) + nanoseconds(500);
+  wheel.Insert(tp, 1);
+  EXPECT_EQ(wheel.NextExpiration(), tp);
+  EXPECT_THAT(wheel.Expire(tp - nanoseconds(1)), IsEmpty());
+  EXPECT_EQ(wheel.NextExpiration(), tp);
+  EXPECT_THAT(wheel.Expire(tp), ElementsAre(Pair(tp, 1)));
+}
+
+TEST(TimingWheelTest, ExpiresInOrder) {
+  TimingWheel<int> wheel(milliseconds(1), kStart);
+  // Sub-tick differences must be respected, and timers with the same
+  // expiration time expire in insertion order.
+  wheel.Insert(kStart + nanoseconds(10), 0);
+  wheel.Insert(kStart + nanoseconds(9), 1);
+  wheel.Insert(kStart + seconds(5), 2);
+  wheel.Insert(kStart + nanoseconds(9), 3);
+  wheel.Insert(kStart + milliseconds(70), 4);
+  wheel.Insert(TimePoint::min(), 5);
+  std::vector<int> actual;
+  for (auto& kv : wheel.Expire(kStart + hours(1))) actual.push_back(kv.second);
+  EXPECT_THAT(actual, ElementsAre(5, 1, 3, 0, 4, 2));
+}
+
+TEST(TimingWheelTest, PastTimers) {
+  TimingWheel<int> wheel(milliseconds(1), kStart);
+  EXPECT_THAT(wheel.Expire(kStart + seconds(10)), IsEmpty());
+  wheel.Insert(kStart, 1);
+  wheel.Insert(TimePoint::min(), 2);
+  EXPECT_LE(wheel.NextExpiration(), kStart);
+  EXPECT_THAT(wheel.Expire(kStart + seconds(10)),
+              ElementsAre(Pair(TimePoint::min(), 2), Pair(kStart, 1)));
+}
+
+TEST(TimingWheelTest, Cancel) {
+  TimingWheel<std::string> wheel(milliseconds(1), kStart);
+  auto h0 = wheel.Insert(kStart + milliseconds(10), "h0");
+  auto h1 = wheel.Insert(kStart + hours(2), "h1");
+  auto h2 = wheel.Insert(kStart + milliseconds(10), "h2");
+  EXPECT_EQ(wheel.Cancel(h1).value_or(""), "h1");
+  EXPECT_FALSE(wheel.Cancel(h1).has_value());
+  EXPECT_EQ(wheel.Cancel(h0).value_or(""), "h0");
+  EXPECT_EQ(wheel.size(), 1);
+
+  EXPECT_THAT(wheel.Expire(kStart + hours(3)),
+              ElementsAre(Pair(kStart + milliseconds(10), "h2")));
+  // Cancelling an expired timer has no effect, even if its storage is reused.
+  auto h3 = wheel.Insert(kStart + hours(4), "h3");
+  EXPECT_FALSE(wheel.Cancel(h2).has_value());
+  EXPECT_EQ(wheel.size(), 1);
+  EXPECT_EQ(wheel.Cancel(h3).value_or(""), "h3");
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, Cascade) {
+  TimingWheel<int> wheel(milliseconds(1), kStart);
+  std::vector<TimePoint> const expirations{
+      kStart + milliseconds(63),  kStart + milliseconds(64),
+      kStart + milliseconds(100), kStart + seconds(5),
+      kStart + seconds(300),      kStart + hours(5),
+      kStart + hours(24 * 30),    kStart + hours(24 * 400),
+  };
+  for (std::size_t i = 0; i != expirations.size(); ++i) {
+    wheel.Insert(expirations[i], static_cast<int>(i));
+  }
+  // Expire each timer at its expiration time, using `NextExpiration()` to
+  // find the next time.
+  std::vector<std::pair<TimePoint, int>> actual;
+  auto now = kStart;
+  while (!wheel.empty()) {
+    auto next = wheel.NextExpiration();
+    ASSERT_GT(next, now);
+    now = next;
+    for (auto& kv : wheel.Expire(now)) {
+      EXPECT_EQ(kv.first, now);
+      actual.push_back(std::move(kv));
+    }
+  }
+  ASSERT_EQ(actual.size(), expirations.size());
+  for (std::size_t i = 0; i != actual.size(); ++i) {
+    EXPECT_EQ(actual[i].first, expirations[i]);
+    EXPECT_EQ(actual[i].second, static_cast<int>(i));
+  }
+}
+
+TEST(TimingWheelTest, Clear) {
+  TimingWheel<int> wheel(milliseconds(1), kStart);
+  wheel.Insert(kStart + milliseconds(1), 1);
+  wheel.Insert(kStart + hours(1), 2);
+  wheel.Insert(kStart + hours(24 * 100), 3);
+  auto all = wheel.Clear();
+  std::vector<int> values;
+  for (auto& kv : all) values.push_back(kv.second);
+  std::sort(values.begin(), values.end());
+  EXPECT_THAT(values, ElementsAre(1, 2, 3));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_THAT(wheel.Expire(kStart + hours(24 * 200)), IsEmpty());
+}
+
+/// @test Compare against a sorted vector with random timers.
+TEST(TimingWheelTest, Random) {
+  TimingWheel<int> wheel(milliseconds(1), kStart);
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<std::int64_t> delay(0, 10'000'000);
+  std::vector<std::pair<TimePoint, int>> expected;
+  std::vector<TimingWheel<int>::Handle> handles;
+  for (int i = 0; i != 10000; ++i) {
+    auto const tp = kStart + microseconds(delay(gen));
+    handles.push_back(wheel.Insert(tp, i));
+    expected.emplace_back(tp, i);
+  }
+  // Cancel every third timer.
+  for (int i = 0; i < 10000; i += 3) {
+    ASSERT_EQ(wheel.Cancel(handles[i]).value_or(-1), i);
+  }
+  auto cancelled = [](auto const& kv) { return kv.second % 3 == 0; };
+  expected.erase(std::remove_if(expected.begin(), expected.end(), cancelled),
+                 expected.end());
+  auto by_time = [](auto const& a, auto const& b) { return a.first < b.first; };
+  std::stable_sort(expected.begin(), expected.end(), by_time);
+
+  std::vector<std::pair<TimePoint, int>> actual;
+  auto now = kStart;
+  while (!wheel.empty()) {
+    now += milliseconds(7);
+    for (auto& kv : wheel.Expire(now)) {
+      ASSERT_LE(kv.first, now);
+      actual.push_back(std::move(kv));
+    }
+  }
+  EXPECT_EQ(actual, expected);
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace cloud
+}  // namespace google
@@ -62,6 +62,8 @@ std::multimap<std::string, std::string> TracingHttpPayload::DebugHeaders()
   return impl_->DebugHeaders();
 }
 
+void TracingHttpPayload::Cancel() { impl_->Cancel(); }
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace rest_internal
 }  // namespace cloud
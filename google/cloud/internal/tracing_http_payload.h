@@ -37,6 +37,7 @@ class TracingHttpPayload : public HttpPayload {
   bool HasUnreadData() const override;
   StatusOr<std::size_t> Read(absl::Span<char> buffer) override;
   std::multimap<std::string, std::string> DebugHeaders() const override;
+  void Cancel() override;
 
  private:
   std::unique_ptr<HttpPayload> impl_;
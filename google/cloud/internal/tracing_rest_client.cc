@@ -33,6 +33,39 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
 namespace {
 
+void AddRequestHeaders(opentelemetry::trace::Span& span,
+                       RestContext const& context) {
+  for (auto const& kv : context.headers()) {
+    auto const name = "http.request.header." + kv.first;
+    if (kv.second.empty()) {
+      span.SetAttribute(name, "");
+      continue;
+    }
+    if (absl::EqualsIgnoreCase(kv.first, "authorization")) {
+      span.SetAttribute(name, kv.second.front().substr(0, 32));
+      continue;
+    }
+    span.SetAttribute(name, kv.second.front());
+  }
+}
+
+void AddResponseHeaders(opentelemetry::trace::Span& span,
+                        RestResponse const& response) {
+  // There are only 32 attributes available per span, and excess attributes are
+  // discarded. First add the `x-*` headers. They tend to have more important
+  // information.
+  auto const headers = response.Headers();
+  for (auto const& kv : headers) {
+    if (!absl::StartsWith(kv.first, "x-")) continue;
+    span.SetAttribute("http.response.header." + kv.first, kv.second);
+  }
+  // Then add all other headers.
+  for (auto const& kv : headers) {
+    if (absl::StartsWith(kv.first, "x-")) continue;
+    span.SetAttribute("http.response.header." + kv.first, kv.second);
+  }
+}
+
 /**
  * Extracts information from @p value, and adds it to a span.
  *
@@ -45,6 +78,8 @@ StatusOr<std::unique_ptr<RestResponse>> EndResponseSpan(
     opentelemetry::nostd::shared_ptr<opentelemetry::trace::Span> span,
     RestContext& context,
     StatusOr<std::unique_ptr<RestResponse>> request_result) {
+  // Avoid formatting the header attributes if the sampler dropped the span.
+  auto const recording = span->IsRecording();
   if (context.primary_ip_address() && context.primary_port()) {
     span->SetAttribute(/*sc::kServerAddress=*/"server.address",
                        *context.primary_ip_address());
@@ -58,35 +93,11 @@ StatusOr<std::unique_ptr<RestResponse>> EndResponseSpan(
     span->SetAttribute(/*sc::kClientPort=*/"client.port",
                        *context.local_port());
   }
-  for (auto const& kv : context.headers()) {
-    auto const name = "http.request.header." + kv.first;
-    if (kv.second.empty()) {
-      span->SetAttribute(name, "");
-      continue;
-    }
-    if (absl::EqualsIgnoreCase(kv.first, "authorization")) {
-      span->SetAttribute(name, kv.second.front().substr(0, 32));
-      continue;
-    }
-    span->SetAttribute(name, kv.second.front());
-  }
+  if (recording) AddRequestHeaders(*span, context);
   if (!request_result || !(*request_result)) {
     return internal::EndSpan(*span, std::move(request_result));
   }
-  auto const& response = *request_result;
-
-  // There are only 32 attributes available per span, and excess attributes are
-  // discarded. First add the `x-*` headers. They tend to have more important
-  // information.
-  for (auto const& kv : response->Headers()) {
-    if (!absl::StartsWith(kv.first, "x-")) continue;
-    span->SetAttribute("http.response.header." + kv.first, kv.second);
-  }
-  // Then add all other headers.
-  for (auto const& kv : response->Headers()) {
-    if (absl::StartsWith(kv.first, "x-")) continue;
-    span->SetAttribute("http.response.header." + kv.first, kv.second);
-  }
+  if (recording) AddResponseHeaders(*span, **request_result);
   return std::unique_ptr<RestResponse>(std::make_unique<TracingRestResponse>(
       *std::move(request_result), std::move(span)));
 }
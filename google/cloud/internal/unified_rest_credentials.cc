@@ -23,6 +23,7 @@
 #include "google/cloud/internal/oauth2_google_credentials.h"
 #include "google/cloud/internal/oauth2_impersonate_service_account_credentials.h"
 #include "google/cloud/internal/oauth2_service_account_credentials.h"
+#include "google/cloud/internal/shared_credentials_cache.h"
 
 namespace google {
 namespace cloud {
@@ -68,9 +69,14 @@ CreateServiceAccountCredentialsFromJsonContents(
 
 std::shared_ptr<oauth2_internal::Credentials> MapCredentials(
     google::cloud::Credentials const& credentials) {
-  return MapCredentials(credentials, [](Options const& options) {
-    return MakeDefaultRestClient("", options);
-  });
+  // All the clients created from the same `credentials` share the mapped
+  // object, and therefore share any cached access tokens.
+  return internal::SharedCredentialsCache<oauth2_internal::Credentials>(
+      credentials, [&credentials] {
+        return MapCredentials(credentials, [](Options const& options) {
+          return MakeDefaultRestClient("", options);
+        });
+      });
 }
 
 std::shared_ptr<oauth2_internal::Credentials> MapCredentials(
@@ -29,6 +29,10 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 /**
  * Maps a GUAC `google::cloud::Credentials` type to its corresponding OAuth 2.0
  * `google::cloud::oauth2_internal::Credentials` type.
+ *
+ * The result is shared by all the callers using the same @p credentials
+ * object, so clients created from the same credentials share their cached
+ * access tokens.
  */
 std::shared_ptr<oauth2_internal::Credentials> MapCredentials(
     google::cloud::Credentials const& credentials);
@@ -36,7 +40,8 @@ std::shared_ptr<oauth2_internal::Credentials> MapCredentials(
 /**
  * @copydoc MapCredentials(std::shared_ptr<google::cloud::Credentials> const&)
  *
- * This is used in tests, where the HTTP client needs to be mocked.
+ * This is used in tests, where the HTTP client needs to be mocked. The result
+ * is not shared.
  */
 std::shared_ptr<oauth2_internal::Credentials> MapCredentials(
     google::cloud::Credentials const& credentials,
@@ -355,6 +355,19 @@ TEST(UnifiedRestCredentialsTest, AccessToken) {
   EXPECT_THAT(token->expiration, Eq(expiration));
 }
 
+TEST(UnifiedRestCredentialsTest, SharedBySameCredentials) {
+  auto const expiration =
+      std::chrono::system_clock::now() + std::chrono::seconds(1800);
+  auto config = MakeAccessTokenCredentials("token1", expiration);
+  auto c1 = MapCredentials(*config);
+  auto c2 = MapCredentials(*config);
+  EXPECT_EQ(c1, c2);
+
+  auto other = MakeAccessTokenCredentials("token1", expiration);
+  auto c3 = MapCredentials(*other);
+  EXPECT_NE(c1, c3);
+}
+
 TEST(UnifiedRestCredentialsTest, ImpersonateServiceAccount) {
   auto const contents = MakeServiceAccountContents();
 
@@ -95,9 +95,10 @@ StatusOr<std::vector<BYTE>> GetCngPrivateKeyBlobFromPkcsBuffer(
   return rsa_blob;
 }
 
-StatusOr<std::unique_ptr<std::remove_pointer_t<BCRYPT_KEY_HANDLE>,
-                         decltype(&BCryptDestroyKey)>>
-CreateRsaBCryptKey(std::vector<BYTE> buffer) {
+using BCryptKey = std::unique_ptr<std::remove_pointer_t<BCRYPT_KEY_HANDLE>,
+                                  decltype(&BCryptDestroyKey)>;
+
+StatusOr<BCryptKey> CreateRsaBCryptKey(std::vector<BYTE> buffer) {
   BCRYPT_KEY_HANDLE key_handle;
   if (BCryptImportKeyPair(BCRYPT_RSA_ALG_HANDLE, nullptr,
                           BCRYPT_RSAPRIVATE_BLOB, &key_handle, buffer.data(),
@@ -108,9 +109,7 @@ CreateRsaBCryptKey(std::vector<BYTE> buffer) {
             "Invalid ServiceAccountCredentials - could not import RSA key: "),
         GCP_ERROR_INFO());
   }
-  return std::unique_ptr<std::remove_pointer_t<BCRYPT_KEY_HANDLE>,
-                         decltype(&BCryptDestroyKey)>(key_handle,
-                                                      &BCryptDestroyKey);
+  return BCryptKey(key_handle, &BCryptDestroyKey);
 }
 
 StatusOr<std::vector<std::uint8_t>> SignSha256Digest(BCRYPT_KEY_HANDLE key,
@@ -135,8 +134,18 @@ StatusOr<std::vector<std::uint8_t>> SignSha256Digest(BCRYPT_KEY_HANDLE key,
 
 }  // namespace
 
-StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
-    std::string const& str, std::string const& pem_contents) {
+class SigningKey {
+ public:
+  explicit SigningKey(BCryptKey key) : key_(std::move(key)) {}
+
+  BCRYPT_KEY_HANDLE get() const { return key_.get(); }
+
+ private:
+  BCryptKey key_;
+};
+
+StatusOr<std::shared_ptr<SigningKey const>> ParseSigningKey(
+    std::string const& pem_contents) {
   auto pem_buffer = DecodePem(pem_contents);
   if (!pem_buffer) return std::move(pem_buffer).status();
 
@@ -146,9 +155,20 @@ StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
   auto key = CreateRsaBCryptKey(std::move(*rsa_blob));
   if (!key) return std::move(key).status();
 
-  auto hash = Sha256Hash(str);
+  return std::shared_ptr<SigningKey const>(
+      std::make_shared<SigningKey>(*std::move(key)));
+}
+
+StatusOr<std::vector<std::uint8_t>> SignUsingSha256(std::string const& str,
+                                                    SigningKey const& key) {
+  return SignSha256Digest(key.get(), Sha256Hash(str));
+}
 
-  return SignSha256Digest(key->get(), hash);
+StatusOr<std::vector<std::uint8_t>> SignUsingSha256(
+    std::string const& str, std::string const& pem_contents) {
+  auto key = ParseSigningKey(pem_contents);
+  if (!key) return std::move(key).status();
+  return SignUsingSha256(str, **key);
 }
 
 }  // namespace internal
@@ -13,12 +13,17 @@
 // limitations under the License.
 
 #include "google/cloud/log.h"
+#include "google/cloud/internal/atomic_shared_ptr.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/log_impl.h"
 #include "absl/strings/str_split.h"
 #include "absl/time/time.h"
+#include <algorithm>
 #include <array>
+#include <cstdlib>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -62,6 +67,45 @@ absl::optional<std::size_t> ParseSize(std::string const& str) {
   return static_cast<std::size_t>(val);
 }
 
+// `LogSink::Instance()` is never destroyed, and neither is its default backend.
+// An `AsyncLogBackend` must write the records it buffered before the process
+// exits, or the records below its flush severity are lost.
+struct AtExitBackends {
+  std::mutex mu;
+  std::vector<std::weak_ptr<LogBackend>> backends;  // GUARDED_BY(mu)
+};
+
+AtExitBackends& GetAtExitBackends() {
+  static auto* const kBackends = new AtExitBackends;
+  return *kBackends;
+}
+
+void FlushBackendsAtExit() {
+  auto& registry = GetAtExitBackends();
+  std::vector<std::shared_ptr<LogBackend>> backends;
+  {
+    std::lock_guard<std::mutex> lk(registry.mu);
+    for (auto const& w : registry.backends) {
+      if (auto b = w.lock()) backends.push_back(std::move(b));
+    }
+  }
+  for (auto const& b : backends) b->Flush();
+}
+
+void FlushAtExit(std::shared_ptr<LogBackend> const& backend) {
+  static auto const kRegistered = std::atexit(FlushBackendsAtExit);
+  (void)kRegistered;
+  auto& registry = GetAtExitBackends();
+  std::lock_guard<std::mutex> lk(registry.mu);
+  auto& backends = registry.backends;
+  backends.erase(std::remove_if(backends.begin(), backends.end(),
+                                [](std::weak_ptr<LogBackend> const& w) {
+                                  return w.expired();
+                                }),
+                 backends.end());
+  backends.push_back(backend);
+}
+
 }  // namespace
 
 absl::optional<Severity> ParseSeverity(std::string const& name) {
@@ -85,9 +129,18 @@ std::ostream& operator<<(std::ostream& os, LogRecord const& rhs) {
             << ')';
 }
 
+struct LogSink::Snapshot {
+  using Backends = std::map<BackendId, std::shared_ptr<LogBackend>>;
+  internal::AtomicSharedPtr<Backends const> backends{
+      std::make_shared<Backends const>()};
+};
+
 LogSink::LogSink()
     : empty_(true),
-      minimum_severity_(static_cast<int>(Severity::GCP_LS_LOWEST_ENABLED)) {}
+      minimum_severity_(static_cast<int>(Severity::GCP_LS_LOWEST_ENABLED)),
+      snapshot_(std::make_unique<Snapshot>()) {}
+
+LogSink::~LogSink() = default;
 
 LogSink& LogSink::Instance() {
   static auto* const kInstance = [] {
@@ -114,7 +167,7 @@ void LogSink::ClearBackends() {
   std::unique_lock<std::mutex> lk(mu_);
   backends_.clear();
   default_backend_id_ = 0;
-  empty_.store(backends_.empty());
+  PublishBackends();
 }
 
 std::size_t LogSink::BackendCount() const {
@@ -123,24 +176,24 @@ std::size_t LogSink::BackendCount() const {
 }
 
 void LogSink::Log(LogRecord log_record) {
-  auto copy = CopyBackends();
-  if (copy.empty()) return;
+  auto backends = snapshot_->backends.load();
+  if (backends->empty()) return;
   // In general, we just give each backend a const-reference and the backends
   // must make a copy if needed.  But if there is only one backend we can give
   // the backend an opportunity to optimize things by transferring ownership of
   // the LogRecord to it.
-  if (copy.size() == 1) {
-    copy.begin()->second->ProcessWithOwnership(std::move(log_record));
+  if (backends->size() == 1) {
+    backends->begin()->second->ProcessWithOwnership(std::move(log_record));
     return;
   }
-  for (auto& kv : copy) {
+  for (auto const& kv : *backends) {
     kv.second->Process(log_record);
   }
 }
 
 void LogSink::Flush() {
-  auto copy = CopyBackends();
-  for (auto& kv : copy) kv.second->Flush();
+  auto backends = snapshot_->backends.load();
+  for (auto const& kv : *backends) kv.second->Flush();
 }
 
 void LogSink::EnableStdClogImpl(Severity min_severity) {
@@ -170,7 +223,7 @@ LogSink::BackendId LogSink::AddBackendImpl(
     std::shared_ptr<LogBackend> backend) {
   auto const id = ++next_id_;
   backends_.emplace(id, std::move(backend));
-  empty_.store(backends_.empty());
+  PublishBackends();
   return id;
 }
 
@@ -180,16 +233,17 @@ void LogSink::RemoveBackendImpl(BackendId id) {
     return;
   }
   backends_.erase(it);
-  empty_.store(backends_.empty());
+  PublishBackends();
 }
 
-// Make a copy of the backends because calling user-defined functions while
+// Publish a copy of the backends because calling user-defined functions while
 // holding a lock is a bad idea: the application may change the backends while
-// we are holding this lock, and soon deadlock occurs.
-std::map<LogSink::BackendId, std::shared_ptr<LogBackend>>
-LogSink::CopyBackends() {
-  std::lock_guard<std::mutex> lk(mu_);
-  return backends_;
+// we are holding this lock, and soon deadlock occurs. The copy is only made
+// when the backends change, not for each log record.
+void LogSink::PublishBackends() {
+  snapshot_->backends.store(
+      std::make_shared<Snapshot::Backends const>(backends_));
+  empty_.store(backends_.empty());
 }
 
 namespace internal {
@@ -220,6 +274,17 @@ std::shared_ptr<LogBackend> DefaultLogBackend() {
             std::make_shared<StdClogBackend>(min_severity));
       }
     }
+    if (fields[0] == "async" && fields.size() == 3) {
+      auto size = ParseSize(fields[1]);
+      auto min_flush_severity = ParseSeverity(fields[2]);
+      if (size.has_value() && min_flush_severity.has_value()) {
+        auto backend = std::make_shared<AsyncLogBackend>(
+            *size, *min_flush_severity,
+            std::make_shared<StdClogBackend>(min_severity));
+        FlushAtExit(backend);
+        return backend;
+      }
+    }
     if (fields[0] == "clog" && fields.size() == 1) {
       return std::make_shared<StdClogBackend>(min_severity);
     }
@@ -182,6 +182,7 @@ class LogBackend {
 class LogSink {
  public:
   LogSink();
+  ~LogSink();
 
   /// Return true if the severity is enabled at compile time.
   static bool constexpr CompileTimeEnabled(Severity level) {
@@ -281,7 +282,8 @@ class LogSink {
   BackendId AddBackendImpl(std::shared_ptr<LogBackend> backend);
   void RemoveBackendImpl(BackendId id);
 
-  std::map<BackendId, std::shared_ptr<LogBackend>> CopyBackends();
+  struct Snapshot;
+  void PublishBackends();
 
   std::atomic<bool> empty_;
   std::atomic<int> minimum_severity_;
@@ -289,6 +291,10 @@ class LogSink {
   BackendId next_id_ = 0;
   BackendId default_backend_id_ = 0;
   std::map<BackendId, std::shared_ptr<LogBackend>> backends_;
+  // An immutable copy of `backends_`, replaced on each change. `Log()` and
+  // `Flush()` use it without locking `mu_`, so logging threads never contend
+  // with each other on this mutex.
+  std::unique_ptr<Snapshot> snapshot_;
 };
 
 /**
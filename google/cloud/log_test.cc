@@ -230,6 +230,25 @@ TEST(LogSinkTest, ClogEnvironment) {
   testing::FLAGS_gtest_death_test_style = old_style;
 }
 
+TEST(LogSinkTest, AsyncEnvironment) {
+  // See the ClogEnvironment test for details on the death test style.
+  auto old_style = testing::FLAGS_gtest_death_test_style;
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+  // The record is below the flush severity, it is still buffered when the
+  // process exits.
+  ScopedEnvironment config(kLogConfig, "async,16,FATAL");
+  ScopedEnvironment env(kEnableClog, absl::nullopt);
+
+  auto f = [] {
+    GCP_LOG(INFO) << "testing async";
+    std::exit(42);
+  };
+  ASSERT_EXIT(f(), ExitedWithCode(42), HasSubstr("testing async"));
+
+  testing::FLAGS_gtest_death_test_style = old_style;
+}
+
 namespace {
 /// A class to count calls to IOStream operator.
 struct IOStreamCounter {
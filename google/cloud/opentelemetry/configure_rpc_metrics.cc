@@ -0,0 +1,57 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/opentelemetry/configure_rpc_metrics.h"
+#include "google/cloud/monitoring/v3/metric_connection.h"
+#include "google/cloud/opentelemetry/internal/rpc_metrics_exporter.h"
+#include "google/cloud/opentelemetry/monitoring_exporter.h"
+#include "google/cloud/opentelemetry/resource_detector.h"
+#include "google/cloud/opentelemetry_options.h"
+#include <algorithm>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace otel {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+Options ConfigureRpcMetrics(std::string service, Project project,
+                            Options options) {
+  auto const period =
+      options.has<RpcMetricsPeriodOption>()
+          ? std::max(options.get<RpcMetricsPeriodOption>(),
+                     std::chrono::seconds(5))
+          : std::chrono::seconds(60);
+  opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions
+      reader_options;
+  reader_options.export_interval_millis =
+      std::chrono::duration_cast<std::chrono::milliseconds>(period);
+  reader_options.export_timeout_millis =
+      std::min(reader_options.export_interval_millis / 2,
+               std::chrono::milliseconds(std::chrono::seconds(30)));
+
+  auto conn = monitoring_v3::MakeMetricServiceConnection(options);
+  auto exporter = otel_internal::MakeMonitoringExporter(
+      std::move(project), std::move(conn), options);
+  auto metrics = otel_internal::MakePeriodicRpcMetrics(
+      std::move(service), std::move(exporter), std::move(reader_options),
+      MakeResourceDetector()->Detect());
+  return Options{}.set<experimental::RpcMetricsOption>(
+      internal::MakeRpcMetricsHandle(std::move(metrics)));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace otel
+}  // namespace cloud
+}  // namespace google
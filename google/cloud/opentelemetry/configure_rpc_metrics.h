@@ -0,0 +1,85 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_OPENTELEMETRY_CONFIGURE_RPC_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_OPENTELEMETRY_CONFIGURE_RPC_METRICS_H
+
+#include "google/cloud/options.h"
+#include "google/cloud/project.h"
+#include "google/cloud/version.h"
+#include <chrono>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace otel {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Configure the client-side RPC metrics for a client library.
+ *
+ * Returns options with `experimental::RpcMetricsOption` set. Pass these
+ * options to the `Make*Connection(...)` factory functions, and the connections
+ * record the latency of each RPC attempt and operation, the server-side latency
+ * (when the service reports it), and the number of attempts in each operation.
+ *
+ * The metrics are exported to [Cloud Monitoring] in a background thread,
+ * every `RpcMetricsPeriodOption`. Exporting stops, after exporting the metrics
+ * one last time, once all the connections using these options are deleted.
+ *
+ * The metrics are labeled with @p service, the RPC method and the status code.
+ * Use a different call to this function for each service.
+ *
+ * @par Example
+ * @code
+ * #include <google/cloud/opentelemetry/configure_rpc_metrics.h>
+ *
+ * ...
+ *   auto options = google::cloud::otel::ConfigureRpcMetrics(
+ *       "spanner", google::cloud::Project([METRICS PROJECT]));
+ *   auto conn = google::cloud::spanner::MakeConnection(db, options);
+ * @endcode
+ *
+ * @warning This is an experimental feature, and subject to change without
+ *     notice.
+ *
+ * @param service the name of the service, used to label the metrics.
+ * @param project the project to send the metrics to.
+ * @param options how to configure the metrics. The configuration parameters
+ *     include `@ref RpcMetricsPeriodOption`,
+ *     `@ref google::cloud::UnifiedCredentialsOption`.
+ *
+ * [Cloud Monitoring]: https://cloud.google.com/monitoring
+ */
+Options ConfigureRpcMetrics(std::string service, Project project,
+                            Options options = {});
+
+/**
+ * Configure how often the RPC metrics are exported.
+ *
+ * The default is 60 seconds. Cloud Monitoring rejects data points written more
+ * often than every 5 seconds, shorter periods are rounded up.
+ *
+ * @see `@ref ConfigureRpcMetrics()` for more information.
+ */
+struct RpcMetricsPeriodOption {
+  using Type = std::chrono::seconds;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace otel
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_OPENTELEMETRY_CONFIGURE_RPC_METRICS_H
@@ -18,9 +18,11 @@
 
 google_cloud_cpp_opentelemetry_hdrs = [
     "configure_basic_tracing.h",
+    "configure_rpc_metrics.h",
     "internal/monitored_resource.h",
     "internal/recordable.h",
     "internal/resource_detector_impl.h",
+    "internal/rpc_metrics_exporter.h",
     "internal/time_series.h",
     "monitoring_exporter.h",
     "resource_detector.h",
@@ -29,9 +31,11 @@ google_cloud_cpp_opentelemetry_hdrs = [
 
 google_cloud_cpp_opentelemetry_srcs = [
     "configure_basic_tracing.cc",
+    "configure_rpc_metrics.cc",
     "internal/monitored_resource.cc",
     "internal/recordable.cc",
     "internal/resource_detector_impl.cc",
+    "internal/rpc_metrics_exporter.cc",
     "internal/time_series.cc",
     "monitoring_exporter.cc",
     "resource_detector.cc",
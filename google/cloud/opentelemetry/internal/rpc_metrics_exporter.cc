@@ -0,0 +1,186 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/opentelemetry/internal/rpc_metrics_exporter.h"
+#include "google/cloud/version.h"
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace otel_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using HistogramMember =
+    internal::RpcMetricsHistogramData internal::RpcMetricsPoint::*;
+
+struct HistogramDescriptor {
+  char const* name;
+  char const* description;
+  char const* unit;
+  HistogramMember member;
+};
+
+HistogramDescriptor const kHistograms[] = {
+    {"rpc.client.attempt_latency", "The latency of each RPC attempt.", "s",
+     &internal::RpcMetricsPoint::attempt_latency},
+    {"rpc.client.server_latency",
+     "The server-side latency of each RPC attempt, as reported by the service.",
+     "s", &internal::RpcMetricsPoint::server_latency},
+    {"rpc.client.operation_latency",
+     "The latency of each RPC operation, including retries and backoff.", "s",
+     &internal::RpcMetricsPoint::operation_latency},
+    {"rpc.client.attempt_count", "The number of attempts in each operation.",
+     "1", &internal::RpcMetricsPoint::attempt_count},
+};
+
+opentelemetry::sdk::metrics::PointDataAttributes ToPointData(
+    std::string const& service, internal::RpcMetricsPoint const& point,
+    internal::RpcMetricsHistogramData const& data) {
+  opentelemetry::sdk::metrics::HistogramPointData histogram;
+  histogram.boundaries_ = data.boundaries;
+  histogram.counts_ = data.counts;
+  histogram.sum_ = data.sum;
+  histogram.count_ = data.count;
+  histogram.record_min_max_ = false;
+
+  opentelemetry::sdk::metrics::PointDataAttributes pda;
+  pda.attributes.SetAttribute("rpc.service",
+                              opentelemetry::nostd::string_view(service));
+  pda.attributes.SetAttribute("rpc.method",
+                              opentelemetry::nostd::string_view(point.method));
+  auto const code = StatusCodeToString(point.code);
+  pda.attributes.SetAttribute("rpc.status_code",
+                              opentelemetry::nostd::string_view(code));
+  pda.point_data = std::move(histogram);
+  return pda;
+}
+
+}  // namespace
+
+std::vector<opentelemetry::sdk::metrics::MetricData> ToMetricData(
+    internal::RpcMetrics const& metrics,
+    std::chrono::system_clock::time_point end_time) {
+  auto const points = metrics.Collect();
+  std::vector<opentelemetry::sdk::metrics::MetricData> result;
+  for (auto const& h : kHistograms) {
+    opentelemetry::sdk::metrics::MetricData md;
+    md.instrument_descriptor.name_ = h.name;
+    md.instrument_descriptor.description_ = h.description;
+    md.instrument_descriptor.unit_ = h.unit;
+    md.instrument_descriptor.type_ =
+        opentelemetry::sdk::metrics::InstrumentType::kHistogram;
+    md.instrument_descriptor.value_type_ =
+        opentelemetry::sdk::metrics::InstrumentValueType::kDouble;
+    md.aggregation_temporality =
+        opentelemetry::sdk::metrics::AggregationTemporality::kCumulative;
+    md.start_ts = metrics.start_time();
+    md.end_ts = end_time;
+    for (auto const& p : points) {
+      auto const& data = p.*h.member;
+      if (data.count == 0) continue;
+      md.point_data_attr_.push_back(ToPointData(metrics.service(), p, data));
+    }
+    if (md.point_data_attr_.empty()) continue;
+    result.push_back(std::move(md));
+  }
+  return result;
+}
+
+RpcMetricsProducer::RpcMetricsProducer(
+    std::shared_ptr<internal::RpcMetrics> metrics,
+    opentelemetry::sdk::resource::Resource resource)
+    : metrics_(std::move(metrics)),
+      resource_(std::move(resource)),
+      scope_(opentelemetry::sdk::instrumentationscope::InstrumentationScope::
+                 Create("gl-cpp", version_string())) {}
+
+opentelemetry::sdk::metrics::ResourceMetrics RpcMetricsProducer::Snapshot()
+    const {
+  opentelemetry::sdk::metrics::ScopeMetrics sm;
+  sm.scope_ = scope_.get();
+  sm.metric_data_ = ToMetricData(*metrics_, std::chrono::system_clock::now());
+
+  opentelemetry::sdk::metrics::ResourceMetrics rm;
+  rm.resource_ = &resource_;
+  rm.scope_metric_data_.push_back(std::move(sm));
+  return rm;
+}
+
+#if OPENTELEMETRY_VERSION_MAJOR > 1 || \
+    (OPENTELEMETRY_VERSION_MAJOR == 1 && OPENTELEMETRY_VERSION_MINOR >= 16)
+RpcMetricsProducer::Result RpcMetricsProducer::Produce() noexcept {
+  return Result{Snapshot(), Status::kOk};
+}
+#else
+bool RpcMetricsProducer::Collect(
+    opentelemetry::nostd::function_ref<
+        bool(opentelemetry::sdk::metrics::ResourceMetrics&)>
+        callback) noexcept {
+  auto rm = Snapshot();
+  return callback(rm);
+}
+#endif
+
+RpcMetricsExporter::RpcMetricsExporter(
+    std::shared_ptr<internal::RpcMetrics> metrics,
+    std::unique_ptr<opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+    opentelemetry::sdk::resource::Resource resource)
+    : producer_(std::move(metrics), std::move(resource)),
+      exporter_(std::move(exporter)) {}
+
+opentelemetry::sdk::common::ExportResult RpcMetricsExporter::Export() {
+  return exporter_->Export(producer_.Snapshot());
+}
+
+PeriodicRpcMetricsExporter::PeriodicRpcMetricsExporter(
+    std::shared_ptr<internal::RpcMetrics> metrics,
+    std::unique_ptr<opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+    opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions
+        reader_options,
+    opentelemetry::sdk::resource::Resource resource)
+    : producer_(std::move(metrics), std::move(resource)),
+      reader_(std::make_unique<
+              opentelemetry::sdk::metrics::PeriodicExportingMetricReader>(
+          std::move(exporter), std::move(reader_options))) {
+  // This starts the background thread.
+  reader_->SetMetricProducer(&producer_);
+}
+
+PeriodicRpcMetricsExporter::~PeriodicRpcMetricsExporter() {
+  // Export any metrics recorded since the last period before stopping.
+  reader_->ForceFlush();
+  reader_->Shutdown();
+}
+
+std::shared_ptr<internal::RpcMetrics> MakePeriodicRpcMetrics(
+    std::string service,
+    std::unique_ptr<opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+    opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions
+        reader_options,
+    opentelemetry::sdk::resource::Resource resource) {
+  auto metrics = std::make_shared<internal::RpcMetrics>(std::move(service));
+  auto periodic = std::make_shared<PeriodicRpcMetricsExporter>(
+      metrics, std::move(exporter), std::move(reader_options),
+      std::move(resource));
+  // The exporter owns the metrics, and the returned pointer owns the exporter.
+  return std::shared_ptr<internal::RpcMetrics>(std::move(periodic),
+                                               metrics.get());
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace otel_internal
+}  // namespace cloud
+}  // namespace google
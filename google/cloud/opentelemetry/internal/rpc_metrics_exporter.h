@@ -0,0 +1,148 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_OPENTELEMETRY_INTERNAL_RPC_METRICS_EXPORTER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_OPENTELEMETRY_INTERNAL_RPC_METRICS_EXPORTER_H
+
+#include "google/cloud/internal/rpc_metrics.h"
+#include "google/cloud/version.h"
+#include <opentelemetry/sdk/instrumentationscope/instrumentation_scope.h>
+#include <opentelemetry/sdk/metrics/export/metric_producer.h>
+#include <opentelemetry/sdk/metrics/export/periodic_exporting_metric_reader.h>
+#include <opentelemetry/sdk/metrics/push_metric_exporter.h>
+#include <opentelemetry/sdk/resource/resource.h>
+#include <opentelemetry/version.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace otel_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Converts the client-side RPC metrics to the OpenTelemetry data model.
+ *
+ * Each `internal::RpcMetricsPoint` becomes one point, labeled with the service,
+ * method and status code, in each of the (cumulative) histograms:
+ * - `rpc.client.attempt_latency` (seconds)
+ * - `rpc.client.server_latency` (seconds)
+ * - `rpc.client.operation_latency` (seconds)
+ * - `rpc.client.attempt_count`
+ *
+ * Histograms without any values are omitted.
+ */
+std::vector<opentelemetry::sdk::metrics::MetricData> ToMetricData(
+    internal::RpcMetrics const& metrics,
+    std::chrono::system_clock::time_point end_time);
+
+/**
+ * Produces the client-side RPC metrics for an OpenTelemetry `MetricReader`.
+ *
+ * The metrics are aggregated each time the reader collects them.
+ */
+class RpcMetricsProducer : public opentelemetry::sdk::metrics::MetricProducer {
+ public:
+  RpcMetricsProducer(std::shared_ptr<internal::RpcMetrics> metrics,
+                     opentelemetry::sdk::resource::Resource resource);
+
+  /// Aggregates the metrics. The result refers to data owned by `*this`.
+  opentelemetry::sdk::metrics::ResourceMetrics Snapshot() const;
+
+#if OPENTELEMETRY_VERSION_MAJOR > 1 || \
+    (OPENTELEMETRY_VERSION_MAJOR == 1 && OPENTELEMETRY_VERSION_MINOR >= 16)
+  Result Produce() noexcept override;
+#else
+  bool Collect(opentelemetry::nostd::function_ref<
+               bool(opentelemetry::sdk::metrics::ResourceMetrics&)>
+                   callback) noexcept override;
+#endif
+
+ private:
+  std::shared_ptr<internal::RpcMetrics> metrics_;
+  opentelemetry::sdk::resource::Resource resource_;
+  std::unique_ptr<
+      opentelemetry::sdk::instrumentationscope::InstrumentationScope>
+      scope_;
+};
+
+/**
+ * Exports the client-side RPC metrics using an OpenTelemetry exporter.
+ *
+ * Typically the exporter is created with `MakeMonitoringExporter()`. The
+ * metrics are aggregated on each call to `Export()`.
+ */
+class RpcMetricsExporter {
+ public:
+  RpcMetricsExporter(
+      std::shared_ptr<internal::RpcMetrics> metrics,
+      std::unique_ptr<opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+      opentelemetry::sdk::resource::Resource resource);
+
+  opentelemetry::sdk::common::ExportResult Export();
+
+ private:
+  RpcMetricsProducer producer_;
+  std::unique_ptr<opentelemetry::sdk::metrics::PushMetricExporter> exporter_;
+};
+
+/**
+ * Exports the client-side RPC metrics periodically, in a background thread.
+ *
+ * This connects a `RpcMetricsProducer` to a `PeriodicExportingMetricReader`.
+ * The destructor exports the metrics one last time, and then stops the
+ * background thread.
+ */
+class PeriodicRpcMetricsExporter {
+ public:
+  PeriodicRpcMetricsExporter(
+      std::shared_ptr<internal::RpcMetrics> metrics,
+      std::unique_ptr<opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+      opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions
+          reader_options,
+      opentelemetry::sdk::resource::Resource resource);
+  ~PeriodicRpcMetricsExporter();
+
+  PeriodicRpcMetricsExporter(PeriodicRpcMetricsExporter const&) = delete;
+  PeriodicRpcMetricsExporter& operator=(PeriodicRpcMetricsExporter const&) =
+      delete;
+
+ private:
+  RpcMetricsProducer producer_;
+  std::unique_ptr<opentelemetry::sdk::metrics::PeriodicExportingMetricReader>
+      reader_;
+};
+
+/**
+ * Returns metrics exported periodically. Use `internal::MakeRpcMetricsHandle()`
+ * to wrap them in a value for `experimental::RpcMetricsOption`.
+ *
+ * The returned pointer owns the exporter. The metrics are exported until all
+ * the copies of the pointer, typically held by the connections, are released.
+ */
+std::shared_ptr<internal::RpcMetrics> MakePeriodicRpcMetrics(
+    std::string service,
+    std::unique_ptr<opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+    opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions
+        reader_options,
+    opentelemetry::sdk::resource::Resource resource);
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace otel_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_OPENTELEMETRY_INTERNAL_RPC_METRICS_EXPORTER_H
@@ -0,0 +1,161 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/opentelemetry/internal/rpc_metrics_exporter.h"
+#include <gmock/gmock.h>
+#include <opentelemetry/sdk/resource/resource.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace otel_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+namespace metrics_sdk = ::opentelemetry::sdk::metrics;
+using ::testing::Contains;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+std::string Attribute(metrics_sdk::PointDataAttributes const& pda,
+                      std::string const& key) {
+  auto l = pda.attributes.find(key);
+  if (l == pda.attributes.end()) return {};
+  return opentelemetry::nostd::get<std::string>(l->second);
+}
+
+std::vector<std::string> Names(
+    std::vector<metrics_sdk::MetricData> const& data) {
+  std::vector<std::string> names;
+  for (auto const& md : data) names.push_back(md.instrument_descriptor.name_);
+  return names;
+}
+
+TEST(RpcMetricsExporter, ToMetricDataEmpty) {
+  internal::RpcMetrics metrics("test-service");
+  EXPECT_THAT(ToMetricData(metrics, std::chrono::system_clock::now()),
+              IsEmpty());
+}
+
+TEST(RpcMetricsExporter, ToMetricData) {
+  internal::RpcMetrics metrics("test-service");
+  metrics.RecordAttempt("Method", StatusCode::kUnavailable,
+                        std::chrono::milliseconds(3));
+  metrics.RecordAttempt("Method", StatusCode::kOk,
+                        std::chrono::milliseconds(5));
+  metrics.RecordOperation("Method", StatusCode::kOk,
+                          std::chrono::milliseconds(20), 2);
+
+  auto const end = std::chrono::system_clock::now();
+  auto data = ToMetricData(metrics, end);
+  // There are no server latency values, the histogram is skipped.
+  ASSERT_THAT(Names(data), ElementsAre("rpc.client.attempt_latency",
+                                       "rpc.client.operation_latency",
+                                       "rpc.client.attempt_count"));
+  for (auto const& md : data) {
+    EXPECT_EQ(md.instrument_descriptor.type_,
+              metrics_sdk::InstrumentType::kHistogram);
+    EXPECT_EQ(md.aggregation_temporality,
+              metrics_sdk::AggregationTemporality::kCumulative);
+    EXPECT_EQ(md.start_ts.time_since_epoch(),
+              metrics.start_time().time_since_epoch());
+    EXPECT_EQ(md.end_ts.time_since_epoch(), end.time_since_epoch());
+  }
+  EXPECT_EQ(data[0].instrument_descriptor.unit_, "s");
+  EXPECT_EQ(data[2].instrument_descriptor.unit_, "1");
+
+  auto const& attempts = data[0].point_data_attr_;
+  ASSERT_THAT(attempts, SizeIs(2));
+  EXPECT_EQ(Attribute(attempts[0], "rpc.service"), "test-service");
+  EXPECT_EQ(Attribute(attempts[0], "rpc.method"), "Method");
+  EXPECT_EQ(Attribute(attempts[0], "rpc.status_code"), "OK");
+  EXPECT_EQ(Attribute(attempts[1], "rpc.status_code"), "UNAVAILABLE");
+
+  auto const& h =
+      opentelemetry::nostd::get<metrics_sdk::HistogramPointData>(
+          data[1].point_data_attr_.at(0).point_data);
+  EXPECT_EQ(h.count_, 1);
+  EXPECT_DOUBLE_EQ(opentelemetry::nostd::get<double>(h.sum_), 0.020);
+  EXPECT_EQ(h.counts_.size(), h.boundaries_.size() + 1);
+}
+
+class FakeExporter : public metrics_sdk::PushMetricExporter {
+ public:
+  explicit FakeExporter(std::vector<std::string>& names) : names_(names) {}
+
+  opentelemetry::sdk::common::ExportResult Export(
+      metrics_sdk::ResourceMetrics const& data) noexcept override {
+    for (auto const& sm : data.scope_metric_data_) {
+      for (auto const& md : sm.metric_data_) {
+        names_.push_back(md.instrument_descriptor.name_);
+      }
+    }
+    return opentelemetry::sdk::common::ExportResult::kSuccess;
+  }
+
+  metrics_sdk::AggregationTemporality GetAggregationTemporality(
+      metrics_sdk::InstrumentType) const noexcept override {
+    return metrics_sdk::AggregationTemporality::kCumulative;
+  }
+
+  bool ForceFlush(std::chrono::microseconds) noexcept override { return true; }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+ private:
+  std::vector<std::string>& names_;
+};
+
+TEST(RpcMetricsExporter, Export) {
+  auto metrics = std::make_shared<internal::RpcMetrics>("test-service");
+  metrics->RecordAttempt("Method", StatusCode::kOk,
+                         std::chrono::milliseconds(5));
+
+  std::vector<std::string> names;
+  RpcMetricsExporter exporter(
+      metrics, std::make_unique<FakeExporter>(names),
+      opentelemetry::sdk::resource::Resource::Create({}));
+  EXPECT_EQ(exporter.Export(),
+            opentelemetry::sdk::common::ExportResult::kSuccess);
+  EXPECT_THAT(names, ElementsAre("rpc.client.attempt_latency"));
+}
+
+TEST(RpcMetricsExporter, PeriodicExportOnRelease) {
+  std::vector<std::string> names;
+  metrics_sdk::PeriodicExportingMetricReaderOptions reader_options;
+  reader_options.export_interval_millis = std::chrono::hours(1);
+  reader_options.export_timeout_millis = std::chrono::seconds(30);
+  auto metrics = MakePeriodicRpcMetrics(
+      "test-service", std::make_unique<FakeExporter>(names),
+      std::move(reader_options),
+      opentelemetry::sdk::resource::Resource::Create({}));
+  ASSERT_NE(metrics, nullptr);
+  EXPECT_EQ(metrics->service(), "test-service");
+  metrics->RecordAttempt("Method", StatusCode::kOk,
+                         std::chrono::milliseconds(5));
+
+  // Releasing the last copy exports the metrics one last time.
+  metrics.reset();
+  EXPECT_THAT(names, Contains("rpc.client.attempt_latency"));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace otel_internal
+}  // namespace cloud
+}  // namespace google
@@ -20,6 +20,7 @@ opentelemetry_unit_tests = [
     "internal/monitored_resource_test.cc",
     "internal/recordable_test.cc",
     "internal/resource_detector_impl_test.cc",
+    "internal/rpc_metrics_exporter_test.cc",
     "internal/time_series_test.cc",
     "monitoring_exporter_test.cc",
     "trace_exporter_test.cc",
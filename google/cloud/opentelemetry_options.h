@@ -16,10 +16,22 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_OPENTELEMETRY_OPTIONS_H
 
 #include "google/cloud/version.h"
+#include <memory>
+#include <utility>
 
 namespace google {
 namespace cloud {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace experimental {
+class RpcMetricsHandle;
+}  // namespace experimental
+namespace internal {
+class RpcMetrics;
+experimental::RpcMetricsHandle MakeRpcMetricsHandle(
+    std::shared_ptr<RpcMetrics> impl);
+std::shared_ptr<RpcMetrics> const& GetRpcMetrics(
+    experimental::RpcMetricsHandle const& handle);
+}  // namespace internal
 
 /**
  * Enables tracing with [OpenTelemetry]
@@ -81,7 +93,75 @@ struct OpenTelemetryTracingOption {
 namespace experimental {
 /// @deprecated Use google::cloud::OpenTelemetryTracingOption instead.
 using OpenTelemetryTracingOption = ::google::cloud::OpenTelemetryTracingOption;
+
+/**
+ * An opaque handle to the client-side RPC metrics.
+ *
+ * Applications do not create handles directly, the value returned by
+ * `google::cloud::otel::ConfigureRpcMetrics()` contains one. A
+ * default-constructed handle does not record any metrics. Copies of a handle
+ * share the same metrics.
+ *
+ * @warning This is an experimental feature, and subject to change without
+ *     notice.
+ */
+class RpcMetricsHandle {
+ public:
+  RpcMetricsHandle() = default;
+
+ private:
+  friend RpcMetricsHandle internal::MakeRpcMetricsHandle(
+      std::shared_ptr<internal::RpcMetrics> impl);
+  friend std::shared_ptr<internal::RpcMetrics> const& internal::GetRpcMetrics(
+      RpcMetricsHandle const& handle);
+  std::shared_ptr<internal::RpcMetrics> impl_;
+};
+
+/**
+ * Enables client-side RPC metrics.
+ *
+ * If set, the client library records the latency of each RPC attempt and
+ * operation, the server-side latency (when the service reports it), and the
+ * number of attempts in each operation.
+ *
+ * Applications do not create the value directly. Use
+ * `google::cloud::otel::ConfigureRpcMetrics()` to create options with this
+ * option set, and to periodically export the metrics to [Cloud Monitoring].
+ *
+ * The metrics cover the unary RPCs made by gRPC-based clients, including the
+ * RPCs to start and poll long-running operations. Streaming RPCs are not
+ * covered.
+ *
+ * This option must be provided to the `Make*Connection(...)` factory
+ * functions. It does not have an effect when passed to a client's constructor.
+ *
+ * @warning This is an experimental feature, and subject to change without
+ *     notice.
+ *
+ * @ingroup options
+ *
+ * [Cloud Monitoring]: https://cloud.google.com/monitoring
+ */
+struct RpcMetricsOption {
+  using Type = RpcMetricsHandle;
+};
 }  // namespace experimental
+
+namespace internal {
+
+inline experimental::RpcMetricsHandle MakeRpcMetricsHandle(
+    std::shared_ptr<RpcMetrics> impl) {
+  experimental::RpcMetricsHandle handle;
+  handle.impl_ = std::move(impl);
+  return handle;
+}
+
+inline std::shared_ptr<RpcMetrics> const& GetRpcMetrics(
+    experimental::RpcMetricsHandle const& handle) {
+  return handle.impl_;
+}
+
+}  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
 }  // namespace google
@@ -22,6 +22,7 @@ google_cloud_cpp_pubsublite_hdrs = [
     "admin_connection_idempotency_policy.h",
     "admin_options.h",
     "endpoint.h",
+    "internal/ack_set_tracker.h",
     "internal/admin_auth_decorator.h",
     "internal/admin_connection_impl.h",
     "internal/admin_logging_decorator.h",
@@ -34,9 +35,11 @@ google_cloud_cpp_pubsublite_hdrs = [
     "internal/admin_tracing_stub.h",
     "internal/alarm_registry.h",
     "internal/alarm_registry_impl.h",
+    "internal/assigning_subscriber.h",
     "internal/batching_options.h",
     "internal/cloud_region.h",
     "internal/cloud_zone.h",
+    "internal/committer.h",
     "internal/cursor_auth_decorator.h",
     "internal/cursor_logging_decorator.h",
     "internal/cursor_metadata_decorator.h",
@@ -45,6 +48,7 @@ google_cloud_cpp_pubsublite_hdrs = [
     "internal/cursor_tracing_stub.h",
     "internal/default_publish_message_transformer.h",
     "internal/default_routing_policy.h",
+    "internal/default_subscribe_message_transformer.h",
     "internal/futures.h",
     "internal/location.h",
     "internal/multipartition_publisher.h",
@@ -54,7 +58,9 @@ google_cloud_cpp_pubsublite_hdrs = [
     "internal/partition_assignment_stub.h",
     "internal/partition_assignment_stub_factory.h",
     "internal/partition_assignment_tracing_stub.h",
+    "internal/partition_callback_sequencer.h",
     "internal/partition_publisher.h",
+    "internal/partition_subscriber.h",
     "internal/publisher.h",
     "internal/publisher_auth_decorator.h",
     "internal/publisher_connection_impl.h",
@@ -70,6 +76,7 @@ google_cloud_cpp_pubsublite_hdrs = [
     "internal/stream_factory.h",
     "internal/stream_retry_policy.h",
     "internal/subscriber_auth_decorator.h",
+    "internal/subscriber_connection_impl.h",
     "internal/subscriber_logging_decorator.h",
     "internal/subscriber_metadata_decorator.h",
     "internal/subscriber_stub.h",
@@ -88,6 +95,8 @@ google_cloud_cpp_pubsublite_hdrs = [
     "message_metadata.h",
     "options.h",
     "publisher_connection.h",
+    "subscriber_connection.h",
+    "subscription.h",
     "topic.h",
     "topic_stats_client.h",
     "topic_stats_connection.h",
@@ -100,6 +109,7 @@ google_cloud_cpp_pubsublite_srcs = [
     "admin_connection.cc",
     "admin_connection_idempotency_policy.cc",
     "endpoint.cc",
+    "internal/ack_set_tracker.cc",
     "internal/admin_auth_decorator.cc",
     "internal/admin_connection_impl.cc",
     "internal/admin_logging_decorator.cc",
@@ -110,8 +120,10 @@ google_cloud_cpp_pubsublite_srcs = [
     "internal/admin_tracing_connection.cc",
     "internal/admin_tracing_stub.cc",
     "internal/alarm_registry_impl.cc",
+    "internal/assigning_subscriber.cc",
     "internal/cloud_region.cc",
     "internal/cloud_zone.cc",
+    "internal/committer.cc",
     "internal/cursor_auth_decorator.cc",
     "internal/cursor_logging_decorator.cc",
     "internal/cursor_metadata_decorator.cc",
@@ -120,6 +132,7 @@ google_cloud_cpp_pubsublite_srcs = [
     "internal/cursor_tracing_stub.cc",
     "internal/default_publish_message_transformer.cc",
     "internal/default_routing_policy.cc",
+    "internal/default_subscribe_message_transformer.cc",
     "internal/location.cc",
     "internal/multipartition_publisher.cc",
     "internal/partition_assignment_auth_decorator.cc",
@@ -128,7 +141,9 @@ google_cloud_cpp_pubsublite_srcs = [
     "internal/partition_assignment_stub.cc",
     "internal/partition_assignment_stub_factory.cc",
     "internal/partition_assignment_tracing_stub.cc",
+    "internal/partition_callback_sequencer.cc",
     "internal/partition_publisher.cc",
+    "internal/partition_subscriber.cc",
     "internal/publisher_auth_decorator.cc",
     "internal/publisher_connection_impl.cc",
     "internal/publisher_logging_decorator.cc",
@@ -137,6 +152,7 @@ google_cloud_cpp_pubsublite_srcs = [
     "internal/publisher_stub_factory.cc",
     "internal/publisher_tracing_stub.cc",
     "internal/subscriber_auth_decorator.cc",
+    "internal/subscriber_connection_impl.cc",
     "internal/subscriber_logging_decorator.cc",
     "internal/subscriber_metadata_decorator.cc",
     "internal/subscriber_stub.cc",
@@ -153,6 +169,7 @@ google_cloud_cpp_pubsublite_srcs = [
     "internal/topic_stats_tracing_stub.cc",
     "message_metadata.cc",
     "publisher_connection.cc",
+    "subscriber_connection.cc",
     "topic_stats_client.cc",
     "topic_stats_connection.cc",
     "topic_stats_connection_idempotency_policy.cc",
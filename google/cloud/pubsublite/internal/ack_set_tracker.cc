@@ -0,0 +1,60 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/ack_set_tracker.h"
+#include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/internal/make_status.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsublite::v1::Cursor;
+
+Status AckSetTracker::Track(std::int64_t offset) {
+  if (!receipts_.empty() && offset <= receipts_.back()) {
+    return internal::FailedPreconditionError(
+        absl::StrCat("Tracked message offsets must increase, got ", offset,
+                     " after ", receipts_.back()),
+        GCP_ERROR_INFO());
+  }
+  receipts_.push_back(offset);
+  return Status{};
+}
+
+absl::optional<Cursor> AckSetTracker::Ack(std::int64_t offset) {
+  // Acks for unknown, or already acked, messages are ignored.
+  if (!std::binary_search(receipts_.begin(), receipts_.end(), offset)) {
+    return absl::nullopt;
+  }
+  acks_.insert(offset);
+  absl::optional<std::int64_t> last;
+  while (!receipts_.empty() && !acks_.empty() &&
+         receipts_.front() == *acks_.begin()) {
+    last = receipts_.front();
+    receipts_.pop_front();
+    acks_.erase(acks_.begin());
+  }
+  if (!last) return absl::nullopt;
+  Cursor cursor;
+  cursor.set_offset(*last + 1);
+  return cursor;
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
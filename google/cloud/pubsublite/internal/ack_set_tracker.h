@@ -0,0 +1,58 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_ACK_SET_TRACKER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_ACK_SET_TRACKER_H
+
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <google/cloud/pubsublite/v1/common.pb.h>
+#include <cstdint>
+#include <deque>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Computes the cursor to commit as the messages in a partition are acked.
+ *
+ * Applications may ack messages in any order. The cursor only moves past a
+ * message once it, and all the messages delivered before it, are acked.
+ *
+ * @note This class is not thread-safe, callers must serialize access.
+ */
+class AckSetTracker {
+ public:
+  /// Records a delivered message, offsets must be strictly increasing.
+  Status Track(std::int64_t offset);
+
+  /// Returns the new cursor to commit, if acking @p offset advanced it.
+  absl::optional<google::cloud::pubsublite::v1::Cursor> Ack(
+      std::int64_t offset);
+
+ private:
+  std::deque<std::int64_t> receipts_;
+  std::set<std::int64_t> acks_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_ACK_SET_TRACKER_H
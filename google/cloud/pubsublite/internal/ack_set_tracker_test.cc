@@ -0,0 +1,73 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/ack_set_tracker.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::Optional;
+using ::testing::Property;
+
+auto CursorOffset(std::int64_t offset) {
+  return Optional(Property(&google::cloud::pubsublite::v1::Cursor::offset,
+                           offset));
+}
+
+TEST(AckSetTrackerTest, InOrderAcks) {
+  AckSetTracker tracker;
+  ASSERT_STATUS_OK(tracker.Track(10));
+  ASSERT_STATUS_OK(tracker.Track(11));
+  EXPECT_THAT(tracker.Ack(10), CursorOffset(11));
+  EXPECT_THAT(tracker.Ack(11), CursorOffset(12));
+}
+
+TEST(AckSetTrackerTest, OutOfOrderAcks) {
+  AckSetTracker tracker;
+  ASSERT_STATUS_OK(tracker.Track(1));
+  ASSERT_STATUS_OK(tracker.Track(3));
+  ASSERT_STATUS_OK(tracker.Track(5));
+  EXPECT_EQ(tracker.Ack(5), absl::nullopt);
+  EXPECT_EQ(tracker.Ack(3), absl::nullopt);
+  EXPECT_THAT(tracker.Ack(1), CursorOffset(6));
+}
+
+TEST(AckSetTrackerTest, UnknownAcksIgnored) {
+  AckSetTracker tracker;
+  ASSERT_STATUS_OK(tracker.Track(5));
+  ASSERT_STATUS_OK(tracker.Track(7));
+  EXPECT_EQ(tracker.Ack(6), absl::nullopt);
+  EXPECT_THAT(tracker.Ack(5), CursorOffset(6));
+  EXPECT_EQ(tracker.Ack(5), absl::nullopt);
+  EXPECT_THAT(tracker.Ack(7), CursorOffset(8));
+}
+
+TEST(AckSetTrackerTest, OffsetsMustIncrease) {
+  AckSetTracker tracker;
+  ASSERT_STATUS_OK(tracker.Track(5));
+  EXPECT_THAT(tracker.Track(5), StatusIs(StatusCode::kFailedPrecondition));
+  EXPECT_THAT(tracker.Track(4), StatusIs(StatusCode::kFailedPrecondition));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
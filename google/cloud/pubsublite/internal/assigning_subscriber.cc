@@ -0,0 +1,195 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/assigning_subscriber.h"
+#include <set>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsublite::v1::InitialPartitionAssignmentRequest;
+using google::cloud::pubsublite::v1::PartitionAssignment;
+using google::cloud::pubsublite::v1::PartitionAssignmentRequest;
+
+AssigningSubscriber::AssigningSubscriber(
+    absl::FunctionRef<std::unique_ptr<ResumableStream>(
+        StreamInitializer<PartitionAssignmentRequest, PartitionAssignment>)>
+        resumable_stream_factory,
+    PartitionSubscriberFactory subscriber_factory,
+    InitialPartitionAssignmentRequest initial_request)
+    : subscriber_factory_{std::move(subscriber_factory)},
+      initial_request_{std::move(initial_request)},
+      resumable_stream_{resumable_stream_factory(
+          [this](ResumableStreamImpl::UnderlyingStream stream) {
+            return Initializer(std::move(stream));
+          })},
+      service_composite_{resumable_stream_.get()} {}
+
+AssigningSubscriber::~AssigningSubscriber() {
+  future<void> shutdown = Shutdown();
+  if (!shutdown.is_ready()) {
+    GCP_LOG(WARNING) << "`Shutdown` must be called and finished before object "
+                        "goes out of scope.";
+  }
+  shutdown.get();
+}
+
+future<Status> AssigningSubscriber::Start() {
+  auto start_return = service_composite_.Start();
+  OnReadStart();
+  Read();
+  return start_return;
+}
+
+future<void> AssigningSubscriber::Shutdown() {
+  std::map<std::int64_t, std::shared_ptr<Service>> partitions;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    shutdown_ = true;
+    partitions.swap(partitions_);
+  }
+  future<void> shutdown = service_composite_.Shutdown();
+  for (auto& kv : partitions) {
+    shutdown = shutdown.then(ChainFuture(kv.second->Shutdown()));
+  }
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    if (reading_) {
+      shutdown = shutdown.then(ChainFuture(reading_->get_future()));
+    }
+  }
+  // Keep the partition subscribers alive until they finish shutting down.
+  return shutdown.then([partitions](future<void>) {});
+}
+
+void AssigningSubscriber::Read() {
+  AsyncRoot root;
+  if (!service_composite_.status().ok()) return OnReadEnd();
+  // need lock because calling `resumable_stream_->Read()`
+  std::lock_guard<std::mutex> g{mu_};
+  root.get_future()
+      .then(ChainFuture(resumable_stream_->Read()))
+      .then([this](future<absl::optional<PartitionAssignment>> assignment) {
+        OnRead(assignment.get());
+      });
+}
+
+void AssigningSubscriber::OnRead(
+    absl::optional<PartitionAssignment> assignment) {
+  // optional not engaged implies that the retry loop has finished
+  if (!assignment) return Read();
+
+  std::set<std::int64_t> const assigned{assignment->partitions().begin(),
+                                        assignment->partitions().end()};
+  std::vector<std::int64_t> added;
+  std::vector<std::shared_ptr<Service>> removed;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    for (auto i = partitions_.begin(); i != partitions_.end();) {
+      if (assigned.count(i->first) != 0) {
+        ++i;
+        continue;
+      }
+      removed.push_back(std::move(i->second));
+      i = partitions_.erase(i);
+    }
+    for (auto p : assigned) {
+      if (partitions_.count(p) == 0) added.push_back(p);
+    }
+  }
+
+  std::vector<std::shared_ptr<Service>> subscribers;
+  for (auto p : added) subscribers.push_back(subscriber_factory_(p));
+  std::vector<future<Status>> started;
+  {
+    // Under lock to guarantee that `Shutdown()` is called on every started
+    // subscriber.
+    std::lock_guard<std::mutex> g{mu_};
+    if (!shutdown_) {
+      for (std::size_t i = 0; i != added.size(); ++i) {
+        partitions_.emplace(added[i], subscribers[i]);
+        started.push_back(subscribers[i]->Start());
+      }
+    }
+  }
+  for (auto& f : started) {
+    f.then([this](future<Status> status_future) {
+      Status s = status_future.get();
+      if (!s.ok()) service_composite_.Abort(std::move(s));
+    });
+  }
+
+  // The service expects the removed partitions to stop receiving messages
+  // before the assignment is acknowledged.
+  future<void> removed_done = make_ready_future();
+  for (auto& s : removed) {
+    removed_done = removed_done.then(ChainFuture(s->Shutdown()));
+  }
+  removed_done.then([this, removed](future<void>) {
+    PartitionAssignmentRequest request;
+    request.mutable_ack();
+    AsyncRoot root;
+    // need lock because calling `resumable_stream_->Write()`
+    std::lock_guard<std::mutex> g{mu_};
+    root.get_future()
+        .then(ChainFuture(resumable_stream_->Write(request)))
+        // If the write fails the service sends a new assignment on the
+        // resumed stream.
+        .then([this](future<bool>) { Read(); });
+  });
+}
+
+void AssigningSubscriber::OnReadStart() {
+  std::lock_guard<std::mutex> g{mu_};
+  if (!reading_) reading_.emplace();
+}
+
+void AssigningSubscriber::OnReadEnd() {
+  absl::optional<promise<void>> read_done;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    read_done.swap(reading_);
+  }
+  if (read_done) read_done->set_value();
+}
+
+future<StatusOr<AssigningSubscriber::ResumableStreamImpl::UnderlyingStream>>
+AssigningSubscriber::Initializer(ResumableStreamImpl::UnderlyingStream stream) {
+  auto shared_stream = std::make_shared<ResumableStreamImpl::UnderlyingStream>(
+      std::move(stream));
+  PartitionAssignmentRequest request;
+  *request.mutable_initial() = initial_request_;
+  // The service does not respond to the initial request, the first response
+  // is the initial assignment.
+  return (*shared_stream)
+      ->Write(request, grpc::WriteOptions())
+      .then([shared_stream](future<bool> write_response) {
+        if (write_response.get()) return make_ready_future(Status());
+        return (*shared_stream)->Finish();
+      })
+      .then([shared_stream](future<Status> f)
+                -> StatusOr<ResumableStreamImpl::UnderlyingStream> {
+        Status status = f.get();
+        if (!status.ok()) return status;
+        return std::move(*shared_stream);
+      });
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
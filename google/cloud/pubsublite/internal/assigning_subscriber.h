@@ -0,0 +1,103 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_ASSIGNING_SUBSCRIBER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_ASSIGNING_SUBSCRIBER_H
+
+#include "google/cloud/pubsublite/internal/resumable_async_streaming_read_write_rpc.h"
+#include "google/cloud/pubsublite/internal/service_composite.h"
+#include "absl/functional/function_ref.h"
+#include <google/cloud/pubsublite/v1/subscriber.pb.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Subscribes to the partitions assigned to this client.
+ *
+ * The service balances the partitions of a subscription across all the clients
+ * connected to the `AssignPartitions` stream. On each new assignment this
+ * class starts a subscriber for each added partition and shuts down the
+ * subscribers for the removed partitions, before acknowledging the assignment.
+ *
+ * If any of the partition subscribers fails this class is aborted with the same
+ * status.
+ */
+class AssigningSubscriber : public Service {
+ private:
+  using ResumableStream = ResumableAsyncStreamingReadWriteRpc<
+      google::cloud::pubsublite::v1::PartitionAssignmentRequest,
+      google::cloud::pubsublite::v1::PartitionAssignment>;
+  using ResumableStreamImpl = ResumableAsyncStreamingReadWriteRpcImpl<
+      google::cloud::pubsublite::v1::PartitionAssignmentRequest,
+      google::cloud::pubsublite::v1::PartitionAssignment>;
+
+ public:
+  using PartitionSubscriberFactory =
+      std::function<std::shared_ptr<Service>(std::int64_t)>;
+
+  AssigningSubscriber(
+      absl::FunctionRef<std::unique_ptr<ResumableStream>(StreamInitializer<
+          google::cloud::pubsublite::v1::PartitionAssignmentRequest,
+          google::cloud::pubsublite::v1::PartitionAssignment>)>,
+      PartitionSubscriberFactory subscriber_factory,
+      google::cloud::pubsublite::v1::InitialPartitionAssignmentRequest);
+
+  ~AssigningSubscriber() override;
+
+  future<Status> Start() override;
+
+  future<void> Shutdown() override;
+
+ private:
+  void Read();
+
+  void OnRead(absl::optional<google::cloud::pubsublite::v1::PartitionAssignment>
+                  assignment);
+
+  void OnReadStart();
+
+  void OnReadEnd();
+
+  future<StatusOr<ResumableStreamImpl::UnderlyingStream>> Initializer(
+      ResumableStreamImpl::UnderlyingStream stream);
+
+  PartitionSubscriberFactory const subscriber_factory_;
+  google::cloud::pubsublite::v1::InitialPartitionAssignmentRequest const
+      initial_request_;
+
+  std::mutex mu_;
+
+  std::unique_ptr<ResumableStream> const
+      resumable_stream_;  // ABSL_GUARDED_BY(mu_)
+  ServiceComposite service_composite_;
+  std::map<std::int64_t, std::shared_ptr<Service>>
+      partitions_;                         // ABSL_GUARDED_BY(mu_)
+  bool shutdown_ = false;                  // ABSL_GUARDED_BY(mu_)
+  absl::optional<promise<void>> reading_;  // ABSL_GUARDED_BY(mu_)
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_ASSIGNING_SUBSCRIBER_H
@@ -0,0 +1,219 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsublite/internal/assigning_subscriber.h"
+#include "google/cloud/mocks/mock_async_streaming_read_write_rpc.h"
+#include "google/cloud/pubsublite/testing/mock_resumable_async_reader_writer_stream.h"
+#include "google/cloud/pubsublite/testing/mock_service.h"
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsublite::v1::InitialPartitionAssignmentRequest;
+using google::cloud::pubsublite::v1::PartitionAssignment;
+using google::cloud::pubsublite::v1::PartitionAssignmentRequest;
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::IsProtoEqual;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::_;
+using ::testing::ByMove;
+using ::testing::MockFunction;
+using ::testing::Return;
+using ::testing::StrictMock;
+
+using ::google::cloud::pubsublite_testing::MockResumableAsyncReaderWriter;
+using ::google::cloud::pubsublite_testing::MockService;
+
+using AsyncReaderWriter = google::cloud::mocks::MockAsyncStreamingReadWriteRpc<
+    PartitionAssignmentRequest, PartitionAssignment>;
+
+using ReadResponse = absl::optional<PartitionAssignment>;
+
+InitialPartitionAssignmentRequest MakeInitialRequest() {
+  InitialPartitionAssignmentRequest request;
+  request.set_subscription(
+      "projects/test-project/locations/us-central1-a/subscriptions/test-sub");
+  request.set_client_id("test-client-id");
+  return request;
+}
+
+ReadResponse Assignment(std::vector<std::int64_t> const& partitions) {
+  PartitionAssignment assignment;
+  for (auto p : partitions) assignment.add_partitions(p);
+  return assignment;
+}
+
+PartitionAssignmentRequest AckRequest() {
+  PartitionAssignmentRequest request;
+  request.mutable_ack();
+  return request;
+}
+
+class AssigningSubscriberTest : public ::testing::Test {
+ protected:
+  AssigningSubscriberTest()
+      : resumable_stream_ref_{
+            *(new StrictMock<MockResumableAsyncReaderWriter<
+                  PartitionAssignmentRequest, PartitionAssignment>>)} {
+    subscriber_ = std::make_unique<AssigningSubscriber>(
+        [&](StreamInitializer<PartitionAssignmentRequest, PartitionAssignment>
+                initializer) {
+          initializer_ = std::move(initializer);
+          return absl::WrapUnique(&resumable_stream_ref_);
+        },
+        partition_factory_.AsStdFunction(), MakeInitialRequest());
+  }
+
+  // Returns a partition subscriber which starts successfully.
+  static std::shared_ptr<StrictMock<MockService>> MakePartition(
+      promise<Status>& start) {
+    auto partition = std::make_shared<StrictMock<MockService>>();
+    EXPECT_CALL(*partition, Start)
+        .WillOnce(Return(ByMove(start.get_future())));
+    return partition;
+  }
+
+  StreamInitializer<PartitionAssignmentRequest, PartitionAssignment>
+      initializer_;
+  // the reference remains valid until the subscriber is destroyed, see
+  // `partition_publisher_test.cc`
+  StrictMock<MockResumableAsyncReaderWriter<PartitionAssignmentRequest,
+                                            PartitionAssignment>>&
+      resumable_stream_ref_;
+  StrictMock<MockFunction<std::shared_ptr<Service>(std::int64_t)>>
+      partition_factory_;
+  std::unique_ptr<AssigningSubscriber> subscriber_;
+};
+
+TEST_F(AssigningSubscriberTest, InitializerSendsInitialRequest) {
+  PartitionAssignmentRequest initial;
+  *initial.mutable_initial() = MakeInitialRequest();
+  auto underlying_stream = std::make_unique<StrictMock<AsyncReaderWriter>>();
+  EXPECT_CALL(*underlying_stream, Write(IsProtoEqual(initial), _))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  EXPECT_THAT(initializer_(std::move(underlying_stream)).get(), IsOk());
+}
+
+TEST_F(AssigningSubscriberTest, InitializerFailure) {
+  auto underlying_stream = std::make_unique<StrictMock<AsyncReaderWriter>>();
+  EXPECT_CALL(*underlying_stream, Write)
+      .WillOnce(Return(ByMove(make_ready_future(false))));
+  EXPECT_CALL(*underlying_stream, Finish)
+      .WillOnce(Return(ByMove(make_ready_future(
+          Status(StatusCode::kUnavailable, "unavailable")))));
+  EXPECT_THAT(initializer_(std::move(underlying_stream)).get(),
+              StatusIs(StatusCode::kUnavailable));
+}
+
+TEST_F(AssigningSubscriberTest, AddsAndRemovesPartitions) {
+  promise<Status> start_promise;
+  EXPECT_CALL(resumable_stream_ref_, Start)
+      .WillOnce(Return(ByMove(start_promise.get_future())));
+  promise<ReadResponse> first_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(first_read.get_future())));
+  auto start = subscriber_->Start();
+
+  promise<Status> start1;
+  promise<Status> start2;
+  auto partition1 = MakePartition(start1);
+  auto partition2 = MakePartition(start2);
+  EXPECT_CALL(partition_factory_, Call(1)).WillOnce(Return(partition1));
+  EXPECT_CALL(partition_factory_, Call(2)).WillOnce(Return(partition2));
+  EXPECT_CALL(resumable_stream_ref_, Write(IsProtoEqual(AckRequest())))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  promise<ReadResponse> second_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(second_read.get_future())));
+  first_read.set_value(Assignment({1, 2}));
+
+  // The assignment is acknowledged once the removed partition shuts down.
+  promise<Status> start3;
+  auto partition3 = MakePartition(start3);
+  EXPECT_CALL(partition_factory_, Call(3)).WillOnce(Return(partition3));
+  promise<void> shutdown1;
+  EXPECT_CALL(*partition1, Shutdown)
+      .WillOnce(Return(ByMove(shutdown1.get_future())));
+  second_read.set_value(Assignment({2, 3}));
+
+  EXPECT_CALL(resumable_stream_ref_, Write(IsProtoEqual(AckRequest())))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  promise<ReadResponse> third_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(third_read.get_future())));
+  start1.set_value(Status());
+  shutdown1.set_value();
+
+  EXPECT_CALL(resumable_stream_ref_, Shutdown)
+      .WillOnce(Return(ByMove(make_ready_future())));
+  EXPECT_CALL(*partition2, Shutdown)
+      .WillOnce(Return(ByMove(make_ready_future())));
+  EXPECT_CALL(*partition3, Shutdown)
+      .WillOnce(Return(ByMove(make_ready_future())));
+  auto shutdown = subscriber_->Shutdown();
+  start_promise.set_value(Status());
+  start2.set_value(Status());
+  start3.set_value(Status());
+  third_read.set_value(ReadResponse());
+  shutdown.get();
+  EXPECT_THAT(start.get(), IsOk());
+}
+
+TEST_F(AssigningSubscriberTest, PartitionFailureAborts) {
+  promise<Status> start_promise;
+  EXPECT_CALL(resumable_stream_ref_, Start)
+      .WillOnce(Return(ByMove(start_promise.get_future())));
+  promise<ReadResponse> first_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(first_read.get_future())));
+  auto start = subscriber_->Start();
+
+  promise<Status> start1;
+  auto partition1 = MakePartition(start1);
+  EXPECT_CALL(partition_factory_, Call(1)).WillOnce(Return(partition1));
+  EXPECT_CALL(resumable_stream_ref_, Write(IsProtoEqual(AckRequest())))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  promise<ReadResponse> second_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(second_read.get_future())));
+  first_read.set_value(Assignment({1}));
+
+  start1.set_value(Status(StatusCode::kFailedPrecondition, "nacked"));
+  EXPECT_THAT(start.get(), StatusIs(StatusCode::kFailedPrecondition));
+
+  EXPECT_CALL(resumable_stream_ref_, Shutdown)
+      .WillOnce(Return(ByMove(make_ready_future())));
+  EXPECT_CALL(*partition1, Shutdown)
+      .WillOnce(Return(ByMove(make_ready_future())));
+  auto shutdown = subscriber_->Shutdown();
+  start_promise.set_value(Status());
+  second_read.set_value(ReadResponse());
+  shutdown.get();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,198 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/committer.h"
+#include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/internal/make_status.h"
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsublite::v1::Cursor;
+using google::cloud::pubsublite::v1::InitialCommitCursorRequest;
+using google::cloud::pubsublite::v1::StreamingCommitCursorRequest;
+using google::cloud::pubsublite::v1::StreamingCommitCursorResponse;
+
+Committer::Committer(
+    absl::FunctionRef<std::unique_ptr<ResumableStream>(
+        StreamInitializer<StreamingCommitCursorRequest,
+                          StreamingCommitCursorResponse>)>
+        resumable_stream_factory,
+    InitialCommitCursorRequest initial_request, AlarmRegistry& alarm_registry,
+    std::chrono::milliseconds alarm_period)
+    : initial_request_{std::move(initial_request)},
+      resumable_stream_{resumable_stream_factory(
+          [this](ResumableStreamImpl::UnderlyingStream stream) {
+            return Initializer(std::move(stream));
+          })},
+      service_composite_{resumable_stream_.get()},
+      cancel_token_{
+          alarm_registry.RegisterAlarm(alarm_period, [this] { Flush(); })} {}
+
+Committer::~Committer() {
+  future<void> shutdown = Shutdown();
+  if (!shutdown.is_ready()) {
+    GCP_LOG(WARNING) << "`Shutdown` must be called and finished before object "
+                        "goes out of scope.";
+  }
+  shutdown.get();
+}
+
+future<Status> Committer::Start() {
+  auto start_return = service_composite_.Start();
+  OnReadStart();
+  Read();
+  return start_return;
+}
+
+void Committer::Commit(Cursor cursor) {
+  std::lock_guard<std::mutex> g{mu_};
+  pending_ = std::move(cursor);
+}
+
+void Committer::Flush() {
+  AsyncRoot root;
+  std::lock_guard<std::mutex> g{mu_};
+  if (writing_ || !pending_ || !service_composite_.status().ok()) return;
+  writing_ = true;
+  StreamingCommitCursorRequest request;
+  *request.mutable_commit()->mutable_cursor() = *pending_;
+  in_flight_.push_back(*std::move(pending_));
+  pending_.reset();
+  root.get_future()
+      .then(ChainFuture(resumable_stream_->Write(std::move(request))))
+      .then([this](future<bool> write_response) {
+        bool const ok = write_response.get();
+        {
+          std::lock_guard<std::mutex> g{mu_};
+          writing_ = false;
+        }
+        // On failure the unacknowledged cursor is resent by `Initializer()`.
+        if (ok) Flush();
+      });
+}
+
+future<void> Committer::Shutdown() {
+  cancel_token_ = nullptr;
+  // Best effort, the write may be cancelled by the shutdown below.
+  Flush();
+  future<void> shutdown = service_composite_.Shutdown();
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    if (reading_) {
+      shutdown = shutdown.then(ChainFuture(reading_->get_future()));
+    }
+  }
+  return shutdown;
+}
+
+void Committer::Read() {
+  AsyncRoot root;
+  if (!service_composite_.status().ok()) return OnReadEnd();
+  // need lock because calling `resumable_stream_->Read()`
+  std::lock_guard<std::mutex> g{mu_};
+  root.get_future()
+      .then(ChainFuture(resumable_stream_->Read()))
+      .then([this](future<absl::optional<StreamingCommitCursorResponse>> f) {
+        OnRead(f.get());
+      });
+}
+
+void Committer::OnRead(absl::optional<StreamingCommitCursorResponse> response) {
+  // optional not engaged implies that the retry loop has finished
+  if (!response) return Read();
+  if (!response->has_commit()) {
+    OnReadEnd();
+    return service_composite_.Abort(internal::AbortedError(
+        absl::StrCat("Invalid `Read` response: ", response->DebugString()),
+        GCP_ERROR_INFO()));
+  }
+  auto const acknowledged = response->commit().acknowledged_commits();
+  bool valid;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    valid = acknowledged >= 0 &&
+            static_cast<std::size_t>(acknowledged) <= in_flight_.size();
+    if (valid) {
+      in_flight_.erase(in_flight_.begin(),
+                       in_flight_.begin() +
+                           static_cast<std::ptrdiff_t>(acknowledged));
+    }
+  }
+  if (!valid) {
+    OnReadEnd();
+    return service_composite_.Abort(internal::FailedPreconditionError(
+        absl::StrCat("Server acknowledged ", acknowledged,
+                     " commits, more than were outstanding."),
+        GCP_ERROR_INFO()));
+  }
+  Read();
+}
+
+void Committer::OnReadStart() {
+  std::lock_guard<std::mutex> g{mu_};
+  if (!reading_) reading_.emplace();
+}
+
+void Committer::OnReadEnd() {
+  absl::optional<promise<void>> read_done;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    read_done.swap(reading_);
+  }
+  if (read_done) read_done->set_value();
+}
+
+future<StatusOr<Committer::ResumableStreamImpl::UnderlyingStream>>
+Committer::Initializer(ResumableStreamImpl::UnderlyingStream stream) {
+  auto shared_stream = std::make_shared<ResumableStreamImpl::UnderlyingStream>(
+      std::move(stream));
+  StreamingCommitCursorRequest request;
+  *request.mutable_initial() = initial_request_;
+  return (*shared_stream)
+      ->Write(request, grpc::WriteOptions())
+      .then([shared_stream](future<bool> write_response) {
+        if (!write_response.get()) {
+          return make_ready_future(
+              absl::optional<StreamingCommitCursorResponse>());
+        }
+        return (*shared_stream)->Read();
+      })
+      .then([shared_stream](
+                future<absl::optional<StreamingCommitCursorResponse>> f) {
+        auto response = f.get();
+        if (response && response->has_initial()) {
+          return make_ready_future(Status());
+        }
+        return (*shared_stream)->Finish();
+      })
+      .then([this, shared_stream](future<Status> f)
+                -> StatusOr<ResumableStreamImpl::UnderlyingStream> {
+        Status status = f.get();
+        if (!status.ok()) return status;
+        std::lock_guard<std::mutex> g{mu_};
+        // The new stream has no outstanding commits, resend the latest cursor
+        // unless a newer one is already pending.
+        if (!pending_ && !in_flight_.empty()) pending_ = in_flight_.back();
+        in_flight_.clear();
+        return std::move(*shared_stream);
+      });
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
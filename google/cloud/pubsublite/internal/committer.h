@@ -0,0 +1,107 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_COMMITTER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_COMMITTER_H
+
+#include "google/cloud/pubsublite/internal/alarm_registry.h"
+#include "google/cloud/pubsublite/internal/resumable_async_streaming_read_write_rpc.h"
+#include "google/cloud/pubsublite/internal/service_composite.h"
+#include "absl/functional/function_ref.h"
+#include <google/cloud/pubsublite/v1/cursor.pb.h>
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Commits the cursor of a single partition over a `StreamingCommitCursor`
+ * stream.
+ *
+ * `Commit()` only records the latest cursor, which is sent on each alarm. At
+ * most one commit is written at a time. If the stream is resumed, the latest
+ * cursor not acknowledged by the service is sent again on the new stream.
+ */
+class Committer : public Service {
+ private:
+  using ResumableStream = ResumableAsyncStreamingReadWriteRpc<
+      google::cloud::pubsublite::v1::StreamingCommitCursorRequest,
+      google::cloud::pubsublite::v1::StreamingCommitCursorResponse>;
+  using ResumableStreamImpl = ResumableAsyncStreamingReadWriteRpcImpl<
+      google::cloud::pubsublite::v1::StreamingCommitCursorRequest,
+      google::cloud::pubsublite::v1::StreamingCommitCursorResponse>;
+
+ public:
+  Committer(
+      absl::FunctionRef<std::unique_ptr<ResumableStream>(
+          StreamInitializer<
+              google::cloud::pubsublite::v1::StreamingCommitCursorRequest,
+              google::cloud::pubsublite::v1::StreamingCommitCursorResponse>)>,
+      google::cloud::pubsublite::v1::InitialCommitCursorRequest,
+      AlarmRegistry&, std::chrono::milliseconds alarm_period);
+
+  ~Committer() override;
+
+  future<Status> Start() override;
+
+  /// Commits @p cursor on the next alarm, replacing any pending cursor.
+  void Commit(google::cloud::pubsublite::v1::Cursor cursor);
+
+  /// Sends the pending cursor, if any.
+  void Flush();
+
+  future<void> Shutdown() override;
+
+ private:
+  void Read();
+
+  void OnRead(absl::optional<
+              google::cloud::pubsublite::v1::StreamingCommitCursorResponse>
+                  response);
+
+  void OnReadStart();
+
+  void OnReadEnd();
+
+  future<StatusOr<ResumableStreamImpl::UnderlyingStream>> Initializer(
+      ResumableStreamImpl::UnderlyingStream stream);
+
+  google::cloud::pubsublite::v1::InitialCommitCursorRequest const
+      initial_request_;
+
+  std::mutex mu_;
+
+  std::unique_ptr<ResumableStream> const
+      resumable_stream_;  // ABSL_GUARDED_BY(mu_)
+  ServiceComposite service_composite_;
+  absl::optional<google::cloud::pubsublite::v1::Cursor>
+      pending_;  // ABSL_GUARDED_BY(mu_)
+  std::deque<google::cloud::pubsublite::v1::Cursor>
+      in_flight_;                          // ABSL_GUARDED_BY(mu_)
+  bool writing_ = false;                   // ABSL_GUARDED_BY(mu_)
+  absl::optional<promise<void>> reading_;  // ABSL_GUARDED_BY(mu_)
+
+  std::unique_ptr<AlarmRegistry::CancelToken> cancel_token_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_COMMITTER_H
@@ -0,0 +1,234 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsublite/internal/committer.h"
+#include "google/cloud/mocks/mock_async_streaming_read_write_rpc.h"
+#include "google/cloud/pubsublite/testing/mock_alarm_registry.h"
+#include "google/cloud/pubsublite/testing/mock_resumable_async_reader_writer_stream.h"
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsublite::v1::Cursor;
+using google::cloud::pubsublite::v1::InitialCommitCursorRequest;
+using google::cloud::pubsublite::v1::InitialCommitCursorResponse;
+using google::cloud::pubsublite::v1::StreamingCommitCursorRequest;
+using google::cloud::pubsublite::v1::StreamingCommitCursorResponse;
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::IsProtoEqual;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::_;
+using ::testing::ByMove;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::testing::StrictMock;
+using ::testing::WithArg;
+
+using ::google::cloud::pubsublite_testing::MockAlarmRegistry;
+using ::google::cloud::pubsublite_testing::MockAlarmRegistryCancelToken;
+using ::google::cloud::pubsublite_testing::MockResumableAsyncReaderWriter;
+
+using AsyncReaderWriter = google::cloud::mocks::MockAsyncStreamingReadWriteRpc<
+    StreamingCommitCursorRequest, StreamingCommitCursorResponse>;
+
+using ReadResponse = absl::optional<StreamingCommitCursorResponse>;
+
+auto const kAlarmDuration = std::chrono::milliseconds{50};
+
+StreamingCommitCursorRequest CommitRequest(std::int64_t offset) {
+  StreamingCommitCursorRequest request;
+  request.mutable_commit()->mutable_cursor()->set_offset(offset);
+  return request;
+}
+
+ReadResponse CommitResponse(std::int64_t acknowledged_commits) {
+  StreamingCommitCursorResponse response;
+  response.mutable_commit()->set_acknowledged_commits(acknowledged_commits);
+  return response;
+}
+
+Cursor MakeCursor(std::int64_t offset) {
+  Cursor cursor;
+  cursor.set_offset(offset);
+  return cursor;
+}
+
+class CommitterTest : public ::testing::Test {
+ protected:
+  CommitterTest()
+      : alarm_token_ref_{*(new StrictMock<MockAlarmRegistryCancelToken>)},
+        resumable_stream_ref_{
+            *(new StrictMock<MockResumableAsyncReaderWriter<
+                  StreamingCommitCursorRequest,
+                  StreamingCommitCursorResponse>>)} {
+    EXPECT_CALL(alarm_registry_, RegisterAlarm(kAlarmDuration, _))
+        .WillOnce(WithArg<1>([&](std::function<void()> on_alarm) {
+          on_alarm_ = std::move(on_alarm);
+          return absl::WrapUnique(&alarm_token_ref_);
+        }));
+    committer_ = std::make_unique<Committer>(
+        [&](StreamInitializer<StreamingCommitCursorRequest,
+                              StreamingCommitCursorResponse>
+                initializer) {
+          initializer_ = std::move(initializer);
+          return absl::WrapUnique(&resumable_stream_ref_);
+        },
+        InitialCommitCursorRequest::default_instance(), alarm_registry_,
+        kAlarmDuration);
+  }
+
+  // Runs the initializer on a new underlying stream, which accepts the initial
+  // request.
+  void InitializeStream() {
+    StreamingCommitCursorRequest initial;
+    *initial.mutable_initial() = InitialCommitCursorRequest::default_instance();
+    StreamingCommitCursorResponse initial_response;
+    *initial_response.mutable_initial() =
+        InitialCommitCursorResponse::default_instance();
+
+    auto underlying_stream = std::make_unique<StrictMock<AsyncReaderWriter>>();
+    EXPECT_CALL(*underlying_stream, Write(IsProtoEqual(initial), _))
+        .WillOnce(Return(ByMove(make_ready_future(true))));
+    EXPECT_CALL(*underlying_stream, Read)
+        .WillOnce(Return(ByMove(make_ready_future(
+            absl::make_optional(std::move(initial_response))))));
+    EXPECT_THAT(initializer_(std::move(underlying_stream)).get(), IsOk());
+  }
+
+  StreamInitializer<StreamingCommitCursorRequest,
+                    StreamingCommitCursorResponse>
+      initializer_;
+  // the references remain valid until the committer is destroyed, see
+  // `partition_publisher_test.cc`
+  StrictMock<MockAlarmRegistryCancelToken>& alarm_token_ref_;
+  StrictMock<MockAlarmRegistry> alarm_registry_;
+  std::function<void()> on_alarm_;
+  StrictMock<MockResumableAsyncReaderWriter<StreamingCommitCursorRequest,
+                                            StreamingCommitCursorResponse>>&
+      resumable_stream_ref_;
+  std::unique_ptr<Committer> committer_;
+};
+
+TEST_F(CommitterTest, StartNotCalled) {
+  EXPECT_CALL(alarm_token_ref_, Destroy);
+}
+
+TEST_F(CommitterTest, CommitsLatestCursorOnAlarm) {
+  InSequence seq;
+
+  promise<Status> start_promise;
+  EXPECT_CALL(resumable_stream_ref_, Start)
+      .WillOnce(Return(ByMove(start_promise.get_future())));
+  promise<ReadResponse> read_promise;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(read_promise.get_future())));
+  auto start = committer_->Start();
+  InitializeStream();
+
+  // Nothing is written until the alarm fires.
+  committer_->Commit(MakeCursor(1));
+  committer_->Commit(MakeCursor(2));
+  promise<bool> write_promise;
+  EXPECT_CALL(resumable_stream_ref_, Write(IsProtoEqual(CommitRequest(2))))
+      .WillOnce(Return(ByMove(write_promise.get_future())));
+  on_alarm_();
+
+  // Only one write is outstanding at a time.
+  committer_->Commit(MakeCursor(3));
+  on_alarm_();
+  EXPECT_CALL(resumable_stream_ref_, Write(IsProtoEqual(CommitRequest(3))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  write_promise.set_value(true);
+
+  promise<ReadResponse> next_read_promise;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(next_read_promise.get_future())));
+  read_promise.set_value(CommitResponse(2));
+
+  EXPECT_CALL(alarm_token_ref_, Destroy);
+  EXPECT_CALL(resumable_stream_ref_, Shutdown)
+      .WillOnce(Return(ByMove(make_ready_future())));
+  auto shutdown = committer_->Shutdown();
+  EXPECT_THAT(start.get(), IsOk());
+  start_promise.set_value(Status());
+  next_read_promise.set_value(ReadResponse());
+  shutdown.get();
+}
+
+TEST_F(CommitterTest, ResendsUnacknowledgedCursorOnReconnect) {
+  InSequence seq;
+
+  promise<Status> start_promise;
+  EXPECT_CALL(resumable_stream_ref_, Start)
+      .WillOnce(Return(ByMove(start_promise.get_future())));
+  promise<ReadResponse> read_promise;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(read_promise.get_future())));
+  auto start = committer_->Start();
+  InitializeStream();
+
+  committer_->Commit(MakeCursor(5));
+  EXPECT_CALL(resumable_stream_ref_, Write(IsProtoEqual(CommitRequest(5))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  on_alarm_();
+
+  // The stream breaks before the commit is acknowledged.
+  InitializeStream();
+  EXPECT_CALL(resumable_stream_ref_, Write(IsProtoEqual(CommitRequest(5))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  on_alarm_();
+
+  EXPECT_CALL(alarm_token_ref_, Destroy);
+  EXPECT_CALL(resumable_stream_ref_, Shutdown)
+      .WillOnce(Return(ByMove(make_ready_future())));
+  auto shutdown = committer_->Shutdown();
+  start_promise.set_value(Status());
+  read_promise.set_value(ReadResponse());
+  shutdown.get();
+  EXPECT_THAT(start.get(), IsOk());
+}
+
+TEST_F(CommitterTest, TooManyAcknowledgedCommits) {
+  InSequence seq;
+
+  promise<Status> start_promise;
+  EXPECT_CALL(resumable_stream_ref_, Start)
+      .WillOnce(Return(ByMove(start_promise.get_future())));
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(make_ready_future(CommitResponse(1)))));
+  auto start = committer_->Start();
+  EXPECT_THAT(start.get(), StatusIs(StatusCode::kFailedPrecondition));
+
+  EXPECT_CALL(alarm_token_ref_, Destroy);
+  EXPECT_CALL(resumable_stream_ref_, Shutdown)
+      .WillOnce(Return(ByMove(make_ready_future())));
+  committer_->Shutdown().get();
+  start_promise.set_value(Status());
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,65 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/default_subscribe_message_transformer.h"
+#include "google/cloud/pubsublite/internal/default_publish_message_transformer.h"
+#include "google/cloud/pubsublite/message_metadata.h"
+#include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/internal/base64_transforms.h"
+#include "google/cloud/internal/make_status.h"
+#include <google/pubsub/v1/pubsub.pb.h>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::internal::Base64Encoder;
+using google::cloud::pubsub::Message;
+using google::cloud::pubsublite::MessageMetadata;
+using google::cloud::pubsublite::v1::SequencedMessage;
+
+StatusOr<Message> DefaultSubscribeMessageTransformer(
+    std::int64_t partition, SequencedMessage const& message) {
+  google::pubsub::v1::PubsubMessage m;
+  m.set_data(message.message().data());
+  m.set_ordering_key(message.message().key());
+  m.set_message_id(MessageMetadata{partition, message.cursor()}.Serialize());
+  *m.mutable_publish_time() = message.publish_time();
+  auto& attributes = *m.mutable_attributes();
+  for (auto const& kv : message.message().attributes()) {
+    if (kv.second.values_size() != 1) {
+      return internal::InvalidArgumentError(
+          absl::StrCat("Attribute `", kv.first, "` has ",
+                       kv.second.values_size(),
+                       " values, only single valued attributes are supported"),
+          GCP_ERROR_INFO());
+    }
+    attributes[kv.first] = kv.second.values(0);
+  }
+  if (message.message().has_event_time()) {
+    Base64Encoder encoder;
+    for (unsigned char const c :
+         message.message().event_time().SerializeAsString()) {
+      encoder.PushBack(c);
+    }
+    attributes[EventTimestampAttribute()] = std::move(encoder).FlushAndPad();
+  }
+  return google::cloud::pubsub_internal::FromProto(std::move(m));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,45 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_DEFAULT_SUBSCRIBE_MESSAGE_TRANSFORMER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_DEFAULT_SUBSCRIBE_MESSAGE_TRANSFORMER_H
+
+#include "google/cloud/pubsub/message.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <google/cloud/pubsublite/v1/common.pb.h>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Converts a message received from @p partition into a Cloud Pub/Sub
+ * `Message`.
+ *
+ * This is the inverse of `DefaultPublishMessageTransformer()`. The message id
+ * is the serialized `MessageMetadata`. Attributes must have exactly one value.
+ */
+StatusOr<google::cloud::pubsub::Message> DefaultSubscribeMessageTransformer(
+    std::int64_t partition,
+    google::cloud::pubsublite::v1::SequencedMessage const& message);
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_DEFAULT_SUBSCRIBE_MESSAGE_TRANSFORMER_H
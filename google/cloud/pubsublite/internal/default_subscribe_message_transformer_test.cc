@@ -0,0 +1,96 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsublite/internal/default_subscribe_message_transformer.h"
+#include "google/cloud/pubsublite/internal/default_publish_message_transformer.h"
+#include "google/cloud/pubsublite/message_metadata.h"
+#include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <google/protobuf/timestamp.pb.h>
+#include <google/pubsub/v1/pubsub.pb.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsublite::MakeMessageMetadata;
+using google::cloud::pubsublite::MessageMetadata;
+using google::cloud::pubsublite::v1::SequencedMessage;
+using ::google::cloud::testing_util::IsProtoEqual;
+using ::google::cloud::testing_util::StatusIs;
+using google::protobuf::Timestamp;
+using ::testing::HasSubstr;
+
+SequencedMessage ExampleSequencedMessage() {
+  SequencedMessage m;
+  m.mutable_cursor()->set_offset(42);
+  m.mutable_publish_time()->set_seconds(1234);
+  m.set_size_bytes(100);
+  auto& message = *m.mutable_message();
+  message.set_data("dataaaa");
+  message.set_key("keyyyy");
+  (*message.mutable_attributes())["attr1_key"].add_values("attr1_value");
+  (*message.mutable_attributes())["lang"].add_values("cpp");
+  return m;
+}
+
+TEST(DefaultSubscribeMessageTransformerTest, Basic) {
+  auto message =
+      DefaultSubscribeMessageTransformer(3, ExampleSequencedMessage());
+  ASSERT_STATUS_OK(message);
+
+  google::pubsub::v1::PubsubMessage expected;
+  expected.set_data("dataaaa");
+  expected.set_ordering_key("keyyyy");
+  expected.set_message_id("3:42");
+  expected.mutable_publish_time()->set_seconds(1234);
+  (*expected.mutable_attributes())["attr1_key"] = "attr1_value";
+  (*expected.mutable_attributes())["lang"] = "cpp";
+  EXPECT_THAT(google::cloud::pubsub_internal::ToProto(*message),
+              IsProtoEqual(expected));
+
+  auto metadata = MakeMessageMetadata(message->message_id());
+  ASSERT_STATUS_OK(metadata);
+  EXPECT_EQ(*metadata,
+            (MessageMetadata{3, ExampleSequencedMessage().cursor()}));
+}
+
+TEST(DefaultSubscribeMessageTransformerTest, EventTimeRoundTrip) {
+  auto m = ExampleSequencedMessage();
+  Timestamp t;
+  t.set_seconds(42);
+  t.set_nanos(42);
+  *m.mutable_message()->mutable_event_time() = t;
+
+  auto message = DefaultSubscribeMessageTransformer(3, m);
+  ASSERT_STATUS_OK(message);
+  auto published = DefaultPublishMessageTransformer(*message);
+  ASSERT_STATUS_OK(published);
+  EXPECT_THAT(*published, IsProtoEqual(m.message()));
+}
+
+TEST(DefaultSubscribeMessageTransformerTest, MultipleAttributeValues) {
+  auto m = ExampleSequencedMessage();
+  (*m.mutable_message()->mutable_attributes())["lang"].add_values("java");
+  EXPECT_THAT(DefaultSubscribeMessageTransformer(3, m).status(),
+              StatusIs(StatusCode::kInvalidArgument, HasSubstr("lang")));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,101 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/partition_callback_sequencer.h"
+#include "absl/types/optional.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsub::AckHandler;
+using google::cloud::pubsub::ApplicationCallback;
+using google::cloud::pubsub::Message;
+
+PartitionCallbackSequencer::PartitionCallbackSequencer(
+    CompletionQueue cq, ApplicationCallback callback)
+    : cq_(std::move(cq)), callback_(std::move(callback)) {}
+
+void PartitionCallbackSequencer::Push(std::int64_t partition, Message m,
+                                      AckHandler h) {
+  std::unique_lock<std::mutex> lk(mu_);
+  // The handler nacks the message when it is destroyed. That is harmless here,
+  // the subscriber is shut down before the sequencer.
+  if (shutdown_) return;
+  auto& p = partitions_[partition];
+  p.queue.push_back(Pending{std::move(m), std::move(h)});
+  if (p.running) return;
+  p.running = true;
+  ++running_;
+  lk.unlock();
+  Schedule(partition);
+}
+
+future<void> PartitionCallbackSequencer::Shutdown() {
+  // Destroy the discarded messages after releasing the lock.
+  std::vector<Pending> discarded;
+  std::lock_guard<std::mutex> lk(mu_);
+  shutdown_ = true;
+  for (auto& kv : partitions_) {
+    auto& queue = kv.second.queue;
+    for (auto& m : queue) discarded.push_back(std::move(m));
+    queue.clear();
+  }
+  if (running_ == 0) return make_ready_future();
+  idle_.emplace_back();
+  return idle_.back().get_future();
+}
+
+void PartitionCallbackSequencer::Schedule(std::int64_t partition) {
+  // Each message is a separate function in the completion queue, so the
+  // callbacks for different partitions, and any other work in the completion
+  // queue, are interleaved.
+  cq_.RunAsync(
+      [self = shared_from_this(), partition] { self->Run(partition); });
+}
+
+void PartitionCallbackSequencer::Run(std::int64_t partition) {
+  absl::optional<Pending> next;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    auto& p = partitions_[partition];
+    if (shutdown_ || p.queue.empty()) return Done(std::move(lk), p);
+    next.emplace(std::move(p.queue.front()));
+    p.queue.pop_front();
+  }
+  callback_(std::move(next->message), std::move(next->handler));
+
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& p = partitions_[partition];
+  if (shutdown_ || p.queue.empty()) return Done(std::move(lk), p);
+  lk.unlock();
+  Schedule(partition);
+}
+
+void PartitionCallbackSequencer::Done(std::unique_lock<std::mutex> lk,
+                                      Partition& p) {
+  p.running = false;
+  if (--running_ != 0 || !shutdown_) return;
+  auto idle = std::move(idle_);
+  idle_.clear();
+  lk.unlock();
+  for (auto& i : idle) i.set_value();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
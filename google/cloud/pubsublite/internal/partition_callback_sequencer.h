@@ -0,0 +1,98 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_PARTITION_CALLBACK_SEQUENCER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_PARTITION_CALLBACK_SEQUENCER_H
+
+#include "google/cloud/pubsub/ack_handler.h"
+#include "google/cloud/pubsub/application_callback.h"
+#include "google/cloud/pubsub/message.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/version.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Runs the application callback on the completion queue, in order for each
+ * partition.
+ *
+ * The messages from one partition are delivered one at a time, in the order
+ * they were received. Messages from different partitions may be delivered
+ * concurrently. The callback never runs in the thread that received the
+ * messages, so a slow callback does not stall the streams served by that
+ * thread.
+ *
+ * The number of queued messages is bounded by the flow control limits of each
+ * partition, as the messages hold their tokens until they are acked.
+ *
+ * @note Objects of this class must be created with `std::make_shared<>`.
+ */
+class PartitionCallbackSequencer
+    : public std::enable_shared_from_this<PartitionCallbackSequencer> {
+ public:
+  PartitionCallbackSequencer(
+      CompletionQueue cq, google::cloud::pubsub::ApplicationCallback callback);
+
+  /// Delivers @p m after all the messages previously received in @p partition.
+  void Push(std::int64_t partition, google::cloud::pubsub::Message m,
+            google::cloud::pubsub::AckHandler h);
+
+  /**
+   * Discards the queued messages, and any messages pushed later.
+   *
+   * The returned future is satisfied once no callback is running.
+   */
+  future<void> Shutdown();
+
+ private:
+  struct Pending {
+    google::cloud::pubsub::Message message;
+    google::cloud::pubsub::AckHandler handler;
+  };
+  struct Partition {
+    std::deque<Pending> queue;
+    bool running = false;
+  };
+
+  void Schedule(std::int64_t partition);
+  void Run(std::int64_t partition);
+  void Done(std::unique_lock<std::mutex> lk, Partition& p);
+
+  CompletionQueue cq_;
+  google::cloud::pubsub::ApplicationCallback const callback_;
+
+  std::mutex mu_;
+  std::unordered_map<std::int64_t, Partition>
+      partitions_;                  // ABSL_GUARDED_BY(mu_)
+  int running_ = 0;                 // ABSL_GUARDED_BY(mu_)
+  bool shutdown_ = false;           // ABSL_GUARDED_BY(mu_)
+  std::vector<promise<void>> idle_;  // ABSL_GUARDED_BY(mu_)
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_PARTITION_CALLBACK_SEQUENCER_H
@@ -0,0 +1,124 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/partition_callback_sequencer.h"
+#include "google/cloud/pubsub/mocks/mock_ack_handler.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::internal::AutomaticallyCreatedBackgroundThreads;
+using ::google::cloud::pubsub::AckHandler;
+using ::google::cloud::pubsub::Message;
+using ::google::cloud::pubsub::MessageBuilder;
+using ::google::cloud::pubsub_mocks::MockAckHandler;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+Message MakeMessage(std::string data) {
+  return MessageBuilder().SetData(std::move(data)).Build();
+}
+
+AckHandler MakeHandler() {
+  return AckHandler(std::make_unique<::testing::NiceMock<MockAckHandler>>());
+}
+
+TEST(PartitionCallbackSequencer, DeliversInOrder) {
+  AutomaticallyCreatedBackgroundThreads background(4);
+  std::mutex mu;
+  std::vector<std::string> received;
+  promise<void> delivered;
+  auto const caller = std::this_thread::get_id();
+  auto sequencer = std::make_shared<PartitionCallbackSequencer>(
+      background.cq(), [&](Message m, AckHandler) {
+        EXPECT_NE(std::this_thread::get_id(), caller);
+        std::lock_guard<std::mutex> lk(mu);
+        received.push_back(m.data());
+        if (received.size() == 3) delivered.set_value();
+      });
+  sequencer->Push(0, MakeMessage("m0"), MakeHandler());
+  sequencer->Push(0, MakeMessage("m1"), MakeHandler());
+  sequencer->Push(0, MakeMessage("m2"), MakeHandler());
+  delivered.get_future().get();
+  sequencer->Shutdown().get();
+  EXPECT_THAT(received, ElementsAre("m0", "m1", "m2"));
+}
+
+TEST(PartitionCallbackSequencer, SlowCallbackDoesNotBlockOtherPartitions) {
+  AutomaticallyCreatedBackgroundThreads background(4);
+  promise<void> unblock;
+  auto blocked = unblock.get_future();
+  promise<void> other;
+  std::mutex mu;
+  std::vector<std::string> received;
+  auto sequencer = std::make_shared<PartitionCallbackSequencer>(
+      background.cq(), [&](Message m, AckHandler) {
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          received.push_back(m.data());
+        }
+        if (m.data() == "p0-m0") blocked.get();
+        if (m.data() == "p1-m0") other.set_value();
+      });
+  sequencer->Push(0, MakeMessage("p0-m0"), MakeHandler());
+  sequencer->Push(0, MakeMessage("p0-m1"), MakeHandler());
+  sequencer->Push(1, MakeMessage("p1-m0"), MakeHandler());
+
+  // The second message in partition 0 waits for the first one.
+  other.get_future().get();
+  {
+    std::lock_guard<std::mutex> lk(mu);
+    EXPECT_THAT(received, ElementsAre("p0-m0", "p1-m0"));
+  }
+  auto shutdown = sequencer->Shutdown();
+  EXPECT_EQ(shutdown.wait_for(std::chrono::milliseconds(10)),
+            std::future_status::timeout);
+  unblock.set_value();
+  shutdown.get();
+
+  // The queued message is discarded.
+  std::lock_guard<std::mutex> lk(mu);
+  EXPECT_THAT(received, ElementsAre("p0-m0", "p1-m0"));
+}
+
+TEST(PartitionCallbackSequencer, DiscardsAfterShutdown) {
+  AutomaticallyCreatedBackgroundThreads background(1);
+  std::vector<std::string> received;
+  auto sequencer = std::make_shared<PartitionCallbackSequencer>(
+      background.cq(),
+      [&](Message m, AckHandler) { received.push_back(m.data()); });
+  sequencer->Shutdown().get();
+  sequencer->Push(0, MakeMessage("m0"), MakeHandler());
+  // Flush the completion queue.
+  promise<void> flushed;
+  background.cq().RunAsync([&] { flushed.set_value(); });
+  flushed.get_future().get();
+  EXPECT_THAT(received, IsEmpty());
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
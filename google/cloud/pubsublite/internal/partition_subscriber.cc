@@ -0,0 +1,302 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/partition_subscriber.h"
+#include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/internal/make_status.h"
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsublite::v1::Cursor;
+using google::cloud::pubsublite::v1::FlowControlRequest;
+using google::cloud::pubsublite::v1::InitialSubscribeRequest;
+using google::cloud::pubsublite::v1::SequencedMessage;
+using google::cloud::pubsublite::v1::SubscribeRequest;
+using google::cloud::pubsublite::v1::SubscribeResponse;
+
+namespace {
+
+class PartitionAckHandler : public google::cloud::pubsub::AckHandler::Impl {
+ public:
+  PartitionAckHandler(std::weak_ptr<PartitionSubscriber> subscriber,
+                      std::int64_t offset, std::int64_t size_bytes)
+      : subscriber_(std::move(subscriber)),
+        offset_(offset),
+        size_bytes_(size_bytes) {}
+
+  void ack() override {
+    if (auto s = subscriber_.lock()) s->Ack(offset_, size_bytes_);
+  }
+  void nack() override {
+    if (auto s = subscriber_.lock()) s->Nack(offset_);
+  }
+
+ private:
+  std::weak_ptr<PartitionSubscriber> subscriber_;
+  std::int64_t offset_;
+  std::int64_t size_bytes_;
+};
+
+}  // namespace
+
+PartitionSubscriber::PartitionSubscriber(
+    absl::FunctionRef<std::unique_ptr<ResumableStream>(
+        StreamInitializer<SubscribeRequest, SubscribeResponse>)>
+        resumable_stream_factory,
+    InitialSubscribeRequest initial_request,
+    FlowControlRequest flow_control_limits,
+    std::unique_ptr<Committer> committer, PartitionMessageCallback callback,
+    AlarmRegistry& alarm_registry, std::chrono::milliseconds alarm_period)
+    : initial_request_{std::move(initial_request)},
+      limits_{std::move(flow_control_limits)},
+      callback_{std::move(callback)},
+      resumable_stream_{resumable_stream_factory(
+          [this](ResumableStreamImpl::UnderlyingStream stream) {
+            return Initializer(std::move(stream));
+          })},
+      committer_{std::move(committer)},
+      service_composite_{resumable_stream_.get(), committer_.get()},
+      tokens_{limits_},
+      cancel_token_{
+          alarm_registry.RegisterAlarm(alarm_period, [this] { Flush(); })} {}
+
+PartitionSubscriber::~PartitionSubscriber() {
+  future<void> shutdown = Shutdown();
+  if (!shutdown.is_ready()) {
+    GCP_LOG(WARNING) << "`Shutdown` must be called and finished before object "
+                        "goes out of scope.";
+  }
+  shutdown.get();
+}
+
+future<Status> PartitionSubscriber::Start() {
+  auto start_return = service_composite_.Start();
+  OnReadStart();
+  Read();
+  return start_return;
+}
+
+future<void> PartitionSubscriber::Shutdown() {
+  cancel_token_ = nullptr;
+  future<void> shutdown = service_composite_.Shutdown();
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    if (reading_) {
+      shutdown = shutdown.then(ChainFuture(reading_->get_future()));
+    }
+  }
+  return shutdown;
+}
+
+void PartitionSubscriber::Ack(std::int64_t offset, std::int64_t size_bytes) {
+  absl::optional<Cursor> cursor;
+  bool flush;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    tokens_.set_allowed_messages(tokens_.allowed_messages() + 1);
+    tokens_.set_allowed_bytes(tokens_.allowed_bytes() + size_bytes);
+    pending_tokens_.set_allowed_messages(pending_tokens_.allowed_messages() +
+                                         1);
+    pending_tokens_.set_allowed_bytes(pending_tokens_.allowed_bytes() +
+                                      size_bytes);
+    cursor = ack_set_tracker_.Ack(offset);
+    // Do not wait for the alarm when the service may be starved of tokens.
+    flush = pending_tokens_.allowed_messages() * 2 >=
+                limits_.allowed_messages() ||
+            pending_tokens_.allowed_bytes() * 2 >= limits_.allowed_bytes();
+  }
+  if (cursor) committer_->Commit(*std::move(cursor));
+  if (flush) Flush();
+}
+
+void PartitionSubscriber::Nack(std::int64_t offset) {
+  service_composite_.Abort(internal::FailedPreconditionError(
+      absl::StrCat("Message at offset ", offset,
+                   " was nacked, Pub/Sub Lite does not support nacks"),
+      GCP_ERROR_INFO()));
+}
+
+void PartitionSubscriber::Flush() {
+  AsyncRoot root;
+  std::lock_guard<std::mutex> g{mu_};
+  if (writing_ || !service_composite_.status().ok()) return;
+  if (pending_tokens_.allowed_messages() == 0 &&
+      pending_tokens_.allowed_bytes() == 0) {
+    return;
+  }
+  writing_ = true;
+  auto const generation = grant_generation_;
+  auto tokens = std::move(pending_tokens_);
+  pending_tokens_.Clear();
+  SubscribeRequest request;
+  *request.mutable_flow_control() = tokens;
+  root.get_future()
+      .then(ChainFuture(resumable_stream_->Write(std::move(request))))
+      .then([this, generation, tokens](future<bool> write_response) {
+        bool const ok = write_response.get();
+        {
+          std::lock_guard<std::mutex> g{mu_};
+          writing_ = false;
+          // The write fails while the stream is resuming. If `Initializer()`
+          // has not granted all the tokens on a newer stream yet, these
+          // tokens must be sent again, or the service would never get them.
+          if (!ok && generation == grant_generation_) {
+            pending_tokens_.set_allowed_messages(
+                pending_tokens_.allowed_messages() + tokens.allowed_messages());
+            pending_tokens_.set_allowed_bytes(pending_tokens_.allowed_bytes() +
+                                              tokens.allowed_bytes());
+          }
+        }
+        if (ok) Flush();
+      });
+}
+
+void PartitionSubscriber::Read() {
+  AsyncRoot root;
+  if (!service_composite_.status().ok()) return OnReadEnd();
+  // need lock because calling `resumable_stream_->Read()`
+  std::lock_guard<std::mutex> g{mu_};
+  root.get_future()
+      .then(ChainFuture(resumable_stream_->Read()))
+      .then([this](future<absl::optional<SubscribeResponse>> response) {
+        OnRead(response.get());
+      });
+}
+
+void PartitionSubscriber::OnRead(absl::optional<SubscribeResponse> response) {
+  // optional not engaged implies that the retry loop has finished
+  if (!response) return Read();
+  if (!response->has_messages()) {
+    OnReadEnd();
+    return service_composite_.Abort(internal::AbortedError(
+        absl::StrCat("Invalid `Read` response: ", response->DebugString()),
+        GCP_ERROR_INFO()));
+  }
+
+  std::vector<SequencedMessage> messages;
+  Status status;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    for (auto& m : *response->mutable_messages()->mutable_messages()) {
+      status = ack_set_tracker_.Track(m.cursor().offset());
+      if (!status.ok()) break;
+      tokens_.set_allowed_messages(tokens_.allowed_messages() - 1);
+      tokens_.set_allowed_bytes(tokens_.allowed_bytes() - m.size_bytes());
+      if (tokens_.allowed_messages() < 0 || tokens_.allowed_bytes() < 0) {
+        status = internal::FailedPreconditionError(
+            "Server sent more messages than allowed by flow control.",
+            GCP_ERROR_INFO());
+        break;
+      }
+      last_offset_ = m.cursor().offset();
+      messages.push_back(std::move(m));
+    }
+  }
+  if (!status.ok()) {
+    OnReadEnd();
+    return service_composite_.Abort(std::move(status));
+  }
+
+  std::weak_ptr<PartitionSubscriber> self = shared_from_this();
+  for (auto& m : messages) {
+    auto const offset = m.cursor().offset();
+    auto const size_bytes = m.size_bytes();
+    status = callback_(
+        std::move(m),
+        std::make_unique<PartitionAckHandler>(self, offset, size_bytes));
+    if (!status.ok()) {
+      OnReadEnd();
+      return service_composite_.Abort(std::move(status));
+    }
+  }
+  Read();
+}
+
+void PartitionSubscriber::OnReadStart() {
+  std::lock_guard<std::mutex> g{mu_};
+  if (!reading_) reading_.emplace();
+}
+
+void PartitionSubscriber::OnReadEnd() {
+  absl::optional<promise<void>> read_done;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    read_done.swap(reading_);
+  }
+  if (read_done) read_done->set_value();
+}
+
+future<StatusOr<PartitionSubscriber::ResumableStreamImpl::UnderlyingStream>>
+PartitionSubscriber::Initializer(ResumableStreamImpl::UnderlyingStream stream) {
+  // By the time initializer is called, no outstanding Read() or Write()
+  // futures will be outstanding.
+  auto shared_stream = std::make_shared<ResumableStreamImpl::UnderlyingStream>(
+      std::move(stream));
+  SubscribeRequest request;
+  *request.mutable_initial() = initial_request_;
+  {
+    std::lock_guard<std::mutex> g{mu_};
+    // Resume after the last delivered message.
+    if (last_offset_) {
+      request.mutable_initial()
+          ->mutable_initial_location()
+          ->mutable_cursor()
+          ->set_offset(*last_offset_ + 1);
+    }
+  }
+  return (*shared_stream)
+      ->Write(request, grpc::WriteOptions())
+      .then([shared_stream](future<bool> write_response) {
+        if (!write_response.get()) {
+          return make_ready_future(absl::optional<SubscribeResponse>());
+        }
+        return (*shared_stream)->Read();
+      })
+      .then([this, shared_stream](
+                future<absl::optional<SubscribeResponse>> read_response) {
+        auto response = read_response.get();
+        if (!response || !response->has_initial()) {
+          return make_ready_future(false);
+        }
+        // The new stream starts without tokens, grant all the tokens held by
+        // the client.
+        SubscribeRequest flow_control;
+        {
+          std::lock_guard<std::mutex> g{mu_};
+          *flow_control.mutable_flow_control() = tokens_;
+          pending_tokens_.Clear();
+          ++grant_generation_;
+        }
+        return (*shared_stream)->Write(flow_control, grpc::WriteOptions());
+      })
+      .then([shared_stream](future<bool> write_response) {
+        if (write_response.get()) return make_ready_future(Status());
+        return (*shared_stream)->Finish();
+      })
+      .then([shared_stream](future<Status> f)
+                -> StatusOr<ResumableStreamImpl::UnderlyingStream> {
+        Status status = f.get();
+        if (!status.ok()) return status;
+        return std::move(*shared_stream);
+      });
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,149 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_PARTITION_SUBSCRIBER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_PARTITION_SUBSCRIBER_H
+
+#include "google/cloud/pubsub/ack_handler.h"
+#include "google/cloud/pubsublite/internal/ack_set_tracker.h"
+#include "google/cloud/pubsublite/internal/alarm_registry.h"
+#include "google/cloud/pubsublite/internal/committer.h"
+#include "google/cloud/pubsublite/internal/resumable_async_streaming_read_write_rpc.h"
+#include "google/cloud/pubsublite/internal/service_composite.h"
+#include "absl/functional/function_ref.h"
+#include <google/cloud/pubsublite/v1/subscriber.pb.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Receives the messages from a single partition.
+ *
+ * Messages are delivered to the callback one at a time, in order, from the
+ * thread that completed the `Read()`. The callback must not block, it returns
+ * an error to abort the subscriber.
+ */
+using PartitionMessageCallback = std::function<Status(
+    google::cloud::pubsublite::v1::SequencedMessage,
+    std::unique_ptr<google::cloud::pubsub::AckHandler::Impl>)>;
+
+/**
+ * Subscribes to a single partition, with flow control.
+ *
+ * The service only sends messages while the client holds flow control tokens.
+ * Each delivered message consumes one message token and `size_bytes` byte
+ * tokens, which are returned once the application acks the message. Returned
+ * tokens are sent in batches, either when they reach half of the configured
+ * limits or on each alarm. The acked messages also advance the cursor
+ * committed by the `Committer`.
+ *
+ * When the subscribe stream is resumed the subscriber seeks past the last
+ * delivered message and grants all the tokens it holds on the new stream.
+ *
+ * @note Objects of this class must be created with `std::make_shared<>`, the
+ *     ack handlers keep a weak reference to the subscriber.
+ */
+class PartitionSubscriber
+    : public Service,
+      public std::enable_shared_from_this<PartitionSubscriber> {
+ private:
+  using ResumableStream = ResumableAsyncStreamingReadWriteRpc<
+      google::cloud::pubsublite::v1::SubscribeRequest,
+      google::cloud::pubsublite::v1::SubscribeResponse>;
+  using ResumableStreamImpl = ResumableAsyncStreamingReadWriteRpcImpl<
+      google::cloud::pubsublite::v1::SubscribeRequest,
+      google::cloud::pubsublite::v1::SubscribeResponse>;
+
+ public:
+  PartitionSubscriber(
+      absl::FunctionRef<std::unique_ptr<ResumableStream>(
+          StreamInitializer<google::cloud::pubsublite::v1::SubscribeRequest,
+                            google::cloud::pubsublite::v1::SubscribeResponse>)>,
+      google::cloud::pubsublite::v1::InitialSubscribeRequest,
+      google::cloud::pubsublite::v1::FlowControlRequest flow_control_limits,
+      std::unique_ptr<Committer> committer, PartitionMessageCallback callback,
+      AlarmRegistry&, std::chrono::milliseconds alarm_period);
+
+  ~PartitionSubscriber() override;
+
+  future<Status> Start() override;
+
+  future<void> Shutdown() override;
+
+  /// Returns the tokens of an acked message and commits its cursor.
+  void Ack(std::int64_t offset, std::int64_t size_bytes);
+
+  /// Pub/Sub Lite does not support negative acknowledgements.
+  void Nack(std::int64_t offset);
+
+  /// Sends any pending flow control tokens.
+  void Flush();
+
+ private:
+  void Read();
+
+  void OnRead(
+      absl::optional<google::cloud::pubsublite::v1::SubscribeResponse>
+          response);
+
+  void OnReadStart();
+
+  void OnReadEnd();
+
+  future<StatusOr<ResumableStreamImpl::UnderlyingStream>> Initializer(
+      ResumableStreamImpl::UnderlyingStream stream);
+
+  google::cloud::pubsublite::v1::InitialSubscribeRequest const
+      initial_request_;
+  google::cloud::pubsublite::v1::FlowControlRequest const limits_;
+  PartitionMessageCallback const callback_;
+
+  std::mutex mu_;
+
+  std::unique_ptr<ResumableStream> const
+      resumable_stream_;  // ABSL_GUARDED_BY(mu_)
+  std::unique_ptr<Committer> const committer_;
+  ServiceComposite service_composite_;
+  // The tokens held by the client, i.e., the limits minus the tokens of the
+  // delivered but not acked messages.
+  google::cloud::pubsublite::v1::FlowControlRequest
+      tokens_;  // ABSL_GUARDED_BY(mu_)
+  // The tokens returned by the application but not sent yet.
+  google::cloud::pubsublite::v1::FlowControlRequest
+      pending_tokens_;  // ABSL_GUARDED_BY(mu_)
+  // Incremented each time `Initializer()` grants all of `tokens_` on a new
+  // stream. A failed write restores its tokens only if no newer grant
+  // included them.
+  std::uint64_t grant_generation_ = 0;            // ABSL_GUARDED_BY(mu_)
+  absl::optional<std::int64_t> last_offset_;      // ABSL_GUARDED_BY(mu_)
+  AckSetTracker ack_set_tracker_;                 // ABSL_GUARDED_BY(mu_)
+  bool writing_ = false;                          // ABSL_GUARDED_BY(mu_)
+  absl::optional<promise<void>> reading_;         // ABSL_GUARDED_BY(mu_)
+
+  std::unique_ptr<AlarmRegistry::CancelToken> cancel_token_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_PARTITION_SUBSCRIBER_H
@@ -0,0 +1,383 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsublite/internal/partition_subscriber.h"
+#include "google/cloud/mocks/mock_async_streaming_read_write_rpc.h"
+#include "google/cloud/pubsublite/testing/mock_alarm_registry.h"
+#include "google/cloud/pubsublite/testing/mock_resumable_async_reader_writer_stream.h"
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsub::AckHandler;
+using google::cloud::pubsublite::v1::FlowControlRequest;
+using google::cloud::pubsublite::v1::InitialCommitCursorRequest;
+using google::cloud::pubsublite::v1::InitialSubscribeRequest;
+using google::cloud::pubsublite::v1::InitialSubscribeResponse;
+using google::cloud::pubsublite::v1::SequencedMessage;
+using google::cloud::pubsublite::v1::StreamingCommitCursorRequest;
+using google::cloud::pubsublite::v1::StreamingCommitCursorResponse;
+using google::cloud::pubsublite::v1::SubscribeRequest;
+using google::cloud::pubsublite::v1::SubscribeResponse;
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::IsProtoEqual;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::_;
+using ::testing::ByMove;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::StrictMock;
+using ::testing::WithArg;
+
+using ::google::cloud::pubsublite_testing::MockAlarmRegistry;
+using ::google::cloud::pubsublite_testing::MockAlarmRegistryCancelToken;
+using ::google::cloud::pubsublite_testing::MockResumableAsyncReaderWriter;
+
+using AsyncReaderWriter =
+    google::cloud::mocks::MockAsyncStreamingReadWriteRpc<SubscribeRequest,
+                                                         SubscribeResponse>;
+
+using ReadResponse = absl::optional<SubscribeResponse>;
+using CommitReadResponse = absl::optional<StreamingCommitCursorResponse>;
+
+auto const kAlarmDuration = std::chrono::milliseconds{50};
+std::int64_t const kMessageBytes = 100;
+
+InitialSubscribeRequest MakeInitialRequest() {
+  InitialSubscribeRequest request;
+  request.set_subscription(
+      "projects/test-project/locations/us-central1-a/subscriptions/test-sub");
+  request.set_partition(2);
+  request.mutable_initial_location()->set_named_target(
+      google::cloud::pubsublite::v1::SeekRequest::COMMITTED_CURSOR);
+  return request;
+}
+
+FlowControlRequest MakeFlowControl(std::int64_t messages, std::int64_t bytes) {
+  FlowControlRequest flow_control;
+  flow_control.set_allowed_messages(messages);
+  flow_control.set_allowed_bytes(bytes);
+  return flow_control;
+}
+
+SubscribeRequest FlowControlRequestFor(std::int64_t messages,
+                                       std::int64_t bytes) {
+  SubscribeRequest request;
+  *request.mutable_flow_control() = MakeFlowControl(messages, bytes);
+  return request;
+}
+
+ReadResponse MessagesResponse(std::vector<std::int64_t> const& offsets) {
+  SubscribeResponse response;
+  for (auto offset : offsets) {
+    auto& m = *response.mutable_messages()->add_messages();
+    m.mutable_cursor()->set_offset(offset);
+    m.set_size_bytes(kMessageBytes);
+    m.mutable_message()->set_data(std::to_string(offset));
+  }
+  return response;
+}
+
+StreamingCommitCursorRequest CommitRequest(std::int64_t offset) {
+  StreamingCommitCursorRequest request;
+  request.mutable_commit()->mutable_cursor()->set_offset(offset);
+  return request;
+}
+
+class PartitionSubscriberTest : public ::testing::Test {
+ protected:
+  PartitionSubscriberTest()
+      : alarm_token_ref_{*(new StrictMock<MockAlarmRegistryCancelToken>)},
+        resumable_stream_ref_{*(
+            new StrictMock<MockResumableAsyncReaderWriter<SubscribeRequest,
+                                                          SubscribeResponse>>)},
+        commit_stream_ref_{
+            *(new StrictMock<MockResumableAsyncReaderWriter<
+                  StreamingCommitCursorRequest,
+                  StreamingCommitCursorResponse>>)} {
+    EXPECT_CALL(alarm_registry_, RegisterAlarm(kAlarmDuration, _))
+        // The committer's alarm, these tests do not ring it.
+        .WillOnce([](std::chrono::milliseconds, std::function<void()> const&) {
+          return std::unique_ptr<AlarmRegistry::CancelToken>(
+              new NiceMock<MockAlarmRegistryCancelToken>);
+        })
+        .WillOnce(WithArg<1>([&](std::function<void()> on_alarm) {
+          on_alarm_ = std::move(on_alarm);
+          return absl::WrapUnique(&alarm_token_ref_);
+        }));
+    auto committer = std::make_unique<Committer>(
+        [&](StreamInitializer<StreamingCommitCursorRequest,
+                              StreamingCommitCursorResponse>) {
+          return absl::WrapUnique(&commit_stream_ref_);
+        },
+        InitialCommitCursorRequest::default_instance(), alarm_registry_,
+        kAlarmDuration);
+    subscriber_ = std::make_shared<PartitionSubscriber>(
+        [&](StreamInitializer<SubscribeRequest, SubscribeResponse>
+                initializer) {
+          initializer_ = std::move(initializer);
+          return absl::WrapUnique(&resumable_stream_ref_);
+        },
+        MakeInitialRequest(), MakeFlowControl(4, 4 * kMessageBytes),
+        std::move(committer),
+        [this](SequencedMessage m, std::unique_ptr<AckHandler::Impl> handler) {
+          received_.push_back(m.cursor().offset());
+          handlers_.push_back(std::move(handler));
+          return Status();
+        },
+        alarm_registry_, kAlarmDuration);
+  }
+
+  // Starts the subscriber, the first `Read()` on the subscribe stream is
+  // satisfied by `read_promise_`.
+  future<Status> Start() {
+    EXPECT_CALL(resumable_stream_ref_, Start)
+        .WillOnce(Return(ByMove(start_promise_.get_future())));
+    EXPECT_CALL(resumable_stream_ref_, Read)
+        .WillOnce(Return(ByMove(read_promise_.get_future())));
+    EXPECT_CALL(commit_stream_ref_, Start)
+        .WillOnce(Return(ByMove(commit_start_promise_.get_future())));
+    EXPECT_CALL(commit_stream_ref_, Read)
+        .WillOnce(Return(ByMove(commit_read_promise_.get_future())));
+    return subscriber_->Start();
+  }
+
+  // Runs the initializer on a new underlying stream, expecting the subscriber
+  // to seek to @p initial and to grant @p tokens.
+  void InitializeStream(InitialSubscribeRequest const& initial,
+                        FlowControlRequest const& tokens) {
+    SubscribeRequest initial_request;
+    *initial_request.mutable_initial() = initial;
+    SubscribeResponse initial_response;
+    *initial_response.mutable_initial() =
+        InitialSubscribeResponse::default_instance();
+    SubscribeRequest flow_control;
+    *flow_control.mutable_flow_control() = tokens;
+
+    auto underlying_stream = std::make_unique<StrictMock<AsyncReaderWriter>>();
+    EXPECT_CALL(*underlying_stream, Write(IsProtoEqual(initial_request), _))
+        .WillOnce(Return(ByMove(make_ready_future(true))));
+    EXPECT_CALL(*underlying_stream, Read)
+        .WillOnce(Return(ByMove(make_ready_future(
+            absl::make_optional(std::move(initial_response))))));
+    EXPECT_CALL(*underlying_stream, Write(IsProtoEqual(flow_control), _))
+        .WillOnce(Return(ByMove(make_ready_future(true))));
+    EXPECT_THAT(initializer_(std::move(underlying_stream)).get(), IsOk());
+  }
+
+  // Shuts down the subscriber, satisfying any outstanding `Read()` calls.
+  void Shutdown(promise<ReadResponse>& outstanding_read) {
+    EXPECT_CALL(alarm_token_ref_, Destroy);
+    EXPECT_CALL(resumable_stream_ref_, Shutdown)
+        .WillOnce(Return(ByMove(make_ready_future())));
+    EXPECT_CALL(commit_stream_ref_, Shutdown)
+        .WillOnce(Return(ByMove(make_ready_future())));
+    auto shutdown = subscriber_->Shutdown();
+    start_promise_.set_value(Status());
+    commit_start_promise_.set_value(Status());
+    outstanding_read.set_value(ReadResponse());
+    commit_read_promise_.set_value(CommitReadResponse());
+    shutdown.get();
+  }
+
+  StreamInitializer<SubscribeRequest, SubscribeResponse> initializer_;
+  // the references remain valid until the subscriber is destroyed, see
+  // `partition_publisher_test.cc`
+  StrictMock<MockAlarmRegistryCancelToken>& alarm_token_ref_;
+  StrictMock<MockAlarmRegistry> alarm_registry_;
+  std::function<void()> on_alarm_;
+  StrictMock<MockResumableAsyncReaderWriter<SubscribeRequest,
+                                            SubscribeResponse>>&
+      resumable_stream_ref_;
+  StrictMock<MockResumableAsyncReaderWriter<StreamingCommitCursorRequest,
+                                            StreamingCommitCursorResponse>>&
+      commit_stream_ref_;
+  promise<Status> start_promise_;
+  promise<ReadResponse> read_promise_;
+  promise<Status> commit_start_promise_;
+  promise<CommitReadResponse> commit_read_promise_;
+  std::vector<std::int64_t> received_;
+  std::vector<std::unique_ptr<AckHandler::Impl>> handlers_;
+  std::shared_ptr<PartitionSubscriber> subscriber_;
+};
+
+TEST_F(PartitionSubscriberTest, StartNotCalled) {
+  EXPECT_CALL(alarm_token_ref_, Destroy);
+}
+
+TEST_F(PartitionSubscriberTest, AcksReturnTokensAndCommit) {
+  auto start = Start();
+  InitializeStream(MakeInitialRequest(), MakeFlowControl(4, 4 * kMessageBytes));
+
+  promise<ReadResponse> next_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(next_read.get_future())));
+  read_promise_.set_value(MessagesResponse({10, 11}));
+  EXPECT_THAT(received_, ElementsAre(10, 11));
+
+  // The tokens are returned on the next alarm, the cursor does not move until
+  // all the preceding messages are acked.
+  handlers_[1]->ack();
+  EXPECT_CALL(resumable_stream_ref_,
+              Write(IsProtoEqual(FlowControlRequestFor(1, kMessageBytes))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  on_alarm_();
+  // Nothing to send.
+  on_alarm_();
+
+  // The committer sends the latest cursor when it shuts down.
+  handlers_[0]->ack();
+  EXPECT_CALL(commit_stream_ref_, Write(IsProtoEqual(CommitRequest(12))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  Shutdown(next_read);
+  EXPECT_THAT(start.get(), IsOk());
+}
+
+TEST_F(PartitionSubscriberTest, FlushesWhenHalfTheTokensAreReturned) {
+  auto start = Start();
+  InitializeStream(MakeInitialRequest(), MakeFlowControl(4, 4 * kMessageBytes));
+
+  promise<ReadResponse> next_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(next_read.get_future())));
+  read_promise_.set_value(MessagesResponse({10, 11}));
+
+  handlers_[0]->ack();
+  EXPECT_CALL(resumable_stream_ref_,
+              Write(IsProtoEqual(FlowControlRequestFor(2, 2 * kMessageBytes))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  handlers_[1]->ack();
+
+  EXPECT_CALL(commit_stream_ref_, Write(IsProtoEqual(CommitRequest(12))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  Shutdown(next_read);
+  EXPECT_THAT(start.get(), IsOk());
+}
+
+TEST_F(PartitionSubscriberTest, ResumesAfterLastDeliveredMessage) {
+  auto start = Start();
+  InitializeStream(MakeInitialRequest(), MakeFlowControl(4, 4 * kMessageBytes));
+
+  promise<ReadResponse> next_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(next_read.get_future())));
+  read_promise_.set_value(MessagesResponse({10}));
+
+  // The unacked message still holds its tokens.
+  auto seek = MakeInitialRequest();
+  seek.mutable_initial_location()->mutable_cursor()->set_offset(11);
+  InitializeStream(seek, MakeFlowControl(3, 3 * kMessageBytes));
+
+  Shutdown(next_read);
+  EXPECT_THAT(start.get(), IsOk());
+}
+
+TEST_F(PartitionSubscriberTest, AcksWhileReconnecting) {
+  auto start = Start();
+  InitializeStream(MakeInitialRequest(), MakeFlowControl(4, 4 * kMessageBytes));
+
+  promise<ReadResponse> next_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(next_read.get_future())));
+  read_promise_.set_value(MessagesResponse({10, 11}));
+
+  // The stream is retrying, and the write fails. The tokens are not lost, they
+  // are sent on the next alarm.
+  handlers_[0]->ack();
+  EXPECT_CALL(resumable_stream_ref_,
+              Write(IsProtoEqual(FlowControlRequestFor(1, kMessageBytes))))
+      .WillOnce(Return(ByMove(make_ready_future(false))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  on_alarm_();
+  on_alarm_();
+  ::testing::Mock::VerifyAndClearExpectations(&resumable_stream_ref_);
+
+  // A newer stream is granted all the tokens, including those in the failed
+  // write, so they are not sent twice.
+  handlers_[1]->ack();
+  EXPECT_CALL(resumable_stream_ref_,
+              Write(IsProtoEqual(FlowControlRequestFor(1, kMessageBytes))))
+      .WillOnce(Return(ByMove(make_ready_future(false))));
+  on_alarm_();
+  auto seek = MakeInitialRequest();
+  seek.mutable_initial_location()->mutable_cursor()->set_offset(12);
+  InitializeStream(seek, MakeFlowControl(4, 4 * kMessageBytes));
+  on_alarm_();
+
+  EXPECT_CALL(commit_stream_ref_, Write(IsProtoEqual(CommitRequest(12))))
+      .WillOnce(Return(ByMove(make_ready_future(true))));
+  Shutdown(next_read);
+  EXPECT_THAT(start.get(), IsOk());
+}
+
+TEST_F(PartitionSubscriberTest, NackAborts) {
+  auto start = Start();
+  InitializeStream(MakeInitialRequest(), MakeFlowControl(4, 4 * kMessageBytes));
+
+  promise<ReadResponse> next_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(next_read.get_future())));
+  read_promise_.set_value(MessagesResponse({10}));
+  handlers_[0]->nack();
+  EXPECT_THAT(start.get(), StatusIs(StatusCode::kFailedPrecondition,
+                                    HasSubstr("does not support nacks")));
+
+  Shutdown(next_read);
+}
+
+TEST_F(PartitionSubscriberTest, TooManyMessagesAborts) {
+  auto start = Start();
+  InitializeStream(MakeInitialRequest(), MakeFlowControl(4, 4 * kMessageBytes));
+
+  read_promise_.set_value(MessagesResponse({10, 11, 12, 13, 14}));
+  EXPECT_THAT(start.get(), StatusIs(StatusCode::kFailedPrecondition));
+  EXPECT_THAT(received_, IsEmpty());
+
+  promise<ReadResponse> unused;
+  Shutdown(unused);
+}
+
+TEST_F(PartitionSubscriberTest, AckAfterDestructionIsIgnored) {
+  auto start = Start();
+  InitializeStream(MakeInitialRequest(), MakeFlowControl(4, 4 * kMessageBytes));
+
+  promise<ReadResponse> next_read;
+  EXPECT_CALL(resumable_stream_ref_, Read)
+      .WillOnce(Return(ByMove(next_read.get_future())));
+  read_promise_.set_value(MessagesResponse({10}));
+  Shutdown(next_read);
+  subscriber_.reset();
+
+  handlers_[0]->ack();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
@@ -20,10 +20,13 @@
 #include "google/cloud/pubsublite/internal/publisher_stub.h"
 #include "google/cloud/pubsublite/internal/subscriber_stub.h"
 #include "google/cloud/internal/async_read_write_stream_impl.h"
+#include "google/cloud/internal/base64_transforms.h"
 #include "google/cloud/version.h"
 #include <google/cloud/pubsublite/v1/cursor.grpc.pb.h>
 #include <google/cloud/pubsublite/v1/publisher.grpc.pb.h>
 #include <google/cloud/pubsublite/v1/subscriber.grpc.pb.h>
+#include <google/protobuf/struct.pb.h>
+#include <string>
 #include <unordered_map>
 
 namespace google {
@@ -37,6 +40,17 @@ using StreamFactory = std::function<
 
 using ClientMetadata = std::unordered_map<std::string, std::string>;
 
+/// Returns the value of the `x-goog-pubsub-context` metadata.
+inline std::string GetSerializedContext(std::string const& framework) {
+  google::protobuf::Struct context;
+  auto& metadata_map = *context.mutable_fields();
+  metadata_map["language"].set_string_value("CPP");
+  metadata_map["framework"].set_string_value(framework);
+  google::cloud::internal::Base64Encoder encoder;
+  for (unsigned char const c : context.SerializeAsString()) encoder.PushBack(c);
+  return std::move(encoder).FlushAndPad();
+}
+
 inline std::shared_ptr<grpc::ClientContext> MakeGrpcClientContext(
     ClientMetadata const& metadata) {
   auto context = std::make_shared<grpc::ClientContext>();
@@ -0,0 +1,74 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/internal/subscriber_connection_impl.h"
+#include "google/cloud/pubsublite/internal/default_subscribe_message_transformer.h"
+#include "google/cloud/pubsublite/internal/partition_callback_sequencer.h"
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::pubsub::AckHandler;
+using google::cloud::pubsublite::v1::SequencedMessage;
+
+SubscriberConnectionImpl::SubscriberConnectionImpl(
+    std::unique_ptr<BackgroundThreads> background,
+    SubscriberFactory subscriber_factory, Options opts)
+    : background_(std::move(background)),
+      subscriber_factory_(std::move(subscriber_factory)),
+      options_(std::move(opts)) {}
+
+future<Status> SubscriberConnectionImpl::Subscribe(SubscribeParams p) {
+  // The callback runs in the completion queue, not in the thread that read the
+  // messages, which also serves the streams for the other partitions.
+  auto sequencer = std::make_shared<PartitionCallbackSequencer>(
+      background_->cq(), std::move(p.callback));
+  auto subscriber = subscriber_factory_([sequencer](std::int64_t partition) {
+    return PartitionMessageCallback(
+        [sequencer, partition](SequencedMessage m,
+                               std::unique_ptr<AckHandler::Impl> handler) {
+          auto message = DefaultSubscribeMessageTransformer(partition, m);
+          if (!message) return std::move(message).status();
+          sequencer->Push(partition, *std::move(message),
+                          AckHandler(std::move(handler)));
+          return Status{};
+        });
+  });
+
+  std::weak_ptr<Service> w = subscriber;
+  promise<Status> done([w] {
+    if (auto s = w.lock()) s->Shutdown();
+  });
+  auto result = done.get_future();
+  subscriber->Start().then([subscriber, sequencer,
+                            done = std::move(done)](future<Status> f) mutable {
+    auto status = f.get();
+    // Satisfy the future only once all the streams are closed, and no
+    // callback is running.
+    subscriber->Shutdown()
+        .then([sequencer](future<void>) { return sequencer->Shutdown(); })
+        .then([subscriber, done = std::move(done),
+               status = std::move(status)](future<void>) mutable {
+          done.set_value(std::move(status));
+        });
+  });
+  return result;
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
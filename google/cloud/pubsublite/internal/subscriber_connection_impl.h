@@ -0,0 +1,69 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_SUBSCRIBER_CONNECTION_IMPL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_SUBSCRIBER_CONNECTION_IMPL_H
+
+#include "google/cloud/pubsub/subscriber_connection.h"
+#include "google/cloud/pubsublite/internal/partition_subscriber.h"
+#include "google/cloud/pubsublite/internal/service.h"
+#include "google/cloud/background_threads.h"
+#include "google/cloud/options.h"
+#include <functional>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace pubsublite_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A connection implementation for receiving messages from a single Pub/Sub Lite
+ * subscription.
+ *
+ * Each call to `Subscribe()` creates a new subscriber, which is shut down when
+ * the returned future is cancelled or when it fails. The messages are
+ * delivered to the application callback in the background threads, in order
+ * for each partition.
+ */
+class SubscriberConnectionImpl
+    : public google::cloud::pubsub::SubscriberConnection {
+ public:
+  /// Creates the callback for the messages received from a partition.
+  using CallbackFactory = std::function<PartitionMessageCallback(std::int64_t)>;
+  using SubscriberFactory =
+      std::function<std::shared_ptr<Service>(CallbackFactory)>;
+
+  SubscriberConnectionImpl(std::unique_ptr<BackgroundThreads> background,
+                           SubscriberFactory subscriber_factory, Options opts);
+
+  ~SubscriberConnectionImpl() override = default;
+
+  future<Status> Subscribe(SubscribeParams p) override;
+
+  Options options() override { return options_; }
+
+ private:
+  // Declared first so the background threads are joined last.
+  std::unique_ptr<BackgroundThreads> background_;
+  SubscriberFactory const subscriber_factory_;
+  Options const options_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_INTERNAL_SUBSCRIBER_CONNECTION_IMPL_H
@@ -63,6 +63,33 @@ struct PublishFlushAlarmPeriodOption {
   using Type = std::chrono::milliseconds;
 };
 
+/**
+ * The maximum number of messages delivered, but not yet acknowledged, for each
+ * partition. The default is 1000 messages.
+ *
+ * The service stops sending messages on a partition once this limit is
+ * reached, and resumes as the application acknowledges them.
+ */
+struct MaxPartitionOutstandingMessagesOption {
+  using Type = std::int64_t;
+};
+
+/**
+ * The maximum size of the messages delivered, but not yet acknowledged, for
+ * each partition. The default is 100MiB.
+ */
+struct MaxPartitionOutstandingBytesOption {
+  using Type = std::int64_t;
+};
+
+/**
+ * The interval at which subscribers commit the cursor of each partition and
+ * return flow control tokens to the service. The default is 50 milliseconds.
+ */
+struct SubscribeFlushAlarmPeriodOption {
+  using Type = std::chrono::milliseconds;
+};
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace pubsublite
 }  // namespace cloud
@@ -28,10 +28,8 @@
 #include "google/cloud/pubsublite/options.h"
 #include "google/cloud/common_options.h"
 #include "google/cloud/grpc_options.h"
-#include "google/cloud/internal/base64_transforms.h"
 #include "google/cloud/internal/make_status.h"
 #include "google/cloud/internal/unified_grpc_credentials.h"
-#include <google/protobuf/struct.pb.h>
 #include <functional>
 
 namespace google {
@@ -39,7 +37,6 @@ namespace cloud {
 namespace pubsublite {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
-using google::cloud::internal::Base64Encoder;
 using google::cloud::internal::MakeBackgroundThreadsFactory;
 using google::cloud::pubsub::PublisherConnection;
 using google::cloud::pubsub_internal::ContainingPublisherConnection;
@@ -53,6 +50,7 @@ using google::cloud::pubsublite_internal::ClientMetadata;
 using google::cloud::pubsublite_internal::CreateDefaultPublisherServiceStub;
 using google::cloud::pubsublite_internal::DefaultPublishMessageTransformer;
 using google::cloud::pubsublite_internal::DefaultRoutingPolicy;
+using google::cloud::pubsublite_internal::GetSerializedContext;
 using google::cloud::pubsublite_internal::MakeLocation;
 using google::cloud::pubsublite_internal::MakeStreamFactory;
 using google::cloud::pubsublite_internal::MultipartitionPublisher;
@@ -63,7 +61,6 @@ using google::cloud::pubsublite_internal::
 using google::cloud::pubsublite_internal::RetryPolicyFactory;
 using google::cloud::pubsublite_internal::StreamInitializer;
 using google::cloud::pubsublite_internal::StreamRetryPolicy;
-using google::protobuf::Struct;
 
 BatchingOptions MakeBatchingOptions(Options const& opts) {
   BatchingOptions batching_options;
@@ -88,16 +85,6 @@ StatusOr<std::string> GetEndpoint(std::string const& location) {
                       "-pubsublite.googleapis.com");
 }
 
-std::string GetSerializedContext(std::string const& framework) {
-  Struct context;
-  auto& metadata_map = *context.mutable_fields();
-  metadata_map["language"].set_string_value("CPP");
-  metadata_map["framework"].set_string_value(framework);
-  Base64Encoder encoder;
-  for (unsigned char const c : context.SerializeAsString()) encoder.PushBack(c);
-  return std::move(encoder).FlushAndPad();
-}
-
 ClientMetadata MakeClientMetadata(Topic const& topic, std::uint32_t partition) {
   ClientMetadata metadata;
   metadata["x-goog-request-params"] =
@@ -18,17 +18,24 @@
 
 pubsublite_unit_tests = [
     "endpoint_test.cc",
+    "internal/ack_set_tracker_test.cc",
     "internal/alarm_registry_impl_test.cc",
+    "internal/assigning_subscriber_test.cc",
+    "internal/committer_test.cc",
     "internal/default_publish_message_transformer_test.cc",
     "internal/default_routing_policy_test.cc",
+    "internal/default_subscribe_message_transformer_test.cc",
     "internal/location_test.cc",
     "internal/multipartition_publisher_test.cc",
+    "internal/partition_callback_sequencer_test.cc",
     "internal/partition_publisher_test.cc",
+    "internal/partition_subscriber_test.cc",
     "internal/publisher_connection_impl_test.cc",
     "internal/resumable_async_streaming_read_write_rpc_test.cc",
     "internal/service_composite_test.cc",
     "internal/stream_factory_test.cc",
     "internal/stream_retry_policy_test.cc",
     "message_metadata_test.cc",
+    "subscription_test.cc",
     "topic_test.cc",
 ]
@@ -0,0 +1,241 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/subscriber_connection.h"
+#include "google/cloud/pubsublite/endpoint.h"
+#include "google/cloud/pubsublite/internal/alarm_registry_impl.h"
+#include "google/cloud/pubsublite/internal/assigning_subscriber.h"
+#include "google/cloud/pubsublite/internal/committer.h"
+#include "google/cloud/pubsublite/internal/cursor_stub_factory.h"
+#include "google/cloud/pubsublite/internal/location.h"
+#include "google/cloud/pubsublite/internal/partition_assignment_stub_factory.h"
+#include "google/cloud/pubsublite/internal/partition_subscriber.h"
+#include "google/cloud/pubsublite/internal/stream_factory.h"
+#include "google/cloud/pubsublite/internal/stream_retry_policy.h"
+#include "google/cloud/pubsublite/internal/subscriber_connection_impl.h"
+#include "google/cloud/pubsublite/internal/subscriber_stub_factory.h"
+#include "google/cloud/pubsublite/options.h"
+#include "google/cloud/common_options.h"
+#include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/make_status.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/internal/unified_grpc_credentials.h"
+
+namespace google {
+namespace cloud {
+namespace pubsublite {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using google::cloud::internal::MakeBackgroundThreadsFactory;
+using google::cloud::pubsub::SubscriberConnection;
+using google::cloud::pubsublite::v1::FlowControlRequest;
+using google::cloud::pubsublite::v1::InitialCommitCursorRequest;
+using google::cloud::pubsublite::v1::InitialPartitionAssignmentRequest;
+using google::cloud::pubsublite::v1::InitialSubscribeRequest;
+using google::cloud::pubsublite::v1::PartitionAssignment;
+using google::cloud::pubsublite::v1::PartitionAssignmentRequest;
+using google::cloud::pubsublite::v1::SeekRequest;
+using google::cloud::pubsublite::v1::StreamingCommitCursorRequest;
+using google::cloud::pubsublite::v1::StreamingCommitCursorResponse;
+using google::cloud::pubsublite::v1::SubscribeRequest;
+using google::cloud::pubsublite::v1::SubscribeResponse;
+using google::cloud::pubsublite_internal::AlarmRegistryImpl;
+using google::cloud::pubsublite_internal::AssigningSubscriber;
+using google::cloud::pubsublite_internal::AsyncSleeper;
+using google::cloud::pubsublite_internal::ClientMetadata;
+using google::cloud::pubsublite_internal::Committer;
+using google::cloud::pubsublite_internal::CreateDefaultCursorServiceStub;
+using google::cloud::pubsublite_internal::
+    CreateDefaultPartitionAssignmentServiceStub;
+using google::cloud::pubsublite_internal::CreateDefaultSubscriberServiceStub;
+using google::cloud::pubsublite_internal::GetSerializedContext;
+using google::cloud::pubsublite_internal::MakeLocation;
+using google::cloud::pubsublite_internal::MakeStreamFactory;
+using google::cloud::pubsublite_internal::PartitionSubscriber;
+using google::cloud::pubsublite_internal::ResumableAsyncStreamingReadWriteRpc;
+using google::cloud::pubsublite_internal::
+    ResumableAsyncStreamingReadWriteRpcImpl;
+using google::cloud::pubsublite_internal::Service;
+using google::cloud::pubsublite_internal::StreamFactory;
+using google::cloud::pubsublite_internal::StreamInitializer;
+using google::cloud::pubsublite_internal::StreamRetryPolicy;
+using google::cloud::pubsublite_internal::SubscriberConnectionImpl;
+
+namespace {
+
+template <typename Request, typename Response>
+std::unique_ptr<ResumableAsyncStreamingReadWriteRpc<Request, Response>>
+MakeResumableStream(std::shared_ptr<BackoffPolicy const> backoff_policy,
+                    AsyncSleeper sleeper,
+                    StreamFactory<Request, Response> stream_factory,
+                    StreamInitializer<Request, Response> initializer) {
+  return std::make_unique<
+      ResumableAsyncStreamingReadWriteRpcImpl<Request, Response>>(
+      [] { return std::make_unique<StreamRetryPolicy>(); },
+      std::move(backoff_policy), std::move(sleeper), std::move(stream_factory),
+      std::move(initializer));
+}
+
+ClientMetadata MakeClientMetadata(std::string request_params) {
+  ClientMetadata metadata;
+  metadata["x-goog-request-params"] = std::move(request_params);
+  metadata["x-goog-pubsub-context"] = GetSerializedContext("CLOUD_PUBSUB_SHIM");
+  return metadata;
+}
+
+ClientMetadata MakeClientMetadata(Subscription const& subscription,
+                                  std::int64_t partition) {
+  return MakeClientMetadata(absl::StrCat("partition=", partition, "&",
+                                         "subscription=",
+                                         subscription.FullName()));
+}
+
+Options SubscriberDefaultOptions(Options opts) {
+  if (!opts.has<MaxPartitionOutstandingMessagesOption>()) {
+    opts.set<MaxPartitionOutstandingMessagesOption>(1000);
+  }
+  if (!opts.has<MaxPartitionOutstandingBytesOption>()) {
+    opts.set<MaxPartitionOutstandingBytesOption>(100 * 1024 * 1024L);
+  }
+  if (!opts.has<SubscribeFlushAlarmPeriodOption>()) {
+    opts.set<SubscribeFlushAlarmPeriodOption>(std::chrono::milliseconds{50});
+  }
+  return opts;
+}
+
+}  // namespace
+
+StatusOr<std::unique_ptr<SubscriberConnection>> MakeSubscriberConnection(
+    Subscription subscription, Options opts) {
+  if (!opts.has<GrpcNumChannelsOption>()) {
+    // Each channel has a limit of 100 outstanding RPCs, each partition uses two
+    // of them.
+    opts.set<GrpcNumChannelsOption>(20);
+  }
+
+  opts = SubscriberDefaultOptions(
+      google::cloud::internal::PopulateGrpcOptions(std::move(opts)));
+  if (!opts.has<EndpointOption>()) {
+    // need to parse the location because if it's a zone we need to extract the
+    // region to form the endpoint
+    auto location = MakeLocation(subscription.location_id());
+    if (!location) {
+      return internal::InvalidArgumentError("`subscription` not valid",
+                                            GCP_ERROR_INFO());
+    }
+    auto endpoint = EndpointFromRegion(location->GetCloudRegion().ToString());
+    if (!endpoint) return std::move(endpoint).status();
+    opts.set<EndpointOption>(*std::move(endpoint));
+  }
+  opts = google::cloud::internal::PopulateCommonOptions(
+      std::move(opts), /*endpoint_env_var=*/{}, /*emulator_env_var=*/{},
+      /*authority_env_var=*/{}, "pubsublite.googleapis.com");
+
+  std::unique_ptr<BackgroundThreads> background_threads =
+      MakeBackgroundThreadsFactory(opts)();
+  CompletionQueue cq = background_threads->cq();
+
+  auto const backoff_policy = std::make_shared<ExponentialBackoffPolicy>(
+      std::chrono::milliseconds{10}, std::chrono::seconds{10}, 2.0);
+  AsyncSleeper sleeper = [cq](std::chrono::milliseconds backoff_time) mutable {
+    return cq.MakeRelativeTimer(backoff_time)
+        .then([](future<StatusOr<std::chrono::system_clock::time_point>> f) {
+          auto status = f.get();
+          if (!status.ok()) {
+            GCP_LOG(INFO) << "`MakeRelativeTimer` returned a non-ok status: "
+                          << status.status();
+          };
+        });
+  };
+
+  auto auth = internal::CreateAuthenticationStrategy(cq, opts);
+  auto subscriber_stub = CreateDefaultSubscriberServiceStub(auth, opts);
+  auto cursor_stub = CreateDefaultCursorServiceStub(auth, opts);
+  auto assignment_stub =
+      CreateDefaultPartitionAssignmentServiceStub(std::move(auth), opts);
+
+  FlowControlRequest limits;
+  limits.set_allowed_messages(
+      opts.get<MaxPartitionOutstandingMessagesOption>());
+  limits.set_allowed_bytes(opts.get<MaxPartitionOutstandingBytesOption>());
+  auto const alarm_period = opts.get<SubscribeFlushAlarmPeriodOption>();
+
+  auto subscriber_factory =
+      [=](SubscriberConnectionImpl::CallbackFactory const& make_callback)
+      -> std::shared_ptr<Service> {
+    auto partition_factory =
+        [=](std::int64_t partition) -> std::shared_ptr<Service> {
+      AlarmRegistryImpl alarm_registry{cq};
+      auto const metadata = MakeClientMetadata(subscription, partition);
+
+      InitialCommitCursorRequest commit_request;
+      commit_request.set_subscription(subscription.FullName());
+      commit_request.set_partition(partition);
+      auto committer = std::make_unique<Committer>(
+          [&](StreamInitializer<StreamingCommitCursorRequest,
+                                StreamingCommitCursorResponse>
+                  initializer) {
+            return MakeResumableStream(
+                backoff_policy, sleeper,
+                MakeStreamFactory(cursor_stub, cq, metadata),
+                std::move(initializer));
+          },
+          std::move(commit_request), alarm_registry, alarm_period);
+
+      InitialSubscribeRequest subscribe_request;
+      subscribe_request.set_subscription(subscription.FullName());
+      subscribe_request.set_partition(partition);
+      subscribe_request.mutable_initial_location()->set_named_target(
+          SeekRequest::COMMITTED_CURSOR);
+      return std::make_shared<PartitionSubscriber>(
+          [&](StreamInitializer<SubscribeRequest, SubscribeResponse>
+                  initializer) {
+            return MakeResumableStream(
+                backoff_policy, sleeper,
+                MakeStreamFactory(subscriber_stub, cq, metadata),
+                std::move(initializer));
+          },
+          std::move(subscribe_request), limits, std::move(committer),
+          make_callback(partition), alarm_registry, alarm_period);
+    };
+
+    InitialPartitionAssignmentRequest assignment_request;
+    assignment_request.set_subscription(subscription.FullName());
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    assignment_request.set_client_id(google::cloud::internal::Sample(
+        generator, 16, "abcdefghijklmnopqrstuvwxyz0123456789"));
+    return std::make_shared<AssigningSubscriber>(
+        [&](StreamInitializer<PartitionAssignmentRequest, PartitionAssignment>
+                initializer) {
+          return MakeResumableStream(
+              backoff_policy, sleeper,
+              MakeStreamFactory(
+                  assignment_stub, cq,
+                  MakeClientMetadata(absl::StrCat("subscription=",
+                                                  subscription.FullName()))),
+              std::move(initializer));
+        },
+        std::move(partition_factory), std::move(assignment_request));
+  };
+
+  return std::unique_ptr<SubscriberConnection>(
+      std::make_unique<SubscriberConnectionImpl>(std::move(background_threads),
+                                                 std::move(subscriber_factory),
+                                                 std::move(opts)));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,59 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_SUBSCRIBER_CONNECTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_SUBSCRIBER_CONNECTION_H
+
+#include "google/cloud/pubsub/subscriber_connection.h"
+#include "google/cloud/pubsublite/subscription.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status_or.h"
+
+namespace google {
+namespace cloud {
+namespace pubsublite {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Creates a new `SubscriberConnection` object to work with `Subscriber`.
+ *
+ * The returned connection joins the partition assignment for @p subscription:
+ * the service balances the partitions across all the clients subscribed to
+ * it, and each client opens one stream per assigned partition. Messages from
+ * the same partition are delivered in order, one at a time. Messages from
+ * different partitions are delivered concurrently, using the background
+ * threads configured in @p opts.
+ *
+ * The cursor of each partition is committed periodically, as the messages are
+ * acknowledged. Pub/Sub Lite does not support negative acknowledgements,
+ * calling `AckHandler::nack()` (or destroying the handler without calling
+ * `ack()`) stops the subscriber with an error.
+ *
+ * @param subscription the Cloud Pub/Sub Lite subscription used by the returned
+ *     `SubscriberConnection`.
+ * @param opts The options to use for this call. Expected options are any of
+ *     the types in the following option lists and in
+ * google/cloud/pubsublite/options.h.
+ *       - `google::cloud::CommonOptionList`
+ *       - `google::cloud::GrpcOptionList`
+ */
+StatusOr<std::unique_ptr<google::cloud::pubsub::SubscriberConnection>>
+MakeSubscriberConnection(Subscription subscription, Options opts);
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_SUBSCRIBER_CONNECTION_H
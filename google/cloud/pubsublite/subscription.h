@@ -0,0 +1,82 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_SUBSCRIPTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_SUBSCRIPTION_H
+
+#include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/location.h"
+#include "google/cloud/version.h"
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace pubsublite {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Objects of this class identify a Cloud Pub/Sub Lite subscription.
+ *
+ * @note
+ * This class makes no effort to validate the ids provided.
+ */
+class Subscription {
+ public:
+  Subscription(std::string project_id, std::string location_id,
+               std::string subscription_id)
+      : project_id_{std::move(project_id)},
+        location_id_{std::move(location_id)},
+        subscription_id_{std::move(subscription_id)} {}
+
+  std::string const& project_id() const { return project_id_; }
+
+  std::string const& location_id() const { return location_id_; }
+
+  std::string const& subscription_id() const { return subscription_id_; }
+
+  /**
+   * Returns the fully qualified subscription name as a string of the form:
+   * "projects/<project-id>/locations/<location>/subscriptions/<id>"
+   */
+  std::string FullName() const {
+    return absl::StrCat(Location(project_id_, location_id_).FullName(),
+                        "/subscriptions/", subscription_id_);
+  }
+
+ private:
+  std::string project_id_;
+  std::string location_id_;
+  std::string subscription_id_;
+};
+
+inline bool operator==(Subscription const& a, Subscription const& b) {
+  return a.project_id() == b.project_id() &&
+         a.location_id() == b.location_id() &&
+         a.subscription_id() == b.subscription_id();
+}
+
+inline bool operator!=(Subscription const& a, Subscription const& b) {
+  return !(a == b);
+}
+
+inline std::ostream& operator<<(std::ostream& os, Subscription const& rhs) {
+  return os << rhs.FullName();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUBLITE_SUBSCRIPTION_H
@@ -0,0 +1,52 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsublite/subscription.h"
+#include "google/cloud/internal/absl_str_join_quiet.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace pubsublite {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+TEST(Subscription, BasicSubscription) {
+  std::string project = "project";
+  std::string location = "location";
+  std::string subscription_name = "subscription_name";
+
+  Subscription subscription{project, location, subscription_name};
+  EXPECT_EQ(project, subscription.project_id());
+  EXPECT_EQ(location, subscription.location_id());
+  EXPECT_EQ(subscription_name, subscription.subscription_id());
+  EXPECT_EQ(subscription.FullName(),
+            "projects/project/locations/location/subscriptions/"
+            "subscription_name");
+}
+
+TEST(Subscription, Equality) {
+  Subscription a{"project", "location", "a"};
+  Subscription b{"project", "location", "b"};
+  EXPECT_EQ(a, a);
+  EXPECT_NE(a, b);
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace pubsublite
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,205 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/bulk_writer.h"
+#include "google/cloud/spanner/options.h"
+#include "google/cloud/internal/make_status.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+auto constexpr kDefaultMaxMutationsPerGroup = std::size_t{2000};
+auto constexpr kDefaultMaxGroupBytes = std::size_t{1024 * 1024};
+auto constexpr kDefaultMaxRequestBytes = std::size_t{4 * 1024 * 1024};
+auto constexpr kDefaultConcurrency = std::size_t{4};
+
+template <typename Option>
+std::size_t GetOrDefault(Options const& opts, std::size_t default_value) {
+  if (!opts.has<Option>()) return default_value;
+  return (std::max)(opts.get<Option>(), std::size_t{1});
+}
+
+google::spanner::v1::Mutation::Write const* AsWrite(
+    google::spanner::v1::Mutation const& m) {
+  switch (m.operation_case()) {
+    case google::spanner::v1::Mutation::kInsert:
+      return &m.insert();
+    case google::spanner::v1::Mutation::kUpdate:
+      return &m.update();
+    case google::spanner::v1::Mutation::kInsertOrUpdate:
+      return &m.insert_or_update();
+    case google::spanner::v1::Mutation::kReplace:
+      return &m.replace();
+    default:
+      break;
+  }
+  return nullptr;
+}
+
+std::string const& TableName(google::spanner::v1::Mutation const& m) {
+  if (auto const* w = AsWrite(m)) return w->table();
+  return m.delete_().table();
+}
+
+// Cloud Spanner counts each column affected by a write, and each key or range
+// in a delete, towards the commit limits.
+std::size_t MutationCount(google::spanner::v1::Mutation const& m) {
+  if (auto const* w = AsWrite(m)) {
+    return static_cast<std::size_t>(w->columns_size()) *
+           static_cast<std::size_t>(w->values_size());
+  }
+  auto const& ks = m.delete_().key_set();
+  if (ks.all()) return 1;
+  return static_cast<std::size_t>(ks.keys_size() + ks.ranges_size());
+}
+
+}  // namespace
+
+BulkWriter::BulkWriter(Client client, Options opts)
+    : client_(std::move(client)),
+      max_mutations_per_group_(
+          GetOrDefault<BulkWriteMaxMutationsPerGroupOption>(
+              opts, kDefaultMaxMutationsPerGroup)),
+      max_group_bytes_(GetOrDefault<BulkWriteMaxGroupBytesOption>(
+          opts, kDefaultMaxGroupBytes)),
+      max_request_bytes_(GetOrDefault<BulkWriteMaxRequestBytesOption>(
+          opts, kDefaultMaxRequestBytes)),
+      concurrency_(
+          GetOrDefault<BulkWriteConcurrencyOption>(opts, kDefaultConcurrency)) {
+  opts.unset<BulkWriteMaxMutationsPerGroupOption>();
+  opts.unset<BulkWriteMaxGroupBytesOption>();
+  opts.unset<BulkWriteMaxRequestBytesOption>();
+  opts.unset<BulkWriteConcurrencyOption>();
+  opts_ = std::move(opts);
+  workers_.reserve(concurrency_);
+  for (std::size_t i = 0; i != concurrency_; ++i) {
+    workers_.emplace_back(&BulkWriter::RunWorker, this);
+  }
+}
+
+BulkWriter::~BulkWriter() { Close(); }
+
+void BulkWriter::Add(Mutation mutation) {
+  auto const& proto = spanner_internal::MutationInternals::Proto(mutation);
+  auto const count = MutationCount(proto);
+  auto const bytes = proto.ByteSizeLong();
+  auto& group = groups_[TableName(proto)];
+  if (!group.mutations.empty() &&
+      (group.mutation_count + count > max_mutations_per_group_ ||
+       group.bytes + bytes > max_group_bytes_)) {
+    SealGroup(std::exchange(group, Group{}));
+  }
+  group.mutations.push_back(std::move(mutation));
+  group.mutation_count += count;
+  group.bytes += bytes;
+}
+
+std::vector<BulkWriteFailure> BulkWriter::Close() {
+  if (workers_.empty()) return {};
+  for (auto& kv : groups_) SealGroup(std::move(kv.second));
+  groups_.clear();
+  FlushBatch();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& w : workers_) w.join();
+  workers_.clear();
+  return std::move(failures_);
+}
+
+void BulkWriter::SealGroup(Group group) {
+  if (group.mutations.empty()) return;
+  if (!batch_.empty() && batch_bytes_ + group.bytes > max_request_bytes_) {
+    FlushBatch();
+  }
+  batch_.push_back(std::move(group.mutations));
+  batch_bytes_ += group.bytes;
+}
+
+void BulkWriter::FlushBatch() {
+  if (batch_.empty()) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  // Allow one request queued for each worker, and block the application
+  // beyond that.
+  cv_.wait(lk, [this] { return pending_.size() < concurrency_; });
+  pending_.push_back(std::move(batch_));
+  lk.unlock();
+  cv_.notify_all();
+  batch_.clear();
+  batch_bytes_ = 0;
+}
+
+void BulkWriter::RunWorker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !pending_.empty(); });
+    if (pending_.empty()) return;
+    auto batch = std::move(pending_.front());
+    pending_.pop_front();
+    lk.unlock();
+    cv_.notify_all();
+    Commit(std::move(batch));
+    lk.lock();
+  }
+}
+
+void BulkWriter::Commit(std::vector<Mutations> batch) {
+  std::vector<bool> reported(batch.size(), false);
+  std::vector<BulkWriteFailure> failures;
+  auto fail = [&](std::size_t index, Status const& status) {
+    if (index >= batch.size() || reported[index]) return;
+    reported[index] = true;
+    failures.push_back(BulkWriteFailure{std::move(batch[index]), status});
+  };
+
+  Status stream_status;
+  for (auto& result : client_.CommitAtLeastOnce(batch, opts_)) {
+    if (!result) {
+      stream_status = std::move(result).status();
+      break;
+    }
+    for (auto index : result->indexes) {
+      if (!result->commit_timestamp) {
+        fail(index, result->commit_timestamp.status());
+      } else if (index < batch.size()) {
+        reported[index] = true;
+      }
+    }
+  }
+  // The outcome of any groups without a result is unknown. Report them as
+  // failures, so the application can retry them.
+  if (stream_status.ok()) {
+    stream_status = google::cloud::internal::UnknownError(
+        "no result received for mutation group", GCP_ERROR_INFO());
+  }
+  for (std::size_t i = 0; i != batch.size(); ++i) fail(i, stream_status);
+
+  if (failures.empty()) return;
+  std::lock_guard<std::mutex> lk(mu_);
+  failures_.insert(failures_.end(), std::make_move_iterator(failures.begin()),
+                   std::make_move_iterator(failures.end()));
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,167 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_BULK_WRITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_BULK_WRITER_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/mutations.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/options.h"
+#include "google/cloud/status.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * A mutation group that could not be committed by a `BulkWriter`.
+ */
+struct BulkWriteFailure {
+  /// The mutations in the group. None of them, or all of them, were applied.
+  Mutations mutation_group;
+
+  /// The reason why the group failed.
+  Status status;
+};
+
+/**
+ * Applies a large stream of mutations using concurrent `BatchWrite` RPCs.
+ *
+ * `Client::CommitAtLeastOnce()` applies a vector of mutation groups, but the
+ * application must split its data into groups that fit in the commit limits,
+ * and drive any concurrency. This class does both: the application calls
+ * `Add()` with each mutation, and the writer:
+ *
+ * - Estimates the number of mutations (as counted by Cloud Spanner, that is,
+ *   each affected column) and the size of each `spanner::Mutation`.
+ * - Groups consecutive mutations for the same table, up to
+ *   `BulkWriteMaxMutationsPerGroupOption` mutations and
+ *   `BulkWriteMaxGroupBytesOption` bytes.
+ * - Batches the groups in requests of up to `BulkWriteMaxRequestBytesOption`
+ *   bytes, and sends up to `BulkWriteConcurrencyOption` requests concurrently.
+ *   The requests use sessions from the session pool in the `Client`.
+ *
+ * `Add()` blocks when the requests are not completing as fast as the
+ * application is adding mutations, which bounds the memory usage.
+ *
+ * The writer does not know the primary key of each table, and does not sort
+ * the mutations. **Add the mutations for each table in primary key order**.
+ * Then each group covers a contiguous range of keys, and Cloud Spanner can
+ * apply it in a few splits. With unordered input each group may span the whole
+ * table, which makes the commits slower.
+ *
+ * Like `Client::CommitAtLeastOnce()`, each group is applied atomically, but
+ * there is no ordering or atomicity between groups, and a group may be applied
+ * more than once. Mutations in different groups must be independent, and
+ * should be idempotent (e.g. use `InsertOrUpdateMutationBuilder`).
+ *
+ * @par Example
+ * @code
+ * namespace spanner = ::google::cloud::spanner;
+ * spanner::BulkWriter writer(client);
+ * for (auto const& row : rows) {
+ *   writer.Add(spanner::MakeInsertOrUpdateMutation(
+ *       "Singers", {"SingerId", "FirstName"}, row.id, row.first_name));
+ * }
+ * for (auto const& failure : writer.Close()) {
+ *   std::cerr << "group failed: " << failure.status << "\n";
+ * }
+ * @endcode
+ */
+class BulkWriter {
+ public:
+  /**
+   * Creates a writer.
+   *
+   * @param client the client used to send the `BatchWrite` RPCs.
+   * @param opts (optional) configure the writer, using any options in
+   *     `BulkWriteOptionList`. Any other options, such as
+   *     `RequestPriorityOption` or `TransactionTagOption`, are used in each
+   *     `Client::CommitAtLeastOnce()` call.
+   */
+  explicit BulkWriter(Client client, Options opts = {});
+
+  /// Commits any pending mutations, and discards any failures.
+  ~BulkWriter();
+
+  BulkWriter(BulkWriter const&) = delete;
+  BulkWriter& operator=(BulkWriter const&) = delete;
+
+  /**
+   * Adds a mutation to the writer.
+   *
+   * The mutation is sent when its group is full, or when the writer is closed.
+   * This function blocks if too many requests are pending. Add the mutations
+   * for each table in primary key order, see above.
+   */
+  void Add(Mutation mutation);
+
+  /**
+   * Commits all the pending mutations and returns the groups that failed.
+   *
+   * The application may retry the failed groups with a new writer, or with
+   * `Client::CommitAtLeastOnce()`. Calling `Add()` after `Close()` is not
+   * supported.
+   */
+  std::vector<BulkWriteFailure> Close();
+
+ private:
+  struct Group {
+    Mutations mutations;
+    std::size_t mutation_count = 0;
+    std::size_t bytes = 0;
+  };
+
+  void SealGroup(Group group);
+  void FlushBatch();
+  void RunWorker();
+  void Commit(std::vector<Mutations> batch);
+
+  Client client_;
+  Options opts_;
+  std::size_t max_mutations_per_group_;
+  std::size_t max_group_bytes_;
+  std::size_t max_request_bytes_;
+  std::size_t concurrency_;
+
+  // The open group for each table, and the batch being built. Only used by the
+  // thread calling `Add()` and `Close()`.
+  std::map<std::string, Group> groups_;
+  std::vector<Mutations> batch_;
+  std::size_t batch_bytes_ = 0;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::vector<Mutations>> pending_;
+  std::vector<BulkWriteFailure> failures_;
+  bool shutdown_ = false;
+  std::vector<std::thread> workers_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_BULK_WRITER_H
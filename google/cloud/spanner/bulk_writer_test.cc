@@ -0,0 +1,198 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/bulk_writer.h"
+#include "google/cloud/mocks/mock_stream_range.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/spanner/options.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/time/time.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+using ::testing::UnorderedElementsAreArray;
+
+Mutation MakeRow(std::string const& table, std::int64_t id) {
+  return MakeInsertOrUpdateMutation(table, {"Id", "Name"}, id,
+                                    "name-" + std::to_string(id));
+}
+
+// Returns a successful result for all the groups in the request.
+BatchedCommitResultStream Success(Connection::BatchWriteParams const& p) {
+  BatchedCommitResult result{{}, MakeTimestamp(absl::UnixEpoch()).value()};
+  for (std::size_t i = 0; i != p.mutation_groups.size(); ++i) {
+    result.indexes.push_back(i);
+  }
+  return mocks::MakeStreamRange<BatchedCommitResult>({std::move(result)});
+}
+
+TEST(BulkWriterTest, GroupsByTable) {
+  std::mutex mu;
+  std::vector<Mutations> groups;
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, BatchWrite)
+      .WillRepeatedly([&](Connection::BatchWriteParams const& p) {
+        EXPECT_EQ(p.options.get<RequestTagOption>(), "test-tag");
+        EXPECT_FALSE(p.options.has<BulkWriteConcurrencyOption>());
+        std::lock_guard<std::mutex> lk(mu);
+        groups.insert(groups.end(), p.mutation_groups.begin(),
+                      p.mutation_groups.end());
+        return Success(p);
+      });
+
+  std::vector<Mutation> expected;
+  {
+    // Each mutation changes 2 columns in one row, so at most 2 mutations fit
+    // in each group.
+    BulkWriter writer(Client(conn),
+                      Options{}
+                          .set<BulkWriteMaxMutationsPerGroupOption>(4)
+                          .set<BulkWriteConcurrencyOption>(2)
+                          .set<RequestTagOption>("test-tag"));
+    for (std::int64_t i = 0; i != 5; ++i) {
+      expected.push_back(MakeRow("T1", i));
+      writer.Add(expected.back());
+      expected.push_back(MakeRow("T2", i));
+      writer.Add(expected.back());
+    }
+    EXPECT_THAT(writer.Close(), IsEmpty());
+  }
+
+  ASSERT_THAT(groups, SizeIs(6));
+  std::vector<Mutation> actual;
+  for (auto const& g : groups) {
+    ASSERT_FALSE(g.empty());
+    EXPECT_LE(g.size(), 2U);
+    for (auto const& m : g) {
+      // All the mutations in a group are for the same table.
+      EXPECT_EQ(m.as_proto().insert_or_update().table(),
+                g.front().as_proto().insert_or_update().table());
+      actual.push_back(m);
+    }
+  }
+  EXPECT_THAT(actual, UnorderedElementsAreArray(expected));
+}
+
+TEST(BulkWriterTest, MaxRequestBytes) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, BatchWrite)
+      .Times(3)
+      .WillRepeatedly([&](Connection::BatchWriteParams const& p) {
+        EXPECT_THAT(p.mutation_groups, SizeIs(1));
+        return Success(p);
+      });
+
+  BulkWriter writer(Client(conn),
+                    Options{}
+                        .set<BulkWriteMaxMutationsPerGroupOption>(2)
+                        .set<BulkWriteMaxRequestBytesOption>(1)
+                        .set<BulkWriteConcurrencyOption>(1));
+  for (std::int64_t i = 0; i != 3; ++i) writer.Add(MakeRow("T1", i));
+  EXPECT_THAT(writer.Close(), IsEmpty());
+}
+
+TEST(BulkWriterTest, MaxGroupBytes) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, BatchWrite)
+      .WillOnce([&](Connection::BatchWriteParams const& p) {
+        // Each mutation is larger than the limit, so it gets its own group.
+        EXPECT_THAT(p.mutation_groups, ElementsAre(SizeIs(1), SizeIs(1),
+                                                   SizeIs(1)));
+        return Success(p);
+      });
+
+  BulkWriter writer(Client(conn),
+                    Options{}
+                        .set<BulkWriteMaxMutationsPerGroupOption>(100)
+                        .set<BulkWriteMaxGroupBytesOption>(1)
+                        .set<BulkWriteConcurrencyOption>(1));
+  for (std::int64_t i = 0; i != 3; ++i) writer.Add(MakeRow("T1", i));
+  EXPECT_THAT(writer.Close(), IsEmpty());
+}
+
+TEST(BulkWriterTest, GroupFailures) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, BatchWrite)
+      .WillOnce([&](Connection::BatchWriteParams const& p) {
+        EXPECT_THAT(p.mutation_groups, SizeIs(3));
+        auto ts = MakeTimestamp(absl::UnixEpoch()).value();
+        return mocks::MakeStreamRange<BatchedCommitResult>({
+            BatchedCommitResult{{0}, ts},
+            BatchedCommitResult{
+                {2}, Status(StatusCode::kAlreadyExists, "already exists")},
+        });
+      });
+
+  BulkWriter writer(Client(conn),
+                    Options{}
+                        .set<BulkWriteMaxMutationsPerGroupOption>(2)
+                        .set<BulkWriteConcurrencyOption>(1));
+  for (std::int64_t i = 0; i != 3; ++i) writer.Add(MakeRow("T1", i));
+  auto failures = writer.Close();
+  // Group 1 has no result, it is reported with an unknown outcome.
+  ASSERT_THAT(failures, SizeIs(2));
+  EXPECT_THAT(failures[0].status, StatusIs(StatusCode::kAlreadyExists));
+  EXPECT_THAT(failures[0].mutation_group, ElementsAre(MakeRow("T1", 2)));
+  EXPECT_THAT(failures[1].status, StatusIs(StatusCode::kUnknown));
+  EXPECT_THAT(failures[1].mutation_group, ElementsAre(MakeRow("T1", 1)));
+}
+
+TEST(BulkWriterTest, StreamFailure) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, BatchWrite)
+      .WillOnce([&](Connection::BatchWriteParams const& p) {
+        EXPECT_THAT(p.mutation_groups, SizeIs(2));
+        auto ts = MakeTimestamp(absl::UnixEpoch()).value();
+        return mocks::MakeStreamRange<BatchedCommitResult>(
+            {BatchedCommitResult{{1}, ts}},
+            Status(StatusCode::kUnavailable, "try-again"));
+      });
+
+  BulkWriter writer(Client(conn),
+                    Options{}
+                        .set<BulkWriteMaxMutationsPerGroupOption>(2)
+                        .set<BulkWriteConcurrencyOption>(1));
+  writer.Add(MakeRow("T1", 0));
+  writer.Add(MakeRow("T1", 1));
+  auto failures = writer.Close();
+  EXPECT_THAT(
+      failures,
+      ElementsAre(AllOf(
+          Field(&BulkWriteFailure::status, StatusIs(StatusCode::kUnavailable)),
+          Field(&BulkWriteFailure::mutation_group,
+                ElementsAre(MakeRow("T1", 0))))));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
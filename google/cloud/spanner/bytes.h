@@ -18,16 +18,30 @@
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/internal/base64_transforms.h"
 #include "google/cloud/status_or.h"
+#include "absl/meta/type_traits.h"
 #include <array>
 #include <cstddef>
 #include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace google {
 namespace cloud {
 namespace spanner_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 struct BytesInternals;
+
+// Detects containers with contiguous storage for octets, such as `std::string`
+// and `std::vector<std::uint8_t>`.
+template <typename C, typename = void>
+struct IsOctetContainer : std::false_type {};
+template <typename C>
+struct IsOctetContainer<C,
+                        absl::void_t<decltype(std::declval<C const&>().data()),
+                                     decltype(std::declval<C const&>().size())>>
+    : std::integral_constant<bool,
+                             sizeof(*std::declval<C const&>().data()) == 1> {};
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
 
@@ -54,15 +68,18 @@ class Bytes {
     base64_rep_ = std::move(encoder).FlushAndPad();
   }
   template <typename Container>
-  explicit Bytes(Container const& c) : Bytes(std::begin(c), std::end(c)) {}
+  explicit Bytes(Container const& c)
+      : base64_rep_(
+            Encode(c, spanner_internal::IsOctetContainer<Container>{})) {}
   ///@}
 
   /// Conversion to a sequence of octets.  The `Container` must support
   /// construction from a range specified as a pair of input iterators.
   template <typename Container>
   Container get() const {
-    google::cloud::internal::Base64Decoder decoder(base64_rep_);
-    return Container(decoder.begin(), decoder.end());
+    auto bytes = google::cloud::internal::Base64DecodeToBytes(base64_rep_);
+    if (!bytes) return Container{};  // unreachable, `base64_rep_` is valid
+    return Container(bytes->begin(), bytes->end());
   }
 
   /// @name Relational operators
@@ -84,6 +101,18 @@ class Bytes {
  private:
   friend struct spanner_internal::BytesInternals;
 
+  // Contiguous octets are encoded in bulk, other containers one at a time.
+  template <typename Container>
+  static std::string Encode(Container const& c, std::true_type) {
+    google::cloud::internal::Base64Encoder encoder;
+    encoder.Append(google::cloud::internal::AsOctets(c));
+    return std::move(encoder).FlushAndPad();
+  }
+  template <typename Container>
+  static std::string Encode(Container const& c, std::false_type) {
+    return Bytes(std::begin(c), std::end(c)).base64_rep_;
+  }
+
   std::string base64_rep_;  // valid base64 representation
 };
 
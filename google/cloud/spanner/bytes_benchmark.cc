@@ -14,6 +14,7 @@
 
 #include "google/cloud/spanner/bytes.h"
 #include <benchmark/benchmark.h>
+#include <deque>
 #include <string>
 
 namespace google {
@@ -22,18 +23,28 @@ namespace spanner {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
-// Run on (6 X 2300 MHz CPU s)
+// Run on (1 X 2100 MHz CPU )
 // CPU Caches:
-//   L1 Data 32K (x3)
-//   L1 Instruction 32K (x3)
-//   L2 Unified 256K (x3)
-//   L3 Unified 46080K (x1)
-// Load Average: 0.22, 0.24, 0.26
-// ----------------------------------------------------------------
-// Benchmark            Time       CPU   Iterations UserCounters...
-// ----------------------------------------------------------------
-// BM_BytesCtor      8386 ns   8318 ns        82963 bytes_per_second=167.843M/s
-// BM_BytesGet       6094 ns   6057 ns       115399 bytes_per_second=307.34M/s
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// Load Average: 0.66, 1.46, 1.79
+// ---------------------------------------------------------------------------
+// Benchmark                           Time        CPU Iterations  Throughput
+// ---------------------------------------------------------------------------
+// BM_BytesCtor                      529 ns     519 ns   529254 2.80808G/s
+// BM_BytesGet                      1114 ns    1111 ns   254979 1.75073G/s
+// BM_BytesCtorBlob/1024             391 ns     389 ns   701890 2.44846G/s
+// BM_BytesCtorBlob/4194304      1834730 ns 1790928 ns      136 2.18113G/s
+// BM_BytesGetBlob/1024              759 ns     758 ns   392732 1.68158G/s
+// BM_BytesGetBlob/4194304       3027899 ns 2994353 ns       91 1.73939G/s
+// BM_BytesFromBase64Blob/1024       440 ns     430 ns   655078 2.96258G/s
+// BM_BytesFromBase64Blob/4194304 1567178 ns 1563011 ns     176 3.33224G/s
+//
+// The throughput is `bytes_per_second`. Before the bulk base64 codec,
+// `BM_BytesCtor` ran at 439.88M/s and `BM_BytesGet` at 516.453M/s on the
+// same machine.
 
 std::string const kText = R"""(
     Four score and seven years ago our fathers brought forth on this
@@ -81,6 +92,57 @@ void BM_BytesGet(benchmark::State& state) {
 }
 BENCHMARK(BM_BytesGet);
 
+// Spanner BYTES columns may hold large blobs, measure the throughput for a
+// range of sizes.
+std::string MakeBlob(std::size_t size) {
+  std::string blob(size, '\0');
+  for (std::size_t i = 0; i != size; ++i) {
+    blob[i] = static_cast<char>((i * 131 + 7) % 256);
+  }
+  return blob;
+}
+
+void BM_BytesCtorBlob(benchmark::State& state) {
+  auto const blob = MakeBlob(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Bytes(blob));
+  }
+  state.SetBytesProcessed(state.iterations() * blob.size());
+}
+BENCHMARK(BM_BytesCtorBlob)->Range(1 << 10, 1 << 22);
+
+// Containers without contiguous storage are encoded one octet at a time, this
+// is the baseline for `BM_BytesCtorBlob`.
+void BM_BytesCtorBlobIterator(benchmark::State& state) {
+  auto const blob = MakeBlob(static_cast<std::size_t>(state.range(0)));
+  std::deque<char> const d(blob.begin(), blob.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Bytes(d));
+  }
+  state.SetBytesProcessed(state.iterations() * blob.size());
+}
+BENCHMARK(BM_BytesCtorBlobIterator)->Range(1 << 10, 1 << 22);
+
+void BM_BytesGetBlob(benchmark::State& state) {
+  Bytes b(MakeBlob(static_cast<std::size_t>(state.range(0))));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(b.get<std::string>());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          spanner_internal::BytesToBase64(b).size());
+}
+BENCHMARK(BM_BytesGetBlob)->Range(1 << 10, 1 << 22);
+
+void BM_BytesFromBase64Blob(benchmark::State& state) {
+  auto const encoded = spanner_internal::BytesToBase64(
+      Bytes(MakeBlob(static_cast<std::size_t>(state.range(0)))));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spanner_internal::BytesFromBase64(encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(BM_BytesFromBase64Blob)->Range(1 << 10, 1 << 22);
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner
@@ -111,6 +111,21 @@ TEST(Bytes, Conversions) {
   EXPECT_EQ(v_plain, bytes->get<std::vector<std::uint8_t>>());
 }
 
+TEST(Bytes, ContiguousAndIteratorEncodingsMatch) {
+  // Containers with contiguous storage are encoded in bulk, others one octet
+  // at a time.
+  for (std::size_t size = 0; size != 100; ++size) {
+    std::string plain(size, '\0');
+    for (std::size_t i = 0; i != size; ++i) {
+      plain[i] = static_cast<char>(i * 37 % 256);
+    }
+    std::deque<char> const d_plain(plain.begin(), plain.end());
+    EXPECT_EQ(Bytes(plain), Bytes(d_plain)) << "size=" << size;
+    EXPECT_EQ(plain, Bytes(plain).get<std::string>()) << "size=" << size;
+    EXPECT_EQ(d_plain, Bytes(plain).get<std::deque<char>>());
+  }
+}
+
 TEST(Bytes, RelationalOperators) {
   std::string const s_plain = "The quick brown fox jumps over the lazy dog.";
   std::deque<char> const d_plain(s_plain.begin(), s_plain.end());
@@ -29,8 +29,10 @@
 #include "google/cloud/spanner/sql_statement.h"
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/options.h"
+#include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "absl/types/optional.h"
 #include <string>
@@ -142,6 +144,17 @@ class Connection {
   /// Returns the options used by the Connection.
   virtual Options options() { return Options{}; }
 
+  /**
+   * Returns a future satisfied when the connection has warmed up.
+   *
+   * For the connections returned by `MakeConnection()` this is when the
+   * session pool has created its initial sessions (see
+   * `SessionPoolMinSessionsOption` and `SessionPoolBackgroundWarmUpOption`).
+   * If the sessions could not be created the future holds the error, but the
+   * connection remains usable, and creates sessions on demand.
+   */
+  virtual future<Status> Ready() { return make_ready_future(Status{}); }
+
   /// Defines the interface for `Client::Read()`
   virtual RowStream Read(ReadParams);
 
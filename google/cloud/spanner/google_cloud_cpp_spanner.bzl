@@ -49,6 +49,7 @@ google_cloud_cpp_spanner_hdrs = [
     "backoff_policy.h",
     "backup.h",
     "batch_dml_result.h",
+    "bulk_writer.h",
     "bytes.h",
     "client.h",
     "client_options.h",
@@ -150,6 +151,7 @@ google_cloud_cpp_spanner_srcs = [
     "admin/internal/instance_admin_tracing_connection.cc",
     "admin/internal/instance_admin_tracing_stub.cc",
     "backup.cc",
+    "bulk_writer.cc",
     "bytes.cc",
     "client.cc",
     "commit_options.cc",
@@ -47,6 +47,7 @@ class ConnectionImpl : public spanner::Connection {
                  std::vector<std::shared_ptr<SpannerStub>> stubs, Options opts);
 
   Options options() override { return opts_; }
+  future<Status> Ready() override { return session_pool_->Ready(); }
 
   spanner::RowStream Read(ReadParams) override;
   StatusOr<std::vector<spanner::ReadPartition>> PartitionRead(
@@ -39,6 +39,37 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
 using ::google::cloud::Idempotency;
 
+namespace {
+
+// Returns a future satisfied once all of `pending` are satisfied, with the
+// last error, if any.
+future<Status> AllOf(std::vector<future<Status>> pending) {
+  auto result = make_ready_future(Status{});
+  for (auto& f : pending) {
+    result = result.then([f = std::move(f)](future<Status> r) mutable {
+      return f.then([previous = r.get()](future<Status> g) {
+        auto status = g.get();
+        return status.ok() ? previous : status;
+      });
+    });
+  }
+  return result;
+}
+
+// A `SELECT 1` query, used to keep `session_name` alive.
+google::spanner::v1::ExecuteSqlRequest MakeRefreshSessionRequest(
+    std::string session_name) {
+  google::spanner::v1::ExecuteSqlRequest request;
+  request.set_session(std::move(session_name));
+  // Single-use transaction with strong concurrency.
+  request.set_sql("SELECT 1;");
+  request.mutable_request_options()->set_priority(
+      google::spanner::v1::RequestOptions::PRIORITY_LOW);
+  return request;
+}
+
+}  // namespace
+
 std::shared_ptr<SessionPool> MakeSessionPool(
     spanner::Database db, std::vector<std::shared_ptr<SpannerStub>> stubs,
     google::cloud::CompletionQueue cq, Options opts) {
@@ -80,13 +111,114 @@ void SessionPool::Initialize() {
   internal::OptionsSpan span(opts_);
   CreateMultiplexedSession();
   auto const min_sessions = opts_.get<spanner::SessionPoolMinSessionsOption>();
+  std::vector<CreateCount> create_counts;
   if (min_sessions > 0) {
+    // Count the calls as in progress before returning, so any `Allocate()`
+    // calls wait for them instead of creating more sessions.
     std::unique_lock<std::mutex> lk(mu_);
-    Grow(lk, min_sessions, WaitForSessionAllocation::kWait);
+    auto counts = ComputeCreateCounts(min_sessions);
+    if (counts) {
+      create_calls_in_progress_ += static_cast<int>(counts->size());
+      create_counts = *std::move(counts);
+    }
+  }
+  if (opts_.get<spanner::SessionPoolBackgroundWarmUpOption>()) {
+    // The warm-up runs in the completion queue. The callbacks hold a
+    // `weak_ptr` to the pool, so there is nothing to wait for in the
+    // destructor.
+    std::weak_ptr<SessionPool> pool = shared_from_this();
+    WarmUp(create_counts).then([pool](future<Status> f) {
+      auto status = f.get();
+      if (auto shared_pool = pool.lock()) shared_pool->SetReady(status);
+      return status;
+    });
+  } else {
+    // Warm up on the calling thread, which works even if the completion queue
+    // is not running yet.
+    auto status =
+        CreateSessions(create_counts, WaitForSessionAllocation::kWait);
+    if (status.ok() && opts_.get<spanner::SessionPoolWarmUpQueryOption>()) {
+      PrimeSessionsSync();
+    }
+    SetReady(std::move(status));
   }
   ScheduleBackgroundWork(std::chrono::seconds(5));
 }
 
+future<Status> SessionPool::WarmUp(
+    std::vector<CreateCount> const& create_counts) {
+  auto created = CreateSessionsAsync(create_counts);
+  if (!opts_.get<spanner::SessionPoolWarmUpQueryOption>()) return created;
+  std::weak_ptr<SessionPool> pool = shared_from_this();
+  return created.then([pool](future<Status> f) {
+    auto status = f.get();
+    auto shared_pool = pool.lock();
+    if (!status.ok() || !shared_pool) return make_ready_future(status);
+    // This may run in a completion queue thread.
+    internal::OptionsSpan span(shared_pool->opts_);
+    return shared_pool->PrimeSessions();
+  });
+}
+
+// Uses each session in the pool once, so the backends have the sessions in
+// their cache before the first application request. Failures are ignored,
+// other than removing any sessions that no longer exist.
+future<Status> SessionPool::PrimeSessions() {
+  auto sessions = PooledSessions();
+  std::weak_ptr<SessionPool> pool = shared_from_this();
+  std::vector<future<Status>> pending;
+  pending.reserve(sessions.size());
+  for (auto const& session : sessions) {
+    pending.push_back(
+        AsyncRefreshSession(cq_, session.first, session.second)
+            .then([pool, name = session.second](
+                      future<StatusOr<google::spanner::v1::ResultSet>> f) {
+              auto response = f.get();
+              if (!response && IsSessionNotFound(response.status())) {
+                if (auto shared_pool = pool.lock()) shared_pool->Erase(name);
+              }
+              return Status{};
+            }));
+  }
+  return AllOf(std::move(pending));
+}
+
+void SessionPool::PrimeSessionsSync() {
+  for (auto const& session : PooledSessions()) {
+    auto response = RefreshSession(session.first, session.second);
+    if (!response && IsSessionNotFound(response.status())) {
+      Erase(session.second);
+    }
+  }
+}
+
+std::vector<std::pair<std::shared_ptr<SpannerStub>, std::string>>
+SessionPool::PooledSessions() {
+  std::vector<std::pair<std::shared_ptr<SpannerStub>, std::string>> sessions;
+  std::unique_lock<std::mutex> lk(mu_);
+  sessions.reserve(sessions_.size());
+  for (auto const& session : sessions_) {
+    sessions.emplace_back(session->channel()->stub, session->session_name());
+  }
+  return sessions;
+}
+
+void SessionPool::SetReady(Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  ready_status_ = status;
+  auto promises = std::move(ready_promises_);
+  ready_promises_.clear();
+  lk.unlock();
+  for (auto& p : promises) p.set_value(status);
+}
+
+future<Status> SessionPool::Ready() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (ready_status_) return make_ready_future(*ready_status_);
+  ready_promises_.emplace_back();
+  return ready_promises_.back().get_future();
+}
+
 SessionPool::~SessionPool() {
   // All references to this object are via `shared_ptr`. Since we're in the
   // destructor that implies there can be no concurrent accesses to any member
@@ -327,27 +459,38 @@ SessionPool::ComputeCreateCounts(int sessions_to_create) {
 Status SessionPool::CreateSessions(
     std::vector<CreateCount> const& create_counts,
     WaitForSessionAllocation wait) {
-  Status return_status;
   auto const& labels = opts_.get<spanner::SessionPoolLabelsOption>();
   auto const& role = opts_.get<spanner::SessionCreatorRoleOption>();
-  for (auto const& op : create_counts) {
-    switch (wait) {
-      case WaitForSessionAllocation::kWait: {
-        auto status =
-            CreateSessionsSync(op.channel, labels, role, op.session_count);
-        if (!status.ok()) {
-          return_status = status;
-        }
-        break;
-      }
-      case WaitForSessionAllocation::kNoWait:
-        CreateSessionsAsync(op.channel, labels, role, op.session_count);
-        break;
+  if (wait == WaitForSessionAllocation::kNoWait) {
+    for (auto const& op : create_counts) {
+      CreateSessionsAsync(op.channel, labels, role, op.session_count);
     }
+    return Status{};
+  }
+  // Blocking on the completion queue could hang, for example when this runs
+  // in one of its threads, so make the calls on this thread.
+  Status return_status;
+  for (auto const& op : create_counts) {
+    auto status =
+        CreateSessionsSync(op.channel, labels, role, op.session_count);
+    if (!status.ok()) return_status = std::move(status);
   }
   return return_status;
 }
 
+future<Status> SessionPool::CreateSessionsAsync(
+    std::vector<CreateCount> const& create_counts) {
+  auto const& labels = opts_.get<spanner::SessionPoolLabelsOption>();
+  auto const& role = opts_.get<spanner::SessionCreatorRoleOption>();
+  std::vector<future<Status>> pending;
+  pending.reserve(create_counts.size());
+  for (auto const& op : create_counts) {
+    pending.push_back(
+        CreateSessionsAsync(op.channel, labels, role, op.session_count));
+  }
+  return AllOf(std::move(pending));
+}
+
 StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
   return Allocate(std::unique_lock<std::mutex>(mu_), dissociate_from_pool);
 }
@@ -486,20 +629,23 @@ Status SessionPool::CreateSessionsSync(
   return HandleBatchCreateSessionsDone(channel, std::move(response));
 }
 
-void SessionPool::CreateSessionsAsync(
+future<Status> SessionPool::CreateSessionsAsync(
     std::shared_ptr<Channel> const& channel,
     std::map<std::string, std::string> const& labels, std::string const& role,
     int num_sessions) {
   std::weak_ptr<SessionPool> pool = shared_from_this();
-  AsyncBatchCreateSessions(cq_, channel->stub, labels, role, num_sessions)
+  return AsyncBatchCreateSessions(cq_, channel->stub, labels, role,
+                                  num_sessions)
       .then(
           [pool, channel](
               future<StatusOr<google::spanner::v1::BatchCreateSessionsResponse>>
                   result) {
             if (auto shared_pool = pool.lock()) {
-              shared_pool->HandleBatchCreateSessionsDone(
+              return shared_pool->HandleBatchCreateSessionsDone(
                   channel, std::move(result).get());
             }
+            return internal::CancelledError("session pool destroyed",
+                                            GCP_ERROR_INFO());
           });
 }
 
@@ -569,12 +715,7 @@ future<StatusOr<google::spanner::v1::ResultSet>>
 SessionPool::AsyncRefreshSession(CompletionQueue& cq,
                                  std::shared_ptr<SpannerStub> const& stub,
                                  std::string session_name) {
-  google::spanner::v1::ExecuteSqlRequest request;
-  request.set_session(std::move(session_name));
-  // Single-use transaction with strong concurrency.
-  request.set_sql("SELECT 1;");
-  request.mutable_request_options()->set_priority(
-      google::spanner::v1::RequestOptions::PRIORITY_LOW);
+  auto request = MakeRefreshSessionRequest(std::move(session_name));
   return google::cloud::internal::AsyncRetryLoop(
       retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
       Idempotency::kIdempotent, cq,
@@ -588,12 +729,29 @@ SessionPool::AsyncRefreshSession(CompletionQueue& cq,
       internal::SaveCurrentOptions(), std::move(request), __func__);
 }
 
+StatusOr<google::spanner::v1::ResultSet> SessionPool::RefreshSession(
+    std::shared_ptr<SpannerStub> const& stub, std::string session_name) {
+  auto const& current = internal::CurrentOptions();
+  return RetryLoop(
+      retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
+      Idempotency::kIdempotent,
+      [&stub](grpc::ClientContext& context, Options const& options,
+              google::spanner::v1::ExecuteSqlRequest const& request) {
+        // Read-only transaction, so no route-to-leader.
+        return stub->ExecuteSql(context, options, request);
+      },
+      current, MakeRefreshSessionRequest(std::move(session_name)), __func__);
+}
+
 Status SessionPool::HandleBatchCreateSessionsDone(
     std::shared_ptr<Channel> const& channel,
     StatusOr<google::spanner::v1::BatchCreateSessionsResponse> response) {
   std::unique_lock<std::mutex> lk(mu_);
   --create_calls_in_progress_;
   if (!response.ok()) {
+    // Wake up anyone waiting for the call to finish, so they can retry.
+    lk.unlock();
+    cond_.notify_all();
     return response.status();
   }
   // Add sessions to the pool and update counters for `channel` and the pool.
@@ -27,6 +27,7 @@
 #include "google/cloud/future.h"
 #include "google/cloud/status_or.h"
 #include "absl/container/fixed_array.h"
+#include "absl/types/optional.h"
 #include <google/spanner/v1/spanner.pb.h>
 #include <chrono>
 #include <condition_variable>
@@ -115,6 +116,14 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
    */
   std::shared_ptr<SpannerStub> GetStub(Session const& session);
 
+  /**
+   * Returns a future satisfied when the initial warm-up of the pool is done,
+   * that is, when the `SessionPoolMinSessionsOption` sessions have been
+   * created (and primed, with `SessionPoolWarmUpQueryOption`), or the
+   * creation failed.
+   */
+  future<Status> Ready();
+
  private:
   friend std::shared_ptr<SessionPool> MakeSessionPool(
       spanner::Database, std::vector<std::shared_ptr<SpannerStub>>,
@@ -169,14 +178,16 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
       int sessions_to_create);  // EXCLUSIVE_LOCKS_REQUIRED(mu_)
   Status CreateSessions(std::vector<CreateCount> const& create_counts,
                         WaitForSessionAllocation wait);  // LOCKS_EXCLUDED(mu_)
+  future<Status> CreateSessionsAsync(
+      std::vector<CreateCount> const& create_counts);  // LOCKS_EXCLUDED(mu_)
   Status CreateSessionsSync(std::shared_ptr<Channel> const& channel,
                             std::map<std::string, std::string> const& labels,
                             std::string const& role,
                             int num_sessions);  // LOCKS_EXCLUDED(mu_)
-  void CreateSessionsAsync(std::shared_ptr<Channel> const& channel,
-                           std::map<std::string, std::string> const& labels,
-                           std::string const& role,
-                           int num_sessions);  // LOCKS_EXCLUDED(mu_)
+  future<Status> CreateSessionsAsync(
+      std::shared_ptr<Channel> const& channel,
+      std::map<std::string, std::string> const& labels,
+      std::string const& role, int num_sessions);  // LOCKS_EXCLUDED(mu_)
 
   SessionHolder MakeSessionHolder(std::unique_ptr<Session> session,
                                   bool dissociate_from_pool);
@@ -194,6 +205,17 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   future<StatusOr<google::spanner::v1::ResultSet>> AsyncRefreshSession(
       CompletionQueue& cq, std::shared_ptr<SpannerStub> const& stub,
       std::string session_name);
+  StatusOr<google::spanner::v1::ResultSet> RefreshSession(
+      std::shared_ptr<SpannerStub> const& stub, std::string session_name);
+
+  // Creates the initial sessions in the completion queue, and primes them if
+  // configured to do so. Only used with `SessionPoolBackgroundWarmUpOption`.
+  future<Status> WarmUp(std::vector<CreateCount> const& create_counts);
+  future<Status> PrimeSessions();  // LOCKS_EXCLUDED(mu_)
+  void PrimeSessionsSync();        // LOCKS_EXCLUDED(mu_)
+  std::vector<std::pair<std::shared_ptr<SpannerStub>, std::string>>
+  PooledSessions();              // LOCKS_EXCLUDED(mu_)
+  void SetReady(Status status);  // LOCKS_EXCLUDED(mu_)
 
   Status HandleBatchCreateSessionsDone(
       std::shared_ptr<Channel> const& channel,
@@ -223,6 +245,8 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   int total_sessions_ = 0;                          // GUARDED_BY(mu_)
   int create_calls_in_progress_ = 0;                // GUARDED_BY(mu_)
   int num_waiting_for_session_ = 0;                 // GUARDED_BY(mu_)
+  absl::optional<Status> ready_status_;             // GUARDED_BY(mu_)
+  std::vector<promise<Status>> ready_promises_;     // GUARDED_BY(mu_)
 
   // Lower bound on all `sessions_[i]->last_use_time()` values.
   Session::Clock::time_point last_use_time_lower_bound_ =
@@ -715,6 +715,116 @@ TEST_F(SessionPoolTest, MultipleChannelsPreAllocation) {
                                 "session pool exhausted"));
 }
 
+TEST_F(SessionPoolTest, BackgroundWarmUp) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  promise<StatusOr<google::spanner::v1::BatchCreateSessionsResponse>> pending;
+  for (auto const& mock : {mock1, mock2}) {
+    EXPECT_CALL(*mock, CreateSession)
+        .WillRepeatedly(
+            Return(ByMove(Status(StatusCode::kInternal, "init failure"))));
+  }
+  EXPECT_CALL(*mock1, AsyncBatchCreateSessions(_, _, _, SessionCountIs(1)))
+      .WillOnce([&pending](CompletionQueue&, auto, auto, auto const&) {
+        return pending.get_future();
+      });
+  EXPECT_CALL(*mock1, AsyncDeleteSession(_, _, _, SessionNameIs("c1s1")))
+      .WillOnce(Return(make_ready_future(Status{})));
+  EXPECT_CALL(*mock2, AsyncBatchCreateSessions(_, _, _, SessionCountIs(1)))
+      .WillOnce([](CompletionQueue&, auto, auto, auto const&) {
+        return make_ready_future(
+            make_status_or(MakeSessionsResponse({"c2s1"})));
+      });
+  EXPECT_CALL(*mock2, AsyncDeleteSession(_, _, _, SessionNameIs("c2s1")))
+      .WillOnce(Return(make_ready_future(Status{})));
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeTestSessionPool(
+      db, {mock1, mock2}, threads.cq(),
+      Options{}
+          .set<spanner::SessionPoolMinSessionsOption>(2)
+          .set<spanner::SessionPoolBackgroundWarmUpOption>(true));
+  auto ready = pool->Ready();
+  EXPECT_EQ(ready.wait_for(std::chrono::milliseconds(10)),
+            std::future_status::timeout);
+
+  // The pool is usable while the sessions for `mock1` are still pending.
+  auto s2 = pool->Allocate();
+  ASSERT_STATUS_OK(s2);
+  EXPECT_EQ((*s2)->session_name(), "c2s1");
+  EXPECT_EQ(ready.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::timeout);
+
+  pending.set_value(MakeSessionsResponse({"c1s1"}));
+  EXPECT_STATUS_OK(ready.get());
+  EXPECT_STATUS_OK(pool->Ready().get());
+  auto s1 = pool->Allocate();
+  ASSERT_STATUS_OK(s1);
+  EXPECT_EQ((*s1)->session_name(), "c1s1");
+}
+
+TEST_F(SessionPoolTest, WarmUpQuery) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  EXPECT_CALL(*mock, CreateSession)
+      .WillRepeatedly(
+          Return(ByMove(Status(StatusCode::kInternal, "init failure"))));
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _, SessionCountIs(2)))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1", "s2"}))));
+  EXPECT_CALL(*mock, ExecuteSql)
+      .Times(2)
+      .WillRepeatedly(
+          [](grpc::ClientContext&, Options const&,
+             google::spanner::v1::ExecuteSqlRequest const& request) {
+            EXPECT_THAT(request.session(), AnyOf("s1", "s2"));
+            EXPECT_EQ(request.sql(), "SELECT 1;");
+            return google::spanner::v1::ResultSet{};
+          });
+  EXPECT_CALL(*mock, AsyncDeleteSession(_, _, _, SessionNameIs("s1")))
+      .WillOnce(Return(make_ready_future(Status{})));
+  EXPECT_CALL(*mock, AsyncDeleteSession(_, _, _, SessionNameIs("s2")))
+      .WillOnce(Return(make_ready_future(Status{})));
+
+  // Nothing runs the completion queue, the warm-up must not depend on it.
+  auto impl = std::make_shared<FakeCompletionQueueImpl>();
+  auto pool = MakeTestSessionPool(
+      db, {mock}, CompletionQueue(impl),
+      Options{}
+          .set<spanner::SessionPoolMinSessionsOption>(2)
+          .set<spanner::SessionPoolWarmUpQueryOption>(true));
+  auto ready = pool->Ready();
+  ASSERT_EQ(ready.wait_for(std::chrono::milliseconds(0)),
+            std::future_status::ready);
+  EXPECT_STATUS_OK(ready.get());
+
+  // Cancel the background work timer.
+  impl->SimulateCompletion(false);
+}
+
+TEST_F(SessionPoolTest, WarmUpFailure) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = spanner::Database("project", "instance", "database");
+  EXPECT_CALL(*mock, CreateSession)
+      .WillRepeatedly(
+          Return(ByMove(Status(StatusCode::kInternal, "init failure"))));
+  EXPECT_CALL(*mock, AsyncBatchCreateSessions)
+      .WillOnce([](CompletionQueue&, auto, auto, auto const&) {
+        return make_ready_future(
+            StatusOr<google::spanner::v1::BatchCreateSessionsResponse>(
+                Status(StatusCode::kPermissionDenied, "uh-oh in create")));
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeTestSessionPool(
+      db, {mock}, threads.cq(),
+      Options{}
+          .set<spanner::SessionPoolMinSessionsOption>(1)
+          .set<spanner::SessionPoolBackgroundWarmUpOption>(true));
+  EXPECT_THAT(pool->Ready().get(), StatusIs(StatusCode::kPermissionDenied,
+                                            HasSubstr("uh-oh in create")));
+}
+
 TEST_F(SessionPoolTest, GetStubForStublessSession) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
   auto db = spanner::Database("project", "instance", "database");
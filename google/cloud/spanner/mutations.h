@@ -29,6 +29,7 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 template <typename Op>
 class WriteMutationBuilder;
 class DeleteMutationBuilder;
+struct MutationInternals;
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner_internal
 
@@ -87,6 +88,7 @@ class Mutation {
   template <typename Op>
   friend class spanner_internal::WriteMutationBuilder;
   friend class spanner_internal::DeleteMutationBuilder;
+  friend struct spanner_internal::MutationInternals;
   explicit Mutation(google::spanner::v1::Mutation m) : m_(std::move(m)) {}
 
   google::spanner::v1::Mutation m_;
@@ -106,6 +108,14 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 namespace spanner_internal {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 
+/// Inspect the underlying proto without copying it.
+struct MutationInternals {
+  static google::spanner::v1::Mutation const& Proto(
+      spanner::Mutation const& m) {
+    return m.m_;
+  }
+};
+
 template <typename Op>
 class WriteMutationBuilder {
  public:
@@ -202,6 +202,39 @@ struct SessionPoolLabelsOption {
   using Type = std::map<std::string, std::string>;
 };
 
+/**
+ * Option for `google::cloud::Options` to create the initial sessions in the
+ * background.
+ *
+ * By default `spanner::MakeConnection()` blocks until the pool has created
+ * `SessionPoolMinSessionsOption` sessions. If this option is `true`,
+ * `MakeConnection()` returns immediately, and the application can use
+ * `Connection::Ready()` to wait for the initial sessions, for example, before
+ * routing any traffic to the new process. In the background the sessions are
+ * created concurrently on all the channels, using the completion queue. Without
+ * this option they are created on the calling thread, one channel at a time.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct SessionPoolBackgroundWarmUpOption {
+  using Type = bool;
+};
+
+/**
+ * Option for `google::cloud::Options` to prime the initial sessions with a
+ * `SELECT 1` query.
+ *
+ * The Cloud Spanner backends keep a cache of recently used sessions. Using
+ * each new session once, before `Connection::Ready()` is satisfied, avoids
+ * paying the cost of loading the session in the first application requests.
+ * Failures in these queries are ignored.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct SessionPoolWarmUpQueryOption {
+  using Type = bool;
+};
+
 /**
  * List of all SessionPool options. Pass to `spanner::MakeConnection()`.
  */
@@ -209,7 +242,8 @@ using SessionPoolOptionList = OptionList<
     RouteToLeaderOption, SessionCreatorRoleOption, SessionPoolMinSessionsOption,
     SessionPoolMaxSessionsPerChannelOption, SessionPoolMaxIdleSessionsOption,
     SessionPoolActionOnExhaustionOption, SessionPoolKeepAliveIntervalOption,
-    SessionPoolLabelsOption>;
+    SessionPoolLabelsOption, SessionPoolBackgroundWarmUpOption,
+    SessionPoolWarmUpQueryOption>;
 
 /**
  * Option for `google::cloud::Options` to set the optimizer version used in an
@@ -395,6 +429,72 @@ struct MaxCommitDelayOption {
  */
 using RequestOptionList = OptionList<RequestPriorityOption, RequestTagOption>;
 
+/**
+ * Option for `google::cloud::Options` to set the maximum number of mutations
+ * in each mutation group created by `spanner::BulkWriter`.
+ *
+ * Cloud Spanner counts each column affected by an insert or update, and each
+ * key or key range in a delete, as one mutation. The default is 2,000. Larger
+ * groups must still fit in the Cloud Spanner limits for a single commit.
+ *
+ * The writer does not sort the mutations, each group contains consecutive
+ * mutations for the same table. Add the mutations in primary key order, or
+ * each group may span many key ranges, and splits.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct BulkWriteMaxMutationsPerGroupOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the maximum size of each
+ * mutation group created by `spanner::BulkWriter`.
+ *
+ * The size is estimated from the size of the mutations. The default is 1 MiB.
+ * A group is closed when it reaches either this size or
+ * `BulkWriteMaxMutationsPerGroupOption` mutations. A single mutation larger
+ * than this value is sent in a group by itself.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct BulkWriteMaxGroupBytesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the maximum size of each
+ * `BatchWrite` request sent by `spanner::BulkWriter`.
+ *
+ * The size is estimated from the size of the mutations. The default is 4 MiB.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct BulkWriteMaxRequestBytesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Option for `google::cloud::Options` to set the maximum number of concurrent
+ * `BatchWrite` requests sent by `spanner::BulkWriter`.
+ *
+ * The default is 4. Each request uses a session from the session pool, so
+ * values larger than the maximum number of sessions are not useful.
+ *
+ * @ingroup google-cloud-spanner-options
+ */
+struct BulkWriteConcurrencyOption {
+  using Type = std::size_t;
+};
+
+/**
+ * List of all the options for `spanner::BulkWriter`.
+ */
+using BulkWriteOptionList =
+    OptionList<BulkWriteMaxMutationsPerGroupOption,
+               BulkWriteMaxGroupBytesOption, BulkWriteMaxRequestBytesOption,
+               BulkWriteConcurrencyOption>;
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace spanner
 }  // namespace cloud
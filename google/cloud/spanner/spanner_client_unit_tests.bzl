@@ -18,6 +18,7 @@
 
 spanner_client_unit_tests = [
     "backup_test.cc",
+    "bulk_writer_test.cc",
     "bytes_test.cc",
     "client_options_test.cc",
     "client_test.cc",
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/make_status.h"
+#include "google/cloud/internal/parse_rfc3339.h"
 #include "google/cloud/status.h"
 #include <google/protobuf/util/time_util.h>
 #include <string>
@@ -94,14 +96,16 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
 // Timestamp objects are always formatted in UTC, and we always format them
-// with a trailing 'Z'. However, we're a bit more liberal in the UTC offsets we
-// accept, thus the use of '%Ez' in kParseSpec.
-auto constexpr kFormatSpec = "%E4Y-%m-%d%ET%H:%M:%E*SZ";
+// with a trailing 'Z', see `internal::FormatRfc3339()`. However, we're a bit
+// more liberal in the UTC offsets we accept, thus the use of '%Ez' in
+// kParseSpec.
 auto constexpr kParseSpec = "%Y-%m-%d%ET%H:%M:%E*S%Ez";
 
 }  // namespace
 
 StatusOr<spanner::Timestamp> TimestampFromRFC3339(std::string const& s) {
+  auto fast = internal::ParseRfc3339Fast(s);
+  if (fast) return spanner::MakeTimestamp(*fast);
   absl::Time t;
   std::string err;
   if (absl::ParseTime(kParseSpec, s, &t, &err)) {
@@ -112,7 +116,8 @@ StatusOr<spanner::Timestamp> TimestampFromRFC3339(std::string const& s) {
 
 std::string TimestampToRFC3339(spanner::Timestamp ts) {
   auto const t = ts.get<absl::Time>().value();  // Cannot fail.
-  return absl::FormatTime(kFormatSpec, t, absl::UTCTimeZone());
+  char buffer[internal::kFormatRfc3339BufferSize];
+  return std::string(buffer, internal::FormatRfc3339(t, buffer));
 }
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
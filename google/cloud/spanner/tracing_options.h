@@ -30,6 +30,8 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
  *   - single_line_mode=on
  *   - use_short_repeated_primitives=on
  *   - truncate_string_field_longer_than=128
+ *   - log_one_in=1
+ *   - max_logs_per_second=0
  */
 using TracingOptions = ::google::cloud::TracingOptions;
 
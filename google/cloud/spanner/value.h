@@ -546,7 +546,7 @@ class Value {
   template <typename M>
   static google::protobuf::Value MakeValueProto(ProtoMessage<M> m) {
     internal::Base64Encoder encoder;
-    for (auto c : std::string{m}) encoder.PushBack(c);
+    encoder.Append(internal::AsOctets(std::string{m}));
     return MakeValueProto(std::move(encoder).FlushAndPad());
   }
   static google::protobuf::Value MakeValueProto(int i);
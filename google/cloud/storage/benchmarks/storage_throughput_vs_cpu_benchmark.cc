@@ -180,7 +180,8 @@ int main(int argc, char* argv[]) {
             << "\n# Duration: "
             << absl::FormatDuration(absl::FromChrono(options->duration))
             << "\n# Thread Count: " << options->thread_count
-            << "\n# Client Per Thread: " << options->client_per_thread;
+            << "\n# Client Per Thread: " << options->client_per_thread
+            << "\n# Read Into: " << options->read_into;
 
   output_size_range("Object Size", options->minimum_object_size,
                     options->maximum_object_size);
@@ -190,9 +190,11 @@ class SimpleUpload : public ThroughputExperiment {
  */
 class DownloadObject : public ThroughputExperiment {
  public:
-  explicit DownloadObject(google::cloud::storage::Client client,
-                          ExperimentTransport transport)
-      : client_(std::move(client)), transport_(transport) {}
+  DownloadObject(google::cloud::storage::Client client,
+                 ExperimentTransport transport, bool read_into)
+      : client_(std::move(client)),
+        transport_(transport),
+        read_into_(read_into) {}
   ~DownloadObject() override = default;
 
   ThroughputResult Run(std::string const& bucket_name,
@@ -212,9 +214,18 @@ class DownloadObject : public ThroughputExperiment {
                            gcs::DisableCrc32cChecksum(!config.enable_crc32c),
                            gcs::DisableMD5Hash(!config.enable_md5));
     std::int64_t transfer_size = 0;
-    while (!reader.eof() && !reader.bad()) {
-      reader.read(buffer.data(), buffer.size());
-      transfer_size += reader.gcount();
+    if (read_into_) {
+      // Receive the data directly into `buffer`, each call blocks until the
+      // buffer is full, the download completes, or there is an error.
+      while (!reader.eof() && !reader.bad()) {
+        transfer_size += static_cast<std::int64_t>(
+            reader.ReadInto(absl::MakeSpan(buffer)));
+      }
+    } else {
+      while (!reader.eof() && !reader.bad()) {
+        reader.read(buffer.data(), buffer.size());
+        transfer_size += reader.gcount();
+      }
     }
     auto const usage = timer.Sample();
     return ThroughputResult{start,
@@ -241,6 +252,7 @@ class DownloadObject : public ThroughputExperiment {
  private:
   google::cloud::storage::Client client_;
   ExperimentTransport transport_;
+  bool read_into_;
 };
 
 extern "C" std::size_t OnWrite(char* src, size_t size, size_t nmemb, void* d) {
@@ -452,7 +464,8 @@ std::vector<std::unique_ptr<ThroughputExperiment>> CreateDownloadExperiments(
   for (auto l : options.libs) {
     if (l != ExperimentLibrary::kRaw) {
       for (auto t : options.transports) {
-        result.push_back(std::make_unique<DownloadObject>(provider(t), t));
+        result.push_back(std::make_unique<DownloadObject>(provider(t), t,
+                                                         options.read_into));
       }
       continue;
     }
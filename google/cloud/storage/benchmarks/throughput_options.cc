@@ -262,6 +262,11 @@ google::cloud::StatusOr<ThroughputOptions> ParseThroughputOptions(
        [&options](std::string const& val) {
          options.client_per_thread = ParseBoolean(val).value_or(false);
        }},
+      {"--read-into",
+       "download using ObjectReadStream::ReadInto() instead of read()",
+       [&options](std::string const& val) {
+         options.read_into = ParseBoolean(val).value_or(false);
+       }},
       {"--grpc-channel-count",
        "number of gRPC channels created by the client library, use 0 for the "
        "default",
@@ -34,6 +34,7 @@ struct ThroughputOptions {
       std::chrono::seconds(std::chrono::minutes(15));
   int thread_count = 1;
   bool client_per_thread = false;
+  bool read_into = false;
   std::int64_t minimum_object_size = 32 * kMiB;
   std::int64_t maximum_object_size = 256 * kMiB;
   // Control the size of the read and write buffers in the application.
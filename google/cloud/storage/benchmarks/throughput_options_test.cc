@@ -53,6 +53,7 @@ TEST(ThroughputOptions, Basic) {
       "--enabled-crc32c=enabled",
       "--enabled-md5=disabled",
       "--client-per-thread=false",
+      "--read-into=true",
       "--rest-endpoint=test-only-rest",
       "--grpc-endpoint=test-only-grpc",
       "--direct-path-endpoint=test-only-direct-path",
@@ -87,6 +88,7 @@ TEST(ThroughputOptions, Basic) {
   EXPECT_EQ(1, options->duration.count());
   EXPECT_EQ(1, options->minimum_sample_count);
   EXPECT_EQ(2, options->maximum_sample_count);
+  EXPECT_TRUE(options->read_into);
   EXPECT_THAT(options->libs,
               UnorderedElementsAre(ExperimentLibrary::kRaw,
                                    ExperimentLibrary::kCppClient));
@@ -15,8 +15,12 @@
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/internal/base64.h"
 #include "google/cloud/storage/internal/connection_factory.h"
+#include "google/cloud/storage/internal/crc32c.h"
+#include "google/cloud/storage/internal/download_manifest.h"
+#include "google/cloud/storage/internal/read_ahead_object_read_source.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
 #include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/internal/big_endian.h"
 #include "google/cloud/internal/curl_handle.h"
 #include "google/cloud/internal/curl_options.h"
 #include "google/cloud/internal/filesystem.h"
@@ -24,9 +28,15 @@
 #include "google/cloud/internal/opentelemetry.h"
 #include "google/cloud/log.h"
 #include "absl/strings/str_split.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -62,15 +72,64 @@ Client::Client(InternalOnly, Options const& opts)
 
 StatusOr<Client> Client::CreateDefaultClient() { return Client(Options{}); }
 
+namespace {
+
+ObjectReadStream ReadObjectError(
+    internal::ReadObjectRangeRequest const& request, Status status) {
+  ObjectReadStream stream(std::make_unique<internal::ObjectReadStreambuf>(
+      request, std::move(status)));
+  stream.setstate(std::ios::badbit | std::ios::eofbit);
+  return stream;
+}
+
+// Reads the generation in the `ResumeReadObject` token, starting at the first
+// byte not yet received. The streambuf continues the checksum in the token.
+StatusOr<internal::ReadObjectRangeRequest> ApplyResumeToken(
+    internal::ReadObjectRangeRequest request) {
+  auto const token = request.GetOption<ResumeReadObject>().value();
+  if (request.HasOption<ReadFromOffset>() || request.HasOption<ReadRange>() ||
+      request.HasOption<ReadLast>()) {
+    return google::cloud::internal::InvalidArgumentError(
+        "ResumeReadObject cannot be used with ReadFromOffset, ReadRange, or "
+        "ReadLast",
+        GCP_ERROR_INFO());
+  }
+  if (request.HasOption<Generation>() &&
+      request.GetOption<Generation>().value() != token.generation) {
+    return google::cloud::internal::InvalidArgumentError(
+        "the Generation option does not match the ResumeReadObject token",
+        GCP_ERROR_INFO());
+  }
+  if (token.offset < 0) {
+    return google::cloud::internal::InvalidArgumentError(
+        "invalid offset in the ResumeReadObject token", GCP_ERROR_INFO());
+  }
+  request.set_multiple_options(Generation(token.generation),
+                               ReadFromOffset(token.offset));
+  return request;
+}
+
+}  // namespace
+
 ObjectReadStream Client::ReadObjectImpl(
     internal::ReadObjectRangeRequest const& request) {
+  if (request.HasOption<ResumeReadObject>()) {
+    auto resumed = ApplyResumeToken(request);
+    if (!resumed) return ReadObjectError(request, std::move(resumed).status());
+    return OpenObjectReadStream(*resumed);
+  }
+  return OpenObjectReadStream(request);
+}
+
+ObjectReadStream Client::OpenObjectReadStream(
+    internal::ReadObjectRangeRequest const& request) {
   auto source = connection_->ReadObject(request);
-  if (!source) {
-    ObjectReadStream error_stream(
-        std::make_unique<internal::ObjectReadStreambuf>(
-            request, std::move(source).status()));
-    error_stream.setstate(std::ios::badbit | std::ios::eofbit);
-    return error_stream;
+  if (!source) return ReadObjectError(request, std::move(source).status());
+  auto const read_ahead_size =
+      google::cloud::internal::CurrentOptions().get<ReadAheadSizeOption>();
+  if (read_ahead_size != 0) {
+    *source = std::make_unique<storage_internal::ReadAheadObjectReadSource>(
+        *std::move(source), read_ahead_size);
   }
   auto stream =
       ObjectReadStream(std::make_unique<internal::ObjectReadStreambuf>(
@@ -306,6 +365,10 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
 
 Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                                 std::string const& file_name) {
+  auto const& options = google::cloud::internal::CurrentOptions();
+  if (options.get<EnableDownloadManifestOption>()) {
+    return DownloadFileWithManifest(request, file_name);
+  }
   auto const* func = __func__;
   auto msg = [&request, &file_name, func](char const* what) {
     std::ostringstream os;
@@ -341,6 +404,181 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
   return Status();
 }
 
+Status Client::DownloadFileWithManifest(
+    internal::ReadObjectRangeRequest const& request,
+    std::string const& file_name) {
+  auto const* func = __func__;
+  auto msg = [&request, &file_name, func](char const* what) {
+    std::ostringstream os;
+    os << func << "(" << request << ", " << file_name << "): " << what;
+    return std::move(os).str();
+  };
+  if (request.RequiresRangeHeader()) {
+    return google::cloud::internal::InvalidArgumentError(
+        msg("download manifests cannot be used with ranged downloads"),
+        GCP_ERROR_INFO());
+  }
+
+  auto const manifest_name = internal::DownloadManifestName(file_name);
+  auto const restart = internal::DownloadManifest{request.bucket_name(),
+                                                  request.object_name()};
+  auto manifest = [&] {
+    auto m = internal::ReadDownloadManifest(manifest_name);
+    if (!m || m->bucket_name != request.bucket_name() ||
+        m->object_name != request.object_name()) {
+      return restart;
+    }
+    if (request.HasOption<Generation>() &&
+        request.GetOption<Generation>().value() != m->generation) {
+      return restart;
+    }
+    // The destination must still contain the data recorded in the manifest.
+    std::error_code ec;
+    auto const size = google::cloud::internal::file_size(file_name, ec);
+    if (ec || size < static_cast<std::uintmax_t>(m->offset)) return restart;
+    return *std::move(m);
+  }();
+
+  // A resumed download skips the data already downloaded, so `stream` cannot
+  // validate the checksums. Fetch the size and checksum of the object instead.
+  absl::optional<ObjectMetadata> metadata;
+  if (manifest.offset != 0) {
+    internal::GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                                        request.object_name());
+    request.ForEachOption(internal::CopyCommonOptions(metadata_request));
+    metadata_request.set_option(Generation(manifest.generation));
+    auto m = connection_->GetObjectMetadata(metadata_request);
+    if (m && m->size() >= static_cast<std::uint64_t>(manifest.offset)) {
+      metadata = *std::move(m);
+    } else if (m || m.status().code() == StatusCode::kNotFound) {
+      // The generation in the manifest no longer exists, or does not match
+      // the manifest, start over.
+      manifest = restart;
+    } else {
+      return std::move(m).status();
+    }
+  }
+
+  // When resuming, keep the data already downloaded. Otherwise remove any
+  // previous manifest before truncating the file: until the first checkpoint
+  // it would describe data that is no longer there.
+  auto const resume = manifest.offset != 0;
+  if (!resume) std::remove(manifest_name.c_str());
+  auto const mode = resume ? std::ios::binary | std::ios::in | std::ios::out
+                           : std::ios::binary | std::ios::out | std::ios::trunc;
+  std::fstream os(file_name, mode);
+  if (!os.is_open()) {
+    return google::cloud::internal::InvalidArgumentError(
+        msg("cannot open download destination file - fstream::open()"),
+        GCP_ERROR_INFO());
+  }
+  os.seekp(manifest.offset);
+
+  // If the process stopped after the last write, there is nothing to read.
+  auto const downloaded = static_cast<std::uint64_t>(manifest.offset);
+  if (!metadata || metadata->size() != downloaded) {
+    auto read_request = request;
+    if (resume) {
+      read_request.set_multiple_options(Generation(manifest.generation),
+                                        ReadFromOffset(manifest.offset));
+    }
+    auto stream = ReadObjectImpl(read_request);
+    if (stream.bad()) return stream.status();
+
+    auto const& current = google::cloud::internal::CurrentOptions();
+    auto const size = current.get<DownloadBufferSizeOption>();
+    auto const checkpoint_bytes =
+        current.get<DownloadManifestCheckpointBytesOption>();
+    auto const checkpoint_period =
+        current.get<DownloadManifestCheckpointPeriodOption>();
+    auto checkpoint_offset = manifest.offset;
+    auto checkpoint_time = std::chrono::steady_clock::now();
+    auto checkpoint = [&]() -> Status {
+      // Without a generation the download cannot be resumed safely.
+      if (manifest.generation == 0 || manifest.offset == checkpoint_offset) {
+        return Status{};
+      }
+      // The data must be durable before the manifest records it.
+      os.flush();
+      if (!os.good()) {
+        return google::cloud::internal::UnknownError(
+            msg("cannot flush download destination file - fstream::flush()"),
+            GCP_ERROR_INFO());
+      }
+      auto status = internal::SyncFile(file_name);
+      if (!status.ok()) return status;
+      status = internal::WriteDownloadManifest(manifest_name, manifest);
+      if (!status.ok()) return status;
+      checkpoint_offset = manifest.offset;
+      checkpoint_time = std::chrono::steady_clock::now();
+      return Status{};
+    };
+
+    std::unique_ptr<char[]> buffer(new char[size]);
+    do {
+      stream.read(buffer.get(), size);
+      auto const n = stream.gcount();
+      if (n == 0) continue;
+      os.write(buffer.get(), n);
+      if (!os.good()) break;
+      manifest.crc32c = storage_internal::ExtendCrc32c(
+          manifest.crc32c,
+          absl::string_view(buffer.get(), static_cast<std::size_t>(n)));
+      manifest.offset += n;
+      if (manifest.generation == 0) {
+        manifest.generation = stream.generation().value_or(0);
+      }
+      auto const pending =
+          static_cast<std::size_t>(manifest.offset - checkpoint_offset);
+      if (pending < checkpoint_bytes &&
+          std::chrono::steady_clock::now() - checkpoint_time <
+              checkpoint_period) {
+        continue;
+      }
+      auto status = checkpoint();
+      if (!status.ok()) return status;
+    } while (os.good() && stream.good());
+    if (stream.bad()) {
+      if (stream.status().code() == StatusCode::kDataLoss) {
+        // Corrupted data must be downloaded again, from the beginning.
+        std::remove(manifest_name.c_str());
+      } else {
+        // Save the progress, so the next call resumes from here. The download
+        // error is more useful to the caller than any error saving it.
+        (void)checkpoint();
+      }
+      return stream.status();
+    }
+  }
+  os.close();
+  if (!os.good()) {
+    return google::cloud::internal::UnknownError(
+        msg("cannot close download destination file - fstream::close()"),
+        GCP_ERROR_INFO());
+  }
+
+  if (metadata && !request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
+    auto const computed = internal::Base64Encode(
+        google::cloud::internal::EncodeBigEndian(manifest.crc32c));
+    auto const size_mismatch =
+        metadata->size() != static_cast<std::uint64_t>(manifest.offset);
+    auto const hash_mismatch =
+        !metadata->crc32c().empty() && metadata->crc32c() != computed;
+    if (size_mismatch || hash_mismatch) {
+      std::remove(manifest_name.c_str());
+      return google::cloud::internal::DataLossError(
+          absl::StrCat(msg("mismatched hashes in resumed download"),
+                       ", computed=crc32c=", computed,
+                       ", received=crc32c=", metadata->crc32c(),
+                       ", downloaded size=", manifest.offset,
+                       ", object size=", metadata->size()),
+          GCP_ERROR_INFO());
+    }
+  }
+  std::remove(manifest_name.c_str());
+  return Status();
+}
+
 std::string Client::SigningEmail(SigningAccount const& signing_account) const {
   if (signing_account.has_value()) {
     return signing_account.value();
@@ -508,10 +746,44 @@ Client ClientImplDetails::CreateWithDecorations(
       storage_internal::DecorateConnection(opts, std::move(connection)));
 }
 
+void ForEachConcurrently(std::size_t count, std::size_t concurrency,
+                         std::function<bool(std::size_t)> const& task) {
+  auto const workers = (std::min)(count, concurrency);
+  if (workers <= 1) {
+    for (std::size_t i = 0; i != count; ++i) {
+      if (!task(i)) return;
+    }
+    return;
+  }
+  std::atomic<std::size_t> next{0};
+  std::atomic<bool> done{false};
+  auto work = [&] {
+    for (auto i = next++; i < count && !done.load(); i = next++) {
+      if (!task(i)) done.store(true);
+    }
+  };
+  auto options = google::cloud::internal::SaveCurrentOptions();
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (std::size_t i = 1; i != workers; ++i) {
+    threads.emplace_back([&work, options] {
+      google::cloud::internal::OptionsSpan const span(options);
+      work();
+    });
+  }
+  work();
+  for (auto& t : threads) t.join();
+}
+
 ScopedDeleter::ScopedDeleter(
     std::function<Status(std::string, std::int64_t)> df)
     : delete_fun_(std::move(df)) {}
 
+ScopedDeleter::ScopedDeleter(
+    std::function<Status(std::string, std::int64_t)> df,
+    std::size_t concurrency)
+    : delete_fun_(std::move(df)), concurrency_(concurrency) {}
+
 ScopedDeleter::~ScopedDeleter() {
   if (enabled_) {
     ExecuteDelete();
@@ -527,25 +799,103 @@ void ScopedDeleter::Add(std::string object_name, std::int64_t generation) {
   object_list_.emplace_back(std::move(object_name), generation);
 }
 
+BatchDeleter::BatchDeleter(std::shared_ptr<StorageConnection> connection)
+    : connection_(std::move(connection)),
+      options_(google::cloud::internal::SaveCurrentOptions()),
+      concurrency_(options_->get<MaximumBulkConcurrencyOption>()) {}
+
+BatchDeleter::~BatchDeleter() { WaitPending(0); }
+
+void BatchDeleter::Add(DeleteObjectRequest request) {
+  batch_.Add(std::move(request));
+  if (batch_.full()) Flush();
+}
+
+Status BatchDeleter::Finish() {
+  Flush();
+  WaitPending(0);
+  std::lock_guard<std::mutex> lk(mu_);
+  return std::move(status_);
+}
+
+void BatchDeleter::Flush() {
+  if (batch_.empty()) return;
+  auto batch = std::exchange(batch_, BatchRequest{});
+  if (concurrency_ <= 1) return Send(batch);
+  // The calling thread continues listing objects, so up to `concurrency_`
+  // batches run in the background.
+  WaitPending(concurrency_ - 1);
+  pending_.push_back(
+      std::async(std::launch::async, [this, b = std::move(batch)] {
+        google::cloud::internal::OptionsSpan const span(options_);
+        Send(b);
+      }));
+}
+
+void BatchDeleter::Send(BatchRequest const& batch) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const use_batch = use_batch_;
+  lk.unlock();
+  if (use_batch) {
+    auto response = connection_->ExecuteBatch(batch);
+    if (response) {
+      for (auto& item : response->items) Record(std::move(item).status());
+      return;
+    }
+    if (response.status().code() != StatusCode::kUnimplemented) {
+      return Record(std::move(response).status());
+    }
+    lk.lock();
+    use_batch_ = false;
+    lk.unlock();
+  }
+  for (auto const& item : batch.items()) {
+    Record(connection_->DeleteObject(absl::get<DeleteObjectRequest>(item))
+               .status());
+  }
+}
+
+void BatchDeleter::Record(Status status) {
+  // We ignore kNotFound because we are trying to delete the object anyway.
+  if (status.ok() || status.code() == StatusCode::kNotFound) return;
+  std::lock_guard<std::mutex> lk(mu_);
+  status_ = std::move(status);
+}
+
+void BatchDeleter::WaitPending(std::size_t max_pending) {
+  while (pending_.size() > max_pending) {
+    pending_.front().get();
+    pending_.pop_front();
+  }
+}
+
 Status ScopedDeleter::ExecuteDelete() {
   std::vector<std::pair<std::string, std::int64_t>> object_list;
   // make sure the dtor will not do this again
   object_list.swap(object_list_);
 
+  if (object_list.empty()) return Status();
+
   // Perform deletion in reverse order. We rely on it in functions which create
   // a "lock" object - it is created as the first file and should be removed as
-  // last.
-  for (auto object_it = object_list.rbegin(); object_it != object_list.rend();
-       ++object_it) {
-    Status status = delete_fun_(std::move(object_it->first), object_it->second);
+  // last. The other objects are independent, and may be deleted concurrently.
+  std::mutex mu;
+  Status status;
+  auto const n = object_list.size() - 1;
+  ForEachConcurrently(n, concurrency_, [&](std::size_t i) {
+    auto& object = object_list[n - i];
+    auto s = delete_fun_(std::move(object.first), object.second);
     // Fail on first error. If the service is unavailable, every deletion
     // would potentially keep retrying until the timeout passes - this would
     // take way too much time and would be pointless.
-    if (!status.ok()) {
-      return status;
-    }
-  }
-  return Status();
+    if (s.ok()) return true;
+    std::lock_guard<std::mutex> lk(mu);
+    if (status.ok()) status = std::move(s);
+    return false;
+  });
+  if (!status.ok()) return status;
+  auto& lock = object_list.front();
+  return delete_fun_(std::move(lock.first), lock.second);
 }
 
 }  // namespace internal
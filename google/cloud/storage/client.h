@@ -40,7 +40,11 @@
 #include "google/cloud/status_or.h"
 #include "absl/meta/type_traits.h"
 #include "absl/strings/string_view.h"
+#include <deque>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -1110,7 +1114,12 @@ class Client {
    *     `DisableMD5Hash`, `EncryptionKey`, `Generation`, `IfGenerationMatch`,
    *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
    *     `IfMetagenerationNotMatch`, `ReadFromOffset`, `ReadRange`, `ReadLast`,
-   *     `UserProject`, and `AcceptEncoding`.
+   *     `ResumeReadObject`, `UserProject`, and `AcceptEncoding`.
+   *
+   * To resume an interrupted download, save `ObjectReadStream::resume_token()`
+   * with the data received so far, and pass it back via `ResumeReadObject`.
+   * Unlike `ReadFromOffset`, the resumed download still validates the CRC32C
+   * checksum of the full object.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
@@ -1295,6 +1304,12 @@ class Client {
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
    *
+   * @par Resuming downloads
+   * Set `EnableDownloadManifestOption` to record the progress of the download
+   * in a manifest file. If the download is interrupted, even by a process
+   * crash, calling this function again with the same arguments resumes the
+   * download where it left off.
+   *
    * @par Example
    * @snippet storage_object_file_transfer_samples.cc download file
    */
@@ -3410,6 +3425,8 @@ class Client {
 
   ObjectReadStream ReadObjectImpl(
       internal::ReadObjectRangeRequest const& request);
+  ObjectReadStream OpenObjectReadStream(
+      internal::ReadObjectRangeRequest const& request);
 
   ObjectWriteStream WriteObjectImpl(
       internal::ResumableUploadRequest const& request);
@@ -3474,6 +3491,10 @@ class Client {
   Status DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                           std::string const& file_name);
 
+  Status DownloadFileWithManifest(
+      internal::ReadObjectRangeRequest const& request,
+      std::string const& file_name);
+
   /// Determine the email used to sign a blob.
   std::string SigningEmail(SigningAccount const& signing_account) const;
 
@@ -3535,6 +3556,12 @@ struct ClientImplDetails {
     return client.UploadStreamResumable(source, request);
   }
 
+  template <typename... Options>
+  static google::cloud::Options SpanOptions(Client const& c,
+                                            Options&&... o) {
+    return c.SpanOptions(std::forward<Options>(o)...);
+  }
+
   static Client CreateWithoutDecorations(
       std::shared_ptr<internal::StorageConnection> c) {
     return Client(Client::InternalOnlyNoDecorations{}, std::move(c));
@@ -3567,6 +3594,70 @@ struct DeleteApplyHelper {
   std::int64_t generation;
 };
 
+// Just a wrapper to allow for using in `google::cloud::internal::apply`.
+struct DeleteRequestApplyHelper {
+  template <typename... Options>
+  DeleteObjectRequest operator()(Options... options) const {
+    DeleteObjectRequest request(bucket_name, object_name);
+    request.set_multiple_options(Generation(generation),
+                                 std::move(options)...);
+    return request;
+  }
+
+  std::string bucket_name;
+  std::string object_name;
+  std::int64_t generation;
+};
+
+/**
+ * Calls `task(0)` through `task(count - 1)` using up to @p concurrency threads.
+ *
+ * The calling thread is one of the threads, so with a @p concurrency of 0 or 1
+ * the tasks run serially, in order. The other threads use the calling
+ * thread's `OptionsSpan`. If any task returns `false` no new tasks are
+ * started, though the tasks already running are allowed to complete.
+ */
+void ForEachConcurrently(std::size_t count, std::size_t concurrency,
+                         std::function<bool(std::size_t)> const& task);
+
+/**
+ * Deletes objects using JSON API batch requests.
+ *
+ * Falls back to one request per object if the connection does not support
+ * batch requests, for example, when using gRPC. The caller must set the
+ * `OptionsSpan` for the connection before creating this object.
+ *
+ * If `MaximumBulkConcurrencyOption` is larger than 1 the full batches are sent
+ * from background threads, with up to that many batches in progress, so the
+ * caller can continue listing objects while they are deleted.
+ */
+class BatchDeleter {
+ public:
+  explicit BatchDeleter(std::shared_ptr<StorageConnection> connection);
+  ~BatchDeleter();
+
+  /// Queues @p request, sending the pending requests if the batch is full.
+  void Add(DeleteObjectRequest request);
+
+  /// Sends any pending requests, and returns the last error, if any.
+  Status Finish();
+
+ private:
+  void Flush();
+  void Send(BatchRequest const& batch);
+  void Record(Status status);
+  void WaitPending(std::size_t max_pending);
+
+  std::shared_ptr<StorageConnection> connection_;
+  google::cloud::internal::ImmutableOptions options_;
+  std::size_t concurrency_;
+  BatchRequest batch_;
+  std::deque<std::future<void>> pending_;
+  std::mutex mu_;
+  bool use_batch_ = true;  // ABSL_GUARDED_BY(mu_)
+  Status status_;          // ABSL_GUARDED_BY(mu_)
+};
+
 // Just a wrapper to allow for using in `google::cloud::internal::apply`.
 struct InsertObjectApplyHelper {
   template <typename... Options>
@@ -3614,12 +3705,16 @@ StatusOr<ObjectMetadata> LockPrefix(Client& client,
 /**
  * Delete objects whose names match a given prefix
  *
+ * The objects are deleted while the listing continues. Use
+ * `MaximumBulkConcurrencyOption` to control how many deletion requests are in
+ * progress at the same time.
+ *
  * @param client the client on which to perform the operation.
  * @param bucket_name the name of the bucket that will contain the object.
  * @param prefix the prefix of the objects to be deleted.
  * @param options a list of optional query parameters and/or request headers.
  *     Valid types for this operation include `QuotaUser`, `UserIp`,
- *     `UserProject` and `Versions`.
+ *     `UserProject` and `Versions`, as well as `google::cloud::Options`.
  */
 template <typename... Options>
 Status DeleteByPrefix(Client& client, std::string const& bucket_name,
@@ -3632,24 +3727,29 @@ Status DeleteByPrefix(Client& client, std::string const& bucket_name,
   static_assert(
       std::tuple_size<
           decltype(StaticTupleFilter<
-                   NotAmong<QuotaUser, UserIp, UserProject, Versions>::TPred>(
+                   NotAmong<QuotaUser, UserIp, UserProject, Versions,
+                            google::cloud::Options>::TPred>(
               all_options))>::value == 0,
       "This functions accepts only options of type QuotaUser, UserIp, "
-      "UserProject or Versions.");
-  auto status = Status{};
+      "UserProject, Versions or google::cloud::Options.");
+  google::cloud::internal::OptionsSpan const span(
+      internal::ClientImplDetails::SpanOptions(client, options...));
+  // Up to 100 objects are deleted in each request.
+  internal::BatchDeleter deleter(
+      internal::ClientImplDetails::GetConnection(client));
   for (auto& object :
        client.ListObjects(bucket_name, Projection::NoAcl(), Prefix(prefix),
-                          std::forward<Options>(options)...)) {
-    if (!object) return std::move(object).status();
-    auto del = google::cloud::internal::apply(
-        internal::DeleteApplyHelper{client, object->bucket(), object->name(),
-                                    object->generation()},
-        StaticTupleFilter<NotAmong<Versions>::TPred>(all_options));
-    // We ignore kNotFound because we are trying to delete the object anyway.
-    if (del.ok() || status.code() == StatusCode::kNotFound) continue;
-    status = std::move(del);
-  }
-  return status;
+                          options...)) {
+    if (!object) {
+      deleter.Finish();
+      return std::move(object).status();
+    }
+    deleter.Add(google::cloud::internal::apply(
+        internal::DeleteRequestApplyHelper{object->bucket(), object->name(),
+                                           object->generation()},
+        StaticTupleFilter<NotAmong<Versions>::TPred>(all_options)));
+  }
+  return deleter.Finish();
 }
 
 namespace internal {
@@ -3675,6 +3775,10 @@ class ScopedDeleter {
   // The actual deletion depends on local's types in a very non-trivial way,
   // so we abstract this away by providing the function to delete one object.
   explicit ScopedDeleter(std::function<Status(std::string, std::int64_t)> df);
+  // Deletes all but the first object using up to @p concurrency threads, then
+  // deletes the first object. @p df must be thread-safe.
+  ScopedDeleter(std::function<Status(std::string, std::int64_t)> df,
+                std::size_t concurrency);
   ScopedDeleter(ScopedDeleter const&) = delete;
   ScopedDeleter& operator=(ScopedDeleter const&) = delete;
   ~ScopedDeleter();
@@ -3693,6 +3797,7 @@ class ScopedDeleter {
  private:
   bool enabled_ = true;
   std::function<Status(std::string, std::int64_t)> delete_fun_;
+  std::size_t concurrency_ = 1;
   std::vector<std::pair<std::string, std::int64_t>> object_list_;
 };
 
@@ -3715,6 +3820,10 @@ class ScopedDeleter {
  * DeleteByPrefix()). We recommend using CreateRandomPrefixName() for selecting
  * a random prefix within a bucket.
  *
+ * The compositions in each level of the composition tree are independent. Use
+ * `MaximumBulkConcurrencyOption` to run them, and the deletion of the
+ * temporary objects, concurrently.
+ *
  * @param client the client on which to perform the operations needed by this
  *     function
  * @param bucket_name the name of the bucket used for source object and
@@ -3731,7 +3840,7 @@ class ScopedDeleter {
  *     Valid types for this operation include `DestinationPredefinedAcl`,
  *     `EncryptionKey`, `IfGenerationMatch`, `IfMetagenerationMatch`
  *     `KmsKeyName`, `QuotaUser`, `UserIp`, `UserProject` and
- *     `WithObjectMetadata`.
+ *     `WithObjectMetadata`, as well as `google::cloud::Options`.
  *
  * @par Idempotency
  * This operation is not idempotent. While each request performed by this
@@ -3766,20 +3875,27 @@ StatusOr<ObjectMetadata> ComposeMany(
                    NotAmong<DestinationPredefinedAcl, EncryptionKey,
                             IfGenerationMatch, IfMetagenerationMatch,
                             KmsKeyName, QuotaUser, UserIp, UserProject,
-                            WithObjectMetadata>::TPred>(all_options))>::value ==
-          0,
+                            WithObjectMetadata, google::cloud::Options>::TPred>(
+              all_options))>::value == 0,
       "This functions accepts only options of type DestinationPredefinedAcl, "
       "EncryptionKey, IfGenerationMatch, IfMetagenerationMatch, KmsKeyName, "
-      "QuotaUser, UserIp, UserProject or WithObjectMetadata.");
+      "QuotaUser, UserIp, UserProject, WithObjectMetadata or "
+      "google::cloud::Options.");
+
+  auto const concurrency =
+      internal::ClientImplDetails::SpanOptions(client, options...)
+          .template get<MaximumBulkConcurrencyOption>();
 
   internal::ScopedDeleter deleter(
       [&](std::string const& object_name, std::int64_t generation) {
         return google::cloud::internal::apply(
             internal::DeleteApplyHelper{client, bucket_name, object_name,
                                         generation},
-            StaticTupleFilter<Among<QuotaUser, UserProject, UserIp>::TPred>(
+            StaticTupleFilter<Among<QuotaUser, UserProject, UserIp,
+                                    google::cloud::Options>::TPred>(
                 all_options));
-      });
+      },
+      concurrency);
 
   auto lock = internal::LockPrefix(client, bucket_name, prefix, "",
                                    std::make_tuple(options...));
@@ -3804,19 +3920,21 @@ StatusOr<ObjectMetadata> ComposeMany(
     return sources;
   };
 
+  // May be called from multiple threads, all the captured state is read-only.
   auto composer = [&](std::vector<ComposeSourceObject> compose_range,
+                      std::string object_name,
                       bool is_final) -> StatusOr<ObjectMetadata> {
     if (is_final) {
       return google::cloud::internal::apply(
           internal::ComposeApplyHelper{client, bucket_name,
                                        std::move(compose_range),
-                                       std::move(destination_object_name)},
+                                       std::move(object_name)},
           all_options);
     }
     return google::cloud::internal::apply(
         internal::ComposeApplyHelper{client, bucket_name,
                                      std::move(compose_range),
-                                     tmpobject_name_gen()},
+                                     std::move(object_name)},
         StaticTupleFilter<
             NotAmong<IfGenerationMatch, IfMetagenerationMatch>::TPred>(
             all_options));
@@ -3824,27 +3942,47 @@ StatusOr<ObjectMetadata> ComposeMany(
 
   auto reduce = [&](std::vector<ComposeSourceObject> source_objects)
       -> StatusOr<std::vector<ObjectMetadata>> {
-    std::vector<ObjectMetadata> objects;
+    bool const is_final_composition = source_objects.size() <= max_num_objects;
+    // Split this level into ranges, and name their destinations, before
+    // starting any composition. The names do not depend on the order in which
+    // the compositions complete.
+    std::vector<std::vector<ComposeSourceObject>> ranges;
+    std::vector<std::string> names;
     for (auto range_begin = source_objects.begin();
          range_begin != source_objects.end();) {
       std::size_t range_size = std::min<std::size_t>(
           std::distance(range_begin, source_objects.end()), max_num_objects);
       auto range_end = std::next(range_begin, range_size);
-      std::vector<ComposeSourceObject> compose_range(range_size);
-      std::move(range_begin, range_end, compose_range.begin());
+      ranges.emplace_back(std::make_move_iterator(range_begin),
+                          std::make_move_iterator(range_end));
+      names.push_back(is_final_composition ? destination_object_name
+                                           : tmpobject_name_gen());
+      range_begin = range_end;
+    }
+
+    std::vector<StatusOr<ObjectMetadata>> results(ranges.size());
+    internal::ForEachConcurrently(
+        ranges.size(), concurrency, [&](std::size_t i) {
+          results[i] = composer(std::move(ranges[i]), std::move(names[i]),
+                                is_final_composition);
+          return results[i].ok();
+        });
 
-      bool const is_final_composition =
-          source_objects.size() <= max_num_objects;
-      auto object = composer(std::move(compose_range), is_final_composition);
+    // Schedule the deletion of any temporary objects, even if some of the
+    // compositions failed.
+    std::vector<ObjectMetadata> objects;
+    Status status;
+    for (auto& object : results) {
       if (!object) {
-        return std::move(object).status();
+        if (status.ok()) status = std::move(object).status();
+        continue;
       }
       objects.push_back(*std::move(object));
       if (!is_final_composition) {
         deleter.Add(objects.back());
       }
-      range_begin = range_end;
     }
+    if (!status.ok()) return status;
     return objects;
   };
 
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/crc32c.h"
+#include "google/cloud/storage/internal/download_manifest.h"
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/storage/retry_policy.h"
@@ -22,6 +24,11 @@
 #include "google/cloud/storage/testing/temp_file.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -35,7 +42,11 @@ namespace {
 
 using ::google::cloud::internal::CurrentOptions;
 using ::google::cloud::storage::testing::TempFile;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
 using ::google::cloud::storage::testing::canonical_errors::TransientError;
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::AtMost;
 using ::testing::ByMove;
 using ::testing::ElementsAre;
 using ::testing::HasSubstr;
@@ -207,6 +218,86 @@ TEST_F(ObjectTest, ReadObject) {
   EXPECT_EQ(actual.gcount(), 1024);
 }
 
+TEST_F(ObjectTest, ReadObjectResume) {
+  auto const contents = std::string{"How vexingly quick daft zebras jump!"};
+  auto const head = contents.substr(0, 8);
+  auto const tail = contents.substr(head.size());
+  auto open = true;
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&](internal::ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(r.GetOption<Generation>().value_or(0), 42);
+        EXPECT_EQ(r.GetOption<ReadFromOffset>().value_or(0), head.size());
+        auto read_source = std::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly([&] {
+          return open;
+        });
+        EXPECT_CALL(*read_source, Read).WillOnce([&](char* buf, std::size_t) {
+          open = false;
+          std::copy(tail.begin(), tail.end(), buf);
+          auto result = internal::ReadSourceResult{tail.size(), {}};
+          result.hashes =
+              internal::HashValues{ComputeCrc32cChecksum(contents), {}};
+          result.generation = 42;
+          return result;
+        });
+        EXPECT_CALL(*read_source, Close).Times(AtMost(1));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(read_source));
+      });
+  auto client = ClientForMock();
+  auto actual = client.ReadObject(
+      "test-bucket-name", "test-object-name",
+      ResumeReadObject(ReadObjectResumeToken{
+          42, static_cast<std::int64_t>(head.size()),
+          storage_internal::Crc32c(head)}));
+  ASSERT_STATUS_OK(actual.status());
+  std::string received{std::istreambuf_iterator<char>{actual}, {}};
+  EXPECT_EQ(received, tail);
+  EXPECT_STATUS_OK(actual.status());
+  EXPECT_EQ(actual.computed_hash(), actual.received_hash());
+}
+
+TEST_F(ObjectTest, ReadObjectResumeInvalid) {
+  EXPECT_CALL(*mock_, ReadObject).Times(0);
+  auto const token = ReadObjectResumeToken{42, 8, 0};
+  auto client = ClientForMock();
+  auto actual = client.ReadObject("test-bucket-name", "test-object-name",
+                                  ResumeReadObject(token), ReadRange(0, 8));
+  EXPECT_THAT(actual.status(), StatusIs(StatusCode::kInvalidArgument));
+  actual = client.ReadObject("test-bucket-name", "test-object-name",
+                             ResumeReadObject(token), Generation(43));
+  EXPECT_THAT(actual.status(), StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST_F(ObjectTest, ReadObjectReadAhead) {
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([](internal::ReadObjectRangeRequest const&) {
+        auto read_source = std::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*read_source, IsOpen())
+            .WillOnce(Return(true))
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*read_source, Read)
+            .WillOnce([](char*, std::size_t n) {
+              // The reads use the buffers for the read-ahead.
+              EXPECT_EQ(n, 2048U / 4);
+              return internal::ReadSourceResult{512, {}};
+            })
+            .WillOnce(Return(internal::ReadSourceResult{256, {}}));
+        EXPECT_CALL(*read_source, Close).Times(AtMost(1));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(read_source));
+      });
+  auto client = ClientForMock();
+  auto actual = client.ReadObject("test-bucket-name", "test-object-name",
+                                  Options{}.set<ReadAheadSizeOption>(2048));
+  ASSERT_STATUS_OK(actual.status());
+  std::vector<char> v(1024);
+  actual.read(v.data(), v.size());
+  EXPECT_EQ(actual.gcount(), 768);
+  EXPECT_TRUE(actual.eof());
+  EXPECT_STATUS_OK(actual.status());
+}
+
 TEST_F(ObjectTest, WriteObject) {
   EXPECT_CALL(*mock_, CreateResumableUpload)
       .WillOnce(Return(TransientError()))
@@ -298,6 +389,331 @@ TEST_F(ObjectTest, DownloadToFile) {
   ASSERT_STATUS_OK(actual);
 }
 
+std::string ReadFile(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  return std::string{std::istreambuf_iterator<char>{is}, {}};
+}
+
+bool FileExists(std::string const& file_name) {
+  return std::ifstream(file_name).is_open();
+}
+
+/// Returns a read source that produces @p data in a single `Read()` call.
+std::unique_ptr<internal::ObjectReadSource> MakeReadSource(std::string data,
+                                                           std::int64_t gen) {
+  auto read_source = std::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*read_source, Read)
+      .WillOnce([data, gen](char* buf, std::size_t n) {
+        EXPECT_GE(n, data.size());
+        std::copy(data.begin(), data.end(), buf);
+        auto result = internal::ReadSourceResult{data.size(), {}};
+        result.generation = gen;
+        return result;
+      })
+      .WillOnce(Return(internal::ReadSourceResult{0, {}}));
+  EXPECT_CALL(*read_source, Close).Times(AtMost(1));
+  return read_source;
+}
+
+ObjectMetadata DownloadedObject(std::string const& contents) {
+  return ObjectMetadata{}
+      .set_bucket("test-bucket-name")
+      .set_name("test-object-name")
+      .set_generation(42)
+      .set_size(contents.size())
+      .set_crc32c(ComputeCrc32cChecksum(contents));
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifest) {
+  auto const contents = std::string{"How vexingly quick daft zebras jump!"};
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&](internal::ReadObjectRangeRequest const& r) {
+        EXPECT_FALSE(r.HasOption<ReadFromOffset>());
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            MakeReadSource(contents, 42));
+      });
+
+  TempFile temp("");
+  auto const manifest_name = internal::DownloadManifestName(temp.name());
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(),
+      Options{}.set<EnableDownloadManifestOption>(true));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(ReadFile(temp.name()), contents);
+  // The manifest is removed once the download completes.
+  EXPECT_FALSE(FileExists(manifest_name));
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifestInterrupted) {
+  auto const contents = std::string{"How vexingly quick daft zebras jump!"};
+  auto const head = contents.substr(0, 8);
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&](internal::ReadObjectRangeRequest const&) {
+        auto read_source = std::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+        EXPECT_CALL(*read_source, Read)
+            .WillOnce([&](char* buf, std::size_t n) {
+              EXPECT_GE(n, head.size());
+              std::copy(head.begin(), head.end(), buf);
+              auto result = internal::ReadSourceResult{head.size(), {}};
+              result.generation = 42;
+              return result;
+            })
+            .WillOnce(Return(PermanentError()));
+        EXPECT_CALL(*read_source, Close).Times(AtMost(1));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(read_source));
+      });
+
+  TempFile temp("");
+  auto const manifest_name = internal::DownloadManifestName(temp.name());
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(),
+      Options{}
+          .set<EnableDownloadManifestOption>(true)
+          .set<DownloadBufferSizeOption>(head.size()));
+  EXPECT_THAT(actual, StatusIs(PermanentError().code()));
+  EXPECT_EQ(ReadFile(temp.name()), head);
+  auto const expected = internal::DownloadManifest{
+      "test-bucket-name", "test-object-name", 42,
+      static_cast<std::int64_t>(head.size()), storage_internal::Crc32c(head)};
+  EXPECT_THAT(internal::ReadDownloadManifest(manifest_name),
+              IsOkAndHolds(expected));
+  EXPECT_EQ(std::remove(manifest_name.c_str()), 0);
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifestCheckpoints) {
+  auto const contents = std::string{"How vexingly quick daft zebras jump!"};
+  auto constexpr kChunk = std::size_t{4};
+  auto constexpr kCheckpoint = std::int64_t{2 * kChunk};
+  TempFile temp("");
+  auto const manifest_name = internal::DownloadManifestName(temp.name());
+  auto manifest_offset = [&]() -> std::int64_t {
+    auto m = internal::ReadDownloadManifest(manifest_name);
+    return m ? m->offset : -1;
+  };
+  auto chunk = [&](std::size_t i) {
+    return [&contents, i](char* buf, std::size_t n) {
+      EXPECT_GE(n, std::size_t{kChunk});
+      auto const data = contents.substr(i * kChunk, kChunk);
+      std::copy(data.begin(), data.end(), buf);
+      auto result = internal::ReadSourceResult{data.size(), {}};
+      result.generation = 42;
+      return result;
+    };
+  };
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&](internal::ReadObjectRangeRequest const&) {
+        auto read_source = std::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+        EXPECT_CALL(*read_source, Read)
+            .WillOnce(chunk(0))
+            .WillOnce([&, next = chunk(1)](char* buf, std::size_t n) {
+              EXPECT_EQ(manifest_offset(), -1);
+              return next(buf, n);
+            })
+            .WillOnce([&, next = chunk(2)](char* buf, std::size_t n) {
+              // The first checkpoint is after `kCheckpoint` bytes.
+              EXPECT_EQ(manifest_offset(), kCheckpoint);
+              return next(buf, n);
+            })
+            .WillOnce([&](char*, std::size_t) {
+              // Not enough new data for another checkpoint.
+              EXPECT_EQ(manifest_offset(), kCheckpoint);
+              return StatusOr<internal::ReadSourceResult>(PermanentError());
+            });
+        EXPECT_CALL(*read_source, Close).Times(AtMost(1));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(read_source));
+      });
+
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(),
+      Options{}
+          .set<EnableDownloadManifestOption>(true)
+          .set<DownloadBufferSizeOption>(kChunk)
+          .set<DownloadManifestCheckpointBytesOption>(kCheckpoint)
+          .set<DownloadManifestCheckpointPeriodOption>(std::chrono::hours(1)));
+  EXPECT_THAT(actual, StatusIs(PermanentError().code()));
+  // The progress is saved before returning the error.
+  auto const head = contents.substr(0, 3 * kChunk);
+  auto const expected = internal::DownloadManifest{
+      "test-bucket-name", "test-object-name", 42,
+      static_cast<std::int64_t>(head.size()), storage_internal::Crc32c(head)};
+  EXPECT_THAT(internal::ReadDownloadManifest(manifest_name),
+              IsOkAndHolds(expected));
+  EXPECT_EQ(std::remove(manifest_name.c_str()), 0);
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifestResume) {
+  auto const contents = std::string{"How vexingly quick daft zebras jump!"};
+  auto const head = contents.substr(0, 8);
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce([&](internal::GetObjectMetadataRequest const& r) {
+        EXPECT_EQ(r.GetOption<Generation>().value_or(0), 42);
+        EXPECT_EQ(r.GetOption<UserProject>().value_or(""), "u-p-test");
+        return make_status_or(DownloadedObject(contents));
+      });
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&](internal::ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(r.GetOption<Generation>().value_or(0), 42);
+        EXPECT_EQ(r.GetOption<ReadFromOffset>().value_or(0), head.size());
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            MakeReadSource(contents.substr(head.size()), 42));
+      });
+
+  // Simulate a download interrupted after the first few bytes. The data in
+  // the destination is garbage, to verify the download does not read it.
+  TempFile temp("garbage!");
+  auto const manifest_name = internal::DownloadManifestName(temp.name());
+  ASSERT_STATUS_OK(internal::WriteDownloadManifest(
+      manifest_name, internal::DownloadManifest{
+                         "test-bucket-name", "test-object-name", 42,
+                         static_cast<std::int64_t>(head.size()),
+                         storage_internal::Crc32c(head)}));
+
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(),
+      UserProject("u-p-test"),
+      Options{}.set<EnableDownloadManifestOption>(true));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(ReadFile(temp.name()), "garbage!" + contents.substr(head.size()));
+  EXPECT_FALSE(FileExists(manifest_name));
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifestResumeComplete) {
+  auto const contents = std::string{"How vexingly quick daft zebras jump!"};
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(make_status_or(DownloadedObject(contents))));
+  // All the data was downloaded, there is nothing to read.
+  EXPECT_CALL(*mock_, ReadObject).Times(0);
+
+  TempFile temp(contents);
+  auto const manifest_name = internal::DownloadManifestName(temp.name());
+  ASSERT_STATUS_OK(internal::WriteDownloadManifest(
+      manifest_name, internal::DownloadManifest{
+                         "test-bucket-name", "test-object-name", 42,
+                         static_cast<std::int64_t>(contents.size()),
+                         storage_internal::Crc32c(contents)}));
+
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(),
+      Options{}.set<EnableDownloadManifestOption>(true));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(ReadFile(temp.name()), contents);
+  EXPECT_FALSE(FileExists(manifest_name));
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifestResumeMismatch) {
+  auto const contents = std::string{"How vexingly quick daft zebras jump!"};
+  auto const head = contents.substr(0, 8);
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(make_status_or(DownloadedObject(contents))));
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&](internal::ReadObjectRangeRequest const&) {
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            MakeReadSource(contents.substr(head.size()), 42));
+      });
+
+  TempFile temp(head);
+  auto const manifest_name = internal::DownloadManifestName(temp.name());
+  ASSERT_STATUS_OK(internal::WriteDownloadManifest(
+      manifest_name, internal::DownloadManifest{
+                         "test-bucket-name", "test-object-name", 42,
+                         static_cast<std::int64_t>(head.size()),
+                         storage_internal::Crc32c("not the head")}));
+
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(),
+      Options{}.set<EnableDownloadManifestOption>(true));
+  EXPECT_THAT(actual, StatusIs(StatusCode::kDataLoss,
+                               HasSubstr("mismatched hashes")));
+  // The next attempt starts from the beginning.
+  EXPECT_FALSE(FileExists(manifest_name));
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifestGenerationNotFound) {
+  auto const contents = std::string{"How vexingly quick daft zebras jump!"};
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(StatusOr<ObjectMetadata>(
+          Status(StatusCode::kNotFound, "generation not found"))));
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&](internal::ReadObjectRangeRequest const& r) {
+        EXPECT_FALSE(r.HasOption<Generation>());
+        EXPECT_FALSE(r.HasOption<ReadFromOffset>());
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            MakeReadSource(contents, 43));
+      });
+
+  TempFile temp("How vex");
+  auto const manifest_name = internal::DownloadManifestName(temp.name());
+  ASSERT_STATUS_OK(internal::WriteDownloadManifest(
+      manifest_name,
+      internal::DownloadManifest{"test-bucket-name", "test-object-name", 42, 7,
+                                 storage_internal::Crc32c("How vex")}));
+
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(),
+      Options{}.set<EnableDownloadManifestOption>(true));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(ReadFile(temp.name()), contents);
+  EXPECT_FALSE(FileExists(manifest_name));
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifestRestartRemovesManifest) {
+  EXPECT_CALL(*mock_, GetObjectMetadata)
+      .WillOnce(Return(StatusOr<ObjectMetadata>(
+          Status(StatusCode::kNotFound, "generation not found"))));
+
+  TempFile temp("How vex");
+  auto const manifest_name = internal::DownloadManifestName(temp.name());
+  ASSERT_STATUS_OK(internal::WriteDownloadManifest(
+      manifest_name,
+      internal::DownloadManifest{"test-bucket-name", "test-object-name", 42, 7,
+                                 storage_internal::Crc32c("How vex")}));
+
+  EXPECT_CALL(*mock_, ReadObject)
+      .WillOnce([&](internal::ReadObjectRangeRequest const& r) {
+        EXPECT_FALSE(r.HasOption<ReadFromOffset>());
+        auto read_source = std::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+        EXPECT_CALL(*read_source, Read).WillOnce([&](char*, std::size_t) {
+          // The process may crash here, before the first checkpoint. The
+          // stale manifest must not describe the truncated file.
+          EXPECT_FALSE(FileExists(manifest_name));
+          return StatusOr<internal::ReadSourceResult>(PermanentError());
+        });
+        EXPECT_CALL(*read_source, Close).Times(AtMost(1));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(read_source));
+      });
+
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(),
+      Options{}.set<EnableDownloadManifestOption>(true));
+  EXPECT_THAT(actual, StatusIs(PermanentError().code()));
+  EXPECT_FALSE(FileExists(manifest_name));
+}
+
+TEST_F(ObjectTest, DownloadToFileWithManifestRanged) {
+  EXPECT_CALL(*mock_, ReadObject).Times(0);
+  TempFile temp("");
+  auto client = ClientForMock();
+  auto actual = client.DownloadToFile(
+      "test-bucket-name", "test-object-name", temp.name(), ReadFromOffset(8),
+      Options{}.set<EnableDownloadManifestOption>(true));
+  EXPECT_THAT(actual, StatusIs(StatusCode::kInvalidArgument));
+}
+
 TEST_F(ObjectTest, DeleteObject) {
   EXPECT_CALL(*mock_, DeleteObject)
       .WillOnce(Return(StatusOr<internal::EmptyResponse>(TransientError())))
@@ -17,6 +17,7 @@
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/internal/absl_str_join_quiet.h"
+#include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/internal/curl_options.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/populate_common_options.h"
@@ -89,6 +90,15 @@ std::size_t DefaultConnectionPoolSize() {
 #define GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_STALL_TIMEOUT 120
 #endif  // GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_STALL_TIMEOUT
 
+#ifndef GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_CHECKPOINT_BYTES
+#define GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_CHECKPOINT_BYTES \
+  (64 * 1024 * 1024)
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_CHECKPOINT_BYTES
+
+#ifndef GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_CHECKPOINT_PERIOD
+#define GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_CHECKPOINT_PERIOD 10
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_CHECKPOINT_PERIOD
+
 // Define the defaults using a pre-processor macro, this allows the application
 // developers to change the defaults for their application by compiling with
 // different values.
@@ -193,10 +203,15 @@ Options DefaultOptions(std::shared_ptr<oauth2::Credentials> credentials,
           .set<ConnectionPoolSizeOption>(DefaultConnectionPoolSize())
           .set<DownloadBufferSizeOption>(
               GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_BUFFER_SIZE)
+          .set<DownloadManifestCheckpointBytesOption>(
+              GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_CHECKPOINT_BYTES)
+          .set<DownloadManifestCheckpointPeriodOption>(std::chrono::seconds(
+              GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_CHECKPOINT_PERIOD))
           .set<UploadBufferSizeOption>(
               GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_UPLOAD_BUFFER_SIZE)
           .set<MaximumSimpleUploadSizeOption>(
               GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MAXIMUM_SIMPLE_UPLOAD_SIZE)
+          .set<MaximumBulkConcurrencyOption>(1)
           .set<EnableCurlSslLockingOption>(true)
           .set<EnableCurlSigpipeHandlerOption>(true)
           .set<MaximumCurlSocketRecvSizeOption>(0)
@@ -304,8 +319,8 @@ Options DefaultOptionsWithCredentials(Options opts) {
         std::move(opts));
   }
   auto credentials =
-      internal::MapCredentials(*google::cloud::MakeGoogleDefaultCredentials(
-          google::cloud::internal::MakeAuthOptions(opts)));
+      internal::MapCredentials(*google::cloud::internal::
+                                   SharedGoogleDefaultCredentials(opts));
   return internal::DefaultOptions(std::move(credentials), std::move(opts));
 }
 
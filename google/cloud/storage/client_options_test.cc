@@ -332,6 +332,7 @@ TEST_F(ClientOptionsTest, MakeOptionsFromDefault) {
   EXPECT_LT(0, opts.get<DownloadStallMinimumRateOption>());
   EXPECT_LT(0, opts.get<UploadBufferSizeOption>());
   EXPECT_LT(0, opts.get<MaximumSimpleUploadSizeOption>());
+  EXPECT_EQ(1, opts.get<MaximumBulkConcurrencyOption>());
   EXPECT_TRUE(opts.has<EnableCurlSslLockingOption>());
   EXPECT_TRUE(opts.has<EnableCurlSigpipeHandlerOption>());
   EXPECT_EQ(0, opts.get<MaximumCurlSocketSendSizeOption>());
@@ -17,7 +17,10 @@
 #include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -27,7 +30,9 @@ namespace storage {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
+using ::testing::ElementsAre;
 using ::testing::Return;
+using ::testing::UnorderedElementsAre;
 
 ObjectMetadata MockObject(std::string const& bucket_name,
                           std::string const& object_name, int generation) {
@@ -361,6 +366,70 @@ TEST(ComposeMany, LockingPrefixFails) {
   EXPECT_EQ(StatusCode::kFailedPrecondition, res.status().code());
 }
 
+TEST(ComposeMany, Concurrent) {
+  auto mock = std::make_shared<testing::MockClient>();
+
+  // Test 100 sources. The four compositions in the first level wait for each
+  // other, so they must run concurrently.
+  std::mutex mu;
+  std::condition_variable cv;
+  int arrived = 0;
+  EXPECT_CALL(*mock, ComposeObject)
+      .Times(5)
+      .WillRepeatedly([&](internal::ComposeObjectRequest const& req)
+                          -> StatusOr<ObjectMetadata> {
+        auto parsed = nlohmann::json::parse(req.JsonPayload());
+        std::vector<std::string> names;
+        for (auto const& o : parsed["sourceObjects"]) {
+          names.push_back(o.value("name", ""));
+        }
+        if (req.object_name() == "dest") {
+          EXPECT_THAT(names, ElementsAre("prefix.compose-tmp-0",
+                                         "prefix.compose-tmp-1",
+                                         "prefix.compose-tmp-2",
+                                         "prefix.compose-tmp-3"));
+          return MockObject(req.bucket_name(), req.object_name(), 42);
+        }
+        std::unique_lock<std::mutex> lk(mu);
+        ++arrived;
+        cv.notify_all();
+        EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(30),
+                                [&] { return arrived == 4; }));
+        return MockObject(req.bucket_name(), req.object_name(), 42);
+      });
+  EXPECT_CALL(*mock, InsertObjectMedia)
+      .WillOnce(
+          Return(make_status_or(MockObject("test-bucket", "prefix", 42))));
+  std::vector<std::string> deleted;
+  EXPECT_CALL(*mock, DeleteObject)
+      .Times(5)
+      .WillRepeatedly([&](internal::DeleteObjectRequest const& r) {
+        std::lock_guard<std::mutex> lk(mu);
+        deleted.push_back(r.object_name());
+        return make_status_or(internal::EmptyResponse{});
+      });
+
+  auto client = testing::ClientFromMock(mock);
+
+  std::vector<ComposeSourceObject> sources;
+  std::size_t i = 0;
+  std::generate_n(std::back_inserter(sources), 100, [&i] {
+    return ComposeSourceObject{std::to_string(i++), 42, {}};
+  });
+
+  auto res = ComposeMany(client, "test-bucket", sources, "prefix", "dest",
+                         false, Options{}.set<MaximumBulkConcurrencyOption>(4));
+  ASSERT_STATUS_OK(res);
+  EXPECT_EQ("dest", res->name());
+  // The lock object is always deleted last.
+  ASSERT_EQ(deleted.size(), 5);
+  EXPECT_EQ(deleted.back(), "prefix");
+  deleted.pop_back();
+  EXPECT_THAT(deleted, UnorderedElementsAre(
+                           "prefix.compose-tmp-0", "prefix.compose-tmp-1",
+                           "prefix.compose-tmp-2", "prefix.compose-tmp-3"));
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage
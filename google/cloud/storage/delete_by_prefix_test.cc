@@ -17,7 +17,10 @@
 #include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -30,6 +33,7 @@ namespace {
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::HasSubstr;
 using ::testing::Return;
+using ::testing::UnorderedElementsAre;
 
 ObjectMetadata CreateObject(int index) {
   std::string id = "object-" + std::to_string(index);
@@ -172,6 +176,130 @@ TEST(DeleteByPrefix, DeleteByPrefixDeleteFailure) {
   EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
 }
 
+TEST(DeleteByPrefix, Batch) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .WillOnce([](internal::ListObjectsRequest const&) {
+        internal::ListObjectsResponse response;
+        for (int i = 0; i != 150; ++i) {
+          response.items.emplace_back(CreateObject(i));
+        }
+        return make_status_or(std::move(response));
+      });
+  EXPECT_CALL(*mock, DeleteObject).Times(0);
+  auto make_response = [](internal::BatchRequest const& r) {
+    for (auto const& item : r.items()) {
+      auto const& d = absl::get<internal::DeleteObjectRequest>(item);
+      EXPECT_EQ("test-bucket", d.bucket_name());
+      EXPECT_EQ(d.GetOption<Generation>().value_or(0), 1);
+      EXPECT_EQ(d.GetOption<UserProject>().value_or(""), "project-to-bill");
+    }
+    internal::BatchResponse response;
+    response.items.assign(r.size(), std::string{});
+    // Objects deleted concurrently are not an error.
+    response.items.back() = Status(StatusCode::kNotFound, "not found");
+    return make_status_or(std::move(response));
+  };
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .WillOnce([&](internal::BatchRequest const& r) {
+        EXPECT_EQ(r.size(), 100);
+        return make_response(r);
+      })
+      .WillOnce([&](internal::BatchRequest const& r) {
+        EXPECT_EQ(r.size(), 50);
+        return make_response(r);
+      });
+  auto client = testing::ClientFromMock(mock);
+  auto status = DeleteByPrefix(client, "test-bucket", "object-", Versions(),
+                               UserProject("project-to-bill"));
+  EXPECT_STATUS_OK(status);
+}
+
+TEST(DeleteByPrefix, BatchItemFailure) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .WillOnce([](internal::ListObjectsRequest const&) {
+        internal::ListObjectsResponse response;
+        response.items.emplace_back(CreateObject(1));
+        response.items.emplace_back(CreateObject(2));
+        return make_status_or(std::move(response));
+      });
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .WillOnce(Return(make_status_or(internal::BatchResponse{
+          {std::string{}, Status(StatusCode::kPermissionDenied, "")}})));
+  auto client = testing::ClientFromMock(mock);
+  auto status = DeleteByPrefix(client, "test-bucket", "object-");
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST(DeleteByPrefix, BatchConcurrent) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .WillOnce([](internal::ListObjectsRequest const&) {
+        internal::ListObjectsResponse response;
+        for (int i = 0; i != 350; ++i) {
+          response.items.emplace_back(CreateObject(i));
+        }
+        return make_status_or(std::move(response));
+      });
+  // The four batches wait for each other, so they must run concurrently.
+  std::mutex mu;
+  std::condition_variable cv;
+  int arrived = 0;
+  std::vector<std::size_t> sizes;
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .Times(4)
+      .WillRepeatedly([&](internal::BatchRequest const& r) {
+        auto const& options = google::cloud::internal::CurrentOptions();
+        EXPECT_EQ(options.get<MaximumBulkConcurrencyOption>(), 4);
+        std::unique_lock<std::mutex> lk(mu);
+        sizes.push_back(r.size());
+        ++arrived;
+        cv.notify_all();
+        EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(30),
+                                [&] { return arrived == 4; }));
+        internal::BatchResponse response;
+        response.items.assign(r.size(), std::string{});
+        return make_status_or(std::move(response));
+      });
+  auto client = testing::ClientFromMock(mock);
+  auto status =
+      DeleteByPrefix(client, "test-bucket", "object-",
+                     Options{}.set<MaximumBulkConcurrencyOption>(4));
+  EXPECT_STATUS_OK(status);
+  EXPECT_THAT(sizes, UnorderedElementsAre(100, 100, 100, 50));
+}
+
+TEST(DeleteByPrefix, BatchConcurrentFallback) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .WillOnce([](internal::ListObjectsRequest const&) {
+        internal::ListObjectsResponse response;
+        for (int i = 0; i != 250; ++i) {
+          response.items.emplace_back(CreateObject(i));
+        }
+        return make_status_or(std::move(response));
+      });
+  // The default `ExecuteBatch()` mock returns `kUnimplemented`.
+  std::mutex mu;
+  int count = 0;
+  EXPECT_CALL(*mock, DeleteObject)
+      .Times(250)
+      .WillRepeatedly([&](internal::DeleteObjectRequest const&) {
+        std::lock_guard<std::mutex> lk(mu);
+        if (++count == 200) {
+          return StatusOr<internal::EmptyResponse>(
+              Status(StatusCode::kPermissionDenied, "uh-oh"));
+        }
+        return make_status_or(internal::EmptyResponse{});
+      });
+  auto client = testing::ClientFromMock(mock);
+  auto status =
+      DeleteByPrefix(client, "test-bucket", "object-",
+                     Options{}.set<MaximumBulkConcurrencyOption>(2));
+  EXPECT_THAT(status, StatusIs(StatusCode::kPermissionDenied));
+}
+
 TEST(DeleteByPrefix, ComposeManyNone) {
   auto mock = std::make_shared<testing::MockClient>();
   auto client = testing::ClientFromMock(mock);
@@ -70,6 +70,67 @@ struct ReadLast : public internal::ComplexOption<ReadLast, std::int64_t> {
   static char const* name() { return "read-last"; }
 };
 
+/**
+ * The state needed to resume an interrupted `ReadObject()` download.
+ *
+ * Applications obtain these values from `ObjectReadStream::resume_token()`,
+ * store them together with the data received so far, and use `ResumeReadObject`
+ * to continue the download, for example after the process restarts.
+ *
+ * @par Example
+ * @code
+ * auto token = *reader.resume_token();  // save with the data received so far
+ * // ... later, possibly in a new process ...
+ * auto resumed = client.ReadObject(bucket, object, ResumeReadObject(token));
+ * @endcode
+ */
+struct ReadObjectResumeToken {
+  /// The generation of the object being downloaded.
+  std::int64_t generation;
+  /// The number of bytes already received.
+  std::int64_t offset;
+  /// The CRC32C checksum of the first @p offset bytes of the object.
+  std::uint32_t crc32c;
+};
+
+inline bool operator==(ReadObjectResumeToken const& lhs,
+                       ReadObjectResumeToken const& rhs) {
+  return lhs.generation == rhs.generation && lhs.offset == rhs.offset &&
+         lhs.crc32c == rhs.crc32c;
+}
+
+inline bool operator!=(ReadObjectResumeToken const& lhs,
+                       ReadObjectResumeToken const& rhs) {
+  return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os,
+                                ReadObjectResumeToken const& rhs) {
+  return os << "ReadObjectResumeToken={generation=" << rhs.generation
+            << ", offset=" << rhs.offset << ", crc32c=" << rhs.crc32c << "}";
+}
+
+/**
+ * Resume a `ReadObject()` download from a `ReadObjectResumeToken`.
+ *
+ * The download reads the generation recorded in the token, starting at the
+ * recorded offset. Unlike `ReadFromOffset`, the stream still validates the
+ * CRC32C checksum of the full object, using the checksum in the token for the
+ * data received before the interruption. MD5 hashes cannot be resumed, and are
+ * not validated.
+ *
+ * This option cannot be combined with `ReadFromOffset`, `ReadRange`, or
+ * `ReadLast`.
+ */
+struct ResumeReadObject
+    : public internal::ComplexOption<ResumeReadObject, ReadObjectResumeToken> {
+  using ComplexOption::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  ResumeReadObject() = default;
+  static char const* name() { return "resume-read-object"; }
+};
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage
 }  // namespace cloud
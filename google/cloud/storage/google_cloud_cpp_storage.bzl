@@ -50,6 +50,7 @@ google_cloud_cpp_storage_hdrs = [
     "internal/access_control_common_parser.h",
     "internal/access_token_credentials.h",
     "internal/base64.h",
+    "internal/batch_requests.h",
     "internal/binary_data_as_debug_string.h",
     "internal/bucket_access_control_parser.h",
     "internal/bucket_acl_requests.h",
@@ -66,6 +67,7 @@ google_cloud_cpp_storage_hdrs = [
     "internal/curl/request.h",
     "internal/curl/request_builder.h",
     "internal/default_object_acl_requests.h",
+    "internal/download_manifest.h",
     "internal/empty_response.h",
     "internal/error_credentials.h",
     "internal/generate_message_boundary.h",
@@ -100,7 +102,9 @@ google_cloud_cpp_storage_hdrs = [
     "internal/patch_builder.h",
     "internal/patch_builder_details.h",
     "internal/policy_document_request.h",
+    "internal/read_ahead_object_read_source.h",
     "internal/request_project_id.h",
+    "internal/rest/batch_builder.h",
     "internal/rest/object_read_source.h",
     "internal/rest/request_builder.h",
     "internal/rest/stub.h",
@@ -181,6 +185,7 @@ google_cloud_cpp_storage_srcs = [
     "internal/access_control_common_parser.cc",
     "internal/access_token_credentials.cc",
     "internal/base64.cc",
+    "internal/batch_requests.cc",
     "internal/bucket_access_control_parser.cc",
     "internal/bucket_acl_requests.cc",
     "internal/bucket_metadata_parser.cc",
@@ -191,6 +196,7 @@ google_cloud_cpp_storage_srcs = [
     "internal/const_buffer.cc",
     "internal/crc32c.cc",
     "internal/default_object_acl_requests.cc",
+    "internal/download_manifest.cc",
     "internal/empty_response.cc",
     "internal/error_credentials.cc",
     "internal/generate_message_boundary.cc",
@@ -222,7 +228,9 @@ google_cloud_cpp_storage_srcs = [
     "internal/patch_builder.cc",
     "internal/patch_builder_details.cc",
     "internal/policy_document_request.cc",
+    "internal/read_ahead_object_read_source.cc",
     "internal/request_project_id.cc",
+    "internal/rest/batch_builder.cc",
     "internal/rest/object_read_source.cc",
     "internal/rest/request_builder.cc",
     "internal/rest/stub.cc",
@@ -76,6 +76,8 @@ add_library(
     internal/access_token_credentials.h
     internal/base64.cc
     internal/base64.h
+    internal/batch_requests.cc
+    internal/batch_requests.h
     internal/binary_data_as_debug_string.h
     internal/bucket_access_control_parser.cc
     internal/bucket_access_control_parser.h
@@ -102,6 +104,8 @@ add_library(
     internal/curl/request_builder.h
     internal/default_object_acl_requests.cc
     internal/default_object_acl_requests.h
+    internal/download_manifest.cc
+    internal/download_manifest.h
     internal/empty_response.cc
     internal/empty_response.h
     internal/error_credentials.cc
@@ -167,8 +171,12 @@ add_library(
     internal/patch_builder_details.h
     internal/policy_document_request.cc
     internal/policy_document_request.h
+    internal/read_ahead_object_read_source.cc
+    internal/read_ahead_object_read_source.h
     internal/request_project_id.cc
     internal/request_project_id.h
+    internal/rest/batch_builder.cc
+    internal/rest/batch_builder.h
     internal/rest/object_read_source.cc
     internal/rest/object_read_source.h
     internal/rest/request_builder.cc
@@ -455,6 +463,7 @@ if (BUILD_TESTING)
         internal/access_control_common_test.cc
         internal/access_token_credentials_test.cc
         internal/base64_test.cc
+        internal/batch_requests_test.cc
         internal/bucket_acl_requests_test.cc
         internal/bucket_requests_test.cc
         internal/complex_option_test.cc
@@ -472,6 +481,7 @@ if (BUILD_TESTING)
         internal/const_buffer_test.cc
         internal/crc32c_test.cc
         internal/default_object_acl_requests_test.cc
+        internal/download_manifest_test.cc
         internal/generate_message_boundary_test.cc
         internal/generic_request_test.cc
         internal/hash_function_impl_test.cc
@@ -491,7 +501,9 @@ if (BUILD_TESTING)
         internal/object_write_streambuf_test.cc
         internal/patch_builder_test.cc
         internal/policy_document_request_test.cc
+        internal/read_ahead_object_read_source_test.cc
         internal/request_project_id_test.cc
+        internal/rest/batch_builder_test.cc
         internal/rest/object_read_source_test.cc
         internal/rest/request_builder_test.cc
         internal/rest/stub_test.cc
@@ -554,8 +566,10 @@ if (BUILD_TESTING)
 
     include(FindBenchmarkWithWorkarounds)
 
-    set(storage_client_benchmarks # cmake-format: sort
-                                  internal/crc32c_benchmark.cc)
+    set(storage_client_benchmarks
+        # cmake-format: sort
+        internal/crc32c_benchmark.cc
+        internal/list_objects_parser_benchmark.cc)
 
     # Export the list of benchmarks to a .bzl file so we do not need to maintain
     # the list in two places.
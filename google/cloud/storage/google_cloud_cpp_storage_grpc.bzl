@@ -60,6 +60,7 @@ google_cloud_cpp_storage_grpc_hdrs = [
     "internal/grpc/bucket_name.h",
     "internal/grpc/bucket_request_parser.h",
     "internal/grpc/buffer_read_object_data.h",
+    "internal/grpc/channel_health.h",
     "internal/grpc/channel_refresh.h",
     "internal/grpc/configure_client_context.h",
     "internal/grpc/ctype_cord_workaround.h",
@@ -87,6 +88,7 @@ google_cloud_cpp_storage_grpc_hdrs = [
     "internal/grpc/stub.h",
     "internal/grpc/synthetic_self_link.h",
     "internal/storage_auth_decorator.h",
+    "internal/storage_channel_health_stub.h",
     "internal/storage_logging_decorator.h",
     "internal/storage_metadata_decorator.h",
     "internal/storage_round_robin_decorator.h",
@@ -153,6 +155,7 @@ google_cloud_cpp_storage_grpc_srcs = [
     "internal/grpc/stub.cc",
     "internal/grpc/synthetic_self_link.cc",
     "internal/storage_auth_decorator.cc",
+    "internal/storage_channel_health_stub.cc",
     "internal/storage_logging_decorator.cc",
     "internal/storage_metadata_decorator.cc",
     "internal/storage_round_robin_decorator.cc",
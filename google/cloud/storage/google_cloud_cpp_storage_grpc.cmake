@@ -142,6 +142,7 @@ add_library(
     internal/grpc/bucket_request_parser.h
     internal/grpc/buffer_read_object_data.cc
     internal/grpc/buffer_read_object_data.h
+    internal/grpc/channel_health.h
     internal/grpc/channel_refresh.cc
     internal/grpc/channel_refresh.h
     internal/grpc/configure_client_context.cc
@@ -195,6 +196,8 @@ add_library(
     internal/grpc/synthetic_self_link.h
     internal/storage_auth_decorator.cc
     internal/storage_auth_decorator.h
+    internal/storage_channel_health_stub.cc
+    internal/storage_channel_health_stub.h
     internal/storage_logging_decorator.cc
     internal/storage_logging_decorator.h
     internal/storage_metadata_decorator.cc
@@ -422,6 +425,7 @@ set(storage_client_grpc_unit_tests
     internal/grpc/bucket_name_test.cc
     internal/grpc/bucket_request_parser_test.cc
     internal/grpc/buffer_read_object_data_test.cc
+    internal/grpc/channel_refresh_test.cc
     internal/grpc/configure_client_context_test.cc
     internal/grpc/default_options_test.cc
     internal/grpc/hmac_key_metadata_parser_test.cc
@@ -449,6 +453,7 @@ set(storage_client_grpc_unit_tests
     internal/grpc/stub_test.cc
     internal/grpc/stub_upload_chunk_test.cc
     internal/grpc/synthetic_self_link_test.cc
+    internal/storage_channel_health_stub_test.cc
     internal/storage_stub_factory_test.cc)
 
 foreach (fname ${storage_client_grpc_unit_tests})
@@ -98,6 +98,26 @@ struct GrpcMetricsPeriodOption {
   using Type = std::chrono::seconds;
 };
 
+/**
+ * Replace gRPC channels that perform clearly worse than their peers.
+ *
+ * When this option is enabled, the client records the latency and transport
+ * errors of each unary RPC in the channel that carried it. Periodically, the
+ * client compares the channels and replaces the one that is clearly worse than
+ * the rest, for example, because it is connected to an overloaded frontend.
+ * New RPCs use the replacement channel, while any RPCs in progress complete on
+ * the old channel.
+ *
+ * The default is `false`. If `EnableGrpcMetricsOption` is also enabled, the
+ * channel scores are exported to [Google Cloud Monitoring] with the rest of
+ * the gRPC telemetry.
+ *
+ * [Google Cloud Monitoring]: https://cloud.google.com/monitoring/docs
+ */
+struct EnableGrpcChannelHealthOption {
+  using Type = bool;
+};
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage_experimental
 }  // namespace cloud
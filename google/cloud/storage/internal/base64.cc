@@ -31,15 +31,14 @@ StatusOr<std::vector<std::uint8_t>> Base64Decode(std::string const& str) {
 }
 
 std::string Base64Encode(std::string const& str) {
-  google::cloud::internal::Base64Encoder enc;
-  for (auto c : str) enc.PushBack(c);
-  return std::move(enc).FlushAndPad();
+  return Base64Encode(google::cloud::internal::AsOctets(str));
 }
 
 std::string Base64Encode(absl::Span<std::uint8_t const> bytes) {
-  google::cloud::internal::Base64Encoder enc;
-  for (auto c : bytes) enc.PushBack(c);
-  return std::move(enc).FlushAndPad();
+  std::string result(google::cloud::internal::Base64EncodedSize(bytes.size()),
+                     '\0');
+  google::cloud::internal::Base64EncodeBulk(bytes, absl::MakeSpan(result));
+  return result;
 }
 
 StatusOr<std::vector<std::uint8_t>> UrlsafeBase64Decode(
@@ -0,0 +1,56 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_requests.h"
+#include <ostream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+std::size_t constexpr BatchRequest::kMaxSize;
+
+std::ostream& operator<<(std::ostream& os, BatchRequest const& r) {
+  os << "BatchRequest={items=[";
+  char const* sep = "";
+  for (auto const& item : r.items()) {
+    os << sep;
+    absl::visit([&os](auto const& request) { os << request; }, item);
+    sep = ", ";
+  }
+  return os << "]}";
+}
+
+std::ostream& operator<<(std::ostream& os, BatchResponse const& r) {
+  os << "BatchResponse={items=[";
+  char const* sep = "";
+  for (auto const& item : r.items) {
+    os << sep;
+    if (item) {
+      os << "{payload=" << *item << "}";
+    } else {
+      os << "{status=" << item.status() << "}";
+    }
+    sep = ", ";
+  }
+  return os << "]}";
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,88 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H
+
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/variant.h"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/**
+ * Represents a JSON API batch request.
+ *
+ * GCS can execute up to 100 metadata operations in a single HTTP request,
+ * using a `multipart/mixed` payload. Each operation succeeds or fails
+ * independently.
+ *
+ * @see https://cloud.google.com/storage/docs/batch
+ */
+class BatchRequest {
+ public:
+  using Item = absl::variant<DeleteObjectRequest, PatchObjectRequest>;
+
+  /// The maximum number of operations in a single batch.
+  static std::size_t constexpr kMaxSize = 100;
+
+  BatchRequest() = default;
+  explicit BatchRequest(std::vector<Item> items) : items_(std::move(items)) {}
+
+  std::vector<Item> const& items() const { return items_; }
+  std::size_t size() const { return items_.size(); }
+  bool empty() const { return items_.empty(); }
+  bool full() const { return items_.size() >= kMaxSize; }
+
+  BatchRequest& Add(Item item) {
+    items_.push_back(std::move(item));
+    return *this;
+  }
+
+ private:
+  std::vector<Item> items_;
+};
+
+std::ostream& operator<<(std::ostream& os, BatchRequest const& r);
+
+/**
+ * The results of a JSON API batch request.
+ *
+ * There is one element for each item in the request, in the same order. On
+ * success the element contains the (possibly empty) payload returned by the
+ * service, for example, the object metadata returned by a `PatchObject`
+ * operation.
+ */
+struct BatchResponse {
+  std::vector<StatusOr<std::string>> items;
+};
+
+std::ostream& operator<<(std::ostream& os, BatchResponse const& r);
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUESTS_H
@@ -0,0 +1,71 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_requests.h"
+#include <gmock/gmock.h>
+#include <sstream>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::testing::HasSubstr;
+
+TEST(BatchRequestsTest, Basic) {
+  BatchRequest request;
+  EXPECT_TRUE(request.empty());
+  for (std::size_t i = 0; i != BatchRequest::kMaxSize; ++i) {
+    EXPECT_FALSE(request.full());
+    request.Add(DeleteObjectRequest("test-bucket", "o" + std::to_string(i)));
+  }
+  EXPECT_TRUE(request.full());
+  EXPECT_EQ(request.size(), BatchRequest::kMaxSize);
+}
+
+TEST(BatchRequestsTest, RequestStream) {
+  BatchRequest request;
+  request.Add(DeleteObjectRequest("test-bucket", "object-1"));
+  request.Add(PatchObjectRequest("test-bucket", "object-2",
+                                 ObjectMetadataPatchBuilder()));
+  std::ostringstream os;
+  os << request;
+  auto const actual = std::move(os).str();
+  EXPECT_THAT(actual, HasSubstr("BatchRequest={"));
+  EXPECT_THAT(actual, HasSubstr("DeleteObjectRequest={"));
+  EXPECT_THAT(actual, HasSubstr("object-1"));
+  EXPECT_THAT(actual, HasSubstr("PatchObjectRequest={"));
+  EXPECT_THAT(actual, HasSubstr("object-2"));
+}
+
+TEST(BatchRequestsTest, ResponseStream) {
+  BatchResponse response{
+      {std::string("test-payload"), Status(StatusCode::kNotFound, "nope")}};
+  std::ostringstream os;
+  os << response;
+  auto const actual = std::move(os).str();
+  EXPECT_THAT(actual, HasSubstr("BatchResponse={"));
+  EXPECT_THAT(actual, HasSubstr("test-payload"));
+  EXPECT_THAT(actual, HasSubstr("nope"));
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -17,9 +17,11 @@
 #include "google/cloud/internal/opentelemetry.h"
 #include "google/cloud/internal/rest_retry_loop.h"
 #include "absl/strings/match.h"
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -499,6 +501,74 @@ StatusOr<RewriteObjectResponse> StorageConnectionImpl::RewriteObject(
       google::cloud::internal::CurrentOptions(), request, __func__);
 }
 
+// The items in a batch succeed or fail independently. The batch is sent using
+// the usual retry loop, then any idempotent items that failed with transient
+// errors are sent again, in a smaller batch, until they succeed or the retry
+// policy is exhausted.
+StatusOr<BatchResponse> StorageConnectionImpl::ExecuteBatch(
+    BatchRequest const& request) {
+  auto const& current = google::cloud::internal::CurrentOptions();
+  std::function<void(std::chrono::milliseconds)> sleeper =
+      [](std::chrono::milliseconds d) { std::this_thread::sleep_for(d); };
+  sleeper = google::cloud::internal::MakeTracedSleeper(
+      current, std::move(sleeper), "Backoff");
+  auto retry_policy = current_retry_policy();
+  auto backoff_policy = current_backoff_policy();
+  auto is_idempotent = [](BatchRequest::Item const& item) {
+    return absl::visit(
+        [](auto const& r) {
+          return current_idempotency_policy().IsIdempotent(r);
+        },
+        item);
+  };
+
+  BatchResponse response;
+  response.items.resize(request.size());
+  std::vector<std::size_t> pending(request.size());
+  std::iota(pending.begin(), pending.end(), std::size_t{0});
+  auto attempt = request;
+  for (bool first = true;; first = false) {
+    auto const idempotency = std::all_of(attempt.items().begin(),
+                                         attempt.items().end(), is_idempotent)
+                                 ? Idempotency::kIdempotent
+                                 : Idempotency::kNonIdempotent;
+    auto result = RestRetryLoop(
+        *retry_policy, *backoff_policy, idempotency,
+        [this](rest_internal::RestContext& context, Options const& options,
+               auto const& request) {
+          return stub_->ExecuteBatch(context, options, request);
+        },
+        current, attempt, __func__);
+    if (!result) {
+      if (first) return result;
+      for (auto i : pending) response.items[i] = result.status();
+      return response;
+    }
+    std::vector<std::size_t> retry;
+    BatchRequest next;
+    for (std::size_t j = 0; j != pending.size(); ++j) {
+      auto const i = pending[j];
+      response.items[i] =
+          j < result->items.size()
+              ? std::move(result->items[j])
+              : google::cloud::internal::InternalError(
+                    "missing result for batch item", GCP_ERROR_INFO());
+      auto const& status = response.items[i].status();
+      if (status.ok() || retry_policy->IsPermanentFailure(status)) continue;
+      if (!is_idempotent(request.items()[i])) continue;
+      retry.push_back(i);
+      next.Add(request.items()[i]);
+    }
+    if (retry.empty()) return response;
+    if (!retry_policy->OnFailure(response.items[retry.front()].status())) {
+      return response;
+    }
+    sleeper(backoff_policy->OnCompletion());
+    pending = std::move(retry);
+    attempt = std::move(next);
+  }
+}
+
 StatusOr<CreateResumableUploadResponse>
 StorageConnectionImpl::CreateResumableUpload(
     ResumableUploadRequest const& request) {
@@ -17,9 +17,12 @@
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_generic_stub.h"
 #include "google/cloud/storage/testing/retry_tests.h"
+#include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -37,7 +40,11 @@ using ::google::cloud::storage::testing::StoppedOnPermanentError;
 using ::google::cloud::storage::testing::StoppedOnTooManyTransients;
 using ::google::cloud::storage::testing::canonical_errors::PermanentError;
 using ::google::cloud::storage::testing::canonical_errors::TransientError;
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
 using ::testing::IsEmpty;
+using ::testing::Return;
 
 TEST(StorageConnectionImpl, InsertObjectMediaTooManyFailures) {
   auto transient = MockRetryClientFunction(TransientError());
@@ -370,6 +377,108 @@ TEST(StorageConnectionImpl, PatchObjectPermanentFailure) {
   EXPECT_THAT(permanent.captured_authority_options(), RetryLoopUsesOptions());
 }
 
+TEST(StorageConnectionImpl, ExecuteBatchTooManyFailures) {
+  auto mock = std::make_unique<MockGenericStub>();
+  EXPECT_CALL(*mock, options);
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .Times(3)
+      .WillRepeatedly(Return(StatusOr<BatchResponse>(TransientError())));
+  auto client =
+      StorageConnectionImpl::Create(std::move(mock), RetryTestOptions());
+  google::cloud::internal::OptionsSpan span(client->options());
+  auto response = client->ExecuteBatch(BatchRequest()).status();
+  EXPECT_THAT(response, StoppedOnTooManyTransients("ExecuteBatch"));
+}
+
+TEST(StorageConnectionImpl, ExecuteBatchPermanentFailure) {
+  auto mock = std::make_unique<MockGenericStub>();
+  EXPECT_CALL(*mock, options);
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .WillOnce(Return(StatusOr<BatchResponse>(PermanentError())));
+  auto client =
+      StorageConnectionImpl::Create(std::move(mock), RetryTestOptions());
+  google::cloud::internal::OptionsSpan span(client->options());
+  auto response = client->ExecuteBatch(BatchRequest()).status();
+  EXPECT_THAT(response, StoppedOnPermanentError("ExecuteBatch"));
+}
+
+BatchRequest MakeDeleteBatch(int count) {
+  BatchRequest request;
+  for (int i = 0; i != count; ++i) {
+    request.Add(DeleteObjectRequest("test-bucket", "o" + std::to_string(i))
+                    .set_multiple_options(Generation(1)));
+  }
+  return request;
+}
+
+std::vector<std::string> ObjectNames(BatchRequest const& request) {
+  std::vector<std::string> names;
+  for (auto const& item : request.items()) {
+    names.push_back(absl::get<DeleteObjectRequest>(item).object_name());
+  }
+  return names;
+}
+
+TEST(StorageConnectionImpl, ExecuteBatchRetriesFailedItems) {
+  auto mock = std::make_unique<MockGenericStub>();
+  EXPECT_CALL(*mock, options);
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .WillOnce([](auto&, auto const&, BatchRequest const& request) {
+        EXPECT_THAT(ObjectNames(request), ElementsAre("o0", "o1", "o2"));
+        return make_status_or(BatchResponse{
+            {std::string{}, TransientError(), PermanentError()}});
+      })
+      .WillOnce([](auto&, auto const&, BatchRequest const& request) {
+        EXPECT_THAT(ObjectNames(request), ElementsAre("o1"));
+        return make_status_or(BatchResponse{{std::string{"o1-result"}}});
+      });
+  auto client =
+      StorageConnectionImpl::Create(std::move(mock), RetryTestOptions());
+  google::cloud::internal::OptionsSpan span(client->options());
+  auto response = client->ExecuteBatch(MakeDeleteBatch(3));
+  ASSERT_STATUS_OK(response);
+  EXPECT_THAT(response->items,
+              ElementsAre(IsOkAndHolds(IsEmpty()), IsOkAndHolds("o1-result"),
+                          StatusIs(PermanentError().code())));
+}
+
+TEST(StorageConnectionImpl, ExecuteBatchItemsTooManyFailures) {
+  auto mock = std::make_unique<MockGenericStub>();
+  EXPECT_CALL(*mock, options);
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .Times(3)
+      .WillRepeatedly([](auto&, auto const&, BatchRequest const& request) {
+        BatchResponse response;
+        response.items.assign(request.size(), TransientError());
+        return make_status_or(std::move(response));
+      });
+  auto client =
+      StorageConnectionImpl::Create(std::move(mock), RetryTestOptions());
+  google::cloud::internal::OptionsSpan span(client->options());
+  auto response = client->ExecuteBatch(MakeDeleteBatch(2));
+  ASSERT_STATUS_OK(response);
+  EXPECT_THAT(response->items,
+              ElementsAre(StatusIs(TransientError().code()),
+                          StatusIs(TransientError().code())));
+}
+
+TEST(StorageConnectionImpl, ExecuteBatchNonIdempotentItems) {
+  auto mock = std::make_unique<MockGenericStub>();
+  EXPECT_CALL(*mock, options);
+  EXPECT_CALL(*mock, ExecuteBatch)
+      .WillOnce(Return(make_status_or(BatchResponse{{TransientError()}})));
+  auto client = StorageConnectionImpl::Create(
+      std::move(mock),
+      RetryTestOptions().set<IdempotencyPolicyOption>(
+          StrictIdempotencyPolicy().clone()));
+  google::cloud::internal::OptionsSpan span(client->options());
+  auto response = client->ExecuteBatch(
+      BatchRequest().Add(DeleteObjectRequest("test-bucket", "o0")));
+  ASSERT_STATUS_OK(response);
+  EXPECT_THAT(response->items,
+              ElementsAre(StatusIs(TransientError().code())));
+}
+
 }  // namespace
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
@@ -0,0 +1,148 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/download_manifest.h"
+#include "google/cloud/internal/make_status.h"
+#include <nlohmann/json.hpp>
+#include <fcntl.h>
+#if _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif  // _WIN32
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <system_error>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+bool operator==(DownloadManifest const& a, DownloadManifest const& b) {
+  return a.bucket_name == b.bucket_name && a.object_name == b.object_name &&
+         a.generation == b.generation && a.offset == b.offset &&
+         a.crc32c == b.crc32c;
+}
+
+std::ostream& operator<<(std::ostream& os, DownloadManifest const& rhs) {
+  return os << "DownloadManifest={bucket_name=" << rhs.bucket_name
+            << ", object_name=" << rhs.object_name
+            << ", generation=" << rhs.generation << ", offset=" << rhs.offset
+            << ", crc32c=" << rhs.crc32c << "}";
+}
+
+Status SyncFile(std::string const& file_name) {
+  auto error = [&file_name](char const* what) {
+    auto const ec = std::error_code(errno, std::generic_category());
+    return google::cloud::internal::UnknownError(
+        std::string(what) + " " + file_name + ": " + ec.message(),
+        GCP_ERROR_INFO());
+  };
+#if _WIN32
+  auto fd = ::_open(file_name.c_str(), _O_RDWR | _O_BINARY);
+  if (fd == -1) return error("cannot open");
+  auto const synced = ::_commit(fd) == 0;
+  auto status = synced ? Status{} : error("cannot sync");
+  ::_close(fd);
+#else
+  auto fd = ::open(file_name.c_str(), O_WRONLY);
+  if (fd == -1) return error("cannot open");
+  auto const synced = ::fsync(fd) == 0;
+  auto status = synced ? Status{} : error("cannot sync");
+  ::close(fd);
+#endif  // _WIN32
+  return status;
+}
+
+std::string DownloadManifestName(std::string const& file_name) {
+  return file_name + ".manifest";
+}
+
+StatusOr<DownloadManifest> ReadDownloadManifest(
+    std::string const& manifest_name) {
+  std::ifstream is(manifest_name, std::ios::binary);
+  if (!is.is_open()) {
+    return google::cloud::internal::NotFoundError(
+        "cannot open download manifest " + manifest_name, GCP_ERROR_INFO());
+  }
+  std::string contents{std::istreambuf_iterator<char>{is}, {}};
+  auto json = nlohmann::json::parse(contents, nullptr, false);
+  auto invalid = [&manifest_name] {
+    return google::cloud::internal::InvalidArgumentError(
+        "invalid download manifest " + manifest_name, GCP_ERROR_INFO());
+  };
+  if (!json.is_object()) return invalid();
+  auto const bucket = json.find("bucket");
+  auto const name = json.find("name");
+  auto const generation = json.find("generation");
+  auto const offset = json.find("offset");
+  auto const crc32c = json.find("crc32c");
+  if (bucket == json.end() || !bucket->is_string() || name == json.end() ||
+      !name->is_string() || generation == json.end() ||
+      !generation->is_number_integer() || offset == json.end() ||
+      !offset->is_number_integer() || crc32c == json.end() ||
+      !crc32c->is_number_unsigned()) {
+    return invalid();
+  }
+  DownloadManifest manifest;
+  manifest.bucket_name = bucket->get<std::string>();
+  manifest.object_name = name->get<std::string>();
+  manifest.generation = generation->get<std::int64_t>();
+  manifest.offset = offset->get<std::int64_t>();
+  manifest.crc32c = crc32c->get<std::uint32_t>();
+  if (manifest.offset < 0) return invalid();
+  return manifest;
+}
+
+Status WriteDownloadManifest(std::string const& manifest_name,
+                             DownloadManifest const& manifest) {
+  auto const json = nlohmann::json{
+      {"bucket", manifest.bucket_name},
+      {"name", manifest.object_name},
+      {"generation", manifest.generation},
+      {"offset", manifest.offset},
+      {"crc32c", manifest.crc32c},
+  };
+  auto const tmp = manifest_name + ".tmp";
+  std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+  os << json.dump();
+  os.close();
+  if (!os.good()) {
+    return google::cloud::internal::UnknownError(
+        "cannot write download manifest " + tmp, GCP_ERROR_INFO());
+  }
+  // Otherwise, after a crash, the rename may be durable while the contents of
+  // the new manifest are not.
+  auto status = SyncFile(tmp);
+  if (!status.ok()) return status;
+  if (std::rename(tmp.c_str(), manifest_name.c_str()) == 0) return Status{};
+  // On Windows `std::rename()` fails if the destination already exists.
+  std::remove(manifest_name.c_str());
+  if (std::rename(tmp.c_str(), manifest_name.c_str()) == 0) return Status{};
+  return google::cloud::internal::UnknownError(
+      "cannot rename download manifest " + tmp + " to " + manifest_name,
+      GCP_ERROR_INFO());
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,96 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_MANIFEST_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_MANIFEST_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/**
+ * The progress of a `Client::DownloadToFile()` call.
+ *
+ * When `EnableDownloadManifestOption` is set, `DownloadToFile()` periodically
+ * saves this in a sidecar file. If the download fails, or the process crashes,
+ * or is preempted, the next `DownloadToFile()` call for the same object and
+ * destination resumes the download at `offset`. The `crc32c` field carries the
+ * checksum of the data already downloaded, so the checksum of the full object
+ * can be verified without reading that data again.
+ */
+struct DownloadManifest {
+  std::string bucket_name;
+  std::string object_name;
+  std::int64_t generation = 0;
+  /// The number of bytes already written to the destination.
+  std::int64_t offset = 0;
+  /// The CRC32C checksum of the first `offset` bytes of the object.
+  std::uint32_t crc32c = 0;
+};
+
+bool operator==(DownloadManifest const& a, DownloadManifest const& b);
+inline bool operator!=(DownloadManifest const& a, DownloadManifest const& b) {
+  return !(a == b);
+}
+
+std::ostream& operator<<(std::ostream& os, DownloadManifest const& rhs);
+
+/**
+ * Flushes the contents of @p file_name to stable storage.
+ *
+ * The data written to a file may stay in the operating system buffers, even
+ * after the file is closed. If the machine crashes, a manifest saved after
+ * that data may survive while the data does not.
+ */
+Status SyncFile(std::string const& file_name);
+
+/// Returns the name of the manifest used when downloading to @p file_name.
+std::string DownloadManifestName(std::string const& file_name);
+
+/**
+ * Loads a download manifest.
+ *
+ * Returns `kNotFound` if the file does not exist, and `kInvalidArgument` if
+ * its contents are not a valid manifest.
+ */
+StatusOr<DownloadManifest> ReadDownloadManifest(
+    std::string const& manifest_name);
+
+/**
+ * Saves a download manifest.
+ *
+ * The new contents are written to a temporary file, flushed to stable
+ * storage, and then renamed to @p manifest_name. Readers see either the
+ * previous or the new manifest, even if the process crashes while saving it.
+ */
+Status WriteDownloadManifest(std::string const& manifest_name,
+                             DownloadManifest const& manifest);
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_MANIFEST_H
@@ -0,0 +1,95 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/storage/internal/download_manifest.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <fstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::TempFile;
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::StatusIs;
+
+TEST(DownloadManifest, Name) {
+  EXPECT_EQ(DownloadManifestName("/tmp/object.bin"),
+            "/tmp/object.bin.manifest");
+}
+
+TEST(DownloadManifest, RoundTrip) {
+  TempFile temp("");
+  auto const name = DownloadManifestName(temp.name());
+  auto const expected = DownloadManifest{"test-bucket", "test-object",
+                                         1234567890123456L, 3 * 1024 * 1024,
+                                         0xFEDCBA98};
+  ASSERT_STATUS_OK(WriteDownloadManifest(name, expected));
+  EXPECT_THAT(ReadDownloadManifest(name), IsOkAndHolds(expected));
+
+  // Saving again replaces the previous contents.
+  auto updated = expected;
+  updated.offset *= 2;
+  updated.crc32c = 0x12345678;
+  ASSERT_STATUS_OK(WriteDownloadManifest(name, updated));
+  EXPECT_THAT(ReadDownloadManifest(name), IsOkAndHolds(updated));
+  EXPECT_EQ(std::remove(name.c_str()), 0);
+}
+
+TEST(DownloadManifest, SyncFile) {
+  TempFile temp("some data");
+  EXPECT_STATUS_OK(SyncFile(temp.name()));
+  EXPECT_THAT(SyncFile(DownloadManifestName(temp.name())),
+              StatusIs(StatusCode::kUnknown));
+}
+
+TEST(DownloadManifest, NotFound) {
+  TempFile temp("");
+  EXPECT_THAT(ReadDownloadManifest(DownloadManifestName(temp.name())),
+              StatusIs(StatusCode::kNotFound));
+}
+
+TEST(DownloadManifest, Invalid) {
+  for (auto const* contents : {
+           "",
+           "not-json",
+           "[]",
+           R"js({"bucket": "b", "name": "o", "generation": 1, "offset": 2})js",
+           R"js({"bucket": "b", "name": "o", "generation": "1",
+                 "offset": 2, "crc32c": 3})js",
+           R"js({"bucket": "b", "name": "o", "generation": 1,
+                 "offset": -2, "crc32c": 3})js",
+           R"js({"bucket": "b", "name": "o", "generation": 1,
+                 "offset": 2, "crc32c": -3})js",
+       }) {
+    TempFile temp(contents);
+    EXPECT_THAT(ReadDownloadManifest(temp.name()),
+                StatusIs(StatusCode::kInvalidArgument))
+        << "contents=" << contents;
+  }
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
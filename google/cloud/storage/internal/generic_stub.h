@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/bucket_metadata.h"
 #include "google/cloud/storage/client_options.h"
+#include "google/cloud/storage/internal/batch_requests.h"
 #include "google/cloud/storage/internal/bucket_acl_requests.h"
 #include "google/cloud/storage/internal/bucket_requests.h"
 #include "google/cloud/storage/internal/default_object_acl_requests.h"
@@ -130,6 +131,9 @@ class GenericStub {
   virtual StatusOr<storage::internal::RewriteObjectResponse> RewriteObject(
       rest_internal::RestContext&, Options const&,
       storage::internal::RewriteObjectRequest const&) = 0;
+  virtual StatusOr<storage::internal::BatchResponse> ExecuteBatch(
+      rest_internal::RestContext&, Options const&,
+      storage::internal::BatchRequest const&) = 0;
 
   virtual StatusOr<storage::internal::CreateResumableUploadResponse>
   CreateResumableUpload(rest_internal::RestContext&, Options const&,
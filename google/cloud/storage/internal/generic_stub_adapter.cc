@@ -141,6 +141,11 @@ class GenericStubAdapter : public GenericStub {
       storage::internal::RewriteObjectRequest const& request) override {
     return impl_->RewriteObject(request);
   }
+  StatusOr<storage::internal::BatchResponse> ExecuteBatch(
+      rest_internal::RestContext&, Options const&,
+      storage::internal::BatchRequest const& request) override {
+    return impl_->ExecuteBatch(request);
+  }
 
   StatusOr<storage::internal::CreateResumableUploadResponse>
   CreateResumableUpload(
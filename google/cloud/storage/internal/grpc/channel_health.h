@@ -0,0 +1,54 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GRPC_CHANNEL_HEALTH_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GRPC_CHANNEL_HEALTH_H
+
+#include "google/cloud/internal/channel_health.h"
+#include "google/cloud/version.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+// The scoring is shared with other libraries using gRPC channel pools.
+using GrpcChannelHealthPoint = ::google::cloud::internal::ChannelHealthPoint;
+using GrpcChannelPoolHealth = ::google::cloud::internal::ChannelPoolHealth;
+using GrpcChannelHealth = ::google::cloud::internal::ChannelHealth;
+
+/**
+ * Enables health scoring for the gRPC channels.
+ *
+ * If set, the client records the latency and result of each unary RPC in the
+ * channel that carried it. Long-running RPCs, such as `RewriteObject()`, are
+ * not recorded. Periodically, the client compares the channels and
+ * replaces the one that is clearly worse than its peers, for example, because
+ * it is connected to an overloaded frontend. New RPCs use the replacement
+ * channel, while any RPCs in progress complete on the old channel.
+ *
+ * The same object can be shared by multiple clients. Use
+ * `GrpcChannelHealth::Collect()` to export the scores as metrics.
+ */
+struct GrpcChannelHealthOption {
+  using Type = std::shared_ptr<GrpcChannelHealth>;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GRPC_CHANNEL_HEALTH_H
@@ -25,13 +25,25 @@ auto constexpr kRefreshPeriod = std::chrono::hours(1);
 
 GrpcChannelRefresh::GrpcChannelRefresh(
     std::vector<std::shared_ptr<grpc::Channel>> channels)
-    : channels_(std::move(channels)) {}
+    : GrpcChannelRefresh(std::move(channels), std::chrono::milliseconds(0),
+                         nullptr, nullptr) {}
+
+GrpcChannelRefresh::GrpcChannelRefresh(
+    std::vector<std::shared_ptr<grpc::Channel>> channels,
+    std::chrono::milliseconds period,
+    std::shared_ptr<GrpcChannelPoolHealth> health, ReplaceChannel replace)
+    : health_check_period_(period),
+      health_(std::move(health)),
+      replace_(std::move(replace)),
+      channels_(std::move(channels)) {}
 
 void GrpcChannelRefresh::StartRefreshLoop(google::cloud::CompletionQueue cq) {
   // Break the ownership cycle.
   auto wcq = std::weak_ptr<google::cloud::internal::CompletionQueueImpl>(
       google::cloud::internal::GetCompletionQueueImpl(std::move(cq)));
-  for (std::size_t i = 0; i != channels_.size(); ++i) Refresh(i, wcq);
+  auto const size = channels().size();
+  for (std::size_t i = 0; i != size; ++i) Refresh(i, wcq);
+  if (health_ && replace_) ScheduleHealthCheck(std::move(wcq));
 }
 
 void GrpcChannelRefresh::Refresh(
@@ -40,9 +52,11 @@ void GrpcChannelRefresh::Refresh(
   auto cq = wcq.lock();
   if (!cq) return;
   auto deadline = std::chrono::system_clock::now() + kRefreshPeriod;
-  // An invalid index, stop the loop.  There is no need for synchronization
-  // as the channels do not change after the class is initialized.
+  std::unique_lock<std::mutex> lk(mu_);
+  // An invalid index, stop the loop.
   if (index >= channels_.size()) return;
+  auto channel = channels_[index];
+  lk.unlock();
   if (index == 0) {
     // We create hundreds of channels in some VMs. That can create a lot of
     // noise in the logs. Logging only one channel is a good tradeoff. It shows
@@ -50,21 +64,56 @@ void GrpcChannelRefresh::Refresh(
     GCP_LOG(INFO) << "Refreshing channel [" << index << "]";
   }
   (void)google::cloud::internal::NotifyOnStateChange::Start(
-      std::move(cq), channels_.at(index), deadline)
-      .then(
-          [index, wcq = std::move(wcq), weak = WeakFromThis()](future<bool> f) {
-            if (auto self = weak.lock()) self->OnRefresh(index, wcq, f.get());
-          });
+      std::move(cq), channel, deadline)
+      .then([index, channel, wcq = std::move(wcq),
+             weak = WeakFromThis()](future<bool> f) {
+        if (auto self = weak.lock()) {
+          self->OnRefresh(index, channel, wcq, f.get());
+        }
+      });
 }
 
 void GrpcChannelRefresh::OnRefresh(
-    std::size_t index,
+    std::size_t index, std::shared_ptr<grpc::Channel> const& channel,
     std::weak_ptr<google::cloud::internal::CompletionQueueImpl> wcq, bool ok) {
   // The CQ is shutting down, or the channel is shutdown, stop the loop.
   if (!ok) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  // The channel was replaced, the replacement has its own loop.
+  if (index >= channels_.size() || channels_[index] != channel) return;
+  lk.unlock();
   Refresh(index, std::move(wcq));
 }
 
+void GrpcChannelRefresh::ScheduleHealthCheck(
+    std::weak_ptr<google::cloud::internal::CompletionQueueImpl> wcq) {
+  auto cq = wcq.lock();
+  if (!cq) return;
+  (void)cq->MakeRelativeTimer(health_check_period_)
+      .then([wcq = std::move(wcq), weak = WeakFromThis()](auto f) {
+        auto self = weak.lock();
+        // The CQ is shutting down, or the client was released, stop the loop.
+        if (!self || !f.get()) return;
+        self->CheckHealth(wcq);
+      });
+}
+
+void GrpcChannelRefresh::CheckHealth(
+    std::weak_ptr<google::cloud::internal::CompletionQueueImpl> wcq) {
+  auto const index = health_->Unhealthy();
+  auto channel = index ? replace_(*index) : nullptr;
+  if (channel) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (*index < channels_.size()) {
+      channels_[*index] = std::move(channel);
+      lk.unlock();
+      GCP_LOG(INFO) << "Replaced unhealthy channel [" << *index << "]";
+      Refresh(*index, wcq);
+    }
+  }
+  ScheduleHealthCheck(std::move(wcq));
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage_internal
 }  // namespace cloud
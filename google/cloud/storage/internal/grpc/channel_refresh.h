@@ -15,10 +15,14 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GRPC_CHANNEL_REFRESH_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GRPC_CHANNEL_REFRESH_H
 
+#include "google/cloud/storage/internal/grpc/channel_health.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/completion_queue.h"
 #include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace google {
@@ -29,13 +33,33 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 class GrpcChannelRefresh
     : public std::enable_shared_from_this<GrpcChannelRefresh> {
  public:
+  /// Creates a new channel to replace the channel at the given index.
+  using ReplaceChannel =
+      std::function<std::shared_ptr<grpc::Channel>(std::size_t)>;
+
   explicit GrpcChannelRefresh(
       std::vector<std::shared_ptr<grpc::Channel>> channels);
+
+  /**
+   * Also replaces the unhealthy channels.
+   *
+   * Every @p period the refresh loop asks @p health for the unhealthy channel,
+   * if any. The channel is replaced with the result of @p replace, which is
+   * expected to create a new channel (with a new connection) and start using
+   * it for new RPCs. At most one channel is replaced on each iteration, so a
+   * systemic problem, affecting all the channels, does not replace all the
+   * channels at once.
+   */
+  GrpcChannelRefresh(std::vector<std::shared_ptr<grpc::Channel>> channels,
+                     std::chrono::milliseconds period,
+                     std::shared_ptr<GrpcChannelPoolHealth> health,
+                     ReplaceChannel replace);
   ~GrpcChannelRefresh() = default;
 
   void StartRefreshLoop(google::cloud::CompletionQueue cq);
 
   std::vector<std::shared_ptr<grpc::Channel>> channels() const {
+    std::lock_guard<std::mutex> lk(mu_);
     return channels_;
   }
 
@@ -48,10 +72,20 @@ class GrpcChannelRefresh
                std::weak_ptr<google::cloud::internal::CompletionQueueImpl> wcq);
 
   void OnRefresh(
-      std::size_t index,
+      std::size_t index, std::shared_ptr<grpc::Channel> const& channel,
       std::weak_ptr<google::cloud::internal::CompletionQueueImpl> wcq, bool ok);
 
-  std::vector<std::shared_ptr<grpc::Channel>> channels_;
+  void ScheduleHealthCheck(
+      std::weak_ptr<google::cloud::internal::CompletionQueueImpl> wcq);
+
+  void CheckHealth(
+      std::weak_ptr<google::cloud::internal::CompletionQueueImpl> wcq);
+
+  std::chrono::milliseconds const health_check_period_;
+  std::shared_ptr<GrpcChannelPoolHealth> const health_;
+  ReplaceChannel const replace_;
+  mutable std::mutex mu_;
+  std::vector<std::shared_ptr<grpc::Channel>> channels_;  // GUARDED_BY(mu_)
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
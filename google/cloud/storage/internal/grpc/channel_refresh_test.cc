@@ -0,0 +1,136 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/grpc/channel_refresh.h"
+#include "google/cloud/testing_util/mock_completion_queue_impl.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::testing_util::MockCompletionQueueImpl;
+using ::testing::ElementsAre;
+using ::testing::MockFunction;
+
+using TimerResult = StatusOr<std::chrono::system_clock::time_point>;
+
+std::shared_ptr<grpc::Channel> MakeTestChannel() {
+  return grpc::CreateChannel("localhost:1",
+                             grpc::InsecureChannelCredentials());
+}
+
+// Stop the refresh loop for each channel after the first iteration.
+void ExpectRefresh(MockCompletionQueueImpl& mock, int times) {
+  EXPECT_CALL(mock, StartOperation)
+      .Times(times)
+      .WillRepeatedly([](auto const& op, auto) { op->Notify(false); });
+}
+
+TEST(GrpcChannelRefresh, RefreshOnly) {
+  auto c0 = MakeTestChannel();
+  auto c1 = MakeTestChannel();
+  auto mock = std::make_shared<MockCompletionQueueImpl>();
+  ExpectRefresh(*mock, 2);
+  EXPECT_CALL(*mock, MakeRelativeTimer).Times(0);
+
+  auto refresh = std::make_shared<GrpcChannelRefresh>(
+      std::vector<std::shared_ptr<grpc::Channel>>{c0, c1});
+  refresh->StartRefreshLoop(CompletionQueue(mock));
+  EXPECT_THAT(refresh->channels(), ElementsAre(c0, c1));
+}
+
+TEST(GrpcChannelRefresh, ReplacesUnhealthyChannel) {
+  auto c0 = MakeTestChannel();
+  auto c1 = MakeTestChannel();
+  auto c2 = MakeTestChannel();
+  auto replacement = MakeTestChannel();
+
+  auto pool = std::make_shared<GrpcChannelPoolHealth>(0, 3, 1, 3.0);
+  pool->Record(0, pool->Epoch(0), std::chrono::milliseconds(10),
+               StatusCode::kOk);
+  pool->Record(1, pool->Epoch(1), std::chrono::milliseconds(100),
+               StatusCode::kOk);
+  pool->Record(2, pool->Epoch(2), std::chrono::milliseconds(10),
+               StatusCode::kOk);
+
+  MockFunction<std::shared_ptr<grpc::Channel>(std::size_t)> replace;
+  EXPECT_CALL(replace, Call(1)).WillOnce([&](std::size_t index) {
+    // The replacement starts with a clean score.
+    pool->Reset(index);
+    return replacement;
+  });
+
+  auto mock = std::make_shared<MockCompletionQueueImpl>();
+  // The initial refresh for each channel, and the refresh for the
+  // replacement.
+  ExpectRefresh(*mock, 4);
+  ::testing::InSequence sequence;
+  EXPECT_CALL(*mock, MakeRelativeTimer)
+      .WillOnce([](std::chrono::nanoseconds d) {
+        EXPECT_EQ(d, std::chrono::seconds(5));
+        return make_ready_future(
+            TimerResult(std::chrono::system_clock::now()));
+      });
+  // The channel is no longer unhealthy, and the CQ is shutting down.
+  EXPECT_CALL(*mock, MakeRelativeTimer).WillOnce([](auto) {
+    return make_ready_future(TimerResult(
+        Status(StatusCode::kCancelled, "cancelled")));
+  });
+
+  auto refresh = std::make_shared<GrpcChannelRefresh>(
+      std::vector<std::shared_ptr<grpc::Channel>>{c0, c1, c2},
+      std::chrono::seconds(5), pool, replace.AsStdFunction());
+  refresh->StartRefreshLoop(CompletionQueue(mock));
+  EXPECT_THAT(refresh->channels(), ElementsAre(c0, replacement, c2));
+  EXPECT_EQ(pool->Collect()[1].replacements, 1);
+}
+
+TEST(GrpcChannelRefresh, HealthyChannels) {
+  auto pool = std::make_shared<GrpcChannelPoolHealth>(0, 3, 1, 3.0);
+  for (std::size_t i = 0; i != 3; ++i) {
+    pool->Record(i, pool->Epoch(i), std::chrono::milliseconds(10),
+                 StatusCode::kOk);
+  }
+  MockFunction<std::shared_ptr<grpc::Channel>(std::size_t)> replace;
+  EXPECT_CALL(replace, Call).Times(0);
+
+  auto mock = std::make_shared<MockCompletionQueueImpl>();
+  ExpectRefresh(*mock, 3);
+  ::testing::InSequence sequence;
+  EXPECT_CALL(*mock, MakeRelativeTimer).Times(2).WillRepeatedly([](auto) {
+    return make_ready_future(TimerResult(std::chrono::system_clock::now()));
+  });
+  EXPECT_CALL(*mock, MakeRelativeTimer).WillOnce([](auto) {
+    return make_ready_future(TimerResult(
+        Status(StatusCode::kCancelled, "cancelled")));
+  });
+
+  auto channels = std::vector<std::shared_ptr<grpc::Channel>>{
+      MakeTestChannel(), MakeTestChannel(), MakeTestChannel()};
+  auto refresh = std::make_shared<GrpcChannelRefresh>(
+      channels, std::chrono::seconds(5), pool, replace.AsStdFunction());
+  refresh->StartRefreshLoop(CompletionQueue(mock));
+  EXPECT_EQ(refresh->channels(), channels);
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage_internal
+}  // namespace cloud
+}  // namespace google
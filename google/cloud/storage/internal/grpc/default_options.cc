@@ -15,15 +15,17 @@
 #include "google/cloud/storage/internal/grpc/default_options.h"
 #include "google/cloud/storage/client_options.h"
 #include "google/cloud/storage/grpc_plugin.h"
+#include "google/cloud/storage/internal/grpc/channel_health.h"
 #include "google/cloud/storage/options.h"
 #include "google/cloud/common_options.h"
 #include "google/cloud/grpc_options.h"
+#include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/internal/getenv.h"
-#include "google/cloud/internal/populate_common_options.h"
 #include "google/cloud/internal/service_endpoint.h"
 #include "absl/strings/match.h"
 #include <grpcpp/grpcpp.h>
 #include <algorithm>
+#include <memory>
 #include <thread>
 
 namespace google {
@@ -54,6 +56,14 @@ int DefaultGrpcNumChannels(std::string const& endpoint) {
   return (std::max)(kMinimumChannels, static_cast<int>(count));
 }
 
+// All the clients share the same object, so the exported metrics include the
+// channels of every client.
+std::shared_ptr<GrpcChannelHealth> DefaultGrpcChannelHealth() {
+  static auto* const kHealth = new std::shared_ptr<GrpcChannelHealth>(
+      std::make_shared<GrpcChannelHealth>());
+  return *kHealth;
+}
+
 }  // namespace
 
 Options DefaultOptionsGrpc(Options options) {
@@ -69,8 +79,7 @@ Options DefaultOptionsGrpc(Options options) {
   if (!options.has<UnifiedCredentialsOption>() &&
       !options.has<GrpcCredentialOption>()) {
     options.set<UnifiedCredentialsOption>(
-        google::cloud::MakeGoogleDefaultCredentials(
-            google::cloud::internal::MakeAuthOptions(options)));
+        google::cloud::internal::SharedGoogleDefaultCredentials(options));
   }
   auto const testbench =
       GetEnv("CLOUD_STORAGE_EXPERIMENTAL_GRPC_TESTBENCH_ENDPOINT");
@@ -86,6 +95,8 @@ Options DefaultOptionsGrpc(Options options) {
   //     https://github.com/grpc/grpc/pull/36664
   auto const enable_grpc_metrics =
       !testbench.has_value() && GrpcEnableMetricsIsSafe();
+  // Setting the (internal) health option directly also enables the feature.
+  auto const enable_channel_health = options.has<GrpcChannelHealthOption>();
 
   auto const ep = google::cloud::internal::UniverseDomainEndpoint(
       "storage.googleapis.com", options);
@@ -97,12 +108,19 @@ Options DefaultOptionsGrpc(Options options) {
           .set<storage_experimental::EnableGrpcMetricsOption>(
               enable_grpc_metrics)
           .set<storage_experimental::GrpcMetricsPeriodOption>(
-              kDefaultMetricsPeriod));
+              kDefaultMetricsPeriod)
+          .set<storage_experimental::EnableGrpcChannelHealthOption>(
+              enable_channel_health));
   if (options.get<storage_experimental::GrpcMetricsPeriodOption>() <
       kMinMetricsPeriod) {
     options.set<storage_experimental::GrpcMetricsPeriodOption>(
         kMinMetricsPeriod);
   }
+  if (!options.get<storage_experimental::EnableGrpcChannelHealthOption>()) {
+    options.unset<GrpcChannelHealthOption>();
+  } else if (!options.has<GrpcChannelHealthOption>()) {
+    options.set<GrpcChannelHealthOption>(DefaultGrpcChannelHealth());
+  }
   // We can only compute this once the endpoint is known, so take an additional
   // step.
   auto const num_channels =
@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/grpc/default_options.h"
 #include "google/cloud/storage/grpc_plugin.h"
+#include "google/cloud/storage/internal/grpc/channel_health.h"
 #include "google/cloud/storage/options.h"
 #include "google/cloud/credentials.h"
 #include "google/cloud/grpc_options.h"
@@ -22,6 +23,7 @@
 #include "google/cloud/universe_domain_options.h"
 #include <gmock/gmock.h>
 #include <grpcpp/grpcpp.h>
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -174,6 +176,42 @@ TEST(DefaultOptionsGrpc, MinMetricsPeriod) {
             std::chrono::seconds(0));
 }
 
+TEST(DefaultOptionsGrpc, ChannelHealthDisabledByDefault) {
+  auto const options = DefaultOptionsGrpc(TestOptions());
+  EXPECT_FALSE(
+      options.get<storage_experimental::EnableGrpcChannelHealthOption>());
+  EXPECT_FALSE(options.has<GrpcChannelHealthOption>());
+}
+
+TEST(DefaultOptionsGrpc, ChannelHealthEnabled) {
+  auto const o1 = DefaultOptionsGrpc(
+      TestOptions().set<storage_experimental::EnableGrpcChannelHealthOption>(
+          true));
+  auto const health = o1.get<GrpcChannelHealthOption>();
+  ASSERT_NE(health, nullptr);
+  // All the clients share the same object, and the defaults are idempotent.
+  auto const o2 = DefaultOptionsGrpc(
+      TestOptions().set<storage_experimental::EnableGrpcChannelHealthOption>(
+          true));
+  EXPECT_EQ(o2.get<GrpcChannelHealthOption>(), health);
+  EXPECT_EQ(DefaultOptionsGrpc(o1).get<GrpcChannelHealthOption>(), health);
+}
+
+TEST(DefaultOptionsGrpc, ChannelHealthOverride) {
+  auto const health = std::make_shared<GrpcChannelHealth>();
+  auto const enabled = DefaultOptionsGrpc(
+      TestOptions().set<GrpcChannelHealthOption>(health));
+  EXPECT_TRUE(
+      enabled.get<storage_experimental::EnableGrpcChannelHealthOption>());
+  EXPECT_EQ(enabled.get<GrpcChannelHealthOption>(), health);
+
+  auto const disabled = DefaultOptionsGrpc(
+      TestOptions()
+          .set<GrpcChannelHealthOption>(health)
+          .set<storage_experimental::EnableGrpcChannelHealthOption>(false));
+  EXPECT_FALSE(disabled.has<GrpcChannelHealthOption>());
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage_internal
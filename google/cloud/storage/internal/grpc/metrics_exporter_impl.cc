@@ -26,13 +26,18 @@
 #include "google/cloud/grpc_options.h"
 #include "google/cloud/internal/absl_str_cat_quiet.h"
 #include "google/cloud/log.h"
+#include "google/cloud/version.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/strip.h"
 #include <grpcpp/ext/otel_plugin.h>
 #include <grpcpp/grpcpp.h>
+#include <opentelemetry/metrics/async_instruments.h>
+#include <opentelemetry/metrics/observer_result.h>
 #include <opentelemetry/sdk/resource/resource.h>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <utility>
@@ -75,10 +80,48 @@ class ExporterRegistry {
     known_authority_.clear();
   }
 
+  // Keeps @p instruments registered for the lifetime of the process.
+  void Retain(std::shared_ptr<void> instruments) {
+    std::unique_lock<std::mutex> lk(mu_);
+    retained_.push_back(std::move(instruments));
+  }
+
   std::set<std::string> known_authority_;
+  std::vector<std::shared_ptr<void>> retained_;
   std::mutex mu_;
 };
 
+double Score(GrpcChannelHealthPoint const& p) { return p.score; }
+
+double LatencySeconds(GrpcChannelHealthPoint const& p) {
+  return std::chrono::duration<double>(p.latency).count();
+}
+
+double ErrorRate(GrpcChannelHealthPoint const& p) { return p.error_rate; }
+
+template <double (*Value)(GrpcChannelHealthPoint const&)>
+void ObserveChannelHealth(opentelemetry::metrics::ObserverResult observer,
+                          void* state) {
+  using Result = opentelemetry::nostd::shared_ptr<
+      opentelemetry::metrics::ObserverResultT<double>>;
+  auto const& health = *static_cast<GrpcChannelHealth const*>(state);
+  auto result = opentelemetry::nostd::get<Result>(observer);
+  for (auto const& p : health.Collect()) {
+    result->Observe(Value(p),
+                    {{"pool", static_cast<std::int64_t>(p.pool)},
+                     {"channel", static_cast<std::int64_t>(p.channel)}});
+  }
+}
+
+struct ChannelHealthGauges {
+  using Gauge = opentelemetry::nostd::shared_ptr<
+      opentelemetry::metrics::ObservableInstrument>;
+
+  // The gauges must be released before the object they observe.
+  std::shared_ptr<GrpcChannelHealth> health;
+  std::vector<Gauge> gauges;
+};
+
 }  // namespace
 
 absl::optional<ExporterConfig> MakeMeterProviderConfig(
@@ -95,7 +138,8 @@ absl::optional<ExporterConfig> MakeMeterProviderConfig(
   return ExporterConfig{std::move(*project), std::move(exporter_options),
                         std::move(exporter_connection_options),
                         MakeReaderOptions(options),
-                        options.get<AuthorityOption>()};
+                        options.get<AuthorityOption>(),
+                        options.get<GrpcChannelHealthOption>()};
 }
 
 void EnableGrpcMetricsImpl(ExporterConfig config) {
@@ -109,6 +153,10 @@ void EnableGrpcMetricsImpl(ExporterConfig config) {
 
   auto provider = MakeGrpcMeterProvider(std::move(exporter),
                                         std::move(config.reader_options));
+  if (config.channel_health) {
+    ExporterRegistry::Singleton().Retain(
+        MakeChannelHealthGauges(*provider, std::move(config.channel_health)));
+  }
 
   auto const metrics = std::vector<absl::string_view>{
       absl::string_view{"grpc.lb.wrr.rr_fallback"},
@@ -145,6 +193,35 @@ void EnableGrpcMetricsImpl(ExporterConfig config) {
   }
 }
 
+std::shared_ptr<void> MakeChannelHealthGauges(
+    opentelemetry::metrics::MeterProvider& provider,
+    std::shared_ptr<GrpcChannelHealth> health) {
+  auto gauges = std::make_shared<ChannelHealthGauges>();
+  gauges->health = std::move(health);
+  auto* state = gauges->health.get();
+  auto meter = provider.GetMeter("gl-cpp", version_string());
+
+  auto score = meter->CreateDoubleObservableGauge(
+      "grpc.channel.health.score",
+      "The health score of each channel, higher is worse", "1");
+  score->AddCallback(&ObserveChannelHealth<Score>, state);
+  gauges->gauges.push_back(std::move(score));
+
+  auto latency = meter->CreateDoubleObservableGauge(
+      "grpc.channel.health.latency",
+      "The moving average of the RPC latency in each channel", "s");
+  latency->AddCallback(&ObserveChannelHealth<LatencySeconds>, state);
+  gauges->gauges.push_back(std::move(latency));
+
+  auto error_rate = meter->CreateDoubleObservableGauge(
+      "grpc.channel.health.error_rate",
+      "The moving average of the transport error rate in each channel", "1");
+  error_rate->AddCallback(&ObserveChannelHealth<ErrorRate>, state);
+  gauges->gauges.push_back(std::move(error_rate));
+
+  return gauges;
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage_internal
 }  // namespace cloud
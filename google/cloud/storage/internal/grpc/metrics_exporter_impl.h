@@ -17,12 +17,15 @@
 
 #ifdef GOOGLE_CLOUD_CPP_STORAGE_WITH_OTEL_METRICS
 
+#include "google/cloud/storage/internal/grpc/channel_health.h"
 #include "google/cloud/options.h"
 #include "google/cloud/project.h"
 #include "google/cloud/version.h"
 #include "absl/types/optional.h"
+#include <opentelemetry/metrics/meter_provider.h>
 #include <opentelemetry/sdk/metrics/export/periodic_exporting_metric_reader.h>
 #include <opentelemetry/sdk/resource/resource.h>
+#include <memory>
 #include <string>
 
 namespace google {
@@ -37,6 +40,7 @@ struct ExporterConfig {
   opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions
       reader_options;
   std::string authority;
+  std::shared_ptr<GrpcChannelHealth> channel_health;
 };
 
 absl::optional<ExporterConfig> MakeMeterProviderConfig(
@@ -45,6 +49,15 @@ absl::optional<ExporterConfig> MakeMeterProviderConfig(
 
 void EnableGrpcMetricsImpl(ExporterConfig config);
 
+/**
+ * Exports the scores in @p health as gauges in @p provider.
+ *
+ * The gauges are registered while the returned object is alive.
+ */
+std::shared_ptr<void> MakeChannelHealthGauges(
+    opentelemetry::metrics::MeterProvider& provider,
+    std::shared_ptr<GrpcChannelHealth> health);
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage_internal
 }  // namespace cloud
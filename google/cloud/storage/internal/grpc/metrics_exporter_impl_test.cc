@@ -17,14 +17,22 @@
 #include "google/cloud/storage/internal/grpc/metrics_exporter_impl.h"
 #include "google/cloud/opentelemetry/monitoring_exporter.h"
 #include "google/cloud/storage/grpc_plugin.h"
+#include "google/cloud/storage/internal/grpc/channel_health.h"
 #include "google/cloud/storage/internal/grpc/default_options.h"
+#include "google/cloud/storage/internal/grpc/metrics_meter_provider.h"
 #include "google/cloud/storage/options.h"
 #include "google/cloud/common_options.h"
 #include "google/cloud/credentials.h"
 #include "google/cloud/testing_util/chrono_output.h"
 #include "google/cloud/testing_util/scoped_environment.h"
 #include <gmock/gmock.h>
+#include <opentelemetry/sdk/metrics/push_metric_exporter.h>
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -33,6 +41,28 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
 using ::google::cloud::testing_util::ScopedEnvironment;
+using ::testing::IsSupersetOf;
+using ::testing::Return;
+
+class MockPushMetricExporter
+    : public opentelemetry::sdk::metrics::PushMetricExporter {
+ public:
+  // NOLINTBEGIN(bugprone-exception-escape)
+  MOCK_METHOD(opentelemetry::sdk::common::ExportResult, Export,
+              (opentelemetry::sdk::metrics::ResourceMetrics const&),
+              (noexcept, override));
+
+  MOCK_METHOD(opentelemetry::sdk::metrics::AggregationTemporality,
+              GetAggregationTemporality,
+              (opentelemetry::sdk::metrics::InstrumentType),
+              (const, noexcept, override));
+
+  MOCK_METHOD(bool, ForceFlush, (std::chrono::microseconds),
+              (noexcept, override));
+  MOCK_METHOD(bool, Shutdown, (std::chrono::microseconds),
+              (noexcept, override));
+  // NOLINTEND(bugprone-exception-escape)
+};
 
 auto EmptyResource() {
   return opentelemetry::sdk::resource::Resource::Create({});
@@ -119,6 +149,72 @@ TEST(GrpcMetricsExporter, EnabledWithTimeout) {
             std::chrono::milliseconds(0));
 }
 
+TEST(GrpcMetricsExporter, ChannelHealth) {
+  auto config = MakeMeterProviderConfig(FullResource(), TestOptions());
+  ASSERT_TRUE(config.has_value());
+  EXPECT_EQ(config->channel_health, nullptr);
+
+  config = MakeMeterProviderConfig(
+      FullResource(),
+      TestOptions(
+          Options{}.set<storage_experimental::EnableGrpcChannelHealthOption>(
+              true)));
+  ASSERT_TRUE(config.has_value());
+  EXPECT_NE(config->channel_health, nullptr);
+}
+
+TEST(GrpcMetricsExporter, ChannelHealthGauges) {
+  auto health = std::make_shared<GrpcChannelHealth>();
+  auto pool = health->AddPool(2);
+  pool->Record(0, pool->Epoch(0), std::chrono::milliseconds(10),
+               StatusCode::kOk);
+
+  auto names = [](opentelemetry::sdk::metrics::ResourceMetrics const& data) {
+    std::vector<std::string> names;
+    for (auto const& sm : data.scope_metric_data_) {
+      for (auto const& md : sm.metric_data_) {
+        if (md.point_data_attr_.empty()) continue;
+        names.push_back(md.instrument_descriptor.name_);
+      }
+    }
+    return names;
+  };
+  std::atomic<int> export_count{0};
+  auto mock = std::make_unique<MockPushMetricExporter>();
+  EXPECT_CALL(*mock, Shutdown).WillOnce(Return(true));
+  EXPECT_CALL(*mock, GetAggregationTemporality)
+      .WillRepeatedly(Return(
+          opentelemetry::sdk::metrics::AggregationTemporality::kCumulative));
+  EXPECT_CALL(*mock, Export)
+      .WillRepeatedly(
+          [&](opentelemetry::sdk::metrics::ResourceMetrics const& data) {
+            auto const actual = names(data);
+            if (actual.empty()) {
+              return opentelemetry::sdk::common::ExportResult::kSuccess;
+            }
+            EXPECT_THAT(actual,
+                        IsSupersetOf({"grpc.channel.health.score",
+                                      "grpc.channel.health.latency",
+                                      "grpc.channel.health.error_rate"}));
+            ++export_count;
+            return opentelemetry::sdk::common::ExportResult::kSuccess;
+          });
+
+  auto constexpr kExportInterval = std::chrono::milliseconds(50);
+  opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions
+      reader_options;
+  reader_options.export_interval_millis = kExportInterval;
+  reader_options.export_timeout_millis = kExportInterval / 2;
+  {
+    auto provider = MakeGrpcMeterProvider(std::move(mock), reader_options);
+    auto gauges = MakeChannelHealthGauges(*provider, health);
+    for (int i = 0; i != 50 && export_count.load() == 0; ++i) {
+      std::this_thread::sleep_for(kExportInterval);
+    }
+  }
+  EXPECT_GT(export_count.load(), 0);
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage_internal
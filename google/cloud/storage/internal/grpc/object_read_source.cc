@@ -31,7 +31,7 @@ GrpcObjectReadSource::GrpcObjectReadSource(TimerSource timer_source,
     : timer_source_(std::move(timer_source)), stream_(std::move(stream)) {}
 
 StatusOr<storage::internal::HttpResponse> GrpcObjectReadSource::Close() {
-  if (stream_) stream_ = nullptr;
+  ResetStream();
   if (!status_.ok()) return status_;
   return storage::internal::HttpResponse{
       storage::internal::HttpStatusCode::kOk, {}, {}};
@@ -69,7 +69,7 @@ StatusOr<storage::internal::ReadSourceResult> GrpcObjectReadSource::Read(
                                      metadata.headers.end());
       result.response.headers.insert(metadata.trailers.begin(),
                                      metadata.trailers.end());
-      stream_.reset();
+      ResetStream();
       if (!status_.ok()) return status_;
       return result;
     }
@@ -80,6 +80,18 @@ StatusOr<storage::internal::ReadSourceResult> GrpcObjectReadSource::Read(
   return result;
 }
 
+void GrpcObjectReadSource::Cancel() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (stream_) stream_->Cancel();
+}
+
+void GrpcObjectReadSource::ResetStream() {
+  // Destroy the stream outside the lock.
+  std::unique_ptr<StreamingRpc> stream;
+  std::lock_guard<std::mutex> lk(mu_);
+  stream.swap(stream_);
+}
+
 void GrpcObjectReadSource::HandleResponse(
     storage::internal::ReadSourceResult& result, char* buf, std::size_t n,
     google::storage::v2::ReadObjectResponse response) {
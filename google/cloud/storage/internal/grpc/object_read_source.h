@@ -23,6 +23,8 @@
 #include "absl/functional/function_ref.h"
 #include <google/storage/v2/storage.pb.h>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace google {
@@ -64,12 +66,20 @@ class GrpcObjectReadSource : public storage::internal::ObjectReadSource {
   StatusOr<storage::internal::ReadSourceResult> Read(char* buf,
                                                      std::size_t n) override;
 
+  /// Cancel the stream, interrupting any `Read()` blocked in another thread.
+  void Cancel() override;
+
  private:
+  void ResetStream();
   void HandleResponse(storage::internal::ReadSourceResult& result, char* buf,
                       std::size_t n,
                       google::storage::v2::ReadObjectResponse response);
 
   TimerSource timer_source_;
+  // Only `Cancel()` uses the stream from other threads. The mutex serializes
+  // `Cancel()` with any changes to the pointer, all other uses happen in the
+  // thread calling `Read()` or `Close()`.
+  std::mutex mu_;
   std::unique_ptr<StreamingRpc> stream_;
 
   // In some cases the gRPC response may contain more data than the buffer
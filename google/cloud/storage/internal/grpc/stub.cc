@@ -522,6 +522,13 @@ StatusOr<storage::internal::RewriteObjectResponse> GrpcStub::RewriteObject(
   return FromProto(*response, options);
 }
 
+StatusOr<storage::internal::BatchResponse> GrpcStub::ExecuteBatch(
+    rest_internal::RestContext&, Options const&,
+    storage::internal::BatchRequest const&) {
+  return google::cloud::internal::UnimplementedError(
+      "batch requests are only supported by the JSON API", GCP_ERROR_INFO());
+}
+
 StatusOr<storage::internal::CreateResumableUploadResponse>
 GrpcStub::CreateResumableUpload(
     rest_internal::RestContext& context, Options const& options,
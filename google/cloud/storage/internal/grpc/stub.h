@@ -116,6 +116,9 @@ class GrpcStub : public GenericStub {
   StatusOr<storage::internal::RewriteObjectResponse> RewriteObject(
       rest_internal::RestContext& context, Options const& options,
       storage::internal::RewriteObjectRequest const& request) override;
+  StatusOr<storage::internal::BatchResponse> ExecuteBatch(
+      rest_internal::RestContext& context, Options const& options,
+      storage::internal::BatchRequest const& request) override;
 
   StatusOr<storage::internal::CreateResumableUploadResponse>
   CreateResumableUpload(
@@ -59,6 +59,14 @@ std::unique_ptr<HashFunction> CreateNullHashFunction() {
 
 std::unique_ptr<HashFunction> CreateHashFunction(
     ReadObjectRangeRequest const& request) {
+  if (request.HasOption<ResumeReadObject>()) {
+    // Only the CRC32C checksum can be resumed, the MD5 state is lost.
+    if (request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
+      return CreateNullHashFunction();
+    }
+    auto const& token = request.GetOption<ResumeReadObject>().value();
+    return std::make_unique<Crc32cHashFunction>(token.offset, token.crc32c);
+  }
   if (request.RequiresRangeHeader()) return CreateNullHashFunction();
 
   auto const disable_crc32c =
@@ -21,6 +21,8 @@
 #include "google/cloud/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -83,6 +85,17 @@ class HashFunction {
    * Compute the final hash values.
    */
   virtual HashValues Finish() = 0;
+
+  /**
+   * The CRC32C checksum of the data processed so far, if this function
+   * computes one.
+   *
+   * Unlike `Finish()`, this can be called at any time, and does not change the
+   * state of the function.
+   */
+  virtual absl::optional<std::uint32_t> Crc32cSoFar() const {
+    return absl::nullopt;
+  }
 };
 
 /// Create a hash function configured by several options.
@@ -96,6 +96,12 @@ HashValues CompositeFunction::Finish() {
   return Merge(a_->Finish(), b_->Finish());
 }
 
+absl::optional<std::uint32_t> CompositeFunction::Crc32cSoFar() const {
+  auto crc = a_->Crc32cSoFar();
+  if (crc) return crc;
+  return b_->Crc32cSoFar();
+}
+
 Status MD5HashFunction::Update(std::int64_t offset, absl::string_view buffer) {
   if (offset == minimum_offset_ || minimum_offset_ == 0) {
     Update(buffer);
@@ -63,6 +63,7 @@ class CompositeFunction : public HashFunction {
   Status Update(std::int64_t offset, absl::Cord const& buffer,
                 std::uint32_t buffer_crc) override;
   HashValues Finish() override;
+  absl::optional<std::uint32_t> Crc32cSoFar() const override;
 
  private:
   std::unique_ptr<HashFunction> a_;
@@ -107,6 +108,10 @@ class Crc32cHashFunction : public HashFunction {
  public:
   Crc32cHashFunction() = default;
 
+  /// Continue a checksum, @p crc is the checksum of the first @p offset bytes.
+  Crc32cHashFunction(std::int64_t offset, std::uint32_t crc)
+      : current_(crc), minimum_offset_(offset) {}
+
   Crc32cHashFunction(Crc32cHashFunction const&) = delete;
   Crc32cHashFunction& operator=(Crc32cHashFunction const&) = delete;
 
@@ -118,6 +123,9 @@ class Crc32cHashFunction : public HashFunction {
   Status Update(std::int64_t offset, absl::Cord const& buffer,
                 std::uint32_t buffer_crc) override;
   HashValues Finish() override;
+  absl::optional<std::uint32_t> Crc32cSoFar() const override {
+    return current_;
+  }
 
  private:
   std::uint32_t current_ = 0;
@@ -185,6 +193,9 @@ class Crc32cMessageHashFunction : public HashFunction {
   Status Update(std::int64_t offset, absl::Cord const& buffer,
                 std::uint32_t buffer_crc) override;
   HashValues Finish() override;
+  absl::optional<std::uint32_t> Crc32cSoFar() const override {
+    return child_->Crc32cSoFar();
+  }
 
  private:
   std::unique_ptr<HashFunction> child_;
@@ -400,6 +400,31 @@ TEST(HashFunctionImplTest, CreateHashFunctionRead) {
   }
 }
 
+TEST(HashFunctionImplTest, CreateHashFunctionReadResumed) {
+  auto const quick_fox = std::string(kQuickFox);
+  auto const head = quick_fox.substr(0, 10);
+  auto const token =
+      ReadObjectResumeToken{42, 10, storage_internal::Crc32c(head)};
+  auto function = CreateHashFunction(
+      ReadObjectRangeRequest("test-bucket", "test-object")
+          .set_multiple_options(ResumeReadObject(token), ReadFromOffset(10)));
+  EXPECT_EQ(function->Crc32cSoFar().value_or(0),
+            storage_internal::Crc32c(head));
+  function->Update(quick_fox.substr(10));
+  EXPECT_EQ(function->Crc32cSoFar().value_or(0),
+            storage_internal::Crc32c(quick_fox));
+  // The MD5 hash cannot be resumed.
+  auto const actual = std::move(*function).Finish();
+  EXPECT_EQ(actual.crc32c, kQuickFoxCrc32cChecksum);
+  EXPECT_THAT(actual.md5, IsEmpty());
+
+  function = CreateHashFunction(
+      ReadObjectRangeRequest("test-bucket", "test-object")
+          .set_multiple_options(ResumeReadObject(token), ReadFromOffset(10),
+                                DisableCrc32cChecksum(true)));
+  EXPECT_FALSE(function->Crc32cSoFar().has_value());
+}
+
 struct UploadTest {
   std::string crc32c_expected;
   std::string md5_expected;
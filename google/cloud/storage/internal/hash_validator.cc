@@ -50,6 +50,13 @@ std::unique_ptr<HashValidator> CreateNullHashValidator() {
 
 std::unique_ptr<HashValidator> CreateHashValidator(
     ReadObjectRangeRequest const& request) {
+  if (request.HasOption<ResumeReadObject>()) {
+    // The service reports the hashes of the full object, and the hash function
+    // continues the CRC32C checksum from the resume token.
+    auto disable_crc32c =
+        request.GetOption<DisableCrc32cChecksum>().value_or(false);
+    return CreateHashValidator(/*disable_md5=*/true, disable_crc32c);
+  }
   if (request.RequiresRangeHeader()) return CreateNullHashValidator();
 
   // `DisableMD5Hash`'s default value is `true`.
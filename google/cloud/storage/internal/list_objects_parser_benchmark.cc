@@ -0,0 +1,95 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_metadata_parser.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::storage::internal::ListObjectsResponse;
+using ::google::cloud::storage::internal::ObjectMetadataParser;
+
+// Compares parsing a `ListObjects` response by first building a DOM, which is
+// how the library used to parse these responses, against the streaming
+// parser used by `ListObjectsResponse::FromHttpResponse()`.
+
+std::string MakePayload(int count) {
+  auto items = nlohmann::json::array();
+  for (int i = 0; i != count; ++i) {
+    auto const name = "prefix/object-" + std::to_string(i);
+    items.push_back(nlohmann::json{
+        {"kind", "storage#object"},
+        {"id", "test-bucket/" + name + "/1234567"},
+        {"selfLink",
+         "https://storage.googleapis.com/storage/v1/b/test-bucket/o/" + name},
+        {"mediaLink",
+         "https://storage.googleapis.com/download/storage/v1/b/test-bucket/o/" +
+             name + "?generation=1234567&alt=media"},
+        {"name", name},
+        {"bucket", "test-bucket"},
+        {"generation", "1234567"},
+        {"metageneration", "1"},
+        {"contentType", "application/octet-stream"},
+        {"storageClass", "STANDARD"},
+        {"size", "1048576"},
+        {"md5Hash", "XrY7u+Ae7tCTyyK7j1rNww=="},
+        {"crc32c", "TJ3Nbg=="},
+        {"etag", "CIe2yPH2kP8CEAE="},
+        {"timeCreated", "2024-01-02T03:04:05.678Z"},
+        {"updated", "2024-01-02T03:04:05.678Z"},
+        {"timeStorageClassUpdated", "2024-01-02T03:04:05.678Z"},
+        {"metadata", {{"key", "value"}}},
+    });
+  }
+  return nlohmann::json{{"kind", "storage#objects"},
+                        {"nextPageToken", "next-page-token"},
+                        {"items", std::move(items)}}
+      .dump();
+}
+
+void BM_ListObjectsParseDom(benchmark::State& state) {
+  auto const payload = MakePayload(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    auto json = nlohmann::json::parse(payload, nullptr, false);
+    for (auto const& kv : json["items"].items()) {
+      benchmark::DoNotOptimize(ObjectMetadataParser::FromJson(kv.value()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_ListObjectsParseDom)->Arg(1000);
+
+void BM_ListObjectsParseStreaming(benchmark::State& state) {
+  auto const payload = MakePayload(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ListObjectsResponse::FromHttpResponse(payload));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_ListObjectsParseStreaming)->Arg(1000);
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage_internal
+}  // namespace cloud
+}  // namespace google
@@ -17,6 +17,8 @@
 #include "google/cloud/internal/parse_rfc3339.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "absl/strings/numbers.h"
+#include <cstdint>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -26,86 +28,109 @@ namespace cloud {
 namespace storage {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace internal {
-StatusOr<bool> ParseBoolField(nlohmann::json const& json,
-                              char const* field_name) {
-  if (json.count(field_name) == 0) return false;
-  auto const& f = json[field_name];
-  if (f.is_boolean()) return f.get<bool>();
+namespace {
 
-  if (f.is_string()) {
-    auto v = f.get<std::string>();
-    if (v == "true") return true;
-    if (v == "false") return false;
-  }
+Status InvalidValue(nlohmann::json const& value, char const* field_name,
+                    char const* type_name) {
   std::ostringstream os;
-  os << "Error parsing field <" << field_name
-     << "> as a boolean, json=" << json;
+  os << "Error parsing field <" << field_name << "> as " << type_name
+     << ", json=" << value;
   return google::cloud::internal::InvalidArgumentError(std::move(os).str(),
                                                        GCP_ERROR_INFO());
 }
 
+// nlohmann::json converts out of range numbers without any checks, for
+// example, -1 becomes 2^64 - 1 as a `std::uint64_t`.
+template <typename T>
+StatusOr<T> ParseIntegerValue(nlohmann::json const& value,
+                              char const* field_name, char const* type_name) {
+  using Limits = std::numeric_limits<T>;
+  if (value.is_number_unsigned()) {
+    auto const v = value.get<std::uint64_t>();
+    if (v <= static_cast<std::uint64_t>((Limits::max)())) {
+      return static_cast<T>(v);
+    }
+  } else if (value.is_number_integer()) {
+    auto const v = value.get<std::int64_t>();
+    auto const in_range =
+        v < 0 ? v >= static_cast<std::int64_t>((Limits::min)())
+              : static_cast<std::uint64_t>(v) <=
+                    static_cast<std::uint64_t>((Limits::max)());
+    if (in_range) return static_cast<T>(v);
+  } else if (value.is_string()) {
+    T v;
+    if (absl::SimpleAtoi(value.get_ref<std::string const&>(), &v)) return v;
+  }
+  return InvalidValue(value, field_name, type_name);
+}
+
+}  // namespace
+
+StatusOr<bool> ParseBoolValue(nlohmann::json const& value,
+                              char const* field_name) {
+  if (value.is_boolean()) return value.get<bool>();
+  if (value.is_string()) {
+    auto const& v = value.get_ref<std::string const&>();
+    if (v == "true") return true;
+    if (v == "false") return false;
+  }
+  return InvalidValue(value, field_name, "a boolean");
+}
+
+StatusOr<std::int32_t> ParseIntValue(nlohmann::json const& value,
+                                     char const* field_name) {
+  return ParseIntegerValue<std::int32_t>(value, field_name, "a std::int32_t");
+}
+
+StatusOr<std::uint32_t> ParseUnsignedIntValue(nlohmann::json const& value,
+                                              char const* field_name) {
+  return ParseIntegerValue<std::uint32_t>(value, field_name, "a std::uint32_t");
+}
+
+StatusOr<std::int64_t> ParseLongValue(nlohmann::json const& value,
+                                      char const* field_name) {
+  return ParseIntegerValue<std::int64_t>(value, field_name, "a std::int64_t");
+}
+
+StatusOr<std::uint64_t> ParseUnsignedLongValue(nlohmann::json const& value,
+                                               char const* field_name) {
+  return ParseIntegerValue<std::uint64_t>(value, field_name, "a std::uint64_t");
+}
+
+StatusOr<std::chrono::system_clock::time_point> ParseTimestampValue(
+    nlohmann::json const& value, char const* field_name) {
+  if (value.is_string()) return google::cloud::internal::ParseRfc3339(value);
+  return InvalidValue(value, field_name, "a timestamp");
+}
+
+StatusOr<bool> ParseBoolField(nlohmann::json const& json,
+                              char const* field_name) {
+  if (json.count(field_name) == 0) return false;
+  return ParseBoolValue(json[field_name], field_name);
+}
+
 StatusOr<std::int32_t> ParseIntField(nlohmann::json const& json,
                                      char const* field_name) {
   if (json.count(field_name) == 0) return 0;
-  auto const& f = json[field_name];
-  if (f.is_number()) return f.get<std::int32_t>();
-  if (f.is_string()) {
-    std::int32_t v;
-    if (absl::SimpleAtoi(f.get_ref<std::string const&>(), &v)) return v;
-  }
-  std::ostringstream os;
-  os << "Error parsing field <" << field_name
-     << "> as a std::int32_t, json=" << json;
-  return google::cloud::internal::InvalidArgumentError(std::move(os).str(),
-                                                       GCP_ERROR_INFO());
+  return ParseIntValue(json[field_name], field_name);
 }
 
 StatusOr<std::uint32_t> ParseUnsignedIntField(nlohmann::json const& json,
                                               char const* field_name) {
   if (json.count(field_name) == 0) return 0;
-  auto const& f = json[field_name];
-  if (f.is_number()) return f.get<std::uint32_t>();
-  if (f.is_string()) {
-    std::uint32_t v;
-    if (absl::SimpleAtoi(f.get_ref<std::string const&>(), &v)) return v;
-  }
-  std::ostringstream os;
-  os << "Error parsing field <" << field_name
-     << "> as a std::uint32_t, json=" << json;
-  return google::cloud::internal::InvalidArgumentError(std::move(os).str(),
-                                                       GCP_ERROR_INFO());
+  return ParseUnsignedIntValue(json[field_name], field_name);
 }
 
 StatusOr<std::int64_t> ParseLongField(nlohmann::json const& json,
                                       char const* field_name) {
   if (json.count(field_name) == 0) return 0;
-  auto const& f = json[field_name];
-  if (f.is_number()) return f.get<std::int64_t>();
-  if (f.is_string()) {
-    std::int64_t v;
-    if (absl::SimpleAtoi(f.get_ref<std::string const&>(), &v)) return v;
-  }
-  std::ostringstream os;
-  os << "Error parsing field <" << field_name
-     << "> as a std::int64_t, json=" << json;
-  return google::cloud::internal::InvalidArgumentError(std::move(os).str(),
-                                                       GCP_ERROR_INFO());
+  return ParseLongValue(json[field_name], field_name);
 }
 
 StatusOr<std::uint64_t> ParseUnsignedLongField(nlohmann::json const& json,
                                                char const* field_name) {
   if (json.count(field_name) == 0) return 0;
-  auto const& f = json[field_name];
-  if (f.is_number()) return f.get<std::uint64_t>();
-  if (f.is_string()) {
-    std::uint64_t v;
-    if (absl::SimpleAtoi(f.get_ref<std::string const&>(), &v)) return v;
-  }
-  std::ostringstream os;
-  os << "Error parsing field <" << field_name
-     << "> as a std::uint64_t, json=" << json;
-  return google::cloud::internal::InvalidArgumentError(std::move(os).str(),
-                                                       GCP_ERROR_INFO());
+  return ParseUnsignedLongValue(json[field_name], field_name);
 }
 
 StatusOr<std::chrono::system_clock::time_point> ParseTimestampField(
@@ -113,13 +138,7 @@ StatusOr<std::chrono::system_clock::time_point> ParseTimestampField(
   if (json.count(field_name) == 0) {
     return std::chrono::system_clock::time_point{};
   }
-  auto const& f = json[field_name];
-  if (f.is_string()) return google::cloud::internal::ParseRfc3339(f);
-  std::ostringstream os;
-  os << "Error parsing field <" << field_name
-     << "> as a timestamp, json=" << json;
-  return google::cloud::internal::InvalidArgumentError(std::move(os).str(),
-                                                       GCP_ERROR_INFO());
+  return ParseTimestampValue(json[field_name], field_name);
 }
 
 Status NotJsonObject(nlohmann::json const& j,
@@ -20,6 +20,7 @@
 #include "google/cloud/status_or.h"
 #include <nlohmann/json.hpp>
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace google {
@@ -27,6 +28,42 @@ namespace cloud {
 namespace storage {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace internal {
+/**
+ * Parses a boolean value, even if it is represented by a string type.
+ *
+ * The `Parse*Field()` functions below use these `Parse*Value()` functions once
+ * they find the field. Parsers that already have the value, for example,
+ * because they iterate over the fields of the object, use them directly.
+ * @p field_name is only used in the error message.
+ */
+StatusOr<bool> ParseBoolValue(nlohmann::json const& value,
+                              char const* field_name);
+
+/**
+ * Parses an integer value, even if it is represented by a string type.
+ *
+ * Values out of the range for the type, including negative values for the
+ * unsigned types, are errors.
+ */
+StatusOr<std::int32_t> ParseIntValue(nlohmann::json const& value,
+                                     char const* field_name);
+
+/// @copydoc ParseIntValue
+StatusOr<std::uint32_t> ParseUnsignedIntValue(nlohmann::json const& value,
+                                              char const* field_name);
+
+/// @copydoc ParseIntValue
+StatusOr<std::int64_t> ParseLongValue(nlohmann::json const& value,
+                                      char const* field_name);
+
+/// @copydoc ParseIntValue
+StatusOr<std::uint64_t> ParseUnsignedLongValue(nlohmann::json const& value,
+                                               char const* field_name);
+
+/// Parses a RFC 3339 timestamp value.
+StatusOr<std::chrono::system_clock::time_point> ParseTimestampValue(
+    nlohmann::json const& value, char const* field_name);
+
 /**
  * Parses a boolean field, even if it is represented by a string type in the
  * JSON object.
@@ -15,6 +15,7 @@
 #include "google/cloud/storage/internal/metadata_parser.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <cstdint>
 #include <limits>
 #include <string>
 #include <vector>
@@ -235,6 +236,42 @@ TEST(MetadataParserTest, ParseIntegralFieldInvalidFieldType) {
   CheckParseInvalidFieldType<std::uint64_t>(&ParseUnsignedLongField);
 }
 
+/// @test Verify Parse*Value rejects numbers out of the range for the type.
+TEST(MetadataParserTest, ParseIntegralValueRange) {
+  auto const max_u64 = (std::numeric_limits<std::uint64_t>::max)();
+  auto const max_u32 = (std::numeric_limits<std::uint32_t>::max)();
+  auto const max_i32 = (std::numeric_limits<std::int32_t>::max)();
+  auto const min_i32 = (std::numeric_limits<std::int32_t>::min)();
+
+  EXPECT_EQ(ParseIntValue(nlohmann::json(-5), "f").value(), -5);
+  EXPECT_EQ(ParseIntValue(nlohmann::json(min_i32), "f").value(), min_i32);
+  EXPECT_THAT(ParseIntValue(nlohmann::json(std::int64_t{min_i32} - 1), "f"),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(ParseIntValue(nlohmann::json(std::int64_t{max_i32} + 1), "f"),
+              StatusIs(StatusCode::kInvalidArgument));
+
+  EXPECT_EQ(ParseUnsignedIntValue(nlohmann::json(max_u32), "f").value(),
+            max_u32);
+  EXPECT_THAT(
+      ParseUnsignedIntValue(nlohmann::json(std::uint64_t{max_u32} + 1), "f"),
+      StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(ParseUnsignedIntValue(nlohmann::json(-1), "f"),
+              StatusIs(StatusCode::kInvalidArgument));
+
+  EXPECT_THAT(ParseLongValue(nlohmann::json(max_u64), "f"),
+              StatusIs(StatusCode::kInvalidArgument));
+
+  EXPECT_EQ(ParseUnsignedLongValue(nlohmann::json(max_u64), "f").value(),
+            max_u64);
+  EXPECT_THAT(ParseUnsignedLongValue(nlohmann::json(-1), "f"),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(ParseUnsignedLongValue(nlohmann::json("-1"), "f"),
+              StatusIs(StatusCode::kInvalidArgument));
+  EXPECT_THAT(ParseUnsignedLongField(nlohmann::json::parse(R"({"f": -1})"),
+                                     "f"),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
 TEST(MetadataParserTest, NotJsonObject) {
   EXPECT_THAT(NotJsonObject(nlohmann::json{}, GCP_ERROR_INFO()),
               StatusIs(StatusCode::kInvalidArgument));
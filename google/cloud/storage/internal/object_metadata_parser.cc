@@ -16,8 +16,10 @@
 #include "google/cloud/storage/internal/metadata_parser.h"
 #include "google/cloud/storage/internal/object_access_control_parser.h"
 #include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/make_status.h"
 #include <nlohmann/json.hpp>
-#include <functional>
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <string>
 #include <utility>
@@ -43,11 +45,25 @@ void SetIfNotEmpty(nlohmann::json& json, char const* key,
   json[key] = value;
 }
 
-Status ParseAcl(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto i = json.find("acl");
-  if (i == json.end()) return Status{};
+using FieldParser = Status (*)(ObjectMetadata&, nlohmann::json const&);
+
+struct FieldParserEntry {
+  absl::string_view name;
+  FieldParser parser;
+};
+
+// Some setters are overloaded, this helper selects the right overload.
+using StringSetter = ObjectMetadata& (ObjectMetadata::*)(std::string);
+
+template <StringSetter Setter>
+Status ParseString(ObjectMetadata& meta, nlohmann::json const& value) {
+  (meta.*Setter)(value.get<std::string>());
+  return Status{};
+}
+
+Status ParseAcl(ObjectMetadata& meta, nlohmann::json const& value) {
   std::vector<ObjectAccessControl> acl;
-  for (auto const& kv : i->items()) {
+  for (auto const& kv : value.items()) {
     auto parsed = ObjectAccessControlParser::FromJson(kv.value());
     if (!parsed) return std::move(parsed).status();
     acl.push_back(*std::move(parsed));
@@ -56,254 +72,219 @@ Status ParseAcl(ObjectMetadata& meta, nlohmann::json const& json) {
   return Status{};
 }
 
-Status ParseComponentCount(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = internal::ParseIntField(json, "componentCount");
+Status ParseComponentCount(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseIntValue(value, "componentCount");
   if (!v) return std::move(v).status();
   meta.set_component_count(*v);
   return Status{};
 }
 
-Status ParseCustomTime(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto f = json.find("customTime");
-  if (f == json.end()) return Status{};
-  auto v = internal::ParseTimestampField(json, "customTime");
+Status ParseCustomTime(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseTimestampValue(value, "customTime");
   if (!v) return std::move(v).status();
   meta.set_custom_time(*v);
   return Status{};
 }
 
 Status ParseCustomerEncryption(ObjectMetadata& meta,
-                               nlohmann::json const& json) {
-  auto f = json.find("customerEncryption");
-  if (f == json.end()) return Status{};
+                               nlohmann::json const& value) {
   CustomerEncryption e;
-  e.encryption_algorithm = f->value("encryptionAlgorithm", "");
-  e.key_sha256 = f->value("keySha256", "");
+  e.encryption_algorithm = value.value("encryptionAlgorithm", "");
+  e.key_sha256 = value.value("keySha256", "");
   meta.set_customer_encryption(std::move(e));
   return Status{};
 }
 
-Status ParseEventBasedHold(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = internal::ParseBoolField(json, "eventBasedHold");
+Status ParseEventBasedHold(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseBoolValue(value, "eventBasedHold");
   if (!v) return std::move(v).status();
   meta.set_event_based_hold(*v);
   return Status{};
 }
 
-Status ParseGeneration(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = internal::ParseLongField(json, "generation");
+Status ParseGeneration(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseLongValue(value, "generation");
   if (!v) return std::move(v).status();
   meta.set_generation(*v);
   return Status{};
 }
 
-Status ParseMetageneration(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = internal::ParseLongField(json, "metageneration");
+Status ParseHardDeleteTime(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseTimestampValue(value, "hardDeleteTime");
+  if (!v) return std::move(v).status();
+  meta.set_hard_delete_time(*std::move(v));
+  return Status{};
+}
+
+Status ParseMetageneration(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseLongValue(value, "metageneration");
   if (!v) return std::move(v).status();
   meta.set_metageneration(*v);
   return Status{};
 }
 
-Status ParseMetadata(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto f = json.find("metadata");
-  if (f == json.end()) return Status{};
+Status ParseMetadata(ObjectMetadata& meta, nlohmann::json const& value) {
   std::map<std::string, std::string> metadata;
-  for (auto const& kv : f->items()) {
+  for (auto const& kv : value.items()) {
     metadata.emplace(kv.key(), kv.value().get<std::string>());
   }
   meta.mutable_metadata() = std::move(metadata);
   return Status{};
 }
 
-Status ParseOwner(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto f = json.find("owner");
-  if (f == json.end()) return Status{};
+Status ParseOwner(ObjectMetadata& meta, nlohmann::json const& value) {
   Owner owner;
-  owner.entity = f->value("entity", "");
-  owner.entity_id = f->value("entityId", "");
+  owner.entity = value.value("entity", "");
+  owner.entity_id = value.value("entityId", "");
   meta.set_owner(std::move(owner));
   return Status{};
 }
 
-Status ParseRetentionExpirationTime(ObjectMetadata& meta,
-                                    nlohmann::json const& json) {
-  auto v = internal::ParseTimestampField(json, "retentionExpirationTime");
-  if (!v) return std::move(v).status();
-  meta.set_retention_expiration_time(*v);
-  return Status{};
-}
-
-Status ParseRetention(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto f = json.find("retention");
-  if (f == json.end()) return Status{};
-
-  auto ts = internal::ParseTimestampField(*f, "retainUntilTime");
+Status ParseRetention(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto ts = internal::ParseTimestampField(value, "retainUntilTime");
   if (!ts) return std::move(ts).status();
 
   ObjectRetention retention;
-  retention.mode = f->value("mode", "");
+  retention.mode = value.value("mode", "");
   retention.retain_until_time = *ts;
   meta.set_retention(std::move(retention));
   return Status{};
 }
 
-Status ParseSize(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = internal::ParseUnsignedLongField(json, "size");
+Status ParseRetentionExpirationTime(ObjectMetadata& meta,
+                                    nlohmann::json const& value) {
+  auto v = ParseTimestampValue(value, "retentionExpirationTime");
   if (!v) return std::move(v).status();
-  meta.set_size(*v);
+  meta.set_retention_expiration_time(*v);
   return Status{};
 }
 
-Status ParseTemporaryHold(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = internal::ParseBoolField(json, "temporaryHold");
+Status ParseSize(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseUnsignedLongValue(value, "size");
   if (!v) return std::move(v).status();
-  meta.set_temporary_hold(*v);
+  meta.set_size(*v);
   return Status{};
 }
 
-Status ParseTimeCreated(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = ParseTimestampField(json, "timeCreated");
+Status ParseSoftDeleteTime(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseTimestampValue(value, "softDeleteTime");
   if (!v) return std::move(v).status();
-  meta.set_time_created(*std::move(v));
+  meta.set_soft_delete_time(*std::move(v));
   return Status{};
 }
 
-Status ParseTimeDeleted(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = ParseTimestampField(json, "timeDeleted");
+Status ParseTemporaryHold(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseBoolValue(value, "temporaryHold");
   if (!v) return std::move(v).status();
-  meta.set_time_deleted(*std::move(v));
+  meta.set_temporary_hold(*v);
   return Status{};
 }
 
-Status ParseTimeStorageClassUpdated(ObjectMetadata& meta,
-                                    nlohmann::json const& json) {
-  auto v = ParseTimestampField(json, "timeStorageClassUpdated");
+Status ParseTimeCreated(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseTimestampValue(value, "timeCreated");
   if (!v) return std::move(v).status();
-  meta.set_time_storage_class_updated(*std::move(v));
+  meta.set_time_created(*std::move(v));
   return Status{};
 }
 
-Status ParseUpdated(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = ParseTimestampField(json, "updated");
+Status ParseTimeDeleted(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseTimestampValue(value, "timeDeleted");
   if (!v) return std::move(v).status();
-  meta.set_updated(*std::move(v));
+  meta.set_time_deleted(*std::move(v));
   return Status{};
 }
 
-Status ParseSoftDeleteTime(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = ParseTimestampField(json, "softDeleteTime");
+Status ParseTimeStorageClassUpdated(ObjectMetadata& meta,
+                                    nlohmann::json const& value) {
+  auto v = ParseTimestampValue(value, "timeStorageClassUpdated");
   if (!v) return std::move(v).status();
-  meta.set_soft_delete_time(*std::move(v));
+  meta.set_time_storage_class_updated(*std::move(v));
   return Status{};
 }
 
-Status ParseHardDeleteTime(ObjectMetadata& meta, nlohmann::json const& json) {
-  auto v = ParseTimestampField(json, "hardDeleteTime");
+Status ParseUpdated(ObjectMetadata& meta, nlohmann::json const& value) {
+  auto v = ParseTimestampValue(value, "updated");
   if (!v) return std::move(v).status();
-  meta.set_hard_delete_time(*std::move(v));
+  meta.set_updated(*std::move(v));
   return Status{};
 }
 
+// Sorted by name, to use a binary search in `ParseField()`.
+FieldParserEntry const kFieldParsers[] = {
+    {"acl", ParseAcl},
+    {"bucket", ParseString<&ObjectMetadata::set_bucket>},
+    {"cacheControl", ParseString<&ObjectMetadata::set_cache_control>},
+    {"componentCount", ParseComponentCount},
+    {"contentDisposition",
+     ParseString<&ObjectMetadata::set_content_disposition>},
+    {"contentEncoding", ParseString<&ObjectMetadata::set_content_encoding>},
+    {"contentLanguage", ParseString<&ObjectMetadata::set_content_language>},
+    {"contentType", ParseString<&ObjectMetadata::set_content_type>},
+    {"crc32c", ParseString<&ObjectMetadata::set_crc32c>},
+    {"customTime", ParseCustomTime},
+    {"customerEncryption", ParseCustomerEncryption},
+    {"etag", ParseString<&ObjectMetadata::set_etag>},
+    {"eventBasedHold", ParseEventBasedHold},
+    {"generation", ParseGeneration},
+    {"hardDeleteTime", ParseHardDeleteTime},
+    {"id", ParseString<&ObjectMetadata::set_id>},
+    {"kind", ParseString<&ObjectMetadata::set_kind>},
+    {"kmsKeyName", ParseString<&ObjectMetadata::set_kms_key_name>},
+    {"md5Hash", ParseString<&ObjectMetadata::set_md5_hash>},
+    {"mediaLink", ParseString<&ObjectMetadata::set_media_link>},
+    {"metadata", ParseMetadata},
+    {"metageneration", ParseMetageneration},
+    {"name", ParseString<&ObjectMetadata::set_name>},
+    {"owner", ParseOwner},
+    {"retention", ParseRetention},
+    {"retentionExpirationTime", ParseRetentionExpirationTime},
+    {"selfLink", ParseString<&ObjectMetadata::set_self_link>},
+    {"size", ParseSize},
+    {"softDeleteTime", ParseSoftDeleteTime},
+    {"storageClass", ParseString<&ObjectMetadata::set_storage_class>},
+    {"temporaryHold", ParseTemporaryHold},
+    {"timeCreated", ParseTimeCreated},
+    {"timeDeleted", ParseTimeDeleted},
+    {"timeStorageClassUpdated", ParseTimeStorageClassUpdated},
+    {"updated", ParseUpdated},
+};
+
 }  // namespace
 
 StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
     nlohmann::json const& json) {
   if (!json.is_object()) return NotJsonObject(json, GCP_ERROR_INFO());
 
-  using Parser = std::function<Status(ObjectMetadata&, nlohmann::json const&)>;
-  Parser parsers[] = {
-      ParseAcl,
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_bucket(json.value("bucket", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_cache_control(json.value("cacheControl", ""));
-        return Status{};
-      },
-      ParseComponentCount,
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_content_disposition(json.value("contentDisposition", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_content_encoding(json.value("contentEncoding", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_content_language(json.value("contentLanguage", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_content_type(json.value("contentType", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_crc32c(json.value("crc32c", ""));
-        return Status{};
-      },
-      ParseCustomTime,
-      ParseCustomerEncryption,
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_etag(json.value("etag", ""));
-        return Status{};
-      },
-      ParseEventBasedHold,
-      ParseGeneration,
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_id(json.value("id", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_kind(json.value("kind", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_kms_key_name(json.value("kmsKeyName", ""));
-        return Status{};
-      },
-      ParseMetageneration,
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_md5_hash(json.value("md5Hash", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_media_link(json.value("mediaLink", ""));
-        return Status{};
-      },
-      ParseMetadata,
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_name(json.value("name", ""));
-        return Status{};
-      },
-      ParseOwner,
-      ParseRetentionExpirationTime,
-      ParseRetention,
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_self_link(json.value("selfLink", ""));
-        return Status{};
-      },
-      [](ObjectMetadata& meta, nlohmann::json const& json) {
-        meta.set_storage_class(json.value("storageClass", ""));
-        return Status{};
-      },
-      ParseSize,
-      ParseTemporaryHold,
-      ParseTimeCreated,
-      ParseTimeDeleted,
-      ParseTimeStorageClassUpdated,
-      ParseUpdated,
-      ParseSoftDeleteTime,
-      ParseHardDeleteTime,
-  };
+  // Only the fields present in the object are parsed, in a single pass.
   ObjectMetadata meta;
-  for (auto const& p : parsers) {
-    auto status = p(meta, json);
+  for (auto const& kv : json.items()) {
+    auto status = ParseField(meta, kv.key(), kv.value());
     if (!status.ok()) return status;
   }
+  FinishParsing(meta);
   return meta;
 }
 
+Status ObjectMetadataParser::ParseField(ObjectMetadata& meta,
+                                        absl::string_view name,
+                                        nlohmann::json const& value) {
+  auto const* end = std::end(kFieldParsers);
+  auto const* i =
+      std::lower_bound(std::begin(kFieldParsers), end, name,
+                       [](FieldParserEntry const& e, absl::string_view n) {
+                         return e.name < n;
+                       });
+  if (i == end || i->name != name) return Status{};
+  return i->parser(meta, value);
+}
+
+void ObjectMetadataParser::FinishParsing(ObjectMetadata& meta) {
+  // Historically these fields are set even when not present in the JSON
+  // object. Preserve that behavior.
+  if (!meta.has_soft_delete_time()) meta.set_soft_delete_time({});
+  if (!meta.has_hard_delete_time()) meta.set_hard_delete_time({});
+}
+
 StatusOr<ObjectMetadata> ObjectMetadataParser::FromString(
     std::string const& payload) {
   auto json = nlohmann::json::parse(payload, nullptr, false);
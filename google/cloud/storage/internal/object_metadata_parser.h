@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/status.h"
+#include "absl/strings/string_view.h"
 #include <nlohmann/json.hpp>
 #include <string>
 
@@ -28,6 +29,17 @@ namespace internal {
 struct ObjectMetadataParser {
   static StatusOr<ObjectMetadata> FromJson(nlohmann::json const& json);
   static StatusOr<ObjectMetadata> FromString(std::string const& payload);
+
+  /**
+   * Parses a single field of an object resource into @p meta.
+   *
+   * This is used by streaming parsers, which receive the fields one at a time.
+   * Unknown fields are ignored. Call `FinishParsing()` once all the fields are
+   * parsed.
+   */
+  static Status ParseField(ObjectMetadata& meta, absl::string_view name,
+                           nlohmann::json const& value);
+  static void FinishParsing(ObjectMetadata& meta);
 };
 
 ///@{
@@ -83,6 +83,15 @@ class ObjectReadSource {
   /// Read more data from the download, returning any HTTP headers and error
   /// codes.
   virtual StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) = 0;
+
+  /**
+   * Interrupts a `Read()` call blocked in another thread.
+   *
+   * Unlike the other member functions, this may be called concurrently with
+   * `Read()`. The interrupted `Read()`, and any later calls, return an error.
+   * Sources that cannot interrupt a blocked read leave this as a no-op.
+   */
+  virtual void Cancel() {}
 };
 
 /**
@@ -22,6 +22,8 @@
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
+#include "absl/types/span.h"
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -62,6 +64,16 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
 
   bool IsOpen() const;
   void Close();
+
+  /**
+   * Reads up to `buffer.size()` bytes directly into @p buffer.
+   *
+   * Any data already in the get area is copied first, then the remaining bytes
+   * are read directly from the data source into @p buffer. The data sources
+   * fill the whole buffer, so this blocks until @p buffer is full, the download
+   * completes, or there is an error.
+   */
+  std::size_t ReadInto(absl::Span<char> buffer);
   Status const& status() const { return status_; }
   std::string const& received_hash() const { return received_hash_; }
   std::string const& computed_hash() const { return computed_hash_; }
@@ -82,6 +94,9 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
     return transformation_;
   }
 
+  /// See `ObjectReadStream::resume_token()`.
+  absl::optional<ReadObjectResumeToken> resume_token() const;
+
  private:
   int_type ReportError(Status status);
   void ThrowHashMismatchDelegate(char const* function_name);
@@ -95,6 +110,10 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
   std::streamoff source_pos_;
   std::vector<char> current_ios_buffer_;
   std::unique_ptr<HashFunction> hash_function_;
+  // The CRC32C checksum before the last `underflow()` filled the get area.
+  absl::optional<std::uint32_t> get_area_crc32c_;
+  // The CRC32C checksum of all the data, once `hash_function_` is consumed.
+  absl::optional<std::uint32_t> closed_crc32c_;
   std::unique_ptr<HashValidator> hash_validator_;
   HashValidator::Result hash_validator_result_;
   std::string computed_hash_;
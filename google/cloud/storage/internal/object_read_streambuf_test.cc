@@ -13,9 +13,12 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/object_read_streambuf.h"
+#include "google/cloud/storage/internal/crc32c.h"
 #include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -27,6 +30,7 @@ namespace internal {
 namespace {
 
 using ::testing::Return;
+using ::testing::StartsWith;
 
 TEST(ObjectReadStreambufTest, FailedTellg) {
   ObjectReadStreambuf buf(ReadObjectRangeRequest{},
@@ -173,6 +177,108 @@ TEST(ObjectReadStreambufTest, WrongSeek) {
   EXPECT_TRUE(stream.fail());
 }
 
+TEST(ObjectReadStreambufTest, ReadInto) {
+  std::vector<char> v(64);
+  auto read_source = std::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*read_source, Read)
+      .WillOnce([](char* buf, std::size_t n) {
+        std::string const contents = "0123456789";
+        EXPECT_GE(n, contents.size());
+        std::copy(contents.begin(), contents.end(), buf);
+        return ReadSourceResult{contents.size(), {}};
+      })
+      .WillOnce([&v](char* buf, std::size_t n) {
+        // The data is received directly into the application buffer.
+        EXPECT_EQ(buf, v.data() + 9);
+        EXPECT_EQ(n, v.size() - 9);
+        std::string const contents = "abcdef";
+        std::copy(contents.begin(), contents.end(), buf);
+        return ReadSourceResult{contents.size(), {}};
+      });
+  ObjectReadStreambuf buf(ReadObjectRangeRequest{}, std::move(read_source));
+
+  std::istream stream(&buf);
+  EXPECT_EQ(stream.get(), '0');
+  // The first 9 bytes come from the get area, the rest from a direct read. A
+  // short read returns what is available instead of blocking for more data.
+  EXPECT_EQ(buf.ReadInto(absl::MakeSpan(v)), 15U);
+  EXPECT_THAT(std::string(v.data(), 15), StartsWith("123456789abcdef"));
+  EXPECT_EQ(stream.tellg(), 16);
+}
+
+TEST(ObjectReadStreambufTest, ResumeToken) {
+  auto const contents = std::string{"0123456789abcdef"};
+  std::vector<char> v(64);
+  auto read_source = std::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*read_source, Read)
+      .WillOnce([&](char* buf, std::size_t n) {
+        auto const data = contents.substr(0, 10);
+        EXPECT_GE(n, data.size());
+        std::copy(data.begin(), data.end(), buf);
+        auto result = ReadSourceResult{data.size(), {}};
+        result.generation = 42;
+        return result;
+      })
+      .WillOnce([&](char* buf, std::size_t) {
+        auto const data = contents.substr(10);
+        std::copy(data.begin(), data.end(), buf);
+        return ReadSourceResult{data.size(), {}};
+      });
+  ObjectReadStreambuf buf(ReadObjectRangeRequest{}, std::move(read_source));
+  // Nothing received, the generation is not known yet.
+  EXPECT_FALSE(buf.resume_token().has_value());
+
+  std::istream stream(&buf);
+  // The get area has 10 bytes, but the application consumed only 3.
+  EXPECT_EQ(stream.peek(), '0');
+  stream.read(v.data(), 3);
+  EXPECT_EQ(buf.resume_token(),
+            ReadObjectResumeToken({42, 3, storage_internal::Crc32c("012")}));
+
+  EXPECT_EQ(buf.ReadInto(absl::MakeSpan(v)), contents.size() - 3);
+  EXPECT_EQ(buf.resume_token(),
+            ReadObjectResumeToken(
+                {42, static_cast<std::int64_t>(contents.size()),
+                 storage_internal::Crc32c(contents)}));
+}
+
+TEST(ObjectReadStreambufTest, ResumeTokenValidatesFullObject) {
+  auto const contents = std::string{"0123456789abcdef"};
+  auto const head = contents.substr(0, 3);
+  auto const tail = contents.substr(3);
+  auto read_source = std::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*read_source, Read).WillOnce([&](char* buf, std::size_t n) {
+    EXPECT_GE(n, tail.size());
+    std::copy(tail.begin(), tail.end(), buf);
+    auto result = ReadSourceResult{tail.size(), {}};
+    // The service reports the checksum of the full object.
+    result.hashes = HashValues{ComputeCrc32cChecksum(contents), {}};
+    result.generation = 42;
+    return result;
+  });
+  auto const token =
+      ReadObjectResumeToken{42, 3, storage_internal::Crc32c(head)};
+  ObjectReadStreambuf buf(
+      ReadObjectRangeRequest{}.set_multiple_options(ResumeReadObject(token),
+                                                    ReadFromOffset(3)),
+      std::move(read_source));
+
+  std::vector<char> v(64);
+  EXPECT_EQ(buf.ReadInto(absl::MakeSpan(v)), tail.size());
+  EXPECT_STATUS_OK(buf.status());
+  EXPECT_EQ(buf.computed_hash(), buf.received_hash());
+  EXPECT_EQ(buf.resume_token(),
+            ReadObjectResumeToken(
+                {42, static_cast<std::int64_t>(contents.size()),
+                 storage_internal::Crc32c(contents)}));
+}
+
 }  // namespace
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
@@ -35,6 +35,7 @@ using ::google::cloud::testing_util::IsOk;
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 using ::testing::Not;
 using ::testing::Pair;
 using ::testing::UnorderedElementsAre;
@@ -150,6 +151,80 @@ TEST(ObjectRequestsTest, ParseListResponseFailureInItems) {
   EXPECT_THAT(actual, Not(IsOk()));
 }
 
+TEST(ObjectRequestsTest, ParseListResponseNestedFields) {
+  std::string object1 = R"""({
+      "acl": [
+        {"entity": "user-qux", "role": "OWNER", "projectTeam": {
+          "projectNumber": "123456789", "team": "owners"}},
+        {"entity": "user-quux", "role": "READER"}
+      ],
+      "bucket": "foo-bar",
+      "customerEncryption": {
+        "encryptionAlgorithm": "AES256",
+        "keySha256": "123456"
+      },
+      "metadata": {"lbl1": "foo", "lbl2": "bar"},
+      "name": "foo",
+      "owner": {"entity": "user-qux", "entityId": "user-qux-id-123"},
+      "retention": {
+        "mode": "Unlocked",
+        "retainUntilTime": "2024-07-18T00:00:00Z"
+      },
+      "unknownField": {"a": [1, {"b": [true, null]}], "c": "d"},
+      "size": "102400"
+})""";
+  std::string object2 = R"""({"name": "bar", "metadata": {}, "acl": []})""";
+  // Put the prefixes and next page token before and after the items, the
+  // order of the top-level fields should not matter.
+  std::string text = R"""({
+      "prefixes": ["foo/", "qux/"],
+      "kind": "storage#objects",
+      "items":
+)""";
+  text += "[" + object1 + "," + object2 + "],\n";
+  text += R"""("nextPageToken": "some-token-42"})""";
+
+  auto o1 = internal::ObjectMetadataParser::FromString(object1).value();
+  auto o2 = internal::ObjectMetadataParser::FromString(object2).value();
+  EXPECT_EQ(o1.acl().size(), 2U);
+  EXPECT_EQ(o1.owner().entity_id, "user-qux-id-123");
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text).value();
+  EXPECT_EQ("some-token-42", actual.next_page_token);
+  EXPECT_THAT(actual.items, ElementsAre(o1, o2));
+  EXPECT_THAT(actual.prefixes, ElementsAre("foo/", "qux/"));
+}
+
+TEST(ObjectRequestsTest, ParseListResponseEmpty) {
+  auto actual = ListObjectsResponse::FromHttpResponse("{}").value();
+  EXPECT_THAT(actual.next_page_token, IsEmpty());
+  EXPECT_THAT(actual.items, IsEmpty());
+  EXPECT_THAT(actual.prefixes, IsEmpty());
+}
+
+TEST(ObjectRequestsTest, ParseListResponseFailureNotObject) {
+  for (std::string text : {"", "[]", R"""("items")""", "123", "null"}) {
+    SCOPED_TRACE("Testing with " + text);
+    auto actual = ListObjectsResponse::FromHttpResponse(text);
+    EXPECT_THAT(actual, StatusIs(StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(ObjectRequestsTest, ParseListResponseFailureInField) {
+  std::string text =
+      R"""({"items": [ {"name": "foo"}, {"generation": "invalid"} ]})""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text);
+  EXPECT_THAT(actual, StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(ObjectRequestsTest, ParseListResponseFailureInPrefixes) {
+  std::string text = R"""({"prefixes": [ "foo/", 42 ]})""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text);
+  EXPECT_THAT(actual, Not(IsOk()));
+}
+
 TEST(ObjectRequestsTest, Get) {
   GetObjectMetadataRequest request("my-bucket", "my-object");
   request.set_multiple_options(Generation(1), IfMetagenerationMatch(3),
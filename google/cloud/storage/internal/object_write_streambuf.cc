@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/object_write_streambuf.h"
 #include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/options.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/internal/make_status.h"
 #include <algorithm>
@@ -56,11 +57,29 @@ ObjectWriteStreambuf::ObjectWriteStreambuf(
       known_hashes_(std::move(known_hashes)),
       hash_validator_(std::move(hash_validator)),
       auto_finalize_(auto_finalize),
-      span_options_(CurrentOptions()) {
+      span_options_(CurrentOptions()),
+      pipeline_depth_(span_options_.get<UploadPipelineDepthOption>()) {
+  if (pipeline_depth_ != 0) {
+    max_buffer_size_ =
+        (std::max)(max_buffer_size_, UploadChunkRequest::kChunkSizeQuantum);
+  }
   current_ios_buffer_.reserve(UploadChunkRequest::kChunkSizeQuantum);
   UpdatePutArea();
 }
 
+ObjectWriteStreambuf::~ObjectWriteStreambuf() {
+  if (!uploader_.joinable()) return;
+  // Any buffers already queued are uploaded before the thread exits, as they
+  // would have been uploaded by the time `write()` returned without
+  // pipelining.
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  uploader_.join();
+}
+
 void ObjectWriteStreambuf::AutoFlushFinal() {
   if (auto_finalize_ != AutoFinalizeConfig::kEnabled) return;
   Close();
@@ -68,11 +87,13 @@ void ObjectWriteStreambuf::AutoFlushFinal() {
 
 StatusOr<QueryResumableUploadResponse> ObjectWriteStreambuf::Close() {
   FlushFinal();
+  std::lock_guard<std::mutex> lk(mu_);
   if (!last_status_.ok()) return last_status_;
   return QueryResumableUploadResponse{committed_size_, metadata_, headers_};
 }
 
 bool ObjectWriteStreambuf::IsOpen() const {
+  std::lock_guard<std::mutex> lk(mu_);
   return last_status_.ok() && !metadata_.has_value();
 }
 
@@ -99,14 +120,37 @@ bool ObjectWriteStreambuf::ValidateHash(ObjectMetadata const& meta) {
 }
 
 int ObjectWriteStreambuf::sync() {
+  if (pipeline_depth_ != 0) {
+    if (IsOpen()) EnqueueRoundChunk();
+    WaitForPendingBuffers();
+    return !last_status().ok() ? traits_type::eof() : 0;
+  }
   Flush();
-  return !last_status_.ok() ? traits_type::eof() : 0;
+  return !last_status().ok() ? traits_type::eof() : 0;
 }
 
 std::streamsize ObjectWriteStreambuf::xsputn(char const* s,
                                              std::streamsize count) {
   if (!IsOpen()) return traits_type::eof();
 
+  if (pipeline_depth_ != 0) {
+    // Fill the current buffer and queue it for upload whenever it is full. The
+    // buffers are uploaded by the background thread, without any further
+    // copies.
+    auto const* const end = s + count;
+    while (s != end) {
+      auto const n = (std::min)(static_cast<std::size_t>(end - s),
+                                max_buffer_size_ - current_ios_buffer_.size());
+      current_ios_buffer_.insert(current_ios_buffer_.end(), s, s + n);
+      s += n;
+      if (current_ios_buffer_.size() < max_buffer_size_) continue;
+      EnqueueBuffer();
+      if (!IsOpen()) return traits_type::eof();
+    }
+    UpdatePutArea();
+    return count;
+  }
+
   auto const actual_size = put_area_size();
   // One of the invariants in this class is that actual_size is always less than
   // max_buffer_size_. Using max_buffer_size_ - actual size avoids overflow.
@@ -123,7 +167,7 @@ std::streamsize ObjectWriteStreambuf::xsputn(char const* s,
         ConstBuffer(s, static_cast<std::size_t>(count)),
     });
   }
-  if (!last_status_.ok()) return traits_type::eof();
+  if (!last_status().ok()) return traits_type::eof();
   return count;
 }
 
@@ -133,13 +177,22 @@ ObjectWriteStreambuf::int_type ObjectWriteStreambuf::overflow(int_type ch) {
   if (!IsOpen()) return traits_type::eof();
 
   auto actual_size = put_area_size();
-  if (actual_size >= max_buffer_size_) Flush();
+  if (actual_size >= max_buffer_size_) {
+    if (pipeline_depth_ != 0) {
+      EnqueueBuffer();
+    } else {
+      Flush();
+    }
+  }
   current_ios_buffer_.push_back(traits_type::to_char_type(ch));
   UpdatePutArea();
-  return last_status_.ok() ? ch : traits_type::eof();
+  // In pipelined uploads the background thread may update `last_status_`
+  // concurrently.
+  return last_status().ok() ? ch : traits_type::eof();
 }
 
 void ObjectWriteStreambuf::FlushFinal() {
+  WaitForPendingBuffers();
   if (!IsOpen()) return;
 
   // Calculate the portion of the buffer that needs to be uploaded, if any.
@@ -223,8 +276,14 @@ void ObjectWriteStreambuf::FlushRoundChunk(ConstBufferSequence buffers) {
   }
   UpdatePutArea();
 
-  metadata_ = std::move(response->payload);
-  committed_size_ = response->committed_size.value_or(0);
+  OnChunkUploaded(expected_committed_size, *std::move(response));
+}
+
+void ObjectWriteStreambuf::OnChunkUploaded(
+    std::uint64_t expected_committed_size,
+    QueryResumableUploadResponse response) {
+  metadata_ = std::move(response.payload);
+  committed_size_ = response.committed_size.value_or(0);
 
   // If the upload completed, the stream was implicitly "closed". There is
   // no need to verify anything else.
@@ -242,6 +301,94 @@ void ObjectWriteStreambuf::FlushRoundChunk(ConstBufferSequence buffers) {
   }
 }
 
+void ObjectWriteStreambuf::EnqueueBuffer() {
+  std::vector<char> next;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    // Block the application until there is room in the queue.
+    cv_.wait(lk, [this] {
+      return pending_.size() < pipeline_depth_ || !last_status_.ok() ||
+             metadata_.has_value();
+    });
+    if (!last_status_.ok() || metadata_.has_value()) {
+      current_ios_buffer_.clear();
+      UpdatePutArea();
+      return;
+    }
+    pending_.push_back(std::move(current_ios_buffer_));
+    if (!spare_.empty()) {
+      next = std::move(spare_.back());
+      spare_.pop_back();
+    }
+  }
+  cv_.notify_all();
+  if (!uploader_.joinable()) {
+    uploader_ = std::thread(&ObjectWriteStreambuf::RunUploader, this);
+  }
+  next.clear();
+  next.reserve(max_buffer_size_);
+  current_ios_buffer_ = std::move(next);
+  UpdatePutArea();
+}
+
+void ObjectWriteStreambuf::EnqueueRoundChunk() {
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  auto const rounded_size = current_ios_buffer_.size() / quantum * quantum;
+  if (rounded_size == 0) return;
+  std::vector<char> trailer(current_ios_buffer_.begin() + rounded_size,
+                            current_ios_buffer_.end());
+  current_ios_buffer_.resize(rounded_size);
+  EnqueueBuffer();
+  current_ios_buffer_.insert(current_ios_buffer_.end(), trailer.begin(),
+                             trailer.end());
+  UpdatePutArea();
+}
+
+void ObjectWriteStreambuf::WaitForPendingBuffers() {
+  if (!uploader_.joinable()) return;
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return pending_.empty(); });
+}
+
+void ObjectWriteStreambuf::RunUploader() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !pending_.empty(); });
+    if (pending_.empty()) return;
+    if (!last_status_.ok() || metadata_.has_value()) {
+      // Once the upload fails, or is finalized, the remaining data cannot be
+      // uploaded.
+      pending_.clear();
+      cv_.notify_all();
+      continue;
+    }
+    // Only this thread removes elements from `pending_`, and `push_back()`
+    // does not invalidate references, so it is safe to use `chunk` without
+    // holding the lock.
+    auto const& chunk = pending_.front();
+    auto const offset = committed_size_;
+    lk.unlock();
+    auto upload_request =
+        UploadChunkRequest(upload_id_, offset,
+                           {ConstBuffer(chunk.data(), chunk.size())},
+                           hash_function_);
+    request_.ForEachOption(internal::CopyCommonOptions(upload_request));
+    auto response = [&] {
+      OptionsSpan const span(span_options_);
+      return connection_->UploadChunk(upload_request);
+    }();
+    lk.lock();
+    if (!response) {
+      last_status_ = std::move(response).status();
+    } else {
+      OnChunkUploaded(offset + chunk.size(), *std::move(response));
+    }
+    spare_.push_back(std::move(pending_.front()));
+    pending_.pop_front();
+    cv_.notify_all();
+  }
+}
+
 void ObjectWriteStreambuf::UpdatePutArea() {
   auto* pbeg = current_ios_buffer_.data();
   auto const n = current_ios_buffer_.size();
@@ -20,9 +20,13 @@
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/storage_connection.h"
 #include "google/cloud/storage/version.h"
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace google {
@@ -38,6 +42,11 @@ namespace internal {
  * We do not want to expose the libcurl objects through `ObjectWriteStream`,
  * this class abstracts away the implementation so applications are not impacted
  * by the implementation details.
+ *
+ * If `UploadPipelineDepthOption` is set, full buffers are uploaded by a
+ * background thread, while the application fills the next buffer. The chunks
+ * are still uploaded one at a time and in order. The background thread is only
+ * started once the first buffer is full, so small uploads never create it.
  */
 class ObjectWriteStreambuf : public std::basic_streambuf<char> {
  public:
@@ -55,7 +64,7 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
                        std::unique_ptr<HashValidator> hash_validator,
                        AutoFinalizeConfig auto_finalize);
 
-  ~ObjectWriteStreambuf() override = default;
+  ~ObjectWriteStreambuf() override;
 
   ObjectWriteStreambuf(ObjectWriteStreambuf&& rhs) = delete;
   ObjectWriteStreambuf& operator=(ObjectWriteStreambuf&& rhs) = delete;
@@ -73,9 +82,15 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   virtual std::string const& resumable_session_id() const { return upload_id_; }
 
   /// The next expected byte, if applicable, always 0 for non-resumable uploads.
-  virtual std::uint64_t next_expected_byte() const { return committed_size_; }
+  virtual std::uint64_t next_expected_byte() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return committed_size_;
+  }
 
-  virtual Status last_status() const { return last_status_; }
+  virtual Status last_status() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return last_status_;
+  }
 
  protected:
   int sync() override;
@@ -104,6 +119,22 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   /// Upload a round chunk
   void FlushRoundChunk(ConstBufferSequence buffers);
 
+  /// Update the upload state after a chunk is successfully uploaded.
+  void OnChunkUploaded(std::uint64_t expected_committed_size,
+                       QueryResumableUploadResponse response);
+
+  /// Queue `current_ios_buffer_` for upload in the background thread.
+  void EnqueueBuffer();
+
+  /// Queue the largest round chunk in `current_ios_buffer_`.
+  void EnqueueRoundChunk();
+
+  /// Block until the background thread uploads all queued buffers.
+  void WaitForPendingBuffers();
+
+  /// The loop for the background thread used in pipelined uploads.
+  void RunUploader();
+
   /// The current used bytes in the put area (aka current_ios_buffer_)
   std::size_t put_area_size() const { return pptr() - pbase(); }
 
@@ -132,6 +163,20 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   // Capture the options in effect when the stream was created, to reuse as
   // new requests are generated.
   google::cloud::Options span_options_;
+
+  // The state shared with the background thread in pipelined uploads. With
+  // pipelining disabled `mu_` is uncontended, and the rest is unused.
+  //
+  // In pipelined uploads `last_status_`, `committed_size_`, `metadata_`,
+  // and `headers_` are modified by the background thread, and guarded by
+  // `mu_` while the background thread has any pending buffers.
+  std::size_t pipeline_depth_ = 0;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::vector<char>> pending_;  // ABSL_GUARDED_BY(mu_)
+  std::vector<std::vector<char>> spare_;   // ABSL_GUARDED_BY(mu_)
+  bool shutdown_ = false;                  // ABSL_GUARDED_BY(mu_)
+  std::thread uploader_;
 };
 
 }  // namespace internal
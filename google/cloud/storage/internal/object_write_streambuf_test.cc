@@ -19,6 +19,8 @@
 #include "google/cloud/storage/testing/mock_generic_stub.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
@@ -30,6 +32,7 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace internal {
 namespace {
 
+using ::google::cloud::internal::OptionsSpan;
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::ElementsAre;
 using ::testing::InvokeWithoutArgs;
@@ -670,6 +673,116 @@ TEST(ObjectWriteStreambufTest, WriteObjectWithCustomHeader) {
   EXPECT_STATUS_OK(response);
 }
 
+/// @test Verify that pipelined uploads send all the chunks in order.
+TEST(ObjectWriteStreambufTest, Pipelined) {
+  auto mock = std::make_unique<testing::MockClient>();
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  auto const p0 = std::string(quantum, '0');
+  auto const p1 = std::string(quantum, '1');
+  auto const p2 = std::string(quantum, '2');
+  auto const trailer = std::string("trailer");
+
+  auto next_chunk = [](std::string const& expected) {
+    return [expected](UploadChunkRequest const& r) {
+      EXPECT_FALSE(r.last_chunk());
+      EXPECT_THAT(r.payload(), ElementsAre(ConstBuffer{expected}));
+      return QueryResumableUploadResponse{r.offset() + r.payload_size(),
+                                          absl::nullopt};
+    };
+  };
+  ::testing::InSequence seq;
+  EXPECT_CALL(*mock, UploadChunk)
+      .WillOnce(next_chunk(p0))
+      .WillOnce(next_chunk(p1))
+      .WillOnce(next_chunk(p2))
+      .WillOnce([&](UploadChunkRequest const& r) {
+        EXPECT_TRUE(r.last_chunk());
+        EXPECT_EQ(r.offset(), 3 * quantum);
+        EXPECT_THAT(r.payload(), ElementsAre(ConstBuffer{trailer}));
+        return QueryResumableUploadResponse{r.offset() + r.payload_size(),
+                                            ObjectMetadata()};
+      });
+
+  OptionsSpan const span(Options{}.set<UploadPipelineDepthOption>(2));
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), ResumableUploadRequest(), "test-only-upload-id",
+      /*committed_size=*/0, absl::nullopt, /*max_buffer_size=*/quantum,
+      CreateNullHashFunction(), HashValues{}, CreateNullHashValidator(),
+      AutoFinalizeConfig::kEnabled);
+
+  auto const payload = p0 + p1 + p2 + trailer;
+  EXPECT_EQ(payload.size(), streambuf.sputn(payload.data(), payload.size()));
+  auto response = streambuf.Close();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(response->committed_size.value_or(0), payload.size());
+}
+
+/// @test Verify that pipelined uploads block when the queue is full.
+TEST(ObjectWriteStreambufTest, PipelinedBackpressure) {
+  auto mock = std::make_unique<testing::MockClient>();
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  auto const payload = std::string(quantum, '*');
+
+  std::promise<void> started;
+  std::promise<void> release;
+  ::testing::InSequence seq;
+  EXPECT_CALL(*mock, UploadChunk)
+      .WillOnce([&](UploadChunkRequest const& r) {
+        started.set_value();
+        release.get_future().wait();
+        return QueryResumableUploadResponse{r.offset() + r.payload_size(),
+                                            absl::nullopt};
+      })
+      .WillOnce([&](UploadChunkRequest const& r) {
+        return QueryResumableUploadResponse{r.offset() + r.payload_size(),
+                                            absl::nullopt};
+      });
+
+  OptionsSpan const span(Options{}.set<UploadPipelineDepthOption>(1));
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), ResumableUploadRequest(), "test-only-upload-id",
+      /*committed_size=*/0, absl::nullopt, /*max_buffer_size=*/quantum,
+      CreateNullHashFunction(), HashValues{}, CreateNullHashValidator(),
+      AutoFinalizeConfig::kDisabled);
+
+  // The first buffer is uploaded in the background.
+  EXPECT_EQ(payload.size(), streambuf.sputn(payload.data(), payload.size()));
+  started.get_future().wait();
+  // The second buffer must wait until the first upload completes.
+  auto pending = std::async(std::launch::async, [&] {
+    return streambuf.sputn(payload.data(), payload.size());
+  });
+  EXPECT_EQ(pending.wait_for(std::chrono::milliseconds(50)),
+            std::future_status::timeout);
+  release.set_value();
+  EXPECT_EQ(payload.size(), pending.get());
+  EXPECT_EQ(0, streambuf.pubsync());
+  EXPECT_EQ(streambuf.next_expected_byte(), 2 * quantum);
+}
+
+/// @test Verify that pipelined uploads stop after an error.
+TEST(ObjectWriteStreambufTest, PipelinedError) {
+  auto mock = std::make_unique<testing::MockClient>();
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  auto const payload = std::string(3 * quantum, '*');
+
+  EXPECT_CALL(*mock, UploadChunk)
+      .WillOnce(::testing::Return(
+          Status(StatusCode::kPermissionDenied, "uh-oh")));
+
+  OptionsSpan const span(Options{}.set<UploadPipelineDepthOption>(2));
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), ResumableUploadRequest(), "test-only-upload-id",
+      /*committed_size=*/0, absl::nullopt, /*max_buffer_size=*/quantum,
+      CreateNullHashFunction(), HashValues{}, CreateNullHashValidator(),
+      AutoFinalizeConfig::kEnabled);
+
+  streambuf.sputn(payload.data(), payload.size());
+  EXPECT_THAT(streambuf.Close(), StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_THAT(streambuf.last_status(), StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_EQ(streambuf.next_expected_byte(), 0U);
+}
+
 }  // namespace
 }  // namespace internal
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
@@ -0,0 +1,145 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/read_ahead_object_read_source.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+using ::google::cloud::storage::internal::HttpResponse;
+using ::google::cloud::storage::internal::ReadSourceResult;
+
+std::size_t constexpr ReadAheadObjectReadSource::kBufferCount;
+
+ReadAheadObjectReadSource::ReadAheadObjectReadSource(
+    std::unique_ptr<storage::internal::ObjectReadSource> child,
+    std::size_t read_ahead_size)
+    : child_(std::move(child)),
+      buffer_size_((std::max)(read_ahead_size / kBufferCount,
+                              static_cast<std::size_t>(1))),
+      free_(kBufferCount) {
+  fetcher_ = std::thread(&ReadAheadObjectReadSource::Fetch, this);
+}
+
+ReadAheadObjectReadSource::~ReadAheadObjectReadSource() { Stop(); }
+
+bool ReadAheadObjectReadSource::IsOpen() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return !ready_.empty() || !done_;
+}
+
+StatusOr<HttpResponse> ReadAheadObjectReadSource::Close() {
+  auto const cancelled = Stop();
+  auto response = child_->Close();
+  // The application closed the download early, any error is the result of
+  // cancelling the read and should not be reported.
+  if (!response && cancelled) {
+    return HttpResponse{storage::internal::HttpStatusCode::kOk, {}, {}};
+  }
+  return response;
+}
+
+StatusOr<ReadSourceResult> ReadAheadObjectReadSource::Read(char* buf,
+                                                           std::size_t n) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return !ready_.empty() || done_; });
+  if (ready_.empty()) {
+    return ReadSourceResult{0, HttpResponse{last_status_code_, {}, {}}};
+  }
+  auto& chunk = ready_.front();
+  if (!chunk.result) {
+    auto status = std::move(chunk.result).status();
+    ready_.pop_front();
+    return status;
+  }
+  // The background thread only appends to `ready_`, which does not invalidate
+  // references to existing elements, so we can copy without holding the lock.
+  lk.unlock();
+  auto const count = (std::min)(n, chunk.size - chunk.offset);
+  if (count != 0) std::memcpy(buf, chunk.buffer.data() + chunk.offset, count);
+  ReadSourceResult result;
+  if (!chunk.consumed) {
+    result = std::move(*chunk.result);
+    chunk.consumed = true;
+  } else {
+    result.response.status_code = chunk.result->response.status_code;
+  }
+  result.bytes_received = count;
+  chunk.offset += count;
+  lk.lock();
+  if (chunk.offset == chunk.size) {
+    free_.push_back(std::move(chunk.buffer));
+    ready_.pop_front();
+    cv_.notify_all();
+  }
+  return result;
+}
+
+bool ReadAheadObjectReadSource::Stop() {
+  bool cancelled = false;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+    // The background thread may be blocked in `child_->Read()`, waiting for
+    // data that may take a long time to arrive. Interrupt it before joining.
+    if (!done_ && fetcher_.joinable()) {
+      child_->Cancel();
+      cancelled = true;
+    }
+  }
+  cv_.notify_all();
+  if (fetcher_.joinable()) fetcher_.join();
+  std::lock_guard<std::mutex> lk(mu_);
+  ready_.clear();
+  return cancelled;
+}
+
+void ReadAheadObjectReadSource::Fetch() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !free_.empty(); });
+    if (shutdown_) break;
+    auto buffer = std::move(free_.back());
+    free_.pop_back();
+    lk.unlock();
+    // The buffers are allocated on first use, small downloads never need all
+    // of them.
+    buffer.resize(buffer_size_);
+    auto result = child_->Read(buffer.data(), buffer.size());
+    auto const is_open = result.ok() && child_->IsOpen();
+    lk.lock();
+    Chunk chunk;
+    chunk.buffer = std::move(buffer);
+    if (result) {
+      chunk.size = result->bytes_received;
+      last_status_code_ = result->response.status_code;
+    }
+    chunk.result = std::move(result);
+    ready_.push_back(std::move(chunk));
+    cv_.notify_all();
+    if (!is_open) break;
+  }
+  done_ = true;
+  cv_.notify_all();
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,98 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READ_AHEAD_OBJECT_READ_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READ_AHEAD_OBJECT_READ_SOURCE_H
+
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+/**
+ * Prefetches the data for a download in a background thread.
+ *
+ * A background thread reads from the wrapped source into a bounded ring of
+ * buffers, keeping up to `read_ahead_size` bytes ahead of the application.
+ * `Read()` consumes the buffered data, and only blocks if the background
+ * thread has not received any data yet. This overlaps the network transfer
+ * with the processing of the data in the application.
+ *
+ * The wrapped source is only used by the background thread until it stops,
+ * that is, until the download completes, fails, or this object is closed.
+ * Closing this object cancels any read in progress in the wrapped source, so
+ * closing a stalled download does not wait for the stall timeout.
+ */
+class ReadAheadObjectReadSource : public storage::internal::ObjectReadSource {
+ public:
+  /// The number of buffers used to hold the prefetched data.
+  static std::size_t constexpr kBufferCount = 4;
+
+  ReadAheadObjectReadSource(
+      std::unique_ptr<storage::internal::ObjectReadSource> child,
+      std::size_t read_ahead_size);
+  ~ReadAheadObjectReadSource() override;
+
+  bool IsOpen() const override;
+  StatusOr<storage::internal::HttpResponse> Close() override;
+  StatusOr<storage::internal::ReadSourceResult> Read(char* buf,
+                                                     std::size_t n) override;
+
+ private:
+  // The result of one `Read()` call in the wrapped source. The metadata in
+  // `result` is returned with the first piece of the chunk consumed by the
+  // application.
+  struct Chunk {
+    std::vector<char> buffer;
+    std::size_t size = 0;
+    std::size_t offset = 0;
+    bool consumed = false;
+    StatusOr<storage::internal::ReadSourceResult> result;
+  };
+
+  // Returns true if a read in the wrapped source was cancelled.
+  bool Stop();
+  void Fetch();
+
+  std::unique_ptr<storage::internal::ObjectReadSource> child_;
+  std::size_t const buffer_size_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Chunk> ready_;              // ABSL_GUARDED_BY(mu_)
+  std::vector<std::vector<char>> free_;  // ABSL_GUARDED_BY(mu_)
+  bool done_ = false;                    // ABSL_GUARDED_BY(mu_)
+  bool shutdown_ = false;                // ABSL_GUARDED_BY(mu_)
+  // NOLINTNEXTLINE(google-runtime-int)
+  long last_status_code_ = 0;  // ABSL_GUARDED_BY(mu_)
+  std::thread fetcher_;
+};
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READ_AHEAD_OBJECT_READ_SOURCE_H
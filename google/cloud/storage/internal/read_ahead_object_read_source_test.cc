@@ -0,0 +1,191 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/read_ahead_object_read_source.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::storage::internal::HttpResponse;
+using ::google::cloud::storage::internal::ReadSourceResult;
+using ::google::cloud::storage::testing::MockObjectReadSource;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::_;
+using ::testing::AtMost;
+using ::testing::ElementsAre;
+using ::testing::Optional;
+using ::testing::Pair;
+using ::testing::Return;
+
+/// Simulate a download returning @p contents in a single `Read()` call.
+auto MockRead(std::string contents) {
+  return [contents](char* buf, std::size_t n) {
+    EXPECT_GE(n, contents.size());
+    std::copy(contents.begin(), contents.end(), buf);
+    ReadSourceResult result{contents.size(), HttpResponse{100, {}, {}}};
+    result.response.headers.emplace("x-test-header", contents);
+    result.generation = 1234;
+    return result;
+  };
+}
+
+TEST(ReadAheadObjectReadSource, Basic) {
+  auto mock = std::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, IsOpen)
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*mock, Read)
+      .WillOnce(MockRead("0123456789"))
+      .WillOnce(MockRead("abcdef"))
+      .WillOnce(MockRead("ABCD"));
+  EXPECT_CALL(*mock, Close).WillOnce(Return(HttpResponse{200, {}, {}}));
+
+  ReadAheadObjectReadSource tested(std::move(mock), 4 * 1024);
+  std::string actual;
+  char buffer[8];
+  auto read = tested.Read(buffer, sizeof(buffer));
+  ASSERT_STATUS_OK(read);
+  EXPECT_EQ(read->bytes_received, 8U);
+  EXPECT_THAT(read->generation, Optional(1234));
+  EXPECT_THAT(read->response.headers,
+              ElementsAre(Pair("x-test-header", "0123456789")));
+  actual.append(buffer, read->bytes_received);
+
+  // The rest of the first chunk is returned without any of the metadata.
+  read = tested.Read(buffer, sizeof(buffer));
+  ASSERT_STATUS_OK(read);
+  EXPECT_EQ(read->bytes_received, 2U);
+  EXPECT_FALSE(read->generation.has_value());
+  EXPECT_THAT(read->response.headers, ElementsAre());
+  actual.append(buffer, read->bytes_received);
+
+  while (tested.IsOpen()) {
+    read = tested.Read(buffer, sizeof(buffer));
+    ASSERT_STATUS_OK(read);
+    actual.append(buffer, read->bytes_received);
+  }
+  EXPECT_EQ(actual, "0123456789abcdefABCD");
+  EXPECT_THAT(tested.Close(), IsOkAndHolds(_));
+}
+
+TEST(ReadAheadObjectReadSource, BufferSize) {
+  auto mock = std::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, IsOpen).WillRepeatedly(Return(false));
+  EXPECT_CALL(*mock, Read).WillOnce([](char*, std::size_t n) {
+    // The read ahead is split in `kBufferCount` buffers.
+    EXPECT_EQ(n, 1024 / ReadAheadObjectReadSource::kBufferCount);
+    return ReadSourceResult{0, HttpResponse{200, {}, {}}};
+  });
+
+  ReadAheadObjectReadSource tested(std::move(mock), 1024);
+  char buffer[8];
+  auto read = tested.Read(buffer, sizeof(buffer));
+  ASSERT_STATUS_OK(read);
+  EXPECT_EQ(read->bytes_received, 0U);
+  EXPECT_FALSE(tested.IsOpen());
+}
+
+TEST(ReadAheadObjectReadSource, Bounded) {
+  std::atomic<int> read_count{0};
+  auto mock = std::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, IsOpen).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock, Read).WillRepeatedly([&](char*, std::size_t n) {
+    ++read_count;
+    return ReadSourceResult{n, HttpResponse{100, {}, {}}};
+  });
+  EXPECT_CALL(*mock, Close).WillOnce(Return(HttpResponse{200, {}, {}}));
+  // The background thread may be waiting for a free buffer when the source is
+  // closed.
+  EXPECT_CALL(*mock, Cancel).Times(AtMost(1));
+
+  ReadAheadObjectReadSource tested(std::move(mock), 1024);
+  char buffer[256];
+  // Each call consumes a full buffer, so at most `kBufferCount` new reads may
+  // be started after each call.
+  for (int i = 1; i != 10; ++i) {
+    auto read = tested.Read(buffer, sizeof(buffer));
+    ASSERT_STATUS_OK(read);
+    EXPECT_EQ(read->bytes_received, sizeof(buffer));
+    EXPECT_LE(read_count.load(),
+              i + static_cast<int>(ReadAheadObjectReadSource::kBufferCount));
+  }
+  EXPECT_THAT(tested.Close(), IsOkAndHolds(_));
+  EXPECT_FALSE(tested.IsOpen());
+}
+
+TEST(ReadAheadObjectReadSource, Error) {
+  auto mock = std::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, IsOpen).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock, Read)
+      .WillOnce(MockRead("0123456789"))
+      .WillOnce(Return(PermanentError()));
+
+  ReadAheadObjectReadSource tested(std::move(mock), 1024);
+  char buffer[16];
+  auto read = tested.Read(buffer, sizeof(buffer));
+  ASSERT_STATUS_OK(read);
+  EXPECT_EQ(read->bytes_received, 10U);
+  read = tested.Read(buffer, sizeof(buffer));
+  EXPECT_THAT(read, StatusIs(PermanentError().code()));
+  EXPECT_FALSE(tested.IsOpen());
+}
+
+TEST(ReadAheadObjectReadSource, CloseCancelsPendingRead) {
+  promise<void> cancelled;
+  auto blocked = cancelled.get_future();
+  promise<void> started;
+  auto mock = std::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, IsOpen).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock, Read)
+      .WillOnce(MockRead("0123456789"))
+      .WillOnce([&](char*, std::size_t) -> StatusOr<ReadSourceResult> {
+        // Simulate a stalled download, which only returns once cancelled.
+        started.set_value();
+        blocked.get();
+        return Status(StatusCode::kCancelled, "cancelled");
+      });
+  EXPECT_CALL(*mock, Cancel).WillOnce([&] { cancelled.set_value(); });
+  EXPECT_CALL(*mock, Close)
+      .WillOnce(Return(Status(StatusCode::kCancelled, "cancelled")));
+
+  ReadAheadObjectReadSource tested(std::move(mock), 1024);
+  char buffer[4];
+  auto read = tested.Read(buffer, sizeof(buffer));
+  ASSERT_STATUS_OK(read);
+  EXPECT_EQ(read->bytes_received, 4U);
+  started.get_future().get();
+  // The application closes the download early, this is not an error.
+  EXPECT_THAT(tested.Close(), IsOkAndHolds(_));
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,242 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/rest/batch_builder.h"
+#include "google/cloud/storage/internal/rest/request_builder.h"
+#include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "google/cloud/internal/make_status.h"
+#include "google/cloud/internal/rest_response.h"
+#include "google/cloud/internal/url_encode.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::google::cloud::internal::UrlEncode;
+
+auto constexpr kCrLf = "\r\n";
+
+struct ItemRequest {
+  char const* method;
+  rest_internal::RestRequest request;
+  std::string body;
+};
+
+template <typename Request>
+RestRequestBuilder MakeObjectBuilder(std::string const& api_version,
+                                     Request const& request) {
+  RestRequestBuilder builder(absl::StrCat(
+      "/storage/", api_version, "/b/", request.bucket_name(), "/o/",
+      UrlEncode(request.object_name())));
+  request.AddOptionsToHttpRequest(builder);
+  return builder;
+}
+
+ItemRequest MakeItemRequest(std::string const& api_version,
+                            DeleteObjectRequest const& request) {
+  auto builder = MakeObjectBuilder(api_version, request);
+  return ItemRequest{"DELETE", std::move(builder).BuildRequest(), {}};
+}
+
+ItemRequest MakeItemRequest(std::string const& api_version,
+                            PatchObjectRequest const& request) {
+  auto builder = MakeObjectBuilder(api_version, request);
+  builder.AddHeader("Content-Type", "application/json; charset=UTF-8");
+  return ItemRequest{"PATCH", std::move(builder).BuildRequest(),
+                     request.payload()};
+}
+
+void FormatItem(std::string& payload, std::size_t index,
+                ItemRequest const& item) {
+  absl::StrAppend(&payload, "Content-Type: application/http", kCrLf,
+                  "Content-ID: <item-", index, ">", kCrLf, kCrLf, item.method,
+                  " ", item.request.path());
+  char const* sep = "?";
+  for (auto const& p : item.request.parameters()) {
+    absl::StrAppend(&payload, sep, UrlEncode(p.first), "=",
+                    UrlEncode(p.second));
+    sep = "&";
+  }
+  absl::StrAppend(&payload, " HTTP/1.1", kCrLf);
+  // Sort the headers, to make the payload deterministic.
+  std::map<std::string, std::vector<std::string>> headers(
+      item.request.headers().begin(), item.request.headers().end());
+  for (auto const& h : headers) {
+    // The batch request already includes this header.
+    if (h.first == "x-goog-api-client") continue;
+    for (auto const& v : h.second) {
+      absl::StrAppend(&payload, h.first, ": ", v, kCrLf);
+    }
+  }
+  if (!item.body.empty()) {
+    absl::StrAppend(&payload, "Content-Length: ", item.body.size(), kCrLf,
+                    kCrLf, item.body);
+  }
+  absl::StrAppend(&payload, kCrLf);
+}
+
+// Splits a message into its headers and its body. Some servers use bare LF as
+// line terminators, we accept both.
+std::pair<absl::string_view, absl::string_view> SplitMessage(
+    absl::string_view message) {
+  for (auto const* separator : {"\r\n\r\n", "\n\n"}) {
+    auto const pos = message.find(separator);
+    if (pos == absl::string_view::npos) continue;
+    return {message.substr(0, pos),
+            message.substr(pos + absl::string_view(separator).size())};
+  }
+  return {message, absl::string_view{}};
+}
+
+std::vector<absl::string_view> SplitLines(absl::string_view headers) {
+  std::vector<absl::string_view> lines;
+  for (auto line : absl::StrSplit(headers, '\n')) {
+    line = absl::StripSuffix(line, "\r");
+    if (!line.empty()) lines.push_back(line);
+  }
+  return lines;
+}
+
+// Returns the index in a `Content-ID` header, such as `<response-item-3>`.
+absl::optional<std::size_t> ParseContentId(absl::string_view headers) {
+  for (auto line : SplitLines(headers)) {
+    auto const colon = line.find(':');
+    if (colon == absl::string_view::npos) continue;
+    auto const name = absl::StripAsciiWhitespace(line.substr(0, colon));
+    if (!absl::EqualsIgnoreCase(name, "content-id")) continue;
+    auto value = absl::StripAsciiWhitespace(line.substr(colon + 1));
+    value = absl::StripSuffix(absl::StripPrefix(value, "<"), ">");
+    auto const dash = value.rfind('-');
+    if (dash == absl::string_view::npos) return absl::nullopt;
+    std::size_t index;
+    if (!absl::SimpleAtoi(value.substr(dash + 1), &index)) return absl::nullopt;
+    return index;
+  }
+  return absl::nullopt;
+}
+
+// Parses the HTTP response embedded in each part.
+StatusOr<std::string> ParseItemResponse(absl::string_view message) {
+  auto const split = SplitMessage(message);
+  auto const lines = SplitLines(split.first);
+  // The status line looks like `HTTP/1.1 204 No Content`.
+  std::vector<absl::string_view> status_line;
+  if (!lines.empty()) {
+    status_line = absl::StrSplit(lines.front(), ' ', absl::SkipEmpty());
+  }
+  int code;
+  if (status_line.size() < 2 || !absl::SimpleAtoi(status_line[1], &code)) {
+    return google::cloud::internal::InternalError(
+        absl::StrCat("cannot parse the status line in batch item response <",
+                     lines.empty() ? absl::string_view{} : lines.front(), ">"),
+        GCP_ERROR_INFO());
+  }
+  auto body = std::string(absl::StripSuffix(split.second, kCrLf));
+  if (code >= rest_internal::kMinNotSuccess) {
+    return rest_internal::AsStatus(
+        static_cast<rest_internal::HttpStatusCode>(code), std::move(body));
+  }
+  return body;
+}
+
+}  // namespace
+
+BatchBuilder::BatchBuilder(std::string api_version, std::string boundary)
+    : api_version_(std::move(api_version)), boundary_(std::move(boundary)) {}
+
+std::string BatchBuilder::path() const {
+  return absl::StrCat("batch/storage/", api_version_);
+}
+
+std::string BatchBuilder::content_type() const {
+  return absl::StrCat("multipart/mixed; boundary=", boundary_);
+}
+
+std::string BatchBuilder::BuildPayload(BatchRequest const& request) const {
+  std::string payload;
+  std::size_t index = 0;
+  for (auto const& item : request.items()) {
+    absl::StrAppend(&payload, "--", boundary_, kCrLf);
+    FormatItem(payload, index++,
+               absl::visit(
+                   [this](auto const& r) {
+                     return MakeItemRequest(api_version_, r);
+                   },
+                   item));
+  }
+  absl::StrAppend(&payload, "--", boundary_, "--", kCrLf);
+  return payload;
+}
+
+StatusOr<BatchResponse> ParseBatchResponse(absl::string_view content_type,
+                                           absl::string_view payload,
+                                           std::size_t size) {
+  auto constexpr kBoundary = absl::string_view("boundary=");
+  auto const pos = content_type.find(kBoundary);
+  if (pos == absl::string_view::npos) {
+    return google::cloud::internal::InternalError(
+        absl::StrCat("missing boundary in batch response content type <",
+                     content_type, ">"),
+        GCP_ERROR_INFO());
+  }
+  auto boundary = content_type.substr(pos + kBoundary.size());
+  boundary = boundary.substr(0, boundary.find(';'));
+  boundary = absl::StripSuffix(absl::StripPrefix(boundary, "\""), "\"");
+  auto const delimiter = absl::StrCat("--", boundary);
+
+  BatchResponse response;
+  response.items.assign(
+      size, google::cloud::internal::InternalError(
+                "missing result for batch item", GCP_ERROR_INFO()));
+
+  std::size_t position = 0;
+  auto start = payload.find(delimiter);
+  while (start != absl::string_view::npos) {
+    start += delimiter.size();
+    // The last delimiter is followed by `--`.
+    if (absl::StartsWith(payload.substr(start), "--")) break;
+    auto const end = payload.find(delimiter, start);
+    auto part = payload.substr(start, end == absl::string_view::npos
+                                          ? absl::string_view::npos
+                                          : end - start);
+    auto const split = SplitMessage(absl::StripPrefix(part, kCrLf));
+    auto const index = ParseContentId(split.first).value_or(position);
+    ++position;
+    start = end;
+    if (index >= size) continue;
+    response.items[index] = ParseItemResponse(split.second);
+  }
+  if (position == 0) {
+    return google::cloud::internal::InternalError(
+        "cannot find any parts in the batch response", GCP_ERROR_INFO());
+  }
+  return response;
+}
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
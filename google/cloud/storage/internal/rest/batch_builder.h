@@ -0,0 +1,81 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_REST_BATCH_BUILDER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_REST_BATCH_BUILDER_H
+
+#include "google/cloud/storage/internal/batch_requests.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include "absl/strings/string_view.h"
+#include <cstddef>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+
+/**
+ * Formats the payload of JSON API batch requests.
+ *
+ * Each item in the batch becomes one part in a `multipart/mixed` payload. The
+ * part contains the complete HTTP request for the item, including any query
+ * parameters and headers. The parts are tagged with a `Content-ID` header,
+ * which the service echoes in the response, so the results can be matched
+ * with the items even if the service reorders them.
+ */
+class BatchBuilder {
+ public:
+  /// @p boundary must not appear in any of the items.
+  BatchBuilder(std::string api_version, std::string boundary);
+
+  /// The path for the batch request, relative to the service endpoint.
+  std::string path() const;
+
+  /// The value for the `Content-Type` header of the batch request.
+  std::string content_type() const;
+
+  /// Formats the `multipart/mixed` payload for @p request.
+  std::string BuildPayload(BatchRequest const& request) const;
+
+ private:
+  std::string api_version_;
+  std::string boundary_;
+};
+
+/**
+ * Splits the `multipart/mixed` response to a batch request.
+ *
+ * Returns an error if the payload cannot be parsed at all. Items without a
+ * result in the payload are reported as `kInternal` errors, as their outcome
+ * is unknown.
+ *
+ * @param content_type the `Content-Type` header of the response, it contains
+ *     the boundary between the parts.
+ * @param payload the response payload.
+ * @param size the number of items in the request.
+ */
+StatusOr<BatchResponse> ParseBatchResponse(absl::string_view content_type,
+                                           absl::string_view payload,
+                                           std::size_t size);
+
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_REST_BATCH_BUILDER_H
@@ -0,0 +1,189 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/rest/batch_builder.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+TEST(BatchBuilder, Basic) {
+  BatchBuilder tested("v1", "test-boundary");
+  EXPECT_EQ(tested.path(), "batch/storage/v1");
+  EXPECT_EQ(tested.content_type(), "multipart/mixed; boundary=test-boundary");
+}
+
+TEST(BatchBuilder, BuildPayload) {
+  BatchRequest request;
+  request.Add(DeleteObjectRequest("test-bucket", "a/b c")
+                  .set_multiple_options(Generation(7),
+                                        UserProject("test-project")));
+  request.Add(PatchObjectRequest(
+      "test-bucket", "object-2",
+      ObjectMetadataPatchBuilder().SetContentType("text/plain")));
+
+  BatchBuilder tested("v1", "test-boundary");
+  auto const actual = tested.BuildPayload(request);
+  auto const expected_patch = PatchObjectRequest(
+      "test-bucket", "object-2",
+      ObjectMetadataPatchBuilder().SetContentType("text/plain"));
+  auto const body = expected_patch.payload();
+  auto const expected =
+      "--test-boundary\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <item-0>\r\n"
+      "\r\n"
+      "DELETE /storage/v1/b/test-bucket/o/a%2Fb%20c"
+      "?generation=7&userProject=test-project HTTP/1.1\r\n"
+      "\r\n"
+      "--test-boundary\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <item-1>\r\n"
+      "\r\n"
+      "PATCH /storage/v1/b/test-bucket/o/object-2 HTTP/1.1\r\n"
+      "content-type: application/json; charset=UTF-8\r\n"
+      "Content-Length: " +
+      std::to_string(body.size()) + "\r\n\r\n" + body +
+      "\r\n"
+      "--test-boundary--\r\n";
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(BatchBuilder, BuildPayloadEmpty) {
+  BatchBuilder tested("v1", "test-boundary");
+  EXPECT_EQ(tested.BuildPayload(BatchRequest{}), "--test-boundary--\r\n");
+}
+
+TEST(ParseBatchResponse, Basic) {
+  // The service may return the parts in any order, and the `Content-ID`
+  // values are prefixed by `response-`.
+  auto const payload = std::string(
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item-1>\r\n"
+      "\r\n"
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: application/json; charset=UTF-8\r\n"
+      "\r\n"
+      "{\"name\": \"object-1\"}\r\n"
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item-0>\r\n"
+      "\r\n"
+      "HTTP/1.1 204 No Content\r\n"
+      "Content-Length: 0\r\n"
+      "\r\n"
+      "\r\n"
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item-2>\r\n"
+      "\r\n"
+      "HTTP/1.1 404 Not Found\r\n"
+      "Content-Type: application/json; charset=UTF-8\r\n"
+      "\r\n"
+      "{\"error\": {\"code\": 404, \"message\": \"No such object\"}}\r\n"
+      "--batch_abc--\r\n");
+  auto actual =
+      ParseBatchResponse("multipart/mixed; boundary=batch_abc", payload, 3);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_THAT(actual->items,
+              ElementsAre(IsOkAndHolds(IsEmpty()),
+                          IsOkAndHolds("{\"name\": \"object-1\"}"),
+                          StatusIs(StatusCode::kNotFound,
+                                   HasSubstr("No such object"))));
+}
+
+TEST(ParseBatchResponse, MissingContentIdAndBareNewlines) {
+  auto const payload = std::string(
+      "--batch_abc\n"
+      "Content-Type: application/http\n"
+      "\n"
+      "HTTP/1.1 204 No Content\n"
+      "\n"
+      "--batch_abc\n"
+      "Content-Type: application/http\n"
+      "\n"
+      "HTTP/1.1 503 Service Unavailable\n"
+      "\n"
+      "try again\n"
+      "--batch_abc--\n");
+  auto actual = ParseBatchResponse(
+      "multipart/mixed; boundary=\"batch_abc\"", payload, 2);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_THAT(actual->items,
+              ElementsAre(IsOkAndHolds(IsEmpty()),
+                          StatusIs(StatusCode::kUnavailable)));
+}
+
+TEST(ParseBatchResponse, MissingItems) {
+  auto const payload = std::string(
+      "--batch_abc\r\n"
+      "Content-ID: <response-item-1>\r\n"
+      "\r\n"
+      "HTTP/1.1 204 No Content\r\n"
+      "\r\n"
+      "\r\n"
+      "--batch_abc\r\n"
+      "Content-ID: <response-item-7>\r\n"
+      "\r\n"
+      "HTTP/1.1 204 No Content\r\n"
+      "\r\n"
+      "\r\n"
+      "--batch_abc--\r\n");
+  auto actual =
+      ParseBatchResponse("multipart/mixed; boundary=batch_abc", payload, 2);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_THAT(actual->items, ElementsAre(StatusIs(StatusCode::kInternal),
+                                         IsOkAndHolds(IsEmpty())));
+}
+
+TEST(ParseBatchResponse, BadStatusLine) {
+  auto const payload = std::string(
+      "--batch_abc\r\n"
+      "Content-ID: <response-item-0>\r\n"
+      "\r\n"
+      "garbage\r\n"
+      "--batch_abc--\r\n");
+  auto actual =
+      ParseBatchResponse("multipart/mixed; boundary=batch_abc", payload, 1);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_THAT(actual->items, ElementsAre(StatusIs(StatusCode::kInternal)));
+}
+
+TEST(ParseBatchResponse, Errors) {
+  EXPECT_THAT(ParseBatchResponse("application/json", "{}", 1),
+              StatusIs(StatusCode::kInternal, HasSubstr("boundary")));
+  EXPECT_THAT(
+      ParseBatchResponse("multipart/mixed; boundary=batch_abc", "{}", 1),
+      StatusIs(StatusCode::kInternal));
+}
+
+}  // namespace
+}  // namespace internal
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -45,6 +45,10 @@ class RestObjectReadSource : public ObjectReadSource {
 
   StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
 
+  void Cancel() override {
+    if (payload_) payload_->Cancel();
+  }
+
  private:
   google::cloud::rest_internal::HttpStatusCode status_code_;
   std::multimap<std::string, std::string> headers_;
@@ -73,6 +73,21 @@ TEST(RestObjectReadSourceTest, Close) {
   EXPECT_THAT(result, StatusIs(StatusCode::kFailedPrecondition));
 }
 
+TEST(RestObjectReadSourceTest, Cancel) {
+  auto mock_response = std::make_unique<MockRestResponse>();
+  EXPECT_CALL(*mock_response, StatusCode).WillOnce(Return(HttpStatusCode::kOk));
+  EXPECT_CALL(*mock_response, Headers)
+      .WillOnce(Return(std::multimap<std::string, std::string>()));
+  EXPECT_CALL(std::move(*mock_response), ExtractPayload).WillOnce([&] {
+    auto mock_payload = std::make_unique<MockHttpPayload>();
+    EXPECT_CALL(*mock_payload, Cancel).Times(1);
+    return mock_payload;
+  });
+
+  RestObjectReadSource read_source(std::move(mock_response));
+  read_source.Cancel();
+}
+
 TEST(RestObjectReadSourceTest, ReadAfterClose) {
   auto mock_response = std::make_unique<MockRestResponse>();
   EXPECT_CALL(*mock_response, StatusCode).WillOnce(Return(HttpStatusCode::kOk));
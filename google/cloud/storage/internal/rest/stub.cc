@@ -22,6 +22,7 @@
 #include "google/cloud/storage/internal/object_access_control_parser.h"
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/storage/internal/object_read_streambuf.h"
+#include "google/cloud/storage/internal/rest/batch_builder.h"
 #include "google/cloud/storage/internal/rest/object_read_source.h"
 #include "google/cloud/storage/internal/rest/request_builder.h"
 #include "google/cloud/storage/internal/service_account_parser.h"
@@ -618,6 +619,31 @@ StatusOr<RewriteObjectResponse> RestStub::RewriteObject(
                                  {absl::MakeConstSpan(json_payload)}));
 }
 
+StatusOr<BatchResponse> RestStub::ExecuteBatch(
+    rest_internal::RestContext& context, Options const& options,
+    BatchRequest const& request) {
+  BatchBuilder batch(options.get<TargetApiVersionOption>(), MakeBoundary());
+  RestRequestBuilder builder(batch.path());
+  auto auth = AddAuthorizationHeader(options, builder);
+  if (!auth.ok()) return auth;
+  builder.AddHeader("Content-Type", batch.content_type());
+  auto const payload = batch.BuildPayload(request);
+  auto response =
+      storage_rest_client_->Post(context, std::move(builder).BuildRequest(),
+                                 {absl::MakeConstSpan(payload)});
+  if (!response.ok()) return std::move(response).status();
+  if (IsHttpError(**response)) return rest::AsStatus(std::move(**response));
+  // The boundary in the response is chosen by the service.
+  std::string content_type;
+  for (auto const& h : (*response)->Headers()) {
+    if (!absl::EqualsIgnoreCase(h.first, "content-type")) continue;
+    content_type = h.second;
+  }
+  auto contents = rest::ReadAll(std::move(**response).ExtractPayload());
+  if (!contents.ok()) return std::move(contents).status();
+  return ParseBatchResponse(content_type, *contents, request.size());
+}
+
 StatusOr<CreateResumableUploadResponse> RestStub::CreateResumableUpload(
     rest_internal::RestContext& context, Options const& options,
     ResumableUploadRequest const& request) {
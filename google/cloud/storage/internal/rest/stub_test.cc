@@ -15,9 +15,14 @@
 #include "google/cloud/storage/internal/rest/stub.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/internal/api_client_header.h"
+#include "google/cloud/testing_util/mock_http_payload.h"
 #include "google/cloud/testing_util/mock_rest_client.h"
+#include "google/cloud/testing_util/mock_rest_response.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <map>
+#include <numeric>
+#include <string>
 #include <vector>
 
 namespace google {
@@ -31,15 +36,20 @@ using ::google::cloud::internal::HandCraftedLibClientHeader;
 using ::google::cloud::rest_internal::RestContext;
 using ::google::cloud::rest_internal::RestRequest;
 using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::testing_util::IsOkAndHolds;
+using ::google::cloud::testing_util::MakeMockHttpPayloadSuccess;
 using ::google::cloud::testing_util::MockRestClient;
+using ::google::cloud::testing_util::MockRestResponse;
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::_;
 using ::testing::AllOf;
 using ::testing::An;
+using ::testing::ByMove;
 using ::testing::Contains;
 using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 using ::testing::Matcher;
 using ::testing::Pair;
 using ::testing::ResultOf;
@@ -140,6 +150,19 @@ Matcher<RestRequest const&> ExpectedRequest() {
                                  ElementsAre(HandCraftedLibClientHeader())))));
 }
 
+// Batch requests use a different path, outside `storage/vTest/`.
+Matcher<RestRequest const&> ExpectedBatchRequest() {
+  return AllOf(ResultOf(
+                   "request is a batch",
+                   [](RestRequest const& r) { return r.path(); },
+                   Eq("batch/storage/vTest")),
+               ResultOf(
+                   "request includes x-goog-api-client header",
+                   [](RestRequest const& r) { return r.headers(); },
+                   Contains(Pair("x-goog-api-client",
+                                 ElementsAre(HandCraftedLibClientHeader())))));
+}
+
 Matcher<std::vector<absl::Span<char const>> const&> ExpectedPayload() {
   return An<std::vector<absl::Span<char const>> const&>();
 }
@@ -608,6 +631,59 @@ TEST(RestStubTest, RewriteObject) {
               StatusIs(PermanentError().code(), PermanentError().message()));
 }
 
+TEST(RestStubTest, ExecuteBatch) {
+  auto mock = std::make_shared<MockRestClient>();
+  EXPECT_CALL(*mock, Post(ExpectedContext(), ExpectedBatchRequest(),
+                          ExpectedPayload()))
+      .WillOnce(Return(PermanentError()));
+  auto tested = std::make_unique<RestStub>(Options{}, mock, mock);
+  auto context = TestContext();
+  auto status = tested->ExecuteBatch(context, TestOptions(), BatchRequest());
+  EXPECT_THAT(status,
+              StatusIs(PermanentError().code(), PermanentError().message()));
+}
+
+TEST(RestStubTest, ExecuteBatchSuccess) {
+  auto const payload = std::string(
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-item-0>\r\n"
+      "\r\n"
+      "HTTP/1.1 204 No Content\r\n"
+      "\r\n"
+      "\r\n"
+      "--batch_abc--\r\n");
+  auto mock = std::make_shared<MockRestClient>();
+  EXPECT_CALL(*mock, Post(ExpectedContext(), ExpectedBatchRequest(),
+                          ExpectedPayload()))
+      .WillOnce([&](auto&, auto const&,
+                    std::vector<absl::Span<char const>> const& p) {
+        auto const body = std::accumulate(
+            p.begin(), p.end(), std::string{}, [](std::string a, auto b) {
+              return a + std::string(b.data(), b.size());
+            });
+        EXPECT_THAT(body, HasSubstr("DELETE /storage/vTest/b/test-bucket/o/"
+                                    "test-object HTTP/1.1"));
+        auto response = std::make_unique<MockRestResponse>();
+        EXPECT_CALL(*response, StatusCode)
+            .WillRepeatedly(Return(rest_internal::HttpStatusCode::kOk));
+        EXPECT_CALL(*response, Headers)
+            .WillOnce(Return(std::multimap<std::string, std::string>{
+                {"Content-Type", "multipart/mixed; boundary=batch_abc"}}));
+        EXPECT_CALL(std::move(*response), ExtractPayload)
+            .WillOnce(Return(ByMove(MakeMockHttpPayloadSuccess(payload))));
+        return std::unique_ptr<rest_internal::RestResponse>(
+            std::move(response));
+      });
+  auto tested = std::make_unique<RestStub>(Options{}, mock, mock);
+  auto context = TestContext();
+  auto response = tested->ExecuteBatch(
+      context, TestOptions(),
+      BatchRequest().Add(DeleteObjectRequest("test-bucket", "test-object")));
+  ASSERT_STATUS_OK(response);
+  EXPECT_THAT(response->items, ElementsAre(IsOkAndHolds(IsEmpty())));
+}
+
 TEST(RestStubTest, ListDefaultObjectAcl) {
   auto mock = std::make_shared<MockRestClient>();
   EXPECT_CALL(*mock, Get(ExpectedContext(), ExpectedRequest()))
@@ -70,6 +70,15 @@ RetryObjectReadSource::RetryObjectReadSource(
           [](std::chrono::milliseconds d) { std::this_thread::sleep_for(d); }) {
 }
 
+StatusOr<HttpResponse> RetryObjectReadSource::Close() {
+  // A cancelled `Read()` may leave the source without a child.
+  if (!child_) {
+    return google::cloud::internal::FailedPreconditionError(
+        "Stream is not open", GCP_ERROR_INFO());
+  }
+  return child_->Close();
+}
+
 StatusOr<ReadSourceResult> RetryObjectReadSource::Read(char* buf,
                                                        std::size_t n) {
   if (!child_) {
@@ -92,12 +101,13 @@ StatusOr<ReadSourceResult> RetryObjectReadSource::Read(char* buf,
   auto backoff_policy = backoff_policy_prototype_->clone();
   auto retry_policy = retry_policy_prototype_->clone();
   int counter = 0;
-  while (!result && retry_policy->OnFailure(result.status())) {
+  while (!result && !IsCancelled() &&
+         retry_policy->OnFailure(result.status())) {
     // A Read() request failed, most likely that means the connection failed or
     // stalled. The current child might no longer be usable, so we will try to
     // create a new one and replace it. Should that fail, the retry policy would
     // already be exhausted, so we should fail this operation too.
-    child_.reset();
+    ResetChild(nullptr);
 
     // The first attempt does not get to backoff.  The previous download was
     // working fine, so whatever caused the download to stop may not be an
@@ -138,6 +148,26 @@ StatusOr<ReadSourceResult> RetryObjectReadSource::Read(char* buf,
   return Status(status.code(), std::move(os).str(), status.error_info());
 }
 
+void RetryObjectReadSource::Cancel() {
+  std::lock_guard<std::mutex> lk(mu_);
+  cancelled_ = true;
+  if (child_) child_->Cancel();
+}
+
+bool RetryObjectReadSource::IsCancelled() {
+  std::lock_guard<std::mutex> lk(mu_);
+  return cancelled_;
+}
+
+void RetryObjectReadSource::ResetChild(
+    std::unique_ptr<ObjectReadSource> child) {
+  // The previous child, if any, is destroyed after releasing the lock.
+  std::lock_guard<std::mutex> lk(mu_);
+  child_.swap(child);
+  // A cancelled download must not block in the new child either.
+  if (cancelled_ && child_) child_->Cancel();
+}
+
 bool RetryObjectReadSource::HandleResult(StatusOr<ReadSourceResult> const& r) {
   if (!r) return false;
   if (r->generation) generation_ = r->generation;
@@ -156,7 +186,7 @@ bool RetryObjectReadSource::HandleResult(StatusOr<ReadSourceResult> const& r) {
 Status RetryObjectReadSource::MakeChild(RetryPolicy& retry_policy,
                                         BackoffPolicy& backoff_policy) {
   auto on_success = [this](std::unique_ptr<ObjectReadSource> child) {
-    child_ = std::move(child);
+    ResetChild(std::move(child));
     return Status{};
   };
 
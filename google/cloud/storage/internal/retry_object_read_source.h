@@ -24,6 +24,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -62,11 +63,14 @@ class RetryObjectReadSource : public ObjectReadSource {
                         std::unique_ptr<BackoffPolicy> backoff_policy);
 
   bool IsOpen() const override { return child_ && child_->IsOpen(); }
-  StatusOr<HttpResponse> Close() override { return child_->Close(); }
+  StatusOr<HttpResponse> Close() override;
   StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
+  void Cancel() override;
 
  private:
   bool HandleResult(StatusOr<ReadSourceResult> const& r);
+  bool IsCancelled();
+  void ResetChild(std::unique_ptr<ObjectReadSource> child);
   Status MakeChild(RetryPolicy& retry_policy, BackoffPolicy& backoff_policy);
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadDiscard(
       std::unique_ptr<ObjectReadSource> child, std::int64_t count) const;
@@ -74,7 +78,11 @@ class RetryObjectReadSource : public ObjectReadSource {
   ReadSourceFactory factory_;
   google::cloud::internal::ImmutableOptions options_;
   ReadObjectRangeRequest request_;
+  // `Cancel()` may be called from other threads, the mutex serializes it with
+  // any changes to `child_`.
+  std::mutex mu_;
   std::unique_ptr<ObjectReadSource> child_;
+  bool cancelled_ = false;  // ABSL_GUARDED_BY(mu_)
   absl::optional<std::int64_t> generation_;
   std::unique_ptr<RetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
@@ -0,0 +1,470 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/storage_channel_health_stub.h"
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+
+StorageChannelHealthStub::StorageChannelHealthStub(
+    std::shared_ptr<GrpcChannelPoolHealth> health, std::size_t index,
+    std::shared_ptr<StorageStub> child)
+    : health_(std::move(health)),
+      index_(index),
+      child_{std::move(child), health_->Epoch(index_)} {}
+
+void StorageChannelHealthStub::ReplaceChild(
+    std::shared_ptr<StorageStub> child) {
+  Child replacement{std::move(child), health_->Reset(index_)};
+  std::unique_lock<std::mutex> lk(mu_);
+  std::swap(child_, replacement);
+  lk.unlock();
+  // The old stub, if this was the last reference, is released here, outside
+  // the lock.
+}
+
+Status StorageChannelHealthStub::DeleteBucket(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::DeleteBucketRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->DeleteBucket(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::Bucket> StorageChannelHealthStub::GetBucket(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::GetBucketRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->GetBucket(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::Bucket> StorageChannelHealthStub::CreateBucket(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::CreateBucketRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->CreateBucket(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::ListBucketsResponse>
+StorageChannelHealthStub::ListBuckets(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::ListBucketsRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->ListBuckets(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::Bucket>
+StorageChannelHealthStub::LockBucketRetentionPolicy(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::LockBucketRetentionPolicyRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->LockBucketRetentionPolicy(context, options,
+                                                        request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::iam::v1::Policy> StorageChannelHealthStub::GetIamPolicy(
+    grpc::ClientContext& context, Options const& options,
+    google::iam::v1::GetIamPolicyRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->GetIamPolicy(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::iam::v1::Policy> StorageChannelHealthStub::SetIamPolicy(
+    grpc::ClientContext& context, Options const& options,
+    google::iam::v1::SetIamPolicyRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->SetIamPolicy(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::iam::v1::TestIamPermissionsResponse>
+StorageChannelHealthStub::TestIamPermissions(
+    grpc::ClientContext& context, Options const& options,
+    google::iam::v1::TestIamPermissionsRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->TestIamPermissions(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::Bucket> StorageChannelHealthStub::UpdateBucket(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::UpdateBucketRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->UpdateBucket(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+Status StorageChannelHealthStub::DeleteNotificationConfig(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::DeleteNotificationConfigRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->DeleteNotificationConfig(context, options,
+                                                       request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::NotificationConfig>
+StorageChannelHealthStub::GetNotificationConfig(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::GetNotificationConfigRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->GetNotificationConfig(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::NotificationConfig>
+StorageChannelHealthStub::CreateNotificationConfig(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::CreateNotificationConfigRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->CreateNotificationConfig(context, options,
+                                                       request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::ListNotificationConfigsResponse>
+StorageChannelHealthStub::ListNotificationConfigs(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::ListNotificationConfigsRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->ListNotificationConfigs(context, options,
+                                                      request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::Object> StorageChannelHealthStub::ComposeObject(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::ComposeObjectRequest const& request) {
+  // Not recorded, see the class comments.
+  return CurrentChild().stub->ComposeObject(context, options, request);
+}
+
+Status StorageChannelHealthStub::DeleteObject(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::DeleteObjectRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->DeleteObject(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::Object> StorageChannelHealthStub::RestoreObject(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::RestoreObjectRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->RestoreObject(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::CancelResumableWriteResponse>
+StorageChannelHealthStub::CancelResumableWrite(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::CancelResumableWriteRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->CancelResumableWrite(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::Object> StorageChannelHealthStub::GetObject(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::GetObjectRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->GetObject(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+    google::storage::v2::ReadObjectResponse>>
+StorageChannelHealthStub::ReadObject(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options,
+    google::storage::v2::ReadObjectRequest const& request) {
+  return CurrentChild().stub->ReadObject(std::move(context), options, request);
+}
+
+StatusOr<google::storage::v2::Object> StorageChannelHealthStub::UpdateObject(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::UpdateObjectRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->UpdateObject(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+std::unique_ptr<google::cloud::internal::StreamingWriteRpc<
+    google::storage::v2::WriteObjectRequest,
+    google::storage::v2::WriteObjectResponse>>
+StorageChannelHealthStub::WriteObject(
+    std::shared_ptr<grpc::ClientContext> context, Options const& options) {
+  return CurrentChild().stub->WriteObject(std::move(context), options);
+}
+
+std::unique_ptr<google::cloud::AsyncStreamingReadWriteRpc<
+    google::storage::v2::BidiWriteObjectRequest,
+    google::storage::v2::BidiWriteObjectResponse>>
+StorageChannelHealthStub::AsyncBidiWriteObject(
+    google::cloud::CompletionQueue const& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options) {
+  return CurrentChild().stub->AsyncBidiWriteObject(cq, std::move(context),
+                                                   std::move(options));
+}
+
+StatusOr<google::storage::v2::ListObjectsResponse>
+StorageChannelHealthStub::ListObjects(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::ListObjectsRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->ListObjects(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::RewriteResponse>
+StorageChannelHealthStub::RewriteObject(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::RewriteObjectRequest const& request) {
+  // Not recorded, see the class comments.
+  return CurrentChild().stub->RewriteObject(context, options, request);
+}
+
+StatusOr<google::storage::v2::StartResumableWriteResponse>
+StorageChannelHealthStub::StartResumableWrite(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::StartResumableWriteRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->StartResumableWrite(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::QueryWriteStatusResponse>
+StorageChannelHealthStub::QueryWriteStatus(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::QueryWriteStatusRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->QueryWriteStatus(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::ServiceAccount>
+StorageChannelHealthStub::GetServiceAccount(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::GetServiceAccountRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->GetServiceAccount(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::CreateHmacKeyResponse>
+StorageChannelHealthStub::CreateHmacKey(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::CreateHmacKeyRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->CreateHmacKey(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+Status StorageChannelHealthStub::DeleteHmacKey(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::DeleteHmacKeyRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->DeleteHmacKey(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::HmacKeyMetadata>
+StorageChannelHealthStub::GetHmacKey(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::GetHmacKeyRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->GetHmacKey(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::ListHmacKeysResponse>
+StorageChannelHealthStub::ListHmacKeys(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::ListHmacKeysRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->ListHmacKeys(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+StatusOr<google::storage::v2::HmacKeyMetadata>
+StorageChannelHealthStub::UpdateHmacKey(
+    grpc::ClientContext& context, Options const& options,
+    google::storage::v2::UpdateHmacKeyRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto response = child.stub->UpdateHmacKey(context, options, request);
+  Record(child.epoch, start, internal::GetResultCode(response));
+  return response;
+}
+
+future<StatusOr<google::storage::v2::Object>>
+StorageChannelHealthStub::AsyncComposeObject(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::storage::v2::ComposeObjectRequest const& request) {
+  // Not recorded, see the class comments.
+  return CurrentChild().stub->AsyncComposeObject(cq, std::move(context),
+                                                 std::move(options), request);
+}
+
+future<Status> StorageChannelHealthStub::AsyncDeleteObject(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::storage::v2::DeleteObjectRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto f = child.stub->AsyncDeleteObject(cq, std::move(context),
+                                         std::move(options), request);
+  return Record(child.epoch, start, std::move(f));
+}
+
+std::unique_ptr<google::cloud::internal::AsyncStreamingReadRpc<
+    google::storage::v2::ReadObjectResponse>>
+StorageChannelHealthStub::AsyncReadObject(
+    google::cloud::CompletionQueue const& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::storage::v2::ReadObjectRequest const& request) {
+  return CurrentChild().stub->AsyncReadObject(cq, std::move(context),
+                                              std::move(options), request);
+}
+
+std::unique_ptr<google::cloud::internal::AsyncStreamingWriteRpc<
+    google::storage::v2::WriteObjectRequest,
+    google::storage::v2::WriteObjectResponse>>
+StorageChannelHealthStub::AsyncWriteObject(
+    google::cloud::CompletionQueue const& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options) {
+  return CurrentChild().stub->AsyncWriteObject(cq, std::move(context),
+                                               std::move(options));
+}
+
+future<StatusOr<google::storage::v2::RewriteResponse>>
+StorageChannelHealthStub::AsyncRewriteObject(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::storage::v2::RewriteObjectRequest const& request) {
+  // Not recorded, see the class comments.
+  return CurrentChild().stub->AsyncRewriteObject(cq, std::move(context),
+                                                 std::move(options), request);
+}
+
+future<StatusOr<google::storage::v2::StartResumableWriteResponse>>
+StorageChannelHealthStub::AsyncStartResumableWrite(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::storage::v2::StartResumableWriteRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto f = child.stub->AsyncStartResumableWrite(cq, std::move(context),
+                                                std::move(options), request);
+  return Record(child.epoch, start, std::move(f));
+}
+
+future<StatusOr<google::storage::v2::QueryWriteStatusResponse>>
+StorageChannelHealthStub::AsyncQueryWriteStatus(
+    google::cloud::CompletionQueue& cq,
+    std::shared_ptr<grpc::ClientContext> context,
+    google::cloud::internal::ImmutableOptions options,
+    google::storage::v2::QueryWriteStatusRequest const& request) {
+  auto const child = CurrentChild();
+  auto const start = std::chrono::steady_clock::now();
+  auto f = child.stub->AsyncQueryWriteStatus(cq, std::move(context),
+                                             std::move(options), request);
+  return Record(child.epoch, start, std::move(f));
+}
+
+StorageChannelHealthStub::Child StorageChannelHealthStub::CurrentChild() {
+  std::lock_guard<std::mutex> lk(mu_);
+  return child_;
+}
+
+void StorageChannelHealthStub::Record(
+    std::uint64_t epoch, std::chrono::steady_clock::time_point start,
+    StatusCode code) {
+  health_->Record(index_, epoch, std::chrono::steady_clock::now() - start,
+                  code);
+}
+
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,161 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/storage_channel_health_stub.h"
+#include "google/cloud/storage/testing/mock_storage_stub.h"
+#include "google/cloud/internal/make_status.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage_internal {
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
+namespace {
+
+using ::google::cloud::storage::testing::MockStorageStub;
+using ::google::cloud::testing_util::IsOk;
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ByMove;
+using ::testing::Return;
+
+auto MakePool() {
+  return std::make_shared<GrpcChannelPoolHealth>(0, 2, 1, 3.0);
+}
+
+TEST(StorageChannelHealthStub, RecordsUnary) {
+  auto pool = MakePool();
+  auto mock = std::make_shared<MockStorageStub>();
+  EXPECT_CALL(*mock, GetBucket)
+      .WillOnce(Return(google::storage::v2::Bucket{}))
+      .WillOnce(Return(internal::UnavailableError("try-again")));
+
+  StorageChannelHealthStub stub(pool, 1, mock);
+  grpc::ClientContext c1;
+  EXPECT_THAT(stub.GetBucket(c1, Options{}, {}), IsOk());
+  grpc::ClientContext c2;
+  EXPECT_THAT(stub.GetBucket(c2, Options{}, {}),
+              StatusIs(StatusCode::kUnavailable));
+
+  auto const points = pool->Collect();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_EQ(points[0].samples, 0);
+  EXPECT_EQ(points[1].samples, 2);
+  EXPECT_GT(points[1].error_rate, 0);
+}
+
+TEST(StorageChannelHealthStub, RecordsAsyncUnary) {
+  auto pool = MakePool();
+  auto mock = std::make_shared<MockStorageStub>();
+  promise<Status> p;
+  EXPECT_CALL(*mock, AsyncDeleteObject)
+      .WillOnce(Return(ByMove(p.get_future())));
+
+  StorageChannelHealthStub stub(pool, 0, mock);
+  CompletionQueue cq;
+  auto f = stub.AsyncDeleteObject(cq, std::make_shared<grpc::ClientContext>(),
+                                  internal::MakeImmutableOptions({}), {});
+  EXPECT_EQ(pool->Collect()[0].samples, 0);
+  p.set_value(internal::DeadlineExceededError("too slow"));
+  EXPECT_THAT(f.get(), StatusIs(StatusCode::kDeadlineExceeded));
+
+  auto const points = pool->Collect();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_EQ(points[0].samples, 1);
+  EXPECT_EQ(points[0].error_rate, 1.0);
+}
+
+TEST(StorageChannelHealthStub, StreamingNotRecorded) {
+  auto pool = MakePool();
+  auto mock = std::make_shared<MockStorageStub>();
+  EXPECT_CALL(*mock, ReadObject).WillOnce([] {
+    return std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+        google::storage::v2::ReadObjectResponse>>{};
+  });
+
+  StorageChannelHealthStub stub(pool, 0, mock);
+  (void)stub.ReadObject(std::make_shared<grpc::ClientContext>(), Options{},
+                        {});
+  EXPECT_EQ(pool->Collect()[0].samples, 0);
+}
+
+TEST(StorageChannelHealthStub, LongRunningNotRecorded) {
+  // Use a large threshold, so the test is not sensitive to small variations
+  // in the latency of the fast RPCs.
+  auto pool = std::make_shared<GrpcChannelPoolHealth>(0, 3, 1, 1000.0);
+  std::vector<std::unique_ptr<StorageChannelHealthStub>> stubs;
+  for (std::size_t i = 0; i != pool->size(); ++i) {
+    auto mock = std::make_shared<MockStorageStub>();
+    EXPECT_CALL(*mock, GetBucket)
+        .WillRepeatedly(Return(google::storage::v2::Bucket{}));
+    if (i == 0) {
+      EXPECT_CALL(*mock, RewriteObject).WillOnce([] {
+        // Much slower than any other RPC, as a large copy would be.
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return google::storage::v2::RewriteResponse{};
+      });
+    }
+    stubs.push_back(std::make_unique<StorageChannelHealthStub>(pool, i, mock));
+  }
+  for (auto& stub : stubs) {
+    grpc::ClientContext context;
+    EXPECT_THAT(stub->GetBucket(context, Options{}, {}), IsOk());
+  }
+  grpc::ClientContext context;
+  EXPECT_THAT(stubs[0]->RewriteObject(context, Options{}, {}), IsOk());
+
+  auto const points = pool->Collect();
+  ASSERT_EQ(points.size(), 3);
+  EXPECT_EQ(points[0].samples, 1);
+  EXPECT_LT(points[0].latency, std::chrono::milliseconds(50));
+  EXPECT_FALSE(pool->Unhealthy().has_value());
+}
+
+TEST(StorageChannelHealthStub, ReplaceChild) {
+  auto pool = MakePool();
+  auto old_mock = std::make_shared<MockStorageStub>();
+  promise<Status> p;
+  EXPECT_CALL(*old_mock, AsyncDeleteObject)
+      .WillOnce(Return(ByMove(p.get_future())));
+  auto new_mock = std::make_shared<MockStorageStub>();
+  EXPECT_CALL(*new_mock, DeleteBucket).WillOnce(Return(Status{}));
+
+  StorageChannelHealthStub stub(pool, 1, old_mock);
+  CompletionQueue cq;
+  auto f = stub.AsyncDeleteObject(cq, std::make_shared<grpc::ClientContext>(),
+                                  internal::MakeImmutableOptions({}), {});
+  stub.ReplaceChild(new_mock);
+  grpc::ClientContext context;
+  EXPECT_THAT(stub.DeleteBucket(context, Options{}, {}), IsOk());
+
+  // The RPC on the old child completes, but its result is discarded.
+  p.set_value(internal::UnavailableError("try-again"));
+  EXPECT_THAT(f.get(), StatusIs(StatusCode::kUnavailable));
+
+  auto const points = pool->Collect();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_EQ(points[1].samples, 1);
+  EXPECT_EQ(points[1].error_rate, 0);
+  EXPECT_EQ(points[1].replacements, 1);
+}
+
+}  // namespace
+GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
+}  // namespace storage_internal
+}  // namespace cloud
+}  // namespace google
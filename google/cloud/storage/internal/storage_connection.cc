@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/storage_connection.h"
+#include "google/cloud/internal/make_status.h"
 #include <utility>
 #include <vector>
 
@@ -26,6 +27,11 @@ std::vector<std::string> StorageConnection::InspectStackStructure() const {
   return {};
 }
 
+StatusOr<BatchResponse> StorageConnection::ExecuteBatch(BatchRequest const&) {
+  return google::cloud::internal::UnimplementedError(
+      "batch requests are not supported by this connection", GCP_ERROR_INFO());
+}
+
 StatusOr<CreateOrResumeResponse> CreateOrResume(
     StorageConnection& connection, ResumableUploadRequest const& request) {
   auto session_id = request.GetOption<UseResumableUploadSession>().value_or("");
@@ -14,7 +14,9 @@
 
 #include "google/cloud/storage/internal/storage_stub_factory.h"
 #include "google/cloud/storage/grpc_plugin.h"
+#include "google/cloud/storage/internal/grpc/channel_health.h"
 #include "google/cloud/storage/internal/storage_auth_decorator.h"
+#include "google/cloud/storage/internal/storage_channel_health_stub.h"
 #include "google/cloud/storage/internal/storage_logging_decorator.h"
 #include "google/cloud/storage/internal/storage_metadata_decorator.h"
 #include "google/cloud/storage/internal/storage_round_robin_decorator.h"
@@ -62,10 +64,39 @@ std::shared_ptr<grpc::Channel> CreateGrpcChannel(
   return auth.CreateChannel(options.get<EndpointOption>(), std::move(args));
 }
 
+// Wraps each child with a `StorageChannelHealthStub` and returns the object to
+// refresh the channels and replace the unhealthy ones.
+std::shared_ptr<GrpcChannelRefresh> MakeChannelHealthRefresh(
+    std::shared_ptr<google::cloud::internal::GrpcAuthenticationStrategy> auth,
+    Options const& options, BaseStorageStubFactory const& base_factory,
+    GrpcChannelHealth& health,
+    std::vector<std::shared_ptr<grpc::Channel>> channels,
+    std::vector<std::shared_ptr<StorageStub>>& children) {
+  auto pool = health.AddPool(children.size());
+  std::vector<std::shared_ptr<StorageChannelHealthStub>> stubs(children.size());
+  for (std::size_t i = 0; i != children.size(); ++i) {
+    stubs[i] = std::make_shared<StorageChannelHealthStub>(
+        pool, i, std::move(children[i]));
+    children[i] = stubs[i];
+  }
+  // The replacement channels need new ids, otherwise gRPC may reuse the
+  // connection of the channel they replace.
+  auto replace = [auth = std::move(auth), options, base_factory,
+                  stubs = std::move(stubs),
+                  id = static_cast<int>(channels.size())](
+                     std::size_t index) mutable {
+    auto channel = CreateGrpcChannel(*auth, options, id++);
+    stubs.at(index)->ReplaceChild(base_factory(channel));
+    return channel;
+  };
+  return std::make_shared<GrpcChannelRefresh>(
+      std::move(channels), health.check_period(), std::move(pool),
+      std::move(replace));
+}
+
 }  // namespace
 
-std::pair<std::vector<std::shared_ptr<grpc::Channel>>,
-          std::shared_ptr<StorageStub>>
+std::pair<std::shared_ptr<GrpcChannelRefresh>, std::shared_ptr<StorageStub>>
 CreateDecoratedStubs(google::cloud::CompletionQueue cq, Options const& options,
                      BaseStorageStubFactory const& base_factory) {
   auto auth = google::cloud::internal::CreateAuthenticationStrategy(
@@ -80,6 +111,14 @@ CreateDecoratedStubs(google::cloud::CompletionQueue cq, Options const& options,
   std::transform(channels.begin(), channels.end(), children.begin(),
                  base_factory);
 
+  std::shared_ptr<GrpcChannelRefresh> refresh;
+  if (auto health = options.get<GrpcChannelHealthOption>()) {
+    refresh = MakeChannelHealthRefresh(auth, options, base_factory, *health,
+                                       std::move(channels), children);
+  } else {
+    refresh = std::make_shared<GrpcChannelRefresh>(std::move(channels));
+  }
+
   std::shared_ptr<StorageStub> stub =
       std::make_shared<StorageRoundRobin>(std::move(children));
   if (auth->RequiresConfigureContext()) {
@@ -98,7 +137,7 @@ CreateDecoratedStubs(google::cloud::CompletionQueue cq, Options const& options,
   if (internal::TracingEnabled(options)) {
     stub = MakeStorageTracingStub(std::move(stub));
   }
-  return std::make_pair(std::move(channels), std::move(stub));
+  return std::make_pair(std::move(refresh), std::move(stub));
 }
 
 std::pair<std::shared_ptr<GrpcChannelRefresh>, std::shared_ptr<StorageStub>>
@@ -108,9 +147,8 @@ CreateStorageStub(google::cloud::CompletionQueue cq, Options const& options) {
         return std::make_shared<DefaultStorageStub>(
             google::storage::v2::Storage::NewStub(std::move(c)));
       });
-  auto refresh = std::make_shared<GrpcChannelRefresh>(std::move(p.first));
-  refresh->StartRefreshLoop(std::move(cq));
-  return std::make_pair(std::move(refresh), std::move(p.second));
+  p.first->StartRefreshLoop(std::move(cq));
+  return p;
 }
 
 std::shared_ptr<google::cloud::internal::MinimalIamCredentialsStub>
@@ -36,8 +36,7 @@ using BaseStorageStubFactory =
     std::function<std::shared_ptr<StorageStub>(std::shared_ptr<grpc::Channel>)>;
 
 /// Used in testing to create decorated mocks.
-std::pair<std::vector<std::shared_ptr<grpc::Channel>>,
-          std::shared_ptr<StorageStub>>
+std::pair<std::shared_ptr<GrpcChannelRefresh>, std::shared_ptr<StorageStub>>
 CreateDecoratedStubs(google::cloud::CompletionQueue cq, Options const& options,
                      BaseStorageStubFactory const& base_factory);
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/storage_stub_factory.h"
+#include "google/cloud/storage/internal/grpc/channel_health.h"
 #include "google/cloud/storage/testing/mock_storage_stub.h"
 #include "google/cloud/common_options.h"
 #include "google/cloud/credentials.h"
@@ -257,6 +258,31 @@ TEST_F(StorageStubFactory, QueryWriteStatus) {
   EXPECT_THAT(log.ExtractLines(), Contains(HasSubstr("QueryWriteStatus")));
 }
 
+TEST_F(StorageStubFactory, ChannelHealth) {
+  MockFactory factory;
+  EXPECT_CALL(factory, Call)
+      .Times(kTestChannels)
+      .WillRepeatedly([](std::shared_ptr<grpc::Channel> const&) {
+        auto mock = std::make_shared<MockStorageStub>();
+        EXPECT_CALL(*mock, DeleteBucket).WillOnce(Return(Status{}));
+        return mock;
+      });
+
+  auto health = std::make_shared<GrpcChannelHealth>();
+  internal::AutomaticallyCreatedBackgroundThreads pool;
+  auto stub = CreateTestStub(pool.cq(), factory.AsStdFunction(),
+                             Options{}.set<GrpcChannelHealthOption>(health));
+  for (int i = 0; i != kTestChannels; ++i) {
+    grpc::ClientContext context;
+    EXPECT_STATUS_OK(stub->DeleteBucket(context, Options{}, {}));
+  }
+
+  // Each RPC is recorded in the channel that carried it.
+  auto const points = health->Collect();
+  ASSERT_EQ(points.size(), kTestChannels);
+  for (auto const& p : points) EXPECT_EQ(p.samples, 1);
+}
+
 #ifdef GOOGLE_CLOUD_CPP_HAVE_OPENTELEMETRY
 using ::google::cloud::testing_util::DisableTracing;
 using ::google::cloud::testing_util::EnableTracing;
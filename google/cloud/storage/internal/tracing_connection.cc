@@ -184,6 +184,13 @@ TracingConnection::RewriteObject(
   return internal::EndSpan(*span, impl_->RewriteObject(request));
 }
 
+StatusOr<storage::internal::BatchResponse> TracingConnection::ExecuteBatch(
+    storage::internal::BatchRequest const& request) {
+  auto span = internal::MakeSpan("storage::Client::ExecuteBatch");
+  auto scope = opentelemetry::trace::Scope(span);
+  return internal::EndSpan(*span, impl_->ExecuteBatch(request));
+}
+
 StatusOr<storage::internal::CreateResumableUploadResponse>
 TracingConnection::CreateResumableUpload(
     storage::internal::ResumableUploadRequest const& request) {
@@ -83,6 +83,8 @@ class TracingConnection : public storage::internal::StorageConnection {
       storage::internal::ComposeObjectRequest const& request) override;
   StatusOr<storage::internal::RewriteObjectResponse> RewriteObject(
       storage::internal::RewriteObjectRequest const& request) override;
+  StatusOr<storage::internal::BatchResponse> ExecuteBatch(
+      storage::internal::BatchRequest const& request) override;
 
   StatusOr<storage::internal::CreateResumableUploadResponse>
   CreateResumableUpload(
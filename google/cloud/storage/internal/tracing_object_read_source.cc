@@ -76,6 +76,11 @@ StatusOr<storage::internal::ReadSourceResult> TracingObjectReadSource::Read(
   return response;
 }
 
+void TracingObjectReadSource::Cancel() {
+  span_->AddEvent("gl-cpp.cancel");
+  child_->Cancel();
+}
+
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace storage_internal
 }  // namespace cloud
@@ -16,6 +16,7 @@
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/common_options.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <nlohmann/json.hpp>
@@ -94,6 +95,45 @@ TEST(ListObjectsReaderTest, Basic) {
   EXPECT_THAT(actual, ContainerEq(expected));
 }
 
+TEST(ListObjectsReaderTest, Prefetch) {
+  std::vector<ObjectMetadata> expected;
+  int const page_count = 4;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects)
+      .Times(page_count)
+      .WillRepeatedly([&](ListObjectsRequest const& r) {
+        EXPECT_EQ(google::cloud::internal::CurrentOptions()
+                      .get<PaginationPrefetchDepthOption>(),
+                  2U);
+        auto const& token = r.page_token();
+        auto const i = token.empty() ? 0 : std::stoi(token.substr(5));
+        ListObjectsResponse response;
+        if (i != page_count - 1) {
+          response.next_page_token = "page-" + std::to_string(i + 1);
+        }
+        response.items.emplace_back(CreateElement(2 * i));
+        response.items.emplace_back(CreateElement(2 * i + 1));
+        return make_status_or(response);
+      });
+
+  google::cloud::internal::OptionsSpan span(
+      Options{}.set<PaginationPrefetchDepthOption>(2));
+  auto reader = google::cloud::internal::MakePaginationRange<ListObjectsReader>(
+      ListObjectsRequest("foo-bar-baz"),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); },
+      [](ListObjectsResponse r) { return std::move(r.items); });
+  std::vector<ObjectMetadata> actual;
+  for (auto&& object : reader) {
+    ASSERT_STATUS_OK(object);
+    actual.emplace_back(*std::move(object));
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
+
 TEST(ListObjectsReaderTest, Empty) {
   auto mock = std::make_shared<MockClient>();
   EXPECT_CALL(*mock, ListObjects)
@@ -16,6 +16,7 @@
 #include "google/cloud/storage/internal/object_access_control_parser.h"
 #include "google/cloud/storage/internal/object_metadata_parser.h"
 #include "google/cloud/internal/parse_rfc3339.h"
+#include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
 #include <sstream>
 #include <string>
@@ -27,6 +28,8 @@ namespace storage {
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 namespace {
 
+using ::google::cloud::testing_util::StatusIs;
+
 TEST(ComposeSourceObject, IOStream) {
   auto to_string = [](ComposeSourceObject const& r) {
     std::ostringstream os;
@@ -209,6 +212,22 @@ TEST(ObjectMetadataTest, Parse) {
                 std::chrono::milliseconds(789));
 }
 
+/// @test Verify that invalid field values are rejected.
+TEST(ObjectMetadataTest, ParseInvalidValues) {
+  for (std::string text : {
+           R"""({"size": -1})""",
+           R"""({"size": "not-a-number"})""",
+           R"""({"generation": 9223372036854775808})""",
+           R"""({"componentCount": 2147483648})""",
+           R"""({"temporaryHold": "maybe"})""",
+           R"""({"updated": 42})""",
+       }) {
+    SCOPED_TRACE("Testing with " + text);
+    auto actual = internal::ObjectMetadataParser::FromString(text);
+    EXPECT_THAT(actual, StatusIs(StatusCode::kInvalidArgument));
+  }
+}
+
 /// @test Verify that the IOStream operator works as expected.
 TEST(ObjectMetadataTest, IOStream) {
   auto meta = CreateObjectMetadataForTest();
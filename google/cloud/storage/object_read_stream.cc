@@ -74,6 +74,28 @@ ObjectReadStream::~ObjectReadStream() {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
 
+std::size_t ObjectReadStream::ReadInto(absl::Span<char> buffer) {
+  if (buffer.empty()) return 0;
+  std::size_t n = 0;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  // Report errors as `std::basic_istream<>::read()` does: set `badbit` and
+  // only rethrow if the application asked for exceptions.
+  try {
+    n = buf_->ReadInto(buffer);
+  } catch (...) {
+    if ((exceptions() & std::ios_base::badbit) != 0) throw;
+    setstate(std::ios_base::badbit);
+    return 0;
+  }
+#else
+  n = buf_->ReadInto(buffer);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  if (n != 0) return n;
+  setstate(status().ok() ? std::ios_base::eofbit
+                         : std::ios_base::eofbit | std::ios_base::badbit);
+  return 0;
+}
+
 void ObjectReadStream::Close() {
   if (!IsOpen()) {
     return;
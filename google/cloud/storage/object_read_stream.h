@@ -18,6 +18,7 @@
 #include "google/cloud/storage/headers_map.h"
 #include "google/cloud/storage/internal/object_read_streambuf.h"
 #include "google/cloud/storage/version.h"
+#include "absl/types/span.h"
 #include <istream>
 #include <memory>
 #include <string>
@@ -76,6 +77,25 @@ class ObjectReadStream : public std::basic_istream<char> {
    */
   void Close();
 
+  /**
+   * Reads up to `buffer.size()` bytes directly into @p buffer.
+   *
+   * Like `read()`, this function blocks until @p buffer is full, the download
+   * completes, or there is an error. Unlike `read()`, a short read does not set
+   * `eof()` or `fail()`. The data is received directly into @p buffer, without
+   * any intermediate copies, so applications can use their own buffers, e.g.,
+   * page-aligned buffers, to minimize the CPU overhead of large downloads. The
+   * checksums and hashes are validated as with `read()`.
+   *
+   * It is safe to mix calls to `ReadInto()` with other `std::istream` read
+   * functions.
+   *
+   * @return the number of bytes read. Returns 0 and sets `eof()` when the
+   *     download is complete, or if there was an error. Use `status()` to
+   *     distinguish both cases.
+   */
+  std::size_t ReadInto(absl::Span<char> buffer);
+
   /**
    * Report any download errors.
    *
@@ -176,6 +196,24 @@ class ObjectReadStream : public std::basic_istream<char> {
   absl::optional<std::uint64_t> const& size() const { return buf_->size(); }
   ///@}
 
+  /**
+   * The state needed to resume this download after an interruption.
+   *
+   * The token records the generation, the number of bytes consumed by the
+   * application, and the CRC32C checksum of those bytes. Pass it to
+   * `Client::ReadObject()` via `ResumeReadObject` to continue the download in
+   * this or a different process, while still validating the checksum of the
+   * full object.
+   *
+   * Returns `absl::nullopt` if the download cannot be resumed, for example,
+   * if the generation is not known yet, if the CRC32C checksum is disabled or
+   * not computed (as with `ReadRange` or `ReadFromOffset`), if the object is
+   * transcoded, or if the data received failed the checksum validation.
+   */
+  absl::optional<ReadObjectResumeToken> resume_token() const {
+    return buf_->resume_token();
+  }
+
  private:
   std::unique_ptr<internal::ObjectReadStreambuf> buf_;
 };
@@ -14,9 +14,12 @@
 
 #include "google/cloud/storage/object_stream.h"
 #include "google/cloud/storage/internal/storage_connection.h"
+#include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -27,6 +30,7 @@ namespace {
 using ::google::cloud::testing_util::IsOk;
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::NotNull;
+using ::testing::Return;
 
 TEST(ObjectStream, ReadMoveConstructor) {
   ObjectReadStream reader;
@@ -64,6 +68,41 @@ TEST(ObjectStream, ReadMoveAssignment) {
   EXPECT_THAT(reader.status(), Not(IsOk()));
 }
 
+TEST(ObjectStream, ReadInto) {
+  auto read_source = std::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen)
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*read_source, Read)
+      .WillOnce(Return(internal::ReadSourceResult{10, {}}));
+  ObjectReadStream reader(std::make_unique<internal::ObjectReadStreambuf>(
+      internal::ReadObjectRangeRequest{}, std::move(read_source)));
+
+  std::vector<char> buffer(1024);
+  // A short read does not set any of the error bits.
+  EXPECT_EQ(reader.ReadInto(absl::MakeSpan(buffer)), 10U);
+  EXPECT_TRUE(reader.good());
+  EXPECT_EQ(reader.ReadInto(absl::MakeSpan(buffer)), 0U);
+  EXPECT_TRUE(reader.eof());
+  EXPECT_FALSE(reader.bad());
+  EXPECT_THAT(reader.status(), IsOk());
+}
+
+TEST(ObjectStream, ReadIntoError) {
+  auto read_source = std::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen).WillRepeatedly(Return(true));
+  EXPECT_CALL(*read_source, Read)
+      .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again")));
+  ObjectReadStream reader(std::make_unique<internal::ObjectReadStreambuf>(
+      internal::ReadObjectRangeRequest{}, std::move(read_source)));
+
+  std::vector<char> buffer(1024);
+  EXPECT_EQ(reader.ReadInto(absl::MakeSpan(buffer)), 0U);
+  EXPECT_TRUE(reader.bad());
+  EXPECT_THAT(reader.status(), StatusIs(StatusCode::kUnavailable));
+}
+
 TEST(ObjectStream, WriteMoveConstructor) {
   ObjectWriteStream writer;
   ASSERT_THAT(writer.rdbuf(), NotNull());
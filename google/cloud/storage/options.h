@@ -157,6 +157,86 @@ struct DownloadBufferSizeOption {
   using Type = std::size_t;
 };
 
+/**
+ * Prefetch the data for downloads in a background thread.
+ *
+ * When set to a non-zero value, `Client::ReadObject()` starts a background
+ * thread for each download. This thread keeps up to this many bytes received
+ * and buffered ahead of the application, so the network transfer overlaps with
+ * the processing of the data. This can significantly increase the throughput
+ * of a single download when the application processes the data sequentially,
+ * at the cost of one thread and this much memory per download.
+ *
+ * The default value is 0, which disables prefetching.
+ *
+ * @ingroup storage-options
+ */
+struct ReadAheadSizeOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Record the progress of `Client::DownloadToFile()` in a manifest file.
+ *
+ * When set to `true`, `DownloadToFile()` periodically saves its progress in a
+ * sidecar file, named `<file_name>.manifest`. The manifest records the object
+ * generation, the number of bytes downloaded, and the CRC32C checksum of these
+ * bytes. See `DownloadManifestCheckpointBytesOption` and
+ * `DownloadManifestCheckpointPeriodOption` for how often the progress is
+ * saved.
+ *
+ * If the download fails, or the process crashes or is preempted, calling
+ * `DownloadToFile()` again for the same object and destination resumes the
+ * download where it left off. The resumed download is pinned to the original
+ * object generation, and the checksum of the full object is still verified,
+ * without reading the data already downloaded. The manifest is removed once
+ * the download completes.
+ *
+ * Manifests cannot be used with ranged downloads, that is, with the
+ * `ReadFromOffset`, `ReadRange`, or `ReadLast` options.
+ *
+ * The default value is `false`.
+ *
+ * @ingroup storage-options
+ */
+struct EnableDownloadManifestOption {
+  using Type = bool;
+};
+
+/**
+ * Save the progress of `Client::DownloadToFile()` after this many bytes.
+ *
+ * Saving the progress in the manifest flushes the downloaded data to stable
+ * storage, and then writes, flushes, and renames the manifest. This is too
+ * expensive to do after every buffer. With `EnableDownloadManifestOption`,
+ * the progress is saved after this many bytes are downloaded, or after
+ * `DownloadManifestCheckpointPeriodOption`, whichever comes first. The
+ * progress is also saved before `DownloadToFile()` returns an error, unless
+ * the error prevents it.
+ *
+ * A crash loses, at most, the data downloaded since the last save.
+ *
+ * The default value is 64 MiB.
+ *
+ * @ingroup storage-options
+ */
+struct DownloadManifestCheckpointBytesOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Save the progress of `Client::DownloadToFile()` at least this often.
+ *
+ * @see `DownloadManifestCheckpointBytesOption` for more details.
+ *
+ * The default value is 10 seconds.
+ *
+ * @ingroup storage-options
+ */
+struct DownloadManifestCheckpointPeriodOption {
+  using Type = std::chrono::seconds;
+};
+
 /**
  * Control the formatted I/O upload buffer.
  *
@@ -175,6 +255,48 @@ struct UploadBufferSizeOption {
   using Type = std::size_t;
 };
 
+/**
+ * Upload data in a background thread while the application fills the next
+ * buffer.
+ *
+ * When set to a non-zero value, `Client::WriteObject()` hands each full buffer
+ * (see `UploadBufferSizeOption`) to a background thread, and the application
+ * continues writing into a new buffer while the previous one is uploaded. This
+ * option controls the maximum number of full buffers queued or being uploaded.
+ * When this many buffers are pending, writing into the stream blocks until
+ * one of them is uploaded, this provides backpressure to the application.
+ *
+ * The chunks of a resumable upload must be sent in order, so at most one
+ * chunk is uploaded at a time. Each pending buffer consumes
+ * `UploadBufferSizeOption` bytes of memory.
+ *
+ * The default value is 0, which disables pipelining.
+ *
+ * @ingroup storage-options
+ */
+struct UploadPipelineDepthOption {
+  using Type = std::size_t;
+};
+
+/**
+ * Sets the maximum number of concurrent requests in bulk operations.
+ *
+ * `DeleteByPrefix()` and `ComposeMany()` issue many independent requests.
+ * When this option is larger than 1, `DeleteByPrefix()` deletes the objects
+ * in background threads while it continues listing them, and `ComposeMany()`
+ * runs the compositions in each level of its composition tree, and the
+ * deletion of its temporary objects, concurrently. This option limits the
+ * number of requests in progress at any time.
+ *
+ * The default value is 1, which issues the requests serially, on the calling
+ * thread.
+ *
+ * @ingroup storage-options
+ */
+struct MaximumBulkConcurrencyOption {
+  using Type = std::size_t;
+};
+
 /**
  * Defines the threshold to switch from simple to resumable uploads for files.
  *
@@ -334,7 +456,10 @@ struct IdempotencyPolicyOption {
 using ClientOptionList = ::google::cloud::OptionList<
     RestEndpointOption, IamEndpointOption, Oauth2CredentialsOption,
     ProjectIdOption, ProjectIdOption, ConnectionPoolSizeOption,
-    DownloadBufferSizeOption, UploadBufferSizeOption,
+    DownloadBufferSizeOption, ReadAheadSizeOption,
+    EnableDownloadManifestOption, DownloadManifestCheckpointBytesOption,
+    DownloadManifestCheckpointPeriodOption, UploadBufferSizeOption,
+    UploadPipelineDepthOption, MaximumBulkConcurrencyOption,
     EnableCurlSslLockingOption, EnableCurlSigpipeHandlerOption,
     MaximumCurlSocketRecvSizeOption, MaximumCurlSocketSendSizeOption,
     TransferStallTimeoutOption, RetryPolicyOption, BackoffPolicyOption,
@@ -18,4 +18,5 @@
 
 storage_client_benchmarks = [
     "internal/crc32c_benchmark.cc",
+    "internal/list_objects_parser_benchmark.cc",
 ]
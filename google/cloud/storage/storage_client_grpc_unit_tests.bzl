@@ -54,6 +54,7 @@ storage_client_grpc_unit_tests = [
     "internal/grpc/bucket_name_test.cc",
     "internal/grpc/bucket_request_parser_test.cc",
     "internal/grpc/buffer_read_object_data_test.cc",
+    "internal/grpc/channel_refresh_test.cc",
     "internal/grpc/configure_client_context_test.cc",
     "internal/grpc/default_options_test.cc",
     "internal/grpc/hmac_key_metadata_parser_test.cc",
@@ -81,5 +82,6 @@ storage_client_grpc_unit_tests = [
     "internal/grpc/stub_test.cc",
     "internal/grpc/stub_upload_chunk_test.cc",
     "internal/grpc/synthetic_self_link_test.cc",
+    "internal/storage_channel_health_stub_test.cc",
     "internal/storage_stub_factory_test.cc",
 ]
@@ -46,6 +46,7 @@ storage_client_unit_tests = [
     "internal/access_control_common_test.cc",
     "internal/access_token_credentials_test.cc",
     "internal/base64_test.cc",
+    "internal/batch_requests_test.cc",
     "internal/bucket_acl_requests_test.cc",
     "internal/bucket_requests_test.cc",
     "internal/complex_option_test.cc",
@@ -63,6 +64,7 @@ storage_client_unit_tests = [
     "internal/const_buffer_test.cc",
     "internal/crc32c_test.cc",
     "internal/default_object_acl_requests_test.cc",
+    "internal/download_manifest_test.cc",
     "internal/generate_message_boundary_test.cc",
     "internal/generic_request_test.cc",
     "internal/hash_function_impl_test.cc",
@@ -82,7 +84,9 @@ storage_client_unit_tests = [
     "internal/object_write_streambuf_test.cc",
     "internal/patch_builder_test.cc",
     "internal/policy_document_request_test.cc",
+    "internal/read_ahead_object_read_source_test.cc",
     "internal/request_project_id_test.cc",
+    "internal/rest/batch_builder_test.cc",
     "internal/rest/object_read_source_test.cc",
     "internal/rest/request_builder_test.cc",
     "internal/rest/stub_test.cc",
@@ -40,6 +40,11 @@ class MockClient : public google::cloud::storage::internal::StorageConnection {
             ::testing::Return(storage::internal::DefaultOptionsWithCredentials(
                 Options{}.set<UnifiedCredentialsOption>(
                     MakeInsecureCredentials()))));
+    // Report batch requests as unsupported, so functions that use them fall
+    // back to individual requests. Tests for batch requests override this.
+    EXPECT_CALL(*this, ExecuteBatch)
+        .WillRepeatedly(::testing::Return(StatusOr<internal::BatchResponse>(
+            Status(StatusCode::kUnimplemented, "not mocked"))));
   }
 
   MOCK_METHOD(ClientOptions const&, client_options, (), (const, override));
@@ -86,6 +91,8 @@ class MockClient : public google::cloud::storage::internal::StorageConnection {
               (internal::ComposeObjectRequest const&), (override));
   MOCK_METHOD(StatusOr<internal::RewriteObjectResponse>, RewriteObject,
               (internal::RewriteObjectRequest const&), (override));
+  MOCK_METHOD(StatusOr<internal::BatchResponse>, ExecuteBatch,
+              (internal::BatchRequest const&), (override));
 
   MOCK_METHOD(StatusOr<internal::CreateResumableUploadResponse>,
               CreateResumableUpload, (internal::ResumableUploadRequest const&),
@@ -178,6 +185,7 @@ class MockObjectReadSource : public internal::ObjectReadSource {
   MOCK_METHOD(StatusOr<internal::HttpResponse>, Close, (), (override));
   MOCK_METHOD(StatusOr<internal::ReadSourceResult>, Read,
               (char* buf, std::size_t n), (override));
+  MOCK_METHOD(void, Cancel, (), (override));
 };
 
 class MockStreambuf : public internal::ObjectWriteStreambuf {
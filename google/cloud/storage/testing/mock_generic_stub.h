@@ -119,6 +119,10 @@ class MockGenericStub : public storage_internal::GenericStub {
               (rest_internal::RestContext&, Options const&,
                storage::internal::RewriteObjectRequest const&),
               (override));
+  MOCK_METHOD(StatusOr<storage::internal::BatchResponse>, ExecuteBatch,
+              (rest_internal::RestContext&, Options const&,
+               storage::internal::BatchRequest const&),
+              (override));
 
   MOCK_METHOD(StatusOr<storage::internal::CreateResumableUploadResponse>,
               CreateResumableUpload,
@@ -46,7 +46,9 @@ bool operator==(TracingOptions const& a, TracingOptions const& b) {
   return a.single_line_mode_ == b.single_line_mode_ &&
          a.use_short_repeated_primitives_ == b.use_short_repeated_primitives_ &&
          a.truncate_string_field_longer_than_ ==
-             b.truncate_string_field_longer_than_;
+             b.truncate_string_field_longer_than_ &&
+         a.log_one_in_ == b.log_one_in_ &&
+         a.max_logs_per_second_ == b.max_logs_per_second_;
 }
 
 TracingOptions& TracingOptions::SetOptions(std::string const& str) {
@@ -63,6 +65,10 @@ TracingOptions& TracingOptions::SetOptions(std::string const& str) {
       if (auto v = ParseBoolean(val)) use_short_repeated_primitives_ = *v;
     } else if (opt == "truncate_string_field_longer_than") {
       if (auto v = ParseInteger(val)) truncate_string_field_longer_than_ = *v;
+    } else if (opt == "log_one_in") {
+      if (auto v = ParseInteger(val)) log_one_in_ = *v;
+    } else if (opt == "max_logs_per_second") {
+      if (auto v = ParseInteger(val)) max_logs_per_second_ = *v;
     }
     if (comma == end) break;
     pos = comma + 1;
@@ -29,6 +29,8 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
  *   single_line_mode=on
  *   use_short_repeated_primitives=on
  *   truncate_string_field_longer_than=128
+ *   log_one_in=1
+ *   max_logs_per_second=0
  */
 class TracingOptions {
  public:
@@ -60,10 +62,19 @@ class TracingOptions {
     return truncate_string_field_longer_than_;
   }
 
+  /// Log only one in this many RPCs for each method. The default (1) logs all
+  /// the RPCs.
+  std::int64_t log_one_in() const { return log_one_in_; }
+
+  /// If non-zero, log at most this many RPCs per second for each method.
+  std::int64_t max_logs_per_second() const { return max_logs_per_second_; }
+
  private:
   bool single_line_mode_ = true;
   bool use_short_repeated_primitives_ = true;
   std::int64_t truncate_string_field_longer_than_ = 128;
+  std::int64_t log_one_in_ = 1;
+  std::int64_t max_logs_per_second_ = 0;
 };
 
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
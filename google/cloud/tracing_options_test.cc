@@ -60,6 +60,8 @@ TEST(TracingOptionsTest, Defaults) {
   EXPECT_TRUE(tracing_options.single_line_mode());
   EXPECT_TRUE(tracing_options.use_short_repeated_primitives());
   EXPECT_EQ(128, tracing_options.truncate_string_field_longer_than());
+  EXPECT_EQ(1, tracing_options.log_one_in());
+  EXPECT_EQ(0, tracing_options.max_logs_per_second());
   EXPECT_EQ(tracing_options, expected_defaults);
 
   // Unknown/unparseable options are ignored.
@@ -81,6 +83,15 @@ TEST(TracingOptionsTest, Override) {
   EXPECT_EQ(256, tracing_options.truncate_string_field_longer_than());
 }
 
+TEST(TracingOptionsTest, Sampling) {
+  auto const tracing_options = TracingOptions{}.SetOptions(
+      "log_one_in=100"
+      ",max_logs_per_second=5");
+  EXPECT_EQ(100, tracing_options.log_one_in());
+  EXPECT_EQ(5, tracing_options.max_logs_per_second());
+  EXPECT_NE(tracing_options, TracingOptions{});
+}
+
 }  // namespace
 GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_END
 }  // namespace cloud
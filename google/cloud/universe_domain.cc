@@ -14,7 +14,7 @@
 
 #include "google/cloud/universe_domain.h"
 #include "google/cloud/credentials.h"
-#include "google/cloud/internal/populate_common_options.h"
+#include "google/cloud/internal/credentials_impl.h"
 #include "google/cloud/internal/unified_rest_credentials.h"
 #include "google/cloud/universe_domain_options.h"
 
@@ -25,7 +25,7 @@ GOOGLE_CLOUD_CPP_INLINE_NAMESPACE_BEGIN
 StatusOr<Options> AddUniverseDomainOption(ExperimentalTag, Options options) {
   if (!options.has<UnifiedCredentialsOption>()) {
     options.set<UnifiedCredentialsOption>(
-        MakeGoogleDefaultCredentials(internal::MakeAuthOptions(options)));
+        internal::SharedGoogleDefaultCredentials(options));
   }
 
   auto universe_domain = GetUniverseDomain(